@@ -25,6 +25,7 @@
 #include <sofa/core/ObjectFactory.h>
 #include <sofa/component/collision/detection/algorithm/MirrorIntersector.h>
 #include <sofa/helper/ScopedAdvancedTimer.h>
+#include <sofa/component/collision/geometry/CubeModel.h>
 
 namespace sofa::component::collision::detection::algorithm
 {
@@ -35,7 +36,10 @@ void registerBVHNarrowPhase(sofa::core::ObjectFactory* factory)
         .add< BVHNarrowPhase >());
 }
 
-BVHNarrowPhase::BVHNarrowPhase() : core::collision::NarrowPhaseDetection()
+BVHNarrowPhase::BVHNarrowPhase()
+    : core::collision::NarrowPhaseDetection()
+    , d_useTraversalCache(initData(&d_useTraversalCache, false, "useTraversalCache", "If true, the pairs of elements where the traversal of the hierarchies stopped are stored for each pair of collision models. "
+                                                                                     "The next traversal starts from these pairs instead of the roots, as long as the hierarchies are only refitted."))
 {}
 
 
@@ -83,9 +87,53 @@ void BVHNarrowPhase::addCollisionPair(const std::pair<core::CollisionModel*, cor
         finestIntersector = nullptr;
     }
 
+    TraversalCache* cache = nullptr;
+    if (d_useTraversalCache.getValue() && finestIntersector != nullptr)
+    {
+        cache = getTraversalCache(cm1, cm2);
+    }
+
     // Queue used for the iterative form of a tree traversal, avoiding the recursive form
     std::queue< TestPair > externalCells;
-    initializeExternalCells(cm1, cm2, externalCells);
+
+    TraversalFront* front = nullptr;
+    bool restartFromFront = false;
+    if (cache)
+    {
+        const auto revision1 = static_cast<geometry::CubeCollisionModel*>(cm1)->getTreeRevision();
+        const auto revision2 = static_cast<geometry::CubeCollisionModel*>(cm2)->getTreeRevision();
+
+        restartFromFront = cache->front.isValid && !cache->front.pairs.empty()
+            && cache->revision1 == revision1 && cache->revision2 == revision2
+            && cache->front.nbTestedPairs <= cache->rootTraversalCost;
+
+        if (restartFromFront)
+        {
+            for (const auto& pair : cache->front.pairs)
+            {
+                externalCells.push(pair);
+            }
+        }
+
+        cache->front.pairs.clear();
+        cache->front.isValid = true;
+        cache->front.nbTestedPairs = 0;
+        cache->revision1 = revision1;
+        cache->revision2 = revision2;
+        cache->used = true;
+        front = &cache->front;
+    }
+
+    if (!restartFromFront)
+    {
+        initializeExternalCells(cm1, cm2, externalCells);
+
+        // the front can only be restarted if the traversal starts from a single pair of roots
+        if (front && externalCells.size() != 1)
+        {
+            front->isValid = false;
+        }
+    }
 
     core::collision::ElementIntersector* intersector = nullptr;
     MirrorIntersector mirror;
@@ -101,7 +149,47 @@ void BVHNarrowPhase::addCollisionPair(const std::pair<core::CollisionModel*, cor
                             cm1, cm2,
                             intersector,
                             {finestCollisionModel1, finestCollisionModel2, finestIntersector, selfCollision},
-                            &mirror, externalCells, outputs);
+                            &mirror, externalCells, outputs, front);
+    }
+
+    if (cache && !restartFromFront)
+    {
+        cache->rootTraversalCost = cache->front.nbTestedPairs;
+    }
+}
+
+BVHNarrowPhase::TraversalCache* BVHNarrowPhase::getTraversalCache(core::CollisionModel* cm1, core::CollisionModel* cm2)
+{
+    // The front is made of cells of the bounding trees, which keep their indices as long as the trees are only
+    // refitted. The self-collisions are not cached: the normal cones of the cells must be tested from the roots.
+    if (cm1 == cm2
+        || dynamic_cast<geometry::CubeCollisionModel*>(cm1) == nullptr
+        || dynamic_cast<geometry::CubeCollisionModel*>(cm2) == nullptr)
+    {
+        return nullptr;
+    }
+
+    // addCollisionPair may be called concurrently on different pairs
+    std::lock_guard lock(m_traversalCachesMutex);
+    return &m_traversalCaches[{cm1, cm2}];
+}
+
+void BVHNarrowPhase::endNarrowPhase()
+{
+    NarrowPhaseDetection::endNarrowPhase();
+
+    // forget the pairs which were not tested during this time step
+    for (auto it = m_traversalCaches.begin(); it != m_traversalCaches.end();)
+    {
+        if (!it->second.used)
+        {
+            it = m_traversalCaches.erase(it);
+        }
+        else
+        {
+            it->second.used = false;
+            ++it;
+        }
     }
 }
 
@@ -135,11 +223,12 @@ void BVHNarrowPhase::initializeExternalCells(
 void BVHNarrowPhase::processExternalCell(const TestPair &externalCell,
                                               core::CollisionModel *&cm1,
                                               core::CollisionModel *&cm2,
-                                              core::collision::ElementIntersector *coarseIntersector,
+                                              core::collision::ElementIntersector *&coarseIntersector,
                                               const FinestCollision &finest,
                                               MirrorIntersector *mirror,
                                               std::queue<TestPair> &externalCells,
-                                              sofa::core::collision::DetectionOutputVector *&outputs) const
+                                              sofa::core::collision::DetectionOutputVector *&outputs,
+                                              TraversalFront* front) const
 {
     const auto [collisionModel1, collisionModel2] = getCollisionModelsFromTestPair(externalCell);
 
@@ -176,7 +265,7 @@ void BVHNarrowPhase::processExternalCell(const TestPair &externalCell,
         TestPair current = internalCells.top();
         internalCells.pop();
 
-        processInternalCell(current, coarseIntersector, finest, externalCells, internalCells, outputs, intersectionMethod);
+        processInternalCell(current, coarseIntersector, finest, externalCells, internalCells, outputs, intersectionMethod, front);
     }
 }
 
@@ -186,18 +275,25 @@ void BVHNarrowPhase::processInternalCell(const TestPair &internalCell,
                                          std::queue<TestPair> &externalCells,
                                          std::stack<TestPair> &internalCells,
                                          sofa::core::collision::DetectionOutputVector *&outputs,
-                                         const sofa::core::collision::Intersection* currentIntersection)
+                                         const sofa::core::collision::Intersection* currentIntersection,
+                                         TraversalFront* front)
 {
     const auto [collisionModel1, collisionModel2] = getCollisionModelsFromTestPair(internalCell);
 
     if (collisionModel1 == finest.cm1 && collisionModel2 == finest.cm2) //the collision models are the finest ones
     {
+        // the traversal stops on ranges of elements, which are not stored in the front
+        if (front)
+        {
+            front->isValid = false;
+        }
+
         // Final collision pairs
         finalCollisionPairs(internalCell, finest.selfCollision, coarseIntersector, outputs, currentIntersection);
     }
     else
     {
-        visitCollisionElements(internalCell, coarseIntersector, finest, externalCells, internalCells, outputs, currentIntersection);
+        visitCollisionElements(internalCell, coarseIntersector, finest, externalCells, internalCells, outputs, currentIntersection, front);
     }
 }
 
@@ -207,13 +303,19 @@ void BVHNarrowPhase::visitCollisionElements(const TestPair &root,
                                             std::queue<TestPair> &externalCells,
                                             std::stack<TestPair> &internalCells,
                                             sofa::core::collision::DetectionOutputVector *&outputs,
-                                            const sofa::core::collision::Intersection* currentIntersection)
+                                            const sofa::core::collision::Intersection* currentIntersection,
+                                            TraversalFront* front)
 {
     const core::CollisionElementIterator begin1 = root.first.first;
     const core::CollisionElementIterator end1 = root.first.second;
     const core::CollisionElementIterator begin2 = root.second.first;
     const core::CollisionElementIterator end2 = root.second.second;
     
+    if (front)
+    {
+        front->nbTestedPairs += (end1.getIndex() - begin1.getIndex()) * (end2.getIndex() - begin2.getIndex());
+    }
+
     for (auto it1 = begin1; it1 != end1; ++it1)
     {
         for (auto it2 = begin2; it2 != end2; ++it2)
@@ -253,10 +355,18 @@ void BVHNarrowPhase::visitCollisionElements(const TestPair &root,
                     {
                         // end of both internal tree of elements.
                         // need to test external children
-                        visitExternalChildren(it1, it2, coarseIntersector, finest, externalCells, outputs, currentIntersection);
+                        if (front)
+                        {
+                            front->pairs.emplace_back(std::make_pair(it1, it1 + 1), std::make_pair(it2, it2 + 1));
+                        }
+                        visitExternalChildren(it1, it2, coarseIntersector, finest, externalCells, outputs, currentIntersection, front);
                     }
                 }
             }
+            else if (front)
+            {
+                front->pairs.emplace_back(std::make_pair(it1, it1 + 1), std::make_pair(it2, it2 + 1));
+            }
         }
     }
 }
@@ -267,10 +377,20 @@ void BVHNarrowPhase::visitExternalChildren(const core::CollisionElementIterator
                                            const FinestCollision &finest,
                                            std::queue<TestPair> &externalCells,
                                            sofa::core::collision::DetectionOutputVector *&outputs,
-                                           const sofa::core::collision::Intersection* currentIntersection)
+                                           const sofa::core::collision::Intersection* currentIntersection,
+                                           TraversalFront* front)
 {
     const TestPair externalChildren(it1.getExternalChildren(), it2.getExternalChildren());
 
+    // The traversal continues in other collision models: the current pair is not where the traversal stops
+    const auto invalidateFront = [front]()
+    {
+        if (front)
+        {
+            front->isValid = false;
+        }
+    };
+
     const bool isExtChildrenRangeEmpty1 = isRangeEmpty(externalChildren.first);
     const bool isExtChildrenRangeEmpty2 = isRangeEmpty(externalChildren.second);
 
@@ -285,6 +405,7 @@ void BVHNarrowPhase::visitExternalChildren(const core::CollisionElementIterator
             }
             else
             {
+                invalidateFront();
                 externalCells.push(externalChildren);
             }
         }
@@ -292,6 +413,7 @@ void BVHNarrowPhase::visitExternalChildren(const core::CollisionElementIterator
         {
             // only first element has external children
             // test them against the second element
+            invalidateFront();
             externalCells.emplace(externalChildren.first, std::make_pair(it2, it2 + 1));
         }
     }
@@ -299,6 +421,7 @@ void BVHNarrowPhase::visitExternalChildren(const core::CollisionElementIterator
     {
         // only second element has external children
         // test them against the first element
+        invalidateFront();
         externalCells.emplace(std::make_pair(it1, it1 + 1), externalChildren.second);
     }
     else
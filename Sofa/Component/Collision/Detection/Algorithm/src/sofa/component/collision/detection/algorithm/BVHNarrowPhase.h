@@ -23,6 +23,8 @@
 #include <sofa/component/collision/detection/algorithm/config.h>
 
 #include <sofa/core/collision/NarrowPhaseDetection.h>
+#include <map>
+#include <mutex>
 #include <queue>
 #include <stack>
 
@@ -45,17 +47,23 @@ class MirrorIntersector;
  * collision models, it traverses the hierarchy of bounding volumes in order to rapidly
  * eliminate pairs of elements which are not in intersection. Finally, the intersection
  * method is called on the remaining pairs of elements.
+ *
+ * Optionally, the pairs of elements where the traversal stopped (the traversal front) are stored for each pair of
+ * collision models. As long as both hierarchies are only refitted, the next traversal starts from this
+ * front instead of the roots. For temporally coherent motions, the cost of the traversal is then close to the number
+ * of contacts.
  */
 class SOFA_COMPONENT_COLLISION_DETECTION_ALGORITHM_API BVHNarrowPhase : public core::collision::NarrowPhaseDetection
 {
 public:
     SOFA_CLASS(BVHNarrowPhase, core::collision::NarrowPhaseDetection);
 
+    Data<bool> d_useTraversalCache; ///< If true, the traversal of the hierarchies of a pair of collision models starts from where it stopped at the previous time step
+
 protected:
     BVHNarrowPhase();
     ~BVHNarrowPhase() override = default;
 
-private:
     /// Range defined by two iterators in a container of CollisionElement
     using CollisionIteratorRange = std::pair<core::CollisionElementIterator, core::CollisionElementIterator>;
 
@@ -76,8 +84,46 @@ public:
      */
     void addCollisionPair(const std::pair<core::CollisionModel*, core::CollisionModel*>& cmPair) override;
 
+    void endNarrowPhase() override;
+
 protected:
 
+    /// Pairs of single collision elements where the traversal of the hierarchies stopped, either because the
+    /// elements do not intersect, or because their children are the finest elements
+    struct TraversalFront
+    {
+        std::vector<TestPair> pairs;
+
+        /// False if the traversal went through pairs which cannot be restarted individually
+        bool isValid { true };
+
+        /// Number of pairs of elements tested during the traversal
+        std::size_t nbTestedPairs { 0 };
+    };
+
+    /// Traversal front of a pair of collision models, stored between two time steps
+    struct TraversalCache
+    {
+        TraversalFront front;
+
+        /// Revisions of the hierarchies when the front was built. The front is only valid for the same hierarchies.
+        std::size_t revision1 { 0 };
+        std::size_t revision2 { 0 };
+
+        /// Number of pairs tested during the last traversal starting from the roots.
+        /// A front only gets finer from one time step to the next: when restarting from the front becomes more expensive
+        /// than starting from the roots, the next traversal starts from the roots.
+        std::size_t rootTraversalCost { 0 };
+
+        bool used { false };
+    };
+
+    /// Return the cache of the pair of collision models, or nullptr if the traversal of this pair cannot be cached
+    TraversalCache* getTraversalCache(core::CollisionModel* cm1, core::CollisionModel* cm2);
+
+    std::map<std::pair<core::CollisionModel*, core::CollisionModel*>, TraversalCache> m_traversalCaches;
+    std::mutex m_traversalCachesMutex;
+
     /// Return true if both collision models belong to the same object, false otherwise
     static bool isSelfCollision(core::CollisionModel* cm1, core::CollisionModel* cm2);
 
@@ -103,11 +149,12 @@ protected:
     void processExternalCell(const TestPair &externalCell,
                              core::CollisionModel *&cm1,
                              core::CollisionModel *&cm2,
-                             core::collision::ElementIntersector *coarseIntersector,
+                             core::collision::ElementIntersector *&coarseIntersector,
                              const FinestCollision &finest,
                              MirrorIntersector *mirror,
                              std::queue<TestPair> &externalCells,
-                             sofa::core::collision::DetectionOutputVector *&outputs) const;
+                             sofa::core::collision::DetectionOutputVector *&outputs,
+                             TraversalFront* front = nullptr) const;
 
     static void
     processInternalCell(const TestPair &internalCell,
@@ -116,7 +163,8 @@ protected:
                         std::queue<TestPair> &externalCells,
                         std::stack<TestPair> &internalCells,
                         sofa::core::collision::DetectionOutputVector *&outputs,
-                        const sofa::core::collision::Intersection* currentIntersection);
+                        const sofa::core::collision::Intersection* currentIntersection,
+                        TraversalFront* front = nullptr);
 
     static void visitCollisionElements(const TestPair &root,
                                        core::collision::ElementIntersector *coarseIntersector,
@@ -124,7 +172,8 @@ protected:
                                        std::queue<TestPair> &externalCells,
                                        std::stack<TestPair> &internalCells,
                                        sofa::core::collision::DetectionOutputVector *&outputs,
-                                       const sofa::core::collision::Intersection* currentIntersection);
+                                       const sofa::core::collision::Intersection* currentIntersection,
+                                       TraversalFront* front = nullptr);
 
     static void
     visitExternalChildren(const core::CollisionElementIterator &it1, const core::CollisionElementIterator &it2,
@@ -132,7 +181,8 @@ protected:
                           const FinestCollision &finest,
                           std::queue<TestPair> &externalCells,
                           sofa::core::collision::DetectionOutputVector *&outputs,
-                          const sofa::core::collision::Intersection* currentIntersection);
+                          const sofa::core::collision::Intersection* currentIntersection,
+                          TraversalFront* front = nullptr);
 
     /// Test intersection between two ranges of CollisionElement's
     /// The provided TestPair contains ranges of external CollisionElement's, which means that
@@ -143,11 +193,11 @@ protected:
                                     sofa::core::collision::DetectionOutputVector*& outputs,
                                     const sofa::core::collision::Intersection* currentIntersection);
 
-private:
-
     /// Get both collision models corresponding to the provided TestPair
     static std::pair<core::CollisionModel*, core::CollisionModel*> getCollisionModelsFromTestPair(const TestPair& pair);
 
+private:
+
     static bool isRangeEmpty(const CollisionIteratorRange& range);
 };
 
@@ -27,6 +27,7 @@
 #include <sofa/core/collision/NarrowPhaseDetection.h>
 #include <sofa/core/collision/CollisionGroupManager.h>
 #include <sofa/core/collision/ContactManager.h>
+#include <sofa/component/collision/geometry/CubeModel.h>
 
 #include <sofa/simulation/Node.h>
 
@@ -65,6 +66,11 @@ CollisionPipeline::CollisionPipeline()
     //TODO(dmarchal 2017-05-16) Fix the min & max value with response from a github issue. Remove in 1 year if not done.
     , d_depth(initData(&d_depth, defaultDepthValue, "depth",
                ("Max depth of bounding trees. (default=" + std::to_string(defaultDepthValue) + ", min=?, max=?)").c_str()))
+    , d_bvhRebuildThreshold(initData(&d_bvhRebuildThreshold, SReal(0), "bvhRebuildThreshold",
+               "When the number of elements of a collision model is unchanged, its bounding tree is only refitted. The subtree of a cell whose "
+               "children grew more than this factor in surface area since they were built is rebuilt. 0 to never rebuild (default=0)"))
+    , d_parallelBVHRefit(initData(&d_parallelBVHRefit, false, "parallelBVHRefit",
+               "If true, the cells of each level of the bounding trees are refitted in parallel. (default=false)"))
 {
 }
 
@@ -103,6 +109,25 @@ void CollisionPipeline::checkDataValues()
                       << "Replaced with the default value = " << defaultDepthValue;
         d_depth.setValue(defaultDepthValue) ;
     }
+
+    const SReal rebuildThreshold = d_bvhRebuildThreshold.getValue();
+    if (rebuildThreshold > 0 && rebuildThreshold < 1)
+    {
+        msg_warning() << "Invalid value 'bvhRebuildThreshold'=" << rebuildThreshold << "." << msgendl
+                      << "A value between 0 and 1 rebuilds the whole bounding trees at each time step, even if the elements did not move. "
+                         "Use a value greater than 1 (e.g. 2 rebuilds the cells whose children doubled in area), or 0 to never rebuild.";
+    }
+}
+
+void CollisionPipeline::linkBoundingTreeParameters(core::CollisionModel* collisionModel)
+{
+    // The bounding tree is created by the collision model itself, it is not accessible from the scene
+    auto* cubeModel = dynamic_cast<sofa::component::collision::geometry::CubeCollisionModel*>(collisionModel->getPrevious());
+    if (cubeModel && cubeModel->d_rebuildThreshold.getParent() == nullptr)
+    {
+        cubeModel->d_rebuildThreshold.setParent(&d_bvhRebuildThreshold);
+        cubeModel->d_parallelRefit.setParent(&d_parallelBVHRefit);
+    }
 }
 
 void CollisionPipeline::doCollisionReset()
@@ -179,6 +204,7 @@ void CollisionPipeline::doCollisionDetection(const type::vector<core::CollisionM
                 ScopedAdvancedTimer boundingTreeTimer(msg.c_str());
                 (*it)->computeBoundingTree(used_depth);
             }
+            linkBoundingTreeParameters(*it);
 
             vectBoundingVolume.push_back ((*it)->getFirst());
             ++nActive;
@@ -35,6 +35,8 @@ public:
     Data<bool> d_doPrintInfoMessage;
     Data<bool> d_doDebugDraw;
     Data<int>  d_depth;
+    Data<SReal> d_bvhRebuildThreshold; ///< Growth of the surface area of the children of a cell of the bounding trees above which its subtree is rebuilt
+    Data<bool> d_parallelBVHRefit; ///< If true, the levels of the bounding trees are refitted in parallel
 protected:
     CollisionPipeline();
 public:
@@ -53,6 +55,9 @@ protected:
 
     virtual void checkDataValues() ;
 
+    /// Link the parameters of the bounding tree of a collision model to the parameters of the pipeline
+    void linkBoundingTreeParameters(core::CollisionModel* collisionModel);
+
 public:
     static const int defaultDepthValue;
 };
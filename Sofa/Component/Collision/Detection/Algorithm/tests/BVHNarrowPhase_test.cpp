@@ -0,0 +1,201 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/component/collision/detection/algorithm/BVHNarrowPhase.h>
+using sofa::component::collision::detection::algorithm::BVHNarrowPhase;
+
+#include <sofa/component/collision/geometry/CubeModel.h>
+using sofa::component::collision::geometry::Cube;
+using sofa::component::collision::geometry::CubeCollisionModel;
+
+#include <sofa/component/collision/testing/BoxCollisionModel.h>
+using sofa::collision_test::BoxCollisionModel;
+
+#include <sofa/core/CollisionModel.h>
+#include <sofa/core/collision/Intersection.h>
+#include <sofa/core/ObjectFactory.h>
+
+#include <sofa/testing/BaseTest.h>
+using sofa::testing::BaseTest;
+
+#include <set>
+
+namespace
+{
+
+/// Intersection method storing the pairs of overlapping boxes
+class RecordingIntersection : public sofa::core::collision::Intersection, public sofa::core::collision::ElementIntersector
+{
+public:
+    SOFA_CLASS(RecordingIntersection, sofa::core::collision::Intersection);
+
+    std::set<std::pair<sofa::Index, sofa::Index> > pairs;
+    std::size_t nbCubeTests { 0 };
+
+    sofa::core::collision::ElementIntersector* findIntersector(sofa::core::CollisionModel*, sofa::core::CollisionModel*, bool& swapModels) override
+    {
+        swapModels = false;
+        return this;
+    }
+
+    bool canIntersect(sofa::core::CollisionElementIterator elem1, sofa::core::CollisionElementIterator elem2, const sofa::core::collision::Intersection*) override
+    {
+        ++nbCubeTests;
+        const Cube cube1(elem1), cube2(elem2);
+        return sofa::collision_test::overlap(cube1.minVect(), cube1.maxVect(), cube2.minVect(), cube2.maxVect());
+    }
+
+    int beginIntersect(sofa::core::CollisionModel*, sofa::core::CollisionModel*, sofa::core::collision::DetectionOutputVector*&) override
+    {
+        return 0;
+    }
+
+    int intersect(sofa::core::CollisionElementIterator elem1, sofa::core::CollisionElementIterator elem2, sofa::core::collision::DetectionOutputVector*, const sofa::core::collision::Intersection*) override
+    {
+        if (sofa::collision_test::boxesOverlap(elem1, elem2))
+        {
+            pairs.emplace(elem1.getIndex(), elem2.getIndex());
+            return 1;
+        }
+        return 0;
+    }
+
+    int endIntersect(sofa::core::CollisionModel*, sofa::core::CollisionModel*, sofa::core::collision::DetectionOutputVector*) override
+    {
+        return 0;
+    }
+
+    std::string name() const override
+    {
+        return "RecordingIntersection";
+    }
+};
+
+}
+
+namespace sofa
+{
+
+struct BVHNarrowPhase_test : public BaseTest
+{
+    BoxCollisionModel::SPtr model1;
+    BoxCollisionModel::SPtr model2;
+
+    void SetUp() override
+    {
+        model1 = core::objectmodel::New<BoxCollisionModel>();
+        model2 = core::objectmodel::New<BoxCollisionModel>();
+    }
+
+    /// Detect the overlapping boxes of both models
+    static void detect(BVHNarrowPhase* narrowPhase, RecordingIntersection* intersection, core::CollisionModel* cm1, core::CollisionModel* cm2)
+    {
+        intersection->pairs.clear();
+        intersection->nbCubeTests = 0;
+        narrowPhase->beginNarrowPhase();
+        narrowPhase->addCollisionPair({cm1, cm2});
+        narrowPhase->endNarrowPhase();
+    }
+
+    /// Compare the pairs detected with and without the traversal cache while the plates move toward each other
+    /// @return the number of pairs of cells tested without and with the cache
+    std::pair<std::size_t, std::size_t> compareWithCache(SReal rebuildThreshold, SReal rotationSpeed)
+    {
+        const auto reference = core::objectmodel::New<BVHNarrowPhase>();
+        const auto cached = core::objectmodel::New<BVHNarrowPhase>();
+        cached->d_useTraversalCache.setValue(true);
+
+        const auto referenceIntersection = core::objectmodel::New<RecordingIntersection>();
+        const auto cachedIntersection = core::objectmodel::New<RecordingIntersection>();
+        reference->setIntersectionMethod(referenceIntersection.get());
+        cached->setIntersectionMethod(cachedIntersection.get());
+
+        std::size_t nbReferenceTests = 0;
+        std::size_t nbCachedTests = 0;
+        std::size_t nbPairs = 0;
+        std::size_t nbRebuiltSteps = 0;
+
+        for (unsigned int step = 0; step < 40; ++step)
+        {
+            const SReal phase = 0.05 * step;
+            model1->setPlate(20, 0, phase, 0);
+            model2->setPlate(step < 30 ? 20 : 18, 3 - 0.1 * step, -phase, rotationSpeed * step);
+
+            for (auto& model : {model1, model2})
+            {
+                auto* leaves = static_cast<CubeCollisionModel*>(model->getPrevious());
+                std::vector<sofa::Index> leafOrder;
+                for (sofa::Index i = 0; leaves && i < leaves->getSize(); ++i)
+                {
+                    leafOrder.push_back(leaves->getLeafIndex(i));
+                }
+
+                model->computeBoundingTree(6);
+
+                leaves = static_cast<CubeCollisionModel*>(model->getPrevious());
+                leaves->d_rebuildThreshold.setValue(rebuildThreshold);
+                if (leafOrder.size() == leaves->getSize())
+                {
+                    for (sofa::Index i = 0; i < leaves->getSize(); ++i)
+                    {
+                        if (leafOrder[i] != leaves->getLeafIndex(i))
+                        {
+                            ++nbRebuiltSteps;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            auto* root1 = model1->getFirst();
+            auto* root2 = model2->getFirst();
+            detect(reference.get(), referenceIntersection.get(), root1, root2);
+            detect(cached.get(), cachedIntersection.get(), root1, root2);
+
+            EXPECT_EQ(cachedIntersection->pairs, referenceIntersection->pairs) << "step " << step;
+
+            nbReferenceTests += referenceIntersection->nbCubeTests;
+            nbCachedTests += cachedIntersection->nbCubeTests;
+            nbPairs += referenceIntersection->pairs.size();
+        }
+
+        EXPECT_GT(nbPairs, 0u);
+        EXPECT_EQ(nbRebuiltSteps > 0, rebuildThreshold > 0);
+
+        return {nbReferenceTests, nbCachedTests};
+    }
+};
+
+TEST_F(BVHNarrowPhase_test, traversalCache)
+{
+    const auto [nbReferenceTests, nbCachedTests] = compareWithCache(0, 0);
+
+    // the pairs of cells above the front are not tested again
+    EXPECT_LT(nbCachedTests, nbReferenceTests);
+}
+
+TEST_F(BVHNarrowPhase_test, traversalCacheWithPartialRebuild)
+{
+    // the rotation of a plate degrades its tree, which is partially rebuilt, and the front is restarted from the roots
+    compareWithCache(1.2, 0.04);
+}
+
+}
@@ -73,6 +73,7 @@ public:
     void checkCollisionPipelineWithMissingNarrowPhase();
     void checkCollisionPipelineWithMissingContactManager();
     int checkCollisionPipelineWithMonkeyValueForDepth(int value);
+    void checkCollisionPipelineWithBVHRebuildThreshold(SReal value);
 
     void SetUp() override
     {
@@ -222,6 +223,22 @@ int TestCollisionPipeline::checkCollisionPipelineWithMonkeyValueForDepth(int dva
     return rv;
 }
 
+void TestCollisionPipeline::checkCollisionPipelineWithBVHRebuildThreshold(SReal value)
+{
+    std::stringstream scene ;
+    scene << "<?xml version='1.0'?>                                                          \n"
+             "<Node 	name='Root' gravity='0 -9.81 0' time='0' animate='0' >               \n"
+             "  <CollisionPipeline name='pipeline' bvhRebuildThreshold='"<< value <<"'/>     \n"
+             "  <BruteForceBroadPhase/>                                                      \n"
+             "  <BVHNarrowPhase/>                                                            \n"
+             "  <CollisionResponse/>                                                         \n"
+             "  <DiscreteIntersection name='interaction'/>                                   \n"
+             "</Node>                                                                        \n" ;
+
+    root = SceneLoaderXML::loadFromMemory ("testscene", scene.str().c_str());
+    ASSERT_NE(root.get(), nullptr) ;
+    root->init(sofa::core::execparams::defaultInstance()) ;
+}
 
 TEST_F(TestCollisionPipeline, checkCollisionPipelineWithNoAttributes)
 {
@@ -285,4 +302,17 @@ TEST_F(TestCollisionPipeline, checkCollisionPipelineWithMonkeyValueForDepth_Open
     }
 }
 
+TEST_F(TestCollisionPipeline, checkCollisionPipelineWithBVHRebuildThreshold)
+{
+    for (const SReal value : {0., 1., 2.})
+    {
+        EXPECT_MSG_NOEMIT(Warning) ;
+        this->checkCollisionPipelineWithBVHRebuildThreshold(value);
+    }
+
+    // the whole trees would be rebuilt at each time step
+    EXPECT_MSG_EMIT(Warning) ;
+    this->checkCollisionPipelineWithBVHRebuildThreshold(0.5);
+}
+
 } // CollisionPipeline_test
@@ -24,7 +24,10 @@
 #include <sofa/core/visual/VisualParams.h>
 #include <sofa/helper/visual/DrawTool.h>
 #include <sofa/core/ObjectFactory.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/ParallelForEach.h>
 #include <algorithm>
+#include <atomic>
 
 namespace sofa::component::collision::geometry
 {
@@ -38,11 +41,57 @@ void registerCubeCollisionModel(sofa::core::ObjectFactory* factory)
         .add< CubeCollisionModel >());
 }
 
+namespace
+{
+
+/// Below this number of cells, a level is refitted sequentially even if the parallel refit is enabled
+constexpr sofa::Size minNbCellsParallelRefit = 512;
+
+/// Source of the revisions of the trees, shared by all the models so that a revision is never reused
+std::atomic<std::size_t> treeRevisionCounter { 0 };
+
+SReal surfaceArea(const CubeCollisionModel::CubeData& cube)
+{
+    const Vec3 l = cube.maxBBox - cube.minBBox;
+    return 2 * (l[0] * l[1] + l[1] * l[2] + l[2] * l[0]);
+}
+
+/// Cells are split along their biggest dimension
+int getSplitAxis(const Vec3& l)
+{
+    if(l[0]>l[1])
+        if (l[0]>l[2])
+            return 0;
+        else
+            return 2;
+    else if (l[1]>l[2])
+        return 1;
+    else
+        return 2;
+}
+
+}
+
 CubeCollisionModel::CubeCollisionModel()
+    : d_rebuildThreshold(initData(&d_rebuildThreshold, SReal(0), "rebuildThreshold", "Growth of the surface area of the children of a cell, relative to their area when they were built, above which the subtree of the cell is rebuilt during a refit (e.g. 2 rebuilds the cells whose children doubled in area). 0 to never rebuild while the number of elements is unchanged."))
+    , d_parallelRefit(initData(&d_parallelRefit, false, "parallelRefit", "If true, the cells of each level of the hierarchy are refitted in parallel"))
 {
     enum_type = AABB_TYPE;
 }
 
+void CubeCollisionModel::init()
+{
+    this->CollisionModel::init();
+
+    const SReal rebuildThreshold = d_rebuildThreshold.getValue();
+    if (rebuildThreshold > 0 && rebuildThreshold < 1)
+    {
+        msg_warning() << "Invalid value 'rebuildThreshold'=" << rebuildThreshold << "." << msgendl
+                      << "A value between 0 and 1 rebuilds the whole tree at each refit, even if the elements did not move. "
+                         "Use a value greater than 1 (e.g. 2 rebuilds the cells whose children doubled in area), or 0 to never rebuild.";
+    }
+}
+
 void CubeCollisionModel::resize(sofa::Size size)
 {
     const auto size0 = this->size;
@@ -112,15 +161,21 @@ Index CubeCollisionModel::addCube(Cube subcellsBegin, Cube subcellsEnd)
     elems[index].children.first = core::CollisionElementIterator();
     elems[index].children.second = core::CollisionElementIterator();
     updateCube(index);
+    elems[index].referenceArea = surfaceArea(elems[index]);
     return index;
 }
 
 void CubeCollisionModel::updateCube(sofa::Index index)
 {
     const std::pair<Cube,Cube>& subcells = elems[index].subcells;
-    if (subcells.first != subcells.second)
+    updateCube(index, subcells.first, subcells.second);
+}
+
+void CubeCollisionModel::updateCube(sofa::Index index, const Cube& begin, const Cube& end)
+{
+    if (begin != end)
     {
-        Cube c = subcells.first;
+        Cube c = begin;
         Vec3 minBBox = c.minVect();
         Vec3 maxBBox = c.maxVect();
 
@@ -128,7 +183,7 @@ void CubeCollisionModel::updateCube(sofa::Index index)
         elems[index].coneAngle = c.getConeAngle();
 
         ++c;
-        while(c != subcells.second)
+        while(c != end)
         {
             const Vec3& cmin = c.minVect();
             const Vec3& cmax = c.maxVect();
@@ -161,6 +216,74 @@ void CubeCollisionModel::updateCubes()
         updateCube(i);
 }
 
+void CubeCollisionModel::updateCubes(simulation::TaskScheduler& taskScheduler)
+{
+    // the cells of a level only depend on the cells of the level below
+    simulation::parallelForEach(taskScheduler, sofa::Index(0), sofa::Index(size), [this](const sofa::Index i)
+    {
+        updateCube(i);
+    });
+}
+
+void CubeCollisionModel::rebuildSubtree(sofa::Index index, sofa::Index leafBegin, sofa::Index leafEnd, CubeCollisionModel* leaves)
+{
+    CubeData& cell = elems[index];
+    if (cell.subcells.first.getCollisionModel() == leaves)
+    {
+        // this cell was not split: it directly contains the leaf cells
+        updateCube(index);
+        cell.referenceArea = surfaceArea(cell);
+        return;
+    }
+
+    // Same splitting as in computeBoundingTree: the number of cells on each side of the median only depends on the number
+    // of leaves, so the children of this cell are the same cells as before
+    updateCube(index, Cube(leaves, leafBegin), Cube(leaves, leafEnd));
+    const int splitAxis = getSplitAxis(cell.maxBBox - cell.minBBox);
+    const sofa::Index middle = leafBegin + (leafEnd - leafBegin + 1) / 2;
+    std::stable_sort(leaves->elems.begin() + leafBegin, leaves->elems.begin() + leafEnd, CubeSortPredicate(splitAxis));
+
+    CubeCollisionModel* clevel = cell.subcells.first.getCollisionModel();
+    const sofa::Index c1 = cell.subcells.first.getIndex();
+    clevel->rebuildSubtree(c1, leafBegin, middle, leaves);
+    clevel->rebuildSubtree(c1 + 1, middle, leafEnd, leaves);
+
+    updateCube(index);
+    cell.referenceArea = surfaceArea(cell);
+}
+
+bool CubeCollisionModel::rebuildDegradedSubtrees(sofa::Index index, sofa::Index leafBegin, sofa::Index leafEnd, SReal threshold, CubeCollisionModel* leaves)
+{
+    CubeData& cell = elems[index];
+    if (cell.subcells.first.getCollisionModel() == leaves)
+    {
+        // the order of the leaves in a cell which was not split does not matter
+        return false;
+    }
+
+    // The split of this cell degraded if its children grew: they may now overlap each other
+    CubeCollisionModel* clevel = cell.subcells.first.getCollisionModel();
+    const sofa::Index c1 = cell.subcells.first.getIndex();
+    const CubeData& child1 = clevel->elems[c1];
+    const CubeData& child2 = clevel->elems[c1 + 1];
+    if (surfaceArea(child1) + surfaceArea(child2) > threshold * (child1.referenceArea + child2.referenceArea))
+    {
+        rebuildSubtree(index, leafBegin, leafEnd, leaves);
+        return true;
+    }
+
+    const sofa::Index middle = leafBegin + (leafEnd - leafBegin + 1) / 2;
+    const bool rebuilt1 = clevel->rebuildDegradedSubtrees(c1, leafBegin, middle, threshold, leaves);
+    const bool rebuilt2 = clevel->rebuildDegradedSubtrees(c1 + 1, middle, leafEnd, threshold, leaves);
+
+    if (rebuilt1 || rebuilt2)
+    {
+        updateCube(index);
+        return true;
+    }
+    return false;
+}
+
 void CubeCollisionModel::draw(const core::visual::VisualParams* vparams)
 {
     if (!isActive() || !((getNext()==nullptr)?vparams->displayFlags().getShowCollisionModels():vparams->displayFlags().getShowBoundingCollisionModels())) return;
@@ -232,6 +355,14 @@ bool CubeCollisionModel::isLeaf(sofa::Index index ) const
     return elems[index].children.first.valid();
 }
 
+void CubeCollisionModel::updateTreeRevision(const std::list<CubeCollisionModel*>& levels)
+{
+    const std::size_t revision = ++treeRevisionCounter;
+    m_treeRevision = revision;
+    for (const auto & level : levels)
+        level->m_treeRevision = revision;
+}
+
 void CubeCollisionModel::computeBoundingTree(int maxDepth)
 {
 
@@ -284,18 +415,8 @@ void CubeCollisionModel::computeBoundingTree(int maxDepth)
                 {
                     // Only split cells with more than 4 childs
                     // Find the biggest dimension
-                    int splitAxis;
-                    Vec3 l = cell.maxVect()-cell.minVect();
+                    const int splitAxis = getSplitAxis(cell.maxVect()-cell.minVect());
                     const sofa::Index middle = subcells.first.getIndex()+(ncells+1)/2;
-                    if(l[0]>l[1])
-                        if (l[0]>l[2])
-                            splitAxis = 0;
-                        else
-                            splitAxis = 2;
-                    else if (l[1]>l[2])
-                        splitAxis = 1;
-                    else
-                        splitAxis = 2;
 
                     // Separate cells on each side of the median cell
                     const CubeSortPredicate sortpred(splitAxis);
@@ -321,17 +442,45 @@ void CubeCollisionModel::computeBoundingTree(int maxDepth)
             for (sofa::Size i=0; i<size; i++)
                 parentOf[elems[i].children.first.getIndex()] = i;
         }
+
+        updateTreeRevision(levels);
     }
     else
     {
+        simulation::TaskScheduler* taskScheduler = nullptr;
+        if (d_parallelRefit.getValue())
+        {
+            taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+            if (taskScheduler && taskScheduler->getThreadCount() < 1)
+            {
+                taskScheduler->init(0);
+            }
+        }
+
         // Simply update the existing tree, starting from the bottom
         int lvl = 0;
         for (auto it = levels.rbegin(); it != levels.rend(); ++it)
         {
             dmsg_info() << "CubeCollisionModel: update level " << lvl;
-            (*it)->updateCubes();
+            if (taskScheduler && taskScheduler->getThreadCount() > 1 && (*it)->size >= minNbCellsParallelRefit)
+                (*it)->updateCubes(*taskScheduler);
+            else
+                (*it)->updateCubes();
             ++lvl;
         }
+
+        // Then rebuild the parts of the tree which degraded too much since they were built
+        const SReal threshold = d_rebuildThreshold.getValue();
+        if (threshold > 0 && root->rebuildDegradedSubtrees(0, 0, size, threshold, this))
+        {
+            dmsg_info() << "CubeCollisionModel: partial rebuild";
+            if (!parentOf.empty())
+            {
+                for (sofa::Size i=0; i<size; i++)
+                    parentOf[elems[i].children.first.getIndex()] = i;
+            }
+            updateTreeRevision(levels);
+        }
     }
     dmsg_info() << "<CubeCollisionModel::computeBoundingTree(" << maxDepth << ")";
 }
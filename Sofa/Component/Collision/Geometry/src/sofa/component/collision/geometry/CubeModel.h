@@ -24,6 +24,12 @@
 
 #include <sofa/core/CollisionModel.h>
 #include <sofa/defaulttype/VecTypes.h>
+#include <list>
+
+namespace sofa::simulation
+{
+    class TaskScheduler;
+}
 
 namespace sofa::component::collision::geometry
 {
@@ -62,6 +68,9 @@ public:
         // additional data for implementing Volino's method for efficient cloth self collision 
         sofa::type::Vec3 coneAxis;
         SReal coneAngle;
+
+        /// Surface area of the cell when its subtree was last built. Used to measure the degradation of the tree during refits
+        SReal referenceArea { 0 };
     };
 
     class CubeSortPredicate
@@ -81,7 +90,12 @@ protected:
     sofa::type::vector<CubeData> elems;
     sofa::type::vector<sofa::Index> parentOf; ///< Given the index of a child leaf element, store the index of the parent cube
 
+    std::size_t m_treeRevision { 0 };
+
 public:
+    Data<SReal> d_rebuildThreshold; ///< Growth of the surface area of the children of a cell, relative to their area when they were built, above which the subtree of the cell is rebuilt during a refit. 0 to never rebuild while the number of elements is unchanged.
+    Data<bool> d_parallelRefit; ///< If true, the cells of each level of the hierarchy are refitted in parallel
+
     typedef core::CollisionElementIterator ChildIterator;
     typedef sofa::defaulttype::Vec3Types DataTypes;
     typedef Cube Element;
@@ -89,6 +103,7 @@ public:
 protected:
     CubeCollisionModel();
 public:
+    void init() override;
     void resize(sofa::Size size) override;
 
     void setParentOf(sofa::Index childIndex, const sofa::type::Vec3& min, const sofa::type::Vec3& max);
@@ -119,6 +134,10 @@ public:
 
     const CubeData & getCubeData(sofa::Index index)const{return elems[index];}
 
+    /// Identifier of the content of the hierarchy. It changes each time the hierarchy is built or partially rebuilt, but
+    /// not when it is only refitted: as long as it is unchanged, the cells of all the levels contain the same elements.
+    std::size_t getTreeRevision() const { return m_treeRevision; }
+
     // -- CollisionModel interface
 
     /**
@@ -129,6 +148,8 @@ public:
       *The division is done only if the box contains more than 4 final CollisionElements and if the depth doesn't exceed
       *the max depth. The division is made along an axis. This axis corresponds to the biggest dimension of the current bounding box.
       *Note : a bounding box is a Cube here.
+      *If the number of elements did not change since the last call, the existing hierarchy is only refitted from the bottom
+      *to the top. The subtrees of the cells whose children grew more than rebuildThreshold in surface area are then rebuilt.
       */
     void computeBoundingTree(int maxDepth=0) override;
 
@@ -143,6 +164,24 @@ public:
     sofa::Index addCube(Cube subcellsBegin, Cube subcellsEnd);
     void updateCube(sofa::Index index);
     void updateCubes();
+    /// Same as updateCubes, the cells being updated in parallel
+    void updateCubes(simulation::TaskScheduler& taskScheduler);
+
+protected:
+    /// Compute the bounding box and the normal cone of a cell from the range of cells [begin, end)
+    void updateCube(sofa::Index index, const Cube& begin, const Cube& end);
+
+    /// Rebuild the subtree of a cell containing the range of leaf cells [leafBegin, leafEnd) of the model leaves.
+    /// The structure of the subtree only depends on the number of leaves, so that the cells keep their indices, only the
+    /// leaf cells are reordered.
+    void rebuildSubtree(sofa::Index index, sofa::Index leafBegin, sofa::Index leafEnd, CubeCollisionModel* leaves);
+
+    /// Rebuild the subtrees of the cells whose children grew more than threshold in surface area, starting from the cell index.
+    /// @return true if at least one subtree was rebuilt
+    bool rebuildDegradedSubtrees(sofa::Index index, sofa::Index leafBegin, sofa::Index leafEnd, SReal threshold, CubeCollisionModel* leaves);
+
+    /// Give a new revision to this model and to the levels of its hierarchy
+    void updateTreeRevision(const std::list<CubeCollisionModel*>& levels);
 };
 
 inline Cube::Cube(CubeCollisionModel* model, Index index)
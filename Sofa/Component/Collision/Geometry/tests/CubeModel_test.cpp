@@ -0,0 +1,259 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/component/collision/geometry/CubeModel.h>
+using sofa::component::collision::geometry::Cube;
+using sofa::component::collision::geometry::CubeCollisionModel;
+
+#include <sofa/testing/BaseTest.h>
+using sofa::testing::BaseTest;
+
+#include <sofa/type/Vec.h>
+using sofa::type::Vec3;
+
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/TaskScheduler.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace sofa
+{
+
+struct CubeModel_test : public BaseTest
+{
+    static constexpr sofa::Size nbElements = 200;
+
+    /// Boxes of unit size centered on points regularly distributed along a line
+    static void setLineBoxes(CubeCollisionModel* leaves, const Vec3& direction)
+    {
+        for (sofa::Index i = 0; i < nbElements; ++i)
+        {
+            const Vec3 center = direction * static_cast<SReal>(i);
+            leaves->setParentOf(i, center - Vec3(0.5, 0.5, 0.5), center + Vec3(0.5, 0.5, 0.5));
+        }
+    }
+
+    static CubeCollisionModel::SPtr createTree()
+    {
+        auto leaves = sofa::core::objectmodel::New<CubeCollisionModel>();
+        leaves->resize(nbElements);
+        setLineBoxes(leaves.get(), Vec3(1, 0, 0));
+        leaves->computeBoundingTree(6);
+        return leaves;
+    }
+
+    /// Check that each cell of the hierarchy contains its subcells, and that each leaf cell is reached once
+    static void checkHierarchy(CubeCollisionModel* leaves)
+    {
+        std::vector<unsigned int> nbVisits(leaves->getSize(), 0);
+        checkCell(Cube(static_cast<CubeCollisionModel*>(leaves->getFirst()), 0), leaves, nbVisits);
+        for (const auto n : nbVisits)
+        {
+            EXPECT_EQ(n, 1u);
+        }
+    }
+
+    static void checkCell(const Cube& cell, CubeCollisionModel* leaves, std::vector<unsigned int>& nbVisits)
+    {
+        for (Cube c = cell.subcells().first; c != cell.subcells().second; ++c)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                EXPECT_LE(cell.minVect()[j], c.minVect()[j]);
+                EXPECT_GE(cell.maxVect()[j], c.maxVect()[j]);
+            }
+            if (c.getCollisionModel() == leaves)
+            {
+                ++nbVisits[c.getIndex()];
+            }
+            else
+            {
+                checkCell(c, leaves, nbVisits);
+            }
+        }
+    }
+
+    /// Sum of the volumes of the cells directly below the root
+    static SReal firstLevelVolume(CubeCollisionModel* leaves)
+    {
+        SReal volume = 0;
+        const Cube root(static_cast<CubeCollisionModel*>(leaves->getFirst()), 0);
+        for (Cube c = root.subcells().first; c != root.subcells().second; ++c)
+        {
+            const Vec3 l = c.maxVect() - c.minVect();
+            volume += l[0] * l[1] * l[2];
+        }
+        return volume;
+    }
+};
+
+TEST_F(CubeModel_test, refit)
+{
+    const auto leaves = createTree();
+    const auto revision = leaves->getTreeRevision();
+    checkHierarchy(leaves.get());
+
+    setLineBoxes(leaves.get(), Vec3(0, 2, 0));
+    leaves->computeBoundingTree(6);
+
+    // the structure of the tree did not change, only the boxes
+    EXPECT_EQ(leaves->getTreeRevision(), revision);
+    checkHierarchy(leaves.get());
+
+    const Cube root(static_cast<CubeCollisionModel*>(leaves->getFirst()), 0);
+    EXPECT_EQ(root.minVect(), Vec3(-0.5, -0.5, -0.5));
+    EXPECT_EQ(root.maxVect(), Vec3(0.5, 2 * (nbElements - 1) + 0.5, 0.5));
+}
+
+TEST_F(CubeModel_test, rebuildDegradedSubtrees)
+{
+    const auto refitted = createTree();
+    const auto rebuilt = createTree();
+    rebuilt->d_rebuildThreshold.setValue(1.5);
+    const auto revision = rebuilt->getTreeRevision();
+
+    // shuffle the boxes: the cells built along the x axis now overlap each other
+    std::vector<sofa::Index> order(nbElements);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(0));
+    for (auto* leaves : {refitted.get(), rebuilt.get()})
+    {
+        for (sofa::Index i = 0; i < nbElements; ++i)
+        {
+            const Vec3 center(static_cast<SReal>(order[i]), 0, 0);
+            leaves->setParentOf(i, center - Vec3(0.5, 0.5, 0.5), center + Vec3(0.5, 0.5, 0.5));
+        }
+        leaves->computeBoundingTree(6);
+        checkHierarchy(leaves);
+    }
+
+    EXPECT_NE(rebuilt->getTreeRevision(), revision);
+    EXPECT_LT(firstLevelVolume(rebuilt.get()), 0.75 * firstLevelVolume(refitted.get()));
+
+    // the leaf cells are reordered, but still point to each element once
+    std::vector<unsigned int> nbVisits(nbElements, 0);
+    for (sofa::Index i = 0; i < nbElements; ++i)
+    {
+        ++nbVisits[rebuilt->getLeafIndex(i)];
+    }
+    for (const auto n : nbVisits)
+    {
+        EXPECT_EQ(n, 1u);
+    }
+}
+
+TEST_F(CubeModel_test, rebuildOnResize)
+{
+    const auto leaves = createTree();
+    const auto revision = leaves->getTreeRevision();
+
+    leaves->resize(nbElements / 2);
+    for (sofa::Index i = 0; i < nbElements / 2; ++i)
+    {
+        const Vec3 corner(static_cast<SReal>(i), 0, 0);
+        leaves->setParentOf(i, corner, corner + Vec3(1, 1, 1));
+    }
+    leaves->computeBoundingTree(6);
+
+    EXPECT_NE(leaves->getTreeRevision(), revision);
+}
+
+TEST_F(CubeModel_test, parallelRefit)
+{
+    // deep enough for the lowest levels to be refitted in parallel
+    constexpr sofa::Size nbBoxes = 8192;
+    constexpr int maxDepth = 11;
+
+    auto* taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    ASSERT_NE(taskScheduler, nullptr);
+    if (taskScheduler->getThreadCount() < 2)
+    {
+        taskScheduler->init(2);
+    }
+
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<SReal> position(0, 100);
+    const auto setRandomBoxes = [&generator, &position](const std::vector<CubeCollisionModel*>& models)
+    {
+        for (sofa::Index i = 0; i < nbBoxes; ++i)
+        {
+            const Vec3 center(position(generator), position(generator), position(generator));
+            for (auto* leaves : models)
+            {
+                leaves->setParentOf(i, center - Vec3(0.5, 0.5, 0.5), center + Vec3(0.5, 0.5, 0.5));
+            }
+        }
+    };
+
+    const auto sequential = sofa::core::objectmodel::New<CubeCollisionModel>();
+    const auto parallel = sofa::core::objectmodel::New<CubeCollisionModel>();
+    parallel->d_parallelRefit.setValue(true);
+    for (auto* leaves : {sequential.get(), parallel.get()})
+    {
+        leaves->resize(nbBoxes);
+    }
+    setRandomBoxes({sequential.get(), parallel.get()});
+    sequential->computeBoundingTree(maxDepth);
+    parallel->computeBoundingTree(maxDepth);
+
+    setRandomBoxes({sequential.get(), parallel.get()});
+    sequential->computeBoundingTree(maxDepth);
+    parallel->computeBoundingTree(maxDepth);
+    checkHierarchy(parallel.get());
+
+    // same cells on each level
+    sofa::Size largestLevel = 0;
+    auto* sequentialLevel = static_cast<CubeCollisionModel*>(sequential->getPrevious());
+    auto* parallelLevel = static_cast<CubeCollisionModel*>(parallel->getPrevious());
+    while (sequentialLevel != nullptr && parallelLevel != nullptr)
+    {
+        sofa::type::vector<std::pair<Vec3, Vec3> > sequentialCells, parallelCells;
+        sequentialLevel->getBoundingTree(sequentialCells);
+        parallelLevel->getBoundingTree(parallelCells);
+        EXPECT_EQ(parallelCells, sequentialCells);
+        largestLevel = std::max(largestLevel, parallelLevel->getSize());
+
+        sequentialLevel = static_cast<CubeCollisionModel*>(sequentialLevel->getPrevious());
+        parallelLevel = static_cast<CubeCollisionModel*>(parallelLevel->getPrevious());
+    }
+    EXPECT_EQ(sequentialLevel, parallelLevel);
+    EXPECT_GE(largestLevel, 512u);
+}
+
+TEST_F(CubeModel_test, rebuildThresholdBelowOne)
+{
+    const auto leaves = sofa::core::objectmodel::New<CubeCollisionModel>();
+
+    {
+        EXPECT_MSG_NOEMIT(Warning);
+        leaves->d_rebuildThreshold.setValue(2);
+        leaves->init();
+    }
+    {
+        EXPECT_MSG_EMIT(Warning);
+        leaves->d_rebuildThreshold.setValue(0.5);
+        leaves->init();
+    }
+}
+
+}
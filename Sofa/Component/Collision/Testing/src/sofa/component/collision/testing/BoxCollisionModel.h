@@ -0,0 +1,105 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/component/collision/geometry/CubeModel.h>
+#include <sofa/core/CollisionModel.h>
+#include <sofa/type/Vec.h>
+
+#include <cmath>
+#include <vector>
+
+namespace sofa::collision_test
+{
+
+/// Collision model made of unit boxes, stored in a bounding tree of CubeCollisionModel's
+class BoxCollisionModel : public sofa::core::CollisionModel
+{
+public:
+    SOFA_CLASS(BoxCollisionModel, sofa::core::CollisionModel);
+
+    std::vector<sofa::type::Vec3> centers;
+
+    void computeBoundingTree(int maxDepth) override
+    {
+        using sofa::component::collision::geometry::CubeCollisionModel;
+
+        CubeCollisionModel* cubeModel = createPrevious<CubeCollisionModel>();
+        if (centers.size() != size)
+        {
+            resize(static_cast<sofa::Size>(centers.size()));
+            cubeModel->resize(0);
+        }
+        cubeModel->resize(size);
+        for (sofa::Index i = 0; i < size; ++i)
+        {
+            const auto [min, max] = getBox(i);
+            cubeModel->setParentOf(i, min, max);
+        }
+        cubeModel->computeBoundingTree(maxDepth);
+    }
+
+    /// Corners of the box i
+    std::pair<sofa::type::Vec3, sofa::type::Vec3> getBox(sofa::Index i) const
+    {
+        const sofa::type::Vec3 halfSize(0.5, 0.5, 0.5);
+        return {centers[i] - halfSize, centers[i] + halfSize};
+    }
+
+    /// Plate of n x n boxes in the plane y = height, deformed by a wave, and rotated around the y axis
+    void setPlate(const unsigned int n, const SReal height, const SReal phase, const SReal angle = 0)
+    {
+        centers.clear();
+        const SReal c = 0.5 * static_cast<SReal>(n);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            for (unsigned int j = 0; j < n; ++j)
+            {
+                const SReal x = static_cast<SReal>(i) - c;
+                const SReal z = static_cast<SReal>(j) - c;
+                const SReal y = height + 0.5 * std::sin(0.3 * x + phase) * std::cos(0.2 * z);
+                centers.emplace_back(c + std::cos(angle) * x - std::sin(angle) * z, y, c + std::sin(angle) * x + std::cos(angle) * z);
+            }
+        }
+    }
+};
+
+/// Test if two axis-aligned boxes overlap
+inline bool overlap(const sofa::type::Vec3& min1, const sofa::type::Vec3& max1, const sofa::type::Vec3& min2, const sofa::type::Vec3& max2)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        if (min1[i] > max2[i] || min2[i] > max1[i])
+            return false;
+    }
+    return true;
+}
+
+/// Test if the boxes of two collision elements of BoxCollisionModel's overlap
+inline bool boxesOverlap(sofa::core::CollisionElementIterator elem1, sofa::core::CollisionElementIterator elem2)
+{
+    const auto [min1, max1] = static_cast<BoxCollisionModel*>(elem1.getCollisionModel())->getBox(elem1.getIndex());
+    const auto [min2, max2] = static_cast<BoxCollisionModel*>(elem2.getCollisionModel())->getBox(elem2.getIndex());
+    return overlap(min1, max1, min2, max2);
+}
+
+} // namespace sofa::collision_test
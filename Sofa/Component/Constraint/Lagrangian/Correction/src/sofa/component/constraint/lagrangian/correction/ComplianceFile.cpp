@@ -0,0 +1,347 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/component/constraint/lagrangian/correction/ComplianceFile.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace sofa::component::constraint::lagrangian::correction::compliance
+{
+
+namespace
+{
+
+/// Number of scalars converted at once when writing a matrix in another precision
+constexpr std::uint64_t conversionBlockSize = 1 << 16;
+
+template<class Real>
+bool writeMatrix(const std::string& filename, const Real* matrix, const std::uint64_t nbRows,
+                 const std::uint64_t nbCols, const std::uint64_t parametersChecksum, const bool singlePrecision)
+{
+    FileHeader header;
+    header.scalarSize = singlePrecision ? sizeof(float) : sizeof(double);
+    header.nbRows = nbRows;
+    header.nbCols = nbCols;
+    header.parametersChecksum = parametersChecksum;
+    header.headerChecksum = computeHeaderChecksum(header);
+
+    const std::string temporaryFilename = filename + ".tmp";
+    {
+        std::ofstream file(temporaryFilename, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+
+        const std::uint64_t size = nbRows * nbCols;
+        const auto write = [&file, matrix, size](auto scalar)
+        {
+            using StoredReal = decltype(scalar);
+            if constexpr (std::is_same_v<StoredReal, Real>)
+            {
+                file.write(reinterpret_cast<const char*>(matrix), size * sizeof(Real));
+            }
+            else
+            {
+                std::vector<StoredReal> block;
+                for (std::uint64_t begin = 0; begin < size; begin += conversionBlockSize)
+                {
+                    const std::uint64_t end = std::min(size, begin + conversionBlockSize);
+                    block.assign(matrix + begin, matrix + end);
+                    file.write(reinterpret_cast<const char*>(block.data()), block.size() * sizeof(StoredReal));
+                }
+            }
+        };
+
+        if (singlePrecision)
+        {
+            write(float{});
+        }
+        else
+        {
+            write(double{});
+        }
+
+        if (!file.good())
+        {
+            file.close();
+            std::error_code error;
+            std::filesystem::remove(temporaryFilename, error);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryFilename, filename, error);
+    if (error)
+    {
+        std::filesystem::remove(temporaryFilename, error);
+        return false;
+    }
+    return true;
+}
+
+std::uint64_t computeRecordChecksum(const std::uint64_t firstColumn, const std::uint64_t nbColumns,
+                                    const double* columns, const std::uint64_t nbRows)
+{
+    Checksum checksum;
+    checksum.add(firstColumn);
+    checksum.add(nbColumns);
+    checksum.add(columns, nbRows * nbColumns * sizeof(double));
+    return checksum.value();
+}
+
+/// Read the valid records of a checkpoint, and return the size of the file up to the last valid record
+std::uint64_t readCheckpoint(std::ifstream& file, const CheckpointHeader& header,
+                             const ComplianceCheckpoint::ColumnsCallback& readColumns)
+{
+    std::uint64_t validSize = sizeof(CheckpointHeader);
+    std::vector<double> columns;
+
+    CheckpointRecord record;
+    while (file.read(reinterpret_cast<char*>(&record), sizeof(CheckpointRecord)))
+    {
+        // a corrupted record may contain any number of columns
+        if (record.nbColumns == 0 || record.nbColumns > header.nbRows
+            || record.firstColumn > header.nbRows - record.nbColumns)
+        {
+            break;
+        }
+
+        columns.resize(header.nbRows * record.nbColumns);
+        if (!file.read(reinterpret_cast<char*>(columns.data()), columns.size() * sizeof(double))
+            || record.checksum != computeRecordChecksum(record.firstColumn, record.nbColumns, columns.data(), header.nbRows))
+        {
+            break;
+        }
+
+        if (readColumns)
+        {
+            readColumns(record.firstColumn, record.nbColumns, columns.data());
+        }
+        validSize += sizeof(CheckpointRecord) + columns.size() * sizeof(double);
+    }
+
+    return validSize;
+}
+
+}
+
+void Checksum::add(const void* data, const std::size_t size)
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        m_value ^= bytes[i];
+        m_value *= 1099511628211ull;
+    }
+}
+
+void Checksum::add(const std::string& value)
+{
+    add(static_cast<std::uint64_t>(value.size()));
+    add(value.data(), value.size());
+}
+
+std::uint64_t computeHeaderChecksum(FileHeader header)
+{
+    header.headerChecksum = 0;
+    Checksum checksum;
+    checksum.add(&header, sizeof(FileHeader));
+    return checksum.value();
+}
+
+bool isComplianceFile(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    std::array<char, 8> magic {};
+    file.read(magic.data(), magic.size());
+    return file.good() && magic == FileMagic;
+}
+
+bool writeComplianceFile(const std::string& filename, const float* matrix, const std::uint64_t nbRows,
+                         const std::uint64_t nbCols, const std::uint64_t parametersChecksum, const bool singlePrecision)
+{
+    return writeMatrix(filename, matrix, nbRows, nbCols, parametersChecksum, singlePrecision);
+}
+
+bool writeComplianceFile(const std::string& filename, const double* matrix, const std::uint64_t nbRows,
+                         const std::uint64_t nbCols, const std::uint64_t parametersChecksum, const bool singlePrecision)
+{
+    return writeMatrix(filename, matrix, nbRows, nbCols, parametersChecksum, singlePrecision);
+}
+
+bool ComplianceFile::open(const std::string& filename)
+{
+    close();
+
+    if (!m_file.open(filename))
+    {
+        m_lastError = "cannot open " + filename + ": " + m_file.getLastError();
+        return false;
+    }
+
+    const auto fail = [this](const std::string& error)
+    {
+        m_lastError = error;
+        close();
+        return false;
+    };
+
+    if (m_file.size() < sizeof(FileHeader))
+    {
+        return fail(filename + " is not a compliance file");
+    }
+
+    std::memcpy(&m_header, m_file.data(), sizeof(FileHeader));
+
+    if (m_header.magic != FileMagic)
+    {
+        return fail(filename + " is not a compliance file");
+    }
+    if (m_header.version > FormatVersion)
+    {
+        return fail(filename + " has been written with a newer version of the format ("
+            + std::to_string(m_header.version) + ")");
+    }
+    if (m_header.headerChecksum != computeHeaderChecksum(m_header))
+    {
+        return fail(filename + " has a corrupted header");
+    }
+    if (m_header.scalarSize != sizeof(float) && m_header.scalarSize != sizeof(double))
+    {
+        return fail(filename + " has an unsupported scalar size (" + std::to_string(m_header.scalarSize) + ")");
+    }
+    if (m_header.payloadOffset % m_header.scalarSize != 0
+        || m_file.size() < m_header.payloadOffset + m_header.nbRows * m_header.nbCols * m_header.scalarSize)
+    {
+        return fail(filename + " is truncated");
+    }
+
+    return true;
+}
+
+void ComplianceFile::close()
+{
+    m_file.close();
+    m_header = FileHeader{};
+}
+
+bool ComplianceCheckpoint::open(const std::string& filename, const std::uint64_t nbRows,
+                                const std::uint64_t parametersChecksum, const ColumnsCallback& readColumns)
+{
+    close();
+    m_filename = filename;
+    m_nbRows = nbRows;
+
+    std::uint64_t validSize = 0;
+    {
+        std::ifstream file(filename, std::ios::binary);
+        CheckpointHeader header;
+        if (file.read(reinterpret_cast<char*>(&header), sizeof(CheckpointHeader))
+            && header.magic == CheckpointMagic && header.version == FormatVersion
+            && header.nbRows == nbRows && header.parametersChecksum == parametersChecksum)
+        {
+            validSize = readCheckpoint(file, header, readColumns);
+        }
+    }
+
+    if (validSize > 0)
+    {
+        // discard a record which has not been completely written
+        std::error_code error;
+        std::filesystem::resize_file(filename, validSize, error);
+        if (error)
+        {
+            m_lastError = "cannot resize " + filename + ": " + error.message();
+            return false;
+        }
+        m_file.open(filename, std::ios::binary | std::ios::app);
+    }
+    else
+    {
+        CheckpointHeader header;
+        header.nbRows = nbRows;
+        header.parametersChecksum = parametersChecksum;
+
+        m_file.open(filename, std::ios::binary | std::ios::trunc);
+        m_file.write(reinterpret_cast<const char*>(&header), sizeof(CheckpointHeader));
+        m_file.flush();
+    }
+
+    if (!m_file.good())
+    {
+        m_lastError = "cannot write " + filename;
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool ComplianceCheckpoint::append(const std::uint64_t firstColumn, const std::uint64_t nbColumns, const double* columns)
+{
+    if (!isOpen())
+    {
+        return false;
+    }
+
+    CheckpointRecord record;
+    record.firstColumn = firstColumn;
+    record.nbColumns = nbColumns;
+    record.checksum = computeRecordChecksum(firstColumn, nbColumns, columns, m_nbRows);
+
+    m_file.write(reinterpret_cast<const char*>(&record), sizeof(CheckpointRecord));
+    m_file.write(reinterpret_cast<const char*>(columns), m_nbRows * nbColumns * sizeof(double));
+    m_file.flush();
+
+    if (!m_file.good())
+    {
+        m_lastError = "cannot write " + m_filename;
+        return false;
+    }
+    return true;
+}
+
+void ComplianceCheckpoint::close()
+{
+    if (m_file.is_open())
+    {
+        m_file.close();
+    }
+    m_file.clear();
+}
+
+void ComplianceCheckpoint::remove()
+{
+    close();
+    if (!m_filename.empty())
+    {
+        std::error_code error;
+        std::filesystem::remove(m_filename, error);
+    }
+}
+
+} // namespace sofa::component::constraint::lagrangian::correction::compliance
@@ -0,0 +1,222 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/constraint/lagrangian/correction/config.h>
+
+#include <sofa/helper/system/MemoryMappedFile.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+namespace sofa::component::constraint::lagrangian::correction::compliance
+{
+
+/**
+ * Binary format of the compliance matrices precomputed by PrecomputedConstraintCorrection.
+ *
+ * Layout of a file:
+ * - a fixed-size FileHeader
+ * - the dense nbRows x nbCols matrix, row-major, starting at FileHeader::payloadOffset
+ *
+ * The scalars are stored in single or double precision. A matrix stored with the precision of the
+ * simulation is used directly from the mapped file: its pages are loaded lazily and shared between
+ * all the processes mapping the same file.
+ *
+ * FileHeader::parametersChecksum identifies the parameters which the compliance depends on (mesh,
+ * material, time step), so that a compliance computed with other parameters is detected.
+ * FileHeader::headerChecksum is the checksum of the header itself, computed with headerChecksum = 0.
+ *
+ * Files written before this format are raw dumps of the matrix, without any header.
+ */
+
+constexpr std::array<char, 8> FileMagic { 'S', 'O', 'F', 'A', 'C', 'M', 'P', '\0' };
+constexpr std::uint32_t FormatVersion = 1;
+
+struct FileHeader
+{
+    std::array<char, 8> magic { FileMagic };
+    std::uint32_t version { FormatVersion };
+    std::uint32_t headerSize { sizeof(FileHeader) };
+    /// 4 for single precision, 8 for double precision
+    std::uint32_t scalarSize { sizeof(double) };
+    std::uint32_t reserved { 0 };
+    std::uint64_t nbRows { 0 };
+    std::uint64_t nbCols { 0 };
+    std::uint64_t parametersChecksum { 0 };
+    std::uint64_t payloadOffset { sizeof(FileHeader) };
+    std::uint64_t headerChecksum { 0 };
+};
+static_assert(sizeof(FileHeader) == 64);
+
+/// 64-bit FNV-1a hash. Unlike std::hash, its value does not depend on the platform or the process.
+class SOFA_COMPONENT_CONSTRAINT_LAGRANGIAN_CORRECTION_API Checksum
+{
+public:
+    void add(const void* data, std::size_t size);
+
+    void add(const std::string& value);
+
+    template<class T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+    void add(T value)
+    {
+        add(&value, sizeof(T));
+    }
+
+    std::uint64_t value() const { return m_value; }
+
+private:
+    std::uint64_t m_value { 14695981039346656037ull };
+};
+
+SOFA_COMPONENT_CONSTRAINT_LAGRANGIAN_CORRECTION_API std::uint64_t computeHeaderChecksum(FileHeader header);
+
+/// Check the magic number at the beginning of a file
+SOFA_COMPONENT_CONSTRAINT_LAGRANGIAN_CORRECTION_API bool isComplianceFile(const std::string& filename);
+
+/// Write a nbRows x nbCols row-major matrix, in single precision if singlePrecision is true.
+/// The file is written under a temporary name, then renamed: the processes which mapped a previous
+/// version of the file keep reading the previous version.
+SOFA_COMPONENT_CONSTRAINT_LAGRANGIAN_CORRECTION_API bool writeComplianceFile(const std::string& filename,
+    const float* matrix, std::uint64_t nbRows, std::uint64_t nbCols, std::uint64_t parametersChecksum, bool singlePrecision);
+SOFA_COMPONENT_CONSTRAINT_LAGRANGIAN_CORRECTION_API bool writeComplianceFile(const std::string& filename,
+    const double* matrix, std::uint64_t nbRows, std::uint64_t nbCols, std::uint64_t parametersChecksum, bool singlePrecision);
+
+/// Compliance file mapped in memory, read-only
+class SOFA_COMPONENT_CONSTRAINT_LAGRANGIAN_CORRECTION_API ComplianceFile
+{
+public:
+    /// Map the file and check its header and its size
+    bool open(const std::string& filename);
+    void close();
+
+    bool isOpen() const { return m_file.isOpen(); }
+
+    const FileHeader& getHeader() const { return m_header; }
+
+    /// The matrix in the mapped memory if it is stored with the precision of Real, nullptr otherwise
+    template<class Real>
+    const Real* getMatrix() const
+    {
+        if (!isOpen() || m_header.scalarSize != sizeof(Real))
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<const Real*>(m_file.data() + m_header.payloadOffset);
+    }
+
+    /// Copy the matrix into a buffer of nbRows * nbCols scalars, converting it to the precision of Real
+    template<class Real>
+    void copyMatrix(Real* matrix) const
+    {
+        const std::uint64_t size = m_header.nbRows * m_header.nbCols;
+        if (const auto* singlePrecision = getMatrix<float>())
+        {
+            std::copy(singlePrecision, singlePrecision + size, matrix);
+        }
+        else if (const auto* doublePrecision = getMatrix<double>())
+        {
+            std::copy(doublePrecision, doublePrecision + size, matrix);
+        }
+    }
+
+    /// Description of the last error which occurred in open()
+    const std::string& getLastError() const { return m_lastError; }
+
+private:
+    helper::system::MemoryMappedFile m_file;
+    FileHeader m_header;
+    std::string m_lastError;
+};
+
+/**
+ * Columns of a compliance matrix saved while it is precomputed, so that an interrupted precomputation
+ * can be resumed.
+ *
+ * Layout of a file:
+ * - a fixed-size CheckpointHeader
+ * - a sequence of records, each made of a CheckpointRecord followed by nbColumns columns of nbRows
+ *   scalars in double precision
+ *
+ * A record is appended once its columns are computed. A record which has not been completely
+ * written (e.g. the process was killed) is detected with its checksum, and discarded.
+ */
+
+constexpr std::array<char, 8> CheckpointMagic { 'S', 'O', 'F', 'A', 'C', 'K', 'P', '\0' };
+
+struct CheckpointHeader
+{
+    std::array<char, 8> magic { CheckpointMagic };
+    std::uint32_t version { FormatVersion };
+    std::uint32_t reserved { 0 };
+    std::uint64_t nbRows { 0 };
+    std::uint64_t parametersChecksum { 0 };
+};
+static_assert(sizeof(CheckpointHeader) == 32);
+
+struct CheckpointRecord
+{
+    std::uint64_t firstColumn { 0 };
+    std::uint64_t nbColumns { 0 };
+    /// Checksum of firstColumn, nbColumns and of the columns
+    std::uint64_t checksum { 0 };
+};
+static_assert(sizeof(CheckpointRecord) == 24);
+
+class SOFA_COMPONENT_CONSTRAINT_LAGRANGIAN_CORRECTION_API ComplianceCheckpoint
+{
+public:
+    /// Called for each record read from an existing checkpoint: columns is a nbRows x nbColumns column-major block
+    using ColumnsCallback = std::function<void(std::uint64_t firstColumn, std::uint64_t nbColumns, const double* columns)>;
+
+    /**
+     * Open a checkpoint for appending. If the file exists and has been written for a matrix with the
+     * same number of rows and the same parameters, its valid records are passed to readColumns first.
+     * Otherwise, the file is replaced by an empty checkpoint.
+     */
+    bool open(const std::string& filename, std::uint64_t nbRows, std::uint64_t parametersChecksum,
+              const ColumnsCallback& readColumns);
+
+    /// Append nbColumns columns of nbRows scalars, column-major, and flush them to the disk
+    bool append(std::uint64_t firstColumn, std::uint64_t nbColumns, const double* columns);
+
+    void close();
+
+    /// Close and delete the file, once the full matrix has been saved
+    void remove();
+
+    bool isOpen() const { return m_file.is_open(); }
+
+    const std::string& getLastError() const { return m_lastError; }
+
+private:
+    std::string m_filename;
+    std::ofstream m_file;
+    std::uint64_t m_nbRows { 0 };
+    std::string m_lastError;
+};
+
+} // namespace sofa::component::constraint::lagrangian::correction::compliance
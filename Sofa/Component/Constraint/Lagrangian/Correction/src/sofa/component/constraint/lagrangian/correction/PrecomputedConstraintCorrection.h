@@ -21,6 +21,7 @@
 ******************************************************************************/
 #pragma once
 #include <sofa/component/constraint/lagrangian/correction/config.h>
+#include <sofa/component/constraint/lagrangian/correction/ComplianceFile.h>
 
 #include <sofa/core/behavior/ConstraintCorrection.h>
 #include <sofa/core/objectmodel/DataFileName.h>
@@ -32,6 +33,11 @@
 
 #include <sofa/core/objectmodel/RenamedData.h>
 
+namespace sofa::component::odesolver::backward
+{
+class EulerImplicitSolver;
+}
+
 namespace sofa::component::constraint::lagrangian::correction
 {
 
@@ -85,6 +91,9 @@ public:
     Data<SReal> d_debugViewFrameScale; ///< Scale on computed node's frame
     sofa::core::objectmodel::DataFileName d_fileCompliance; ///< Precomputed compliance matrix data file
     Data<std::string> d_fileDir; ///< If not empty, the compliance will be saved in this repertory
+    Data<bool> d_singlePrecisionFile; ///< If true, the compliance is saved in single precision
+    Data<bool> d_batchedPrecomputation; ///< If true, the system is factorized once and the columns of the compliance are solved by batches, in parallel
+    Data<unsigned int> d_batchSize; ///< Number of columns of the compliance solved at once by a task of the batched precomputation
     
 protected:
     PrecomputedConstraintCorrection(sofa::core::behavior::MechanicalState<DataTypes> *mm = nullptr);
@@ -141,12 +150,19 @@ public:
     {
         Real* data;
         int nbref;
+
+        /// Compliance file stored with the precision of Real. The matrix is used directly from the mapped memory,
+        /// which is shared with the other processes mapping the same file.
+        compliance::ComplianceFile file;
+
         InverseStorage() : data(nullptr), nbref(0) {}
+
+        const Real* getData() const { return data ? data : file.template getMatrix<Real>(); }
     };
 
     std::string invName;
     InverseStorage* invM;
-    Real* appCompliance;
+    const Real* appCompliance;
     unsigned int dimensionAppCompliance;
 
     static std::map<std::string, InverseStorage>& getInverseMap()
@@ -178,10 +194,10 @@ public:
     std::list<int> constraint_dofs;		// list of indices of each point which is involve with constraint
 
 public:
-    Real* getInverse()
+    const Real* getInverse()
     {
-        if (invM->data)
-            return invM->data;
+        if (invM->getData())
+            return invM->getData();
         else
             msg_error() << "Inverse is not computed yet";
         return nullptr;
@@ -195,10 +211,48 @@ protected:
      */
     bool loadCompliance(std::string fileName);
 
+    /**
+     * @brief Read the compliance matrix from a file, either a versioned compliance file, which is mapped in memory
+     * if possible, or a raw file.
+     *
+     * @return Reading success.
+     */
+    bool readCompliance(const std::string& path);
+
+    /**
+     * @brief Checksum of the parameters the compliance depends on: time step, rest positions, the parameters of
+     * the force fields, masses and projective constraints of the node, the parameters of the EulerImplicitSolver and
+     * the elements of the topology.
+     */
+    std::uint64_t computeParametersChecksum();
+
+    /// Checksum of the parameters, computed at initialization
+    std::uint64_t m_parametersChecksum { 0 };
+
     /**
      * @brief Save compliance matrix into a file.
+     *
+     * @return Saving success.
+     */
+    bool saveCompliance(const std::string& fileName);
+
+    /**
+     * @brief Path where the compliance file is saved: in fileDir if it is set, in the first path of the data
+     * repository otherwise.
+     */
+    std::string getComplianceSavePath(const std::string& fileName) const;
+
+    /**
+     * @brief Precompute the compliance by factorizing the system matrix of the implicit Euler scheme once, then
+     * solving its columns by batches of batchSize right-hand sides, in parallel using the task scheduler.
+     * The computed columns are saved in a checkpoint file next to the compliance file, from which an interrupted
+     * precomputation is resumed.
+     *
+     * @return false if the system cannot be assembled or factorized: the compliance has then to be precomputed
+     * column by column.
      */
-    void saveCompliance(const std::string& fileName);
+    bool precomputeComplianceByBatches(const sofa::component::odesolver::backward::EulerImplicitSolver& eulerSolver,
+                                       const VecCoord& restPositions);
 
     /**
      * @brief Builds the compliance file name using the SOFA component internal data.
@@ -30,18 +30,32 @@
 #include <sofa/component/odesolver/backward/EulerImplicitSolver.h>
 
 #include <sofa/linearalgebra/SparseMatrix.h>
+#include <sofa/linearalgebra/EigenBaseSparseMatrix.h>
 #include <sofa/component/linearsolver/iterative/CGLinearSolver.h>
 
+#include <sofa/core/behavior/DefaultMultiMatrixAccessor.h>
+#include <sofa/simulation/MechanicalOperations.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/ParallelForEach.h>
+
 #include <sofa/core/behavior/RotationFinder.h>
+#include <sofa/core/behavior/BaseForceField.h>
+#include <sofa/core/behavior/BaseMass.h>
+#include <sofa/core/behavior/BaseProjectiveConstraintSet.h>
+#include <sofa/core/topology/BaseMeshTopology.h>
 
 #include <sofa/helper/system/FileRepository.h>
 #include <sofa/type/Quat.h>
 
 #include <sofa/simulation/fwd.h>
 
+#include <Eigen/SparseCholesky>
+
+#include <chrono>
 #include <fstream>
 #include <sstream>
 #include <list>
+#include <set>
 #include <iomanip>
 #include <sofa/helper/system/FileSystem.h>
 
@@ -59,6 +73,12 @@ PrecomputedConstraintCorrection<DataTypes>::PrecomputedConstraintCorrection(sofa
     , d_debugViewFrameScale(initData(&d_debugViewFrameScale, 1.0_sreal, "debugViewFrameScale", "Scale on computed node's frame"))
     , d_fileCompliance(initData(&d_fileCompliance, "fileCompliance", "Precomputed compliance matrix data file"))
     , d_fileDir(initData(&d_fileDir, "fileDir", "If not empty, the compliance will be saved in this repertory"))
+    , d_singlePrecisionFile(initData(&d_singlePrecisionFile, false, "singlePrecisionFile", "If true, the compliance is saved in single precision, which halves the size of the file. "
+                                                                                        "A compliance stored in another precision than the simulation is converted when it is loaded: it is not shared with the other processes using the same file."))
+    , d_batchedPrecomputation(initData(&d_batchedPrecomputation, false, "batchedPrecomputation", "If true, the system matrix of the EulerImplicitSolver is assembled and factorized once, then the columns of the compliance are solved by batches, in parallel using the task scheduler. "
+                                                                                                 "The computed columns are saved in a checkpoint file next to the compliance file, so that an interrupted precomputation is resumed. "
+                                                                                                 "The linear solver of the node is not used."))
+    , d_batchSize(initData(&d_batchSize, 32u, "batchSize", "Number of columns of the compliance solved at once by a task of the batched precomputation"))
     , invM(nullptr)
     , appCompliance(nullptr)
     , nbRows(0), nbCols(0), dof_on_node(0), nbNodes(0)
@@ -133,7 +153,7 @@ bool PrecomputedConstraintCorrection<DataTypes>::loadCompliance(std::string file
     invM = getInverse(fileName);
     dimensionAppCompliance = nbRows;
 
-    if (invM->data == nullptr)
+    if (invM->getData() == nullptr)
     {
         // Try to load from file
         msg_info() << "Try to load compliance from : " << fileName ;
@@ -142,17 +162,10 @@ bool PrecomputedConstraintCorrection<DataTypes>::loadCompliance(std::string file
         if (!dir.empty())
         {
             const std::string path = helper::system::FileSystem::append(dir, fileName);
-            std::ifstream compFileIn(path, std::ifstream::binary);
-            if (compFileIn.is_open())
+            if (helper::system::FileSystem::exists(path))
             {
-                invM->data = new Real[nbRows * nbCols];
-
                 msg_info() << "File " << path << " found. Loading..." ;
-
-                compFileIn.read((char*)invM->data, nbCols * nbRows * sizeof(Real));
-                compFileIn.close();
-
-                return true;
+                return readCompliance(path);
             }
             else
                 return false;
@@ -162,16 +175,8 @@ bool PrecomputedConstraintCorrection<DataTypes>::loadCompliance(std::string file
             std::stringstream ss;
             if (sofa::helper::system::DataRepository.findFile(fileName, "", &ss))
             {
-                invM->data = new Real[nbRows * nbCols];
-
-                std::ifstream compFileIn(fileName.c_str(), std::ifstream::binary);
-
                 msg_info() << "File " << fileName << " found. Loading..." ;
-
-                compFileIn.read((char*)invM->data, nbCols * nbRows * sizeof(Real));
-                compFileIn.close();
-
-                return true;
+                return readCompliance(fileName);
             }
             else
             {
@@ -186,31 +191,397 @@ bool PrecomputedConstraintCorrection<DataTypes>::loadCompliance(std::string file
     return true;
 }
 
+template<class DataTypes>
+bool PrecomputedConstraintCorrection<DataTypes>::readCompliance(const std::string& path)
+{
+    if (!compliance::isComplianceFile(path))
+    {
+        // raw file, written before the versioned format
+        std::ifstream compFileIn(path, std::ifstream::binary);
+        if (!compFileIn.is_open())
+            return false;
 
+        invM->data = new Real[nbRows * nbCols];
+        compFileIn.read((char*)invM->data, nbCols * nbRows * sizeof(Real));
+        compFileIn.close();
+
+        return true;
+    }
+
+    compliance::ComplianceFile file;
+    if (!file.open(path))
+    {
+        msg_error() << file.getLastError();
+        return false;
+    }
+
+    const compliance::FileHeader& header = file.getHeader();
+    if (header.nbRows != nbRows || header.nbCols != nbCols)
+    {
+        msg_error() << "The compliance in " << path << " is a " << header.nbRows << "x" << header.nbCols
+                    << " matrix, but a " << nbRows << "x" << nbCols << " matrix is expected";
+        return false;
+    }
+
+    if (header.parametersChecksum != m_parametersChecksum)
+    {
+        msg_warning() << "The compliance in " << path << " has been computed with other parameters "
+                         "(time step, rest positions, topology, mass, force fields, projective constraints or integration scheme)";
+        return false;
+    }
+
+    if (file.template getMatrix<Real>() != nullptr)
+    {
+        msg_info() << "The compliance is mapped in memory from " << path;
+        invM->file = std::move(file);
+    }
+    else
+    {
+        msg_info() << "The compliance is converted from " << (header.scalarSize == sizeof(float) ? "single" : "double") << " precision";
+        invM->data = new Real[nbRows * nbCols];
+        file.copyMatrix(invM->data);
+    }
+
+    return true;
+}
 
 template<class DataTypes>
-void PrecomputedConstraintCorrection<DataTypes>::saveCompliance(const std::string& fileName)
-{    
-    std::string filePathInSofaShare;
+std::uint64_t PrecomputedConstraintCorrection<DataTypes>::computeParametersChecksum()
+{
+    compliance::Checksum checksum;
+    checksum.add(static_cast<std::uint64_t>(nbRows));
+    checksum.add(static_cast<std::uint64_t>(dof_on_node));
+    checksum.add(static_cast<double>(this->getContext()->getDt()));
+
+    const VecCoord& restPositions = this->mstate->read(core::ConstVecCoordId::restPosition())->getValue();
+    for (const auto& coord : restPositions)
+    {
+        for (std::size_t i = 0; i < Coord::total_size; ++i)
+        {
+            checksum.add(static_cast<double>(coord[i]));
+        }
+    }
+
+    // The parameters of the components involved in the precomputation. The data of the base classes
+    // (name, printLog, tags...), the outputs (read-only data) and the visualization parameters are ignored.
+    const auto addComponent = [&checksum](core::objectmodel::BaseObject* component)
+    {
+        const std::set<const core::objectmodel::BaseData*> ignoredData {
+            &component->name, &component->f_printLog, &component->f_tags, &component->f_bbox,
+            &component->d_componentState, &component->f_listening
+        };
+
+        checksum.add(component->getClassName());
+        for (const core::objectmodel::BaseData* data : component->getDataFields())
+        {
+            if (ignoredData.count(data) || data->isReadOnly() || data->getGroup() == "Visualization")
+                continue;
+
+            checksum.add(data->getName());
+            checksum.add(data->getValueString());
+        }
+    };
+
+    for (auto* forceField : this->getContext()->template getObjects<core::behavior::BaseForceField>(core::objectmodel::BaseContext::Local))
+    {
+        addComponent(forceField);
+    }
+    for (auto* mass : this->getContext()->template getObjects<core::behavior::BaseMass>(core::objectmodel::BaseContext::Local))
+    {
+        addComponent(mass);
+    }
+    for (auto* constraint : this->getContext()->template getObjects<core::behavior::BaseProjectiveConstraintSet>(core::objectmodel::BaseContext::Local))
+    {
+        addComponent(constraint);
+    }
+
+    // the integration scheme (rayleighMass, rayleighStiffness, vdamping, trapezoidalScheme...)
+    sofa::component::odesolver::backward::EulerImplicitSolver* eulerSolver { nullptr };
+    this->getContext()->get(eulerSolver);
+    if (eulerSolver)
+    {
+        addComponent(eulerSolver);
+    }
+
+    // the elements of the topology, which may change while the rest positions and the data of the force fields do not
+    if (core::topology::BaseMeshTopology* topology = this->getContext()->getMeshTopology())
+    {
+        const auto addElements = [&checksum](const auto& elements)
+        {
+            checksum.add(static_cast<std::uint64_t>(elements.size()));
+            checksum.add(elements.data(), elements.size() * sizeof(typename std::decay_t<decltype(elements)>::value_type));
+        };
+        addElements(topology->getEdges());
+        addElements(topology->getTriangles());
+        addElements(topology->getQuads());
+        addElements(topology->getTetrahedra());
+        addElements(topology->getHexahedra());
+    }
+
+    return checksum.value();
+}
+
+
+
+template<class DataTypes>
+std::string PrecomputedConstraintCorrection<DataTypes>::getComplianceSavePath(const std::string& fileName) const
+{
     const std::string dir = d_fileDir.getValue();
     if (!dir.empty())
     {
-        filePathInSofaShare = helper::system::FileSystem::append(dir, fileName);
+        return helper::system::FileSystem::append(dir, fileName);
     }
-    else
+    return helper::system::FileSystem::append(sofa::helper::system::DataRepository.getFirstPath(), fileName);
+}
+
+template<class DataTypes>
+bool PrecomputedConstraintCorrection<DataTypes>::saveCompliance(const std::string& fileName)
+{    
+    const std::string filePathInSofaShare = getComplianceSavePath(fileName);
+
+    if (!compliance::writeComplianceFile(filePathInSofaShare, invM->data, nbRows, nbCols,
+                                         m_parametersChecksum, d_singlePrecisionFile.getValue()))
     {
-        filePathInSofaShare = helper::system::FileSystem::append(
-            sofa::helper::system::DataRepository.getFirstPath(), fileName);
+        msg_error() << "The compliance cannot be saved in " << filePathInSofaShare;
+        return false;
     }
 
     const bool printLog = this->f_printLog.getValue();
     this->f_printLog.setValue(true);
     msg_info() << "Compliance file has been saved in " << filePathInSofaShare << ". Load this file using fileCompliance if you don't want to recompute the compliance matrice at next start.";
     this->f_printLog.setValue(printLog);
+    return true;
+}
+
+
+
+template<class DataTypes>
+bool PrecomputedConstraintCorrection<DataTypes>::precomputeComplianceByBatches(
+    const sofa::component::odesolver::backward::EulerImplicitSolver& eulerSolver, const VecCoord& restPositions)
+{
+    using SparseMatrix = Eigen::SparseMatrix<double>;
+    using DenseMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>;
+
+    const SReal dt = this->getContext()->getDt();
+
+    // Same system as the one solved by EulerImplicitSolver::solve, with a null velocity: the velocity computed
+    // from a unit force is the solution of the system scaled by the velocity damping. The right-hand side of the
+    // solver is b = h * tr * (f / tr), so it does not depend on the trapezoidal factor.
+    const SReal tr = eulerSolver.d_trapezoidalScheme.getValue() ? 0.5_sreal : 1.0_sreal;
+    SReal mFact, bFact, kFact, rhsFact;
+    if (eulerSolver.d_firstOrder.getValue())
+    {
+        mFact = 1;
+        bFact = 0;
+        kFact = -dt * tr;
+        rhsFact = 1;
+    }
+    else
+    {
+        mFact = 1 + tr * dt * eulerSolver.d_rayleighMass.getValue();
+        bFact = -tr * dt;
+        kFact = -tr * dt * (dt + eulerSolver.d_rayleighStiffness.getValue());
+        rhsFact = dt;
+    }
+    const SReal columnFact = rhsFact * std::exp(-dt * eulerSolver.d_velocityDamping.getValue())
+        * eulerSolver.getPositionIntegrationFactor() / dt;
+
+    {
+        helper::WriteOnlyAccessor< Data< VecCoord > > position = *this->mstate->write(core::VecCoordId::position());
+        position.wref() = restPositions;
+        helper::WriteOnlyAccessor< Data< VecDeriv > > velocity = *this->mstate->write(core::VecDerivId::velocity());
+        velocity.wref().assign(nbNodes, Deriv());
+    }
+
+    core::MechanicalParams mparams(*core::mechanicalparams::defaultInstance());
+    mparams.setDt(dt);
+    simulation::common::MechanicalOperations mops(&mparams, this->getContext());
+    mops->setImplicit(true);
+
+    // the force fields update their stiffness when the forces are computed, as at the beginning of a time step
+    mops.computeForce(core::VecDerivId::force());
 
-    std::ofstream compFileOut(filePathInSofaShare.c_str(), std::fstream::out | std::fstream::binary);
-    compFileOut.write((char*)invM->data, nbCols * nbRows * sizeof(Real));
-    compFileOut.close();
+    linearalgebra::EigenBaseSparseMatrix<double> systemMatrix;
+    core::behavior::DefaultMultiMatrixAccessor matrixAccessor;
+    matrixAccessor.setGlobalMatrix(&systemMatrix);
+    matrixAccessor.clear();
+    mops.getMatrixDimension(&matrixAccessor);
+    matrixAccessor.setupMatrices();
+
+    const auto dimension = matrixAccessor.getGlobalDimension();
+    if (dimension != static_cast<decltype(dimension)>(nbRows))
+    {
+        msg_warning() << "The system assembled from the node has " << dimension << " rows instead of " << nbRows
+                      << ": the compliance is precomputed column by column";
+        return false;
+    }
+
+    systemMatrix.resize(nbRows, nbCols);
+    mops.addMBK_ToMatrix(&matrixAccessor, mFact, bFact, kFact);
+    matrixAccessor.computeGlobalMatrix();
+    systemMatrix.compress();
+
+    const Eigen::SimplicialLDLT<SparseMatrix> factorization(SparseMatrix(systemMatrix.compressedMatrix));
+    if (factorization.info() != Eigen::Success)
+    {
+        msg_warning() << "The system matrix cannot be factorized: the compliance is precomputed column by column";
+        return false;
+    }
+
+    // The right-hand side of a column is the projection of a unit force. The projective constraints work on the
+    // vectors of the mechanical state, so the right-hand sides are built sequentially.
+    const auto projectiveConstraints = this->getContext()->template getObjects<core::behavior::BaseProjectiveConstraintSet>(core::objectmodel::BaseContext::Local);
+    const auto buildRightHandSides = [&](const unsigned int firstColumn, DenseMatrix& rightHandSides)
+    {
+        for (Eigen::Index c = 0; c < rightHandSides.cols(); ++c)
+        {
+            const unsigned int column = firstColumn + static_cast<unsigned int>(c);
+            {
+                helper::WriteOnlyAccessor< Data< VecDeriv > > force = *this->mstate->write(core::VecDerivId::externalForce());
+                force.wref().assign(nbNodes, Deriv());
+                force.wref()[column / dof_on_node][column % dof_on_node] = 1;
+            }
+
+            for (auto* constraint : projectiveConstraints)
+            {
+                constraint->projectResponse(&mparams, core::VecDerivId::externalForce());
+            }
+
+            const VecDeriv& force = this->mstate->read(core::ConstVecDerivId::externalForce())->getValue();
+            for (unsigned int n = 0; n < nbNodes; ++n)
+            {
+                for (unsigned int j = 0; j < dof_on_node; ++j)
+                {
+                    rightHandSides(n * dof_on_node + j, c) = force[n][j];
+                }
+            }
+        }
+    };
+
+    // Resume from the columns computed by a previous precomputation
+    std::vector<bool> computedColumns(nbCols, false);
+    const std::string checkpointPath = getComplianceSavePath(invName) + ".checkpoint";
+    compliance::ComplianceCheckpoint checkpoint;
+    if (!checkpoint.open(checkpointPath, nbRows, m_parametersChecksum,
+        [this, &computedColumns](const std::uint64_t firstColumn, const std::uint64_t nbColumns, const double* columns)
+        {
+            for (std::uint64_t c = 0; c < nbColumns; ++c)
+            {
+                for (unsigned int row = 0; row < nbRows; ++row)
+                {
+                    invM->data[row * nbCols + firstColumn + c] = static_cast<Real>(columns[c * nbRows + row]);
+                }
+                computedColumns[firstColumn + c] = true;
+            }
+        }))
+    {
+        msg_warning() << checkpoint.getLastError() << ": an interrupted precomputation cannot be resumed";
+    }
+
+    const auto nbResumedColumns = static_cast<unsigned int>(std::count(computedColumns.begin(), computedColumns.end(), true));
+    if (nbResumedColumns > 0)
+    {
+        msg_info() << nbResumedColumns << " columns of the compliance are resumed from " << checkpointPath;
+    }
+
+    // Batches of consecutive columns which remain to compute
+    const unsigned int batchSize = std::max(1u, d_batchSize.getValue());
+    std::vector< std::pair<unsigned int, unsigned int> > batches; // first column, number of columns
+    for (unsigned int column = 0; column < nbCols;)
+    {
+        if (computedColumns[column])
+        {
+            ++column;
+            continue;
+        }
+
+        unsigned int end = column + 1;
+        while (end < nbCols && end - column < batchSize && !computedColumns[end])
+        {
+            ++end;
+        }
+        batches.emplace_back(column, end - column);
+        column = end;
+    }
+
+    simulation::TaskScheduler* taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    assert(taskScheduler);
+    if (taskScheduler->getThreadCount() < 1)
+    {
+        taskScheduler->init(0);
+        msg_info() << "Task scheduler initialized on " << taskScheduler->getThreadCount() << " threads";
+    }
+
+    // A round solves one batch per thread
+    const std::size_t nbBatchesPerRound = std::max(1u, taskScheduler->getThreadCount());
+    std::vector<DenseMatrix> rightHandSides(nbBatchesPerRound);
+    std::vector<DenseMatrix> solutions(nbBatchesPerRound);
+
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    auto lastReport = start;
+    unsigned int nbComputedColumns = nbResumedColumns;
+
+    for (std::size_t roundBegin = 0; roundBegin < batches.size(); roundBegin += nbBatchesPerRound)
+    {
+        const std::size_t roundEnd = std::min(batches.size(), roundBegin + nbBatchesPerRound);
+
+        for (std::size_t b = roundBegin; b < roundEnd; ++b)
+        {
+            rightHandSides[b - roundBegin].resize(nbRows, batches[b].second);
+            buildRightHandSides(batches[b].first, rightHandSides[b - roundBegin]);
+        }
+
+        simulation::parallelForEach(*taskScheduler, std::size_t(0), roundEnd - roundBegin,
+            [&](const std::size_t i)
+            {
+                solutions[i] = factorization.solve(rightHandSides[i]) * columnFact;
+            });
+
+        for (std::size_t b = roundBegin; b < roundEnd; ++b)
+        {
+            const auto [firstColumn, nbColumns] = batches[b];
+            const DenseMatrix& solution = solutions[b - roundBegin];
+
+            for (unsigned int c = 0; c < nbColumns; ++c)
+            {
+                for (unsigned int row = 0; row < nbRows; ++row)
+                {
+                    invM->data[row * nbCols + firstColumn + c] = static_cast<Real>(solution(row, c));
+                }
+            }
+
+            if (checkpoint.isOpen() && !checkpoint.append(firstColumn, nbColumns, solution.data()))
+            {
+                msg_warning() << checkpoint.getLastError() << ": an interrupted precomputation cannot be resumed";
+                checkpoint.close();
+            }
+
+            nbComputedColumns += nbColumns;
+        }
+
+        const auto now = Clock::now();
+        if (now - lastReport >= std::chrono::seconds(1) || nbComputedColumns == nbCols)
+        {
+            lastReport = now;
+            const double elapsed = std::chrono::duration<double>(now - start).count();
+            const double remaining = elapsed / (nbComputedColumns - nbResumedColumns) * (nbCols - nbComputedColumns);
+            msg_info() << "Precomputing constraint correction: " << std::fixed << std::setprecision(1)
+                       << 100.0 * nbComputedColumns / nbCols << " % (" << nbComputedColumns << "/" << nbCols
+                       << " columns), " << std::setprecision(0) << remaining << " s remaining";
+        }
+    }
+
+    {
+        helper::WriteOnlyAccessor< Data< VecDeriv > > force = *this->mstate->write(core::VecDerivId::externalForce());
+        force.wref().assign(nbNodes, Deriv());
+    }
+
+    msg_info() << "Compliance precomputed by batches of " << batchSize << " columns on "
+               << taskScheduler->getThreadCount() << " threads in "
+               << std::chrono::duration<double>(Clock::now() - start).count() << " s";
+
+    return true;
 }
 
 
@@ -237,6 +608,8 @@ void PrecomputedConstraintCorrection<DataTypes>::bwdInit()
 
     const SReal dt = this->getContext()->getDt();
 
+    m_parametersChecksum = computeParametersChecksum();
+
     invName = d_fileCompliance.getFullPath();
     bool complianceLoaded = false;
     if (!invName.empty())
@@ -328,10 +701,14 @@ void PrecomputedConstraintCorrection<DataTypes>::bwdInit()
             eulerSolver->solve(core::execparams::defaultInstance(), dt, core::VecCoordId::position(), core::VecDerivId::velocity());
         }
 
+        const bool precomputedByBatches = d_batchedPrecomputation.getValue()
+            && precomputeComplianceByBatches(*eulerSolver, prev_pos);
+
         Deriv unitary_force;
 
         std::stringstream tmpStr;
-        for (unsigned int f = 0; f < nbNodes; f++)
+        // column by column, unless the compliance has been precomputed by batches
+        for (unsigned int f = 0; f < nbNodes && !precomputedByBatches; f++)
         {
             tmpStr.precision(2);
             tmpStr << "Precomputing constraint correction : " << std::fixed << (float)f / (float)nbNodes * 100.0f << " %   " << '\xd';
@@ -384,7 +761,11 @@ void PrecomputedConstraintCorrection<DataTypes>::bwdInit()
         if (linearSolver)
             linearSolver->freezeSystemMatrix();
 
-        saveCompliance(invName);
+        if (saveCompliance(invName) && precomputedByBatches)
+        {
+            // the compliance file replaces the checkpoint of the precomputation
+            helper::system::FileSystem::removeFile(getComplianceSavePath(invName) + ".checkpoint");
+        }
 
         // Restore gravity
         this->getContext()->setGravity(gravity);
@@ -409,7 +790,7 @@ void PrecomputedConstraintCorrection<DataTypes>::bwdInit()
             pos[i] = prev_pos[i];
     }
 
-    appCompliance = invM->data;
+    appCompliance = invM->getData();
 
     // Optimisation for the computation of W
     _indexNodeSparseCompliance.resize(v0.size());
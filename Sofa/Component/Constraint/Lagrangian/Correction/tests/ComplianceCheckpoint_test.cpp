@@ -0,0 +1,182 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <sofa/component/constraint/lagrangian/correction/ComplianceFile.h>
+
+#include <filesystem>
+#include <map>
+#include <vector>
+
+namespace sofa
+{
+
+using namespace component::constraint::lagrangian::correction::compliance;
+
+namespace
+{
+
+constexpr std::uint64_t nbRows = 8;
+constexpr std::uint64_t parametersChecksum = 42;
+
+std::string buildFile(const std::string& name)
+{
+    return std::string(SOFA_COMPONENT_CONSTRAINT_LAGRANGIAN_CORRECTION_TEST_BUILD_DIR) + name;
+}
+
+/// nbColumns columns starting at firstColumn, column-major, the values depending on the row and the column
+std::vector<double> buildColumns(const std::uint64_t firstColumn, const std::uint64_t nbColumns)
+{
+    std::vector<double> columns(nbRows * nbColumns);
+    for (std::uint64_t c = 0; c < nbColumns; ++c)
+    {
+        for (std::uint64_t row = 0; row < nbRows; ++row)
+        {
+            columns[c * nbRows + row] = static_cast<double>(row) + 0.1 * static_cast<double>(firstColumn + c);
+        }
+    }
+    return columns;
+}
+
+void append(ComplianceCheckpoint& checkpoint, const std::uint64_t firstColumn, const std::uint64_t nbColumns)
+{
+    const std::vector<double> columns = buildColumns(firstColumn, nbColumns);
+    ASSERT_TRUE(checkpoint.append(firstColumn, nbColumns, columns.data())) << checkpoint.getLastError();
+}
+
+/// Open the checkpoint and return the columns read from it, by column index
+std::map<std::uint64_t, std::vector<double>> open(ComplianceCheckpoint& checkpoint, const std::string& filename,
+                                                  const std::uint64_t checksum = parametersChecksum)
+{
+    std::map<std::uint64_t, std::vector<double>> readColumns;
+    EXPECT_TRUE(checkpoint.open(filename, nbRows, checksum,
+        [&readColumns](const std::uint64_t firstColumn, const std::uint64_t nbColumns, const double* columns)
+        {
+            for (std::uint64_t c = 0; c < nbColumns; ++c)
+            {
+                readColumns[firstColumn + c].assign(columns + c * nbRows, columns + (c + 1) * nbRows);
+            }
+        })) << checkpoint.getLastError();
+    return readColumns;
+}
+
+void checkColumns(const std::map<std::uint64_t, std::vector<double>>& readColumns,
+                  const std::vector<std::uint64_t>& expectedColumns)
+{
+    ASSERT_EQ(readColumns.size(), expectedColumns.size());
+    for (const std::uint64_t column : expectedColumns)
+    {
+        const auto it = readColumns.find(column);
+        ASSERT_NE(it, readColumns.end()) << "column " << column;
+        EXPECT_EQ(it->second, buildColumns(column, 1)) << "column " << column;
+    }
+}
+
+}
+
+TEST(ComplianceCheckpoint, resume)
+{
+    const std::string filename = buildFile("ComplianceCheckpoint_resume.checkpoint");
+    std::filesystem::remove(filename);
+
+    ComplianceCheckpoint checkpoint;
+    checkColumns(open(checkpoint, filename), {});
+    append(checkpoint, 0, 3);
+    append(checkpoint, 5, 2);
+    checkpoint.close();
+
+    // the precomputation is interrupted, then resumed
+    checkColumns(open(checkpoint, filename), {0, 1, 2, 5, 6});
+    append(checkpoint, 3, 2);
+    checkpoint.close();
+
+    checkColumns(open(checkpoint, filename), {0, 1, 2, 3, 4, 5, 6});
+    checkpoint.remove();
+    EXPECT_FALSE(std::filesystem::exists(filename));
+}
+
+TEST(ComplianceCheckpoint, otherParameters)
+{
+    const std::string filename = buildFile("ComplianceCheckpoint_otherParameters.checkpoint");
+    std::filesystem::remove(filename);
+
+    ComplianceCheckpoint checkpoint;
+    open(checkpoint, filename);
+    append(checkpoint, 0, 3);
+    checkpoint.close();
+
+    // the columns computed with other parameters are discarded
+    checkColumns(open(checkpoint, filename, parametersChecksum + 1), {});
+    checkpoint.close();
+    checkColumns(open(checkpoint, filename, parametersChecksum + 1), {});
+    checkpoint.remove();
+}
+
+TEST(ComplianceCheckpoint, truncatedRecord)
+{
+    const std::string filename = buildFile("ComplianceCheckpoint_truncatedRecord.checkpoint");
+    std::filesystem::remove(filename);
+
+    ComplianceCheckpoint checkpoint;
+    open(checkpoint, filename);
+    append(checkpoint, 0, 2);
+    append(checkpoint, 2, 2);
+    checkpoint.close();
+
+    // the process is killed while the last record is written
+    const auto size = std::filesystem::file_size(filename);
+    std::filesystem::resize_file(filename, size - sizeof(double));
+
+    checkColumns(open(checkpoint, filename), {0, 1});
+
+    // the truncated record has been discarded, so that the next records are appended to valid ones
+    append(checkpoint, 2, 2);
+    checkpoint.close();
+    EXPECT_EQ(std::filesystem::file_size(filename), size);
+
+    checkColumns(open(checkpoint, filename), {0, 1, 2, 3});
+    checkpoint.remove();
+}
+
+TEST(ComplianceCheckpoint, corruptedRecord)
+{
+    const std::string filename = buildFile("ComplianceCheckpoint_corruptedRecord.checkpoint");
+    std::filesystem::remove(filename);
+
+    ComplianceCheckpoint checkpoint;
+    open(checkpoint, filename);
+    append(checkpoint, 0, 2);
+    append(checkpoint, 2, 2);
+    checkpoint.close();
+
+    // modify a value of the last record
+    {
+        std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(-static_cast<std::streamoff>(sizeof(double)), std::ios::end);
+        const double value = -1.0;
+        file.write(reinterpret_cast<const char*>(&value), sizeof(double));
+    }
+
+    checkColumns(open(checkpoint, filename), {0, 1});
+    checkpoint.remove();
+}
+
+}
@@ -0,0 +1,200 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <sofa/component/constraint/lagrangian/correction/ComplianceFile.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace sofa
+{
+
+using namespace component::constraint::lagrangian::correction::compliance;
+
+namespace
+{
+
+constexpr std::uint64_t nbRows = 5;
+constexpr std::uint64_t nbCols = 7;
+constexpr std::uint64_t parametersChecksum = 1234;
+
+std::string buildFile(const std::string& name)
+{
+    return std::string(SOFA_COMPONENT_CONSTRAINT_LAGRANGIAN_CORRECTION_TEST_BUILD_DIR) + name;
+}
+
+template<class Real>
+std::vector<Real> buildMatrix()
+{
+    std::vector<Real> matrix(nbRows * nbCols);
+    for (std::size_t i = 0; i < matrix.size(); ++i)
+    {
+        matrix[i] = static_cast<Real>(1.0 / (1.0 + static_cast<double>(i)));
+    }
+    return matrix;
+}
+
+template<class Real>
+void writeFile(const std::string& filename, bool singlePrecision)
+{
+    std::filesystem::remove(filename);
+    const std::vector<Real> matrix = buildMatrix<Real>();
+    ASSERT_TRUE(writeComplianceFile(filename, matrix.data(), nbRows, nbCols, parametersChecksum, singlePrecision));
+    EXPECT_TRUE(isComplianceFile(filename));
+    EXPECT_FALSE(std::filesystem::exists(filename + ".tmp"));
+}
+
+/// Read the file in the precision StoredReal it has been written with, and convert it to Real
+template<class StoredReal, class Real>
+void checkRoundTrip(const std::string& filename)
+{
+    ComplianceFile file;
+    ASSERT_TRUE(file.open(filename)) << file.getLastError();
+
+    const FileHeader& header = file.getHeader();
+    EXPECT_EQ(header.nbRows, nbRows);
+    EXPECT_EQ(header.nbCols, nbCols);
+    EXPECT_EQ(header.parametersChecksum, parametersChecksum);
+    EXPECT_EQ(header.scalarSize, sizeof(StoredReal));
+
+    // the matrix is used from the mapped memory only in the precision it has been stored with
+    const StoredReal* mapped = file.getMatrix<StoredReal>();
+    ASSERT_NE(mapped, nullptr);
+    if constexpr (!std::is_same_v<StoredReal, Real>)
+    {
+        EXPECT_EQ(file.getMatrix<Real>(), nullptr);
+    }
+
+    // the values written in double precision are exactly the values written in single precision, once rounded
+    const std::vector<double> expected = buildMatrix<double>();
+    std::vector<Real> converted(nbRows * nbCols);
+    file.copyMatrix(converted.data());
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(mapped[i], static_cast<StoredReal>(expected[i]));
+        EXPECT_EQ(converted[i], static_cast<Real>(static_cast<StoredReal>(expected[i])));
+    }
+}
+
+}
+
+TEST(ComplianceFile, roundTripDouble)
+{
+    const std::string filename = buildFile("ComplianceFile_roundTripDouble.comp");
+    writeFile<double>(filename, false);
+    checkRoundTrip<double, double>(filename);
+    checkRoundTrip<double, float>(filename);
+}
+
+TEST(ComplianceFile, roundTripSinglePrecision)
+{
+    const std::string filename = buildFile("ComplianceFile_roundTripSinglePrecision.comp");
+    writeFile<double>(filename, true);
+    checkRoundTrip<float, double>(filename);
+    checkRoundTrip<float, float>(filename);
+
+    writeFile<float>(filename, true);
+    checkRoundTrip<float, float>(filename);
+}
+
+TEST(ComplianceFile, roundTripFloatToDouble)
+{
+    const std::string filename = buildFile("ComplianceFile_roundTripFloatToDouble.comp");
+    writeFile<float>(filename, false);
+
+    ComplianceFile file;
+    ASSERT_TRUE(file.open(filename)) << file.getLastError();
+    ASSERT_NE(file.getMatrix<double>(), nullptr);
+
+    const std::vector<float> expected = buildMatrix<float>();
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(file.getMatrix<double>()[i], static_cast<double>(expected[i]));
+    }
+}
+
+TEST(ComplianceFile, truncatedFile)
+{
+    const std::string filename = buildFile("ComplianceFile_truncatedFile.comp");
+    writeFile<double>(filename, false);
+    std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - sizeof(double));
+
+    ComplianceFile file;
+    EXPECT_FALSE(file.open(filename));
+    EXPECT_FALSE(file.isOpen());
+    EXPECT_NE(file.getLastError().find("truncated"), std::string::npos) << file.getLastError();
+
+    // a file shorter than a header
+    std::filesystem::resize_file(filename, sizeof(FileHeader) / 2);
+    EXPECT_FALSE(file.open(filename));
+}
+
+TEST(ComplianceFile, corruptedHeader)
+{
+    const std::string filename = buildFile("ComplianceFile_corruptedHeader.comp");
+    writeFile<double>(filename, false);
+
+    // modify the number of columns, without updating the checksum of the header
+    {
+        std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(offsetof(FileHeader, nbCols));
+        const std::uint64_t corruptedNbCols = nbCols - 1;
+        file.write(reinterpret_cast<const char*>(&corruptedNbCols), sizeof(std::uint64_t));
+    }
+
+    ComplianceFile file;
+    EXPECT_FALSE(file.open(filename));
+    EXPECT_NE(file.getLastError().find("corrupted header"), std::string::npos) << file.getLastError();
+}
+
+TEST(ComplianceFile, legacyRawFile)
+{
+    const std::string filename = buildFile("ComplianceFile_legacyRawFile.comp");
+    const std::vector<double> matrix = buildMatrix<double>();
+    {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(matrix.data()), matrix.size() * sizeof(double));
+    }
+
+    EXPECT_FALSE(isComplianceFile(filename));
+
+    ComplianceFile file;
+    EXPECT_FALSE(file.open(filename));
+}
+
+TEST(ComplianceFile, failedWriteRemovesTemporaryFile)
+{
+    // the file cannot replace a non-empty directory
+    const std::string filename = buildFile("ComplianceFile_failedWrite.comp");
+    std::filesystem::remove_all(filename);
+    std::filesystem::create_directories(filename + "/content");
+
+    const std::vector<double> matrix = buildMatrix<double>();
+    EXPECT_FALSE(writeComplianceFile(filename, matrix.data(), nbRows, nbCols, parametersChecksum, false));
+    EXPECT_FALSE(std::filesystem::exists(filename + ".tmp"));
+
+    std::filesystem::remove_all(filename);
+}
+
+}
@@ -0,0 +1,208 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/testing/BaseSimulationTest.h>
+using sofa::testing::BaseSimulationTest;
+
+#include <sofa/component/constraint/lagrangian/correction/PrecomputedConstraintCorrection.h>
+#include <sofa/simpleapi/SimpleApi.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/Node.h>
+#include <sofa/simulation/TaskScheduler.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace sofa
+{
+
+using CorrectionType = component::constraint::lagrangian::correction::PrecomputedConstraintCorrection<defaulttype::Vec3Types>;
+
+/** Test the precomputation of the compliance of PrecomputedConstraintCorrection */
+struct PrecomputedConstraintCorrection_test : public BaseSimulationTest
+{
+    void SetUp() override
+    {
+        simpleapi::importPlugin("Sofa.Component.Constraint.Lagrangian.Correction");
+        simpleapi::importPlugin("Sofa.Component.Constraint.Projective");
+        simpleapi::importPlugin("Sofa.Component.LinearSolver.Iterative");
+        simpleapi::importPlugin("Sofa.Component.Mass");
+        simpleapi::importPlugin("Sofa.Component.ODESolver.Backward");
+        simpleapi::importPlugin("Sofa.Component.SolidMechanics.FEM.Elastic");
+        simpleapi::importPlugin("Sofa.Component.StateContainer");
+        simpleapi::importPlugin("Sofa.Component.Topology.Container.Grid");
+
+        // the default thread count is 0 on a single core machine, so that the batches would not be solved in parallel
+        simulation::TaskScheduler* taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+        if (taskScheduler->getThreadCount() < 2)
+        {
+            taskScheduler->init(2);
+        }
+    }
+
+    struct SceneParameters
+    {
+        bool batchedPrecomputation { false };
+        bool trapezoidalScheme { false };
+        std::string youngModulus { "500" };
+        std::string rayleighMass { "0.1" };
+    };
+
+    static std::string complianceFile(const std::string& name)
+    {
+        return std::string(SOFA_COMPONENT_CONSTRAINT_LAGRANGIAN_CORRECTION_TEST_BUILD_DIR) + name + "-72-0.01.comp";
+    }
+
+    /// Precompute the compliance of a bar of hexahedra, fixed at one end, and return it
+    std::vector<SReal> precomputeCompliance(const std::string& name, const SceneParameters& parameters)
+    {
+        std::filesystem::remove(complianceFile(name));
+        return runScene(name, parameters);
+    }
+
+    /// Initialize the scene, which loads the compliance saved in its file if any, and return the compliance
+    std::vector<SReal> runScene(const std::string& name, const SceneParameters& parameters)
+    {
+        const auto simulation = simpleapi::createSimulation();
+        const simulation::Node::SPtr root = simpleapi::createRootNode(simulation, "root");
+        root->setDt(0.01);
+
+        simpleapi::createObject(root, "DefaultAnimationLoop", {});
+
+        const simulation::Node::SPtr bar = simpleapi::createChild(root, name);
+        simpleapi::createObject(bar, "EulerImplicitSolver", {
+            {"trapezoidalScheme", simpleapi::str(parameters.trapezoidalScheme)},
+            {"rayleighStiffness", "0.1"},
+            {"rayleighMass", parameters.rayleighMass},
+            {"vdamping", "0.5"}});
+        simpleapi::createObject(bar, "CGLinearSolver", {{"iterations", "1000"}, {"tolerance", "1e-20"}, {"threshold", "1e-30"}});
+        simpleapi::createObject(bar, "RegularGridTopology", {{"n", "2 3 4"}, {"min", "0 0 0"}, {"max", "1 2 3"}});
+        simpleapi::createObject(bar, "MechanicalObject", {{"template", "Vec3"}});
+        simpleapi::createObject(bar, "UniformMass", {{"totalMass", "2"}});
+        simpleapi::createObject(bar, "HexahedronFEMForceField", {{"youngModulus", parameters.youngModulus}, {"poissonRatio", "0.3"}});
+        simpleapi::createObject(bar, "FixedProjectiveConstraint", {{"indices", "0 1 2 3 4 5"}});
+        const auto correction = simpleapi::createObject(bar, "PrecomputedConstraintCorrection", {
+            {"recompute", "true"},
+            {"fileDir", std::string(SOFA_COMPONENT_CONSTRAINT_LAGRANGIAN_CORRECTION_TEST_BUILD_DIR)},
+            {"batchedPrecomputation", simpleapi::str(parameters.batchedPrecomputation)},
+            {"batchSize", "5"}});
+
+        sofa::simulation::node::initRoot(root.get());
+
+        const auto* precomputedCorrection = dynamic_cast<CorrectionType*>(correction.get());
+        EXPECT_NE(precomputedCorrection, nullptr);
+        if (!precomputedCorrection || !precomputedCorrection->invM || !precomputedCorrection->invM->getData())
+        {
+            ADD_FAILURE() << "The compliance has not been computed";
+            return {};
+        }
+
+        const auto size = precomputedCorrection->nbRows * precomputedCorrection->nbCols;
+        const auto* compliance = precomputedCorrection->invM->getData();
+        std::vector<SReal> result(compliance, compliance + size);
+
+        sofa::simulation::node::unload(root);
+        return result;
+    }
+
+    void compareBatchedAndColumnByColumn(bool trapezoidalScheme)
+    {
+        const std::string suffix = trapezoidalScheme ? "Trapezoidal" : "";
+        SceneParameters parameters;
+        parameters.trapezoidalScheme = trapezoidalScheme;
+        const std::vector<SReal> columnByColumn = precomputeCompliance("columnByColumn" + suffix, parameters);
+        parameters.batchedPrecomputation = true;
+        const std::vector<SReal> batched = precomputeCompliance("batched" + suffix, parameters);
+
+        ASSERT_EQ(columnByColumn.size(), 72u * 72u);
+        ASSERT_EQ(batched.size(), columnByColumn.size());
+
+        SReal maxValue = 0;
+        for (const SReal value : columnByColumn)
+        {
+            maxValue = std::max(maxValue, std::abs(value));
+        }
+        ASSERT_GT(maxValue, 0);
+
+        for (std::size_t i = 0; i < batched.size(); ++i)
+        {
+            EXPECT_NEAR(batched[i], columnByColumn[i], 1e-6 * maxValue) << "row " << i / 72 << ", column " << i % 72;
+        }
+    }
+};
+
+TEST_F(PrecomputedConstraintCorrection_test, batchedPrecomputation)
+{
+    this->compareBatchedAndColumnByColumn(false);
+}
+
+TEST_F(PrecomputedConstraintCorrection_test, batchedPrecomputationTrapezoidalScheme)
+{
+    this->compareBatchedAndColumnByColumn(true);
+}
+
+TEST_F(PrecomputedConstraintCorrection_test, savedComplianceIsLoaded)
+{
+    const std::vector<SReal> saved = this->precomputeCompliance("savedCompliance", {});
+    ASSERT_EQ(saved.size(), 72u * 72u);
+    EXPECT_EQ(this->runScene("savedCompliance", {}), saved);
+}
+
+TEST_F(PrecomputedConstraintCorrection_test, otherParametersRecompute)
+{
+    const std::vector<SReal> saved = this->precomputeCompliance("otherParameters", {});
+    ASSERT_EQ(saved.size(), 72u * 72u);
+
+    SceneParameters forceFieldParameters;
+    forceFieldParameters.youngModulus = "1000";
+    SceneParameters solverParameters;
+    solverParameters.rayleighMass = "0.2";
+
+    for (const SceneParameters& parameters : {forceFieldParameters, solverParameters})
+    {
+        std::vector<SReal> recomputed;
+        {
+            EXPECT_MSG_EMIT(Warning);
+            recomputed = this->runScene("otherParameters", parameters);
+        }
+        ASSERT_EQ(recomputed.size(), saved.size());
+        EXPECT_NE(recomputed, saved);
+        EXPECT_EQ(recomputed, this->precomputeCompliance("otherParametersReference", parameters));
+    }
+}
+
+TEST_F(PrecomputedConstraintCorrection_test, legacyRawFile)
+{
+    // a raw file contains only the values of the compliance, without header
+    std::vector<SReal> raw(72 * 72);
+    for (std::size_t i = 0; i < raw.size(); ++i)
+    {
+        raw[i] = 1e-3 * static_cast<SReal>(i);
+    }
+    {
+        std::ofstream file(complianceFile("legacyRawFile"), std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(raw.data()), raw.size() * sizeof(SReal));
+    }
+
+    EXPECT_EQ(this->runScene("legacyRawFile", {}), raw);
+}
+
+}
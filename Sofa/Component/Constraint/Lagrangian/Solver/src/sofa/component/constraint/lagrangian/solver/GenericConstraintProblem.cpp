@@ -24,6 +24,9 @@
 
 #include <sofa/component/constraint/lagrangian/solver/GenericConstraintSolver.h>
 #include <sofa/helper/AdvancedTimer.h>
+#include <sofa/helper/ScopedAdvancedTimer.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/ParallelForEach.h>
 
 namespace sofa::component::constraint::lagrangian::solver
 {
@@ -82,6 +85,16 @@ void GenericConstraintProblem::solveTimed(SReal tol, int maxIt, SReal timeout)
 
 // Debug is only available when called directly by the solver (not in haptic thread)
 void GenericConstraintProblem::gaussSeidel(SReal timeout, GenericConstraintSolver* solver)
+{
+    doGaussSeidel(timeout, solver, nullptr, false);
+}
+
+void GenericConstraintProblem::parallelGaussSeidel(SReal timeout, GenericConstraintSolver* solver)
+{
+    doGaussSeidel(timeout, solver, simulation::MainTaskSchedulerFactory::createInRegistry(), true);
+}
+
+void GenericConstraintProblem::doGaussSeidel(SReal timeout, GenericConstraintSolver* solver, simulation::TaskScheduler* taskScheduler, bool colored)
 {
     if(!solver)
         return;
@@ -129,6 +142,12 @@ void GenericConstraintProblem::gaussSeidel(SReal timeout, GenericConstraintSolve
         i += constraintsResolutions[i]->getNbLines();
     }
 
+    if(colored)
+    {
+        SCOPED_TIMER("ConstraintGroupColoring");
+        updateConstraintGroupColors();
+    }
+
     bool showGraphs = false;
     sofa::type::vector<SReal>* graph_residuals = nullptr;
     std::map < std::string, sofa::type::vector<SReal> > *graph_forces = nullptr, *graph_violations = nullptr;
@@ -162,7 +181,14 @@ void GenericConstraintProblem::gaussSeidel(SReal timeout, GenericConstraintSolve
         }
 
         error=0.0;
-        gaussSeidel_increment(true, dfree, force, w, tol, d, dimension, constraintsAreVerified, error, tabErrors);
+        if(colored)
+        {
+            parallelGaussSeidel_increment(true, dfree, force, w, tol, d, dimension, constraintsAreVerified, error, tabErrors, taskScheduler);
+        }
+        else
+        {
+            gaussSeidel_increment(true, dfree, force, w, tol, d, dimension, constraintsAreVerified, error, tabErrors);
+        }
 
         if(showGraphs)
         {
@@ -662,55 +688,308 @@ void GenericConstraintProblem::gaussSeidel_increment(bool measureError, SReal *d
         //4. the error is measured (displacement due to the new resolution (i.e. due to the new force))
         if(measureError)
         {
-            SReal contraintError = 0.0;
-            if(nb > 1)
-            {
-                for(unsigned int l=0; l<nb; l++)
-                {
-                    SReal lineError = 0.0;
-                    for (unsigned int m=0; m<nb; m++)
-                    {
-                        const SReal dofError = w[j+l][j+m] * (force[j+m] - errF[m]);
-                        lineError += dofError * dofError;
-                    }
-                    lineError = sqrt(lineError);
-                    if(lineError > tol)
-                    {
-                        constraintsAreVerified = false;
-                    }
+            const SReal contraintError = computeConstraintGroupError(j, nb, errF.data(), force, w, tol, constraintsAreVerified);
+            error += contraintError;
+            tabErrors[j] = contraintError;
+        }
+        else
+        {
+            constraintsAreVerified = true;
+        }
 
-                    contraintError += lineError;
-                }
+        j += nb;
+    }
+}
+
+SReal GenericConstraintProblem::computeConstraintGroupError(int j, unsigned int nb, const SReal* errF, const SReal* force, SReal** w, SReal tol, bool& constraintsAreVerified) const
+{
+    SReal contraintError = 0.0;
+    if(nb > 1)
+    {
+        for(unsigned int l=0; l<nb; l++)
+        {
+            SReal lineError = 0.0;
+            for (unsigned int m=0; m<nb; m++)
+            {
+                const SReal dofError = w[j+l][j+m] * (force[j+m] - errF[m]);
+                lineError += dofError * dofError;
             }
-            else
+            lineError = sqrt(lineError);
+            if(lineError > tol)
             {
-                contraintError = fabs(w[j][j] * (force[j] - errF[0]));
-                if(contraintError > tol)
+                constraintsAreVerified = false;
+            }
+
+            contraintError += lineError;
+        }
+    }
+    else
+    {
+        contraintError = fabs(w[j][j] * (force[j] - errF[0]));
+        if(contraintError > tol)
+        {
+            constraintsAreVerified = false;
+        }
+    }
+
+    const bool givenTolerance = (bool)constraintsResolutions[j]->getTolerance();
+
+    if(givenTolerance)
+    {
+        if(contraintError > constraintsResolutions[j]->getTolerance())
+        {
+            constraintsAreVerified = false;
+        }
+        contraintError *= tol / constraintsResolutions[j]->getTolerance();
+    }
+
+    return contraintError;
+}
+
+void GenericConstraintProblem::computeConstraintGroupColors()
+{
+    const int dim = getDimension();
+    SReal** w = getW();
+
+    // 1. constraint groups
+    m_lineToGroup.assign(dim, -1);
+    m_groupFirstLine.clear();
+    int line = 0;
+    while(line < dim && constraintsResolutions[line])
+    {
+        const int nb = std::min<int>(constraintsResolutions[line]->getNbLines(), dim - line);
+        std::fill_n(m_lineToGroup.begin() + line, nb, static_cast<int>(m_groupFirstLine.size()));
+        m_groupFirstLine.push_back(line);
+        line += nb;
+    }
+    const int nbGroups = static_cast<int>(m_groupFirstLine.size());
+    m_groupFirstLine.push_back(line);
+
+    // 2. coupling between the groups, given by the non-zero blocks of the compliance matrix.
+    //    The graph is made symmetric, so the coloring does not rely on the symmetry of W.
+    sofa::type::vector< sofa::type::vector<int> > adjacency(nbGroups);
+    sofa::type::vector<int> lastSeen(nbGroups, -1);
+    for(int g=0; g<nbGroups; ++g)
+    {
+        adjacency[g].push_back(g);
+        lastSeen[g] = g;
+        for(int i=m_groupFirstLine[g]; i<m_groupFirstLine[g+1]; ++i)
+        {
+            for(int k=0; k<dim; ++k)
+            {
+                const int h = m_lineToGroup[k];
+                if(w[i][k] != 0 && h >= 0 && lastSeen[h] != g)
                 {
-                    constraintsAreVerified = false;
+                    lastSeen[h] = g;
+                    adjacency[g].push_back(h);
+                    adjacency[h].push_back(g);
                 }
             }
+        }
+    }
+
+    m_coupledGroups.assign(static_cast<std::size_t>(nbGroups) * nbGroups, 0);
+    for(int g=0; g<nbGroups; ++g)
+    {
+        for(const int h : adjacency[g])
+        {
+            m_coupledGroups[static_cast<std::size_t>(g) * nbGroups + h] = 1;
+        }
+    }
+
+    m_neighborPtr.resize(nbGroups + 1);
+    m_neighborGroups.clear();
+    m_neighborPtr[0] = 0;
+    for(int g=0; g<nbGroups; ++g)
+    {
+        auto& neighbors = adjacency[g];
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+        m_neighborGroups.insert(m_neighborGroups.end(), neighbors.begin(), neighbors.end());
+        m_neighborPtr[g+1] = static_cast<int>(m_neighborGroups.size());
+    }
+
+    // 3. greedy coloring: each group takes the smallest color which is not used by its neighbors
+    sofa::type::vector<int> groupColor(nbGroups, -1);
+    sofa::type::vector<int> colorUsedBy; // last group having a neighbor with this color
+    for(int g=0; g<nbGroups; ++g)
+    {
+        for(int n=m_neighborPtr[g]; n<m_neighborPtr[g+1]; ++n)
+        {
+            const int neighborColor = groupColor[m_neighborGroups[n]];
+            if(neighborColor >= 0)
+            {
+                colorUsedBy[neighborColor] = g;
+            }
+        }
+
+        int color = 0;
+        while(color < static_cast<int>(colorUsedBy.size()) && colorUsedBy[color] == g)
+        {
+            ++color;
+        }
+        if(color == static_cast<int>(colorUsedBy.size()))
+        {
+            colorUsedBy.push_back(-1);
+        }
+        groupColor[g] = color;
+    }
+
+    // 4. groups sorted by color, then by index
+    const int nbColors = static_cast<int>(colorUsedBy.size());
+    m_colorPtr.assign(nbColors + 1, 0);
+    for(int g=0; g<nbGroups; ++g)
+    {
+        ++m_colorPtr[groupColor[g] + 1];
+    }
+    for(int c=0; c<nbColors; ++c)
+    {
+        m_colorPtr[c+1] += m_colorPtr[c];
+    }
+    m_colorGroups.resize(nbGroups);
+    sofa::type::vector<int> colorFill(m_colorPtr.begin(), m_colorPtr.end() - 1);
+    for(int g=0; g<nbGroups; ++g)
+    {
+        m_colorGroups[colorFill[groupColor[g]]++] = g;
+    }
+
+    m_groupErrors.resize(nbGroups);
+    m_groupVerified.resize(nbGroups);
+}
+
+bool GenericConstraintProblem::hasConstraintGroupStructure()
+{
+    const int dim = getDimension();
+    if(static_cast<int>(m_lineToGroup.size()) != dim || m_groupFirstLine.empty())
+    {
+        return false;
+    }
 
-            const bool givenTolerance = (bool)constraintsResolutions[j]->getTolerance();
+    // same groups
+    const int nbGroups = static_cast<int>(m_groupFirstLine.size()) - 1;
+    int line = 0;
+    for(int g=0; g<nbGroups; ++g)
+    {
+        if(m_groupFirstLine[g] != line || !constraintsResolutions[line])
+        {
+            return false;
+        }
+        line += std::min<int>(constraintsResolutions[line]->getNbLines(), dim - line);
+    }
+    if(line != m_groupFirstLine[nbGroups] || (line < dim && constraintsResolutions[line]))
+    {
+        return false;
+    }
 
-            if(givenTolerance)
+    // no new coupling. A coupling which disappeared keeps the coloring valid: the groups are then
+    // relaxed with a zero contribution of the uncoupled group.
+    SReal** w = getW();
+    for(int g=0; g<nbGroups; ++g)
+    {
+        const char* coupled = m_coupledGroups.data() + static_cast<std::size_t>(g) * nbGroups;
+        for(int i=m_groupFirstLine[g]; i<m_groupFirstLine[g+1]; ++i)
+        {
+            for(int k=0; k<line; ++k)
             {
-                if(contraintError > constraintsResolutions[j]->getTolerance())
+                if(w[i][k] != 0 && !coupled[m_lineToGroup[k]])
                 {
-                    constraintsAreVerified = false;
+                    return false;
                 }
-                contraintError *= tol / constraintsResolutions[j]->getTolerance();
             }
+        }
+    }
+    return true;
+}
 
-            error += contraintError;
-            tabErrors[j] = contraintError;
+bool GenericConstraintProblem::updateConstraintGroupColors()
+{
+    if(hasConstraintGroupStructure())
+    {
+        return false;
+    }
+    computeConstraintGroupColors();
+    return true;
+}
+
+SReal GenericConstraintProblem::relaxConstraintGroup(int groupId, bool measureError, SReal *dfree, SReal *force, SReal **w, SReal tol, SReal *d, bool& constraintsAreVerified)
+{
+    const int j = m_groupFirstLine[groupId];
+    const unsigned int nb = m_groupFirstLine[groupId + 1] - j;
+
+    std::vector<SReal> errF(&force[j], &force[j+nb]);
+    std::copy_n(&dfree[j], nb, &d[j]);
+
+    // only the coupled groups contribute to d. They are visited in increasing order, so the
+    // non-zero terms are accumulated in the same order as in gaussSeidel_increment
+    for(int n=m_neighborPtr[groupId]; n<m_neighborPtr[groupId + 1]; ++n)
+    {
+        const int neighbor = m_neighborGroups[n];
+        for(int k=m_groupFirstLine[neighbor]; k<m_groupFirstLine[neighbor + 1]; k++)
+        {
+            for(unsigned int l=0; l<nb; l++)
+            {
+                d[j+l] += w[j+l][k] * force[k];
+            }
+        }
+    }
+
+    constraintsResolutions[j]->resolution(j, w, d, force, dfree);
+
+    if(measureError)
+    {
+        return computeConstraintGroupError(j, nb, errF.data(), force, w, tol, constraintsAreVerified);
+    }
+    return 0;
+}
+
+void GenericConstraintProblem::parallelGaussSeidel_increment(bool measureError, SReal *dfree, SReal *force, SReal **w, SReal tol, SReal *d, int dim, bool& constraintsAreVerified, SReal& error, sofa::type::vector<SReal>& tabErrors, simulation::TaskScheduler* taskScheduler)
+{
+    SOFA_UNUSED(dim);
+
+    const bool parallel = taskScheduler && taskScheduler->getThreadCount() > 1;
+
+    const auto relaxGroups = [&](const auto& range)
+    {
+        for(auto it = range.start; it != range.end; ++it)
+        {
+            bool groupVerified = true;
+            m_groupErrors[*it] = relaxConstraintGroup(*it, measureError, dfree, force, w, tol, d, groupVerified);
+            m_groupVerified[*it] = groupVerified;
+        }
+    };
+
+    // the groups of a color are independent: they only read the forces of the other colors
+    for(int c=0; c<getNbConstraintGroupColors(); ++c)
+    {
+        const auto first = m_colorGroups.begin() + m_colorPtr[c];
+        const auto last = m_colorGroups.begin() + m_colorPtr[c+1];
+        if(parallel && static_cast<std::size_t>(std::distance(first, last)) >= MinGroupsPerParallelColor)
+        {
+            simulation::parallelForEachRange(*taskScheduler, first, last, relaxGroups);
         }
         else
         {
-            constraintsAreVerified = true;
+            simulation::forEachRange(first, last, relaxGroups);
         }
+    }
 
-        j += nb;
+    // reduction in the order of the groups, so the result does not depend on the number of threads
+    if(measureError)
+    {
+        const int nbGroups = static_cast<int>(m_groupFirstLine.size()) - 1;
+        for(int g=0; g<nbGroups; ++g)
+        {
+            error += m_groupErrors[g];
+            tabErrors[m_groupFirstLine[g]] = m_groupErrors[g];
+            if(!m_groupVerified[g])
+            {
+                constraintsAreVerified = false;
+            }
+        }
+    }
+    else
+    {
+        constraintsAreVerified = true;
     }
 }
 
@@ -25,6 +25,11 @@
 #include <sofa/component/constraint/lagrangian/solver/ConstraintSolverImpl.h>
 #include <sofa/linearalgebra/SparseMatrix.h>
 
+namespace sofa::simulation
+{
+class TaskScheduler;
+}
+
 namespace sofa::component::constraint::lagrangian::solver
 {
 
@@ -69,18 +74,68 @@ public:
     /// A nonsmooth nonlinear conjugate gradient method for interactive contact force problems
     /// - 2010, Silcowitz, Morten and Niebe, Sarah and Erleben, Kenny
     void NNCG(GenericConstraintSolver* solver = nullptr, int iterationNewton = 1);
+    /// Projective Gauss Seidel method building the compliance matrix, where the constraint groups
+    /// are relaxed color by color (see computeConstraintGroupColors). The groups of a color are
+    /// not coupled in the compliance matrix, so they are relaxed in parallel.
+    void parallelGaussSeidel(SReal timeout=0, GenericConstraintSolver* solver = nullptr);
 
     void gaussSeidel_increment(bool measureError, SReal *dfree, SReal *force, SReal **w, SReal tol, SReal *d, int dim, bool& constraintsAreVerified, SReal& error, sofa::type::vector<SReal>& tabErrors) const;
+    /// Same as gaussSeidel_increment, but the groups are visited color by color.
+    /// computeConstraintGroupColors must have been called before.
+    void parallelGaussSeidel_increment(bool measureError, SReal *dfree, SReal *force, SReal **w, SReal tol, SReal *d, int dim, bool& constraintsAreVerified, SReal& error, sofa::type::vector<SReal>& tabErrors, simulation::TaskScheduler* taskScheduler);
+
+    /// Greedy coloring of the constraint groups, such that two groups coupled by a non-zero block
+    /// of the compliance matrix never share the same color. The groups are colored in their
+    /// order of appearance, so the coloring only depends on the sparsity of the compliance matrix.
+    void computeConstraintGroupColors();
+    /// Compute the coloring of the constraint groups only if the constraint structure changed since the
+    /// last coloring, i.e. if the groups changed or if W couples groups which were not coupled.
+    /// @return true if the coloring has been computed
+    bool updateConstraintGroupColors();
+    int getNbConstraintGroupColors() const { return m_colorPtr.empty() ? 0 : static_cast<int>(m_colorPtr.size()) - 1; }
     void result_output(GenericConstraintSolver* solver, SReal *force, SReal error, int iterCount, bool convergence);
 
     int getNumConstraints();
     int getNumConstraintGroups();
 
+    /// Minimum number of constraint groups in a color to relax it in parallel
+    static constexpr std::size_t MinGroupsPerParallelColor = 32;
+
 protected:
+    void doGaussSeidel(SReal timeout, GenericConstraintSolver* solver, simulation::TaskScheduler* taskScheduler, bool colored);
+
+    /// Relax a constraint group, computing d only from the coupled groups
+    /// @return the error of the group, or 0 if measureError is false
+    SReal relaxConstraintGroup(int groupId, bool measureError, SReal *dfree, SReal *force, SReal **w, SReal tol, SReal *d, bool& constraintsAreVerified);
+
+    /// Error due to the new force of the constraint group starting at line j. errF is the force before the resolution.
+    SReal computeConstraintGroupError(int j, unsigned int nb, const SReal* errF, const SReal* force, SReal** w, SReal tol, bool& constraintsAreVerified) const;
+
     sofa::linearalgebra::FullVector<SReal> m_lam;
     sofa::linearalgebra::FullVector<SReal> m_deltaF;
     sofa::linearalgebra::FullVector<SReal> m_deltaF_new;
     sofa::linearalgebra::FullVector<SReal> m_p;
 
+    /// Check that the groups are the ones of the last coloring, and that W has no non-zero block
+    /// between groups which were not coupled
+    bool hasConstraintGroupStructure();
+
+    // For colored version :
+    /// first line of each constraint group, followed by the end of the last group
+    sofa::type::vector<int> m_groupFirstLine;
+    /// constraint group of each line
+    sofa::type::vector<int> m_lineToGroup;
+    /// nbGroups x nbGroups flags of the groups coupled in the last coloring
+    sofa::type::vector<char> m_coupledGroups;
+    /// groups coupled with each group (including itself), sorted by increasing index:
+    /// m_neighborGroups[m_neighborPtr[g]] to m_neighborGroups[m_neighborPtr[g+1]-1]
+    sofa::type::vector<int> m_neighborPtr;
+    sofa::type::vector<int> m_neighborGroups;
+    /// groups of each color, sorted by increasing index:
+    /// m_colorGroups[m_colorPtr[c]] to m_colorGroups[m_colorPtr[c+1]-1]
+    sofa::type::vector<int> m_colorPtr;
+    sofa::type::vector<int> m_colorGroups;
+    sofa::type::vector<SReal> m_groupErrors;
+    sofa::type::vector<char> m_groupVerified;
 };
 }
@@ -61,7 +61,7 @@ void clearMultiVecId(sofa::core::objectmodel::BaseContext* ctx, const sofa::core
 }
 
 GenericConstraintSolver::GenericConstraintSolver()
-    : d_resolutionMethod( initData(&d_resolutionMethod, "resolutionMethod", "Method used to solve the constraint problem, among: \"ProjectedGaussSeidel\", \"UnbuiltGaussSeidel\" or \"for NonsmoothNonlinearConjugateGradient\""))
+    : d_resolutionMethod( initData(&d_resolutionMethod, "resolutionMethod", "Method used to solve the constraint problem, among: \"ProjectedGaussSeidel\", \"UnbuiltGaussSeidel\", \"for NonsmoothNonlinearConjugateGradient\" or \"ParallelGaussSeidel\" (ProjectedGaussSeidel where the constraint groups which are not coupled are relaxed in parallel)"))
     , d_maxIt(initData(&d_maxIt, 1000, "maxIterations", "maximal number of iterations of the Gauss-Seidel algorithm"))
     , d_tolerance(initData(&d_tolerance, 0.001_sreal, "tolerance", "residual error threshold for termination of the Gauss-Seidel algorithm"))
     , d_sor(initData(&d_sor, 1.0_sreal, "sor", "Successive Over Relaxation parameter (0-2)"))
@@ -86,7 +86,7 @@ GenericConstraintSolver::GenericConstraintSolver()
     , current_cp(&m_cpBuffer[0])
     , last_cp(nullptr)
 {
-    sofa::helper::OptionsGroup m_newoptiongroup{"ProjectedGaussSeidel","UnbuiltGaussSeidel", "NonsmoothNonlinearConjugateGradient"};
+    sofa::helper::OptionsGroup m_newoptiongroup{"ProjectedGaussSeidel","UnbuiltGaussSeidel", "NonsmoothNonlinearConjugateGradient", "ParallelGaussSeidel"};
     m_newoptiongroup.setSelectedItem("ProjectedGaussSeidel");
     d_resolutionMethod.setValue(m_newoptiongroup);
 
@@ -152,7 +152,7 @@ void GenericConstraintSolver::init()
         m_dxId = dx.id();
     }
 
-    if(d_multithreading.getValue())
+    if(d_multithreading.getValue() || d_resolutionMethod.getValue().getSelectedId() == 3)
     {
         simulation::MainTaskSchedulerFactory::createInRegistry()->init();
     }
@@ -229,6 +229,7 @@ bool GenericConstraintSolver::buildSystem(const core::ConstraintParams *cParams,
     {
         case 0: // ProjectedGaussSeidel
         case 2: // NonsmoothNonlinearConjugateGradient
+        case 3: // ParallelGaussSeidel
         {
             buildSystem_matrixAssembly(cParams);
             break;
@@ -456,6 +457,12 @@ bool GenericConstraintSolver::solveSystem(const core::ConstraintParams * /*cPara
             current_cp->NNCG(this, d_newtonIterations.getValue());
             break;
         }
+        // ParallelGaussSeidel
+        case 3: {
+            SCOPED_TIMER_VARNAME(parallelGaussSeidelTimer, "ConstraintsParallelGaussSeidel");
+            current_cp->parallelGaussSeidel(0, this);
+            break;
+        }
         default:
             msg_error() << "Wrong \"resolutionMethod\" given";
     }
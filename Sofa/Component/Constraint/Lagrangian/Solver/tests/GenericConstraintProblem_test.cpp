@@ -0,0 +1,344 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <sofa/component/constraint/lagrangian/solver/GenericConstraintProblem.h>
+#include <sofa/component/constraint/lagrangian/solver/GenericConstraintSolver.h>
+#include <sofa/core/behavior/ConstraintResolution.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/TaskScheduler.h>
+#include <sofa/type/Vec.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+
+namespace sofa
+{
+
+using component::constraint::lagrangian::solver::GenericConstraintProblem;
+using component::constraint::lagrangian::solver::GenericConstraintSolver;
+
+namespace
+{
+
+/// Non-negative force on a single line
+class UnilateralResolution : public core::behavior::ConstraintResolution
+{
+public:
+    UnilateralResolution() : core::behavior::ConstraintResolution(1) {}
+
+    void resolution(int line, SReal** w, SReal* d, SReal* force, SReal* /*dFree*/) override
+    {
+        force[line] = std::max(0_sreal, force[line] - d[line] / w[line][line]);
+    }
+};
+
+/// Two lines solved together, without bounds
+class BilateralResolution : public core::behavior::ConstraintResolution
+{
+public:
+    BilateralResolution() : core::behavior::ConstraintResolution(2) {}
+
+    void resolution(int line, SReal** w, SReal* d, SReal* force, SReal* /*dFree*/) override
+    {
+        const SReal a = w[line][line], b = w[line][line + 1], c = w[line + 1][line], e = w[line + 1][line + 1];
+        const SReal det = a * e - b * c;
+        force[line] -= (e * d[line] - b * d[line + 1]) / det;
+        force[line + 1] -= (a * d[line + 1] - c * d[line]) / det;
+    }
+};
+
+/// Exposes the coloring of the constraint groups
+class ConstraintProblem : public GenericConstraintProblem
+{
+public:
+    using GenericConstraintProblem::m_colorPtr;
+    using GenericConstraintProblem::m_colorGroups;
+    using GenericConstraintProblem::m_groupFirstLine;
+};
+
+/**
+ * Contacts between particles: each constraint group pushes two particles apart along random
+ * directions, so W = J C J^T only couples the groups sharing a particle.
+ */
+struct ContactProblemDescription
+{
+    struct Group
+    {
+        bool bilateral { false };
+        int particles[2] {};
+        std::vector<type::Vec3> directions;
+    };
+
+    std::vector<Group> groups;
+    std::vector<SReal> particleCompliance;
+    std::vector<SReal> dFree;
+
+    ContactProblemDescription(const int nbParticles, const int nbGroups, const unsigned int seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<SReal> unit(-1, 1);
+        std::uniform_int_distribution<int> particle(0, nbParticles - 1);
+        std::set<std::pair<int, int>> pairs;
+
+        for (int p = 0; p < nbParticles; ++p)
+        {
+            particleCompliance.push_back(1 + 0.5 * unit(generator));
+        }
+
+        for (int g = 0; g < nbGroups; ++g)
+        {
+            Group group;
+            group.bilateral = (g % 5 == 0);
+            // a pair of particles is constrained by a single group, so that W is positive definite
+            do
+            {
+                group.particles[0] = particle(generator);
+                group.particles[1] = particle(generator);
+            } while (group.particles[1] == group.particles[0]
+                || !pairs.insert(std::minmax(group.particles[0], group.particles[1])).second);
+
+            for (int l = 0; l < (group.bilateral ? 2 : 1); ++l)
+            {
+                type::Vec3 direction(unit(generator), unit(generator), unit(generator));
+                direction.normalize();
+                group.directions.push_back(direction);
+                dFree.push_back(unit(generator));
+            }
+            groups.push_back(group);
+        }
+    }
+
+    int getDimension() const { return static_cast<int>(dFree.size()); }
+
+    void fill(GenericConstraintProblem& problem) const
+    {
+        const int dim = getDimension();
+        problem.clear(dim);
+        problem.tolerance = 1e-10;
+        problem.scaleTolerance = false;
+        problem.maxIterations = 10000;
+
+        // line -> (group, direction)
+        std::vector<std::pair<int, int>> lines;
+        for (int g = 0; g < static_cast<int>(groups.size()); ++g)
+        {
+            problem.constraintsResolutions[lines.size()] = groups[g].bilateral
+                ? static_cast<core::behavior::ConstraintResolution*>(new BilateralResolution)
+                : new UnilateralResolution;
+            for (int l = 0; l < static_cast<int>(groups[g].directions.size()); ++l)
+            {
+                lines.emplace_back(g, l);
+            }
+        }
+
+        SReal** w = problem.getW();
+        for (int i = 0; i < dim; ++i)
+        {
+            problem.getDfree()[i] = dFree[i];
+            problem.getF()[i] = 0;
+
+            const Group& gi = groups[lines[i].first];
+            for (int j = 0; j < dim; ++j)
+            {
+                const Group& gj = groups[lines[j].first];
+                SReal value = 0;
+                for (int a = 0; a < 2; ++a)
+                {
+                    for (int b = 0; b < 2; ++b)
+                    {
+                        if (gi.particles[a] == gj.particles[b])
+                        {
+                            // the direction is applied positively on the first particle, negatively on the second
+                            const SReal sign = (a == b) ? 1 : -1;
+                            value += sign * particleCompliance[gi.particles[a]]
+                                * dot(gi.directions[lines[i].second], gj.directions[lines[j].second]);
+                        }
+                    }
+                }
+                w[i][j] = value;
+            }
+        }
+    }
+};
+
+std::vector<SReal> solve(GenericConstraintProblem& problem, bool parallel)
+{
+    const GenericConstraintSolver::SPtr solver = core::objectmodel::New<GenericConstraintSolver>();
+    if (parallel)
+    {
+        problem.parallelGaussSeidel(0, solver.get());
+    }
+    else
+    {
+        problem.gaussSeidel(0, solver.get());
+    }
+    return std::vector<SReal>(problem.getF(), problem.getF() + problem.getDimension());
+}
+
+}
+
+TEST(GenericConstraintProblem, parallelGaussSeidelConvergesToProjectedGaussSeidel)
+{
+    const ContactProblemDescription description(300, 400, 1);
+
+    ConstraintProblem sequentialProblem;
+    description.fill(sequentialProblem);
+    const std::vector<SReal> sequentialForces = solve(sequentialProblem, false);
+
+    ConstraintProblem parallelProblem;
+    description.fill(parallelProblem);
+    const std::vector<SReal> parallelForces = solve(parallelProblem, true);
+
+    EXPECT_LT(sequentialProblem.currentError, sequentialProblem.tolerance);
+    EXPECT_LT(parallelProblem.currentError, parallelProblem.tolerance);
+
+    // the groups are visited in another order: the methods converge to the same solution
+    ASSERT_EQ(parallelForces.size(), sequentialForces.size());
+    for (std::size_t i = 0; i < parallelForces.size(); ++i)
+    {
+        EXPECT_NEAR(parallelForces[i], sequentialForces[i], 1e-6) << "line " << i;
+    }
+}
+
+TEST(GenericConstraintProblem, constraintGroupColoringHasNoConflict)
+{
+    const ContactProblemDescription description(300, 400, 2);
+
+    ConstraintProblem problem;
+    description.fill(problem);
+    problem.computeConstraintGroupColors();
+
+    const int nbGroups = problem.getNumConstraintGroups();
+    ASSERT_EQ(static_cast<int>(problem.m_groupFirstLine.size()), nbGroups + 1);
+    ASSERT_EQ(static_cast<int>(problem.m_colorGroups.size()), nbGroups);
+
+    // a sparse problem is split into a few colors, and each group has exactly one color
+    const int nbColors = problem.getNbConstraintGroupColors();
+    EXPECT_GT(nbColors, 1);
+    EXPECT_LT(nbColors, 20);
+
+    std::vector<int> groupColor(nbGroups, -1);
+    for (int c = 0; c < nbColors; ++c)
+    {
+        for (int i = problem.m_colorPtr[c]; i < problem.m_colorPtr[c + 1]; ++i)
+        {
+            const int group = problem.m_colorGroups[i];
+            ASSERT_EQ(groupColor[group], -1) << "group " << group << " has two colors";
+            groupColor[group] = c;
+        }
+    }
+
+    // two groups of the same color are not coupled in W
+    SReal** w = problem.getW();
+    for (int g = 0; g < nbGroups; ++g)
+    {
+        for (int h = 0; h < nbGroups; ++h)
+        {
+            if (g == h || groupColor[g] != groupColor[h])
+                continue;
+
+            for (int i = problem.m_groupFirstLine[g]; i < problem.m_groupFirstLine[g + 1]; ++i)
+            {
+                for (int k = problem.m_groupFirstLine[h]; k < problem.m_groupFirstLine[h + 1]; ++k)
+                {
+                    ASSERT_EQ(w[i][k], 0) << "groups " << g << " and " << h << " have the color " << groupColor[g];
+                }
+            }
+        }
+    }
+}
+
+TEST(GenericConstraintProblem, parallelGaussSeidelDoesNotDependOnThreadCount)
+{
+    const ContactProblemDescription description(300, 400, 3);
+    simulation::TaskScheduler* taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    ASSERT_NE(taskScheduler, nullptr);
+
+    std::vector<SReal> referenceForces;
+    for (const unsigned int nbThreads : {1u, 2u, 4u})
+    {
+        taskScheduler->init(nbThreads);
+
+        // a fixed number of iterations, which does not converge
+        ConstraintProblem problem;
+        description.fill(problem);
+        problem.tolerance = 0;
+        problem.maxIterations = 10;
+        const std::vector<SReal> forces = solve(problem, true);
+
+        if (referenceForces.empty())
+        {
+            referenceForces = forces;
+        }
+        else
+        {
+            EXPECT_EQ(forces, referenceForces) << nbThreads << " threads";
+        }
+    }
+
+    taskScheduler->init(0);
+}
+
+TEST(GenericConstraintProblem, constraintGroupColoringIsCached)
+{
+    const ContactProblemDescription description(300, 400, 4);
+
+    ConstraintProblem problem;
+    description.fill(problem);
+    EXPECT_TRUE(problem.updateConstraintGroupColors());
+
+    // same structure, other values
+    problem.getW()[0][0] *= 2;
+    problem.getDfree()[0] = 1;
+    EXPECT_FALSE(problem.updateConstraintGroupColors());
+
+    // a coupling which disappears keeps the coloring
+    const int firstNeighbor = [&problem]()
+    {
+        for (int k = problem.m_groupFirstLine[1]; k < problem.getDimension(); ++k)
+        {
+            if (problem.getW()[0][k] != 0)
+                return k;
+        }
+        return -1;
+    }();
+    ASSERT_GT(firstNeighbor, 0);
+    problem.getW()[0][firstNeighbor] = problem.getW()[firstNeighbor][0] = 0;
+    EXPECT_FALSE(problem.updateConstraintGroupColors());
+
+    // new coupling between two groups of the first color
+    const int group0 = problem.m_colorGroups[problem.m_colorPtr[0]];
+    const int group1 = problem.m_colorGroups[problem.m_colorPtr[0] + 1];
+    const int line0 = problem.m_groupFirstLine[group0];
+    const int line1 = problem.m_groupFirstLine[group1];
+    problem.getW()[line0][line1] = problem.getW()[line1][line0] = 0.1;
+    EXPECT_TRUE(problem.updateConstraintGroupColors());
+    EXPECT_FALSE(problem.updateConstraintGroupColors());
+
+    // other constraint groups
+    const ContactProblemDescription otherDescription(300, 401, 4);
+    otherDescription.fill(problem);
+    EXPECT_TRUE(problem.updateConstraintGroupColors());
+}
+
+}
@@ -0,0 +1,120 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/component/haptics/HapticLoopMonitor.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace sofa::component::haptics
+{
+
+using helper::system::thread::CTime;
+
+HapticLoopMonitor::HapticLoopMonitor(double expectedPeriod, double reportPeriod)
+    : m_expectedPeriod(expectedPeriod)
+    , m_reportPeriod(reportPeriod)
+{
+}
+
+void HapticLoopMonitor::setExpectedPeriod(double expectedPeriod)
+{
+    m_expectedPeriod.store(expectedPeriod, std::memory_order_relaxed);
+}
+
+double HapticLoopMonitor::getExpectedPeriod() const
+{
+    return m_expectedPeriod.load(std::memory_order_relaxed);
+}
+
+void HapticLoopMonitor::addIteration(ctime_t now, ctime_t snapshotTime)
+{
+    const double ticksPerSec = double(CTime::getTicksPerSec());
+
+    if (m_previousTime == 0)
+    {
+        m_reportStartTime = now;
+    }
+    ++m_nbIterations;
+
+    if (m_previousTime != 0 && now >= m_previousTime)
+    {
+        const double expectedPeriod = getExpectedPeriod();
+        const double period = double(now - m_previousTime) / ticksPerSec;
+        const double jitter = std::abs(period - expectedPeriod);
+        m_sumSquaredJitter += jitter * jitter;
+        m_current.maxJitter = std::max(m_current.maxJitter, jitter);
+        if (period > 2 * expectedPeriod)
+        {
+            ++m_current.missedDeadlines;
+        }
+        ++m_nbPeriods;
+    }
+    m_previousTime = now;
+
+    if (snapshotTime != 0 && now >= snapshotTime)
+    {
+        const double age = double(now - snapshotTime) / ticksPerSec;
+        m_sumSnapshotAge += age;
+        m_current.maxSnapshotAge = std::max(m_current.maxSnapshotAge, age);
+        ++m_nbSnapshots;
+    }
+
+    if (double(now - m_reportStartTime) >= m_reportPeriod * ticksPerSec)
+    {
+        publish();
+    }
+}
+
+void HapticLoopMonitor::publish()
+{
+    const double ticksPerSec = double(CTime::getTicksPerSec());
+    const double duration = double(m_previousTime - m_reportStartTime) / ticksPerSec;
+
+    m_current.nbIterations = m_nbIterations;
+    m_current.frequency = (duration > 0 && m_nbPeriods > 0) ? m_nbPeriods / duration : 0.;
+    m_current.jitter = m_nbPeriods > 0 ? std::sqrt(m_sumSquaredJitter / m_nbPeriods) : 0.;
+    m_current.snapshotAge = m_nbSnapshots > 0 ? m_sumSnapshotAge / m_nbSnapshots : 0.;
+
+    m_published.getWriteBuffer() = m_current;
+    m_published.publish();
+
+    // the next report starts at the last iteration, so that its period is counted
+    m_reportStartTime = m_previousTime;
+    m_nbIterations = 0;
+    m_nbPeriods = 0;
+    m_nbSnapshots = 0;
+    m_sumSquaredJitter = 0.;
+    m_sumSnapshotAge = 0.;
+    m_current = Statistics();
+}
+
+bool HapticLoopMonitor::getStatistics(Statistics& statistics)
+{
+    if (!m_published.update())
+    {
+        return false;
+    }
+    statistics = m_published.getReadBuffer();
+    return true;
+}
+
+} // namespace sofa::component::haptics
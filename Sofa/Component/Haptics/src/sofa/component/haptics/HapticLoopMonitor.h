@@ -0,0 +1,93 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/haptics/config.h>
+
+#include <sofa/component/haptics/TripleBuffer.h>
+#include <sofa/helper/system/thread/CTime.h>
+
+#include <atomic>
+
+namespace sofa::component::haptics
+{
+
+/**
+ * Statistics of a haptic loop: frequency, jitter of the loop period, missed deadlines, and age of the snapshot of
+ * the simulation used by each iteration.
+ *
+ * The haptic thread records its iterations, and publishes the statistics of the last report period without locks.
+ * Any other thread can get them.
+ */
+class SOFA_COMPONENT_HAPTICS_API HapticLoopMonitor
+{
+public:
+    using ctime_t = helper::system::thread::ctime_t;
+
+    struct Statistics
+    {
+        unsigned int nbIterations { 0 };
+        double frequency { 0. }; ///< iterations per second
+        double jitter { 0. }; ///< root mean square of the deviation of the loop period from the expected one, in seconds
+        double maxJitter { 0. }; ///< maximum deviation of the loop period from the expected one, in seconds
+        unsigned int missedDeadlines { 0 }; ///< number of iterations whose period exceeds twice the expected one
+        double snapshotAge { 0. }; ///< mean age of the snapshots used by the iterations, in seconds
+        double maxSnapshotAge { 0. }; ///< maximum age of the snapshots used by the iterations, in seconds
+    };
+
+    /// @param expectedPeriod expected period of the haptic loop, in seconds
+    /// @param reportPeriod period of the publication of the statistics, in seconds
+    explicit HapticLoopMonitor(double expectedPeriod = 0.001, double reportPeriod = 1.0);
+
+    void setExpectedPeriod(double expectedPeriod);
+    double getExpectedPeriod() const;
+
+    /// Haptic thread: record an iteration starting at the time now, which uses a snapshot of the simulation taken at
+    /// the time snapshotTime (0 if there is none). The times are given by CTime::getTime.
+    /// The statistics are published if the report period has elapsed.
+    void addIteration(ctime_t now, ctime_t snapshotTime);
+
+    /// Haptic thread: publish the statistics of the iterations recorded since the last publication
+    void publish();
+
+    /// Any other thread: get the statistics published since the last call. Returns false if there are none.
+    bool getStatistics(Statistics& statistics);
+
+protected:
+    std::atomic<double> m_expectedPeriod;
+    const double m_reportPeriod;
+
+    /// Accumulators, owned by the haptic thread
+    /// @{
+    ctime_t m_reportStartTime { 0 };
+    ctime_t m_previousTime { 0 };
+    unsigned int m_nbIterations { 0 };
+    unsigned int m_nbPeriods { 0 };
+    unsigned int m_nbSnapshots { 0 };
+    double m_sumSquaredJitter { 0. };
+    double m_sumSnapshotAge { 0. };
+    Statistics m_current;
+    /// @}
+
+    TripleBuffer<Statistics> m_published;
+};
+
+} // namespace sofa::component::haptics
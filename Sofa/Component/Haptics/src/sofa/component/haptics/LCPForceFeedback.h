@@ -23,6 +23,8 @@
 #include <sofa/component/haptics/config.h>
 
 #include <sofa/component/haptics/MechanicalStateForceFeedback.h>
+#include <sofa/component/haptics/HapticLoopMonitor.h>
+#include <sofa/component/haptics/TripleBuffer.h>
 #include <sofa/core/behavior/MechanicalState.h>
 #include <sofa/helper/system/thread/CTime.h>
 #include <mutex>
@@ -81,6 +83,18 @@ public:
     // Enable/disable constraint haptic influence from all frames
     Data< bool > d_localHapticConstraintAllFrames; ///< Flag to enable/disable constraint haptic influence from all frames
 
+    Data< double > d_hapticPeriod; ///< expected period of the haptic loop, in seconds
+
+    /// Statistics of the haptic loop over the last second, updated at the end of each time step
+    /// @{
+    Data< double > d_hapticFrequency; ///< frequency of the haptic loop
+    Data< double > d_hapticJitter; ///< root mean square of the deviation of the haptic loop period from hapticPeriod, in seconds
+    Data< double > d_hapticMaxJitter; ///< maximum deviation of the haptic loop period from hapticPeriod, in seconds
+    Data< unsigned int > d_hapticMissedDeadlines; ///< number of haptic loop iterations whose period exceeds twice hapticPeriod
+    Data< double > d_snapshotAge; ///< mean age of the constraint problem snapshots used by the haptic loop, in seconds
+    Data< double > d_maxSnapshotAge; ///< maximum age of the constraint problem snapshots used by the haptic loop, in seconds
+    /// @}
+
     void computeForce(SReal x, SReal y, SReal z,
                       SReal u, SReal v, SReal w,
                       SReal q, SReal& fx, SReal& fy, SReal& fz) override;
@@ -122,26 +136,33 @@ public:
     void setLock(bool value) override;
 
 protected:
+    /// Constraint problem and constraints of a time step, used by the haptic thread to compute the forces
+    struct ConstraintProblemSnapshot
+    {
+        VecCoord val;
+        MatrixDeriv constraints;
+        component::constraint::lagrangian::solver::ConstraintProblem* cp { nullptr };
+        helper::system::thread::ctime_t time { 0 }; ///< time of the publication of the snapshot
+    };
+
     core::behavior::MechanicalState<DataTypes> *mState; ///< The device try to follow this mechanical state.
-    VecCoord mVal[3];
-    MatrixDeriv mConstraints[3];
-    std::vector<int> mId_buf[3];
-    component::constraint::lagrangian::solver::ConstraintProblem* mCP[3];
 
-    unsigned char mNextBufferId; // Next buffer id to be use
-    unsigned char mCurBufferId; // Current buffer id in use
-    bool mIsCuBufferInUse; // Is current buffer currently in use right now
+    /// Snapshots written by the simulation thread and read by the haptic thread, without locks
+    TripleBuffer<ConstraintProblemSnapshot> m_snapshots;
 
     sofa::component::constraint::lagrangian::solver::ConstraintSolverImpl* constraintSolver;
 
     /// timer: verifies the time rates of the haptic loop
     helper::system::thread::CTime *_timer;
-    helper::system::thread::ctime_t time_buf;
-    int timer_iterations;
+    HapticLoopMonitor m_hapticLoopMonitor;
     double haptic_freq;
     unsigned int num_constraints;
 
+    /// Forces of the last computation, sent again if the computation is locked
+    VecDeriv m_lastForces;
+
     /// mutex used in method @doComputeForce which can be touched from outside using method @sa setLock if components are modified in another thread.
+    /// The haptic thread does not wait for it.
     std::mutex lockForce;
 };
 
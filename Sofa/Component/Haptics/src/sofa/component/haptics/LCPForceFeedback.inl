@@ -126,24 +126,29 @@ LCPForceFeedback<DataTypes>::LCPForceFeedback()
     , d_solverMaxIt(initData(&d_solverMaxIt, 100, "solverMaxIt", "max iteration to spend solving constraints"))
     , d_derivRotations(initData(&d_derivRotations, false, "derivRotations", "if true, deriv the rotations when updating the violations"))
     , d_localHapticConstraintAllFrames(initData(&d_localHapticConstraintAllFrames, false, "localHapticConstraintAllFrames", "Flag to enable/disable constraint haptic influence from all frames"))
+    , d_hapticPeriod(initData(&d_hapticPeriod, 0.001, "hapticPeriod", "expected period of the haptic loop, in seconds"))
+    , d_hapticFrequency(initData(&d_hapticFrequency, 0.0, "hapticFrequency", "frequency of the haptic loop"))
+    , d_hapticJitter(initData(&d_hapticJitter, 0.0, "hapticJitter", "root mean square of the deviation of the haptic loop period from hapticPeriod, in seconds"))
+    , d_hapticMaxJitter(initData(&d_hapticMaxJitter, 0.0, "hapticMaxJitter", "maximum deviation of the haptic loop period from hapticPeriod, in seconds"))
+    , d_hapticMissedDeadlines(initData(&d_hapticMissedDeadlines, 0u, "hapticMissedDeadlines", "number of haptic loop iterations whose period exceeds twice hapticPeriod"))
+    , d_snapshotAge(initData(&d_snapshotAge, 0.0, "snapshotAge", "mean age of the constraint problem snapshots used by the haptic loop, in seconds"))
+    , d_maxSnapshotAge(initData(&d_maxSnapshotAge, 0.0, "maxSnapshotAge", "maximum age of the constraint problem snapshots used by the haptic loop, in seconds"))
     , mState(nullptr)
-    , mNextBufferId(0)
-    , mCurBufferId(0)
-    , mIsCuBufferInUse(false)
     , constraintSolver(nullptr)
     , _timer(nullptr)
-    , time_buf(0)
-    , timer_iterations(0)
     , haptic_freq(0.0)
     , num_constraints(0)
 {
     this->f_listening.setValue(true);
-    mCP[0] = nullptr;
-    mCP[1] = nullptr;
-    mCP[2] = nullptr;
     _timer = new helper::system::thread::CTime();
-    time_buf = _timer->getTime();
-    timer_iterations = 0;
+
+    for (auto* data : {&d_hapticFrequency, &d_hapticJitter, &d_hapticMaxJitter, &d_snapshotAge, &d_maxSnapshotAge})
+    {
+        data->setReadOnly(true);
+        data->setGroup("Statistics");
+    }
+    d_hapticMissedDeadlines.setReadOnly(true);
+    d_hapticMissedDeadlines.setGroup("Statistics");
 
     forceCoef.setOriginalData(&d_forceCoef);
     solverTimeout.setOriginalData(&d_solverTimeout);
@@ -195,53 +200,37 @@ void LCPForceFeedback<DataTypes>::computeForce(const VecCoord& state,  VecDeriv&
     {
         return;
     }
-    updateStats();
 
-    lockForce.lock(); // check if computation has not been locked using setLock method.
-    updateConstraintProblem();
-    doComputeForce(state, forces);
-    lockForce.unlock();
+    // check if computation has not been locked using setLock method. The haptic thread does not wait: the last
+    // forces are sent again
+    std::unique_lock<std::mutex> lock(lockForce, std::try_to_lock);
+    if (lock.owns_lock())
+    {
+        updateConstraintProblem();
+        doComputeForce(state, forces);
+        m_lastForces = forces;
+    }
+    else
+    {
+        forces = m_lastForces;
+        forces.resize(state.size());
+    }
+
+    updateStats();
 }
 template <class DataTypes>
 void LCPForceFeedback<DataTypes>::updateStats()
 {
-    using namespace helper::system::thread;
-
-    const ctime_t actualTime = _timer->getTime();
-    ++timer_iterations;
-    if (actualTime - time_buf >= sofa::helper::system::thread::CTime::getTicksPerSec())
-    {
-        haptic_freq = (double)(timer_iterations*sofa::helper::system::thread::CTime::getTicksPerSec())/ (double)( actualTime - time_buf) ;
-        time_buf = actualTime;
-        timer_iterations = 0;
-    }
+    m_hapticLoopMonitor.addIteration(_timer->getTime(), m_snapshots.getReadBuffer().time);
 }
 
 template <class DataTypes>
 bool LCPForceFeedback<DataTypes>::updateConstraintProblem()
 {
-    const int prevId = mCurBufferId;
-
     //
     // Retrieve the last LCP and constraints computed by the Sofa thread.
     //
-    mIsCuBufferInUse = true;
-
-    {
-        // TODO: Lock and/or memory barrier HERE
-        mCurBufferId = mNextBufferId;
-    }
-
-    const bool changed = (prevId != mCurBufferId);
-
-    const sofa::component::constraint::lagrangian::solver::ConstraintProblem* cp = mCP[mCurBufferId];
-
-    if(!cp)
-    {
-        mIsCuBufferInUse = false;
-    }
-
-    return changed;
+    return m_snapshots.update();
 }
 
 template <class DataTypes>
@@ -257,9 +246,10 @@ void LCPForceFeedback<DataTypes>::doComputeForce(const VecCoord& state,  VecDeri
     if(!constraintSolver||!mState)
         return;
 
-    const MatrixDeriv& constraints = mConstraints[mCurBufferId];
-    VecCoord &val = mVal[mCurBufferId];
-    sofa::component::constraint::lagrangian::solver::ConstraintProblem* cp = mCP[mCurBufferId];
+    const ConstraintProblemSnapshot& snapshot = m_snapshots.getReadBuffer();
+    const MatrixDeriv& constraints = snapshot.constraints;
+    const VecCoord& val = snapshot.val;
+    sofa::component::constraint::lagrangian::solver::ConstraintProblem* cp = snapshot.cp;
 
     if(!cp)
     {
@@ -336,6 +326,19 @@ void LCPForceFeedback<DataTypes>::handleEvent(sofa::core::objectmodel::Event *ev
     if (!sofa::simulation::AnimateEndEvent::checkEventType(event))
         return;
 
+    m_hapticLoopMonitor.setExpectedPeriod(d_hapticPeriod.getValue());
+    HapticLoopMonitor::Statistics statistics;
+    if (m_hapticLoopMonitor.getStatistics(statistics))
+    {
+        haptic_freq = statistics.frequency;
+        d_hapticFrequency.setValue(statistics.frequency);
+        d_hapticJitter.setValue(statistics.jitter);
+        d_hapticMaxJitter.setValue(statistics.maxJitter);
+        d_hapticMissedDeadlines.setValue(statistics.missedDeadlines);
+        d_snapshotAge.setValue(statistics.snapshotAge);
+        d_maxSnapshotAge.setValue(statistics.maxSnapshotAge);
+    }
+
     if (!constraintSolver)
         return;
 
@@ -347,35 +350,19 @@ void LCPForceFeedback<DataTypes>::handleEvent(sofa::core::objectmodel::Event *ev
     if (!new_cp)
         return;
 
-    // Find available buffer
+    // Compute constraints, lcp and val for the current lcp, in the buffer owned by the simulation thread
 
-    unsigned char buf_index=0;
-    const unsigned char cbuf_index=mCurBufferId;
-    const unsigned char nbuf_index=mNextBufferId;
-
-    if (buf_index == cbuf_index || buf_index == nbuf_index)
-    {
-        buf_index++;
-        if (buf_index == cbuf_index || buf_index == nbuf_index)
-            buf_index++;
-    }
-
-    // Compute constraints, id_buf lcp and val for the current lcp.
-
-    MatrixDeriv& constraints = mConstraints[buf_index];
-
-    //	std::vector<int>& id_buf = mId_buf[buf_index];
-    VecCoord& val = mVal[buf_index];
+    ConstraintProblemSnapshot& snapshot = m_snapshots.getWriteBuffer();
 
     // Update LCP
-    mCP[buf_index] = new_cp;
+    snapshot.cp = new_cp;
 
     // Update Val
-    val = mState->read(sofa::core::VecCoordId::freePosition())->getValue();
+    snapshot.val = mState->read(sofa::core::VecCoordId::freePosition())->getValue();
 
-    // Update constraints and id_buf
+    // Update constraints
+    MatrixDeriv& constraints = snapshot.constraints;
     constraints.clear();
-    //	id_buf.clear();
 
     const MatrixDeriv& c = mState->read(core::ConstMatrixDerivId::constraintJacobian())->getValue()   ;
 
@@ -389,18 +376,15 @@ void LCPForceFeedback<DataTypes>::handleEvent(sofa::core::objectmodel::Event *ev
     // make sure the MatrixDeriv has been compressed
     constraints.compress();
 
-    // valid buffer
+    snapshot.time = _timer->getTime();
 
-    {
-        // TODO: Lock and/or memory barrier HERE
-        mNextBufferId = buf_index;
-    }
+    // valid buffer: the haptic thread uses it from its next iteration
+    m_snapshots.publish();
 
-    // Lock lcp to prevent its use by the SOFA thread while it is used by haptic thread
-    if(mIsCuBufferInUse)
-        constraintSolver->lockConstraintProblem(this, mCP[mCurBufferId], mCP[mNextBufferId]);
-    else
-        constraintSolver->lockConstraintProblem(this, mCP[mNextBufferId]);
+    // Lock the lcps of the two other buffers, the latest one and the one which may be in use by the haptic thread,
+    // to prevent their use by the SOFA thread
+    const auto sharedSnapshots = m_snapshots.getSharedBuffers();
+    constraintSolver->lockConstraintProblem(this, sharedSnapshots[0]->cp, sharedSnapshots[1]->cp);
 }
 
 
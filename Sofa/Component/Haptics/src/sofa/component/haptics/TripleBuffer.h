@@ -0,0 +1,95 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/haptics/config.h>
+
+#include <array>
+#include <atomic>
+
+namespace sofa::component::haptics
+{
+
+/**
+ * Wait-free exchange of the latest value of a producer thread with a consumer thread.
+ *
+ * The producer writes into its own buffer and publishes it, the consumer reads its own buffer and acquires the
+ * latest published one. The third buffer holds the latest published value between the two. Publishing and
+ * acquiring are a single atomic exchange: neither thread ever waits for the other one, and the consumer always
+ * reads a complete value, possibly an older one if nothing was published since its last acquisition.
+ */
+template<class T>
+class TripleBuffer
+{
+public:
+
+    /// Producer: the buffer to write the next value into. It keeps its content until it is published.
+    T& getWriteBuffer()
+    {
+        return m_buffers[m_writeIndex];
+    }
+
+    /// Producer: make the write buffer the latest value, and get the previous latest one as the new write buffer.
+    void publish()
+    {
+        const unsigned char previous = m_latest.exchange(m_writeIndex | Fresh, std::memory_order_acq_rel);
+        m_writeIndex = previous & IndexMask;
+    }
+
+    /// Producer: the two buffers which are not the write buffer, i.e. the latest value and the one read by the
+    /// consumer. The consumer only reads its buffer, so the producer can read them concurrently.
+    std::array<const T*, 2> getSharedBuffers() const
+    {
+        return { &m_buffers[(m_writeIndex + 1) % 3], &m_buffers[(m_writeIndex + 2) % 3] };
+    }
+
+    /// Consumer: make the latest value the read buffer, if a value was published since the last call.
+    /// Returns true if the read buffer changed.
+    bool update()
+    {
+        // only the consumer clears the flag: it is still set in the exchange
+        if (!(m_latest.load(std::memory_order_relaxed) & Fresh))
+        {
+            return false;
+        }
+
+        m_readIndex = m_latest.exchange(m_readIndex, std::memory_order_acq_rel) & IndexMask;
+        return true;
+    }
+
+    /// Consumer: the value acquired by the last update, or a value-initialized one before the first publication.
+    const T& getReadBuffer() const
+    {
+        return m_buffers[m_readIndex];
+    }
+
+private:
+
+    static constexpr unsigned char IndexMask = 3;
+    static constexpr unsigned char Fresh = 4;
+
+    std::array<T, 3> m_buffers {};
+    unsigned char m_writeIndex { 0 }; ///< owned by the producer
+    unsigned char m_readIndex { 1 };  ///< owned by the consumer
+    std::atomic<unsigned char> m_latest { 2 }; ///< index of the latest value, and whether it was published since the last update
+};
+
+} // namespace sofa::component::haptics
@@ -0,0 +1,81 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <sofa/component/haptics/HapticLoopMonitor.h>
+
+#include <cmath>
+
+namespace sofa
+{
+
+using component::haptics::HapticLoopMonitor;
+using helper::system::thread::CTime;
+using helper::system::thread::ctime_t;
+
+TEST(HapticLoopMonitor, statistics)
+{
+    const ctime_t ticksPerMs = CTime::getTicksPerSec() / 1000;
+    const ctime_t start = 1000 * ticksPerMs;
+
+    // expected period of 1ms, reported every 100ms
+    HapticLoopMonitor monitor(0.001, 0.1);
+    HapticLoopMonitor::Statistics statistics;
+    EXPECT_FALSE(monitor.getStatistics(statistics));
+
+    // 50 iterations at 1ms, one iteration after 5ms (missed deadline), using a snapshot of 10ms then 2ms
+    ctime_t now = start;
+    for (unsigned int i = 0; i < 50; ++i)
+    {
+        monitor.addIteration(now, start - 10 * ticksPerMs);
+        now += ticksPerMs;
+    }
+    now += 4 * ticksPerMs;
+    monitor.addIteration(now, now - 2 * ticksPerMs);
+
+    // the report period has not elapsed
+    EXPECT_FALSE(monitor.getStatistics(statistics));
+    monitor.publish();
+    ASSERT_TRUE(monitor.getStatistics(statistics));
+    EXPECT_FALSE(monitor.getStatistics(statistics));
+
+    EXPECT_EQ(statistics.nbIterations, 51u);
+    EXPECT_NEAR(statistics.frequency, 50 / 0.054, 1e-6);
+    EXPECT_EQ(statistics.missedDeadlines, 1u);
+    EXPECT_NEAR(statistics.maxJitter, 0.004, 1e-9);
+    EXPECT_NEAR(statistics.jitter, std::sqrt(0.004 * 0.004 / 50), 1e-9);
+    EXPECT_NEAR(statistics.maxSnapshotAge, 0.059, 1e-9);
+    EXPECT_GT(statistics.snapshotAge, 0.01);
+    EXPECT_LT(statistics.snapshotAge, statistics.maxSnapshotAge);
+
+    // the statistics are published automatically when the report period has elapsed
+    for (unsigned int i = 0; i < 150; ++i)
+    {
+        now += ticksPerMs;
+        monitor.addIteration(now, 0);
+    }
+    ASSERT_TRUE(monitor.getStatistics(statistics));
+    EXPECT_EQ(statistics.missedDeadlines, 0u);
+    EXPECT_NEAR(statistics.jitter, 0., 1e-9);
+    EXPECT_EQ(statistics.snapshotAge, 0.);
+}
+
+}
@@ -0,0 +1,104 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <sofa/component/haptics/TripleBuffer.h>
+
+#include <thread>
+#include <vector>
+
+namespace sofa
+{
+
+using component::haptics::TripleBuffer;
+
+TEST(TripleBuffer, sequential)
+{
+    TripleBuffer<int> buffer;
+
+    // nothing published yet
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(buffer.getReadBuffer(), 0);
+
+    buffer.getWriteBuffer() = 1;
+    buffer.publish();
+    buffer.getWriteBuffer() = 2;
+    buffer.publish();
+
+    // only the latest value is read
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.getReadBuffer(), 2);
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(buffer.getReadBuffer(), 2);
+
+    // the read buffer is not shared with the producer
+    buffer.getWriteBuffer() = 3;
+    EXPECT_EQ(buffer.getReadBuffer(), 2);
+    const auto shared = buffer.getSharedBuffers();
+    EXPECT_NE(shared[0], &buffer.getWriteBuffer());
+    EXPECT_NE(shared[1], &buffer.getWriteBuffer());
+    EXPECT_TRUE(shared[0] == &buffer.getReadBuffer() || shared[1] == &buffer.getReadBuffer());
+
+    buffer.publish();
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.getReadBuffer(), 3);
+}
+
+TEST(TripleBuffer, concurrent)
+{
+    // each value is a sequence of identical numbers: a torn value would mix two of them
+    TripleBuffer<std::vector<int>> buffer;
+    constexpr int nbValues = 100000;
+    constexpr std::size_t valueSize = 64;
+
+    std::thread producer([&buffer]()
+    {
+        for (int i = 1; i <= nbValues; ++i)
+        {
+            buffer.getWriteBuffer().assign(valueSize, i);
+            buffer.publish();
+        }
+    });
+
+    int previous = 0;
+    while (previous < nbValues)
+    {
+        if (!buffer.update())
+        {
+            continue;
+        }
+
+        const std::vector<int>& value = buffer.getReadBuffer();
+        ASSERT_EQ(value.size(), valueSize);
+        for (const int v : value)
+        {
+            ASSERT_EQ(v, value.front());
+        }
+
+        // the values are read in the order of their publication
+        ASSERT_GT(value.front(), previous);
+        previous = value.front();
+    }
+
+    producer.join();
+}
+
+}
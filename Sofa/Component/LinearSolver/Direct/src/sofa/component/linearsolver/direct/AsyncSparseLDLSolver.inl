@@ -32,6 +32,15 @@ template <class TMatrix, class TVector, class TThreadManager>
 void AsyncSparseLDLSolver<TMatrix, TVector, TThreadManager>::init()
 {
     Inherit1::init();
+
+    if (this->d_parallelFactorization.getValue())
+    {
+        // the factorization runs in a thread which is not known by the task scheduler
+        msg_warning() << "The parallel factorization is not supported by the asynchronous factorization. "
+                         "Data '" << this->d_parallelFactorization.getName() << "' is ignored.";
+        this->d_parallelFactorization.setValue(false);
+    }
+
     waitForAsyncTask = true;
     m_asyncThreadInvertData = &m_secondInvertData;
     m_mainThreadInvertData = static_cast<InvertData*>(this->invertData.get());
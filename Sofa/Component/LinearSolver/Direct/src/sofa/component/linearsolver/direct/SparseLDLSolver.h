@@ -80,6 +80,9 @@ protected :
     void showInvalidSystemMessage(const std::string& reason) const;
 
     using Triplet = std::tuple<sofa::SignedIndex, sofa::SignedIndex, Real>;
+
+    /// Number of right-hand side vectors solved together when computing J * M^-1 * J^T
+    static constexpr unsigned int RHSBlockSize = 8;
 };
 
 #if !defined(SOFA_COMPONENT_LINEARSOLVER_SPARSELDLSOLVER_CPP)
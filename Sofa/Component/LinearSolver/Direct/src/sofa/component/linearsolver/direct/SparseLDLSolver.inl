@@ -201,32 +201,49 @@ bool SparseLDLSolver<TMatrix, TVector, TThreadManager>::doAddJMInvJtLocal(ResMat
 
     {
         SCOPED_TIMER("LowerSystem");
-        simulation::forEachRange(execution, *taskScheduler, 0u, JlocalRowSize,
-            [&data, this](const auto& range)
+
+        // The rows of JLinv are solved by blocks of RHSBlockSize vectors: the vectors of a block are
+        // interleaved in a buffer, so that each value of L is loaded once for the whole block.
+        const unsigned int nbBlocks = (JlocalRowSize + RHSBlockSize - 1) / RHSBlockSize;
+        simulation::forEachRange(execution, *taskScheduler, 0u, nbBlocks,
+            [&data, this, JlocalRowSize](const auto& range)
             {
                 SCOPED_TIMER("Lower");
-                for (auto i = range.start; i != range.end; ++i)
+                const int n = data->n;
+                type::vector<Real> interleaved(static_cast<std::size_t>(n) * RHSBlockSize);
+
+                for (auto block = range.start; block != range.end; ++block)
                 {
-                    Real* line = JLinv[i];
-                    sofa::linearalgebra::solveLowerUnitriangularSystemCSR(data->n, line, line, data->LT_colptr.data(), data->LT_rowind.data(), data->LT_values.data());
+                    const unsigned int firstRow = block * RHSBlockSize;
+                    const unsigned int nbRows = std::min(RHSBlockSize, JlocalRowSize - firstRow);
+
+                    for (unsigned int r = 0; r < RHSBlockSize; ++r)
+                    {
+                        const Real* line = r < nbRows ? JLinv[firstRow + r] : nullptr;
+                        for (int i = 0; i < n; ++i)
+                        {
+                            interleaved[i * RHSBlockSize + r] = line ? line[i] : 0;
+                        }
+                    }
+
+                    sofa::linearalgebra::solveLowerUnitriangularSystemCSRMultipleRHS<RHSBlockSize>(n,
+                        interleaved.data(), interleaved.data(),
+                        data->LT_colptr.data(), data->LT_rowind.data(), data->LT_values.data());
+
+                    for (unsigned int r = 0; r < nbRows; ++r)
+                    {
+                        Real* lineD = JLinv[firstRow + r];
+                        Real* lineM = JLinvDinv[firstRow + r];
+                        for (int i = 0; i < n; ++i)
+                        {
+                            lineD[i] = interleaved[i * RHSBlockSize + r];
+                        }
+                        sofa::linearalgebra::solveDiagonalSystemUsingInvertedValues(n, lineD, lineM, data->invD.data());
+                    }
                 }
             });
     }
 
-    {
-        SCOPED_TIMER("Diagonal");
-        simulation::forEachRange(execution, *taskScheduler, 0u, JlocalRowSize,
-           [&data, this](const auto& range)
-           {
-               for (auto i = range.start; i != range.end; ++i)
-               {
-                   Real* lineD = JLinv[i];
-                   Real* lineM = JLinvDinv[i];
-                   sofa::linearalgebra::solveDiagonalSystemUsingInvertedValues(data->n, lineD, lineM, data->invD.data());
-               }
-           });
-    }
-
     const auto nbTriplets = JlocalRowSize * (JlocalRowSize+1) / 2;
     std::vector<Triplet> tripletsBuffer(nbTriplets);
 
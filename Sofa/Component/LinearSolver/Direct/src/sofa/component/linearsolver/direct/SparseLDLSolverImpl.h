@@ -25,10 +25,12 @@
 #include <sofa/helper/ScopedAdvancedTimer.h>
 #include <sofa/component/linearsolver/iterative/MatrixLinearSolver.h>
 #include <sofa/component/linearsolver/direct/SparseCommon.h>
+#include <sofa/component/linearsolver/direct/SupernodalLDL.h>
 #include <sofa/helper/OptionsGroup.h>
 #include <sofa/linearalgebra/DiagonalSystemSolver.h>
 #include <sofa/linearalgebra/TriangularSystemSolver.h>
 #include <sofa/component/linearsolver/ordering/OrderingMethodAccessor.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
 
 
 namespace sofa::component::linearsolver::direct
@@ -62,6 +64,14 @@ public :
 
     type::vector<int> Parent;
     bool new_factorization_needed;
+
+    //level sets of L and L^T (see computeUnitriangularSystemLevelsCSR), only used by the parallel solve
+    type::vector<int> L_levelPtr, L_levelRows;
+    type::vector<int> LT_levelPtr, LT_levelRows;
+
+    //supernodal structure and dense panels, only used by the supernodal factorization
+    SupernodalLDLSymbolic supernodal;
+    VecReal supernodal_values;
 };
 
 inline void CSPARSE_symbolic (int n,int * M_colptr,int * M_rowind,int * colptr,int * perm,int * invperm,int * Parent, int * Flag, int * Lnz)
@@ -94,6 +104,30 @@ inline void CSPARSE_symbolic (int n,int * M_colptr,int * M_rowind,int * colptr,i
     for (int k = 0 ; k < n ; k++) colptr[k+1] = colptr[k] + Lnz[k] ;
 }
 
+// compute the pattern of L (rowind) without computing its values. The row indices of each column are sorted.
+inline void CSPARSE_pattern(int n,int * M_colptr,int * M_rowind,int * colptr,int * rowind,int * perm,int * invperm,int * Parent, int * Flag, int * Lnz)
+{
+    for (int k = 0 ; k < n ; k++)
+    {
+        Flag [k] = k ;		    // mark node k as visited
+        Lnz [k] = 0 ;		    // count of nonzeros in column k of L
+        const int kk = perm[k];  // kth original, or permuted, column
+        for (int p = M_colptr[kk] ; p < M_colptr[kk+1] ; p++)
+        {
+            int i = invperm[M_rowind[p]];
+            if (i < k)
+            {
+                // follow path from i to root of etree, stop at flagged node
+                for ( ; Flag [i] != k ; i = Parent [i])
+                {
+                    rowind[colptr[i] + Lnz[i]++] = k ;	// L (k,i) is nonzero
+                    Flag [i] = k ;			// mark i as visited
+                }
+            }
+        }
+    }
+}
+
 template<class Real>
 inline void CSPARSE_numeric(int n,int * M_colptr,int * M_rowind,Real * M_values,int * colptr,int * rowind,Real * values,Real * D,int * perm,int * invperm,int * Parent, int * Flag, int * Lnz, int * Pattern, Real * Y)
 {
@@ -168,13 +202,43 @@ protected :
     Data<bool> d_precomputeSymbolicDecomposition; ///< If true the solver will reuse the precomputed symbolic decomposition. Otherwise it will recompute it at each step.
     core::objectmodel::lifecycle::DeprecatedData d_applyPermutation{this, "v24.06", "v24.12", "applyPermutation", "Ordering method is now defined using ordering components"};
     Data<int> d_L_nnz; ///< Number of non-zero values in the lower triangular matrix of the factorization. The lower, the faster the system is solved.
+    Data<bool> d_supernodal; ///< If true, the numeric factorization groups the columns sharing the same pattern into dense supernodes.
+    Data<bool> d_parallelFactorization; ///< If true, independent subtrees of the elimination tree are factorized in parallel. Only used by the supernodal factorization.
+    Data<int> d_nbSupernodes; ///< Number of supernodes of the supernodal factorization
+    Data<bool> d_parallelSolve; ///< If true, the independent rows of the triangular systems are solved in parallel
 
 
     SparseLDLSolverImpl()
     : d_precomputeSymbolicDecomposition(initData(&d_precomputeSymbolicDecomposition, true ,"precomputeSymbolicDecomposition", "If true, the solver will reuse the precomputed symbolic decomposition, meaning that it will store the shape of [factor matrix] on the first step, or when its shape changes, and then it will only update its coefficients. When the shape of the matrix changes, a new factorization is computed."
                                                                                                                               "If false, the solver will compute the entire decomposition at each step"))
     , d_L_nnz(initData(&d_L_nnz, 0, "L_nnz", "Number of non-zero values in the lower triangular matrix of the factorization. The lower, the faster the system is solved.", true, true))
-    {}
+    , d_supernodal(initData(&d_supernodal, false, "supernodal", "If true, the numeric factorization groups the consecutive columns of the factor sharing the same pattern into supernodes, factorized with dense kernels. "
+                                                                  "It is faster on large matrices with a block structure, for instance matrices of 3D FEM meshes."))
+    , d_parallelFactorization(initData(&d_parallelFactorization, false, "parallelFactorization", "If true, independent subtrees of the elimination tree are factorized in parallel. Only used if supernodal is true. "
+                                                                                                  "The result does not depend on the number of threads."))
+    , d_nbSupernodes(initData(&d_nbSupernodes, 0, "nbSupernodes", "Number of supernodes of the supernodal factorization", true, true))
+    , d_parallelSolve(initData(&d_parallelSolve, false, "parallelSolve", "If true, the rows of the triangular systems are grouped into levels of independent rows, and large levels are solved in parallel. "
+                                                                          "The result does not depend on the number of threads."))
+    {
+        this->addUpdateCallback("parallelFactorization", {&d_parallelFactorization, &d_parallelSolve},
+        [this](const core::DataTracker& tracker) -> sofa::core::objectmodel::ComponentState
+        {
+            SOFA_UNUSED(tracker);
+            if (d_parallelFactorization.getValue() || d_parallelSolve.getValue())
+            {
+                simulation::TaskScheduler* taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+                assert(taskScheduler);
+
+                if (taskScheduler->getThreadCount() < 1)
+                {
+                    taskScheduler->init(0);
+                    msg_info() << "Task scheduler initialized on " << taskScheduler->getThreadCount() << " threads";
+                }
+            }
+            return this->d_componentState.getValue();
+        },
+        {});
+    }
 
     template<class VecInt,class VecReal>
     void solve_cpu(Real * x,const Real * b,SparseLDLImplInvertData<VecInt,VecReal> * data)
@@ -208,18 +272,36 @@ protected :
             bPermuted[i] = b[perm[i]];
         }
 
+        simulation::TaskScheduler* taskScheduler = getSolveTaskScheduler(data);
+
         // Step 1: compute y from the system L y = b
         // Note that L^T, stored in CSC, corresponds to L in CSR
-        sofa::linearalgebra::solveLowerUnitriangularSystemCSR(n, bPermuted, y,
-            data->LT_colptr.data(), data->LT_rowind.data(), data->LT_values.data());
+        if (taskScheduler)
+        {
+            solveByLevels(*taskScheduler, data->LT_levelPtr, data->LT_levelRows, bPermuted, y,
+                data->LT_colptr.data(), data->LT_rowind.data(), data->LT_values.data());
+        }
+        else
+        {
+            sofa::linearalgebra::solveLowerUnitriangularSystemCSR(n, bPermuted, y,
+                data->LT_colptr.data(), data->LT_rowind.data(), data->LT_values.data());
+        }
 
         // Step 2: compute z from the system D z = y
         sofa::linearalgebra::solveDiagonalSystemUsingInvertedValues(n, y, z, data->invD.data());
 
         // Step 3: compute x from the system L^T x = z
         // Note that L, stored in CSC, corresponds to L^T in CSR
-        sofa::linearalgebra::solveUpperUnitriangularSystemCSR(n, z, xPermuted,
-            data->L_colptr.data(), data->L_rowind.data(), data->L_values.data());
+        if (taskScheduler)
+        {
+            solveByLevels(*taskScheduler, data->L_levelPtr, data->L_levelRows, z, xPermuted,
+                data->L_colptr.data(), data->L_rowind.data(), data->L_values.data());
+        }
+        else
+        {
+            sofa::linearalgebra::solveUpperUnitriangularSystemCSR(n, z, xPermuted,
+                data->L_colptr.data(), data->L_rowind.data(), data->L_values.data());
+        }
 
         // apply the permutation to the solution
         for (int i = 0; i < n; ++i)
@@ -228,6 +310,54 @@ protected :
         }
     }
 
+    /// Minimum number of rows in a level to solve it in parallel. Smaller levels are solved sequentially.
+    static constexpr int MinRowsPerParallelLevel = 256;
+
+    /// @return the task scheduler used to solve the triangular systems, or nullptr if the solve is sequential
+    template<class VecInt,class VecReal>
+    simulation::TaskScheduler* getSolveTaskScheduler(const SparseLDLImplInvertData<VecInt,VecReal> * data) const
+    {
+        if (!d_parallelSolve.getValue() || data->L_levelPtr.empty() || data->LT_levelPtr.empty())
+        {
+            return nullptr;
+        }
+
+        // on average, a level must be large enough to compensate the synchronization between levels
+        const auto nbLevels = std::max(data->L_levelPtr.size(), data->LT_levelPtr.size()) - 1;
+        if (static_cast<std::size_t>(data->n) < nbLevels * MinRowsPerParallelLevel)
+        {
+            return nullptr;
+        }
+
+        simulation::TaskScheduler* taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+        return taskScheduler && taskScheduler->getThreadCount() > 1 ? taskScheduler : nullptr;
+    }
+
+    /// Solve a unitriangular system in CSR format level by level. The rows of a large level are solved in parallel.
+    static void solveByLevels(simulation::TaskScheduler& taskScheduler,
+                              const type::vector<int>& levelPtr, const type::vector<int>& levelRows,
+                              const Real* rhs, Real* solution,
+                              const int* CSR_rows, const int* CSR_columns, const Real* CSR_values)
+    {
+        for (std::size_t l = 0; l + 1 < levelPtr.size(); ++l)
+        {
+            const int* first = levelRows.data() + levelPtr[l];
+            const int* last = levelRows.data() + levelPtr[l + 1];
+            if (last - first < MinRowsPerParallelLevel)
+            {
+                sofa::linearalgebra::solveUnitriangularSystemCSRRows(first, last, rhs, solution, CSR_rows, CSR_columns, CSR_values);
+            }
+            else
+            {
+                simulation::parallelForEachRange(taskScheduler, first, last,
+                    [=](const auto& range)
+                    {
+                        sofa::linearalgebra::solveUnitriangularSystemCSRRows(range.start, range.end, rhs, solution, CSR_rows, CSR_columns, CSR_values);
+                    });
+            }
+        }
+    }
+
     void LDL_ordering(int n, int nnz, int* M_colptr, int* M_rowind, Real* M_values, int* perm, int* invperm)
     {
         SOFA_UNUSED(M_values);
@@ -252,6 +382,22 @@ protected :
         CSPARSE_symbolic(n,M_colptr,M_rowind,colptr,perm,invperm,Parent,Flag.data(),Lnz.data());
     }
 
+    void LDL_pattern(int n, int* M_colptr, int* M_rowind, int* colptr, int* rowind, int* perm, int* invperm, int* Parent)
+    {
+        CSPARSE_pattern(n,M_colptr,M_rowind,colptr,rowind,perm,invperm,Parent,Flag.data(),Lnz.data());
+    }
+
+    /// @return the task scheduler used by the supernodal factorization, or nullptr if it is sequential
+    simulation::TaskScheduler* getFactorizationTaskScheduler() const
+    {
+        if (!d_parallelFactorization.getValue())
+        {
+            return nullptr;
+        }
+        simulation::TaskScheduler* taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+        return taskScheduler && taskScheduler->getThreadCount() > 1 ? taskScheduler : nullptr;
+    }
+
     void LDL_numeric(int n,
                      int* M_colptr, int* M_rowind, Real* M_values,
                      int* colptr, int* rowind, Real* values,
@@ -276,6 +422,13 @@ protected :
         data->P_values.fastResize(data->P_nnz);
         memcpy(data->P_values.data(), M_values, data->P_nnz * sizeof(Real));
 
+        const bool supernodal = d_supernodal.getValue();
+        if (supernodal && data->supernodal.n != n)
+        {
+            // the supernodal structure has not been computed with the current symbolic decomposition
+            data->new_factorization_needed = true;
+        }
+
         // we test if the matrix has the same struct as previous factorized matrix
         if (data->new_factorization_needed  || !d_precomputeSymbolicDecomposition.getValue() )
         {
@@ -310,6 +463,21 @@ protected :
             data->L_values.clear();data->L_values.fastResize(data->L_nnz);
             data->LT_rowind.clear();data->LT_rowind.fastResize(data->L_nnz);
             data->LT_values.clear();data->LT_values.fastResize(data->L_nnz);
+
+            data->supernodal.clear();
+            data->supernodal_values.clear();
+            if (supernodal)
+            {
+                SCOPED_TIMER_VARNAME(supernodalTimer, "supernodal_symbolic");
+                LDL_pattern(data->n, M_colptr, M_rowind, data->L_colptr.data(), data->L_rowind.data(),
+                            data->perm.data(), data->invperm.data(), data->Parent.data());
+
+                simulation::TaskScheduler* taskScheduler = getFactorizationTaskScheduler();
+                supernodalLDLSymbolic(data->n, data->L_colptr.data(), data->L_rowind.data(), data->Parent.data(),
+                                      taskScheduler ? taskScheduler->getThreadCount() : 1, data->supernodal);
+                data->supernodal_values.fastResize(data->supernodal.valuePtr.back());
+                d_nbSupernodes.setValue(data->supernodal.nbSupernodes());
+            }
         }
 
         Real * D = data->invD.data();
@@ -323,8 +491,20 @@ protected :
         //Numeric Factorization
         {
             SCOPED_TIMER_VARNAME(factorizationTimer, "numeric_factorization");
-            LDL_numeric(data->n, M_colptr, M_rowind, M_values, colptr, rowind, values, D,
-                        data->perm.data(), data->invperm.data(), data->Parent.data());
+            if (supernodal)
+            {
+                if (!supernodalLDLNumeric<Real>(data->supernodal, M_colptr, M_rowind, M_values,
+                                                data->perm.data(), data->invperm.data(), colptr, values, D,
+                                                data->supernodal_values.data(), getFactorizationTaskScheduler()))
+                {
+                    msg_error("SparseLDLSolver") << "Failed to factorize, D(k,k) is zero" ;
+                }
+            }
+            else
+            {
+                LDL_numeric(data->n, M_colptr, M_rowind, M_values, colptr, rowind, values, D,
+                            data->perm.data(), data->invperm.data(), data->Parent.data());
+            }
 
             //inverse the diagonal
             for (int i = 0; i < data->n; i++)
@@ -363,6 +543,17 @@ protected :
                 tran_countvec[line]++;
             }
         }
+
+        if (d_parallelSolve.getValue() && (data->new_factorization_needed || !d_precomputeSymbolicDecomposition.getValue() || data->L_levelPtr.empty()))
+        {
+            sofa::linearalgebra::computeUnitriangularSystemLevelsCSR(data->n, data->L_colptr.data(), data->L_rowind.data(), false, data->L_levelPtr, data->L_levelRows);
+            sofa::linearalgebra::computeUnitriangularSystemLevelsCSR(data->n, data->LT_colptr.data(), data->LT_rowind.data(), true, data->LT_levelPtr, data->LT_levelRows);
+        }
+        else if (!d_parallelSolve.getValue())
+        {
+            data->L_levelPtr.clear(); data->L_levelRows.clear();
+            data->LT_levelPtr.clear(); data->LT_levelRows.clear();
+        }
     }
 
     type::vector<Real> Tmp;
@@ -0,0 +1,236 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/component/linearsolver/direct/SupernodalLDL.h>
+
+#include <numeric>
+
+namespace sofa::component::linearsolver::direct
+{
+
+void SupernodalLDLSymbolic::clear()
+{
+    n = 0;
+    superBegin.clear();
+    columnToSupernode.clear();
+    superParent.clear();
+    rowPtr.clear();
+    rows.clear();
+    valuePtr.clear();
+    descendantPtr.clear();
+    descendants.clear();
+    subtreePtr.clear();
+    subtreeSupernodes.clear();
+    levelPtr.clear();
+    levelSupernodes.clear();
+}
+
+namespace
+{
+
+/// build the CSR-like structure (ptr, values) of the groups of elements, from the group of each element
+void groupBy(const type::vector<int>& groupOf, const type::vector<int>& elements, const int nbGroups,
+             type::vector<int>& ptr, type::vector<int>& values)
+{
+    ptr.assign(nbGroups + 1, 0);
+    for (const int e : elements)
+    {
+        ++ptr[groupOf[e] + 1];
+    }
+    std::partial_sum(ptr.begin(), ptr.end(), ptr.begin());
+
+    values.resize(ptr.back());
+    type::vector<int> position(ptr.begin(), ptr.end() - 1);
+    for (const int e : elements)
+    {
+        values[position[groupOf[e]]++] = e;
+    }
+}
+
+}
+
+void supernodalLDLSymbolic(const int n, const int* L_colptr, const int* L_rowind, const int* Parent,
+                           const unsigned int nbThreads, SupernodalLDLSymbolic& symbolic)
+{
+    symbolic.clear();
+    symbolic.n = n;
+
+    if (n <= 0)
+    {
+        return;
+    }
+
+    // Fundamental supernodes: the column j is merged with the column j-1 if j is the parent of j-1
+    // and if the pattern of j-1 is the pattern of j, plus j itself
+    symbolic.superBegin.push_back(0);
+    for (int j = 1; j < n; ++j)
+    {
+        const int lnzPrevious = L_colptr[j] - L_colptr[j - 1];
+        const int lnz = L_colptr[j + 1] - L_colptr[j];
+        if (Parent[j - 1] != j || lnzPrevious != lnz + 1)
+        {
+            symbolic.superBegin.push_back(j);
+        }
+    }
+    symbolic.superBegin.push_back(n);
+
+    const int nbSupernodes = symbolic.nbSupernodes();
+
+    symbolic.columnToSupernode.resize(n);
+    symbolic.superParent.resize(nbSupernodes);
+    symbolic.rowPtr.resize(nbSupernodes + 1);
+    symbolic.valuePtr.resize(nbSupernodes + 1);
+    symbolic.rowPtr[0] = 0;
+    symbolic.valuePtr[0] = 0;
+
+    for (int s = 0; s < nbSupernodes; ++s)
+    {
+        const int first = symbolic.superBegin[s];
+        const int last = symbolic.superBegin[s + 1];
+        for (int j = first; j < last; ++j)
+        {
+            symbolic.columnToSupernode[j] = s;
+        }
+
+        // the panel rows are the first column of the supernode and its pattern
+        const int nbRows = 1 + L_colptr[first + 1] - L_colptr[first];
+        symbolic.rowPtr[s + 1] = symbolic.rowPtr[s] + nbRows;
+        symbolic.valuePtr[s + 1] = symbolic.valuePtr[s] + static_cast<std::size_t>(nbRows) * (last - first);
+    }
+
+    symbolic.rows.resize(symbolic.rowPtr[nbSupernodes]);
+    for (int s = 0; s < nbSupernodes; ++s)
+    {
+        const int first = symbolic.superBegin[s];
+        int* rows = symbolic.rows.data() + symbolic.rowPtr[s];
+        rows[0] = first;
+        std::copy(L_rowind + L_colptr[first], L_rowind + L_colptr[first + 1], rows + 1);
+
+        const int parentColumn = Parent[symbolic.superBegin[s + 1] - 1];
+        symbolic.superParent[s] = parentColumn < 0 ? -1 : symbolic.columnToSupernode[parentColumn];
+    }
+
+    // The descendants updating a supernode s are the supernodes having a row in the columns of s.
+    // The rows of a panel are sorted, so the rows belonging to the same supernode are contiguous.
+    type::vector<int> updatedSupernodes, updatingSupernodes;
+    for (int d = 0; d < nbSupernodes; ++d)
+    {
+        const int nbCols = symbolic.superBegin[d + 1] - symbolic.superBegin[d];
+        int previous = -1;
+        for (int p = symbolic.rowPtr[d] + nbCols; p < symbolic.rowPtr[d + 1]; ++p)
+        {
+            const int s = symbolic.columnToSupernode[symbolic.rows[p]];
+            if (s != previous)
+            {
+                updatedSupernodes.push_back(s);
+                updatingSupernodes.push_back(d);
+                previous = s;
+            }
+        }
+    }
+    {
+        type::vector<int> pairs(updatedSupernodes.size());
+        std::iota(pairs.begin(), pairs.end(), 0);
+        groupBy(updatedSupernodes, pairs, nbSupernodes, symbolic.descendantPtr, symbolic.descendants);
+        for (int& q : symbolic.descendants)
+        {
+            q = updatingSupernodes[q];
+        }
+    }
+
+    // Estimated cost of each subtree of the supernodal elimination tree
+    type::vector<double> subtreeCost(nbSupernodes, 0.);
+    double totalCost = 0.;
+    for (int s = 0; s < nbSupernodes; ++s)
+    {
+        const double nbCols = symbolic.superBegin[s + 1] - symbolic.superBegin[s];
+        const double nbRows = symbolic.rowPtr[s + 1] - symbolic.rowPtr[s];
+        subtreeCost[s] += nbCols * nbRows * nbRows;
+        if (symbolic.superParent[s] >= 0)
+        {
+            subtreeCost[symbolic.superParent[s]] += subtreeCost[s];
+        }
+        else
+        {
+            totalCost += subtreeCost[s];
+        }
+    }
+
+    // The tree is split in subtrees whose cost is below a threshold, leaving a few supernodes at the
+    // top of the tree. With a single thread, the whole tree is made of subtrees.
+    const double threshold = nbThreads < 2 ? totalCost : totalCost / (4. * nbThreads);
+
+    type::vector<int> subtreeOf(nbSupernodes, -1);
+    type::vector<int> subtreeRoots;
+    for (int s = nbSupernodes - 1; s >= 0; --s)
+    {
+        const int parent = symbolic.superParent[s];
+        if (parent >= 0 && subtreeOf[parent] >= 0)
+        {
+            subtreeOf[s] = subtreeOf[parent];
+        }
+        else if (subtreeCost[s] <= threshold)
+        {
+            subtreeOf[s] = static_cast<int>(subtreeRoots.size());
+            subtreeRoots.push_back(s);
+        }
+    }
+
+    // the most expensive subtrees are started first
+    type::vector<int> subtreeOrder(subtreeRoots.size());
+    std::iota(subtreeOrder.begin(), subtreeOrder.end(), 0);
+    std::stable_sort(subtreeOrder.begin(), subtreeOrder.end(), [&](const int a, const int b)
+    {
+        return subtreeCost[subtreeRoots[a]] > subtreeCost[subtreeRoots[b]];
+    });
+    type::vector<int> subtreeRank(subtreeRoots.size());
+    for (std::size_t i = 0; i < subtreeOrder.size(); ++i)
+    {
+        subtreeRank[subtreeOrder[i]] = static_cast<int>(i);
+    }
+
+    // Supernodes are listed in increasing order, so children are factorized before their parent
+    type::vector<int> inSubtree, subtreeGroup(nbSupernodes, 0), topSupernodes, level(nbSupernodes, 0);
+    int nbLevels = 0;
+    for (int s = 0; s < nbSupernodes; ++s)
+    {
+        if (subtreeOf[s] >= 0)
+        {
+            inSubtree.push_back(s);
+            subtreeGroup[s] = subtreeRank[subtreeOf[s]];
+        }
+        else
+        {
+            topSupernodes.push_back(s);
+            nbLevels = std::max(nbLevels, level[s] + 1);
+            const int parent = symbolic.superParent[s];
+            if (parent >= 0)
+            {
+                level[parent] = std::max(level[parent], level[s] + 1);
+            }
+        }
+    }
+
+    groupBy(subtreeGroup, inSubtree, static_cast<int>(subtreeRoots.size()), symbolic.subtreePtr, symbolic.subtreeSupernodes);
+    groupBy(level, topSupernodes, nbLevels, symbolic.levelPtr, symbolic.levelSupernodes);
+}
+
+} // namespace sofa::component::linearsolver::direct
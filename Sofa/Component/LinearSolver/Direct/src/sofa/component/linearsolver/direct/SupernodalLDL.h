@@ -0,0 +1,320 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/linearsolver/direct/config.h>
+
+#include <sofa/simulation/CpuTaskStatus.h>
+#include <sofa/simulation/ParallelForEach.h>
+#include <sofa/simulation/TaskScheduler.h>
+#include <sofa/type/vector.h>
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+
+namespace sofa::component::linearsolver::direct
+{
+
+/**
+ * Symbolic structure of a supernodal LDL^T factorization.
+ *
+ * A supernode is a set of contiguous columns of L sharing the same sparsity pattern below their
+ * diagonal block. The columns of a supernode are stored in a dense column-major panel, whose rows
+ * are the diagonal block followed by the common pattern.
+ *
+ * Supernodes are numbered in the column order, so the parent of a supernode in the supernodal
+ * elimination tree always has a larger index than the supernode itself.
+ */
+struct SOFA_COMPONENT_LINEARSOLVER_DIRECT_API SupernodalLDLSymbolic
+{
+    int n { 0 };
+
+    /// the columns [superBegin[s], superBegin[s+1]) of L belong to the supernode s
+    type::vector<int> superBegin;
+
+    /// supernode of each column of L
+    type::vector<int> columnToSupernode;
+
+    /// parent of each supernode in the supernodal elimination tree (-1 for a root)
+    type::vector<int> superParent;
+
+    /// sorted row indices of the panel of the supernode s: rows[rowPtr[s]] to rows[rowPtr[s+1]-1]
+    type::vector<int> rowPtr, rows;
+
+    /// offset of the panel of each supernode in the array of the panels values
+    type::vector<std::size_t> valuePtr;
+
+    /// supernodes updating the supernode s, in increasing order: descendants[descendantPtr[s]] to descendants[descendantPtr[s+1]-1]
+    type::vector<int> descendantPtr, descendants;
+
+    /// Independent subtrees of the supernodal elimination tree. Each subtree is factorized
+    /// sequentially by a single task, in the order of subtreeSupernodes.
+    type::vector<int> subtreePtr, subtreeSupernodes;
+
+    /// Supernodes which do not belong to an independent subtree, sorted by level. The supernodes
+    /// of a level only depend on the subtrees and on the previous levels.
+    type::vector<int> levelPtr, levelSupernodes;
+
+    int nbSupernodes() const { return static_cast<int>(superBegin.size()) - 1; }
+
+    void clear();
+};
+
+/**
+ * Detect the supernodes from the elimination tree and the pattern of L (CSC, strictly lower part,
+ * sorted row indices), and compute the schedule of the numeric factorization.
+ *
+ * @param nbThreads the number of threads expected to run the numeric factorization. It is used to
+ * split the elimination tree in independent subtrees of similar cost.
+ */
+SOFA_COMPONENT_LINEARSOLVER_DIRECT_API
+void supernodalLDLSymbolic(int n, const int* L_colptr, const int* L_rowind, const int* Parent,
+                           unsigned int nbThreads, SupernodalLDLSymbolic& symbolic);
+
+namespace supernodal
+{
+
+template<class Real>
+using DenseMatrix = Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
+
+/// Temporary buffers used to factorize a supernode
+template<class Real>
+struct Workspace
+{
+    DenseMatrix<Real> LD;
+    DenseMatrix<Real> update;
+    type::vector<int> relativeRows;
+};
+
+/**
+ * Left-looking factorization of a single supernode: the panel is assembled from the permuted
+ * matrix, updated by all its descendants, factorized, and finally copied into the CSC storage of L.
+ * @return false if a zero pivot has been found
+ */
+template<class Real>
+bool factorizeSupernode(const int s, const SupernodalLDLSymbolic& symbolic,
+                        const int* M_colptr, const int* M_rowind, const Real* M_values,
+                        const int* perm, const int* invperm,
+                        const int* colptr, Real* values, Real* D, Real* panels,
+                        Workspace<Real>& workspace)
+{
+    using Panel = Eigen::Map<DenseMatrix<Real> >;
+    using ConstPanel = Eigen::Map<const DenseMatrix<Real> >;
+    using ConstVector = Eigen::Map<const Eigen::Matrix<Real, Eigen::Dynamic, 1> >;
+
+    const int first = symbolic.superBegin[s];
+    const int last = symbolic.superBegin[s + 1];
+    const int nbCols = last - first;
+    const int* rows = symbolic.rows.data() + symbolic.rowPtr[s];
+    const int nbRows = symbolic.rowPtr[s + 1] - symbolic.rowPtr[s];
+
+    Panel panel(panels + symbolic.valuePtr[s], nbRows, nbCols);
+
+    // assemble the lower part of the permuted matrix
+    panel.setZero();
+    for (int c = 0; c < nbCols; ++c)
+    {
+        const int k = first + c;
+        const int kk = perm[k];
+        for (int p = M_colptr[kk]; p < M_colptr[kk + 1]; ++p)
+        {
+            const int i = invperm[M_rowind[p]];
+            if (i >= k)
+            {
+                const int r = static_cast<int>(std::lower_bound(rows + c, rows + nbRows, i) - rows);
+                panel(r, c) += M_values[p];
+            }
+        }
+    }
+
+    // updates from the descendants: panel -= L_d * D_d * L_d^T, restricted to the rows and columns of s
+    for (int q = symbolic.descendantPtr[s]; q < symbolic.descendantPtr[s + 1]; ++q)
+    {
+        const int d = symbolic.descendants[q];
+        const int dFirst = symbolic.superBegin[d];
+        const int dNbCols = symbolic.superBegin[d + 1] - dFirst;
+        const int* dRows = symbolic.rows.data() + symbolic.rowPtr[d];
+        const int dNbRows = symbolic.rowPtr[d + 1] - symbolic.rowPtr[d];
+
+        // rows of d in [p1, p2) belong to the columns of s, rows in [p1, dNbRows) belong to the panel of s
+        const int p1 = static_cast<int>(std::lower_bound(dRows + dNbCols, dRows + dNbRows, first) - dRows);
+        const int p2 = static_cast<int>(std::lower_bound(dRows + p1, dRows + dNbRows, last) - dRows);
+
+        const ConstPanel dPanel(panels + symbolic.valuePtr[d], dNbRows, dNbCols);
+        const ConstVector dD(D + dFirst, dNbCols);
+
+        workspace.LD.noalias() = dPanel.middleRows(p1, p2 - p1) * dD.asDiagonal();
+        workspace.update.noalias() = dPanel.bottomRows(dNbRows - p1) * workspace.LD.transpose();
+
+        workspace.relativeRows.resize(dNbRows - p1);
+        const int* r = rows;
+        for (int i = p1; i < dNbRows; ++i)
+        {
+            r = std::lower_bound(r, rows + nbRows, dRows[i]);
+            workspace.relativeRows[i - p1] = static_cast<int>(r - rows);
+        }
+
+        for (int j = 0; j < p2 - p1; ++j)
+        {
+            const int c = dRows[p1 + j] - first;
+            for (int i = j; i < dNbRows - p1; ++i)
+            {
+                panel(workspace.relativeRows[i], c) -= workspace.update(i, j);
+            }
+        }
+    }
+
+    // dense LDL^T of the diagonal block
+    for (int k = 0; k < nbCols; ++k)
+    {
+        for (int j = 0; j < k; ++j)
+        {
+            const Real l_kj_d = panel(k, j) * D[first + j];
+            panel.col(k).segment(k, nbCols - k) -= l_kj_d * panel.col(j).segment(k, nbCols - k);
+        }
+
+        const Real d = panel(k, k);
+        if (d == 0)
+        {
+            return false;
+        }
+        D[first + k] = d;
+        panel.col(k).segment(k + 1, nbCols - k - 1) /= d;
+    }
+
+    // off-diagonal block: L_21 = A_21 * L_11^-T * D^-1
+    if (nbRows > nbCols)
+    {
+        auto offDiagonal = panel.bottomRows(nbRows - nbCols);
+        panel.topRows(nbCols).transpose().template triangularView<Eigen::UnitUpper>()
+            .template solveInPlace<Eigen::OnTheRight>(offDiagonal);
+        offDiagonal *= ConstVector(D + first, nbCols).cwiseInverse().asDiagonal();
+    }
+
+    // copy into the CSC storage of L. The pattern of column first+c is rows[c+1] to rows[nbRows-1]
+    for (int c = 0; c < nbCols; ++c)
+    {
+        const int k = first + c;
+        const int nbValues = nbRows - c - 1;
+        assert(colptr[k + 1] - colptr[k] == nbValues);
+        if (nbValues > 0)
+        {
+            std::copy_n(panel.col(c).data() + c + 1, nbValues, values + colptr[k]);
+        }
+    }
+
+    return true;
+}
+
+} // namespace supernodal
+
+/**
+ * Supernodal numeric LDL^T factorization of the permuted matrix, based on a symbolic structure
+ * computed by supernodalLDLSymbolic.
+ *
+ * The factor is written in the CSC storage of L (colptr, values), whose pattern must have been
+ * computed beforehand, and in D. panels must contain at least symbolic.valuePtr.back() values.
+ *
+ * If a task scheduler is provided, the independent subtrees, then each level of the remaining
+ * supernodes, are factorized in parallel. The result does not depend on the number of threads.
+ *
+ * @return false if a zero pivot has been found
+ */
+template<class Real>
+bool supernodalLDLNumeric(const SupernodalLDLSymbolic& symbolic,
+                          const int* M_colptr, const int* M_rowind, const Real* M_values,
+                          const int* perm, const int* invperm,
+                          const int* colptr, Real* values, Real* D, Real* panels,
+                          simulation::TaskScheduler* taskScheduler)
+{
+    std::atomic<bool> success { true };
+
+    const auto factorizeRange = [&](const int* begin, const int* end)
+    {
+        supernodal::Workspace<Real> workspace;
+        for (const int* s = begin; s != end && success.load(std::memory_order_relaxed); ++s)
+        {
+            if (!supernodal::factorizeSupernode(*s, symbolic, M_colptr, M_rowind, M_values,
+                                                perm, invperm, colptr, values, D, panels, workspace))
+            {
+                success.store(false, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    const int nbSubtrees = static_cast<int>(symbolic.subtreePtr.size()) - 1;
+    const int nbLevels = static_cast<int>(symbolic.levelPtr.size()) - 1;
+
+    if (taskScheduler == nullptr || taskScheduler->getThreadCount() < 2)
+    {
+        for (int t = 0; t < nbSubtrees; ++t)
+        {
+            factorizeRange(symbolic.subtreeSupernodes.data() + symbolic.subtreePtr[t],
+                           symbolic.subtreeSupernodes.data() + symbolic.subtreePtr[t + 1]);
+        }
+        for (int l = 0; l < nbLevels; ++l)
+        {
+            factorizeRange(symbolic.levelSupernodes.data() + symbolic.levelPtr[l],
+                           symbolic.levelSupernodes.data() + symbolic.levelPtr[l + 1]);
+        }
+        return success;
+    }
+
+    // one task per subtree: the subtrees are sorted by decreasing cost
+    {
+        simulation::CpuTaskStatus status;
+        for (int t = 0; t < nbSubtrees; ++t)
+        {
+            taskScheduler->addTask(status, [t, &symbolic, &factorizeRange]()
+            {
+                factorizeRange(symbolic.subtreeSupernodes.data() + symbolic.subtreePtr[t],
+                               symbolic.subtreeSupernodes.data() + symbolic.subtreePtr[t + 1]);
+            });
+        }
+        taskScheduler->workUntilDone(&status);
+    }
+
+    for (int l = 0; l < nbLevels && success; ++l)
+    {
+        const int* begin = symbolic.levelSupernodes.data() + symbolic.levelPtr[l];
+        const int* end = symbolic.levelSupernodes.data() + symbolic.levelPtr[l + 1];
+        if (end - begin == 1)
+        {
+            factorizeRange(begin, end);
+        }
+        else
+        {
+            simulation::parallelForEachRange(*taskScheduler, begin, end,
+                [&factorizeRange](const auto& range)
+                {
+                    factorizeRange(range.start, range.end);
+                });
+        }
+    }
+
+    return success;
+}
+
+} // namespace sofa::component::linearsolver::direct
@@ -22,7 +22,9 @@
 #include <sofa/testing/BaseTest.h>
 #include <sofa/component/linearsolver/direct/SparseLDLSolver.h>
 #include <sofa/component/linearsolver/direct/SparseCommon.h>
+#include <sofa/component/linearsolver/direct/SupernodalLDL.h>
 #include <sofa/component/linearsystem/MatrixLinearSystem.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
 #include <sofa/simulation/Node.h>
 #include <sofa/simulation/graph/DAGSimulation.h>
 #include <sofa/simpleapi/SimpleApi.h>
@@ -138,3 +140,211 @@ TEST(SparseLDLSolver, AssociatedLinearSystem)
 
     EXPECT_EQ(MatrixSystem::GetCustomTemplateName(), MatrixType::Name());
 }
+
+TEST(SparseLDLSolver, SupernodalSymbolicDenseMatrix)
+{
+    // pattern of the strictly lower part of L for a dense 4x4 matrix
+    const int n = 4;
+    const std::vector<int> L_colptr { 0, 3, 5, 6, 6 };
+    const std::vector<int> L_rowind { 1, 2, 3, 2, 3, 3 };
+    const std::vector<int> parent { 1, 2, 3, -1 };
+
+    sofa::component::linearsolver::direct::SupernodalLDLSymbolic symbolic;
+    sofa::component::linearsolver::direct::supernodalLDLSymbolic(n, L_colptr.data(), L_rowind.data(), parent.data(), 1, symbolic);
+
+    ASSERT_EQ(symbolic.nbSupernodes(), 1);
+    EXPECT_EQ(symbolic.superBegin, sofa::type::vector<int>({0, 4}));
+    EXPECT_EQ(symbolic.rows, sofa::type::vector<int>({0, 1, 2, 3}));
+    EXPECT_EQ(symbolic.valuePtr.back(), 16);
+    EXPECT_TRUE(symbolic.descendants.empty());
+}
+
+TEST(SparseLDLSolver, SupernodalSymbolicTridiagonalMatrix)
+{
+    // pattern of the strictly lower part of L for a tridiagonal 4x4 matrix
+    const int n = 4;
+    const std::vector<int> L_colptr { 0, 1, 2, 3, 3 };
+    const std::vector<int> L_rowind { 1, 2, 3 };
+    const std::vector<int> parent { 1, 2, 3, -1 };
+
+    sofa::component::linearsolver::direct::SupernodalLDLSymbolic symbolic;
+    sofa::component::linearsolver::direct::supernodalLDLSymbolic(n, L_colptr.data(), L_rowind.data(), parent.data(), 4, symbolic);
+
+    // only the two last columns share the same pattern
+    ASSERT_EQ(symbolic.nbSupernodes(), 3);
+    EXPECT_EQ(symbolic.superBegin, sofa::type::vector<int>({0, 1, 2, 4}));
+    EXPECT_EQ(symbolic.superParent, sofa::type::vector<int>({1, 2, -1}));
+    EXPECT_EQ(symbolic.descendantPtr, sofa::type::vector<int>({0, 0, 1, 2}));
+    EXPECT_EQ(symbolic.descendants, sofa::type::vector<int>({0, 1}));
+
+    // every supernode is scheduled exactly once
+    sofa::type::vector<int> scheduled(symbolic.subtreeSupernodes.begin(), symbolic.subtreeSupernodes.end());
+    scheduled.insert(scheduled.end(), symbolic.levelSupernodes.begin(), symbolic.levelSupernodes.end());
+    std::sort(scheduled.begin(), scheduled.end());
+    EXPECT_EQ(scheduled, sofa::type::vector<int>({0, 1, 2}));
+}
+
+namespace
+{
+/// symmetric positive definite matrix made of 3x3 blocks, coupling the nodes of a 3D grid
+sofa::linearalgebra::CompressedRowSparseMatrix<SReal> makeGridMatrix(int nx, int ny, int nz)
+{
+    const auto nodeId = [nx, ny](int x, int y, int z) { return (z * ny + y) * nx + x; };
+    const int nbNodes = nx * ny * nz;
+
+    sofa::linearalgebra::CompressedRowSparseMatrix<SReal> matrix;
+    matrix.resize(3 * nbNodes, 3 * nbNodes);
+
+    const auto addCoupling = [&matrix](int a, int b)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                const SReal value = -0.1_sreal * (1 + i + 2 * j) / (1 + a % 7);
+                matrix.add(3 * a + i, 3 * b + j, value);
+                matrix.add(3 * b + j, 3 * a + i, value);
+            }
+        }
+    };
+
+    for (int z = 0; z < nz; ++z)
+    {
+        for (int y = 0; y < ny; ++y)
+        {
+            for (int x = 0; x < nx; ++x)
+            {
+                const int a = nodeId(x, y, z);
+                if (x + 1 < nx) addCoupling(a, nodeId(x + 1, y, z));
+                if (y + 1 < ny) addCoupling(a, nodeId(x, y + 1, z));
+                if (z + 1 < nz) addCoupling(a, nodeId(x, y, z + 1));
+            }
+        }
+    }
+
+    // diagonal dominance
+    for (int i = 0; i < 3 * nbNodes; ++i)
+    {
+        matrix.add(i, i, 10_sreal + i % 5);
+    }
+
+    matrix.compress();
+    return matrix;
+}
+
+/// symmetric positive definite block diagonal matrix made of independent 3x3 blocks
+sofa::linearalgebra::CompressedRowSparseMatrix<SReal> makeBlockDiagonalMatrix(int nbBlocks)
+{
+    sofa::linearalgebra::CompressedRowSparseMatrix<SReal> matrix;
+    matrix.resize(3 * nbBlocks, 3 * nbBlocks);
+    for (int b = 0; b < nbBlocks; ++b)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                matrix.add(3 * b + i, 3 * b + j, i == j ? 5_sreal + b % 3 : 1_sreal / (1 + i + j));
+            }
+        }
+    }
+    matrix.compress();
+    return matrix;
+}
+
+sofa::linearalgebra::FullVector<SReal> solveGridSystem(
+    sofa::linearalgebra::CompressedRowSparseMatrix<SReal>& matrix, bool supernodal, bool parallel, bool parallelSolve = false)
+{
+    using MatrixType = sofa::linearalgebra::CompressedRowSparseMatrix<SReal>;
+    using Solver = sofa::component::linearsolver::direct::SparseLDLSolver<MatrixType, sofa::linearalgebra::FullVector<SReal> >;
+    const Solver::SPtr solver = sofa::core::objectmodel::New<Solver>();
+    solver->findData("supernodal")->read(supernodal ? "true" : "false");
+    solver->findData("parallelFactorization")->read(parallel ? "true" : "false");
+    solver->findData("parallelSolve")->read(parallelSolve ? "true" : "false");
+    solver->init();
+
+    sofa::linearalgebra::FullVector<SReal> rhs(matrix.rowSize());
+    for (int i = 0; i < rhs.size(); ++i)
+    {
+        rhs[i] = std::sin(static_cast<SReal>(i));
+    }
+    sofa::linearalgebra::FullVector<SReal> solution(matrix.rowSize());
+
+    solver->invert(matrix);
+    solver->solve(matrix, solution, rhs);
+
+    // the factorization reusing the symbolic decomposition must give the same result
+    sofa::linearalgebra::FullVector<SReal> secondSolution(matrix.rowSize());
+    solver->invert(matrix);
+    solver->solve(matrix, secondSolution, rhs);
+    for (int i = 0; i < rhs.size(); ++i)
+    {
+        EXPECT_EQ(solution[i], secondSolution[i]);
+    }
+
+    if (supernodal)
+    {
+        EXPECT_GT(std::stoi(solver->findData("nbSupernodes")->getValueString()), 0);
+    }
+
+    return solution;
+}
+}
+
+TEST(SparseLDLSolver, SupernodalFactorization)
+{
+    auto matrix = makeGridMatrix(6, 5, 4);
+
+    const auto reference = solveGridSystem(matrix, false, false);
+    const auto supernodal = solveGridSystem(matrix, true, false);
+
+    ASSERT_EQ(reference.size(), supernodal.size());
+    for (int i = 0; i < reference.size(); ++i)
+    {
+        EXPECT_NEAR(reference[i], supernodal[i], 1e-10);
+    }
+
+    // residual
+    sofa::linearalgebra::FullVector<SReal> product(matrix.rowSize());
+    matrix.mul(product, supernodal);
+    for (int i = 0; i < product.size(); ++i)
+    {
+        EXPECT_NEAR(product[i], std::sin(static_cast<SReal>(i)), 1e-10);
+    }
+}
+
+TEST(SparseLDLSolver, ParallelSupernodalFactorizationIsDeterministic)
+{
+    auto matrix = makeGridMatrix(8, 7, 6);
+
+    auto* taskScheduler = sofa::simulation::MainTaskSchedulerFactory::createInRegistry();
+    ASSERT_NE(taskScheduler, nullptr);
+    taskScheduler->init(4);
+
+    const auto sequential = solveGridSystem(matrix, true, false);
+    const auto parallel = solveGridSystem(matrix, true, true);
+
+    ASSERT_EQ(sequential.size(), parallel.size());
+    for (int i = 0; i < sequential.size(); ++i)
+    {
+        EXPECT_EQ(sequential[i], parallel[i]);
+    }
+}
+
+TEST(SparseLDLSolver, ParallelSolveIsDeterministic)
+{
+    auto* taskScheduler = sofa::simulation::MainTaskSchedulerFactory::createInRegistry();
+    ASSERT_NE(taskScheduler, nullptr);
+    taskScheduler->init(4);
+
+    for (auto matrix : { makeGridMatrix(8, 7, 6), makeBlockDiagonalMatrix(2000) })
+    {
+        const auto sequential = solveGridSystem(matrix, false, false, false);
+        const auto parallel = solveGridSystem(matrix, false, false, true);
+
+        ASSERT_EQ(sequential.size(), parallel.size());
+        for (int i = 0; i < sequential.size(); ++i)
+        {
+            EXPECT_EQ(sequential[i], parallel[i]);
+        }
+    }
+}
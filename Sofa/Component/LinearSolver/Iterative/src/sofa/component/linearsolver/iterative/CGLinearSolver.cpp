@@ -27,8 +27,7 @@
 #include <sofa/linearalgebra/CompressedRowSparseMatrix.h>
 #include <sofa/core/ObjectFactory.h>
 
-#include <sofa/simulation/mechanicalvisitor/MechanicalVMultiOpVisitor.h>
-using sofa::simulation::mechanicalvisitor::MechanicalVMultiOpVisitor;
+#include <sofa/simulation/FusedVectorOperations.h>
 
 namespace sofa::component::linearsolver::iterative
 {
@@ -44,22 +43,20 @@ inline void CGLinearSolver<component::linearsolver::GraphScatteredMatrix,compone
 }
 
 template<> SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API
-inline void CGLinearSolver<component::linearsolver::GraphScatteredMatrix,component::linearsolver::GraphScatteredVector>::cgstep_alpha(const core::ExecParams* params, Vector& x, Vector& r, Vector& p, Vector& q, Real alpha)
+inline SReal CGLinearSolver<component::linearsolver::GraphScatteredMatrix,component::linearsolver::GraphScatteredVector>::cgstep_alpha(const core::ExecParams* params, Vector& x, Vector& r, Vector& p, Vector& q, Real alpha)
 {
 #ifdef SOFA_NO_VMULTIOP // unoptimized version
+    SOFA_UNUSED(params);
     x.peq(p,alpha);                 // x = x + alpha p
     r.peq(q,-alpha);                // r = r - alpha q
-#else // single-operation optimization
-    typedef sofa::core::behavior::BaseMechanicalState::VMultiOp VMultiOp;
-    VMultiOp ops;
-    ops.resize(2);
-    ops[0].first = (MultiVecDerivId)x;
-    ops[0].second.push_back(std::make_pair((MultiVecDerivId)x,1.0));
-    ops[0].second.push_back(std::make_pair((MultiVecDerivId)p,alpha));
-    ops[1].first = (MultiVecDerivId)r;
-    ops[1].second.push_back(std::make_pair((MultiVecDerivId)r,1.0));
-    ops[1].second.push_back(std::make_pair((MultiVecDerivId)q,-alpha));
-    this->executeVisitor(MechanicalVMultiOpVisitor(params, ops));
+    return r.dot(r);
+#else // single-operation optimization: the vectors are updated and the new residual norm is computed in one pass
+    sofa::simulation::common::FusedVectorOperations ops(params, this->getContext());
+    ops.v_peq((MultiVecDerivId)x, (MultiVecDerivId)p, alpha);
+    ops.v_peq((MultiVecDerivId)r, (MultiVecDerivId)q, -alpha);
+    const auto rhoId = ops.v_dot((MultiVecDerivId)r, (MultiVecDerivId)r);
+    ops.execute();
+    return ops.getResult(rhoId);
 #endif
 }
 using namespace sofa::linearalgebra;
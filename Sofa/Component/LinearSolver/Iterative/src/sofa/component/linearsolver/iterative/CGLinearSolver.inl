@@ -108,7 +108,7 @@ void CGLinearSolver<TMatrix,TVector>::solve(Matrix& A, Vector& x, Vector& b)
     Vector& q = *vtmp.createTempVector(); // temporary vector computing A*p
     Vector& r = *vtmp.createTempVector(); // residual
 
-    Real rho, rho_1=0, alpha, beta;
+    Real rho, rho_1=0, rho_next=0, alpha, beta;
 
     msg_info() << "b = " << b ;
 
@@ -148,6 +148,9 @@ void CGLinearSolver<TMatrix,TVector>::solve(Matrix& A, Vector& x, Vector& b)
     // Check if forces in the Left Hand Side (LHS) vector are non-zero
     if(normb != 0.0)
     {
+        /// Compute ρ = r². In the next iterations, it is computed while updating r.
+        rho = r.dot(r);
+
         for( nb_iter = 1; nb_iter <= d_maxIter.getValue(); nb_iter++ )
         {
 #ifdef SOFA_DUMP_VISITOR_INFO
@@ -159,9 +162,6 @@ void CGLinearSolver<TMatrix,TVector>::solve(Matrix& A, Vector& x, Vector& b)
             }
 #endif
 
-            /// Compute ρ = r²
-            rho = r.dot(r);
-
             /// Compute the error from the norm of ρ and b
             const auto normr = sqrt(rho);
             const auto err = normr/normb;
@@ -274,7 +274,8 @@ void CGLinearSolver<TMatrix,TVector>::solve(Matrix& A, Vector& x, Vector& b)
                 /// End of the CG step by updating x and r
                 /// x = x + alpha p
                 /// r = r - alpha p
-                cgstep_alpha(params, x,r,p,q,alpha);
+                /// ρ_next = r²
+                rho_next = cgstep_alpha(params, x,r,p,q,alpha);
 
                 msg_info() << "den = " << den << ", alpha = " << alpha << ", x = " << x << ", r = " << r;
             }
@@ -285,6 +286,7 @@ void CGLinearSolver<TMatrix,TVector>::solve(Matrix& A, Vector& x, Vector& b)
             }
 
             rho_1 = rho;
+            rho = rho_next;
 
 #ifdef SOFA_DUMP_VISITOR_INFO
             if (simulation::Visitor::isPrintActivated())
@@ -344,13 +346,15 @@ inline void CGLinearSolver<TMatrix,TVector>::cgstep_beta(const core::ExecParams*
 }
 
 template<class TMatrix, class TVector>
-inline void CGLinearSolver<TMatrix,TVector>::cgstep_alpha(const core::ExecParams* /*params*/, Vector& x, Vector& r, Vector& p, Vector& q, Real alpha)
+inline auto CGLinearSolver<TMatrix,TVector>::cgstep_alpha(const core::ExecParams* /*params*/, Vector& x, Vector& r, Vector& p, Vector& q, Real alpha) -> Real
 {
     // x = x + alpha p
     x.peq(p,alpha);
 
     // r = r - alpha q
     r.peq(q,-alpha);
+
+    return r.dot(r);
 }
 
 } // namespace sofa::component::linearsolver::iterative
@@ -26,6 +26,7 @@
 #include <sofa/simulation/MechanicalOperations.h>
 #include <sofa/simulation/VectorOperations.h>
 #include <sofa/core/behavior/LinearSolver.h>
+#include <sofa/core/behavior/MultiVecPool.h>
 #include <sofa/component/linearsolver/iterative/GraphScatteredTypes.h>
 #include <sofa/linearalgebra/FullVector.h>
 #include <sofa/linearalgebra/FullMatrix.h>
@@ -197,6 +198,9 @@ public:
 
     void init() override;
 
+    /// Free the temporary vectors allocated in the mechanical states
+    void cleanup() override;
+
     /// Reset the current linear system.
     void resetSystem() override;
 
@@ -356,6 +360,9 @@ protected:
     MatrixLinearSolverInternalData<Vector> internalData;
     std::unique_ptr<MatrixInvertData> invertData;
 
+    /// Temporary vectors of the solvers working on graph-scattered vectors, kept allocated from one solve to the next
+    core::behavior::MultiVecDerivPool m_temporaryVectors;
+
     virtual MatrixInvertData * createInvertData();
 
     struct LinearSystemData
@@ -417,8 +424,18 @@ public:
         b.setOps( &vops );
         M.parent = &mops;
     }
-    GraphScatteredVector* createTempVector() { return new GraphScatteredVector(&vops); }
-    void deleteTempVector(GraphScatteredVector* v) { delete v; }
+    /// The vector is borrowed from the pool of the solver: its values are those left by its previous use
+    GraphScatteredVector* createTempVector()
+    {
+        auto* v = new GraphScatteredVector(&vops, core::VecDerivId::null());
+        v->set(parent->m_temporaryVectors.acquireId(&vops));
+        return v;
+    }
+    void deleteTempVector(GraphScatteredVector* v)
+    {
+        parent->m_temporaryVectors.release(v->id());
+        delete v;
+    }
 };
 
 template<> SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API
@@ -468,6 +485,7 @@ extern template class SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API MatrixLinearSolv
 /// hand to prevent MSVC from complaining that it doesn't find their definition.
 extern template SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API MatrixLinearSolver<GraphScatteredMatrix,GraphScatteredVector,NoThreadManager>::MatrixLinearSolver();
 extern template SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API MatrixLinearSolver<GraphScatteredMatrix,GraphScatteredVector,NoThreadManager>::~MatrixLinearSolver();
+extern template SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API void MatrixLinearSolver<GraphScatteredMatrix,GraphScatteredVector,NoThreadManager>::cleanup();
 extern template SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API void MatrixLinearSolver<GraphScatteredMatrix,GraphScatteredVector,NoThreadManager>::invertSystem();
 extern template SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API bool MatrixLinearSolver<GraphScatteredMatrix,GraphScatteredVector,NoThreadManager>::addJMInvJt(linearalgebra::BaseMatrix*, linearalgebra::BaseMatrix*, SReal);
 extern template SOFA_COMPONENT_LINEARSOLVER_ITERATIVE_API bool MatrixLinearSolver<GraphScatteredMatrix,GraphScatteredVector,NoThreadManager>::addMInvJt(linearalgebra::BaseMatrix*, linearalgebra::BaseMatrix*, SReal);
@@ -91,6 +91,16 @@ void MatrixLinearSolver<Matrix,Vector>::init()
     this->d_componentState.setValue(core::objectmodel::ComponentState::Valid);
 }
 
+template<class Matrix, class Vector>
+void MatrixLinearSolver<Matrix,Vector>::cleanup()
+{
+    // free the temporary vectors (including eventual external mechanical states linked by an InteractionForceField)
+    simulation::common::VectorOperations vop(core::execparams::defaultInstance(), this->getContext());
+    m_temporaryVectors.clear(&vop);
+
+    Inherit1::cleanup();
+}
+
 template <class Matrix, class Vector>
 void MatrixLinearSolver<Matrix, Vector, NoThreadManager>::checkLinearSystem()
 {
@@ -99,6 +99,9 @@ void MinResLinearSolver<TMatrix,TVector>::solve(Matrix& A, Vector& x, Vector& b)
     Vector* w2 =  vtmp.createTempVector();
     Vector& v  = *vtmp.createTempVector();
 
+    // the temporary vectors may be reused from a previous solve: w and w2 are the only ones read before being written
+    w->clear();
+    w2->clear();
 
     *r1 = A * x;
     r1->eq( b, *r1, -1.0 );   //  r1 = b - r1;
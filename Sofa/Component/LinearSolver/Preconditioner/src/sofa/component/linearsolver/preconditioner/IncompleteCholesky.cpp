@@ -0,0 +1,286 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/component/linearsolver/preconditioner/IncompleteCholesky.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace sofa::component::linearsolver::preconditioner
+{
+
+namespace
+{
+/// Number of diagonal shifts tried before the factorization is considered as failed
+constexpr unsigned int maxNbShifts = 10;
+
+/// First relative diagonal shift, doubled after each failed factorization
+constexpr SReal initialShift = 1e-3;
+}
+
+void IncompleteCholesky::analyze(const int n, const int* rowBegin, const int* colIndex,
+                                 const int* perm, const int* invperm, const unsigned int fillLevel)
+{
+    m_n = n;
+    m_perm.assign(perm, perm + n);
+    m_invperm.assign(invperm, invperm + n);
+
+    // pattern of the permuted matrix, made symmetric. The position of the value in A is kept for
+    // the entries of the upper triangle.
+    type::vector<type::vector<std::pair<int, int> > > permutedRows(n);
+    for (int r = 0; r < n; ++r)
+    {
+        const int i = invperm[r];
+        for (int p = rowBegin[r]; p < rowBegin[r + 1]; ++p)
+        {
+            const int j = invperm[colIndex[p]];
+            if (j >= i)
+            {
+                permutedRows[i].emplace_back(j, p);
+            }
+            if (j != i)
+            {
+                permutedRows[j].emplace_back(i, -1);
+            }
+        }
+    }
+
+    // Symbolic factorization: the level of an entry of the matrix is 0, and the level of a fill-in
+    // created by the elimination of k is lev(i,k) + lev(k,j) + 1. Only the entries of level at most
+    // fillLevel are kept.
+    m_rowBegin.assign(n + 1, 0);
+    m_colIndex.clear();
+    m_matrixPosition.clear();
+    type::vector<unsigned int> levels; // levels of the entries of U, in the same layout
+
+    type::vector<unsigned int> rowLevel(n);
+    type::vector<int> rowMarker(n, -1);
+    type::vector<int> rowMatrixPosition(n, -1);
+    type::vector<int> upper;
+    std::priority_queue<int, std::vector<int>, std::greater<> > lower;
+
+    for (int i = 0; i < n; ++i)
+    {
+        upper.clear();
+        const auto addEntry = [&](const int j, const unsigned int level, const int matrixPosition)
+        {
+            if (rowMarker[j] == i)
+            {
+                rowLevel[j] = std::min(rowLevel[j], level);
+                if (matrixPosition != -1)
+                {
+                    rowMatrixPosition[j] = matrixPosition;
+                }
+                return;
+            }
+            rowMarker[j] = i;
+            rowLevel[j] = level;
+            rowMatrixPosition[j] = matrixPosition;
+            if (j < i)
+            {
+                lower.push(j);
+            }
+            else
+            {
+                upper.push_back(j);
+            }
+        };
+
+        addEntry(i, 0, -1);
+        for (const auto& [j, matrixPosition] : permutedRows[i])
+        {
+            addEntry(j, 0, matrixPosition);
+        }
+
+        // the lower entries are eliminated in increasing order, including the fill-ins
+        while (!lower.empty())
+        {
+            const int k = lower.top();
+            lower.pop();
+
+            const unsigned int levelIK = rowLevel[k];
+            // skip the diagonal of the row k
+            for (int q = m_rowBegin[k] + 1; q < m_rowBegin[k + 1]; ++q)
+            {
+                const int j = m_colIndex[q];
+                if (j <= k)
+                {
+                    continue;
+                }
+                const unsigned int level = levelIK + levels[q] + 1;
+                if (level <= fillLevel)
+                {
+                    addEntry(j, level, -1);
+                }
+            }
+        }
+
+        std::sort(upper.begin(), upper.end());
+        for (const int j : upper)
+        {
+            m_colIndex.push_back(j);
+            m_matrixPosition.push_back(rowMatrixPosition[j]);
+            levels.push_back(rowLevel[j]);
+        }
+        m_rowBegin[i + 1] = static_cast<int>(m_colIndex.size());
+    }
+
+    // transposed structure
+    m_colBegin.assign(n + 1, 0);
+    for (int i = 0; i < n; ++i)
+    {
+        for (int p = m_rowBegin[i] + 1; p < m_rowBegin[i + 1]; ++p)
+        {
+            ++m_colBegin[m_colIndex[p] + 1];
+        }
+    }
+    for (int j = 0; j < n; ++j)
+    {
+        m_colBegin[j + 1] += m_colBegin[j];
+    }
+    m_colRow.resize(m_colBegin[n]);
+    m_colPosition.resize(m_colBegin[n]);
+    type::vector<int> next(m_colBegin.begin(), m_colBegin.end() - 1);
+    for (int i = 0; i < n; ++i)
+    {
+        for (int p = m_rowBegin[i] + 1; p < m_rowBegin[i + 1]; ++p)
+        {
+            const int c = next[m_colIndex[p]]++;
+            m_colRow[c] = i;
+            m_colPosition[c] = p;
+        }
+    }
+
+    m_values.resize(m_colIndex.size());
+    m_diagonal.resize(n);
+    m_work.assign(n, 0);
+    m_position.assign(n, -1);
+    m_permuted.resize(n);
+}
+
+bool IncompleteCholesky::factorize(const SReal* values)
+{
+    SReal shift = 0;
+    for (unsigned int s = 0; s <= maxNbShifts; ++s)
+    {
+        if (factorize(values, shift))
+        {
+            m_shift = shift;
+            return true;
+        }
+        shift = (shift == 0) ? initialShift : 2 * shift;
+    }
+    return false;
+}
+
+bool IncompleteCholesky::factorize(const SReal* values, const SReal shift)
+{
+    for (int i = 0; i < m_n; ++i)
+    {
+        const int rowStart = m_rowBegin[i];
+        const int rowEnd = m_rowBegin[i + 1];
+
+        for (int p = rowStart; p < rowEnd; ++p)
+        {
+            const int j = m_colIndex[p];
+            m_position[j] = p;
+            m_work[j] = m_matrixPosition[p] != -1 ? values[m_matrixPosition[p]] : 0;
+        }
+        const SReal diagonal = m_work[i];
+        m_work[i] += shift * std::abs(diagonal);
+
+        // up-looking update by the rows k < i having a non-zero in the column i
+        for (int c = m_colBegin[i]; c < m_colBegin[i + 1]; ++c)
+        {
+            const int k = m_colRow[c];
+            const int pki = m_colPosition[c];
+            const SReal factor = m_values[pki] * m_diagonal[k];
+            for (int q = pki; q < m_rowBegin[k + 1]; ++q)
+            {
+                const int j = m_colIndex[q];
+                if (m_position[j] != -1)
+                {
+                    m_work[j] -= factor * m_values[q];
+                }
+            }
+        }
+
+        const SReal pivot = m_work[i];
+        const bool isValid = pivot > std::numeric_limits<SReal>::epsilon() * std::abs(diagonal) && std::isfinite(pivot);
+
+        m_diagonal[i] = pivot;
+        m_values[rowStart] = 1;
+        for (int p = rowStart + 1; p < rowEnd; ++p)
+        {
+            m_values[p] = m_work[m_colIndex[p]] / pivot;
+        }
+        for (int p = rowStart; p < rowEnd; ++p)
+        {
+            m_position[m_colIndex[p]] = -1;
+        }
+
+        if (!isValid)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void IncompleteCholesky::solve(const SReal* b, SReal* x) const
+{
+    SReal* y = m_permuted.data();
+    for (int i = 0; i < m_n; ++i)
+    {
+        y[i] = b[m_perm[i]];
+    }
+
+    // U^T y = b
+    for (int i = 0; i < m_n; ++i)
+    {
+        const SReal yi = y[i];
+        for (int p = m_rowBegin[i] + 1; p < m_rowBegin[i + 1]; ++p)
+        {
+            y[m_colIndex[p]] -= m_values[p] * yi;
+        }
+    }
+
+    // D U x = y
+    for (int i = m_n - 1; i >= 0; --i)
+    {
+        SReal xi = y[i] / m_diagonal[i];
+        for (int p = m_rowBegin[i] + 1; p < m_rowBegin[i + 1]; ++p)
+        {
+            xi -= m_values[p] * y[m_colIndex[p]];
+        }
+        y[i] = xi;
+    }
+
+    for (int i = 0; i < m_n; ++i)
+    {
+        x[m_perm[i]] = y[i];
+    }
+}
+
+} // namespace sofa::component::linearsolver::preconditioner
@@ -0,0 +1,99 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/linearsolver/preconditioner/config.h>
+
+#include <sofa/type/vector.h>
+
+namespace sofa::component::linearsolver::preconditioner
+{
+
+/**
+ * Incomplete LDL^T factorization with level of fill k, IC(k), of a symmetric positive definite
+ * sparse matrix.
+ *
+ * The symbolic analysis (analyze()) only depends on the pattern of the matrix, the permutation
+ * and the level of fill: it computes the pattern of the factor, which is kept as long as the
+ * pattern of the matrix does not change. The numeric factorization (factorize()) fills the values
+ * of the factor on this pattern. If a pivot is not positive, the factorization is restarted on a
+ * matrix with a shifted diagonal (A + alpha diag(A)).
+ *
+ * The matrix is given in CSR format, with both its upper and lower triangles. The factorization
+ * is computed on the permuted matrix P^T A P, where perm[i] is the row of A corresponding to the
+ * row i of the permuted matrix.
+ */
+class SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_API IncompleteCholesky
+{
+public:
+
+    /// Compute the pattern of the factor
+    void analyze(int n, const int* rowBegin, const int* colIndex, const int* perm, const int* invperm,
+                 unsigned int fillLevel);
+
+    /// Compute the values of the factor, for a matrix with the pattern given to analyze()
+    /// @return false if the factorization failed, even with a shifted diagonal
+    bool factorize(const SReal* values);
+
+    /// x = (P L D L^T P^T)^-1 b
+    void solve(const SReal* b, SReal* x) const;
+
+    int size() const { return m_n; }
+
+    /// Number of non-zero values in the upper triangle of the factor, including the diagonal
+    std::size_t getNbNonZeros() const { return m_colIndex.size(); }
+
+    /// Relative diagonal shift used by the last numeric factorization
+    SReal getShift() const { return m_shift; }
+
+protected:
+
+    /// try to factorize A + shift diag(A)
+    bool factorize(const SReal* values, SReal shift);
+
+    int m_n { 0 };
+
+    type::vector<int> m_perm, m_invperm;
+
+    /// U = L^T in CSR, with the diagonal as the first entry of each row
+    type::vector<int> m_rowBegin;
+    type::vector<int> m_colIndex;
+    type::vector<SReal> m_values;
+
+    /// U in CSC: rows and positions in m_values of the entries of each column, excluding the diagonal
+    type::vector<int> m_colBegin;
+    type::vector<int> m_colRow;
+    type::vector<int> m_colPosition;
+
+    /// for each entry of U, position of the corresponding value of A, or -1 if it is a fill-in
+    type::vector<int> m_matrixPosition;
+
+    type::vector<SReal> m_diagonal;
+
+    SReal m_shift { 0 };
+
+    /// work vectors
+    type::vector<SReal> m_work;
+    type::vector<int> m_position;
+    mutable type::vector<SReal> m_permuted;
+};
+
+} // namespace sofa::component::linearsolver::preconditioner
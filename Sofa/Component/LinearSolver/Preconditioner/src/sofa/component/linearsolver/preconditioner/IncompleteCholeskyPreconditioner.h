@@ -0,0 +1,103 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/linearsolver/preconditioner/config.h>
+
+#include <sofa/component/linearsolver/iterative/MatrixLinearSolver.h>
+#include <sofa/component/linearsolver/ordering/OrderingMethodAccessor.h>
+#include <sofa/component/linearsolver/preconditioner/IncompleteCholesky.h>
+#include <sofa/linearalgebra/CompressedRowSparseMatrix.h>
+#include <sofa/linearalgebra/FullVector.h>
+
+namespace sofa::component::linearsolver::preconditioner
+{
+
+/**
+ * Preconditioner based on an incomplete Cholesky factorization with level of fill k, IC(k)
+ * (see @IncompleteCholesky), of the permuted matrix. The permutation is computed by the linked
+ * ordering method (e.g. AMDOrderingMethod).
+ *
+ * The permutation and the pattern of the factor are kept as long as the pattern of the matrix
+ * does not change. The numeric factorization is recomputed every update_step assemblies of the
+ * matrix, the previous factorization being used in between.
+ */
+template<class TMatrix, class TVector>
+class IncompleteCholeskyPreconditioner : public ordering::OrderingMethodAccessor<sofa::component::linearsolver::MatrixLinearSolver<TMatrix,TVector> >
+{
+public:
+    SOFA_CLASS(SOFA_TEMPLATE2(IncompleteCholeskyPreconditioner,TMatrix,TVector),
+        SOFA_TEMPLATE(ordering::OrderingMethodAccessor, SOFA_TEMPLATE2(sofa::component::linearsolver::MatrixLinearSolver,TMatrix,TVector)));
+
+    typedef TMatrix Matrix;
+    typedef TVector Vector;
+    typedef ordering::OrderingMethodAccessor<sofa::component::linearsolver::MatrixLinearSolver<TMatrix,TVector> > Inherit;
+
+    Data<unsigned int> d_fillLevel; ///< Level of fill of the incomplete factorization. 0 keeps the pattern of the matrix.
+    Data<unsigned int> d_updateStep; ///< Number of assemblies of the matrix before the next numeric factorization
+    Data<int> d_L_nnz; ///< Number of non-zero values in the lower triangular matrix of the factorization
+    Data<SReal> d_shift; ///< Diagonal shift, relative to the diagonal, used by the last factorization
+
+protected:
+    IncompleteCholeskyPreconditioner();
+
+public:
+    void solve (Matrix& M, Vector& x, Vector& b) override;
+    void invert(Matrix& M) override;
+
+    MatrixInvertData * createInvertData() override
+    {
+        return new IncompleteCholeskyInvertData();
+    }
+
+protected:
+
+    class IncompleteCholeskyInvertData : public MatrixInvertData
+    {
+    public:
+        IncompleteCholesky factorization;
+
+        /// pattern and level of fill of the last analyzed matrix
+        type::vector<int> rowBegin;
+        type::vector<int> colIndex;
+        unsigned int fillLevel { 0 };
+
+        bool isAnalyzed { false };
+        bool isFactorized { false };
+
+        /// number of calls to invert since the last numeric factorization
+        unsigned int nbStepsSinceFactorization { 0 };
+    };
+
+    /// scalar copy of the matrix, with a row pointer for each row
+    linearalgebra::CompressedRowSparseMatrix<SReal> m_filteredMatrix;
+    type::vector<int> m_rowBegin;
+    type::vector<int> m_colIndex;
+
+    bool m_isShiftWarningEmitted { false };
+};
+
+#if !defined(SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_INCOMPLETECHOLESKYPRECONDITIONER_CPP)
+extern template class SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_API IncompleteCholeskyPreconditioner< linearalgebra::CompressedRowSparseMatrix<SReal>, linearalgebra::FullVector<SReal> >;
+extern template class SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_API IncompleteCholeskyPreconditioner< linearalgebra::CompressedRowSparseMatrix< type::Mat<3, 3, SReal> >, linearalgebra::FullVector<SReal> >;
+#endif // !defined(SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_INCOMPLETECHOLESKYPRECONDITIONER_CPP)
+
+} // namespace sofa::component::linearsolver::preconditioner
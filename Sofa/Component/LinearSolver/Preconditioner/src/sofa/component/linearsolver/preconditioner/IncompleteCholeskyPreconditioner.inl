@@ -0,0 +1,126 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/linearsolver/preconditioner/IncompleteCholeskyPreconditioner.h>
+#include <sofa/helper/ScopedAdvancedTimer.h>
+
+#include <numeric>
+
+namespace sofa::component::linearsolver::preconditioner
+{
+
+template<class TMatrix, class TVector>
+IncompleteCholeskyPreconditioner<TMatrix,TVector>::IncompleteCholeskyPreconditioner()
+    : d_fillLevel(initData(&d_fillLevel, 0u, "fillLevel", "Level of fill of the incomplete factorization. 0 keeps the pattern of the matrix, higher levels give a better preconditioner at the cost of more memory."))
+    , d_updateStep(initData(&d_updateStep, 1u, "update_step", "Number of assemblies of the matrix before the next numeric factorization. The last factorization is used in between. 0 or 1 to factorize at each assembly."))
+    , d_L_nnz(initData(&d_L_nnz, 0, "L_nnz", "Number of non-zero values in the lower triangular matrix of the factorization", true, true))
+    , d_shift(initData(&d_shift, 0_sreal, "shift", "Diagonal shift, relative to the diagonal, used by the last factorization to keep the pivots positive", true, true))
+{}
+
+template<class TMatrix, class TVector>
+void IncompleteCholeskyPreconditioner<TMatrix,TVector>::invert(Matrix& M)
+{
+    auto* data = static_cast<IncompleteCholeskyInvertData*>(this->getMatrixInvertData(&M));
+
+    m_filteredMatrix.copyNonZeros(M);
+    m_filteredMatrix.compress();
+
+    const int n = static_cast<int>(M.rowSize());
+
+    // the compressed matrix only stores its non-empty rows
+    const auto& rowIndex = m_filteredMatrix.getRowIndex();
+    const auto& rowBegin = m_filteredMatrix.getRowBegin();
+    const auto& colsIndex = m_filteredMatrix.getColsIndex();
+    m_rowBegin.assign(n + 1, 0);
+    for (std::size_t r = 0; r < rowIndex.size(); ++r)
+    {
+        m_rowBegin[rowIndex[r] + 1] = rowBegin[r + 1] - rowBegin[r];
+    }
+    std::partial_sum(m_rowBegin.begin(), m_rowBegin.end(), m_rowBegin.begin());
+    m_colIndex.assign(colsIndex.begin(), colsIndex.end());
+
+    const unsigned int fillLevel = d_fillLevel.getValue();
+    const bool patternChanged = !data->isAnalyzed || data->fillLevel != fillLevel
+        || m_rowBegin != data->rowBegin || m_colIndex != data->colIndex;
+
+    if (patternChanged)
+    {
+        SCOPED_TIMER_VARNAME(symbolicTimer, "symbolic_factorization");
+
+        type::vector<int> perm(n), invperm(n);
+        if (this->l_orderingMethod)
+        {
+            core::behavior::BaseOrderingMethod::SparseMatrixPattern pattern;
+            pattern.matrixSize = n;
+            pattern.numberOfNonZeros = m_rowBegin[n];
+            pattern.rowBegin = m_rowBegin.data();
+            pattern.colsIndex = m_colIndex.data();
+            this->l_orderingMethod->computePermutation(pattern, perm.data(), invperm.data());
+        }
+        else
+        {
+            std::iota(perm.begin(), perm.end(), 0);
+            std::iota(invperm.begin(), invperm.end(), 0);
+        }
+
+        data->factorization.analyze(n, m_rowBegin.data(), m_colIndex.data(), perm.data(), invperm.data(), fillLevel);
+        data->rowBegin = m_rowBegin;
+        data->colIndex = m_colIndex;
+        data->fillLevel = fillLevel;
+        data->isAnalyzed = true;
+        d_L_nnz.setValue(static_cast<int>(data->factorization.getNbNonZeros()));
+    }
+    else if (data->isFactorized && ++data->nbStepsSinceFactorization < d_updateStep.getValue())
+    {
+        return;
+    }
+
+    SCOPED_TIMER_VARNAME(numericTimer, "numeric_factorization");
+    data->nbStepsSinceFactorization = 0;
+    data->isFactorized = data->factorization.factorize(m_filteredMatrix.getColsValue().data());
+    d_shift.setValue(data->factorization.getShift());
+
+    msg_error_when(!data->isFactorized) << "Incomplete factorization failed: the preconditioner is replaced by the identity";
+    // the shift of the next factorizations is reported in the Data 'shift' only
+    if (data->isFactorized && data->factorization.getShift() > 0 && !m_isShiftWarningEmitted)
+    {
+        msg_warning() << "Non-positive pivot: the matrix has been factorized with a diagonal shift of "
+            << data->factorization.getShift() << " times the diagonal. This warning is emitted only once.";
+        m_isShiftWarningEmitted = true;
+    }
+}
+
+template<class TMatrix, class TVector>
+void IncompleteCholeskyPreconditioner<TMatrix,TVector>::solve(Matrix& M, Vector& z, Vector& r)
+{
+    auto* data = static_cast<IncompleteCholeskyInvertData*>(this->getMatrixInvertData(&M));
+    if (data->isFactorized && data->factorization.size() == static_cast<int>(r.size()))
+    {
+        data->factorization.solve(r.ptr(), z.ptr());
+    }
+    else
+    {
+        z = r;
+    }
+}
+
+} // namespace sofa::component::linearsolver::preconditioner
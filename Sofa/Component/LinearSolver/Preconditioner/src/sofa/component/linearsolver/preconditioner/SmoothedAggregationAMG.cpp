@@ -0,0 +1,704 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/component/linearsolver/preconditioner/SmoothedAggregationAMG.h>
+
+#include <sofa/simulation/ParallelForEach.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace sofa::component::linearsolver::preconditioner
+{
+
+namespace
+{
+
+using Block = BlockCSRMatrix::Block;
+using Vec3 = type::Vec<3, SReal>;
+
+/// Coarsest levels larger than this number of scalar rows are not factorized, but smoothed
+constexpr int maxDenseCoarsestSize = 3000;
+
+/// Number of smoothing steps on the coarsest level, if it is not factorized
+constexpr unsigned int nbCoarsestSmoothingSteps = 10;
+
+/// Number of iterations of the power method estimating the spectral radius of D^-1 A
+constexpr unsigned int nbPowerIterations = 20;
+
+/// Call f(begin, end) on ranges of [0, n), in parallel if a task scheduler is provided
+template<class F>
+void forEachRowRange(simulation::TaskScheduler* taskScheduler, const int n, F f)
+{
+    const auto call = [&f](const auto& range) { f(range.start, range.end); };
+    if (taskScheduler && taskScheduler->getThreadCount() > 1)
+    {
+        simulation::parallelForEachRange(*taskScheduler, 0, n, call);
+    }
+    else
+    {
+        simulation::forEachRange(0, n, call);
+    }
+}
+
+SReal squaredNorm(const Block& b)
+{
+    SReal s = 0;
+    for (sofa::Size i = 0; i < 3; ++i)
+    {
+        s += b[i].norm2();
+    }
+    return s;
+}
+
+Vec3 getBlockVector(const SReal* v, const int i)
+{
+    return Vec3(v[3 * i], v[3 * i + 1], v[3 * i + 2]);
+}
+
+void setBlockVector(SReal* v, const int i, const Vec3& value)
+{
+    v[3 * i] = value[0];
+    v[3 * i + 1] = value[1];
+    v[3 * i + 2] = value[2];
+}
+
+/// Pattern of C = A * B, with sorted column indices
+void multiplyPattern(const BlockCSRMatrix& A, const BlockCSRMatrix& B, BlockCSRMatrix& C)
+{
+    C.nbRows = A.nbRows;
+    C.nbCols = B.nbCols;
+    C.rowBegin.assign(A.nbRows + 1, 0);
+    C.colIndex.clear();
+
+    type::vector<int> marker(B.nbCols, -1);
+    for (int i = 0; i < A.nbRows; ++i)
+    {
+        const auto rowStart = static_cast<int>(C.colIndex.size());
+        for (int k = A.rowBegin[i]; k < A.rowBegin[i + 1]; ++k)
+        {
+            const int j = A.colIndex[k];
+            for (int m = B.rowBegin[j]; m < B.rowBegin[j + 1]; ++m)
+            {
+                const int col = B.colIndex[m];
+                if (marker[col] != i)
+                {
+                    marker[col] = i;
+                    C.colIndex.push_back(col);
+                }
+            }
+        }
+        std::sort(C.colIndex.begin() + rowStart, C.colIndex.end());
+        C.rowBegin[i + 1] = static_cast<int>(C.colIndex.size());
+    }
+    C.values.resize(C.colIndex.size());
+}
+
+/// Values of C = A * B. The pattern of C must have been computed by multiplyPattern.
+void multiplyValues(const BlockCSRMatrix& A, const BlockCSRMatrix& B, BlockCSRMatrix& C,
+                    simulation::TaskScheduler* taskScheduler)
+{
+    forEachRowRange(taskScheduler, A.nbRows, [&](const int begin, const int end)
+    {
+        // position in the current row of C of each column
+        type::vector<int> position(B.nbCols, -1);
+        for (int i = begin; i < end; ++i)
+        {
+            for (int p = C.rowBegin[i]; p < C.rowBegin[i + 1]; ++p)
+            {
+                position[C.colIndex[p]] = p;
+                C.values[p].clear();
+            }
+            for (int k = A.rowBegin[i]; k < A.rowBegin[i + 1]; ++k)
+            {
+                const int j = A.colIndex[k];
+                const Block& a = A.values[k];
+                for (int m = B.rowBegin[j]; m < B.rowBegin[j + 1]; ++m)
+                {
+                    C.values[position[B.colIndex[m]]] += a * B.values[m];
+                }
+            }
+        }
+    });
+}
+
+} // namespace
+
+bool SmoothedAggregationAMG::Parameters::operator==(const Parameters& other) const
+{
+    return strengthThreshold == other.strengthThreshold
+        && maxLevels == other.maxLevels
+        && coarsestSize == other.coarsestSize
+        && prolongationDamping == other.prolongationDamping
+        && smootherDamping == other.smootherDamping
+        && nbSmoothingSteps == other.nbSmoothingSteps;
+}
+
+bool BlockCSRMatrix::hasSamePattern(const BlockCSRMatrix& other) const
+{
+    return nbRows == other.nbRows && nbCols == other.nbCols
+        && rowBegin == other.rowBegin && colIndex == other.colIndex;
+}
+
+void BlockCSRMatrix::mul(const SReal* x, SReal* y, simulation::TaskScheduler* taskScheduler) const
+{
+    forEachRowRange(taskScheduler, nbRows, [&](const int begin, const int end)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            Vec3 sum;
+            for (int k = rowBegin[i]; k < rowBegin[i + 1]; ++k)
+            {
+                sum += values[k] * getBlockVector(x, colIndex[k]);
+            }
+            setBlockVector(y, i, sum);
+        }
+    });
+}
+
+void SmoothedAggregationAMG::build(const BlockCSRMatrix& A, const Parameters& parameters,
+                                   simulation::TaskScheduler* taskScheduler)
+{
+    m_parameters = parameters;
+    m_levels.clear();
+    m_levels.emplace_back().A = A;
+
+    for (std::size_t l = 0; ; ++l)
+    {
+        computeDiagonal(m_levels[l], taskScheduler);
+
+        const int n = m_levels[l].A.nbRows;
+        if (n <= m_parameters.coarsestSize || m_levels.size() >= m_parameters.maxLevels)
+        {
+            break;
+        }
+
+        computeAggregates(m_levels[l], m_parameters.strengthThreshold * std::pow(0.5_sreal, static_cast<SReal>(l)));
+
+        // the coarsening stagnates: the next level would be almost as expensive as this one
+        const auto nbAggregates = static_cast<int>(m_levels[l].aggregateSize.size());
+        if (nbAggregates == 0 || 10 * nbAggregates > 9 * n)
+        {
+            m_levels[l].aggregate.clear();
+            m_levels[l].aggregateSize.clear();
+            break;
+        }
+
+        computeCoarsePattern(l);
+        computeCoarseValues(l, taskScheduler);
+    }
+
+    factorizeCoarsest();
+
+    for (auto& level : m_levels)
+    {
+        const auto size = 3 * static_cast<std::size_t>(level.A.nbRows);
+        level.x.resize(size);
+        level.b.resize(size);
+        level.residual.resize(size);
+    }
+}
+
+void SmoothedAggregationAMG::update(const BlockCSRMatrix& A, simulation::TaskScheduler* taskScheduler)
+{
+    m_levels.front().A.values = A.values;
+
+    for (std::size_t l = 0; l < m_levels.size(); ++l)
+    {
+        computeDiagonal(m_levels[l], taskScheduler);
+        if (l + 1 < m_levels.size())
+        {
+            computeCoarseValues(l, taskScheduler);
+        }
+    }
+
+    factorizeCoarsest();
+}
+
+SReal SmoothedAggregationAMG::getOperatorComplexity() const
+{
+    if (m_levels.empty() || m_levels.front().A.nbBlocks() == 0)
+    {
+        return 0;
+    }
+
+    std::size_t nbBlocks = 0;
+    for (const auto& level : m_levels)
+    {
+        nbBlocks += level.A.nbBlocks();
+    }
+    return static_cast<SReal>(nbBlocks) / static_cast<SReal>(m_levels.front().A.nbBlocks());
+}
+
+void SmoothedAggregationAMG::computeDiagonal(Level& level, simulation::TaskScheduler* taskScheduler) const
+{
+    const BlockCSRMatrix& A = level.A;
+    level.invDiagonal.resize(A.nbRows);
+    type::vector<Block> diagonals(A.nbRows);
+
+    for (int i = 0; i < A.nbRows; ++i)
+    {
+        Block& invDiagonal = level.invDiagonal[i];
+        invDiagonal.clear();
+
+        const auto first = A.colIndex.begin() + A.rowBegin[i];
+        const auto last = A.colIndex.begin() + A.rowBegin[i + 1];
+        const auto it = std::lower_bound(first, last, i);
+        if (it != last && *it == i)
+        {
+            const Block& diagonal = A.values[it - A.colIndex.begin()];
+            diagonals[i] = diagonal;
+            if (!invertMatrix(invDiagonal, diagonal))
+            {
+                // fall back to a scalar Jacobi on the non-zero diagonal entries
+                for (sofa::Size d = 0; d < 3; ++d)
+                {
+                    if (diagonal[d][d] != 0)
+                    {
+                        invDiagonal[d][d] = 1 / diagonal[d][d];
+                    }
+                }
+            }
+        }
+    }
+
+    // Power method on D^-1 A. A is symmetric and D is positive definite, so the eigenvalues of
+    // D^-1 A are the ones of the generalized problem A v = lambda D v, and the Rayleigh quotient
+    // (v^T A v) / (v^T D v) converges to the largest one.
+    const auto size = 3 * static_cast<std::size_t>(A.nbRows);
+    type::vector<SReal> v(size), Av(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        // deterministic vector, not orthogonal to the dominant eigenvector in practice
+        v[i] = 1 + static_cast<SReal>((i * 7919) % 97) / 97;
+    }
+
+    SReal lambda = 0;
+    for (unsigned int it = 0; it < nbPowerIterations && size > 0; ++it)
+    {
+        A.mul(v.data(), Av.data(), taskScheduler);
+
+        SReal vAv = 0;
+        SReal vDv = 0;
+        for (int i = 0; i < A.nbRows; ++i)
+        {
+            const Vec3 vi = getBlockVector(v.data(), i);
+            const Vec3 Avi = getBlockVector(Av.data(), i);
+            vAv += vi * Avi;
+
+            // v <- D^-1 A v
+            const Vec3 next = level.invDiagonal[i] * Avi;
+            vDv += vi * (diagonals[i] * vi);
+            setBlockVector(v.data(), i, next);
+        }
+        if (vDv <= 0)
+        {
+            break;
+        }
+        lambda = vAv / vDv;
+
+        SReal norm = 0;
+        for (const SReal value : v)
+        {
+            norm = std::max(norm, std::abs(value));
+        }
+        if (norm == 0)
+        {
+            break;
+        }
+        for (SReal& value : v)
+        {
+            value /= norm;
+        }
+    }
+
+    // the Rayleigh quotient underestimates the spectral radius
+    level.spectralRadius = lambda > 0 ? 1.1_sreal * lambda : 1_sreal;
+}
+
+void SmoothedAggregationAMG::computeAggregates(Level& level, const SReal strengthThreshold) const
+{
+    const BlockCSRMatrix& A = level.A;
+    const int n = A.nbRows;
+    const SReal threshold2 = strengthThreshold * strengthThreshold;
+
+    type::vector<SReal> diagonalNorm(n, 0);
+    for (int i = 0; i < n; ++i)
+    {
+        for (int k = A.rowBegin[i]; k < A.rowBegin[i + 1]; ++k)
+        {
+            if (A.colIndex[k] == i)
+            {
+                diagonalNorm[i] = std::sqrt(squaredNorm(A.values[k]));
+            }
+        }
+    }
+
+    auto& isStrong = level.isStrong;
+    isStrong.assign(A.nbBlocks(), false);
+    for (int i = 0; i < n; ++i)
+    {
+        for (int k = A.rowBegin[i]; k < A.rowBegin[i + 1]; ++k)
+        {
+            const int j = A.colIndex[k];
+            isStrong[k] = j != i && squaredNorm(A.values[k]) > threshold2 * diagonalNorm[i] * diagonalNorm[j];
+        }
+    }
+
+    auto& aggregate = level.aggregate;
+    aggregate.assign(n, -1);
+    int nbAggregates = 0;
+
+    // 1. a node and all its strong neighbors form an aggregate, if none of them is aggregated yet
+    for (int i = 0; i < n; ++i)
+    {
+        if (aggregate[i] != -1)
+        {
+            continue;
+        }
+
+        bool isFree = true;
+        bool hasNeighbor = false;
+        for (int k = A.rowBegin[i]; k < A.rowBegin[i + 1] && isFree; ++k)
+        {
+            if (isStrong[k])
+            {
+                hasNeighbor = true;
+                isFree = aggregate[A.colIndex[k]] == -1;
+            }
+        }
+        if (!isFree || !hasNeighbor)
+        {
+            continue;
+        }
+
+        aggregate[i] = nbAggregates;
+        for (int k = A.rowBegin[i]; k < A.rowBegin[i + 1]; ++k)
+        {
+            if (isStrong[k])
+            {
+                aggregate[A.colIndex[k]] = nbAggregates;
+            }
+        }
+        ++nbAggregates;
+    }
+
+    // 2. the remaining nodes join the aggregate of one of their strong neighbors
+    const type::vector<int> firstAggregates = aggregate;
+    for (int i = 0; i < n; ++i)
+    {
+        if (aggregate[i] != -1)
+        {
+            continue;
+        }
+        for (int k = A.rowBegin[i]; k < A.rowBegin[i + 1]; ++k)
+        {
+            if (isStrong[k] && firstAggregates[A.colIndex[k]] != -1)
+            {
+                aggregate[i] = firstAggregates[A.colIndex[k]];
+                break;
+            }
+        }
+    }
+
+    // 3. the nodes still not aggregated form new aggregates with their free strong neighbors
+    for (int i = 0; i < n; ++i)
+    {
+        if (aggregate[i] != -1)
+        {
+            continue;
+        }
+        aggregate[i] = nbAggregates;
+        for (int k = A.rowBegin[i]; k < A.rowBegin[i + 1]; ++k)
+        {
+            if (isStrong[k] && aggregate[A.colIndex[k]] == -1)
+            {
+                aggregate[A.colIndex[k]] = nbAggregates;
+            }
+        }
+        ++nbAggregates;
+    }
+
+    level.aggregateSize.assign(nbAggregates, 0);
+    for (const int a : aggregate)
+    {
+        ++level.aggregateSize[a];
+    }
+}
+
+void SmoothedAggregationAMG::computeCoarsePattern(const std::size_t l)
+{
+    Level& level = m_levels[l];
+    const BlockCSRMatrix& A = level.A;
+    const int nbAggregates = static_cast<int>(level.aggregateSize.size());
+
+    // P = (I - w D^-1 A_F) T, where T is the tentative prolongation and A_F the filtered matrix:
+    // the row i of P contains the aggregates of i and of the nodes strongly connected to i
+    BlockCSRMatrix& P = level.P;
+    P.nbRows = A.nbRows;
+    P.nbCols = nbAggregates;
+    P.rowBegin.assign(A.nbRows + 1, 0);
+    P.colIndex.clear();
+    type::vector<int> marker(nbAggregates, -1);
+    for (int i = 0; i < A.nbRows; ++i)
+    {
+        const auto rowStart = static_cast<int>(P.colIndex.size());
+        for (int k = A.rowBegin[i]; k < A.rowBegin[i + 1]; ++k)
+        {
+            if (!level.isStrong[k])
+            {
+                continue;
+            }
+            const int a = level.aggregate[A.colIndex[k]];
+            if (marker[a] != i)
+            {
+                marker[a] = i;
+                P.colIndex.push_back(a);
+            }
+        }
+        if (marker[level.aggregate[i]] != i)
+        {
+            P.colIndex.push_back(level.aggregate[i]);
+        }
+        std::sort(P.colIndex.begin() + rowStart, P.colIndex.end());
+        P.rowBegin[i + 1] = static_cast<int>(P.colIndex.size());
+    }
+    P.values.resize(P.colIndex.size());
+
+    // R = P^T
+    BlockCSRMatrix& R = level.R;
+    R.nbRows = P.nbCols;
+    R.nbCols = P.nbRows;
+    R.rowBegin.assign(R.nbRows + 1, 0);
+    for (const int a : P.colIndex)
+    {
+        ++R.rowBegin[a + 1];
+    }
+    for (int a = 0; a < R.nbRows; ++a)
+    {
+        R.rowBegin[a + 1] += R.rowBegin[a];
+    }
+    R.colIndex.resize(P.colIndex.size());
+    R.values.resize(P.colIndex.size());
+    level.transposePosition.resize(P.colIndex.size());
+    type::vector<int> next(R.rowBegin.begin(), R.rowBegin.end() - 1);
+    for (int i = 0; i < P.nbRows; ++i)
+    {
+        for (int k = P.rowBegin[i]; k < P.rowBegin[i + 1]; ++k)
+        {
+            const int r = next[P.colIndex[k]]++;
+            R.colIndex[r] = i;
+            level.transposePosition[r] = k;
+        }
+    }
+
+    multiplyPattern(A, P, level.AP);
+
+    Level coarse;
+    multiplyPattern(R, level.AP, coarse.A);
+    m_levels.push_back(std::move(coarse));
+}
+
+void SmoothedAggregationAMG::computeCoarseValues(const std::size_t l, simulation::TaskScheduler* taskScheduler)
+{
+    Level& level = m_levels[l];
+    const BlockCSRMatrix& A = level.A;
+    BlockCSRMatrix& P = level.P;
+
+    type::vector<SReal> aggregateScale(level.aggregateSize.size());
+    for (std::size_t a = 0; a < aggregateScale.size(); ++a)
+    {
+        aggregateScale[a] = 1 / std::sqrt(static_cast<SReal>(level.aggregateSize[a]));
+    }
+
+    // P_ia = s_a ( [i in a] I - w D_i^-1 sum_{j in a} A_F,ij ), where the weak connections of
+    // A_F are added to its diagonal, so that A_F has the same near null space as A
+    const SReal w = m_parameters.prolongationDamping / level.spectralRadius;
+    forEachRowRange(taskScheduler, A.nbRows, [&](const int begin, const int end)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            const auto first = P.colIndex.begin() + P.rowBegin[i];
+            const auto last = P.colIndex.begin() + P.rowBegin[i + 1];
+            const auto positionInP = [&](const int a)
+            {
+                return static_cast<int>(std::lower_bound(first, last, a) - P.colIndex.begin());
+            };
+
+            for (int p = P.rowBegin[i]; p < P.rowBegin[i + 1]; ++p)
+            {
+                P.values[p].clear();
+            }
+            for (int k = A.rowBegin[i]; k < A.rowBegin[i + 1]; ++k)
+            {
+                const int j = level.isStrong[k] ? A.colIndex[k] : i;
+                P.values[positionInP(level.aggregate[j])] -= A.values[k];
+            }
+            for (int p = P.rowBegin[i]; p < P.rowBegin[i + 1]; ++p)
+            {
+                P.values[p] = (level.invDiagonal[i] * P.values[p]) * w;
+            }
+            for (sofa::Size d = 0; d < 3; ++d)
+            {
+                P.values[positionInP(level.aggregate[i])][d][d] += 1;
+            }
+            for (int p = P.rowBegin[i]; p < P.rowBegin[i + 1]; ++p)
+            {
+                P.values[p] *= aggregateScale[P.colIndex[p]];
+            }
+        }
+    });
+
+    BlockCSRMatrix& R = level.R;
+    for (std::size_t r = 0; r < R.values.size(); ++r)
+    {
+        R.values[r] = P.values[level.transposePosition[r]].transposed();
+    }
+
+    multiplyValues(A, P, level.AP, taskScheduler);
+    multiplyValues(R, level.AP, m_levels[l + 1].A, taskScheduler);
+}
+
+void SmoothedAggregationAMG::factorizeCoarsest()
+{
+    const BlockCSRMatrix& A = m_levels.back().A;
+    const int size = 3 * A.nbRows;
+
+    m_hasCoarsestSolver = false;
+    if (size == 0 || size > maxDenseCoarsestSize)
+    {
+        return;
+    }
+
+    DenseMatrix dense = DenseMatrix::Zero(size, size);
+    for (int i = 0; i < A.nbRows; ++i)
+    {
+        for (int k = A.rowBegin[i]; k < A.rowBegin[i + 1]; ++k)
+        {
+            const int j = A.colIndex[k];
+            for (sofa::Size r = 0; r < 3; ++r)
+            {
+                for (sofa::Size c = 0; c < 3; ++c)
+                {
+                    dense(3 * i + r, 3 * j + c) = A.values[k][r][c];
+                }
+            }
+        }
+    }
+
+    m_coarsestSolver.compute(dense);
+    m_hasCoarsestSolver = m_coarsestSolver.info() == Eigen::Success;
+    m_coarsestRhs.resize(size);
+}
+
+void SmoothedAggregationAMG::computeResidual(Level& level, simulation::TaskScheduler* taskScheduler) const
+{
+    const BlockCSRMatrix& A = level.A;
+    forEachRowRange(taskScheduler, A.nbRows, [&](const int begin, const int end)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            Vec3 r = getBlockVector(level.b.data(), i);
+            for (int k = A.rowBegin[i]; k < A.rowBegin[i + 1]; ++k)
+            {
+                r -= A.values[k] * getBlockVector(level.x.data(), A.colIndex[k]);
+            }
+            setBlockVector(level.residual.data(), i, r);
+        }
+    });
+}
+
+void SmoothedAggregationAMG::smooth(Level& level, simulation::TaskScheduler* taskScheduler) const
+{
+    computeResidual(level, taskScheduler);
+
+    const SReal w = m_parameters.smootherDamping / level.spectralRadius;
+    forEachRowRange(taskScheduler, level.A.nbRows, [&](const int begin, const int end)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            const Vec3 dx = level.invDiagonal[i] * getBlockVector(level.residual.data(), i);
+            setBlockVector(level.x.data(), i, getBlockVector(level.x.data(), i) + dx * w);
+        }
+    });
+}
+
+void SmoothedAggregationAMG::cycle(const std::size_t l, simulation::TaskScheduler* taskScheduler)
+{
+    Level& level = m_levels[l];
+    std::fill(level.x.begin(), level.x.end(), 0_sreal);
+
+    if (l + 1 == m_levels.size())
+    {
+        if (m_hasCoarsestSolver)
+        {
+            m_coarsestRhs = Eigen::Map<const DenseVector>(level.b.data(), level.b.size());
+            Eigen::Map<DenseVector>(level.x.data(), level.x.size()) = m_coarsestSolver.solve(m_coarsestRhs);
+        }
+        else
+        {
+            for (unsigned int s = 0; s < nbCoarsestSmoothingSteps; ++s)
+            {
+                smooth(level, taskScheduler);
+            }
+        }
+        return;
+    }
+
+    for (unsigned int s = 0; s < m_parameters.nbSmoothingSteps; ++s)
+    {
+        smooth(level, taskScheduler);
+    }
+
+    // restriction of the residual
+    Level& coarse = m_levels[l + 1];
+    computeResidual(level, taskScheduler);
+    level.R.mul(level.residual.data(), coarse.b.data(), taskScheduler);
+
+    cycle(l + 1, taskScheduler);
+
+    // prolongation of the coarse correction
+    level.P.mul(coarse.x.data(), level.residual.data(), taskScheduler);
+    for (std::size_t i = 0; i < level.x.size(); ++i)
+    {
+        level.x[i] += level.residual[i];
+    }
+
+    for (unsigned int s = 0; s < m_parameters.nbSmoothingSteps; ++s)
+    {
+        smooth(level, taskScheduler);
+    }
+}
+
+void SmoothedAggregationAMG::apply(const SReal* b, SReal* x, simulation::TaskScheduler* taskScheduler)
+{
+    if (m_levels.empty())
+    {
+        return;
+    }
+
+    Level& fine = m_levels.front();
+    std::copy(b, b + fine.b.size(), fine.b.begin());
+    cycle(0, taskScheduler);
+    std::copy(fine.x.begin(), fine.x.end(), x);
+}
+
+} // namespace sofa::component::linearsolver::preconditioner
@@ -0,0 +1,197 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/linearsolver/preconditioner/config.h>
+
+#include <sofa/simulation/TaskScheduler.h>
+#include <sofa/type/Mat.h>
+#include <sofa/type/vector.h>
+
+#include <Eigen/Dense>
+
+namespace sofa::component::linearsolver::preconditioner
+{
+
+/**
+ * Sparse matrix of 3x3 blocks, stored by rows. The column indices of a row are sorted.
+ */
+struct SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_API BlockCSRMatrix
+{
+    using Block = type::Mat<3, 3, SReal>;
+
+    /// number of block rows and block columns
+    int nbRows { 0 };
+    int nbCols { 0 };
+
+    /// the blocks of the row i are stored from rowBegin[i] to rowBegin[i+1]-1
+    type::vector<int> rowBegin;
+    type::vector<int> colIndex;
+    type::vector<Block> values;
+
+    std::size_t nbBlocks() const { return colIndex.size(); }
+
+    bool hasSamePattern(const BlockCSRMatrix& other) const;
+
+    /// y = A * x. The rows are computed in parallel if a task scheduler is provided.
+    void mul(const SReal* x, SReal* y, simulation::TaskScheduler* taskScheduler) const;
+};
+
+/**
+ * Smoothed aggregation algebraic multigrid, for matrices of 3x3 nodal blocks.
+ *
+ * The nodes (block rows) are grouped into aggregates, based on the strength of the connections
+ * between the nodes. The tentative prolongation interpolates the 3 translations of each aggregate,
+ * and is smoothed by a damped Jacobi iteration on the filtered matrix, where the weak connections
+ * are lumped on the diagonal, to limit the fill-in of the coarse matrices. The coarse matrix is computed with the Galerkin
+ * product P^T A P. The coarsest level is solved with a dense LDL^T factorization.
+ *
+ * The hierarchy is split into a symbolic part (aggregates and patterns of all the matrices),
+ * computed by build(), and a numeric part (values of all the matrices), which can be recomputed
+ * by update() as long as the sparsity pattern of the fine matrix does not change.
+ *
+ * apply() runs a symmetric V-cycle with a damped block Jacobi smoother, so that it can be used as
+ * a preconditioner of a conjugate gradient. The smoother, the residuals and the transfers between
+ * the levels are computed in parallel if a task scheduler is provided.
+ */
+class SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_API SmoothedAggregationAMG
+{
+public:
+
+    struct Parameters
+    {
+        /// two nodes i and j are strongly connected if ||A_ij|| > threshold * sqrt(||A_ii|| ||A_jj||).
+        /// The threshold is halved on each coarser level.
+        SReal strengthThreshold { 0.08 };
+
+        unsigned int maxLevels { 10 };
+
+        /// the coarsening stops when a level has at most this number of block rows
+        int coarsestSize { 64 };
+
+        /// damping of the Jacobi iteration smoothing the tentative prolongation, relative to the
+        /// inverse of the spectral radius of D^-1 A
+        SReal prolongationDamping { 4_sreal / 3_sreal };
+
+        /// damping of the Jacobi smoother, relative to the inverse of the spectral radius of D^-1 A
+        SReal smootherDamping { 4_sreal / 3_sreal };
+
+        /// number of pre- and post-smoothing steps
+        unsigned int nbSmoothingSteps { 1 };
+
+        bool operator==(const Parameters& other) const;
+        bool operator!=(const Parameters& other) const { return !(*this == other); }
+    };
+
+    /// Compute the hierarchy from the fine matrix
+    void build(const BlockCSRMatrix& A, const Parameters& parameters, simulation::TaskScheduler* taskScheduler);
+
+    /// Recompute the values of the hierarchy, keeping the aggregates. The fine matrix must have the
+    /// same pattern as the one given to build().
+    void update(const BlockCSRMatrix& A, simulation::TaskScheduler* taskScheduler);
+
+    bool isBuilt() const { return !m_levels.empty(); }
+
+    const Parameters& getParameters() const { return m_parameters; }
+
+    /// x = M^-1 b, where M^-1 is a V-cycle. x and b have the size of the fine level.
+    void apply(const SReal* b, SReal* x, simulation::TaskScheduler* taskScheduler);
+
+    std::size_t getNbLevels() const { return m_levels.size(); }
+
+    /// Matrix of the given level. The level 0 is the fine level.
+    const BlockCSRMatrix& getMatrix(std::size_t level) const { return m_levels[level].A; }
+
+    /// Total number of blocks of the matrices of all the levels, divided by the number of blocks of
+    /// the fine matrix
+    SReal getOperatorComplexity() const;
+
+    /// Aggregate of each node of the given level (except the coarsest)
+    const type::vector<int>& getAggregates(std::size_t level) const { return m_levels[level].aggregate; }
+
+protected:
+
+    struct Level
+    {
+        BlockCSRMatrix A;
+
+        /// inverse of the diagonal blocks of A
+        type::vector<BlockCSRMatrix::Block> invDiagonal;
+
+        /// estimation of the spectral radius of D^-1 A
+        SReal spectralRadius { 1 };
+
+        /// strong connections, in the same layout as the blocks of A
+        type::vector<bool> isStrong;
+
+        /// aggregate of each node, and number of nodes in each aggregate. Empty on the coarsest level.
+        type::vector<int> aggregate;
+        type::vector<int> aggregateSize;
+
+        /// prolongation from the next level to this level, and its transpose
+        BlockCSRMatrix P;
+        BlockCSRMatrix R;
+
+        /// position in P of each block of R
+        type::vector<int> transposePosition;
+
+        /// A * P
+        BlockCSRMatrix AP;
+
+        /// work vectors
+        type::vector<SReal> x, b, residual;
+    };
+
+    /// Inverse of the diagonal blocks and spectral radius of D^-1 A
+    void computeDiagonal(Level& level, simulation::TaskScheduler* taskScheduler) const;
+
+    void computeAggregates(Level& level, SReal strengthThreshold) const;
+
+    /// Pattern of the prolongation of the given level, and of the matrix of the next level
+    void computeCoarsePattern(std::size_t l);
+
+    /// Values of the prolongation of the given level, and of the matrix of the next level
+    void computeCoarseValues(std::size_t l, simulation::TaskScheduler* taskScheduler);
+
+    void factorizeCoarsest();
+
+    /// x += w D^-1 (b - A x)
+    void smooth(Level& level, simulation::TaskScheduler* taskScheduler) const;
+
+    /// residual = b - A x
+    void computeResidual(Level& level, simulation::TaskScheduler* taskScheduler) const;
+
+    void cycle(std::size_t l, simulation::TaskScheduler* taskScheduler);
+
+    Parameters m_parameters;
+
+    std::vector<Level> m_levels;
+
+    using DenseMatrix = Eigen::Matrix<SReal, Eigen::Dynamic, Eigen::Dynamic>;
+    using DenseVector = Eigen::Matrix<SReal, Eigen::Dynamic, 1>;
+
+    /// factorization of the coarsest level, if it is small enough
+    Eigen::LDLT<DenseMatrix> m_coarsestSolver;
+    bool m_hasCoarsestSolver { false };
+    DenseVector m_coarsestRhs;
+};
+
+} // namespace sofa::component::linearsolver::preconditioner
@@ -0,0 +1,98 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/linearsolver/preconditioner/config.h>
+
+#include <sofa/component/linearsolver/iterative/MatrixLinearSolver.h>
+#include <sofa/component/linearsolver/preconditioner/SmoothedAggregationAMG.h>
+#include <sofa/linearalgebra/CompressedRowSparseMatrix.h>
+#include <sofa/linearalgebra/FullVector.h>
+
+namespace sofa::component::linearsolver::preconditioner
+{
+
+/**
+ * Preconditioner based on a V-cycle of a smoothed aggregation algebraic multigrid
+ * (see @SmoothedAggregationAMG), for matrices of 3x3 blocks.
+ *
+ * The multigrid hierarchy is built at the first assembly. As long as the sparsity pattern of the
+ * matrix and the parameters do not change, the next assemblies only recompute the values of the
+ * hierarchy, keeping the aggregates. The V-cycle is symmetric positive definite, so this
+ * preconditioner can be used with a conjugate gradient (e.g. ShewchukPCGLinearSolver).
+ */
+template<class TMatrix, class TVector>
+class SmoothedAggregationAMGPreconditioner : public sofa::component::linearsolver::MatrixLinearSolver<TMatrix,TVector>
+{
+public:
+    SOFA_CLASS(SOFA_TEMPLATE2(SmoothedAggregationAMGPreconditioner,TMatrix,TVector),SOFA_TEMPLATE2(sofa::component::linearsolver::MatrixLinearSolver,TMatrix,TVector));
+
+    typedef TMatrix Matrix;
+    typedef TVector Vector;
+    typedef sofa::component::linearsolver::MatrixLinearSolver<TMatrix,TVector> Inherit;
+
+    Data<SReal> d_strengthThreshold; ///< Threshold defining the strong connections between the nodes on the fine level. It is halved on each coarser level.
+    Data<unsigned int> d_maxLevels; ///< Maximum number of levels of the hierarchy
+    Data<int> d_coarsestSize; ///< Maximum number of nodes (3x3 block rows) of the coarsest level
+    Data<unsigned int> d_nbSmoothingSteps; ///< Number of pre- and post-smoothing steps on each level
+    Data<SReal> d_smootherDamping; ///< Damping of the Jacobi smoother, relative to the inverse of the spectral radius of D^-1 A
+    Data<SReal> d_prolongationDamping; ///< Damping of the Jacobi iteration smoothing the prolongation, relative to the inverse of the spectral radius of D^-1 A
+    Data<bool> d_parallel; ///< If true, the smoothers, the residuals, the transfers between the levels and the coarse matrices are computed in parallel
+    Data<unsigned int> d_nbLevels; ///< Number of levels of the hierarchy
+    Data<SReal> d_operatorComplexity; ///< Total number of blocks of the matrices of all the levels, divided by the number of blocks of the fine matrix
+
+protected:
+    SmoothedAggregationAMGPreconditioner();
+
+public:
+    void solve (Matrix& M, Vector& x, Vector& b) override;
+    void invert(Matrix& M) override;
+
+    MatrixInvertData * createInvertData() override
+    {
+        return new SmoothedAggregationAMGInvertData();
+    }
+
+protected:
+
+    class SmoothedAggregationAMGInvertData : public MatrixInvertData
+    {
+    public:
+        /// fine matrix, in the format of the multigrid
+        BlockCSRMatrix matrix;
+
+        SmoothedAggregationAMG amg;
+    };
+
+    SmoothedAggregationAMG::Parameters getParameters() const;
+
+    /// @return the task scheduler used by the multigrid, or nullptr if it is sequential
+    simulation::TaskScheduler* getTaskScheduler() const;
+
+    /// Copy the matrix of the linear system into the format of the multigrid
+    static void convertMatrix(Matrix& M, BlockCSRMatrix& matrix);
+};
+
+#if !defined(SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_SMOOTHEDAGGREGATIONAMGPRECONDITIONER_CPP)
+extern template class SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_API SmoothedAggregationAMGPreconditioner< linearalgebra::CompressedRowSparseMatrix< type::Mat<3, 3, SReal> >, linearalgebra::FullVector<SReal> >;
+#endif // !defined(SOFA_COMPONENT_LINEARSOLVER_PRECONDITIONER_SMOOTHEDAGGREGATIONAMGPRECONDITIONER_CPP)
+
+} // namespace sofa::component::linearsolver::preconditioner
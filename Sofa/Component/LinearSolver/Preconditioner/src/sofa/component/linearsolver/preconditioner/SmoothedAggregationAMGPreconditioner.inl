@@ -0,0 +1,156 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/linearsolver/preconditioner/SmoothedAggregationAMGPreconditioner.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/helper/ScopedAdvancedTimer.h>
+
+namespace sofa::component::linearsolver::preconditioner
+{
+
+template<class TMatrix, class TVector>
+SmoothedAggregationAMGPreconditioner<TMatrix,TVector>::SmoothedAggregationAMGPreconditioner()
+    : d_strengthThreshold(initData(&d_strengthThreshold, SmoothedAggregationAMG::Parameters{}.strengthThreshold, "strengthThreshold", "Threshold defining the strong connections between the nodes on the fine level. It is halved on each coarser level."))
+    , d_maxLevels(initData(&d_maxLevels, SmoothedAggregationAMG::Parameters{}.maxLevels, "maxLevels", "Maximum number of levels of the hierarchy"))
+    , d_coarsestSize(initData(&d_coarsestSize, SmoothedAggregationAMG::Parameters{}.coarsestSize, "coarsestSize", "Maximum number of nodes (3x3 block rows) of the coarsest level"))
+    , d_nbSmoothingSteps(initData(&d_nbSmoothingSteps, SmoothedAggregationAMG::Parameters{}.nbSmoothingSteps, "nbSmoothingSteps", "Number of pre- and post-smoothing steps on each level"))
+    , d_smootherDamping(initData(&d_smootherDamping, SmoothedAggregationAMG::Parameters{}.smootherDamping, "smootherDamping", "Damping of the Jacobi smoother, relative to the inverse of the spectral radius of D^-1 A"))
+    , d_prolongationDamping(initData(&d_prolongationDamping, SmoothedAggregationAMG::Parameters{}.prolongationDamping, "prolongationDamping", "Damping of the Jacobi iteration smoothing the prolongation, relative to the inverse of the spectral radius of D^-1 A"))
+    , d_parallel(initData(&d_parallel, false, "parallel", "If true, the smoothers, the residuals, the transfers between the levels and the coarse matrices are computed in parallel"))
+    , d_nbLevels(initData(&d_nbLevels, 0u, "nbLevels", "Number of levels of the hierarchy", true, true))
+    , d_operatorComplexity(initData(&d_operatorComplexity, 0_sreal, "operatorComplexity", "Total number of blocks of the matrices of all the levels, divided by the number of blocks of the fine matrix", true, true))
+{
+    this->addUpdateCallback("parallel", {&d_parallel},
+    [this](const core::DataTracker& tracker) -> sofa::core::objectmodel::ComponentState
+    {
+        SOFA_UNUSED(tracker);
+        if (d_parallel.getValue())
+        {
+            simulation::TaskScheduler* taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+            assert(taskScheduler);
+
+            if (taskScheduler->getThreadCount() < 1)
+            {
+                taskScheduler->init(0);
+                msg_info() << "Task scheduler initialized on " << taskScheduler->getThreadCount() << " threads";
+            }
+        }
+        return this->d_componentState.getValue();
+    },
+    {});
+}
+
+template<class TMatrix, class TVector>
+SmoothedAggregationAMG::Parameters SmoothedAggregationAMGPreconditioner<TMatrix,TVector>::getParameters() const
+{
+    SmoothedAggregationAMG::Parameters parameters;
+    parameters.strengthThreshold = d_strengthThreshold.getValue();
+    parameters.maxLevels = std::max(d_maxLevels.getValue(), 1u);
+    parameters.coarsestSize = d_coarsestSize.getValue();
+    parameters.nbSmoothingSteps = d_nbSmoothingSteps.getValue();
+    parameters.smootherDamping = d_smootherDamping.getValue();
+    parameters.prolongationDamping = d_prolongationDamping.getValue();
+    return parameters;
+}
+
+template<class TMatrix, class TVector>
+simulation::TaskScheduler* SmoothedAggregationAMGPreconditioner<TMatrix,TVector>::getTaskScheduler() const
+{
+    if (!d_parallel.getValue())
+    {
+        return nullptr;
+    }
+    simulation::TaskScheduler* taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    return taskScheduler && taskScheduler->getThreadCount() > 1 ? taskScheduler : nullptr;
+}
+
+template<class TMatrix, class TVector>
+void SmoothedAggregationAMGPreconditioner<TMatrix,TVector>::convertMatrix(Matrix& M, BlockCSRMatrix& matrix)
+{
+    M.compress();
+
+    const auto& rowIndex = M.getRowIndex();
+    const auto& rowBegin = M.getRowBegin();
+    const auto& colsIndex = M.getColsIndex();
+    const auto& colsValue = M.getColsValue();
+
+    matrix.nbRows = static_cast<int>(M.rowBSize());
+    matrix.nbCols = static_cast<int>(M.colBSize());
+    matrix.rowBegin.assign(matrix.nbRows + 1, 0);
+    matrix.colIndex.resize(colsIndex.size());
+    matrix.values.resize(colsValue.size());
+
+    // only the non-empty rows are stored in M
+    for (std::size_t r = 0; r < rowIndex.size(); ++r)
+    {
+        matrix.rowBegin[rowIndex[r] + 1] = rowBegin[r + 1] - rowBegin[r];
+    }
+    for (int i = 0; i < matrix.nbRows; ++i)
+    {
+        matrix.rowBegin[i + 1] += matrix.rowBegin[i];
+    }
+
+    for (std::size_t k = 0; k < colsIndex.size(); ++k)
+    {
+        matrix.colIndex[k] = static_cast<int>(colsIndex[k]);
+        matrix.values[k] = colsValue[k];
+    }
+}
+
+template<class TMatrix, class TVector>
+void SmoothedAggregationAMGPreconditioner<TMatrix,TVector>::invert(Matrix& M)
+{
+    auto* data = static_cast<SmoothedAggregationAMGInvertData*>(this->getMatrixInvertData(&M));
+
+    BlockCSRMatrix matrix;
+    convertMatrix(M, matrix);
+
+    simulation::TaskScheduler* taskScheduler = getTaskScheduler();
+    const auto parameters = getParameters();
+
+    if (data->amg.isBuilt() && matrix.hasSamePattern(data->matrix) && data->amg.getParameters() == parameters)
+    {
+        SCOPED_TIMER_VARNAME(updateTimer, "AMGUpdate");
+        data->amg.update(matrix, taskScheduler);
+    }
+    else
+    {
+        SCOPED_TIMER_VARNAME(buildTimer, "AMGBuild");
+        data->amg.build(matrix, parameters, taskScheduler);
+
+        d_nbLevels.setValue(static_cast<unsigned int>(data->amg.getNbLevels()));
+        d_operatorComplexity.setValue(data->amg.getOperatorComplexity());
+        msg_info() << "Multigrid hierarchy built with " << data->amg.getNbLevels()
+                   << " levels, operator complexity " << data->amg.getOperatorComplexity();
+    }
+
+    data->matrix = std::move(matrix);
+}
+
+template<class TMatrix, class TVector>
+void SmoothedAggregationAMGPreconditioner<TMatrix,TVector>::solve(Matrix& M, Vector& z, Vector& r)
+{
+    auto* data = static_cast<SmoothedAggregationAMGInvertData*>(this->getMatrixInvertData(&M));
+    data->amg.apply(r.ptr(), z.ptr(), getTaskScheduler());
+}
+
+} // namespace sofa::component::linearsolver::preconditioner
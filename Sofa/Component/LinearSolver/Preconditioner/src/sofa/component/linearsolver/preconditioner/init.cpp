@@ -27,11 +27,13 @@ namespace sofa::component::linearsolver::preconditioner
 {
 
 extern void registerBlockJacobiPreconditioner(sofa::core::ObjectFactory* factory);
+extern void registerIncompleteCholeskyPreconditioner(sofa::core::ObjectFactory* factory);
 extern void registerJacobiPreconditioner(sofa::core::ObjectFactory* factory);
 extern void registerPrecomputedMatrixSystem(sofa::core::ObjectFactory* factory);
 extern void registerPrecomputedWarpPreconditioner(sofa::core::ObjectFactory* factory);
 extern void registerRotationMatrixSystem(sofa::core::ObjectFactory* factory);
 extern void registerSSORPreconditioner(sofa::core::ObjectFactory* factory);
+extern void registerSmoothedAggregationAMGPreconditioner(sofa::core::ObjectFactory* factory);
 extern void registerWarpPreconditioner(sofa::core::ObjectFactory* factory);
 
 extern "C" {
@@ -59,11 +61,13 @@ const char* getModuleVersion()
 void registerObjects(sofa::core::ObjectFactory* factory)
 {
     registerBlockJacobiPreconditioner(factory);
+    registerIncompleteCholeskyPreconditioner(factory);
     registerJacobiPreconditioner(factory);
     registerPrecomputedMatrixSystem(factory);
     registerPrecomputedWarpPreconditioner(factory);
     registerRotationMatrixSystem(factory);
     registerSSORPreconditioner(factory);
+    registerSmoothedAggregationAMGPreconditioner(factory);
     registerWarpPreconditioner(factory);
 }
 
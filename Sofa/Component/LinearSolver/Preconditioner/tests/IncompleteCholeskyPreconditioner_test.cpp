@@ -0,0 +1,199 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/testing/BaseTest.h>
+#include <sofa/component/linearsolver/preconditioner/IncompleteCholeskyPreconditioner.h>
+#include <sofa/core/behavior/BaseOrderingMethod.h>
+
+#include <numeric>
+
+namespace sofa
+{
+
+namespace
+{
+
+using Matrix = linearalgebra::CompressedRowSparseMatrix<SReal>;
+using Vector = linearalgebra::FullVector<SReal>;
+using Preconditioner = component::linearsolver::preconditioner::IncompleteCholeskyPreconditioner<Matrix, Vector>;
+
+/// Identity permutation, counting the number of times it is computed
+class CountingOrderingMethod : public core::behavior::BaseOrderingMethod
+{
+public:
+    SOFA_CLASS(CountingOrderingMethod, core::behavior::BaseOrderingMethod);
+
+    unsigned int nbPermutations { 0 };
+
+    void computePermutation(const SparseMatrixPattern& pattern, int* permutation, int* inversePermutation) override
+    {
+        ++nbPermutations;
+        std::iota(permutation, permutation + pattern.matrixSize, 0);
+        std::iota(inversePermutation, inversePermutation + pattern.matrixSize, 0);
+    }
+
+    std::string methodName() const override { return "Counting"; }
+};
+
+/// 1D Laplacian with a small mass on each node, scaled by scale. Its incomplete factorization is exact.
+void fillTridiagonal(Matrix& M, const int n, const SReal scale)
+{
+    M.resize(n, n);
+    for (int i = 0; i < n; ++i)
+    {
+        M.add(i, i, scale * 2.01_sreal);
+        if (i > 0)
+        {
+            M.add(i, i - 1, -scale);
+        }
+        if (i + 1 < n)
+        {
+            M.add(i, i + 1, -scale);
+        }
+    }
+    M.compress();
+}
+
+/// Residual of M z = r, in infinity norm
+SReal residual(const Matrix& M, const Vector& z, const Vector& r)
+{
+    SReal norm = 0;
+    for (Matrix::Index i = 0; i < M.rowSize(); ++i)
+    {
+        SReal value = -r[i];
+        for (Matrix::Index j = 0; j < M.colSize(); ++j)
+        {
+            value += M.element(i, j) * z[j];
+        }
+        norm = std::max(norm, std::abs(value));
+    }
+    return norm;
+}
+
+struct IncompleteCholeskyPreconditioner_test : public testing::BaseTest
+{
+    static constexpr int n = 10;
+
+    Preconditioner::SPtr preconditioner;
+    CountingOrderingMethod::SPtr orderingMethod;
+    Vector r, z;
+
+    void SetUp() override
+    {
+        orderingMethod = core::objectmodel::New<CountingOrderingMethod>();
+        preconditioner = core::objectmodel::New<Preconditioner>();
+        preconditioner->l_orderingMethod.set(orderingMethod.get());
+
+        r.resize(n);
+        z.resize(n);
+        for (int i = 0; i < n; ++i)
+        {
+            r[i] = static_cast<SReal>(i % 3) - 1_sreal;
+        }
+    }
+};
+
+}
+
+TEST_F(IncompleteCholeskyPreconditioner_test, patternIsReused)
+{
+    Matrix M;
+    fillTridiagonal(M, n, 1);
+    preconditioner->invert(M);
+    EXPECT_EQ(orderingMethod->nbPermutations, 1u);
+    EXPECT_EQ(preconditioner->d_L_nnz.getValue(), 2 * n - 1);
+
+    // same pattern, other values: only the numeric factorization is computed
+    fillTridiagonal(M, n, 3);
+    preconditioner->invert(M);
+    EXPECT_EQ(orderingMethod->nbPermutations, 1u);
+    preconditioner->solve(M, z, r);
+    EXPECT_LT(residual(M, z, r), 1e-12);
+
+    // other level of fill
+    preconditioner->d_fillLevel.setValue(1);
+    preconditioner->invert(M);
+    EXPECT_EQ(orderingMethod->nbPermutations, 2u);
+
+    // other pattern
+    M.add(0, n - 1, -0.5_sreal);
+    M.add(n - 1, 0, -0.5_sreal);
+    M.compress();
+    preconditioner->invert(M);
+    EXPECT_EQ(orderingMethod->nbPermutations, 3u);
+    EXPECT_GT(preconditioner->d_L_nnz.getValue(), 2 * n - 1);
+}
+
+TEST_F(IncompleteCholeskyPreconditioner_test, updateStep)
+{
+    preconditioner->d_updateStep.setValue(3);
+
+    Matrix M;
+    fillTridiagonal(M, n, 1);
+    preconditioner->invert(M);
+    preconditioner->solve(M, z, r);
+    EXPECT_LT(residual(M, z, r), 1e-12);
+
+    Matrix initialM;
+    fillTridiagonal(initialM, n, 1);
+
+    // the factorization of the first matrix is used for the next two assemblies
+    fillTridiagonal(M, n, 2);
+    for (unsigned int step = 1; step < 3; ++step)
+    {
+        preconditioner->invert(M);
+        preconditioner->solve(M, z, r);
+        EXPECT_LT(residual(initialM, z, r), 1e-12) << "step " << step;
+    }
+
+    // the third assembly is factorized
+    preconditioner->invert(M);
+    preconditioner->solve(M, z, r);
+    EXPECT_LT(residual(M, z, r), 1e-12);
+    EXPECT_EQ(orderingMethod->nbPermutations, 1u);
+}
+
+TEST_F(IncompleteCholeskyPreconditioner_test, shiftWarningIsEmittedOnce)
+{
+    // slightly indefinite: the factorization breaks down without a shift
+    Matrix M;
+    M.resize(3, 3);
+    M.add(0, 0, 1.);
+    M.add(0, 1, 1.05);
+    M.add(1, 0, 1.05);
+    M.add(1, 1, 1.);
+    M.add(2, 2, 1.);
+    M.compress();
+
+    {
+        EXPECT_MSG_EMIT(Warning);
+        preconditioner->invert(M);
+    }
+    EXPECT_GT(preconditioner->d_shift.getValue(), 0);
+
+    {
+        EXPECT_MSG_NOEMIT(Warning);
+        preconditioner->invert(M);
+    }
+    EXPECT_GT(preconditioner->d_shift.getValue(), 0);
+}
+
+}
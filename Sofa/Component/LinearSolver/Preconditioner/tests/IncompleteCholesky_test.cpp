@@ -0,0 +1,266 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <sofa/component/linearsolver/preconditioner/IncompleteCholesky.h>
+
+#include <cmath>
+#include <numeric>
+
+namespace sofa
+{
+
+using component::linearsolver::preconditioner::IncompleteCholesky;
+
+namespace
+{
+
+/// Matrix in CSR format, with both its lower and upper triangles
+struct CSRMatrix
+{
+    int n { 0 };
+    std::vector<int> rowBegin { 0 };
+    std::vector<int> colIndex;
+    std::vector<SReal> values;
+
+    std::vector<SReal> mul(const std::vector<SReal>& x) const
+    {
+        std::vector<SReal> y(n, 0);
+        for (int i = 0; i < n; ++i)
+        {
+            for (int p = rowBegin[i]; p < rowBegin[i + 1]; ++p)
+            {
+                y[i] += values[p] * x[colIndex[p]];
+            }
+        }
+        return y;
+    }
+};
+
+/// 7-point Laplacian on a grid, with a small mass on each node
+CSRMatrix createLaplacian(const int size, const SReal scale)
+{
+    CSRMatrix A;
+    A.n = size * size * size;
+    const auto index = [size](int x, int y, int z) { return x + size * (y + size * z); };
+    for (int z = 0; z < size; ++z)
+    {
+        for (int y = 0; y < size; ++y)
+        {
+            for (int x = 0; x < size; ++x)
+            {
+                const int i = index(x, y, z);
+                std::vector<int> row;
+                if (z > 0) row.push_back(index(x, y, z - 1));
+                if (y > 0) row.push_back(index(x, y - 1, z));
+                if (x > 0) row.push_back(index(x - 1, y, z));
+                row.push_back(i);
+                if (x + 1 < size) row.push_back(index(x + 1, y, z));
+                if (y + 1 < size) row.push_back(index(x, y + 1, z));
+                if (z + 1 < size) row.push_back(index(x, y, z + 1));
+
+                for (const int j : row)
+                {
+                    A.colIndex.push_back(j);
+                    A.values.push_back(scale * (j == i ? static_cast<SReal>(row.size() - 1) + 1e-2_sreal : -1_sreal));
+                }
+                A.rowBegin.push_back(static_cast<int>(A.colIndex.size()));
+            }
+        }
+    }
+    return A;
+}
+
+std::vector<int> identityPermutation(const int n)
+{
+    std::vector<int> perm(n);
+    std::iota(perm.begin(), perm.end(), 0);
+    return perm;
+}
+
+SReal dot(const std::vector<SReal>& a, const std::vector<SReal>& b)
+{
+    return std::inner_product(a.begin(), a.end(), b.begin(), 0_sreal);
+}
+
+/// Preconditioned conjugate gradient. Return the number of iterations to reach the tolerance.
+unsigned int solveWithPCG(const CSRMatrix& A, const std::vector<SReal>& b, const IncompleteCholesky* preconditioner)
+{
+    const auto n = static_cast<std::size_t>(A.n);
+    std::vector<SReal> x(n, 0), r = b, z(n), p(n);
+    const auto precondition = [&]()
+    {
+        if (preconditioner) preconditioner->solve(r.data(), z.data());
+        else z = r;
+    };
+
+    precondition();
+    p = z;
+    SReal rz = dot(r, z);
+    const SReal tolerance = 1e-8_sreal * std::sqrt(dot(b, b));
+    for (unsigned int it = 1; it <= 1000; ++it)
+    {
+        const auto Ap = A.mul(p);
+        const SReal alpha = rz / dot(p, Ap);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * Ap[i];
+        }
+        if (std::sqrt(dot(r, r)) < tolerance)
+        {
+            return it;
+        }
+        precondition();
+        const SReal rzNew = dot(r, z);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            p[i] = z[i] + rzNew / rz * p[i];
+        }
+        rz = rzNew;
+    }
+    return 1000;
+}
+
+} // namespace
+
+TEST(IncompleteCholesky, tridiagonalIsExact)
+{
+    // IC(0) of a tridiagonal matrix is its complete factorization
+    const int n = 50;
+    CSRMatrix A;
+    A.n = n;
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = std::max(0, i - 1); j <= std::min(n - 1, i + 1); ++j)
+        {
+            A.colIndex.push_back(j);
+            A.values.push_back(j == i ? 4 : -1);
+        }
+        A.rowBegin.push_back(static_cast<int>(A.colIndex.size()));
+    }
+
+    // reversed ordering
+    std::vector<int> perm(n);
+    for (int i = 0; i < n; ++i)
+    {
+        perm[i] = n - 1 - i;
+    }
+
+    IncompleteCholesky ic;
+    ic.analyze(n, A.rowBegin.data(), A.colIndex.data(), perm.data(), perm.data(), 0);
+    ASSERT_TRUE(ic.factorize(A.values.data()));
+    EXPECT_EQ(ic.getNbNonZeros(), 2 * n - 1);
+    EXPECT_EQ(ic.getShift(), 0);
+
+    std::vector<SReal> expected(n);
+    for (int i = 0; i < n; ++i)
+    {
+        expected[i] = std::cos(static_cast<SReal>(i));
+    }
+    const auto b = A.mul(expected);
+    std::vector<SReal> x(n);
+    ic.solve(b.data(), x.data());
+
+    for (int i = 0; i < n; ++i)
+    {
+        EXPECT_NEAR(x[i], expected[i], 1e-12);
+    }
+}
+
+TEST(IncompleteCholesky, fillLevel)
+{
+    const CSRMatrix A = createLaplacian(12, 1);
+    const auto perm = identityPermutation(A.n);
+    std::vector<SReal> b(A.n);
+    for (int i = 0; i < A.n; ++i)
+    {
+        b[i] = std::sin(static_cast<SReal>(i));
+    }
+
+    const auto nbIterationsCG = solveWithPCG(A, b, nullptr);
+
+    std::size_t previousNbNonZeros = 0;
+    unsigned int previousNbIterations = nbIterationsCG;
+    for (unsigned int fillLevel = 0; fillLevel < 3; ++fillLevel)
+    {
+        IncompleteCholesky ic;
+        ic.analyze(A.n, A.rowBegin.data(), A.colIndex.data(), perm.data(), perm.data(), fillLevel);
+        ASSERT_TRUE(ic.factorize(A.values.data()));
+
+        if (fillLevel == 0)
+        {
+            // no fill-in: same number of entries as the upper triangle of A
+            EXPECT_EQ(ic.getNbNonZeros(), (A.colIndex.size() + A.n) / 2);
+        }
+        EXPECT_GT(ic.getNbNonZeros(), previousNbNonZeros);
+
+        const auto nbIterations = solveWithPCG(A, b, &ic);
+        EXPECT_LT(nbIterations, previousNbIterations);
+
+        previousNbNonZeros = ic.getNbNonZeros();
+        previousNbIterations = nbIterations;
+    }
+    EXPECT_LT(3 * previousNbIterations, nbIterationsCG);
+}
+
+TEST(IncompleteCholesky, refactorization)
+{
+    const CSRMatrix A = createLaplacian(6, 1);
+    const CSRMatrix A2 = createLaplacian(6, 3);
+    const auto perm = identityPermutation(A.n);
+
+    IncompleteCholesky refactorized;
+    refactorized.analyze(A.n, A.rowBegin.data(), A.colIndex.data(), perm.data(), perm.data(), 1);
+    ASSERT_TRUE(refactorized.factorize(A.values.data()));
+    ASSERT_TRUE(refactorized.factorize(A2.values.data()));
+
+    IncompleteCholesky factorized;
+    factorized.analyze(A2.n, A2.rowBegin.data(), A2.colIndex.data(), perm.data(), perm.data(), 1);
+    ASSERT_TRUE(factorized.factorize(A2.values.data()));
+
+    const std::vector<SReal> b(A.n, 1);
+    std::vector<SReal> x1(A.n), x2(A.n);
+    refactorized.solve(b.data(), x1.data());
+    factorized.solve(b.data(), x2.data());
+    for (int i = 0; i < A.n; ++i)
+    {
+        EXPECT_DOUBLE_EQ(x1[i], x2[i]);
+    }
+}
+
+TEST(IncompleteCholesky, diagonalShift)
+{
+    // slightly indefinite: the factorization breaks down without a shift
+    CSRMatrix A;
+    A.n = 3;
+    A.rowBegin = { 0, 2, 4, 5 };
+    A.colIndex = { 0, 1, 0, 1, 2 };
+    A.values = { 1, 1.05, 1.05, 1, 1 };
+
+    const auto perm = identityPermutation(A.n);
+    IncompleteCholesky ic;
+    ic.analyze(A.n, A.rowBegin.data(), A.colIndex.data(), perm.data(), perm.data(), 0);
+    EXPECT_TRUE(ic.factorize(A.values.data()));
+    EXPECT_GT(ic.getShift(), 0);
+}
+
+} // namespace sofa
@@ -0,0 +1,263 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <sofa/component/linearsolver/preconditioner/SmoothedAggregationAMG.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+
+namespace sofa
+{
+
+using component::linearsolver::preconditioner::BlockCSRMatrix;
+using component::linearsolver::preconditioner::SmoothedAggregationAMG;
+
+namespace
+{
+
+/**
+ * Stiffness matrix of a grid of nodes connected to their 6 neighbors by anisotropic springs,
+ * and a small mass on each node
+ */
+BlockCSRMatrix createGridMatrix(const int size, const SReal stiffness)
+{
+    const auto nodeIndex = [size](int x, int y, int z) { return x + size * (y + size * z); };
+
+    const int n = size * size * size;
+    BlockCSRMatrix A;
+    A.nbRows = A.nbCols = n;
+    A.rowBegin.push_back(0);
+
+    for (int z = 0; z < size; ++z)
+    {
+        for (int y = 0; y < size; ++y)
+        {
+            for (int x = 0; x < size; ++x)
+            {
+                const int i = nodeIndex(x, y, z);
+
+                BlockCSRMatrix::Block diagonal = BlockCSRMatrix::Block::Identity() * (1e-2_sreal * stiffness);
+                std::vector<std::pair<int, BlockCSRMatrix::Block> > row;
+
+                const int neighbors[6][3] = { {-1,0,0}, {1,0,0}, {0,-1,0}, {0,1,0}, {0,0,-1}, {0,0,1} };
+                for (const auto& d : neighbors)
+                {
+                    const int nx = x + d[0], ny = y + d[1], nz = z + d[2];
+                    if (nx < 0 || ny < 0 || nz < 0 || nx >= size || ny >= size || nz >= size)
+                    {
+                        continue;
+                    }
+
+                    // K = k (I + u u^T), u being the direction of the spring
+                    BlockCSRMatrix::Block K = BlockCSRMatrix::Block::Identity();
+                    for (int r = 0; r < 3; ++r)
+                    {
+                        K[r][r] += static_cast<SReal>(d[r] * d[r]);
+                    }
+                    K *= stiffness;
+
+                    diagonal += K;
+                    row.emplace_back(nodeIndex(nx, ny, nz), -K);
+                }
+                row.emplace_back(i, diagonal);
+
+                std::sort(row.begin(), row.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+                for (const auto& [j, block] : row)
+                {
+                    A.colIndex.push_back(j);
+                    A.values.push_back(block);
+                }
+                A.rowBegin.push_back(static_cast<int>(A.colIndex.size()));
+            }
+        }
+    }
+    return A;
+}
+
+SReal dot(const std::vector<SReal>& a, const std::vector<SReal>& b)
+{
+    return std::inner_product(a.begin(), a.end(), b.begin(), 0_sreal);
+}
+
+/// Preconditioned conjugate gradient. Return the number of iterations to reach the tolerance.
+unsigned int solveWithPCG(const BlockCSRMatrix& A, const std::vector<SReal>& b, std::vector<SReal>& x,
+                          const std::function<void(const std::vector<SReal>&, std::vector<SReal>&)>& precondition)
+{
+    const auto size = b.size();
+    x.assign(size, 0);
+    std::vector<SReal> r = b, z(size), p(size), Ap(size);
+
+    precondition(r, z);
+    p = z;
+    SReal rz = dot(r, z);
+    const SReal tolerance = 1e-8_sreal * std::sqrt(dot(b, b));
+
+    for (unsigned int it = 1; it <= 1000; ++it)
+    {
+        A.mul(p.data(), Ap.data(), nullptr);
+        const SReal alpha = rz / dot(p, Ap);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * Ap[i];
+        }
+        if (std::sqrt(dot(r, r)) < tolerance)
+        {
+            return it;
+        }
+
+        precondition(r, z);
+        const SReal rzNew = dot(r, z);
+        const SReal beta = rzNew / rz;
+        rz = rzNew;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            p[i] = z[i] + beta * p[i];
+        }
+    }
+    return 1000;
+}
+
+std::vector<SReal> createVector(const std::size_t size, const unsigned int seed)
+{
+    std::vector<SReal> v(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        v[i] = std::sin(static_cast<SReal>((i + 1) * (seed + 1)));
+    }
+    return v;
+}
+
+} // namespace
+
+TEST(SmoothedAggregationAMG, hierarchy)
+{
+    const BlockCSRMatrix A = createGridMatrix(12, 1e3_sreal);
+
+    SmoothedAggregationAMG amg;
+    amg.build(A, {}, nullptr);
+
+    ASSERT_GE(amg.getNbLevels(), 2);
+    for (std::size_t l = 1; l < amg.getNbLevels(); ++l)
+    {
+        EXPECT_LT(amg.getMatrix(l).nbRows, amg.getMatrix(l - 1).nbRows);
+        EXPECT_EQ(amg.getMatrix(l).nbRows, amg.getMatrix(l).nbCols);
+    }
+    EXPECT_EQ(amg.getAggregates(0).size(), A.nbRows);
+    EXPECT_GT(amg.getOperatorComplexity(), 1);
+    EXPECT_LT(amg.getOperatorComplexity(), 2);
+}
+
+TEST(SmoothedAggregationAMG, convergence)
+{
+    const BlockCSRMatrix A = createGridMatrix(12, 1e3_sreal);
+    const auto b = createVector(3 * A.nbRows, 0);
+
+    SmoothedAggregationAMG amg;
+    amg.build(A, {}, nullptr);
+
+    std::vector<SReal> x;
+    const auto nbIterationsCG = solveWithPCG(A, b, x, [](const auto& r, auto& z) { z = r; });
+    const auto nbIterationsAMG = solveWithPCG(A, b, x, [&amg](const auto& r, auto& z) { amg.apply(r.data(), z.data(), nullptr); });
+
+    EXPECT_LT(nbIterationsAMG, 30);
+    EXPECT_LT(2 * nbIterationsAMG, nbIterationsCG);
+
+    std::vector<SReal> Ax(b.size());
+    A.mul(x.data(), Ax.data(), nullptr);
+    for (std::size_t i = 0; i < b.size(); ++i)
+    {
+        EXPECT_NEAR(Ax[i], b[i], 1e-5);
+    }
+}
+
+TEST(SmoothedAggregationAMG, symmetry)
+{
+    const BlockCSRMatrix A = createGridMatrix(10, 1e3_sreal);
+
+    SmoothedAggregationAMG amg;
+    amg.build(A, {}, nullptr);
+
+    const auto u = createVector(3 * A.nbRows, 1);
+    const auto v = createVector(3 * A.nbRows, 2);
+    std::vector<SReal> Mu(u.size()), Mv(v.size());
+    amg.apply(u.data(), Mu.data(), nullptr);
+    amg.apply(v.data(), Mv.data(), nullptr);
+
+    EXPECT_NEAR(dot(v, Mu), dot(u, Mv), 1e-10 * std::abs(dot(u, Mv)));
+    EXPECT_GT(dot(u, Mu), 0);
+}
+
+TEST(SmoothedAggregationAMG, updateMatchesBuild)
+{
+    const BlockCSRMatrix A = createGridMatrix(10, 1e3_sreal);
+    const BlockCSRMatrix A2 = createGridMatrix(10, 2.5e3_sreal);
+    ASSERT_TRUE(A.hasSamePattern(A2));
+
+    SmoothedAggregationAMG updated;
+    updated.build(A, {}, nullptr);
+    updated.update(A2, nullptr);
+
+    SmoothedAggregationAMG built;
+    built.build(A2, {}, nullptr);
+
+    ASSERT_EQ(updated.getNbLevels(), built.getNbLevels());
+
+    const auto b = createVector(3 * A.nbRows, 3);
+    std::vector<SReal> x1(b.size()), x2(b.size());
+    updated.apply(b.data(), x1.data(), nullptr);
+    built.apply(b.data(), x2.data(), nullptr);
+
+    for (std::size_t i = 0; i < b.size(); ++i)
+    {
+        EXPECT_NEAR(x1[i], x2[i], 1e-10);
+    }
+}
+
+TEST(SmoothedAggregationAMG, parallelMatchesSequential)
+{
+    simulation::TaskScheduler* taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    ASSERT_NE(taskScheduler, nullptr);
+    taskScheduler->init(4);
+
+    const BlockCSRMatrix A = createGridMatrix(10, 1e3_sreal);
+    const auto b = createVector(3 * A.nbRows, 4);
+
+    SmoothedAggregationAMG sequential;
+    sequential.build(A, {}, nullptr);
+    std::vector<SReal> x1(b.size()), x2(b.size());
+    sequential.apply(b.data(), x1.data(), nullptr);
+
+    SmoothedAggregationAMG parallel;
+    parallel.build(A, {}, taskScheduler);
+    parallel.apply(b.data(), x2.data(), taskScheduler);
+
+    for (std::size_t i = 0; i < b.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(x1[i], x2[i]);
+    }
+}
+
+} // namespace sofa
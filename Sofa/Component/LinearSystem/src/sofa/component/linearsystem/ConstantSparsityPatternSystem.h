@@ -24,6 +24,7 @@
 #include <sofa/component/linearsystem/config.h>
 #include <sofa/component/linearsystem/MatrixLinearSystem.h>
 #include <sofa/linearalgebra/CompressedRowSparseMatrix.h>
+#include <sofa/simulation/TaskScheduler.h>
 
 namespace sofa::component::linearsystem
 {
@@ -52,6 +53,16 @@ class SparsityPatternLocalMappedMatrix;
  * Second time step and after:
  * 1) The local matrices assume the order of insertion did not change. Therefore, they rely only on the ordered list of
  * ids to know where in the values array to insert the matrix contribution. The row and column ids are useless.
+ *
+ * Parallel assembly (optional):
+ * The local matrices of the non-mapped states write their values in their own buffer, following the insertion order,
+ * instead of adding them into the global matrix. The components are then independent and build their matrices in
+ * parallel. The buffers are finally gathered into the compressed values: each thread owns a range of the compressed
+ * values and sums all the buffer values associated to it. No atomic operation nor lock is required, and the result
+ * does not depend on the number of threads.
+ * The parallelism is only across components: the matrix of a single component is built by a single thread, and the
+ * components involving mapped states are built sequentially. If a local matrix of a non-mapped state cannot write in
+ * a buffer, the whole assembly falls back to the sequential mode.
  */
 template<class TMatrix, class TVector>
 class SOFA_COMPONENT_LINEARSYSTEM_API ConstantSparsityPatternSystem : public MatrixLinearSystem<TMatrix, TVector >
@@ -73,14 +84,30 @@ public:
 
     bool isConstantSparsityPatternUsedYet() const;
 
+    Data< bool > d_parallelAssembly; ///< If true, once the sparsity pattern is known, the components build their local matrices in parallel
+
 protected:
 
     void preAssembleSystem(const core::MechanicalParams* /*mparams*/) override;
+    void buildMatrices(const core::MechanicalParams* mparams) override;
 
     bool m_isConstantSparsityPatternUsedYet { false };
     std::unique_ptr<ConstantCRSMapping> m_constantCRSMapping;
     sofa::type::vector<ConstantCRSMapping> m_constantCRSMappingMappedMatrices;
 
+    bool m_isParallelAssemblyInitialized { false };
+
+    /// False if a local matrix of a non-mapped state cannot write in a buffer
+    bool m_isParallelAssemblySupported { false };
+
+    /// Buffers of all the local matrices of the non-mapped states, concatenated
+    sofa::type::vector<Real> m_localValues;
+
+    /// For each value of the compressed global matrix, the list of indices in m_localValues contributing to this
+    /// value. It is stored in a CSR format.
+    sofa::type::vector<std::size_t> m_gatherBegin;
+    sofa::type::vector<std::size_t> m_gatherIndices;
+
 
     ConstantSparsityPatternSystem();
 
@@ -108,6 +135,23 @@ protected:
     template<core::matrixaccumulator::Contribution c>
     void reinitLocalMatrices(LocalMatrixMaps<c, Real>& matrixMaps);
 
+    /// Apply f on the ConstantLocalMatrix of the non-mapped states, and return false if another type of local matrix is found
+    template<core::matrixaccumulator::Contribution c, class F>
+    bool forEachNonMappedConstantLocalMatrix(LocalMatrixMaps<c, Real>& matrixMaps, F f);
+
+    /// Allocate the buffers of the local matrices and build the list of buffer values for each compressed value
+    void initializeParallelAssembly();
+
+    /// The local matrices add their values into the global matrix again
+    void releaseParallelAssembly();
+
+    template<core::matrixaccumulator::Contribution c, class TComponent, class TLocalMatrix>
+    void parallelContribute(simulation::TaskScheduler& taskScheduler, const core::MechanicalParams* mparams,
+                            std::map<TComponent*, TLocalMatrix>& contributors);
+
+    /// Sum the buffers of the local matrices into the compressed values of the global matrix
+    void gatherLocalValues(simulation::TaskScheduler& taskScheduler);
+
 
     static void buildHashTable(linearalgebra::CompressedRowSparseMatrix<SReal>& M, ConstantCRSMapping& mapping);
 
@@ -25,6 +25,9 @@
 #include <sofa/component/linearsystem/matrixaccumulators/SparsityPatternLocalMappedMatrix.h>
 #include <sofa/component/linearsystem/matrixaccumulators/ConstantLocalMappedMatrix.h>
 #include <sofa/helper/narrow_cast.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/ParallelForEach.h>
+#include <numeric>
 
 namespace sofa::component::linearsystem
 {
@@ -95,6 +98,9 @@ using StrategyCheckerType = sofa::core::matrixaccumulator::CompositeIndexVerific
 template<class TMatrix, class TVector>
 ConstantSparsityPatternSystem<TMatrix, TVector>::ConstantSparsityPatternSystem()
     : Inherit1()
+    , d_parallelAssembly(initData(&d_parallelAssembly, false, "parallelAssembly",
+        "If true, once the sparsity pattern is known, the components build their local matrices in parallel. "
+        "Each local matrix writes in its own buffer, then the buffers are gathered into the global matrix."))
 {
 }
 
@@ -317,6 +323,40 @@ void ConstantSparsityPatternSystem<TMatrix, TVector>::reinitLocalMatrices(LocalM
     }
 }
 
+template<class TMatrix, class TVector>
+template <core::matrixaccumulator::Contribution c, class F>
+bool ConstantSparsityPatternSystem<TMatrix, TVector>::forEachNonMappedConstantLocalMatrix(
+    LocalMatrixMaps<c, Real>& matrixMaps, F f)
+{
+    bool allConstant = true;
+    for (auto& [component, localMatrixMap] : matrixMaps.componentLocalMatrix)
+    {
+        for (auto& [states, localMatrix] : localMatrixMap)
+        {
+            const bool isMapped0 = this->getMappingGraph().hasAnyMappingInput(states[0]);
+            const bool isMapped1 = this->getMappingGraph().hasAnyMappingInput(states[1]);
+            if (isMapped0 || isMapped1)
+            {
+                continue;
+            }
+
+            if (auto* local = dynamic_cast<ConstantLocalMatrix<TMatrix, c>* >(localMatrix))
+            {
+                f(*local);
+            }
+            else if (auto* localWithCheck = dynamic_cast<ConstantLocalMatrix<TMatrix, c, StrategyCheckerType>* >(localMatrix))
+            {
+                f(*localWithCheck);
+            }
+            else
+            {
+                allConstant = false;
+            }
+        }
+    }
+    return allConstant;
+}
+
 template<class TMatrix, class TVector>
 void ConstantSparsityPatternSystem<TMatrix, TVector>::buildHashTable(linearalgebra::CompressedRowSparseMatrix<SReal>& M, ConstantCRSMapping& mapping)
 {
@@ -468,6 +508,250 @@ void ConstantSparsityPatternSystem<TMatrix, TVector>::preAssembleSystem(const co
     }
 }
 
+template<class TMatrix, class TVector>
+void ConstantSparsityPatternSystem<TMatrix, TVector>::initializeParallelAssembly()
+{
+    SCOPED_TIMER("initializeParallelAssembly");
+
+    struct BufferedLocalMatrix
+    {
+        const sofa::type::vector<std::size_t>* compressedInsertionOrderList { nullptr };
+        Real** localValues { nullptr };
+        std::size_t offset {};
+    };
+
+    sofa::type::vector<BufferedLocalMatrix> localMatrices;
+    std::size_t bufferSize {};
+
+    const auto collect = [&localMatrices, &bufferSize](auto& local)
+    {
+        localMatrices.push_back({&local.compressedInsertionOrderList, &local.localValues, bufferSize});
+        bufferSize += local.compressedInsertionOrderList.size();
+    };
+    bool allConstant = forEachNonMappedConstantLocalMatrix(this->template getLocalMatrixMap<Contribution::STIFFNESS>(), collect);
+    allConstant &= forEachNonMappedConstantLocalMatrix(this->template getLocalMatrixMap<Contribution::MASS>(), collect);
+    allConstant &= forEachNonMappedConstantLocalMatrix(this->template getLocalMatrixMap<Contribution::DAMPING>(), collect);
+    allConstant &= forEachNonMappedConstantLocalMatrix(this->template getLocalMatrixMap<Contribution::GEOMETRIC_STIFFNESS>(), collect);
+
+    m_isParallelAssemblyInitialized = true;
+
+    // A local matrix which does not write in a buffer would add its values directly into the global matrix,
+    // concurrently with the other components.
+    m_isParallelAssemblySupported = allConstant;
+    if (!m_isParallelAssemblySupported)
+    {
+        msg_warning() << "Some local matrices do not support the parallel assembly: the assembly is sequential";
+        return;
+    }
+
+    m_localValues.assign(bufferSize, 0_sreal);
+
+    // count the number of buffer values for each compressed value
+    const auto nbCompressedValues = this->getSystemMatrix()->colsValue.size();
+    m_gatherBegin.assign(nbCompressedValues + 1, 0);
+    for (const auto& localMatrix : localMatrices)
+    {
+        for (const auto compressedId : *localMatrix.compressedInsertionOrderList)
+        {
+            ++m_gatherBegin[compressedId + 1];
+        }
+    }
+    std::partial_sum(m_gatherBegin.begin(), m_gatherBegin.end(), m_gatherBegin.begin());
+
+    // the buffer values of a compressed value are sorted in increasing order: the summation order is always the same
+    m_gatherIndices.resize(bufferSize);
+    sofa::type::vector<std::size_t> nextGatherIndex(m_gatherBegin.begin(), m_gatherBegin.end() - 1);
+    for (const auto& localMatrix : localMatrices)
+    {
+        *localMatrix.localValues = m_localValues.data() + localMatrix.offset;
+
+        const auto& compressedInsertionOrderList = *localMatrix.compressedInsertionOrderList;
+        for (std::size_t i = 0; i < compressedInsertionOrderList.size(); ++i)
+        {
+            m_gatherIndices[nextGatherIndex[compressedInsertionOrderList[i]]++] = localMatrix.offset + i;
+        }
+    }
+
+    msg_info() << "Parallel assembly of " << localMatrices.size() << " local matrices: "
+        << bufferSize << " values are gathered into " << nbCompressedValues << " compressed values";
+}
+
+template<class TMatrix, class TVector>
+void ConstantSparsityPatternSystem<TMatrix, TVector>::releaseParallelAssembly()
+{
+    const auto release = [](auto& local) { local.localValues = nullptr; };
+    forEachNonMappedConstantLocalMatrix(this->template getLocalMatrixMap<Contribution::STIFFNESS>(), release);
+    forEachNonMappedConstantLocalMatrix(this->template getLocalMatrixMap<Contribution::MASS>(), release);
+    forEachNonMappedConstantLocalMatrix(this->template getLocalMatrixMap<Contribution::DAMPING>(), release);
+    forEachNonMappedConstantLocalMatrix(this->template getLocalMatrixMap<Contribution::GEOMETRIC_STIFFNESS>(), release);
+
+    m_localValues.clear();
+    m_gatherBegin.clear();
+    m_gatherIndices.clear();
+
+    m_isParallelAssemblyInitialized = false;
+    m_isParallelAssemblySupported = false;
+}
+
+template<class TMatrix, class TVector>
+template<core::matrixaccumulator::Contribution c, class TComponent, class TLocalMatrix>
+void ConstantSparsityPatternSystem<TMatrix, TVector>::parallelContribute(
+    simulation::TaskScheduler& taskScheduler, const core::MechanicalParams* mparams,
+    std::map<TComponent*, TLocalMatrix>& contributors)
+{
+    sofa::type::vector<std::pair<TComponent*, TLocalMatrix*> > tasks;
+    tasks.reserve(contributors.size());
+    for (auto& [component, localMatrix] : contributors)
+    {
+        if constexpr (c == Contribution::MASS)
+        {
+            if (this->getMassObserver(component))
+            {
+                continue;
+            }
+        }
+        if (Inherit1::template getContributionFactor<c>(mparams, component) != 0._sreal)
+        {
+            tasks.emplace_back(component, &localMatrix);
+        }
+    }
+
+    // each component writes only in the buffers of its own local matrices
+    simulation::parallelForEach(taskScheduler, tasks.begin(), tasks.end(),
+        [](const std::pair<TComponent*, TLocalMatrix*>& task)
+        {
+            auto* component = task.first;
+            if constexpr (c == Contribution::STIFFNESS)
+            {
+                component->buildStiffnessMatrix(task.second);
+            }
+            else if constexpr (c == Contribution::MASS)
+            {
+                component->buildMassMatrix(*task.second);
+            }
+            else if constexpr (c == Contribution::DAMPING)
+            {
+                component->buildDampingMatrix(task.second);
+            }
+            else if constexpr (c == Contribution::GEOMETRIC_STIFFNESS)
+            {
+                component->buildGeometricStiffnessMatrix(task.second);
+            }
+        });
+}
+
+template<class TMatrix, class TVector>
+void ConstantSparsityPatternSystem<TMatrix, TVector>::gatherLocalValues(simulation::TaskScheduler& taskScheduler)
+{
+    SCOPED_TIMER("gatherLocalValues");
+
+    auto& values = this->getSystemMatrix()->colsValue;
+    if (m_gatherBegin.size() != values.size() + 1)
+    {
+        msg_error() << "The compressed matrix changed since the initialization of the parallel assembly";
+        return;
+    }
+
+    // each thread owns a range of compressed values: no conflict is possible
+    simulation::parallelForEachRange(taskScheduler, std::size_t{}, values.size(),
+        [this, &values](const auto& range)
+        {
+            for (auto compressedId = range.start; compressedId != range.end; ++compressedId)
+            {
+                Real sum {};
+                for (auto j = m_gatherBegin[compressedId]; j < m_gatherBegin[compressedId + 1]; ++j)
+                {
+                    sum += m_localValues[m_gatherIndices[j]];
+                }
+                values[compressedId] += sum;
+            }
+        });
+}
+
+template<class TMatrix, class TVector>
+void ConstantSparsityPatternSystem<TMatrix, TVector>::buildMatrices(const core::MechanicalParams* mparams)
+{
+    const bool parallelAssembly = d_parallelAssembly.getValue() && isConstantSparsityPatternUsedYet();
+    if (parallelAssembly && !m_isParallelAssemblyInitialized)
+    {
+        initializeParallelAssembly();
+    }
+    else if (!parallelAssembly && m_isParallelAssemblyInitialized)
+    {
+        releaseParallelAssembly();
+    }
+
+    if (!parallelAssembly || !m_isParallelAssemblySupported)
+    {
+        Inherit1::buildMatrices(mparams);
+        return;
+    }
+
+    simulation::TaskScheduler* taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    assert(taskScheduler);
+    if (taskScheduler->getThreadCount() < 1)
+    {
+        taskScheduler->init(0);
+    }
+
+    std::fill(m_localValues.begin(), m_localValues.end(), 0_sreal);
+
+    const bool assembleStiffness = this->d_assembleStiffness.getValue();
+    const bool assembleMass = this->d_assembleMass.getValue();
+    const bool assembleDamping = this->d_assembleDamping.getValue();
+    const bool assembleGeometricStiffness = this->d_assembleGeometricStiffness.getValue();
+
+    for (std::size_t i = 0; i < this->m_independentContributors.size(); ++i)
+    {
+        auto& contributors = this->m_independentContributors[i];
+
+        // The first group contains the components not involving any mapped state. All their local matrices write in
+        // their own buffers, so they can be built concurrently.
+        if (i == 0)
+        {
+            SCOPED_TIMER("parallelBuildNonMapped");
+            if (assembleStiffness)
+            {
+                parallelContribute<Contribution::STIFFNESS>(*taskScheduler, mparams, contributors.m_stiffness);
+            }
+            if (assembleMass)
+            {
+                parallelContribute<Contribution::MASS>(*taskScheduler, mparams, contributors.m_mass);
+            }
+            if (assembleDamping)
+            {
+                parallelContribute<Contribution::DAMPING>(*taskScheduler, mparams, contributors.m_damping);
+            }
+            if (assembleGeometricStiffness)
+            {
+                parallelContribute<Contribution::GEOMETRIC_STIFFNESS>(*taskScheduler, mparams, contributors.m_geometricStiffness);
+            }
+        }
+        else
+        {
+            SCOPED_TIMER("buildMapped");
+            if (assembleStiffness)
+            {
+                this->template contribute<Contribution::STIFFNESS>(mparams, contributors);
+            }
+            if (assembleMass)
+            {
+                this->template contribute<Contribution::MASS>(mparams, contributors);
+            }
+            if (assembleDamping)
+            {
+                this->template contribute<Contribution::DAMPING>(mparams, contributors);
+            }
+            if (assembleGeometricStiffness)
+            {
+                this->template contribute<Contribution::GEOMETRIC_STIFFNESS>(mparams, contributors);
+            }
+        }
+    }
+
+    gatherLocalValues(*taskScheduler);
+}
+
 template<class TMatrix, class TVector>
 void ConstantSparsityPatternSystem<TMatrix, TVector>::makeCreateDispatcher()
 {
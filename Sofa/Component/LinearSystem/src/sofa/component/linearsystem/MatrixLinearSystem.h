@@ -137,6 +137,11 @@ protected:
 
     void assembleSystem(const core::MechanicalParams* mparams) override;
 
+    /**
+     * Let all the contributors add their matrix contributions into their local matrices
+     */
+    virtual void buildMatrices(const core::MechanicalParams* mparams);
+
     /**
      * Gather all components associated to the same mechanical state into groups
      */
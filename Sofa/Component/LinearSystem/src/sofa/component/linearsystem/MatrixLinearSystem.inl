@@ -137,73 +137,78 @@ void MatrixLinearSystem<TMatrix, TVector>::contribute(
     }
 }
 
-template<class TMatrix, class TVector>
-void MatrixLinearSystem<TMatrix, TVector>::assembleSystem(const core::MechanicalParams* mparams)
+template <class TMatrix, class TVector>
+void MatrixLinearSystem<TMatrix, TVector>::buildMatrices(const core::MechanicalParams* mparams)
 {
-    if (this->getSystemMatrix()->rowSize() == 0 || this->getSystemMatrix()->colSize() == 0)
+    simulation::TaskScheduler* taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    assert(taskScheduler);
+
+    if (d_parallelAssemblyIndependentMatrices.getValue() && taskScheduler && taskScheduler->getThreadCount() < 1)
     {
-        msg_error() << "Global system matrix is not resized appropriately (" << this->getPathName() << ")";
-        return;
+        taskScheduler->init(0);
     }
 
-    SCOPED_TIMER_VARNAME(assembleSystemTimer, "AssembleSystem");
+    const simulation::ForEachExecutionPolicy execution = d_parallelAssemblyIndependentMatrices.getValue() ?
+        simulation::ForEachExecutionPolicy::PARALLEL :
+        simulation::ForEachExecutionPolicy::SEQUENTIAL;
 
-    {
-        SCOPED_TIMER_VARNAME(buildMatricesTimer, "buildMatrices");
+    const bool assembleStiffness = d_assembleStiffness.getValue();
+    const bool assembleMass = d_assembleMass.getValue();
+    const bool assembleDamping = d_assembleDamping.getValue();
+    const bool assembleGeometricStiffness = d_assembleGeometricStiffness.getValue();
 
-        simulation::TaskScheduler* taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
-        assert(taskScheduler);
+    int counter{};
+    for (auto& c : m_independentContributors)
+    {
+        c.id = counter++;
+    }
 
-        if (d_parallelAssemblyIndependentMatrices.getValue() && taskScheduler && taskScheduler->getThreadCount() < 1)
+    simulation::forEach(execution, *taskScheduler,
+        m_independentContributors.begin(), m_independentContributors.end(),
+        [this, mparams, assembleStiffness, assembleMass, assembleDamping, assembleGeometricStiffness](IndependentContributors& contributors)
         {
-            taskScheduler->init(0);
-        }
+            helper::ScopedAdvancedTimer timerContributors("buildContributors" + std::to_string(contributors.id));
 
-        const simulation::ForEachExecutionPolicy execution = d_parallelAssemblyIndependentMatrices.getValue() ?
-            simulation::ForEachExecutionPolicy::PARALLEL :
-            simulation::ForEachExecutionPolicy::SEQUENTIAL;
-
-        const bool assembleStiffness = d_assembleStiffness.getValue();
-        const bool assembleMass = d_assembleMass.getValue();
-        const bool assembleDamping = d_assembleDamping.getValue();
-        const bool assembleGeometricStiffness = d_assembleGeometricStiffness.getValue();
+            if (assembleStiffness)
+            {
+                helper::ScopedAdvancedTimer timerStiffness("buildStiffness" + std::to_string(contributors.id));
+                contribute<Contribution::STIFFNESS>(mparams, contributors);
+            }
 
-        int counter{};
-        for (auto& c : m_independentContributors)
-        {
-            c.id = counter++;
-        }
+            if (assembleMass)
+            {
+                helper::ScopedAdvancedTimer timerMass("buildMass" + std::to_string(contributors.id));
+                contribute<Contribution::MASS>(mparams, contributors);
+            }
 
-        simulation::forEach(execution, *taskScheduler,
-            m_independentContributors.begin(), m_independentContributors.end(),
-            [this, mparams, assembleStiffness, assembleMass, assembleDamping, assembleGeometricStiffness](IndependentContributors& contributors)
+            if (assembleDamping)
             {
-                helper::ScopedAdvancedTimer timerContributors("buildContributors" + std::to_string(contributors.id));
+                helper::ScopedAdvancedTimer timerDamping("buildDamping" + std::to_string(contributors.id));
+                contribute<Contribution::DAMPING>(mparams, contributors);
+            }
 
-                if (assembleStiffness)
-                {
-                    helper::ScopedAdvancedTimer timerStiffness("buildStiffness" + std::to_string(contributors.id));
-                    contribute<Contribution::STIFFNESS>(mparams, contributors);
-                }
+            if (assembleGeometricStiffness)
+            {
+                helper::ScopedAdvancedTimer timerGeometricStiffness("buildGeometricStiffness" + std::to_string(contributors.id));
+                contribute<Contribution::GEOMETRIC_STIFFNESS>(mparams, contributors);
+            }
+        });
+}
 
-                if (assembleMass)
-                {
-                    helper::ScopedAdvancedTimer timerMass("buildMass" + std::to_string(contributors.id));
-                    contribute<Contribution::MASS>(mparams, contributors);
-                }
+template<class TMatrix, class TVector>
+void MatrixLinearSystem<TMatrix, TVector>::assembleSystem(const core::MechanicalParams* mparams)
+{
+    if (this->getSystemMatrix()->rowSize() == 0 || this->getSystemMatrix()->colSize() == 0)
+    {
+        msg_error() << "Global system matrix is not resized appropriately (" << this->getPathName() << ")";
+        return;
+    }
 
-                if (assembleDamping)
-                {
-                    helper::ScopedAdvancedTimer timerDamping("buildDamping" + std::to_string(contributors.id));
-                    contribute<Contribution::DAMPING>(mparams, contributors);
-                }
+    SCOPED_TIMER_VARNAME(assembleSystemTimer, "AssembleSystem");
 
-                if (assembleGeometricStiffness)
-                {
-                    helper::ScopedAdvancedTimer timerGeometricStiffness("buildGeometricStiffness" + std::to_string(contributors.id));
-                    contribute<Contribution::GEOMETRIC_STIFFNESS>(mparams, contributors);
-                }
-            });
+    {
+        SCOPED_TIMER_VARNAME(buildMatricesTimer, "buildMatrices");
+        buildMatrices(mparams);
     }
 
     if (d_applyMappedComponents.getValue() && m_mappingGraph.hasAnyMapping())
@@ -44,8 +44,27 @@ public:
 
     std::size_t currentId {};
 
+    /// If not null, the values are not added into the global matrix, but written in this buffer
+    /// following the insertion order. The buffer must contain as many values as
+    /// compressedInsertionOrderList. It allows to build several local matrices concurrently.
+    typename TMatrix::Real* localValues { nullptr };
+
 protected:
 
+    template<class Real>
+    void addInCompressedValues(Real value)
+    {
+        if (localValues)
+        {
+            localValues[currentId++] = this->m_cachedFactor * value;
+        }
+        else
+        {
+            static_cast<TMatrix*>(this->m_globalMatrix)->colsValue[compressedInsertionOrderList[currentId++]]
+                += this->m_cachedFactor * value;
+        }
+    }
+
     void add(const core::matrixaccumulator::no_check_policy&, sofa::SignedIndex row, sofa::SignedIndex col, float value) override;
     void add(const core::matrixaccumulator::no_check_policy&, sofa::SignedIndex row, sofa::SignedIndex col, double value) override;
     void add(const core::matrixaccumulator::no_check_policy&, sofa::SignedIndex row, sofa::SignedIndex col, const sofa::type::Mat<3, 3, float>& value) override;
@@ -58,8 +77,7 @@ void ConstantLocalMatrix<TMatrix, c, TStrategy>::add(const core::matrixaccumulat
 {
     SOFA_UNUSED(row);
     SOFA_UNUSED(col);
-    static_cast<TMatrix*>(this->m_globalMatrix)->colsValue[compressedInsertionOrderList[currentId++]]
-                += this->m_cachedFactor * value;
+    addInCompressedValues(value);
 }
 
 template <class TMatrix, core::matrixaccumulator::Contribution c, class TStrategy>
@@ -67,19 +85,20 @@ void ConstantLocalMatrix<TMatrix, c, TStrategy>::add(const core::matrixaccumulat
 {
     SOFA_UNUSED(row);
     SOFA_UNUSED(col);
-    static_cast<TMatrix*>(this->m_globalMatrix)->colsValue[compressedInsertionOrderList[currentId++]]
-                += this->m_cachedFactor * value;
+    addInCompressedValues(value);
 }
 
 template <class TMatrix, core::matrixaccumulator::Contribution c, class TStrategy>
 void ConstantLocalMatrix<TMatrix, c, TStrategy>::add(const core::matrixaccumulator::no_check_policy&, sofa::SignedIndex row, sofa::SignedIndex col,
     const sofa::type::Mat<3, 3, float>& value)
 {
+    SOFA_UNUSED(row);
+    SOFA_UNUSED(col);
     for (sofa::SignedIndex i = 0; i < 3; ++i)
     {
         for (sofa::SignedIndex j = 0; j < 3; ++j)
         {
-            this->add(core::matrixaccumulator::no_check, row + i, col + j, value(i, j));
+            addInCompressedValues(value(i, j));
         }
     }
 }
@@ -88,11 +107,13 @@ template <class TMatrix, core::matrixaccumulator::Contribution c, class TStrateg
 void ConstantLocalMatrix<TMatrix, c, TStrategy>::add(const core::matrixaccumulator::no_check_policy&, sofa::SignedIndex row, sofa::SignedIndex col,
     const sofa::type::Mat<3, 3, double>& value)
 {
+    SOFA_UNUSED(row);
+    SOFA_UNUSED(col);
     for (sofa::SignedIndex i = 0; i < 3; ++i)
     {
         for (sofa::SignedIndex j = 0; j < 3; ++j)
         {
-            this->add(core::matrixaccumulator::no_check, row + i, col + j, value(i, j));
+            addInCompressedValues(value(i, j));
         }
     }
 }
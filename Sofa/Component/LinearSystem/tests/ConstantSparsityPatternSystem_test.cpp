@@ -0,0 +1,126 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/testing/BaseTest.h>
+#include <sofa/component/linearsystem/ConstantSparsityPatternSystem.inl>
+
+#include <sofa/core/MechanicalParams.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/graph/DAGNode.h>
+#include <sofa/component/statecontainer/MechanicalObject.h>
+#include <sofa/component/solidmechanics/spring/SpringForceField.h>
+
+namespace
+{
+
+using MatrixType = sofa::linearalgebra::CompressedRowSparseMatrix<SReal>;
+using ConstantSparsityPatternSystem = sofa::component::linearsystem::ConstantSparsityPatternSystem<MatrixType, sofa::linearalgebra::FullVector<SReal> >;
+using SpringForceField = sofa::component::solidmechanics::spring::SpringForceField<sofa::defaulttype::Vec3Types>;
+
+/// Scene made of several spring force fields sharing the same particles, so that several components contribute to
+/// the same matrix values
+struct SpringScene
+{
+    sofa::simulation::Node::SPtr root;
+    ConstantSparsityPatternSystem::SPtr linearSystem;
+    sofa::type::vector<SpringForceField::SPtr> springs;
+
+    static constexpr std::size_t nbParticles = 30;
+    static constexpr std::size_t nbForceFields = 4;
+
+    explicit SpringScene(bool parallelAssembly)
+    {
+        root = sofa::core::objectmodel::New<sofa::simulation::graph::DAGNode>();
+
+        linearSystem = sofa::core::objectmodel::New<ConstantSparsityPatternSystem>();
+        linearSystem->d_parallelAssembly.setValue(parallelAssembly);
+        root->addObject(linearSystem);
+
+        const auto mstate = sofa::core::objectmodel::New<sofa::component::statecontainer::MechanicalObject<sofa::defaulttype::Vec3Types> >();
+        root->addObject(mstate);
+        mstate->resize(nbParticles);
+        auto x = mstate->writePositions();
+        for (std::size_t i = 0; i < nbParticles; ++i)
+        {
+            x[i] = sofa::type::Vec3(std::cos(i), std::sin(2. * i), 0.1 * i);
+        }
+
+        for (std::size_t f = 0; f < nbForceFields; ++f)
+        {
+            auto spring = sofa::core::objectmodel::New<SpringForceField>();
+            root->addObject(spring);
+            for (std::size_t i = 0; i < nbParticles; ++i)
+            {
+                const auto j = (i + f + 1) % nbParticles;
+                spring->addSpring(i, j, 10. * (f + 1), 0.1, 0.5);
+            }
+            springs.push_back(spring);
+        }
+    }
+
+    const MatrixType* build(const sofa::core::MechanicalParams& mparams)
+    {
+        for (const auto& spring : springs)
+        {
+            static_cast<sofa::core::behavior::BaseForceField*>(spring.get())->addForce(&mparams, sofa::core::VecDerivId::externalForce());
+        }
+        linearSystem->buildSystemMatrix(&mparams);
+        return linearSystem->getSystemMatrix();
+    }
+};
+
+TEST(ConstantSparsityPatternSystem, parallelAssembly)
+{
+    sofa::simulation::MainTaskSchedulerFactory::createInRegistry()->init(4);
+
+    auto mparams = *sofa::core::MechanicalParams::defaultInstance();
+    mparams.setKFactor(1._sreal);
+    mparams.setBFactor(0.5_sreal);
+
+    SpringScene sequential(false);
+    SpringScene parallel(true);
+    sequential.root->init(&mparams);
+    parallel.root->init(&mparams);
+
+    // the first step builds the sparsity pattern, the next ones use it
+    for (unsigned int step = 0; step < 4; ++step)
+    {
+        const MatrixType* expected = sequential.build(mparams);
+        const MatrixType* actual = parallel.build(mparams);
+
+        ASSERT_EQ(expected->rowSize(), actual->rowSize());
+        ASSERT_EQ(expected->colSize(), actual->colSize());
+        ASSERT_EQ(expected->colsValue.size(), actual->colsValue.size());
+
+        for (MatrixType::Index i = 0; i < expected->rowSize(); ++i)
+        {
+            for (MatrixType::Index j = 0; j < expected->colSize(); ++j)
+            {
+                EXPECT_NEAR(expected->element(i, j), actual->element(i, j), 1e-12)
+                    << "at step " << step << ", row " << i << ", col " << j;
+            }
+        }
+    }
+
+    EXPECT_TRUE(parallel.linearSystem->isConstantSparsityPatternUsedYet());
+}
+
+}
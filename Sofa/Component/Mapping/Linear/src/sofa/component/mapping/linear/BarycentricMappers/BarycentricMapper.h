@@ -25,6 +25,11 @@
 #include <sofa/core/objectmodel/BaseObject.h>
 #include <sofa/defaulttype/VecTypes.h>
 
+namespace sofa::simulation
+{
+class TaskScheduler;
+}
+
 namespace sofa::component::mapping::linear::_barycentricmapper_
 {
 
@@ -76,10 +81,14 @@ public:
     inline friend std::istream& operator >> ( std::istream& in, BarycentricMapper< In, Out > & ) {return in;}
     inline friend std::ostream& operator << ( std::ostream& out, const BarycentricMapper< In, Out > &  ) { return out; }
 
+    /// Task scheduler used by the mappers providing parallel kernels. The kernels are sequential if it is null.
+    void setTaskScheduler(simulation::TaskScheduler* taskScheduler) { m_taskScheduler = taskScheduler; }
 
 protected:
     void addMatrixContrib(MatrixType* m, int row, int col, Real value);
 
+    simulation::TaskScheduler* m_taskScheduler { nullptr };
+
     template< int NC,  int NP>
     class MappingData
     {
@@ -128,11 +128,33 @@ protected:
     };
 
     using Inherit1::m_fromTopology;
+    using Inherit1::m_taskScheduler;
 
     core::topology::PointData< type::vector<MappingDataType > > d_map; ///< mapper data
     MatrixType* m_matrixJ {nullptr};
     bool m_updateJ {false};
 
+    /// Weights of the mapping, built from d_map for the parallel kernels
+    struct MappingWeights
+    {
+        /// Vertices of the element of each mapped point and their weights, NbVertices entries per mapped point
+        type::vector<Index> vertices;
+        type::vector<SReal> weights;
+
+        /// Transposed (parent-major) CSR: the mapped points contributing to each input vertex, sorted by mapped
+        /// point, and the weights of their contributions
+        type::vector<Index> transposedBegin;
+        type::vector<Index> transposedPoints;
+        type::vector<SReal> transposedWeights;
+    };
+
+    static constexpr std::size_t NbVertices = Element::static_size;
+
+    MappingWeights m_weights;
+    bool m_updateWeights {true};
+    int m_weightsMapCounter {-1}; ///< counter of d_map when the weights were built
+    int m_weightsTopologyRevision {-1}; ///< revision of the input topology when the weights were built
+
     type::vector<Mat3x3d> m_bases;
     type::vector<Vec3> m_centers;
 
@@ -142,6 +164,25 @@ protected:
     std::unordered_map<Key, type::vector<unsigned int>, HashFunction, HashEqual> m_hashTable;
     std::size_t m_hashTableSize;
 
+    /// Node of the bounding volume hierarchy over the elements, used to find the nearest element of the points
+    /// located in an empty grid cell
+    struct ElementTreeNode
+    {
+        /// Bounds of the regions where the points are inside the elements of the node (see computeDistance)
+        Vec3 insideMin, insideMax;
+        /// Bounds of the centers of the elements of the node
+        Vec3 centerMin, centerMax;
+        /// Range of the elements of the node in m_elementTreeIndices
+        Index begin {0}, end {0};
+        /// Children of the node, sofa::InvalidID for the leaves
+        Index left {sofa::InvalidID}, right {sofa::InvalidID};
+    };
+
+    static constexpr Index MaxElementsPerTreeLeaf = 4;
+
+    type::vector<ElementTreeNode> m_elementTree;
+    type::vector<unsigned int> m_elementTreeIndices;
+
 
     BarycentricMapperTopologyContainer(sofa::core::topology::TopologyContainer* fromTopology, core::topology::BaseMeshTopology* toTopology);
 
@@ -177,6 +218,30 @@ protected:
     void computeHashingCellSize(const typename In::VecCoord& in);
     void computeHashTable(const typename In::VecCoord& in);
 
+    /// Build the bounding volume hierarchy over the elements, from the bases and centers
+    void buildElementTree(const typename In::VecCoord& in);
+
+    /// Find the nearest element of outPos in the bounding volume hierarchy, with the distance of checkDistanceFromElement.
+    /// Equal distances are resolved with the smallest element id, so that the result is the one of an exhaustive search.
+    void findNearestElement(const Vec3& outPos, const typename In::VecCoord& in, const type::vector<Element>& elements,
+                            NearestParams& nearestParams);
+
+    /// Find the nearest element of outPos in its grid cell and the neighbor ones, or in the bounding volume hierarchy
+    /// if its grid cell is empty
+    NearestParams locatePoint(const Vec3& outPos, const typename In::VecCoord& in, const type::vector<Element>& elements);
+
+    /// Build the weights if the mapping or the input topology changed since they were built
+    void updateWeights();
+
+    /// Parallel kernels, used if a task scheduler is set. Each output value is computed by a single task, from
+    /// the inputs in the same order as the sequential kernels: the results do not depend on the number of threads.
+    /// @{
+    template<class VecOut, class VecIn, class SetValue>
+    void parallelInterpolate(VecOut& out, const VecIn& in, SetValue setValue);
+    void parallelApplyJT(typename In::VecDeriv& out, const typename Out::VecDeriv& in);
+    void parallelApplyJT(typename In::MatrixDeriv& out, const typename Out::MatrixDeriv& in);
+    /// @}
+
 };
 
 #if !defined(SOFA_COMPONENT_MAPPING_BARYCENTRICMAPPERTOPOLOGYCONTAINER_CPP)
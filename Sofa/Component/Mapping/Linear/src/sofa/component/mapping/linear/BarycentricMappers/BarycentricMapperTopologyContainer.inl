@@ -23,6 +23,12 @@
 #include <sofa/component/mapping/linear/BarycentricMappers/BarycentricMapperTopologyContainer.h>
 #include <sofa/core/State.h>
 #include <sofa/core/visual/VisualParams.h>
+#include <sofa/simulation/ParallelForEach.h>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <type_traits>
 
 namespace sofa::component::mapping::linear::_barycentricmappertopologycontainer_
 {
@@ -48,6 +54,7 @@ void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::clear(s
     vectorData.clear();
     if ( size>0 ) vectorData.reserve ( size );
     d_map.endEdit();
+    m_updateWeights = true;
 }
 
 
@@ -133,61 +140,237 @@ void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::init (
     initHashing(in);
     this->clear ( int(out.size()) );
     computeBasesAndCenters(in);
+    buildElementTree(in);
 
     // Compute distances to get nearest element and corresponding bary coef
+    // The points are located in parallel if a task scheduler is set, and added sequentially in their order
     const type::vector<Element>& elements = getElements();
-    for ( unsigned int i=0; i<out.size(); i++ )
+    type::vector<NearestParams> nearestParams(out.size());
+    const auto locate = [&](const std::size_t i)
+    {
+        nearestParams[i] = locatePoint(Out::getCPos(out[i]), in, elements);
+    };
+
+    if (m_taskScheduler)
     {
-        const auto& outPos = Out::getCPos(out[i]);
-        NearestParams nearestParams;
+        simulation::parallelForEach(*m_taskScheduler, std::size_t(0), out.size(), locate);
+    }
+    else
+    {
+        for ( std::size_t i=0; i<out.size(); i++ )
+            locate(i);
+    }
+
+    for ( const auto& nearest : nearestParams )
+        addPointInElement(nearest.elementId, nearest.baryCoords.ptr());
+}
 
-        // Search nearest element in grid cell
-        Vec3i gridIds = getGridIndices(outPos);
-        Key key(gridIds[0],gridIds[1],gridIds[2]);
 
-        auto it_entries = m_hashTable.find(key);
-        if( it_entries != m_hashTable.end() )
+template <class In, class Out, class MappingDataType, class Element>
+auto BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::locatePoint(const Vec3& outPos,
+                                                                                   const typename In::VecCoord& in,
+                                                                                   const type::vector<Element>& elements) -> NearestParams
+{
+    NearestParams nearestParams;
+
+    // Search nearest element in grid cell
+    Vec3i gridIds = getGridIndices(outPos);
+    Key key(gridIds[0],gridIds[1],gridIds[2]);
+
+    auto it_entries = m_hashTable.find(key);
+    if( it_entries != m_hashTable.end() )
+    {
+        for(auto entry : it_entries->second)
         {
-            for(auto entry : it_entries->second)
+            const auto& inPos = in[elements[entry][0]];
+            checkDistanceFromElement(entry, outPos, inPos, nearestParams);
+        }
+    }
+
+    if(nearestParams.elementId==std::numeric_limits<unsigned int>::max()) // No element in grid cell, search the element tree
+    {
+        findNearestElement(outPos, in, elements, nearestParams);
+    }
+    else if(fabs(nearestParams.distance)>m_gridCellSize/2.) // Nearest element in grid cell may not be optimal, check neighbors
+    {
+        Vec3i centerGridIds = gridIds;
+        for(int xId=-1; xId<=1; xId++)
+            for(int yId=-1; yId<=1; yId++)
+                for(int zId=-1; zId<=1; zId++)
+                {
+                    gridIds = Vec3i(centerGridIds[0]+xId,centerGridIds[1]+yId,centerGridIds[2]+zId);
+                    Key key(gridIds[0],gridIds[1],gridIds[2]);
+
+                    auto it_entries = m_hashTable.find(key);
+                    if( it_entries != m_hashTable.end() )
+                    {
+                        for(auto entry : it_entries->second)
+                        {
+                            Vec3 inPos = in[elements[entry][0]];
+                            checkDistanceFromElement(entry, outPos, inPos, nearestParams);
+                        }
+                    }
+                }
+    }
+
+    return nearestParams;
+}
+
+
+template <class In, class Out, class MappingDataType, class Element>
+void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::buildElementTree(const typename In::VecCoord& in)
+{
+    const type::vector<Element>& elements = getElements();
+    m_elementTree.clear();
+    m_elementTreeIndices.resize(elements.size());
+    std::iota(m_elementTreeIndices.begin(), m_elementTreeIndices.end(), 0u);
+    if (elements.empty())
+        return;
+
+    // The region where a point is inside an element (computeDistance is not positive) is bounded by the image of
+    // a box of barycentric coordinates: [0,1]^3 for the volumes, and [0,1]^2 with the tolerance along the normal
+    // for the surfaces
+    constexpr std::size_t baryDimension = std::extent_v<decltype(MappingDataType::baryCoords)>;
+    const SReal normalMin = (baryDimension == 3) ? 0_sreal : -0.01_sreal;
+    const SReal normalMax = (baryDimension == 3) ? 1_sreal : 0.01_sreal;
+
+    type::vector<Vec3> insideMin(elements.size()), insideMax(elements.size());
+    for (unsigned int e = 0; e < elements.size(); e++)
+    {
+        Mat3x3d frame;
+        if (!frame.invert(m_bases[e]))
+        {
+            // degenerate element, always checked
+            insideMin[e] = Vec3(1, 1, 1) * std::numeric_limits<SReal>::lowest();
+            insideMax[e] = Vec3(1, 1, 1) * std::numeric_limits<SReal>::max();
+            continue;
+        }
+
+        const Vec3& origin = in[elements[e][0]];
+        insideMin[e] = insideMax[e] = origin + frame * Vec3(0, 0, normalMin);
+        for (unsigned int corner = 1; corner < 8; corner++)
+        {
+            const Vec3 bary((corner & 1) ? 1 : 0, (corner & 2) ? 1 : 0, (corner & 4) ? normalMax : normalMin);
+            const Vec3 pos = origin + frame * bary;
+            for (int k = 0; k < 3; k++)
             {
-                const auto& inPos = in[elements[entry][0]];
-                checkDistanceFromElement(entry, outPos, inPos, nearestParams);
+                insideMin[e][k] = std::min(insideMin[e][k], pos[k]);
+                insideMax[e][k] = std::max(insideMax[e][k], pos[k]);
             }
         }
+    }
 
-        if(nearestParams.elementId==std::numeric_limits<unsigned int>::max()) // No element in grid cell, perform exhaustive search
+    // Top-down construction, splitting the elements of a node at the median of their centers along the longest axis
+    ElementTreeNode root;
+    root.end = Index(elements.size());
+    m_elementTree.push_back(root);
+    for (std::size_t nodeId = 0; nodeId < m_elementTree.size(); nodeId++)
+    {
+        ElementTreeNode node = m_elementTree[nodeId];
+        const unsigned int first = m_elementTreeIndices[node.begin];
+        node.insideMin = insideMin[first];
+        node.insideMax = insideMax[first];
+        node.centerMin = node.centerMax = m_centers[first];
+        for (Index i = node.begin + 1; i < node.end; i++)
         {
-            for ( unsigned int e = 0; e < elements.size(); e++ )
+            const unsigned int e = m_elementTreeIndices[i];
+            for (int k = 0; k < 3; k++)
             {
-                const auto& inPos = in[elements[e][0]];
-                checkDistanceFromElement(e, outPos, inPos, nearestParams);
+                node.insideMin[k] = std::min(node.insideMin[k], insideMin[e][k]);
+                node.insideMax[k] = std::max(node.insideMax[k], insideMax[e][k]);
+                node.centerMin[k] = std::min(node.centerMin[k], m_centers[e][k]);
+                node.centerMax[k] = std::max(node.centerMax[k], m_centers[e][k]);
             }
-            addPointInElement(nearestParams.elementId, nearestParams.baryCoords.ptr());
         }
-        else if(fabs(nearestParams.distance)>m_gridCellSize/2.) // Nearest element in grid cell may not be optimal, check neighbors
+
+        if (node.end - node.begin > MaxElementsPerTreeLeaf)
         {
-            Vec3i centerGridIds = gridIds;
-            for(int xId=-1; xId<=1; xId++)
-                for(int yId=-1; yId<=1; yId++)
-                    for(int zId=-1; zId<=1; zId++)
-                    {
-                        gridIds = Vec3i(centerGridIds[0]+xId,centerGridIds[1]+yId,centerGridIds[2]+zId);
-                        Key key(gridIds[0],gridIds[1],gridIds[2]);
+            const Vec3 extent = node.centerMax - node.centerMin;
+            const int axis = (extent[0] >= extent[1] && extent[0] >= extent[2]) ? 0 : (extent[1] >= extent[2] ? 1 : 2);
+            const Index middle = node.begin + (node.end - node.begin) / 2;
+            std::nth_element(m_elementTreeIndices.begin() + node.begin, m_elementTreeIndices.begin() + middle,
+                             m_elementTreeIndices.begin() + node.end,
+                             [this, axis](unsigned int a, unsigned int b) { return m_centers[a][axis] < m_centers[b][axis]; });
+
+            ElementTreeNode left, right;
+            left.begin = node.begin;
+            left.end = right.begin = middle;
+            right.end = node.end;
+            node.left = Index(m_elementTree.size());
+            node.right = node.left + 1;
+            m_elementTree.push_back(left);
+            m_elementTree.push_back(right);
+        }
+        m_elementTree[nodeId] = node;
+    }
+}
 
-                        auto it_entries = m_hashTable.find(key);
-                        if( it_entries != m_hashTable.end() )
-                        {
-                            for(auto entry : it_entries->second)
-                            {
-                                Vec3 inPos = in[elements[entry][0]];
-                                checkDistanceFromElement(entry, outPos, inPos, nearestParams);
-                            }
-                        }
-                    }
-            addPointInElement(nearestParams.elementId, nearestParams.baryCoords.ptr());
+
+template <class In, class Out, class MappingDataType, class Element>
+void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::findNearestElement(const Vec3& outPos,
+                                                                                            const typename In::VecCoord& in,
+                                                                                            const type::vector<Element>& elements,
+                                                                                            NearestParams& nearestParams)
+{
+    if (m_elementTree.empty())
+        return;
+
+    // Lower bound of the distance to the elements of a node: the point may be inside one of them, or its distance
+    // is the one to the center of an element
+    const auto lowerBound = [&outPos](const ElementTreeNode& node)
+    {
+        bool inside = true;
+        SReal distance = 0;
+        for (int k = 0; k < 3; k++)
+        {
+            inside = inside && outPos[k] >= node.insideMin[k] && outPos[k] <= node.insideMax[k];
+            const SReal delta = std::max({node.centerMin[k] - outPos[k], SReal(0), outPos[k] - node.centerMax[k]});
+            distance += delta * delta;
+        }
+        return inside ? std::numeric_limits<SReal>::lowest() : distance;
+    };
+
+    // Depth-first traversal, nearest child first. The tree is balanced, its depth is at most log2 of the number of elements
+    std::array<std::pair<SReal, Index>, 2 * sizeof(Index) * 8> stack;
+    std::size_t stackSize = 0;
+    stack[stackSize++] = { lowerBound(m_elementTree[0]), 0 };
+    while (stackSize > 0)
+    {
+        const auto [bound, nodeId] = stack[--stackSize];
+        if (bound > nearestParams.distance)
+            continue;
+
+        const ElementTreeNode& node = m_elementTree[nodeId];
+        if (node.left == sofa::InvalidID)
+        {
+            for (Index i = node.begin; i < node.end; i++)
+            {
+                const unsigned int e = m_elementTreeIndices[i];
+                NearestParams candidate;
+                checkDistanceFromElement(e, outPos, in[elements[e][0]], candidate);
+                if (candidate.distance < nearestParams.distance
+                    || (candidate.distance == nearestParams.distance && e < nearestParams.elementId))
+                {
+                    nearestParams = candidate;
+                }
+            }
         }
         else
-            addPointInElement(nearestParams.elementId, nearestParams.baryCoords.ptr());
+        {
+            const SReal leftBound = lowerBound(m_elementTree[node.left]);
+            const SReal rightBound = lowerBound(m_elementTree[node.right]);
+            assert(stackSize + 2 <= stack.size());
+            if (leftBound <= rightBound)
+            {
+                stack[stackSize++] = { rightBound, node.right };
+                stack[stackSize++] = { leftBound, node.left };
+            }
+            else
+            {
+                stack[stackSize++] = { leftBound, node.left };
+                stack[stackSize++] = { rightBound, node.right };
+            }
+        }
     }
 }
 
@@ -237,6 +420,12 @@ void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::checkDi
 template <class In, class Out, class MappingDataType, class Element>
 void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::applyJT ( typename In::MatrixDeriv& out, const typename Out::MatrixDeriv& in )
 {
+    if (m_taskScheduler)
+    {
+        parallelApplyJT(out, in);
+        return;
+    }
+
     typename Out::MatrixDeriv::RowConstIterator rowItEnd = in.end();
     const type::vector< Element >& elements = getElements();
 
@@ -299,6 +488,12 @@ const linearalgebra::BaseMatrix* BarycentricMapperTopologyContainer<In,Out,Mappi
 template <class In, class Out, class MappingDataType, class Element>
 void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::applyJT ( typename In::VecDeriv& out, const typename Out::VecDeriv& in )
 {
+    if (m_taskScheduler && in.size() == d_map.getValue().size())
+    {
+        parallelApplyJT(out, in);
+        return;
+    }
+
     const type::vector<Element>& elements = getElements();
 
     for( size_t i=0 ; i<in.size() ; ++i)
@@ -320,6 +515,12 @@ void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::applyJ
 {
     out.resize( d_map.getValue().size() );
 
+    if (m_taskScheduler)
+    {
+        parallelInterpolate(out, in, [](OutDeriv& value, const InDeriv& interpolated) { Out::setDPos(value, interpolated); });
+        return;
+    }
+
     const type::vector<Element>& elements = getElements();
 
     for( size_t i=0 ; i<out.size() ; ++i)
@@ -356,6 +557,12 @@ void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::apply (
 {
     out.resize( d_map.getValue().size() );
 
+    if (m_taskScheduler)
+    {
+        parallelInterpolate(out, in, [](typename Out::Coord& value, const InDeriv& interpolated) { Out::setCPos(value, interpolated); });
+        return;
+    }
+
     const type::vector<Element>& elements = getElements();
     for ( unsigned int i=0; i<d_map.getValue().size(); i++ )
     {
@@ -401,6 +608,129 @@ void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::draw  (
 }
 
 
+template <class In, class Out, class MappingDataType, class Element>
+void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::updateWeights()
+{
+    // the elements may have been modified without the mapping being cleared
+    const int topologyRevision = m_fromTopology->getRevision();
+    if (!m_updateWeights && m_weightsMapCounter == d_map.getCounter() && m_weightsTopologyRevision == topologyRevision)
+        return;
+
+    const auto& map = d_map.getValue();
+    const type::vector<Element>& elements = getElements();
+
+    m_weights.vertices.resize(map.size() * NbVertices);
+    m_weights.weights.resize(map.size() * NbVertices);
+
+    Index nbInputVertices = 0;
+    for (std::size_t i = 0; i < map.size(); ++i)
+    {
+        const Element& element = elements[map[i].in_index];
+        const type::vector<SReal> baryCoef = getBaryCoef(map[i].baryCoords);
+        for (std::size_t j = 0; j < NbVertices; ++j)
+        {
+            m_weights.vertices[i * NbVertices + j] = element[j];
+            m_weights.weights[i * NbVertices + j] = baryCoef[j];
+            nbInputVertices = std::max(nbInputVertices, element[j] + 1);
+        }
+    }
+
+    // Transposition by counting sort: the mapped points are visited in increasing order, so the contributions
+    // to an input vertex are sorted by mapped point
+    auto& begin = m_weights.transposedBegin;
+    begin.assign(nbInputVertices + 1, 0);
+    for (const Index vertex : m_weights.vertices)
+        ++begin[vertex + 1];
+    std::partial_sum(begin.begin(), begin.end(), begin.begin());
+
+    m_weights.transposedPoints.resize(m_weights.vertices.size());
+    m_weights.transposedWeights.resize(m_weights.vertices.size());
+    type::vector<Index> next(begin.begin(), begin.end() - 1);
+    for (std::size_t i = 0; i < map.size(); ++i)
+    {
+        for (std::size_t j = 0; j < NbVertices; ++j)
+        {
+            const Index position = next[m_weights.vertices[i * NbVertices + j]]++;
+            m_weights.transposedPoints[position] = Index(i);
+            m_weights.transposedWeights[position] = m_weights.weights[i * NbVertices + j];
+        }
+    }
+
+    m_updateWeights = false;
+    m_weightsMapCounter = d_map.getCounter();
+    m_weightsTopologyRevision = topologyRevision;
+}
+
+
+template <class In, class Out, class MappingDataType, class Element>
+template<class VecOut, class VecIn, class SetValue>
+void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::parallelInterpolate(VecOut& out, const VecIn& in, SetValue setValue)
+{
+    updateWeights();
+
+    simulation::parallelForEach(*m_taskScheduler, std::size_t(0), out.size(), [&](const std::size_t i)
+    {
+        InDeriv value{0.,0.,0.};
+        for (std::size_t j = 0; j < NbVertices; ++j)
+            value += in[m_weights.vertices[i * NbVertices + j]] * m_weights.weights[i * NbVertices + j];
+
+        setValue(out[i], value);
+    });
+}
+
+
+template <class In, class Out, class MappingDataType, class Element>
+void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::parallelApplyJT(typename In::VecDeriv& out, const typename Out::VecDeriv& in)
+{
+    updateWeights();
+
+    // Each input vertex gathers the contributions of its mapped points: no two tasks write the same value
+    const auto& begin = m_weights.transposedBegin;
+    const std::size_t nbInputVertices = std::min<std::size_t>(out.size(), begin.size() - 1);
+
+    simulation::parallelForEach(*m_taskScheduler, std::size_t(0), nbInputVertices, [&](const std::size_t vertex)
+    {
+        for (Index k = begin[vertex]; k < begin[vertex + 1]; ++k)
+            out[vertex] += Out::getDPos(in[m_weights.transposedPoints[k]]) * m_weights.transposedWeights[k];
+    });
+}
+
+
+template <class In, class Out, class MappingDataType, class Element>
+void BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::parallelApplyJT(typename In::MatrixDeriv& out, const typename Out::MatrixDeriv& in)
+{
+    updateWeights();
+
+    std::vector<typename Out::MatrixDeriv::RowConstIterator> rows;
+    for (auto rowIt = in.begin(); rowIt != in.end(); ++rowIt)
+    {
+        if (rowIt.begin() != rowIt.end())
+            rows.push_back(rowIt);
+    }
+
+    // The rows are mapped in parallel, then written sequentially in the matrix, which is not thread-safe
+    std::vector< std::vector< std::pair<Index, InDeriv> > > mappedRows(rows.size());
+    simulation::parallelForEach(*m_taskScheduler, std::size_t(0), rows.size(), [&](const std::size_t r)
+    {
+        auto& mappedRow = mappedRows[r];
+        for (auto colIt = rows[r].begin(); colIt != rows[r].end(); ++colIt)
+        {
+            const Index indexIn = colIt.index();
+            const InDeriv data = InDeriv(Out::getDPos(colIt.val()));
+            for (std::size_t j = 0; j < NbVertices; ++j)
+                mappedRow.emplace_back(m_weights.vertices[indexIn * NbVertices + j], data * m_weights.weights[indexIn * NbVertices + j]);
+        }
+    });
+
+    for (std::size_t r = 0; r < rows.size(); ++r)
+    {
+        typename In::MatrixDeriv::RowIterator o = out.writeLine(rows[r].index());
+        for (const auto& [vertex, value] : mappedRows[r])
+            o.addCol(vertex, value);
+    }
+}
+
+
 template <class In, class Out, class MappingDataType, class Element>
 Vec3i BarycentricMapperTopologyContainer<In,Out,MappingDataType,Element>::getGridIndices(const Vec3& pos)
 {
@@ -63,6 +63,7 @@ public:
 
 public:
     Data< bool > d_useRestPosition; ///< Use the rest position of the input and output models to initialize the mapping
+    Data< bool > d_parallel; ///< If true, the mapper computes apply, applyJ and applyJT in parallel, using the task scheduler
 
     SingleLink<BarycentricMapping<In,Out>,Mapper,BaseLink::FLAG_STRONGLINK> d_mapper;
     SingleLink<BarycentricMapping<In,Out>,BaseMeshTopology,BaseLink::FLAG_STRONGLINK> d_input_topology;
@@ -40,6 +40,8 @@
 #include <sofa/core/behavior/MechanicalState.h>
 #include <sofa/type/vector.h>
 #include <sofa/simulation/Simulation.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/TaskScheduler.h>
 
 namespace sofa::component::mapping::linear
 {
@@ -74,6 +76,8 @@ template <class TIn, class TOut>
 BarycentricMapping<TIn, TOut>::BarycentricMapping(core::State<In>* from, core::State<Out>* to, typename Mapper::SPtr mapper)
     : Inherit1 ( from, to )
     , d_useRestPosition(core::objectmodel::Base::initData(&d_useRestPosition, false, "useRestPosition", "Use the rest position of the input and output models to initialize the mapping"))
+    , d_parallel(core::objectmodel::Base::initData(&d_parallel, false, "parallel", "If true, the mapper computes apply, applyJ and applyJT in parallel, using the task scheduler. "
+                                                                                 "The results do not depend on the number of threads. Only the mappers of the topology containers (edges, triangles, quads, tetrahedra, hexahedra) provide parallel kernels."))
     , d_mapper(initLink("mapper","Internal mapper created depending on the type of topology"), mapper)
     , d_input_topology(initLink("input_topology", "Input topology container (usually the surrounding domain)."))
     , d_output_topology(initLink("output_topology", "Output topology container (usually the immersed domain)."))
@@ -89,6 +93,8 @@ template <class TIn, class TOut>
 BarycentricMapping<TIn, TOut>::BarycentricMapping (core::State<In>* from, core::State<Out>* to, BaseMeshTopology * input_topology )
     : Inherit1 ( from, to )
     , d_useRestPosition(core::objectmodel::Base::initData(&d_useRestPosition, false, "useRestPosition", "Use the rest position of the input and output models to initialize the mapping"))
+    , d_parallel(core::objectmodel::Base::initData(&d_parallel, false, "parallel", "If true, the mapper computes apply, applyJ and applyJT in parallel, using the task scheduler. "
+                                                                                 "The results do not depend on the number of threads. Only the mappers of the topology containers (edges, triangles, quads, tetrahedra, hexahedra) provide parallel kernels."))
     , d_mapper (initLink("mapper","Internal mapper created depending on the type of topology"))
     , d_input_topology(initLink("input_topology", "Input topology container (usually the surrounding domain)."))
     , d_output_topology(initLink("output_topology", "Output topology container (usually the immersed domain)."))
@@ -282,6 +288,18 @@ void BarycentricMapping<TIn, TOut>::initMapper()
 {
     if (d_mapper != nullptr && this->toModel != nullptr && this->fromModel != nullptr)
     {
+        simulation::TaskScheduler* taskScheduler = nullptr;
+        if (d_parallel.getValue())
+        {
+            taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+            if (taskScheduler && taskScheduler->getThreadCount() < 1)
+            {
+                taskScheduler->init(0);
+                msg_info() << "Task scheduler initialized on " << taskScheduler->getThreadCount() << " threads";
+            }
+        }
+        d_mapper->setTaskScheduler(taskScheduler);
+
         if (d_useRestPosition.getValue())
             d_mapper->init (((const core::State<Out> *)this->toModel)->read(core::ConstVecCoordId::restPosition())->getValue(), ((const core::State<In> *)this->fromModel)->read(core::ConstVecCoordId::restPosition())->getValue() );
         else
@@ -50,6 +50,8 @@ using sofa::component::statecontainer::MechanicalObject ;
 
 #include <sofa/simulation/Node.h>
 
+#include <random>
+
 using sofa::defaulttype::Vec3Types;
 
 template <class In, class Out>
@@ -64,11 +66,17 @@ struct BarycentricMapperTriangleSetTopologyTest :  public BaseTest, public Baryc
     using Inherit::m_convFactor;
     using Inherit::m_fromTopology;
     using Inherit::d_map;
+    using NearestParams = typename Inherit::NearestParams;
 
     using Inherit::computeHashTable;
     using Inherit::getGridIndices;
     using Inherit::initHashing;
     using Inherit::init;
+    using Inherit::computeBasesAndCenters;
+    using Inherit::buildElementTree;
+    using Inherit::checkDistanceFromElement;
+    using Inherit::findNearestElement;
+    using Inherit::getElements;
 
     typename In::VecCoord m_in;
     typename Out::VecCoord m_out;
@@ -129,6 +137,55 @@ struct BarycentricMapperTriangleSetTopologyTest :  public BaseTest, public Baryc
 
         EXPECT_EQ(m_convFactor,1./m_gridCellSize);
     }
+
+    void findNearestElement_test()
+    {
+        // a wavy surface, to test the tolerance of the triangles along their normal
+        constexpr unsigned int n = 10;
+        const auto vertexId = [](unsigned int i, unsigned int j) { return i + (n + 1) * j; };
+        m_in.clear();
+        for (unsigned int j = 0; j <= n; ++j)
+            for (unsigned int i = 0; i <= n; ++i)
+                m_in.push_back(Vec3(i, j, 0.3 * std::sin(i) * std::cos(j)));
+
+        m_topology = New<TriangleSetTopologyContainer>();
+        m_fromTopology = m_topology.get();
+        for (unsigned int j = 0; j < n; ++j)
+        {
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                m_fromTopology->addTriangle(vertexId(i, j), vertexId(i + 1, j), vertexId(i + 1, j + 1));
+                m_fromTopology->addTriangle(vertexId(i, j), vertexId(i + 1, j + 1), vertexId(i, j + 1));
+            }
+        }
+
+        computeBasesAndCenters(m_in);
+        buildElementTree(m_in);
+        const auto elements = getElements();
+
+        std::mt19937 generator(0);
+        std::uniform_real_distribution<Real> position(-5, n + 5);
+        std::uniform_real_distribution<Real> offset(-0.02, 0.02);
+        for (unsigned int p = 0; p < 2000; ++p)
+        {
+            Vec3 outPos(position(generator), position(generator), position(generator));
+            if (p % 2)
+            {
+                // close to the surface
+                const Vec3& vertex = m_in[(p * 7) % m_in.size()];
+                outPos = vertex + Vec3(offset(generator), offset(generator), offset(generator));
+            }
+
+            NearestParams exhaustive;
+            for (unsigned int e = 0; e < elements.size(); ++e)
+                checkDistanceFromElement(e, outPos, m_in[elements[e][0]], exhaustive);
+
+            NearestParams nearest;
+            findNearestElement(outPos, m_in, elements, nearest);
+            EXPECT_EQ(nearest.elementId, exhaustive.elementId);
+            EXPECT_EQ(nearest.distance, exhaustive.distance);
+        }
+    }
 };
 
 
@@ -145,4 +202,164 @@ TEST_F(BarycentricMapperTriangleSetTopologyTest_d, initHashing)
     initHashing_test();
 }
 
+TEST_F(BarycentricMapperTriangleSetTopologyTest_d, findNearestElement)
+{
+    findNearestElement_test();
+}
+
+
+
+#include <sofa/component/mapping/linear/BarycentricMappers/BarycentricMapperTetrahedronSetTopology.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/TaskScheduler.h>
+#include <sofa/core/topology/TopologyChange.h>
+using sofa::component::mapping::linear::BarycentricMapperTetrahedronSetTopology;
+
+namespace
+{
+
+/// Compare the parallel kernels of a tetrahedron mapper with the sequential ones, on points inside and outside a
+/// grid of tetrahedra
+TEST(BarycentricMapperTetrahedronSetTopology, parallelKernels)
+{
+    using Mapper = BarycentricMapperTetrahedronSetTopology<Vec3Types, Vec3Types>;
+
+    constexpr unsigned int n = 6;
+    const auto vertexId = [](unsigned int i, unsigned int j, unsigned int k) { return i + (n + 1) * (j + (n + 1) * k); };
+
+    Vec3Types::VecCoord in;
+    for (unsigned int k = 0; k <= n; ++k)
+        for (unsigned int j = 0; j <= n; ++j)
+            for (unsigned int i = 0; i <= n; ++i)
+                in.emplace_back(i, j, k);
+
+    const TetrahedronSetTopologyContainer::SPtr topology = New<TetrahedronSetTopologyContainer>();
+    for (unsigned int k = 0; k < n; ++k)
+    {
+        for (unsigned int j = 0; j < n; ++j)
+        {
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                const sofa::Index c[8] = {
+                    vertexId(i, j, k), vertexId(i + 1, j, k), vertexId(i + 1, j + 1, k), vertexId(i, j + 1, k),
+                    vertexId(i, j, k + 1), vertexId(i + 1, j, k + 1), vertexId(i + 1, j + 1, k + 1), vertexId(i, j + 1, k + 1) };
+                topology->addTetra(c[0], c[5], c[1], c[6]);
+                topology->addTetra(c[0], c[1], c[3], c[6]);
+                topology->addTetra(c[1], c[3], c[6], c[2]);
+                topology->addTetra(c[6], c[3], c[0], c[7]);
+                topology->addTetra(c[6], c[7], c[0], c[5]);
+                topology->addTetra(c[7], c[5], c[4], c[0]);
+            }
+        }
+    }
+    topology->init();
 
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<SReal> position(-0.5, n + 0.5);
+    std::uniform_real_distribution<SReal> value(-1, 1);
+
+    Vec3Types::VecCoord out(2000);
+    for (auto& p : out)
+        p = Vec3(position(generator), position(generator), position(generator));
+
+    Vec3Types::VecDeriv inDeriv(in.size()), outDeriv(out.size());
+    for (auto& v : inDeriv)
+        v = Vec3(value(generator), value(generator), value(generator));
+    for (auto& v : outDeriv)
+        v = Vec3(value(generator), value(generator), value(generator));
+
+    Vec3Types::MatrixDeriv constraints;
+    for (unsigned int row = 0; row < 50; ++row)
+    {
+        auto line = constraints.writeLine(row * 2);
+        for (unsigned int c = 0; c < 5; ++c)
+            line.addCol((row * 37 + c * 101) % out.size(), Vec3(value(generator), value(generator), value(generator)));
+    }
+    constraints.compress();
+
+    const Mapper::SPtr mapper = New<Mapper>(topology.get(), nullptr);
+    mapper->init(out, in);
+
+    struct Results
+    {
+        Vec3Types::VecCoord apply;
+        Vec3Types::VecDeriv applyJ;
+        Vec3Types::VecDeriv applyJT;
+        Vec3Types::MatrixDeriv applyJTMatrix;
+    };
+    const auto compute = [&]()
+    {
+        Results results;
+        mapper->apply(results.apply, in);
+        mapper->applyJ(results.applyJ, inDeriv);
+        results.applyJT.resize(in.size());
+        mapper->applyJT(results.applyJT, outDeriv);
+        mapper->applyJT(results.applyJTMatrix, constraints);
+        results.applyJTMatrix.compress();
+        return results;
+    };
+
+    const Results sequential = compute();
+
+    auto* taskScheduler = sofa::simulation::MainTaskSchedulerFactory::createInRegistry();
+    ASSERT_NE(taskScheduler, nullptr);
+    taskScheduler->init(4);
+    mapper->setTaskScheduler(taskScheduler);
+
+    // the points are located in parallel, with the same mapping as the sequential location
+    mapper->init(out, in);
+
+    // the results are the same as the sequential ones, bit for bit, at each run
+    for (unsigned int run = 0; run < 3; ++run)
+    {
+        const Results parallel = compute();
+        EXPECT_EQ(parallel.apply, sequential.apply);
+        EXPECT_EQ(parallel.applyJ, sequential.applyJ);
+        EXPECT_EQ(parallel.applyJT, sequential.applyJT);
+
+        auto rowSequential = sequential.applyJTMatrix.begin();
+        auto rowParallel = parallel.applyJTMatrix.begin();
+        for (; rowSequential != sequential.applyJTMatrix.end() && rowParallel != parallel.applyJTMatrix.end(); ++rowSequential, ++rowParallel)
+        {
+            EXPECT_EQ(rowParallel.index(), rowSequential.index());
+            auto colSequential = rowSequential.begin();
+            auto colParallel = rowParallel.begin();
+            for (; colSequential != rowSequential.end() && colParallel != rowParallel.end(); ++colSequential, ++colParallel)
+            {
+                EXPECT_EQ(colParallel.index(), colSequential.index());
+                EXPECT_EQ(colParallel.val(), colSequential.val());
+            }
+            EXPECT_TRUE(colSequential == rowSequential.end() && colParallel == rowParallel.end());
+        }
+        EXPECT_TRUE(rowSequential == sequential.applyJTMatrix.end() && rowParallel == parallel.applyJTMatrix.end());
+    }
+
+    // the weights are updated with the mapping
+    mapper->clear();
+    out.resize(500);
+    mapper->init(out, in);
+    Vec3Types::VecCoord parallelApply;
+    mapper->apply(parallelApply, in);
+    mapper->setTaskScheduler(nullptr);
+    Vec3Types::VecCoord sequentialApply;
+    mapper->apply(sequentialApply, in);
+    EXPECT_EQ(parallelApply, sequentialApply);
+
+    // the weights are updated with the elements of the input topology
+    mapper->setTaskScheduler(taskScheduler);
+    mapper->apply(parallelApply, in);
+    {
+        auto tetrahedra = sofa::helper::getWriteAccessor(topology->d_tetrahedron);
+        for (auto& tetrahedron : tetrahedra)
+            std::swap(tetrahedron[0], tetrahedron[1]);
+    }
+    topology->addTopologyChange(new sofa::core::topology::EndingEvent());
+    mapper->apply(parallelApply, in);
+    mapper->setTaskScheduler(nullptr);
+    mapper->apply(sequentialApply, in);
+    EXPECT_EQ(parallelApply, sequentialApply);
+
+    taskScheduler->stop();
+}
+
+}
@@ -24,6 +24,7 @@
 #include <sofa/core/behavior/LinearSolverAccessor.h>
 
 #include <sofa/core/behavior/OdeSolver.h>
+#include <sofa/core/behavior/MultiVecPool.h>
 
 #include <sofa/core/objectmodel/RenamedData.h>
 
@@ -182,6 +183,9 @@ protected:
     /// the solution vector is stored for warm-start
     core::behavior::MultiVecDeriv x;
 
+    /// temporary vectors, kept allocated from one time step to the next
+    core::behavior::MultiVecDerivPool m_temporaryVectors;
+
 };
 
 } // namespace sofa::component::odesolver::backward
@@ -56,6 +56,11 @@ NewmarkImplicitSolver::NewmarkImplicitSolver()
     cpt=0;
 }
 
+void NewmarkImplicitSolver::cleanup()
+{
+    sofa::simulation::common::VectorOperations vop( core::execparams::defaultInstance(), this->getContext() );
+    m_temporaryVectors.clear(&vop);
+}
 
 void NewmarkImplicitSolver::solve(const core::ExecParams* params, SReal dt, sofa::core::MultiVecCoordId xResult, sofa::core::MultiVecDerivId vResult)
 {
@@ -63,8 +68,9 @@ void NewmarkImplicitSolver::solve(const core::ExecParams* params, SReal dt, sofa
     sofa::simulation::common::MechanicalOperations mop( params, this->getContext() );
     MultiVecCoord pos(&vop, core::VecCoordId::position() );
     MultiVecDeriv vel(&vop, core::VecDerivId::velocity() );
-    MultiVecDeriv b(&vop);
-    MultiVecDeriv aResult(&vop);
+    auto b = m_temporaryVectors.acquire(&vop); // cleared by computeForce
+    auto aResult = m_temporaryVectors.acquire(&vop);
+    aResult.clear(); // initial guess of the linear solver
     MultiVecCoord newPos(&vop, xResult );
     MultiVecDeriv newVel(&vop, vResult );
 
@@ -25,6 +25,7 @@
 #include <sofa/core/behavior/LinearSolverAccessor.h>
 
 #include <sofa/core/behavior/OdeSolver.h>
+#include <sofa/core/behavior/MultiVecPool.h>
 
 namespace sofa::component::odesolver::backward
 {
@@ -55,6 +56,9 @@ protected:
     unsigned int cpt;
     sofa::core::MultiVecDerivId pID;
 
+    /// temporary vectors, kept allocated from one time step to the next
+    sofa::core::behavior::MultiVecDerivPool m_temporaryVectors;
+
     NewmarkImplicitSolver();
 
 public:
@@ -68,6 +72,8 @@ public:
 
     Data<bool> d_threadSafeVisitor; ///< If true, do not use realloc and free visitors in fwdInteractionForceField.
 
+    void cleanup() override;
+
     void solve (const core::ExecParams* params, SReal dt, sofa::core::MultiVecCoordId xResult, sofa::core::MultiVecDerivId vResult) override;
 
     /// Given a displacement as computed by the linear system inversion, how much will it affect the velocity
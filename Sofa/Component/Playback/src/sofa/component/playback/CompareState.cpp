@@ -34,6 +34,7 @@
 
 #include <sstream>
 #include <algorithm>
+#include <cmath>
 
 using namespace sofa::type;
 using namespace sofa::defaulttype;
@@ -131,6 +132,36 @@ void CompareState::processCompareState()
 {
     SReal time = getContext()->getTime() + d_shift.getValue();
     time += getContext()->getDt() * 0.001;
+
+    if (m_trajectoryReader)
+    {
+        using trajectory::VectorId;
+        trajectory::TrajectoryReader::Frame frame;
+        if (!this->readNextFrame(time, frame)) return;
+
+        const double dsize = (double)this->mmodel->getSize();
+        if (frame.has(VectorId::Position))
+        {
+            m_lastTrajectoryX.assign(frame.data(VectorId::Position), frame.data(VectorId::Position) + frame.size(VectorId::Position));
+            const double currentError = compareStateVector(core::VecId::position(), frame.data(VectorId::Position),
+                                                           frame.size(VectorId::Position), mmodel->getCoordDimension());
+            totalError_X += currentError;
+            if (dsize != 0.0)
+                dofError_X += currentError/dsize;
+        }
+        if (frame.has(VectorId::Velocity))
+        {
+            const double currentError = compareStateVector(core::VecId::velocity(), frame.data(VectorId::Velocity),
+                                                           frame.size(VectorId::Velocity), mmodel->getDerivDimension());
+            totalError_V += currentError;
+            if (dsize != 0.0)
+                dofError_V += currentError/dsize;
+        }
+
+        msg_info() << "totalError_X = " << totalError_X << ", totalError_V = " << totalError_V;
+        return;
+    }
+
     //lastTime = time+0.00001;
     std::vector<std::string> validLines;
     if (!nextValidLines.empty() && last_time == getContext()->getTime())
@@ -174,6 +205,23 @@ void CompareState::processCompareState()
     msg_info() << "totalError_X = " << totalError_X << ", totalError_V = " << totalError_V;
 }
 
+SReal CompareState::compareStateVector(core::ConstVecId v, const SReal* reference, std::size_t size, std::size_t dimension)
+{
+    m_currentValues.resize(mmodel->getSize() * dimension);
+    mmodel->copyToBuffer(m_currentValues.data(), v, static_cast<unsigned int>(m_currentValues.size()));
+
+    // same measure as MechanicalObject::compareVec
+    const std::size_t count = std::min(size, m_currentValues.size());
+    if (count == 0) return 0;
+
+    SReal error = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        error += std::abs(reference[i] - m_currentValues[i]);
+    }
+    return error / count;
+}
+
 //-------------------------------- processCompareState------------------------------------
 void CompareState::draw(const core::visual::VisualParams* vparams)
 {
@@ -182,7 +230,7 @@ void CompareState::draw(const core::visual::VisualParams* vparams)
     SReal time = getContext()->getTime() + d_shift.getValue();
     time += getContext()->getDt() * 0.001;
     //lastTime = time+0.00001;
-    if (nextValidLines.empty() && last_time != getContext()->getTime())
+    if (!m_trajectoryReader && nextValidLines.empty() && last_time != getContext()->getTime())
     {
         last_time = getContext()->getTime();
         if (!this->readNext(time, nextValidLines))
@@ -206,15 +254,25 @@ void CompareState::draw(const core::visual::VisualParams* vparams)
         }
     }
 
-    if (mmodel && !last_X.empty())
+    const bool hasTrajectoryX = m_trajectoryReader && mmodel
+        && !m_lastTrajectoryX.empty() && m_lastTrajectoryX.size() == mmodel->getSize() * mmodel->getCoordDimension();
+
+    if (mmodel && (!last_X.empty() || hasTrajectoryX))
     {
         core::VecCoordId refX(core::VecCoordId::V_FIRST_DYNAMIC_INDEX);
         mmodel->vAvail(vparams, refX);
         mmodel->vAlloc(vparams, refX);
-        std::istringstream str(last_X);
-        std::string cmd;
-        str >> cmd;
-        mmodel->readVec(refX, str);
+        if (hasTrajectoryX)
+        {
+            mmodel->copyFromBuffer(refX, m_lastTrajectoryX.data(), static_cast<unsigned int>(m_lastTrajectoryX.size()));
+        }
+        else
+        {
+            std::istringstream str(last_X);
+            std::string cmd;
+            str >> cmd;
+            mmodel->readVec(refX, str);
+        }
 
         const core::objectmodel::BaseData* dataX = mmodel->baseRead(core::VecCoordId::position());
         const core::objectmodel::BaseData* dataRefX = mmodel->baseRead(refX);
@@ -78,6 +78,13 @@ protected :
     double last_time;
     std::string last_X, last_V;
     std::vector<std::string> nextValidLines;
+    /// last position read in a binary trajectory (for draw)
+    std::vector<SReal> m_lastTrajectoryX;
+    std::vector<SReal> m_currentValues;
+
+    /// Mean absolute difference between a vector of the mechanical state and reference values
+    /// read in a binary trajectory
+    SReal compareStateVector(core::ConstVecId v, const SReal* reference, std::size_t size, std::size_t dimension);
 };
 
 /// Create CompareState component in the graph each time needed
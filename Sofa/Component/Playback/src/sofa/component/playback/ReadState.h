@@ -23,21 +23,26 @@
 #include <sofa/component/playback/config.h>
 
 #include <sofa/core/objectmodel/BaseObject.h>
+#include <sofa/core/VecId.h>
 #include <sofa/simulation/AnimateBeginEvent.h>
 #include <sofa/simulation/AnimateEndEvent.h>
 #include <sofa/simulation/Visitor.h>
 #include <sofa/core/objectmodel/DataFileName.h>
+#include <sofa/component/playback/TrajectoryFile.h>
 
 #if SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
 #include <zlib.h>
 #endif
 
 #include <fstream>
+#include <memory>
 
 namespace sofa::component::playback
 {
 
 /** Read State vectors from file at each timestep
+ * Binary trajectory files (see TrajectoryFile.h) are memory-mapped, and the frame corresponding
+ * to the current time is accessed directly, without reading the previous ones.
 */
 class SOFA_COMPONENT_PLAYBACK_API ReadState: public core::objectmodel::BaseObject
 {
@@ -62,6 +67,11 @@ protected:
     double lastTime;
     double loopTime;
 
+    std::unique_ptr<trajectory::TrajectoryReader> m_trajectoryReader;
+    std::string m_trajectoryFilename;
+    /// loop count and index of the last frame read in the binary trajectory
+    std::uint64_t m_lastTrajectoryFrame;
+
     ReadState();
 
     ~ReadState() override;
@@ -82,6 +92,10 @@ public:
     /// Read the next values in the file corresponding to the last timestep before the given time
     bool readNext(double time, std::vector<std::string>& lines);
 
+    /// Binary trajectory version of readNext: read the last frame before the given time, if it
+    /// has not already been read
+    bool readNextFrame(double time, trajectory::TrajectoryReader::Frame& frame);
+
     /// Pre-construction check method called by ObjectFactory.
     /// Check that DataTypes matches the MechanicalState.
     template<class T>
@@ -94,6 +108,9 @@ public:
         return BaseObject::canCreate(obj, context, arg);
     }
 
+protected:
+    /// Copy a vector read in a binary trajectory in the mechanical state, resizing it if needed
+    bool setStateVector(core::VecId v, const SReal* values, std::size_t size, std::size_t dimension);
 
 };
 
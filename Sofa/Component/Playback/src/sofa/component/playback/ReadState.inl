@@ -31,7 +31,9 @@ using sofa::simulation::mechanicalvisitor::MechanicalProjectPositionAndVelocityV
 #include <sofa/simulation/mechanicalvisitor/MechanicalPropagateOnlyPositionAndVelocityVisitor.h>
 using sofa::simulation::mechanicalvisitor::MechanicalPropagateOnlyPositionAndVelocityVisitor;
 
+#include <cmath>
 #include <cstring>
+#include <limits>
 #include <sstream>
 
 namespace sofa::component::playback
@@ -55,6 +57,7 @@ ReadState::ReadState()
     , nextTime(0)
     , lastTime(0)
     , loopTime(0)
+    , m_lastTrajectoryFrame(std::numeric_limits<std::uint64_t>::max())
 {
     this->f_listening.setValue(true);
     d_scalePos.setGroup("Transformation");
@@ -103,10 +106,26 @@ void ReadState::reset()
     if (filename.empty())
     {
         msg_error() << "ERROR: empty filename";
+        m_trajectoryReader.reset();
+    }
+    else if (m_trajectoryReader && m_trajectoryFilename == filename)
+    {
+        // the mapped file is kept, frames are accessed from their time
+    }
+    else if (trajectory::isTrajectoryFile(filename))
+    {
+        m_trajectoryReader = std::make_unique<trajectory::TrajectoryReader>();
+        m_trajectoryFilename = filename;
+        if (!m_trajectoryReader->open(filename))
+        {
+            msg_error() << "Error opening file " << filename << ": " << m_trajectoryReader->getLastError();
+            m_trajectoryReader.reset();
+        }
     }
 #if SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
     else if (filename.size() >= 3 && filename.substr(filename.size()-3)==".gz")
     {
+        m_trajectoryReader.reset();
         gzfile = gzopen(filename.c_str(),"rb");
         if( !gzfile )
         {
@@ -116,6 +135,7 @@ void ReadState::reset()
 #endif
     else
     {
+        m_trajectoryReader.reset();
         infile = new std::ifstream(filename.c_str());
         if( !infile->is_open() )
         {
@@ -127,6 +147,7 @@ void ReadState::reset()
     nextTime = 0;
     lastTime = 0;
     loopTime = 0;
+    m_lastTrajectoryFrame = std::numeric_limits<std::uint64_t>::max();
 }
 
 void ReadState::handleEvent(sofa::core::objectmodel::Event* event)
@@ -230,37 +251,115 @@ bool ReadState::readNext(double time, std::vector<std::string>& validLines)
     return true;
 }
 
+bool ReadState::readNextFrame(double time, trajectory::TrajectoryReader::Frame& frame)
+{
+    if (!mmodel || !m_trajectoryReader) return false;
+    lastTime = time;
+
+    const std::size_t nbFrames = m_trajectoryReader->getNbFrames();
+    if (nbFrames == 0) return false;
+
+    // same convention as the text format: when looping, the times of the file are shifted by
+    // the time of its last frame
+    std::uint64_t loop = 0;
+    const double loopPeriod = m_trajectoryReader->getFrameTime(nbFrames - 1);
+    if (d_loop.getValue() && loopPeriod > 0 && time >= loopPeriod)
+    {
+        loop = static_cast<std::uint64_t>(std::floor(time / loopPeriod));
+        time -= static_cast<double>(loop) * loopPeriod;
+    }
+
+    const std::size_t index = m_trajectoryReader->findFrame(time);
+    if (index == trajectory::TrajectoryReader::InvalidFrame) return false;
+
+    const std::uint64_t frameId = loop * nbFrames + index;
+    if (frameId == m_lastTrajectoryFrame) return false;
+    m_lastTrajectoryFrame = frameId;
+
+    if (!m_trajectoryReader->readFrame(index, frame))
+    {
+        msg_error() << "Error reading " << d_filename.getFullPath() << ": " << m_trajectoryReader->getLastError();
+        return false;
+    }
+    return true;
+}
+
+bool ReadState::setStateVector(core::VecId v, const SReal* values, std::size_t size, std::size_t dimension)
+{
+    if (dimension == 0 || size % dimension != 0)
+    {
+        msg_error() << "The size of the vector read in " << d_filename.getFullPath()
+                    << " (" << size << ") is not a multiple of the dimension of the mechanical state (" << dimension << ")";
+        return false;
+    }
+    if (mmodel->getSize() != size / dimension)
+    {
+        mmodel->resize(size / dimension);
+    }
+    mmodel->copyFromBuffer(v, values, static_cast<unsigned int>(size));
+    return true;
+}
+
 void ReadState::processReadState()
 {
     double time = getContext()->getTime() + d_shift.getValue();
-    std::vector<std::string> validLines;
-    if (!readNext(time, validLines)) return;
     bool updated = false;
 
     const double scale = d_scalePos.getValue();
     const Vec3& rotation = d_rotation.getValue();
     const Vec3& translation = d_translation.getValue();
 
-    for (std::vector<std::string>::iterator it=validLines.begin(); it!=validLines.end(); ++it)
+    const auto applyTransformation = [&]()
     {
-        std::istringstream str(*it);
-        std::string cmd;
-        str >> cmd;
-        if (cmd == "X=")
-        {
-            mmodel->readVec(core::VecId::position(), str);
-            mmodel->applyScale(scale,scale,scale);
-            mmodel->applyRotation(rotation[0],rotation[1],rotation[2]);
-            mmodel->applyTranslation(translation[0],translation[1],translation[2]);
+        mmodel->applyScale(scale,scale,scale);
+        mmodel->applyRotation(rotation[0],rotation[1],rotation[2]);
+        mmodel->applyTranslation(translation[0],translation[1],translation[2]);
+    };
 
+    if (m_trajectoryReader)
+    {
+        using trajectory::VectorId;
+        trajectory::TrajectoryReader::Frame frame;
+        if (!readNextFrame(time, frame)) return;
+
+        if (frame.has(VectorId::Position)
+            && setStateVector(core::VecId::position(), frame.data(VectorId::Position),
+                              frame.size(VectorId::Position), mmodel->getCoordDimension()))
+        {
+            applyTransformation();
             updated = true;
         }
-        else if (cmd == "V=")
+        if (frame.has(VectorId::Velocity)
+            && setStateVector(core::VecId::velocity(), frame.data(VectorId::Velocity),
+                              frame.size(VectorId::Velocity), mmodel->getDerivDimension()))
         {
-            mmodel->readVec(core::VecId::velocity(), str);
             updated = true;
         }
     }
+    else
+    {
+        std::vector<std::string> validLines;
+        if (!readNext(time, validLines)) return;
+
+        for (std::vector<std::string>::iterator it=validLines.begin(); it!=validLines.end(); ++it)
+        {
+            std::istringstream str(*it);
+            std::string cmd;
+            str >> cmd;
+            if (cmd == "X=")
+            {
+                mmodel->readVec(core::VecId::position(), str);
+                applyTransformation();
+
+                updated = true;
+            }
+            else if (cmd == "V=")
+            {
+                mmodel->readVec(core::VecId::velocity(), str);
+                updated = true;
+            }
+        }
+    }
 
     if (updated)
     {
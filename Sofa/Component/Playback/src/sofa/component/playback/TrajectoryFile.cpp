@@ -0,0 +1,570 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/component/playback/TrajectoryFile.h>
+#include <sofa/helper/logging/Messaging.h>
+
+#if SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+namespace sofa::component::playback::trajectory
+{
+
+namespace
+{
+
+constexpr std::uint64_t padding8(std::uint64_t size)
+{
+    return (8 - size % 8) % 8;
+}
+
+template<class T>
+T readValue(const char* src)
+{
+    T value;
+    std::memcpy(&value, src, sizeof(T));
+    return value;
+}
+
+template<class T>
+void appendValue(std::vector<char>& buffer, const T& value)
+{
+    const auto* bytes = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+}
+
+bool isTrajectoryFile(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    std::array<char, 8> magic {};
+    file.read(magic.data(), magic.size());
+    return file.good() && magic == FileMagic;
+}
+
+TrajectoryWriter::~TrajectoryWriter()
+{
+    close();
+}
+
+bool TrajectoryWriter::open(const std::string& filename, Compression compression,
+                            std::uint32_t coordDimension, std::uint32_t derivDimension)
+{
+    close();
+
+    m_file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open())
+    {
+        return false;
+    }
+
+#if !SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
+    if (compression == Compression::Zlib)
+    {
+        msg_warning("TrajectoryWriter") << "zlib is not available: frames of " << filename
+                                        << " are not compressed";
+        compression = Compression::None;
+    }
+#endif
+
+    m_header = FileHeader{};
+    m_header.compression = compression;
+    m_header.coordDimension = coordDimension;
+    m_header.derivDimension = derivDimension;
+    m_index.clear();
+
+    m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(FileHeader));
+    m_offset = sizeof(FileHeader);
+    return m_file.good();
+}
+
+bool TrajectoryWriter::writeFrame(const Frame& frame)
+{
+    if (!m_file.is_open())
+    {
+        return false;
+    }
+
+    m_payload.clear();
+    appendValue(m_payload, frame.time);
+    for (std::size_t v = 0; v < NbVectors; ++v)
+    {
+        const std::uint64_t size = frame.vectors[v] ? frame.sizes[v] : 0;
+        appendValue(m_payload, size);
+        if (size != 0)
+        {
+            m_header.vectorMask |= 1u << v;
+            const auto* bytes = reinterpret_cast<const char*>(frame.vectors[v]);
+            m_payload.insert(m_payload.end(), bytes, bytes + size * sizeof(SReal));
+            m_payload.resize(m_payload.size() + padding8(size * sizeof(SReal)), 0);
+        }
+    }
+
+    ChunkHeader chunk;
+    chunk.time = frame.time;
+    chunk.rawSize = m_payload.size();
+    chunk.storedSize = m_payload.size();
+    const char* stored = m_payload.data();
+
+#if SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
+    if (m_header.compression == Compression::Zlib)
+    {
+        uLongf compressedSize = compressBound(static_cast<uLong>(m_payload.size()));
+        m_compressed.resize(compressedSize);
+        if (compress2(reinterpret_cast<Bytef*>(m_compressed.data()), &compressedSize,
+                      reinterpret_cast<const Bytef*>(m_payload.data()),
+                      static_cast<uLong>(m_payload.size()), Z_BEST_SPEED) == Z_OK
+            && compressedSize < m_payload.size())
+        {
+            // incompressible frames are stored as is
+            chunk.storedSize = compressedSize;
+            stored = m_compressed.data();
+        }
+    }
+#endif
+
+    static constexpr std::array<char, 8> zeros {};
+    const std::uint64_t padding = padding8(chunk.storedSize);
+
+    m_file.write(reinterpret_cast<const char*>(&chunk), sizeof(ChunkHeader));
+    m_file.write(stored, static_cast<std::streamsize>(chunk.storedSize));
+    m_file.write(zeros.data(), static_cast<std::streamsize>(padding));
+
+    m_index.push_back({frame.time, m_offset});
+    m_offset += sizeof(ChunkHeader) + chunk.storedSize + padding;
+
+    return m_file.good();
+}
+
+void TrajectoryWriter::close()
+{
+    if (!m_file.is_open())
+    {
+        return;
+    }
+
+    m_header.nbFrames = m_index.size();
+    m_header.indexOffset = m_offset;
+    m_file.write(reinterpret_cast<const char*>(m_index.data()),
+                 static_cast<std::streamsize>(m_index.size() * sizeof(FrameIndexEntry)));
+    m_file.seekp(0);
+    m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(FileHeader));
+    m_file.close();
+}
+
+bool TrajectoryReader::open(const std::string& filename)
+{
+    close();
+
+    if (!m_file.open(filename))
+    {
+        m_lastError = "cannot open " + filename + ": " + m_file.getLastError();
+        return false;
+    }
+
+    if (m_file.size() < sizeof(FileHeader))
+    {
+        m_lastError = filename + " is not a trajectory file";
+        close();
+        return false;
+    }
+
+    std::memcpy(&m_header, m_file.data(), sizeof(FileHeader));
+    if (m_header.magic != FileMagic)
+    {
+        m_lastError = filename + " is not a trajectory file";
+        close();
+        return false;
+    }
+    if (m_header.version > FormatVersion)
+    {
+        m_lastError = filename + " has been written with a newer version of the format ("
+                      + std::to_string(m_header.version) + ")";
+        close();
+        return false;
+    }
+    if (m_header.scalarSize != sizeof(float) && m_header.scalarSize != sizeof(double))
+    {
+        m_lastError = filename + " has an unsupported scalar size (" + std::to_string(m_header.scalarSize) + ")";
+        close();
+        return false;
+    }
+#if !SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
+    if (m_header.compression == Compression::Zlib)
+    {
+        m_lastError = filename + " is compressed but zlib is not available";
+        close();
+        return false;
+    }
+#endif
+
+    if (!readIndex())
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void TrajectoryReader::close()
+{
+    m_file.close();
+    m_header = FileHeader{};
+    m_index.clear();
+}
+
+bool TrajectoryReader::readIndex()
+{
+    const std::uint64_t indexSize = m_header.nbFrames * sizeof(FrameIndexEntry);
+    if (m_header.indexOffset == 0 || m_header.indexOffset + indexSize > m_file.size())
+    {
+        // the writer has not been closed properly
+        return rebuildIndex();
+    }
+
+    m_index.resize(m_header.nbFrames);
+    std::memcpy(m_index.data(), m_file.data() + m_header.indexOffset, indexSize);
+    return true;
+}
+
+bool TrajectoryReader::rebuildIndex()
+{
+    m_index.clear();
+
+    const char* data = reinterpret_cast<const char*>(m_file.data());
+    std::uint64_t offset = m_header.headerSize;
+    while (offset + sizeof(ChunkHeader) <= m_file.size())
+    {
+        const auto chunk = readValue<ChunkHeader>(data + offset);
+        if (chunk.magic != ChunkMagic || offset + sizeof(ChunkHeader) + chunk.storedSize > m_file.size())
+        {
+            break;
+        }
+        m_index.push_back({chunk.time, offset});
+        offset += sizeof(ChunkHeader) + chunk.storedSize + padding8(chunk.storedSize);
+    }
+
+    m_header.nbFrames = m_index.size();
+    return true;
+}
+
+double TrajectoryReader::getDuration() const
+{
+    return m_index.empty() ? 0. : m_index.back().time - m_index.front().time;
+}
+
+std::size_t TrajectoryReader::findFrame(double time) const
+{
+    if (m_index.empty() || time < m_index.front().time)
+    {
+        return InvalidFrame;
+    }
+
+    const std::size_t nbFrames = m_index.size();
+    std::size_t frame = 0;
+    const double duration = getDuration();
+    if (nbFrames > 1 && duration > 0)
+    {
+        const double estimation = (time - m_index.front().time) / duration * static_cast<double>(nbFrames - 1);
+        frame = static_cast<std::size_t>(std::min(std::floor(estimation), static_cast<double>(nbFrames - 1)));
+    }
+
+    while (frame + 1 < nbFrames && m_index[frame + 1].time <= time)
+    {
+        ++frame;
+    }
+    while (frame > 0 && m_index[frame].time > time)
+    {
+        --frame;
+    }
+    return frame;
+}
+
+bool TrajectoryReader::readFrame(std::size_t frame, Frame& values)
+{
+    if (frame >= m_index.size())
+    {
+        m_lastError = "invalid frame " + std::to_string(frame);
+        return false;
+    }
+
+    const char* data = reinterpret_cast<const char*>(m_file.data());
+    const std::uint64_t offset = m_index[frame].offset;
+    if (offset + sizeof(ChunkHeader) > m_file.size())
+    {
+        m_lastError = "truncated frame " + std::to_string(frame);
+        return false;
+    }
+    const auto chunk = readValue<ChunkHeader>(data + offset);
+    if (chunk.magic != ChunkMagic || offset + sizeof(ChunkHeader) + chunk.storedSize > m_file.size())
+    {
+        m_lastError = "corrupted frame " + std::to_string(frame);
+        return false;
+    }
+
+    const char* payload = data + offset + sizeof(ChunkHeader);
+    if (chunk.storedSize != chunk.rawSize)
+    {
+#if SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
+        m_uncompressed.resize(chunk.rawSize);
+        uLongf rawSize = static_cast<uLongf>(chunk.rawSize);
+        if (uncompress(reinterpret_cast<Bytef*>(m_uncompressed.data()), &rawSize,
+                       reinterpret_cast<const Bytef*>(payload), static_cast<uLong>(chunk.storedSize)) != Z_OK
+            || rawSize != chunk.rawSize)
+        {
+            m_lastError = "cannot uncompress frame " + std::to_string(frame);
+            return false;
+        }
+        payload = m_uncompressed.data();
+#else
+        m_lastError = "cannot uncompress frame " + std::to_string(frame) + ": zlib is not available";
+        return false;
+#endif
+    }
+
+    const std::uint64_t scalarSize = m_header.scalarSize;
+    const bool convert = scalarSize != sizeof(SReal);
+
+    // first pass: sizes and offsets of the vectors in the payload
+    std::array<std::uint64_t, NbVectors> vectorOffsets {};
+    std::uint64_t position = sizeof(double);
+    std::size_t totalSize = 0;
+    for (std::size_t v = 0; v < NbVectors; ++v)
+    {
+        if (position + sizeof(std::uint64_t) > chunk.rawSize)
+        {
+            m_lastError = "corrupted frame " + std::to_string(frame);
+            return false;
+        }
+        const auto size = readValue<std::uint64_t>(payload + position);
+        position += sizeof(std::uint64_t);
+        vectorOffsets[v] = position;
+        values.sizes[v] = static_cast<std::size_t>(size);
+        totalSize += static_cast<std::size_t>(size);
+        position += size * scalarSize + padding8(size * scalarSize);
+        if (position > chunk.rawSize)
+        {
+            m_lastError = "corrupted frame " + std::to_string(frame);
+            return false;
+        }
+    }
+
+    values.time = readValue<double>(payload);
+
+    if (convert)
+    {
+        m_converted.resize(totalSize);
+    }
+
+    SReal* converted = m_converted.data();
+    for (std::size_t v = 0; v < NbVectors; ++v)
+    {
+        const char* src = payload + vectorOffsets[v];
+        if (values.sizes[v] == 0)
+        {
+            values.vectors[v] = nullptr;
+        }
+        else if (!convert)
+        {
+            values.vectors[v] = reinterpret_cast<const SReal*>(src);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < values.sizes[v]; ++i)
+            {
+                converted[i] = scalarSize == sizeof(float)
+                    ? static_cast<SReal>(readValue<float>(src + i * scalarSize))
+                    : static_cast<SReal>(readValue<double>(src + i * scalarSize));
+            }
+            values.vectors[v] = converted;
+            converted += values.sizes[v];
+        }
+    }
+
+    return true;
+}
+
+namespace
+{
+
+/// Line reader of text trajectories, transparently reading gzipped files if zlib is available
+class TextLineReader
+{
+public:
+    explicit TextLineReader(const std::string& filename)
+    {
+#if SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
+        m_gzfile = gzopen(filename.c_str(), "rb");
+#else
+        m_file.open(filename);
+#endif
+    }
+
+    ~TextLineReader()
+    {
+#if SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
+        if (m_gzfile)
+        {
+            gzclose(m_gzfile);
+        }
+#endif
+    }
+
+    bool isOpen() const
+    {
+#if SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
+        return m_gzfile != nullptr;
+#else
+        return m_file.is_open();
+#endif
+    }
+
+    bool getline(std::string& line)
+    {
+        line.clear();
+#if SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
+        char buf[4097];
+        bool read = false;
+        while (gzgets(m_gzfile, buf, sizeof(buf)) != nullptr && buf[0])
+        {
+            read = true;
+            const size_t l = strlen(buf);
+            if (buf[l-1] == '\n')
+            {
+                buf[l-1] = '\0';
+                line += buf;
+                break;
+            }
+            line += buf;
+        }
+        return read;
+#else
+        return static_cast<bool>(std::getline(m_file, line));
+#endif
+    }
+
+private:
+#if SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
+    gzFile m_gzfile { nullptr };
+#else
+    std::ifstream m_file;
+#endif
+};
+
+}
+
+bool convertTextTrajectory(const std::string& textFilename, const std::string& binaryFilename,
+                           Compression compression, std::uint32_t coordDimension, std::uint32_t derivDimension)
+{
+    TextLineReader input(textFilename);
+    if (!input.isOpen())
+    {
+        msg_error("TrajectoryFile") << "Error opening file " << textFilename;
+        return false;
+    }
+
+    TrajectoryWriter writer;
+    if (!writer.open(binaryFilename, compression, coordDimension, derivDimension))
+    {
+        msg_error("TrajectoryFile") << "Error creating file " << binaryFilename;
+        return false;
+    }
+
+    bool hasFrame = false;
+    TrajectoryWriter::Frame frame;
+    std::array<std::vector<SReal>, NbVectors> vectors;
+
+    const auto flushFrame = [&]()
+    {
+        if (!hasFrame)
+        {
+            return true;
+        }
+        for (std::size_t v = 0; v < NbVectors; ++v)
+        {
+            frame.vectors[v] = vectors[v].data();
+            frame.sizes[v] = vectors[v].size();
+        }
+        return writer.writeFrame(frame);
+    };
+
+    std::string line, cmd;
+    while (input.getline(line))
+    {
+        std::istringstream str(line);
+        if (!(str >> cmd))
+        {
+            continue;
+        }
+
+        if (cmd == "T=")
+        {
+            if (!flushFrame())
+            {
+                msg_error("TrajectoryFile") << "Error writing file " << binaryFilename;
+                return false;
+            }
+            hasFrame = true;
+            frame.time = 0;
+            str >> frame.time;
+            for (auto& v : vectors)
+            {
+                v.clear();
+            }
+            continue;
+        }
+
+        VectorId vectorId;
+        if (cmd == "X=")       vectorId = VectorId::Position;
+        else if (cmd == "X0=") vectorId = VectorId::RestPosition;
+        else if (cmd == "V=")  vectorId = VectorId::Velocity;
+        else if (cmd == "F=")  vectorId = VectorId::Force;
+        else continue;
+
+        auto& values = vectors[static_cast<std::size_t>(vectorId)];
+        values.clear();
+        SReal value;
+        while (str >> value)
+        {
+            values.push_back(value);
+        }
+    }
+
+    if (!flushFrame())
+    {
+        msg_error("TrajectoryFile") << "Error writing file " << binaryFilename;
+        return false;
+    }
+
+    msg_info("TrajectoryFile") << "Converted " << writer.getNbFrames() << " frames from "
+                               << textFilename << " to " << binaryFilename;
+    writer.close();
+    return true;
+}
+
+} // namespace sofa::component::playback::trajectory
@@ -0,0 +1,215 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/playback/config.h>
+
+#include <sofa/helper/system/MemoryMappedFile.h>
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace sofa::component::playback::trajectory
+{
+
+/**
+ * Binary trajectory format, used by WriteState and ReadState for files with the ".trj" extension.
+ *
+ * Layout of a file:
+ * - a fixed-size FileHeader
+ * - one chunk per frame: a ChunkHeader followed by the (optionally compressed) frame payload,
+ *   padded to 8 bytes
+ * - the frame index: one FrameIndexEntry per frame, located at FileHeader::indexOffset
+ *
+ * The frame payload is the frame time (double), followed, for each of the NbVectors vectors, by
+ * the number of scalars (uint64) and the scalars themselves, padded to 8 bytes. Vectors which are
+ * not recorded have 0 scalars.
+ *
+ * The index and the header are written when the file is closed. If the writer did not close the
+ * file properly, the reader rebuilds the index by walking through the chunk headers.
+ */
+
+enum class VectorId : std::uint32_t
+{
+    Position = 0,
+    RestPosition,
+    Velocity,
+    Force,
+    NbVectors
+};
+constexpr std::size_t NbVectors = static_cast<std::size_t>(VectorId::NbVectors);
+
+enum class Compression : std::uint32_t
+{
+    None = 0,
+    Zlib = 1
+};
+
+constexpr std::array<char, 8> FileMagic { 'S', 'O', 'F', 'A', 'T', 'R', 'J', '\0' };
+constexpr std::uint32_t ChunkMagic = 0x454d5246; // "FRME"
+constexpr std::uint32_t FormatVersion = 1;
+
+struct FileHeader
+{
+    std::array<char, 8> magic { FileMagic };
+    std::uint32_t version { FormatVersion };
+    std::uint32_t headerSize { sizeof(FileHeader) };
+    std::uint32_t scalarSize { sizeof(SReal) };
+    Compression compression { Compression::None };
+    /// bit i is set if the vector VectorId(i) is recorded
+    std::uint32_t vectorMask { 0 };
+    std::uint32_t coordDimension { 0 };
+    std::uint32_t derivDimension { 0 };
+    std::uint32_t reserved { 0 };
+    std::uint64_t nbFrames { 0 };
+    /// 0 if the index has not been written
+    std::uint64_t indexOffset { 0 };
+    std::uint64_t reserved2 { 0 };
+};
+static_assert(sizeof(FileHeader) == 64);
+
+struct ChunkHeader
+{
+    std::uint32_t magic { ChunkMagic };
+    std::uint32_t reserved { 0 };
+    double time { 0 };
+    /// size of the payload in the file
+    std::uint64_t storedSize { 0 };
+    /// size of the uncompressed payload. The payload is not compressed if both sizes are equal.
+    std::uint64_t rawSize { 0 };
+};
+static_assert(sizeof(ChunkHeader) == 32);
+
+struct FrameIndexEntry
+{
+    double time { 0 };
+    /// offset of the ChunkHeader in the file
+    std::uint64_t offset { 0 };
+};
+static_assert(sizeof(FrameIndexEntry) == 16);
+
+/// Check the magic number at the beginning of a file
+SOFA_COMPONENT_PLAYBACK_API bool isTrajectoryFile(const std::string& filename);
+
+/// Writes frames sequentially in a binary trajectory file
+class SOFA_COMPONENT_PLAYBACK_API TrajectoryWriter
+{
+public:
+    ~TrajectoryWriter();
+
+    /// Create the file and write a provisional header.
+    /// A requested compression which is not available is replaced by Compression::None.
+    bool open(const std::string& filename, Compression compression,
+              std::uint32_t coordDimension, std::uint32_t derivDimension);
+
+    /// Write the index and the final header, and close the file
+    void close();
+
+    bool isOpen() const { return m_file.is_open(); }
+
+    /// Data of a frame: vectors[i] points to sizes[i] scalars of the vector VectorId(i)
+    struct Frame
+    {
+        double time { 0 };
+        std::array<const SReal*, NbVectors> vectors {};
+        std::array<std::size_t, NbVectors> sizes {};
+    };
+
+    bool writeFrame(const Frame& frame);
+
+    std::size_t getNbFrames() const { return m_index.size(); }
+
+private:
+    std::ofstream m_file;
+    FileHeader m_header;
+    std::vector<FrameIndexEntry> m_index;
+    std::vector<char> m_payload;
+    std::vector<char> m_compressed;
+    std::uint64_t m_offset { 0 };
+};
+
+/// Random access to the frames of a memory-mapped binary trajectory file
+class SOFA_COMPONENT_PLAYBACK_API TrajectoryReader
+{
+public:
+    bool open(const std::string& filename);
+    void close();
+
+    bool isOpen() const { return m_file.isOpen(); }
+
+    const FileHeader& getHeader() const { return m_header; }
+
+    std::size_t getNbFrames() const { return m_index.size(); }
+    double getFrameTime(std::size_t frame) const { return m_index[frame].time; }
+
+    /// Time of the last frame minus time of the first one
+    double getDuration() const;
+
+    static constexpr std::size_t InvalidFrame = static_cast<std::size_t>(-1);
+
+    /// @return the last frame with a time lower or equal to the given time, or InvalidFrame if
+    /// the time is before the first frame.
+    /// The search starts from an estimation assuming a regular period between frames, so it
+    /// runs in constant time for trajectories recorded at a fixed period.
+    std::size_t findFrame(double time) const;
+
+    /// Values of a frame. The pointers remain valid until the next call to readFrame or close.
+    struct Frame
+    {
+        double time { 0 };
+        std::array<const SReal*, NbVectors> vectors {};
+        std::array<std::size_t, NbVectors> sizes {};
+
+        bool has(VectorId v) const { return sizes[static_cast<std::size_t>(v)] != 0; }
+        const SReal* data(VectorId v) const { return vectors[static_cast<std::size_t>(v)]; }
+        std::size_t size(VectorId v) const { return sizes[static_cast<std::size_t>(v)]; }
+    };
+
+    /// Uncompressed frames with the same scalar type as SReal are read directly from the mapped
+    /// memory, without any copy.
+    bool readFrame(std::size_t frame, Frame& values);
+
+    const std::string& getLastError() const { return m_lastError; }
+
+private:
+    bool readIndex();
+    bool rebuildIndex();
+
+    helper::system::MemoryMappedFile m_file;
+    FileHeader m_header;
+    std::vector<FrameIndexEntry> m_index;
+    std::vector<char> m_uncompressed;
+    std::vector<SReal> m_converted;
+    std::string m_lastError;
+};
+
+/// Convert a text file written by WriteState (optionally gzipped) into a binary trajectory file.
+/// The dimensions are only stored as information in the header, they can be 0 if unknown.
+SOFA_COMPONENT_PLAYBACK_API bool convertTextTrajectory(const std::string& textFilename,
+                                                       const std::string& binaryFilename,
+                                                       Compression compression = Compression::None,
+                                                       std::uint32_t coordDimension = 0,
+                                                       std::uint32_t derivDimension = 0);
+
+} // namespace sofa::component::playback::trajectory
@@ -31,12 +31,14 @@
 #include <sofa/defaulttype/DataTypeInfo.h>
 #include <sofa/simulation/Visitor.h>
 #include <sofa/core/objectmodel/DataFileName.h>
+#include <sofa/component/playback/TrajectoryFile.h>
 
 #if SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
 #include <zlib.h>
 #endif
 
 #include <fstream>
+#include <memory>
 
 namespace sofa::component::playback
 {
@@ -46,6 +48,7 @@ namespace sofa::component::playback
  * The DoFs to print can be chosen using DOFsX and DOFsV
  * Stop to write the state if the kinematic energy reach a given threshold (stopAt)
  * The energy will be measured at each period determined by keperiod
+ * Files with the ".trj" extension are written in the binary trajectory format (see TrajectoryFile.h)
 */
 class SOFA_COMPONENT_PLAYBACK_API WriteState: public core::objectmodel::BaseObject
 {
@@ -63,6 +66,7 @@ public:
     Data < type::vector<unsigned int> > d_DOFsV; ///< set the velocity DOFs to write
     Data < double > d_stopAt; ///< stop the simulation when the given threshold is reached
     Data < double > d_keperiod; ///< set the period to measure the kinetic energy increase
+    Data < bool > d_compressFrames; ///< compress each frame of a binary trajectory file (.trj) with zlib
 
 protected:
     core::behavior::BaseMechanicalState* mmodel;
@@ -70,6 +74,9 @@ protected:
 #if SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
     gzFile gzfile;
 #endif
+    std::unique_ptr<trajectory::TrajectoryWriter> m_trajectoryWriter;
+    /// buffers used to write the state vectors in the binary trajectory
+    std::array<std::vector<SReal>, trajectory::NbVectors> m_trajectoryBuffers;
     unsigned int nextIteration;
     double lastTime;
     bool kineticEnergyThresholdReached;
@@ -92,6 +99,9 @@ public:
 
     void handleEvent(sofa::core::objectmodel::Event* event) override;
 
+    /// @return true if the given file name has the extension of the binary trajectory format
+    static bool isBinaryTrajectoryFilename(const std::string& filename);
+
 
     /// Pre-construction check method called by ObjectFactory.
     /// Check that DataTypes matches the MechanicalState.
@@ -106,6 +116,9 @@ public:
         return BaseObject::canCreate(obj, context, arg);
     }
 
+protected:
+    void writeTrajectoryFrame(double time);
+
 };
 
 ///Create WriteState component in the graph each time needed
@@ -44,6 +44,7 @@ WriteState::WriteState()
     , d_DOFsV( initData(&d_DOFsV, type::vector<unsigned int>(0), "DOFsV", "set the velocity DOFs to write"))
     , d_stopAt( initData(&d_stopAt, 0.0, "stopAt", "stop the simulation when the given threshold is reached"))
     , d_keperiod( initData(&d_keperiod, 0.0, "keperiod", "set the period to measure the kinetic energy increase"))
+    , d_compressFrames( initData(&d_compressFrames, false, "compressFrames", "compress each frame of a binary trajectory file (.trj) with zlib"))
     , mmodel(nullptr)
     , outfile(nullptr)
 #if SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
@@ -86,6 +87,19 @@ void WriteState::init()
     const std::string& filename = d_filename.getFullPath();
     if (!filename.empty())
     {
+        if (isBinaryTrajectoryFilename(filename))
+        {
+            m_trajectoryWriter = std::make_unique<trajectory::TrajectoryWriter>();
+            const auto compression = d_compressFrames.getValue() ? trajectory::Compression::Zlib : trajectory::Compression::None;
+            if (!m_trajectoryWriter->open(filename, compression,
+                                          mmodel ? mmodel->getCoordDimension() : 0,
+                                          mmodel ? mmodel->getDerivDimension() : 0))
+            {
+                msg_error() << "Error creating file " << filename;
+                m_trajectoryWriter.reset();
+            }
+        }
+        else
 #if SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
         if (filename.size() >= 3 && filename.substr(filename.size()-3)==".gz")
         {
@@ -222,10 +236,13 @@ void WriteState::init()
 void WriteState::reinit(){
 if (outfile)
     delete outfile;
+outfile = nullptr;
 #if SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
 if (gzfile)
     gzclose(gzfile);
+gzfile = nullptr;
 #endif
+m_trajectoryWriter.reset();
 init();
 }
 void WriteState::reset()
@@ -246,7 +263,7 @@ void WriteState::handleEvent(sofa::core::objectmodel::Event* event)
     if (simulation::AnimateBeginEvent::checkEventType(event))
     {
         if (!mmodel) return;
-        if (!outfile
+        if (!outfile && !m_trajectoryWriter
 #if SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
             && !gzfile
 #endif
@@ -318,6 +335,11 @@ void WriteState::handleEvent(sofa::core::objectmodel::Event* event)
         }
         if (writeCurrent)
         {
+            if (m_trajectoryWriter)
+            {
+                writeTrajectoryFrame(time);
+            }
+            else
 #if SOFA_COMPONENT_PLAYBACK_HAVE_ZLIB
             if (gzfile)
             {
@@ -385,4 +407,38 @@ void WriteState::handleEvent(sofa::core::objectmodel::Event* event)
     }
 }
 
+bool WriteState::isBinaryTrajectoryFilename(const std::string& filename)
+{
+    return filename.size() >= 4 && filename.substr(filename.size()-4) == ".trj";
+}
+
+void WriteState::writeTrajectoryFrame(double time)
+{
+    trajectory::TrajectoryWriter::Frame frame;
+    frame.time = time;
+
+    const auto addVector = [&](trajectory::VectorId id, core::ConstVecId v, std::size_t dimension)
+    {
+        auto& buffer = m_trajectoryBuffers[static_cast<std::size_t>(id)];
+        buffer.resize(mmodel->getSize() * dimension);
+        mmodel->copyToBuffer(buffer.data(), v, static_cast<unsigned int>(buffer.size()));
+        frame.vectors[static_cast<std::size_t>(id)] = buffer.data();
+        frame.sizes[static_cast<std::size_t>(id)] = buffer.size();
+    };
+
+    if (d_writeX.getValue())
+        addVector(trajectory::VectorId::Position, core::VecId::position(), mmodel->getCoordDimension());
+    if (d_writeX0.getValue())
+        addVector(trajectory::VectorId::RestPosition, core::VecId::restPosition(), mmodel->getCoordDimension());
+    if (d_writeV.getValue())
+        addVector(trajectory::VectorId::Velocity, core::VecId::velocity(), mmodel->getDerivDimension());
+    if (d_writeF.getValue())
+        addVector(trajectory::VectorId::Force, core::VecId::force(), mmodel->getDerivDimension());
+
+    if (!m_trajectoryWriter->writeFrame(frame))
+    {
+        msg_error() << "Error writing the frame at time " << time << " in " << d_filename.getFullPath();
+    }
+}
+
 } // namespace sofa::component::playback
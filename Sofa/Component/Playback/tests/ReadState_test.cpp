@@ -28,11 +28,27 @@ using sofa::simulation::Node;
 #include <sofa/type/Vec.h>
 using sofa::type::Vec3;
 
+#include <sofa/component/playback/TrajectoryFile.h>
+
 class ReadState_test : public BaseSimulationTest
 {
 public:
     /// Run seven steps of simulation then check results
     bool testDefaultBehavior()
+    {
+        return testReadFile(std::string(SOFA_COMPONENT_PLAYBACK_TEST_FILES_DIR)+"particleGravityX.data");
+    }
+
+    /// Same as testDefaultBehavior, with the file converted to the binary trajectory format
+    bool testBinaryTrajectory(sofa::component::playback::trajectory::Compression compression)
+    {
+        const std::string filename = std::string(SOFA_COMPONENT_PLAYBACK_TEST_BUILD_DIR)+"particleGravityX_ReadState.trj";
+        EXPECT_TRUE(sofa::component::playback::trajectory::convertTextTrajectory(
+            std::string(SOFA_COMPONENT_PLAYBACK_TEST_FILES_DIR)+"particleGravityX.data", filename, compression));
+        return testReadFile(filename);
+    }
+
+    bool testReadFile(const std::string& filename)
     {
         const double dt = 0.01;
         const auto simulation = sofa::simpleapi::createSimulation();
@@ -50,7 +66,7 @@ public:
                                                         {{"size", "1"}});
 
         sofa::simpleapi::createObject(childNode, "ReadState",
-                                      {{"filename", std::string(SOFA_COMPONENT_PLAYBACK_TEST_FILES_DIR)+"particleGravityX.data"}});
+                                      {{"filename", filename}});
 
         sofa::simulation::node::initRoot(root.get());
         for(int i=0; i<7; i++)
@@ -91,6 +107,17 @@ TEST_F(ReadState_test , test_defaultBehavior)
     ASSERT_TRUE( this->testDefaultBehavior() );
 }
 
+/// Test : read positions of a particle falling under gravity from a binary trajectory
+TEST_F(ReadState_test , test_binaryTrajectory)
+{
+    ASSERT_TRUE( this->testBinaryTrajectory(sofa::component::playback::trajectory::Compression::None) );
+}
+
+TEST_F(ReadState_test , test_binaryTrajectoryCompressed)
+{
+    ASSERT_TRUE( this->testBinaryTrajectory(sofa::component::playback::trajectory::Compression::Zlib) );
+}
+
 /// Test : when happens when unable to load the file ?
 TEST_F(ReadState_test , test_loadFailure)
 {
@@ -0,0 +1,173 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <sofa/component/playback/TrajectoryFile.h>
+
+#include <cstddef>
+#include <fstream>
+#include <numeric>
+
+namespace sofa
+{
+
+using namespace component::playback::trajectory;
+
+namespace
+{
+
+std::string buildFile(const std::string& name)
+{
+    return std::string(SOFA_COMPONENT_PLAYBACK_TEST_BUILD_DIR) + name;
+}
+
+/// Write nbFrames frames of 10 positions and 10 velocities, the values depending on the frame
+void writeTrajectory(const std::string& filename, Compression compression, std::size_t nbFrames)
+{
+    TrajectoryWriter writer;
+    ASSERT_TRUE(writer.open(filename, compression, 3, 3));
+
+    std::vector<SReal> x(30), v(30);
+    for (std::size_t f = 0; f < nbFrames; ++f)
+    {
+        std::iota(x.begin(), x.end(), static_cast<SReal>(f));
+        std::fill(v.begin(), v.end(), static_cast<SReal>(f) * 0.5);
+
+        TrajectoryWriter::Frame frame;
+        frame.time = 0.01 * static_cast<double>(f);
+        frame.vectors[static_cast<std::size_t>(VectorId::Position)] = x.data();
+        frame.sizes[static_cast<std::size_t>(VectorId::Position)] = x.size();
+        frame.vectors[static_cast<std::size_t>(VectorId::Velocity)] = v.data();
+        frame.sizes[static_cast<std::size_t>(VectorId::Velocity)] = v.size();
+        ASSERT_TRUE(writer.writeFrame(frame));
+    }
+    EXPECT_EQ(writer.getNbFrames(), nbFrames);
+    writer.close();
+}
+
+void checkTrajectory(const std::string& filename, std::size_t nbFrames)
+{
+    EXPECT_TRUE(isTrajectoryFile(filename));
+
+    TrajectoryReader reader;
+    ASSERT_TRUE(reader.open(filename)) << reader.getLastError();
+    ASSERT_EQ(reader.getNbFrames(), nbFrames);
+    EXPECT_EQ(reader.getHeader().coordDimension, 3u);
+
+    // random access, in reverse order
+    for (std::size_t f = nbFrames; f-- > 0;)
+    {
+        TrajectoryReader::Frame frame;
+        ASSERT_TRUE(reader.readFrame(f, frame)) << reader.getLastError();
+        EXPECT_DOUBLE_EQ(frame.time, 0.01 * static_cast<double>(f));
+
+        ASSERT_EQ(frame.size(VectorId::Position), 30u);
+        ASSERT_EQ(frame.size(VectorId::Velocity), 30u);
+        EXPECT_FALSE(frame.has(VectorId::RestPosition));
+        EXPECT_FALSE(frame.has(VectorId::Force));
+        for (std::size_t i = 0; i < 30; ++i)
+        {
+            EXPECT_EQ(frame.data(VectorId::Position)[i], static_cast<SReal>(f + i));
+            EXPECT_EQ(frame.data(VectorId::Velocity)[i], static_cast<SReal>(f) * 0.5);
+        }
+    }
+}
+
+}
+
+TEST(TrajectoryFile, roundTrip)
+{
+    const auto filename = buildFile("trajectory.trj");
+    writeTrajectory(filename, Compression::None, 50);
+    checkTrajectory(filename, 50);
+}
+
+TEST(TrajectoryFile, roundTripCompressed)
+{
+    const auto filename = buildFile("trajectoryCompressed.trj");
+    writeTrajectory(filename, Compression::Zlib, 50);
+    checkTrajectory(filename, 50);
+}
+
+TEST(TrajectoryFile, rebuildIndex)
+{
+    const auto filename = buildFile("trajectoryNotClosed.trj");
+    writeTrajectory(filename, Compression::Zlib, 20);
+
+    // simulate a writer which has not been closed properly: the index is not referenced in the header
+    {
+        std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(offsetof(FileHeader, indexOffset));
+        const std::uint64_t zero = 0;
+        file.write(reinterpret_cast<const char*>(&zero), sizeof(zero));
+    }
+
+    checkTrajectory(filename, 20);
+}
+
+TEST(TrajectoryFile, findFrame)
+{
+    const auto filename = buildFile("trajectoryFind.trj");
+    writeTrajectory(filename, Compression::None, 100);
+
+    TrajectoryReader reader;
+    ASSERT_TRUE(reader.open(filename));
+
+    EXPECT_EQ(reader.findFrame(-1.), TrajectoryReader::InvalidFrame);
+    EXPECT_EQ(reader.findFrame(0.), 0u);
+    EXPECT_EQ(reader.findFrame(0.005), 0u);
+    EXPECT_EQ(reader.findFrame(0.01 * 42 + 1e-9), 42u);
+    EXPECT_EQ(reader.findFrame(0.01 * 42 - 1e-9), 41u);
+    EXPECT_EQ(reader.findFrame(0.99), 99u);
+    EXPECT_EQ(reader.findFrame(10.), 99u);
+}
+
+TEST(TrajectoryFile, invalidFile)
+{
+    const auto filename = std::string(SOFA_COMPONENT_PLAYBACK_TEST_FILES_DIR) + "particleGravityX.data";
+    EXPECT_FALSE(isTrajectoryFile(filename));
+
+    TrajectoryReader reader;
+    EXPECT_FALSE(reader.open(filename));
+    EXPECT_FALSE(reader.isOpen());
+}
+
+TEST(TrajectoryFile, convertText)
+{
+    const auto filename = buildFile("particleGravityX.trj");
+    ASSERT_TRUE(convertTextTrajectory(std::string(SOFA_COMPONENT_PLAYBACK_TEST_FILES_DIR) + "particleGravityX.data",
+                                      filename, Compression::None, 3, 3));
+
+    TrajectoryReader reader;
+    ASSERT_TRUE(reader.open(filename)) << reader.getLastError();
+    ASSERT_EQ(reader.getNbFrames(), 7u);
+
+    TrajectoryReader::Frame frame;
+    ASSERT_TRUE(reader.readFrame(6, frame));
+    EXPECT_DOUBLE_EQ(frame.time, 0.06);
+    ASSERT_EQ(frame.size(VectorId::Position), 3u);
+    EXPECT_FALSE(frame.has(VectorId::Velocity));
+    EXPECT_EQ(frame.data(VectorId::Position)[0], 0);
+    EXPECT_EQ(frame.data(VectorId::Position)[1], 0);
+    EXPECT_DOUBLE_EQ(frame.data(VectorId::Position)[2], -0.017658);
+}
+
+}
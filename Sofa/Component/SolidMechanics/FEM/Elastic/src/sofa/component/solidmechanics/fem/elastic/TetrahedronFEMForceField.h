@@ -22,6 +22,7 @@
 #pragma once
 #include <sofa/component/solidmechanics/fem/elastic/BaseLinearElasticityFEMForceField.h>
 #include <sofa/component/solidmechanics/fem/elastic/fwd.h>
+#include <sofa/component/solidmechanics/fem/elastic/TetrahedronFEMSIMDKernels.h>
 
 #include <sofa/core/behavior/ForceField.h>
 #include <sofa/core/topology/BaseMeshTopology.h>
@@ -306,6 +307,8 @@ public:
 
     Data<bool>  d_updateStiffness; ///< update structures (precomputed in init) using stiffness parameters in each iteration (set listening=1)
 
+    Data<bool> d_useSIMD; ///< use the vectorized kernels of the corotational methods (large, polar, svd), with the widest instruction set supported by the CPU
+
     using Inherit1::l_topology;
 
     type::vector<type::Vec<6,Real> > elemDisplacements;
@@ -397,6 +400,25 @@ protected:
 
     void applyStiffnessCorotational( Vector& f, const Vector& x, Index i=0, Index a=0,Index b=1,Index c=2,Index d=3, SReal fact=1.0  );
 
+    void computeRotationPolar( Transformation &R_0_2, const Vector &p, const Element& index );
+    void computeRotationSVD( Transformation &R_0_2, const Vector &p, const Element& index, Index elementIndex );
+
+    ////////////// vectorized kernels of the corotational methods
+    /// per-element data stored as a structure of arrays (see simd::TetrahedronSoAElements)
+    type::vector<Real> m_simdElementData;
+    type::vector<unsigned int> m_simdElementIndices;
+    simd::TetrahedronSoAElements<Real> m_simdElements;
+    const simd::TetrahedronFEMKernels<Real>* m_simdKernels { nullptr };
+    /// true if the rotations stored in m_simdElements are the same as 'rotations'
+    bool m_simdRotationsUpToDate { false };
+
+    /// Copies the per-element data into m_simdElements, and selects the kernels
+    void packSIMDElements();
+    void setSIMDRotation(Index elementIndex, const Transformation& R_0_2);
+    /// The vectorized kernels do not support plasticity, nor the options updating or assembling the stiffness matrices
+    bool useSIMDKernels() const;
+    void addForceSIMD( Vector& f, const Vector& p );
+
     void handleTopologyChange() override { needUpdateTopology = true; }
 
     void computeVonMisesStress();
@@ -65,6 +65,7 @@ TetrahedronFEMForceField<DataTypes>::TetrahedronFEMForceField()
     , d_showVonMisesStressPerElement(initData(&d_showVonMisesStressPerElement, false, "showVonMisesStressPerElement", "draw triangles showing vonMises stress interpolated in elements"))
     , d_showElementGapScale(initData(&d_showElementGapScale, (Real)0.333, "showElementGapScale", "draw gap between elements (when showWireFrame is disabled) [0,1]: 0: no gap, 1: no element"))
     , d_updateStiffness(initData(&d_updateStiffness, false, "updateStiffness", "update structures (precomputed in init) using stiffness parameters in each iteration (set listening=1)"))
+    , d_useSIMD(initData(&d_useSIMD, false, "useSIMD", "use the vectorized kernels of the corotational methods (large, polar, svd), with the widest instruction set supported by the CPU"))
 {
     data.initPtrData(this);
     this->addAlias(&d_assembling, "assembling");
@@ -1055,17 +1056,23 @@ void TetrahedronFEMForceField<DataTypes>::initPolar(Index i, Index& a, Index&b,
 }
 
 template<class DataTypes>
-inline void TetrahedronFEMForceField<DataTypes>::accumulateForcePolar( Vector& f, const Vector & p, typename VecElement::const_iterator elementIt, Index elementIndex )
+inline void TetrahedronFEMForceField<DataTypes>::computeRotationPolar( Transformation &R_0_2, const Vector &p, const Element& index )
 {
-    Element index = *elementIt;
-
     Transformation A;
     A[0] = p[index[1]]-p[index[0]];
     A[1] = p[index[2]]-p[index[0]];
     A[2] = p[index[3]]-p[index[0]];
 
-    Transformation R_0_2;
     helper::Decompose<Real>::polarDecomposition( A, R_0_2 );
+}
+
+template<class DataTypes>
+inline void TetrahedronFEMForceField<DataTypes>::accumulateForcePolar( Vector& f, const Vector & p, typename VecElement::const_iterator elementIt, Index elementIndex )
+{
+    Element index = *elementIt;
+
+    Transformation R_0_2;
+    computeRotationPolar( R_0_2, p, index );
 
     rotations[elementIndex].transpose( R_0_2 );
 
@@ -1152,23 +1159,13 @@ void TetrahedronFEMForceField<DataTypes>::initSVD(Index i, Index& a, Index&b, In
 
 
 template<class DataTypes>
-inline void TetrahedronFEMForceField<DataTypes>::accumulateForceSVD( Vector& f, const Vector & p, typename VecElement::const_iterator elementIt, Index elementIndex )
+inline void TetrahedronFEMForceField<DataTypes>::computeRotationSVD( Transformation &R_0_2, const Vector &p, const Element& index, Index elementIndex )
 {
-    if( d_assembling.getValue() )
-    {
-        dmsg_error() << "Support for assembling system matrix when using SVD method.";
-        return;
-    }
-
-    Element index = *elementIt;
-
     Transformation A;
     A[0] = p[index[1]]-p[index[0]];
     A[1] = p[index[2]]-p[index[0]];
     A[2] = p[index[3]]-p[index[0]];
 
-    type::Mat<3,3,Real> R_0_2;
-
     type::Mat<3,3,Real> F = A * _initialTransformation[elementIndex];
 
     if(type::determinant(F) < 1e-6 ) // inverted or too flat element -> SVD decomposition + handle degenerated cases
@@ -1180,6 +1177,21 @@ inline void TetrahedronFEMForceField<DataTypes>::accumulateForceSVD( Vector& f,
     {
         helper::Decompose<Real>::polarDecomposition( A, R_0_2 );
     }
+}
+
+template<class DataTypes>
+inline void TetrahedronFEMForceField<DataTypes>::accumulateForceSVD( Vector& f, const Vector & p, typename VecElement::const_iterator elementIt, Index elementIndex )
+{
+    if( d_assembling.getValue() )
+    {
+        dmsg_error() << "Support for assembling system matrix when using SVD method.";
+        return;
+    }
+
+    Element index = *elementIt;
+
+    Transformation R_0_2;
+    computeRotationSVD( R_0_2, p, index, elementIndex );
 
     rotations[elementIndex].transpose( R_0_2 );
 
@@ -1269,6 +1281,169 @@ inline void TetrahedronFEMForceField<DataTypes>::applyStiffnessCorotational( Vec
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////////
+/////////////  vectorized kernels for corotational large, polar, svd  /////////////////
+///////////////////////////////////////////////////////////////////////////////////////
+
+template<class DataTypes>
+void TetrahedronFEMForceField<DataTypes>::packSIMDElements()
+{
+    m_simdKernels = nullptr;
+    m_simdElements = simd::TetrahedronSoAElements<Real>();
+    m_simdRotationsUpToDate = false;
+
+    if (!d_useSIMD.getValue() || _indexedElements == nullptr || _indexedElements->empty())
+    {
+        return;
+    }
+
+    if (method == SMALL)
+    {
+        msg_warning() << "The vectorized kernels are only available for the corotational methods (large, polar, svd): "
+                         "they are not used with the method small.";
+        return;
+    }
+
+    static_assert(sizeof(Coord) == 3 * sizeof(Real) && sizeof(Deriv) == 3 * sizeof(Real),
+                  "The vectorized kernels require contiguous coordinates");
+    static_assert(sizeof(Transformation) == 9 * sizeof(Real),
+                  "The vectorized kernels require contiguous rotation matrices");
+
+    using SoAElements = simd::TetrahedronSoAElements<Real>;
+    constexpr std::size_t blockSize = SoAElements::BlockSize;
+
+    const std::size_t nbElements = _indexedElements->size();
+    const std::size_t nbBlocks = (nbElements + blockSize - 1) / blockSize;
+
+    m_simdElementIndices.resize(4 * nbBlocks * blockSize);
+    m_simdElementData.resize(nbBlocks * SoAElements::NbFields * blockSize);
+
+    // the last block is padded with copies of the last element
+    for (std::size_t e = 0; e < nbBlocks * blockSize; ++e)
+    {
+        const Index i = static_cast<Index>(std::min(e, nbElements - 1));
+        const Element& element = (*_indexedElements)[i];
+        for (std::size_t n = 0; n < 4; ++n)
+        {
+            m_simdElementIndices[4 * e + n] = element[n];
+        }
+
+        Real* fields = m_simdElementData.data() + (e / blockSize) * SoAElements::NbFields * blockSize + e % blockSize;
+        const auto setField = [fields](std::size_t field, Real value) { fields[field * blockSize] = value; };
+
+        for (std::size_t n = 0; n < 4; ++n)
+        {
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                setField(SoAElements::RestPositions + 3 * n + c, _rotatedInitialElements[i][n][c]);
+            }
+        }
+
+        const StrainDisplacement& J = strainDisplacements[i];
+        for (std::size_t r = 0; r < 12; ++r)
+        {
+            const std::size_t m = r % 3;
+            setField(SoAElements::StrainDisplacement + 3 * r, J[r][m]);
+            setField(SoAElements::StrainDisplacement + 3 * r + 1, J[r][m == 2 ? 4 : 3]);
+            setField(SoAElements::StrainDisplacement + 3 * r + 2, J[r][m == 1 ? 4 : 5]);
+        }
+
+        const MaterialStiffness& K = materialsStiffnesses[i];
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                setField(SoAElements::MaterialStiffness + 3 * j + k, K[j][k]);
+            }
+            setField(SoAElements::MaterialStiffness + 9 + j, K[3 + j][3 + j]);
+        }
+
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                setField(SoAElements::Rotation + 3 * j + k, rotations[i][k][j]);
+            }
+        }
+    }
+
+    m_simdElements.nbElements = nbElements;
+    m_simdElements.indices = m_simdElementIndices.data();
+    m_simdElements.data = m_simdElementData.data();
+    m_simdKernels = &simd::getTetrahedronFEMKernels<Real>();
+    m_simdRotationsUpToDate = true;
+
+    msg_info() << "Vectorized kernels: " << m_simdKernels->instructionSet;
+}
+
+template<class DataTypes>
+void TetrahedronFEMForceField<DataTypes>::setSIMDRotation(Index elementIndex, const Transformation& R_0_2)
+{
+    using SoAElements = simd::TetrahedronSoAElements<Real>;
+    constexpr std::size_t blockSize = SoAElements::BlockSize;
+
+    Real* fields = m_simdElementData.data() + (elementIndex / blockSize) * SoAElements::NbFields * blockSize + elementIndex % blockSize;
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+            fields[(SoAElements::Rotation + 3 * j + k) * blockSize] = R_0_2[j][k];
+        }
+    }
+}
+
+template<class DataTypes>
+bool TetrahedronFEMForceField<DataTypes>::useSIMDKernels() const
+{
+    return m_simdKernels != nullptr
+        && method != SMALL
+        && m_simdElements.nbElements == _indexedElements->size()
+        && !d_assembling.getValue()
+        && !d_updateStiffnessMatrix.getValue()
+        && d_plasticMaxThreshold.getValue() <= 0;
+}
+
+template<class DataTypes>
+void TetrahedronFEMForceField<DataTypes>::addForceSIMD( Vector& f, const Vector& p )
+{
+    const Real* x = reinterpret_cast<const Real*>(p.data());
+    Real* force = reinterpret_cast<Real*>(f.data());
+
+    switch(method)
+    {
+    case LARGE :
+    {
+        m_simdKernels->addForceLarge(m_simdElements, x, force, reinterpret_cast<Real*>(rotations.data()));
+        break;
+    }
+    case POLAR :
+    case SVD :
+    {
+        // the rotations are computed by the scalar code, and the forces by the vectorized kernels
+        unsigned int i;
+        typename VecElement::const_iterator it;
+        for(it = _indexedElements->begin(), i = 0 ; it != _indexedElements->end() ; ++it, ++i)
+        {
+            Transformation R_0_2;
+            if (method == POLAR)
+            {
+                computeRotationPolar( R_0_2, p, *it );
+            }
+            else
+            {
+                computeRotationSVD( R_0_2, p, *it, i );
+            }
+            rotations[i].transpose( R_0_2 );
+            setSIMDRotation(i, R_0_2);
+        }
+        m_simdKernels->addForceRotated(m_simdElements, x, force);
+        break;
+    }
+    }
+
+    m_simdRotationsUpToDate = true;
+}
+
 //////////////////////////////////////////////////////////////////////
 ////////////////  generic main computations methods  /////////////////
 //////////////////////////////////////////////////////////////////////
@@ -1551,6 +1726,8 @@ inline void TetrahedronFEMForceField<DataTypes>::reinit()
     }
     }
 
+    packSIMDElements();
+
     if ( isComputeVonMisesStressMethodSet() )
     {
         elemDisplacements.resize(  _indexedElements->size() );
@@ -1593,6 +1770,17 @@ inline void TetrahedronFEMForceField<DataTypes>::addForce (const core::Mechanica
         needUpdateTopology = false;
     }
 
+    if (useSIMDKernels())
+    {
+        addForceSIMD(f, p);
+        d_f.endEdit();
+
+        updateVonMisesStress = true;
+        return;
+    }
+
+    m_simdRotationsUpToDate = false;
+
     unsigned int i;
     typename VecElement::const_iterator it;
     switch(method)
@@ -1658,6 +1846,10 @@ inline void TetrahedronFEMForceField<DataTypes>::addDForce(const core::Mechanica
             applyStiffnessSmall(df, dx, i, a, b, c, d, kFactor);
         }
     }
+    else if (m_simdRotationsUpToDate && useSIMDKernels())
+    {
+        m_simdKernels->addDForce(m_simdElements, reinterpret_cast<const Real*>(dx.data()), reinterpret_cast<Real*>(df.data()), kFactor);
+    }
     else
     {
         for(it = _indexedElements->begin(), i = 0 ; it != _indexedElements->end() ; ++it, ++i)
@@ -2059,6 +2251,7 @@ void TetrahedronFEMForceField<DataTypes>::handleEvent(core::objectmodel::Event *
                 Index d = (*it)[3];
                 this->computeMaterialStiffness(i, a, b, c, d);
             }
+            packSIMDElements();
         }
     }
     if (sofa::simulation::AnimateEndEvent::checkEventType(event))
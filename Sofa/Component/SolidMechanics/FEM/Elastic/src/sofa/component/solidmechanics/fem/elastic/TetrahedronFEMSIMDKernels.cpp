@@ -0,0 +1,149 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/component/solidmechanics/fem/elastic/TetrahedronFEMSIMDKernels.inl>
+
+#include <cmath>
+
+#if defined(SOFA_COMPONENT_SOLIDMECHANICS_FEM_ELASTIC_HAVE_X86_KERNELS) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace sofa::component::solidmechanics::fem::elastic::simd
+{
+
+namespace
+{
+
+template<class TReal>
+struct ScalarPack
+{
+    using Real = TReal;
+    static constexpr std::size_t Width = 1;
+
+    Real v;
+
+    static ScalarPack load(const Real* p) { return { *p }; }
+    static void store(Real* p, ScalarPack a) { *p = a.v; }
+    static ScalarPack broadcast(Real a) { return { a }; }
+    static ScalarPack sqrt(ScalarPack a) { return { std::sqrt(a.v) }; }
+    static ScalarPack fmadd(ScalarPack a, ScalarPack b, ScalarPack c) { return { a.v * b.v + c.v }; }
+    static ScalarPack selectGreater(ScalarPack a, ScalarPack b, ScalarPack x, ScalarPack y) { return a.v > b.v ? x : y; }
+
+    friend ScalarPack operator+(ScalarPack a, ScalarPack b) { return { a.v + b.v }; }
+    friend ScalarPack operator-(ScalarPack a, ScalarPack b) { return { a.v - b.v }; }
+    friend ScalarPack operator*(ScalarPack a, ScalarPack b) { return { a.v * b.v }; }
+    friend ScalarPack operator/(ScalarPack a, ScalarPack b) { return { a.v / b.v }; }
+};
+
+enum class InstructionSet { Scalar, AVX2, AVX512 };
+
+InstructionSet detectInstructionSet()
+{
+#if defined(SOFA_COMPONENT_SOLIDMECHANICS_FEM_ELASTIC_HAVE_X86_KERNELS)
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    if (maxLeaf < 7)
+    {
+        return InstructionSet::Scalar;
+    }
+
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    if (!osxsave)
+    {
+        return InstructionSet::Scalar;
+    }
+
+    // registers saved by the operating system on context switches
+    const unsigned long long xcr0 = _xgetbv(0);
+    const bool osAVX = (xcr0 & 0x6) == 0x6;
+    const bool osAVX512 = (xcr0 & 0xe6) == 0xe6;
+
+    __cpuidex(info, 7, 0);
+    const bool avx2 = (info[1] & (1 << 5)) != 0;
+    const bool avx512f = (info[1] & (1 << 16)) != 0;
+
+    if (osAVX512 && avx512f)
+    {
+        return InstructionSet::AVX512;
+    }
+    if (osAVX && avx2 && fma)
+    {
+        return InstructionSet::AVX2;
+    }
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return InstructionSet::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+        return InstructionSet::AVX2;
+    }
+#endif
+#endif
+    return InstructionSet::Scalar;
+}
+
+template<class Real>
+const TetrahedronFEMKernels<Real>& selectTetrahedronFEMKernels()
+{
+#if defined(SOFA_COMPONENT_SOLIDMECHANICS_FEM_ELASTIC_HAVE_X86_KERNELS)
+    switch (detectInstructionSet())
+    {
+    case InstructionSet::AVX512:
+        return getAVX512TetrahedronFEMKernels<Real>();
+    case InstructionSet::AVX2:
+        return getAVX2TetrahedronFEMKernels<Real>();
+    default:
+        break;
+    }
+#endif
+    return getScalarTetrahedronFEMKernels<Real>();
+}
+
+} // namespace
+
+template<class Real>
+const TetrahedronFEMKernels<Real>& getScalarTetrahedronFEMKernels()
+{
+    static constexpr TetrahedronFEMKernels<Real> kernels = TetrahedronFEMKernelsImpl<ScalarPack<Real> >::kernels("scalar");
+    return kernels;
+}
+
+template<class Real>
+const TetrahedronFEMKernels<Real>& getTetrahedronFEMKernels()
+{
+    static const TetrahedronFEMKernels<Real>& kernels = selectTetrahedronFEMKernels<Real>();
+    return kernels;
+}
+
+template SOFA_COMPONENT_SOLIDMECHANICS_FEM_ELASTIC_API const TetrahedronFEMKernels<float>& getScalarTetrahedronFEMKernels<float>();
+template SOFA_COMPONENT_SOLIDMECHANICS_FEM_ELASTIC_API const TetrahedronFEMKernels<double>& getScalarTetrahedronFEMKernels<double>();
+template SOFA_COMPONENT_SOLIDMECHANICS_FEM_ELASTIC_API const TetrahedronFEMKernels<float>& getTetrahedronFEMKernels<float>();
+template SOFA_COMPONENT_SOLIDMECHANICS_FEM_ELASTIC_API const TetrahedronFEMKernels<double>& getTetrahedronFEMKernels<double>();
+
+} // namespace sofa::component::solidmechanics::fem::elastic::simd
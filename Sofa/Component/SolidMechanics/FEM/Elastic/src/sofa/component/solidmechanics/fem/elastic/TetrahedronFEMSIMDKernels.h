@@ -0,0 +1,94 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/solidmechanics/fem/elastic/config.h>
+
+#include <cstddef>
+
+/**
+ * Vectorized kernels of the corotational methods (large, polar and svd) of TetrahedronFEMForceField.
+ *
+ * Each instruction set is compiled in its own translation unit, with its own compiler flags, and the
+ * best one supported by the CPU is selected at runtime. The translation units of the kernels only
+ * use the types declared in this file, so that no code compiled with wider instructions can be
+ * shared with the rest of the library.
+ */
+namespace sofa::component::solidmechanics::fem::elastic::simd
+{
+
+/**
+ * Per-element data of TetrahedronFEMForceField, stored as a structure of arrays.
+ *
+ * The elements are grouped by blocks of BlockSize elements. In a block, each field is stored as
+ * BlockSize consecutive values, one per element. The last block is padded with copies of the last
+ * element, whose forces are never accumulated.
+ */
+template<class Real>
+struct TetrahedronSoAElements
+{
+    /// one cache line per field and per block
+    static constexpr std::size_t BlockSize = 64 / sizeof(Real);
+
+    /// initial positions of the 4 nodes in the element frame
+    static constexpr std::size_t RestPositions = 0;
+    /// non-zero entries of the 12x6 strain-displacement matrix J: J[r][r%3], J[r][3+(r%3==2)] and J[r][5-(r%3==1)] for each row r
+    static constexpr std::size_t StrainDisplacement = 12;
+    /// non-zero entries of the 6x6 material stiffness matrix K: the 3x3 upper-left block, followed by K[3][3], K[4][4] and K[5][5]
+    static constexpr std::size_t MaterialStiffness = 48;
+    /// rotation from the world frame to the element frame (transposed of the rotations of TetrahedronFEMForceField)
+    static constexpr std::size_t Rotation = 60;
+    static constexpr std::size_t NbFields = 69;
+
+    /// number of elements, not including the padding
+    std::size_t nbElements { 0 };
+    /// 4 node indices per element, including the padding
+    const unsigned int* indices { nullptr };
+    /// NbFields * BlockSize values per block
+    Real* data { nullptr };
+};
+
+template<class Real>
+struct TetrahedronFEMKernels
+{
+    /// name of the instruction set used by the kernels
+    const char* instructionSet;
+
+    /// Large method: computes the rotations by QR decomposition, and accumulates the element forces in f.
+    /// The rotations are stored in the elements, and in the array of 3x3 matrices 'rotations'.
+    void (*addForceLarge)(const TetrahedronSoAElements<Real>& elements, const Real* x, Real* f, Real* rotations);
+
+    /// Polar and svd methods: accumulates the element forces in f, using the rotations already stored in the elements
+    void (*addForceRotated)(const TetrahedronSoAElements<Real>& elements, const Real* x, Real* f);
+
+    /// Accumulates -kFactor * R J K Jt Rt dx in df
+    void (*addDForce)(const TetrahedronSoAElements<Real>& elements, const Real* dx, Real* df, Real kFactor);
+};
+
+/// @return the kernels using the widest instruction set supported by the CPU
+template<class Real>
+SOFA_COMPONENT_SOLIDMECHANICS_FEM_ELASTIC_API const TetrahedronFEMKernels<Real>& getTetrahedronFEMKernels();
+
+/// @return the kernels without any explicit vectorization
+template<class Real>
+SOFA_COMPONENT_SOLIDMECHANICS_FEM_ELASTIC_API const TetrahedronFEMKernels<Real>& getScalarTetrahedronFEMKernels();
+
+} // namespace sofa::component::solidmechanics::fem::elastic::simd
@@ -0,0 +1,353 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/component/solidmechanics/fem/elastic/TetrahedronFEMSIMDKernels.h>
+
+#include <limits>
+
+/**
+ * Implementation of the kernels, generic on the type of pack of values.
+ *
+ * A Pack type provides:
+ * - Real: type of the values, and Width: number of values in a pack
+ * - static functions load(const Real*), store(Real*, Pack), broadcast(Real), sqrt(Pack),
+ *   fmadd(a, b, c) = a * b + c, and selectGreater(a, b, x, y) = a > b ? x : y
+ * - operators +, -, * and /
+ *
+ * This file is included by the translation units of each instruction set, where the Pack types are
+ * declared in an anonymous namespace. To avoid mixing code compiled with different instruction sets
+ * at link time, the kernels must not call any inline function which is not specific to the pack type
+ * (in particular, nothing from the standard library).
+ */
+namespace sofa::component::solidmechanics::fem::elastic::simd
+{
+
+/// Kernels compiled with AVX2 and FMA instructions
+template<class Real>
+const TetrahedronFEMKernels<Real>& getAVX2TetrahedronFEMKernels();
+
+/// Kernels compiled with AVX-512 instructions
+template<class Real>
+const TetrahedronFEMKernels<Real>& getAVX512TetrahedronFEMKernels();
+
+template<class Pack>
+struct TetrahedronFEMKernelsImpl
+{
+    using Real = typename Pack::Real;
+    using Elements = TetrahedronSoAElements<Real>;
+
+    static constexpr std::size_t Width = Pack::Width;
+    static constexpr std::size_t BlockSize = Elements::BlockSize;
+    static_assert(BlockSize % Width == 0, "A block must contain a whole number of packs");
+
+    static constexpr Real Epsilon = std::numeric_limits<Real>::epsilon();
+
+    static constexpr TetrahedronFEMKernels<Real> kernels(const char* instructionSet)
+    {
+        return { instructionSet, &addForceLarge, &addForceRotated, &addDForce };
+    }
+
+    /// Calls f(fields, firstElement, nbElements) for each pack of elements
+    template<class F>
+    static void forEachPack(const Elements& elements, F f)
+    {
+        for (std::size_t first = 0; first < elements.nbElements; first += Width)
+        {
+            const std::size_t block = first / BlockSize;
+            Real* fields = elements.data + block * Elements::NbFields * BlockSize + (first - block * BlockSize);
+            const std::size_t remaining = elements.nbElements - first;
+            f(fields, first, remaining < Width ? remaining : Width);
+        }
+    }
+
+    static Pack field(const Real* fields, std::size_t i)
+    {
+        return Pack::load(fields + i * BlockSize);
+    }
+
+    /// Loads the 3 coordinates of the 4 nodes of each element of the pack
+    static void gather(const Real* x, const unsigned int* indices, Pack p[12])
+    {
+        Real buffer[12][Width];
+        for (std::size_t l = 0; l < Width; ++l)
+        {
+            for (std::size_t n = 0; n < 4; ++n)
+            {
+                const Real* xn = x + 3 * static_cast<std::size_t>(indices[4 * l + n]);
+                buffer[3 * n + 0][l] = xn[0];
+                buffer[3 * n + 1][l] = xn[1];
+                buffer[3 * n + 2][l] = xn[2];
+            }
+        }
+        for (std::size_t k = 0; k < 12; ++k)
+        {
+            p[k] = Pack::load(buffer[k]);
+        }
+    }
+
+    /// Accumulates the nodal values of the nbElements first elements of the pack, in the order of the elements
+    static void scatter(Real* f, const unsigned int* indices, std::size_t nbElements, const Pack values[12])
+    {
+        Real buffer[12][Width];
+        for (std::size_t k = 0; k < 12; ++k)
+        {
+            Pack::store(buffer[k], values[k]);
+        }
+        for (std::size_t l = 0; l < nbElements; ++l)
+        {
+            for (std::size_t n = 0; n < 4; ++n)
+            {
+                Real* fn = f + 3 * static_cast<std::size_t>(indices[4 * l + n]);
+                fn[0] += buffer[3 * n + 0][l];
+                fn[1] += buffer[3 * n + 1][l];
+                fn[2] += buffer[3 * n + 2][l];
+            }
+        }
+    }
+
+    static void normalize(Pack v[3])
+    {
+        const Pack norm = Pack::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        const Pack epsilon = Pack::broadcast(Epsilon);
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            v[c] = Pack::selectGreater(norm, epsilon, v[c] / norm, v[c]);
+        }
+    }
+
+    static void cross(const Pack a[3], const Pack b[3], Pack r[3])
+    {
+        r[0] = a[1] * b[2] - a[2] * b[1];
+        r[1] = a[2] * b[0] - a[0] * b[2];
+        r[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    /// r = R v
+    static void rotate(const Pack R[9], const Pack v[3], Pack r[3])
+    {
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            r[i] = Pack::fmadd(R[3 * i + 2], v[2], Pack::fmadd(R[3 * i + 1], v[1], R[3 * i] * v[0]));
+        }
+    }
+
+    /// r = R^T v
+    static void rotateTransposed(const Pack R[9], const Pack v[3], Pack r[3])
+    {
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            r[i] = Pack::fmadd(R[6 + i], v[2], Pack::fmadd(R[3 + i], v[1], R[i] * v[0]));
+        }
+    }
+
+    static void loadRotation(const Real* fields, Pack R[9])
+    {
+        for (std::size_t k = 0; k < 9; ++k)
+        {
+            R[k] = field(fields, Elements::Rotation + k);
+        }
+    }
+
+    /**
+     * Computes K J^T D, taking into account the sparsity of J and K.
+     * With the large method, the displacement of the first node, the y and z displacement of the
+     * second node, and the z displacement of the third node are null.
+     */
+    template<bool IsLarge>
+    static void computeStress(const Real* fields, const Pack D[12], Pack KJtD[6])
+    {
+        Pack JtD[6];
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+            JtD[i] = Pack::broadcast(0);
+        }
+        for (std::size_t r = 0; r < 12; ++r)
+        {
+            if (IsLarge && (r < 3 || r == 4 || r == 5 || r == 8))
+            {
+                continue;
+            }
+            const std::size_t m = r % 3;
+            const std::size_t J = Elements::StrainDisplacement + 3 * r;
+            JtD[m] = Pack::fmadd(field(fields, J), D[r], JtD[m]);
+            JtD[m == 2 ? 4 : 3] = Pack::fmadd(field(fields, J + 1), D[r], JtD[m == 2 ? 4 : 3]);
+            JtD[m == 1 ? 4 : 5] = Pack::fmadd(field(fields, J + 2), D[r], JtD[m == 1 ? 4 : 5]);
+        }
+
+        constexpr std::size_t K = Elements::MaterialStiffness;
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            KJtD[i] = Pack::fmadd(field(fields, K + 3 * i + 2), JtD[2],
+                      Pack::fmadd(field(fields, K + 3 * i + 1), JtD[1], field(fields, K + 3 * i) * JtD[0]));
+            KJtD[3 + i] = field(fields, K + 9 + i) * JtD[3 + i];
+        }
+    }
+
+    /// Computes the world forces R^T J KJtD on the 4 nodes
+    static void computeNodalForces(const Real* fields, const Pack R[9], const Pack KJtD[6], Pack forces[12])
+    {
+        Pack F[12];
+        for (std::size_t r = 0; r < 12; ++r)
+        {
+            const std::size_t m = r % 3;
+            const std::size_t J = Elements::StrainDisplacement + 3 * r;
+            F[r] = Pack::fmadd(field(fields, J + 2), KJtD[m == 1 ? 4 : 5],
+                   Pack::fmadd(field(fields, J + 1), KJtD[m == 2 ? 4 : 3], field(fields, J) * KJtD[m]));
+        }
+        for (std::size_t n = 0; n < 4; ++n)
+        {
+            rotateTransposed(R, F + 3 * n, forces + 3 * n);
+        }
+    }
+
+    static void addForceLarge(const Elements& elements, const Real* x, Real* f, Real* rotations)
+    {
+        forEachPack(elements, [&](Real* fields, std::size_t first, std::size_t nbElements)
+        {
+            const unsigned int* indices = elements.indices + 4 * first;
+
+            Pack p[12];
+            gather(x, indices, p);
+
+            // first vector on first edge
+            // second vector in the plane of the two first edges
+            // third vector orthogonal to first and second
+            Pack R[9];
+            Pack* edgex = R;
+            Pack* edgey = R + 3;
+            Pack* edgez = R + 6;
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                edgex[c] = p[3 + c] - p[c];
+                edgey[c] = p[6 + c] - p[c];
+            }
+            normalize(edgex);
+            cross(edgex, edgey, edgez);
+            normalize(edgez);
+            cross(edgez, edgex, edgey);
+
+            Real buffer[9][Width];
+            for (std::size_t k = 0; k < 9; ++k)
+            {
+                Pack::store(fields + (Elements::Rotation + k) * BlockSize, R[k]);
+                Pack::store(buffer[k], R[k]);
+            }
+            for (std::size_t l = 0; l < nbElements; ++l)
+            {
+                Real* rotation = rotations + 9 * (first + l);
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                    for (std::size_t j = 0; j < 3; ++j)
+                    {
+                        rotation[3 * i + j] = buffer[3 * j + i][l];
+                    }
+                }
+            }
+
+            // displacement, in the element frame, of the nodes relatively to the first node
+            Pack D[12];
+            for (std::size_t n = 1; n < 4; ++n)
+            {
+                const Pack relative[3] = { p[3 * n] - p[0], p[3 * n + 1] - p[1], p[3 * n + 2] - p[2] };
+                Pack deformed[3];
+                rotate(R, relative, deformed);
+                for (std::size_t c = 0; c < 3; ++c)
+                {
+                    D[3 * n + c] = field(fields, Elements::RestPositions + 3 * n + c) - deformed[c];
+                }
+            }
+
+            Pack KJtD[6];
+            computeStress<true>(fields, D, KJtD);
+
+            Pack forces[12];
+            computeNodalForces(fields, R, KJtD, forces);
+            scatter(f, indices, nbElements, forces);
+        });
+    }
+
+    static void addForceRotated(const Elements& elements, const Real* x, Real* f)
+    {
+        forEachPack(elements, [&](Real* fields, std::size_t first, std::size_t nbElements)
+        {
+            const unsigned int* indices = elements.indices + 4 * first;
+
+            Pack p[12];
+            gather(x, indices, p);
+
+            Pack R[9];
+            loadRotation(fields, R);
+
+            Pack D[12];
+            for (std::size_t n = 0; n < 4; ++n)
+            {
+                Pack deformed[3];
+                rotate(R, p + 3 * n, deformed);
+                for (std::size_t c = 0; c < 3; ++c)
+                {
+                    D[3 * n + c] = field(fields, Elements::RestPositions + 3 * n + c) - deformed[c];
+                }
+            }
+
+            Pack KJtD[6];
+            computeStress<false>(fields, D, KJtD);
+
+            Pack forces[12];
+            computeNodalForces(fields, R, KJtD, forces);
+            scatter(f, indices, nbElements, forces);
+        });
+    }
+
+    static void addDForce(const Elements& elements, const Real* dx, Real* df, Real kFactor)
+    {
+        const Pack factor = Pack::broadcast(-kFactor);
+        forEachPack(elements, [&](Real* fields, std::size_t first, std::size_t nbElements)
+        {
+            const unsigned int* indices = elements.indices + 4 * first;
+
+            Pack v[12];
+            gather(dx, indices, v);
+
+            Pack R[9];
+            loadRotation(fields, R);
+
+            Pack X[12];
+            for (std::size_t n = 0; n < 4; ++n)
+            {
+                rotate(R, v + 3 * n, X + 3 * n);
+            }
+
+            Pack KJtD[6];
+            computeStress<false>(fields, X, KJtD);
+            for (std::size_t i = 0; i < 6; ++i)
+            {
+                KJtD[i] = KJtD[i] * factor;
+            }
+
+            Pack forces[12];
+            computeNodalForces(fields, R, KJtD, forces);
+            scatter(df, indices, nbElements, forces);
+        });
+    }
+};
+
+} // namespace sofa::component::solidmechanics::fem::elastic::simd
@@ -0,0 +1,89 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/component/solidmechanics/fem/elastic/TetrahedronFEMSIMDKernels.inl>
+
+#include <immintrin.h>
+
+// Kernels using AVX2 and FMA instructions: 4 elements per pack in double precision, 8 in single precision
+namespace sofa::component::solidmechanics::fem::elastic::simd
+{
+
+namespace
+{
+
+struct AVX2PackDouble
+{
+    using Real = double;
+    static constexpr std::size_t Width = 4;
+
+    __m256d v;
+
+    static AVX2PackDouble load(const double* p) { return { _mm256_loadu_pd(p) }; }
+    static void store(double* p, AVX2PackDouble a) { _mm256_storeu_pd(p, a.v); }
+    static AVX2PackDouble broadcast(double a) { return { _mm256_set1_pd(a) }; }
+    static AVX2PackDouble sqrt(AVX2PackDouble a) { return { _mm256_sqrt_pd(a.v) }; }
+    static AVX2PackDouble fmadd(AVX2PackDouble a, AVX2PackDouble b, AVX2PackDouble c) { return { _mm256_fmadd_pd(a.v, b.v, c.v) }; }
+    static AVX2PackDouble selectGreater(AVX2PackDouble a, AVX2PackDouble b, AVX2PackDouble x, AVX2PackDouble y) { return { _mm256_blendv_pd(y.v, x.v, _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)) }; }
+
+    friend AVX2PackDouble operator+(AVX2PackDouble a, AVX2PackDouble b) { return { _mm256_add_pd(a.v, b.v) }; }
+    friend AVX2PackDouble operator-(AVX2PackDouble a, AVX2PackDouble b) { return { _mm256_sub_pd(a.v, b.v) }; }
+    friend AVX2PackDouble operator*(AVX2PackDouble a, AVX2PackDouble b) { return { _mm256_mul_pd(a.v, b.v) }; }
+    friend AVX2PackDouble operator/(AVX2PackDouble a, AVX2PackDouble b) { return { _mm256_div_pd(a.v, b.v) }; }
+};
+
+struct AVX2PackFloat
+{
+    using Real = float;
+    static constexpr std::size_t Width = 8;
+
+    __m256 v;
+
+    static AVX2PackFloat load(const float* p) { return { _mm256_loadu_ps(p) }; }
+    static void store(float* p, AVX2PackFloat a) { _mm256_storeu_ps(p, a.v); }
+    static AVX2PackFloat broadcast(float a) { return { _mm256_set1_ps(a) }; }
+    static AVX2PackFloat sqrt(AVX2PackFloat a) { return { _mm256_sqrt_ps(a.v) }; }
+    static AVX2PackFloat fmadd(AVX2PackFloat a, AVX2PackFloat b, AVX2PackFloat c) { return { _mm256_fmadd_ps(a.v, b.v, c.v) }; }
+    static AVX2PackFloat selectGreater(AVX2PackFloat a, AVX2PackFloat b, AVX2PackFloat x, AVX2PackFloat y) { return { _mm256_blendv_ps(y.v, x.v, _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)) }; }
+
+    friend AVX2PackFloat operator+(AVX2PackFloat a, AVX2PackFloat b) { return { _mm256_add_ps(a.v, b.v) }; }
+    friend AVX2PackFloat operator-(AVX2PackFloat a, AVX2PackFloat b) { return { _mm256_sub_ps(a.v, b.v) }; }
+    friend AVX2PackFloat operator*(AVX2PackFloat a, AVX2PackFloat b) { return { _mm256_mul_ps(a.v, b.v) }; }
+    friend AVX2PackFloat operator/(AVX2PackFloat a, AVX2PackFloat b) { return { _mm256_div_ps(a.v, b.v) }; }
+};
+
+} // namespace
+
+template<>
+const TetrahedronFEMKernels<double>& getAVX2TetrahedronFEMKernels<double>()
+{
+    static constexpr TetrahedronFEMKernels<double> kernels = TetrahedronFEMKernelsImpl<AVX2PackDouble>::kernels("AVX2");
+    return kernels;
+}
+
+template<>
+const TetrahedronFEMKernels<float>& getAVX2TetrahedronFEMKernels<float>()
+{
+    static constexpr TetrahedronFEMKernels<float> kernels = TetrahedronFEMKernelsImpl<AVX2PackFloat>::kernels("AVX2");
+    return kernels;
+}
+
+} // namespace sofa::component::solidmechanics::fem::elastic::simd
@@ -0,0 +1,89 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/component/solidmechanics/fem/elastic/TetrahedronFEMSIMDKernels.inl>
+
+#include <immintrin.h>
+
+// Kernels using AVX-512 instructions: 8 elements per pack in double precision, 16 in single precision
+namespace sofa::component::solidmechanics::fem::elastic::simd
+{
+
+namespace
+{
+
+struct AVX512PackDouble
+{
+    using Real = double;
+    static constexpr std::size_t Width = 8;
+
+    __m512d v;
+
+    static AVX512PackDouble load(const double* p) { return { _mm512_loadu_pd(p) }; }
+    static void store(double* p, AVX512PackDouble a) { _mm512_storeu_pd(p, a.v); }
+    static AVX512PackDouble broadcast(double a) { return { _mm512_set1_pd(a) }; }
+    static AVX512PackDouble sqrt(AVX512PackDouble a) { return { _mm512_sqrt_pd(a.v) }; }
+    static AVX512PackDouble fmadd(AVX512PackDouble a, AVX512PackDouble b, AVX512PackDouble c) { return { _mm512_fmadd_pd(a.v, b.v, c.v) }; }
+    static AVX512PackDouble selectGreater(AVX512PackDouble a, AVX512PackDouble b, AVX512PackDouble x, AVX512PackDouble y) { return { _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ), y.v, x.v) }; }
+
+    friend AVX512PackDouble operator+(AVX512PackDouble a, AVX512PackDouble b) { return { _mm512_add_pd(a.v, b.v) }; }
+    friend AVX512PackDouble operator-(AVX512PackDouble a, AVX512PackDouble b) { return { _mm512_sub_pd(a.v, b.v) }; }
+    friend AVX512PackDouble operator*(AVX512PackDouble a, AVX512PackDouble b) { return { _mm512_mul_pd(a.v, b.v) }; }
+    friend AVX512PackDouble operator/(AVX512PackDouble a, AVX512PackDouble b) { return { _mm512_div_pd(a.v, b.v) }; }
+};
+
+struct AVX512PackFloat
+{
+    using Real = float;
+    static constexpr std::size_t Width = 16;
+
+    __m512 v;
+
+    static AVX512PackFloat load(const float* p) { return { _mm512_loadu_ps(p) }; }
+    static void store(float* p, AVX512PackFloat a) { _mm512_storeu_ps(p, a.v); }
+    static AVX512PackFloat broadcast(float a) { return { _mm512_set1_ps(a) }; }
+    static AVX512PackFloat sqrt(AVX512PackFloat a) { return { _mm512_sqrt_ps(a.v) }; }
+    static AVX512PackFloat fmadd(AVX512PackFloat a, AVX512PackFloat b, AVX512PackFloat c) { return { _mm512_fmadd_ps(a.v, b.v, c.v) }; }
+    static AVX512PackFloat selectGreater(AVX512PackFloat a, AVX512PackFloat b, AVX512PackFloat x, AVX512PackFloat y) { return { _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ), y.v, x.v) }; }
+
+    friend AVX512PackFloat operator+(AVX512PackFloat a, AVX512PackFloat b) { return { _mm512_add_ps(a.v, b.v) }; }
+    friend AVX512PackFloat operator-(AVX512PackFloat a, AVX512PackFloat b) { return { _mm512_sub_ps(a.v, b.v) }; }
+    friend AVX512PackFloat operator*(AVX512PackFloat a, AVX512PackFloat b) { return { _mm512_mul_ps(a.v, b.v) }; }
+    friend AVX512PackFloat operator/(AVX512PackFloat a, AVX512PackFloat b) { return { _mm512_div_ps(a.v, b.v) }; }
+};
+
+} // namespace
+
+template<>
+const TetrahedronFEMKernels<double>& getAVX512TetrahedronFEMKernels<double>()
+{
+    static constexpr TetrahedronFEMKernels<double> kernels = TetrahedronFEMKernelsImpl<AVX512PackDouble>::kernels("AVX512");
+    return kernels;
+}
+
+template<>
+const TetrahedronFEMKernels<float>& getAVX512TetrahedronFEMKernels<float>()
+{
+    static constexpr TetrahedronFEMKernels<float> kernels = TetrahedronFEMKernelsImpl<AVX512PackFloat>::kernels("AVX512");
+    return kernels;
+}
+
+} // namespace sofa::component::solidmechanics::fem::elastic::simd
@@ -21,6 +21,7 @@
 ******************************************************************************/
 #include <sofa/component/solidmechanics/fem/elastic/TetrahedronFEMForceField.h>
 #include <sofa/simulation/common/SceneLoaderXML.h>
+#include <sofa/core/MechanicalParams.h>
 
 #include "BaseTetrahedronFEMForceField_test.h"
 
@@ -79,6 +80,111 @@ public:
 
         EXPECT_EQ(fem->getComponentState(), core::objectmodel::ComponentState::Invalid) ;
     }
+
+    /// Compares the forces computed with and without the vectorized kernels, on a deformed block of
+    /// 3x3x3 cubes split into 6 tetrahedra (the number of elements is not a multiple of the packs width)
+    void checkSIMDKernels(const std::string& method)
+    {
+        using Deriv = TetrahedronFEMForceField3::Deriv;
+        using VecDeriv = TetrahedronFEMForceField3::VecDeriv;
+        using core::objectmodel::Data;
+
+        constexpr sofa::Size n = 4;
+        const auto nodeIndex = [](sofa::Size i, sofa::Size j, sofa::Size k) { return i + n * (j + n * k); };
+
+        std::stringstream positions;
+        for (sofa::Size k = 0; k < n; ++k)
+            for (sofa::Size j = 0; j < n; ++j)
+                for (sofa::Size i = 0; i < n; ++i)
+                    positions << i << ' ' << j << ' ' << k << ' ';
+
+        std::stringstream tetrahedra;
+        for (sofa::Size k = 0; k + 1 < n; ++k)
+        {
+            for (sofa::Size j = 0; j + 1 < n; ++j)
+            {
+                for (sofa::Size i = 0; i + 1 < n; ++i)
+                {
+                    const sofa::Index c[8] = {
+                        nodeIndex(i, j, k), nodeIndex(i + 1, j, k), nodeIndex(i + 1, j + 1, k), nodeIndex(i, j + 1, k),
+                        nodeIndex(i, j, k + 1), nodeIndex(i + 1, j, k + 1), nodeIndex(i + 1, j + 1, k + 1), nodeIndex(i, j + 1, k + 1) };
+                    tetrahedra << c[0] << ' ' << c[5] << ' ' << c[1] << ' ' << c[6] << ' '
+                               << c[0] << ' ' << c[1] << ' ' << c[2] << ' ' << c[6] << ' '
+                               << c[0] << ' ' << c[2] << ' ' << c[3] << ' ' << c[6] << ' '
+                               << c[0] << ' ' << c[3] << ' ' << c[7] << ' ' << c[6] << ' '
+                               << c[0] << ' ' << c[7] << ' ' << c[4] << ' ' << c[6] << ' '
+                               << c[0] << ' ' << c[4] << ' ' << c[5] << ' ' << c[6] << ' ';
+                }
+            }
+        }
+
+        m_root = sofa::simpleapi::createRootNode(m_simulation, "root");
+        sofa::simpleapi::importPlugin("Sofa.Component.StateContainer");
+        sofa::simpleapi::importPlugin("Sofa.Component.Topology.Container.Dynamic");
+        sofa::simpleapi::importPlugin("Sofa.Component.SolidMechanics.FEM.Elastic");
+
+        std::vector<TetrahedronFEMForceField3*> forceFields;
+        for (const std::string useSIMD : { "false", "true" })
+        {
+            const auto node = sofa::simpleapi::createChild(m_root, "useSIMD_" + useSIMD);
+            sofa::simpleapi::createObject(node, "MechanicalObject", { {"template", dataTypeName}, {"position", positions.str()} });
+            sofa::simpleapi::createObject(node, "TetrahedronSetTopologyContainer", { {"tetrahedra", tetrahedra.str()} });
+            sofa::simpleapi::createObject(node, className, {
+                {"youngModulus", "1000"}, {"poissonRatio", "0.3"}, {"method", method}, {"useSIMD", useSIMD} });
+            forceFields.push_back(node->getTreeObject<TetrahedronFEMForceField3>());
+            ASSERT_NE(forceFields.back(), nullptr);
+        }
+        sofa::simulation::node::initRoot(m_root.get());
+
+        // rotated and deformed positions, and an arbitrary displacement
+        const VecCoord& restPositions = forceFields[0]->d_initialPoints.getValue();
+        const auto rotation = sofa::type::Quat<SReal>::fromEuler(0.3, -0.8, 1.2);
+        Data<VecCoord> x;
+        Data<VecDeriv> v, dx;
+        sofa::helper::WriteAccessor<Data<VecCoord> > xAccessor = x;
+        sofa::helper::WriteAccessor<Data<VecDeriv> > dxAccessor = dx;
+        for (sofa::Size i = 0; i < restPositions.size(); ++i)
+        {
+            const Coord noise(std::sin(3.0 * i), std::cos(5.0 * i), std::sin(7.0 * i + 1.0));
+            xAccessor.push_back(rotation.rotate(restPositions[i] + noise * 0.2));
+            dxAccessor.push_back(Deriv(std::cos(2.0 * i), std::sin(11.0 * i), std::cos(13.0 * i + 2.0)));
+        }
+        v.setValue(VecDeriv(restPositions.size()));
+
+        sofa::core::MechanicalParams mparams;
+        mparams.setKFactor(0.7);
+
+        std::vector<VecDeriv> forces, dforces;
+        for (auto* forceField : forceFields)
+        {
+            Data<VecDeriv> f, df;
+            f.setValue(VecDeriv(restPositions.size()));
+            df.setValue(VecDeriv(restPositions.size()));
+            forceField->addForce(&mparams, f, x, v);
+            forceField->addDForce(&mparams, df, dx);
+            forces.push_back(f.getValue());
+            dforces.push_back(df.getValue());
+        }
+
+        for (sofa::Size i = 0; i < restPositions.size(); ++i)
+        {
+            for (sofa::Size c = 0; c < 3; ++c)
+            {
+                EXPECT_NEAR(forces[0][i][c], forces[1][i][c], 1e-9) << "node " << i;
+                EXPECT_NEAR(dforces[0][i][c], dforces[1][i][c], 1e-9) << "node " << i;
+            }
+        }
+
+        const auto nbElements = forceFields[0]->l_topology->getNbTetrahedra();
+        for (sofa::Index e = 0; e < nbElements; ++e)
+        {
+            const auto& R0 = forceFields[0]->getActualTetraRotation(e);
+            const auto& R1 = forceFields[1]->getActualTetraRotation(e);
+            for (sofa::Size i = 0; i < 3; ++i)
+                for (sofa::Size j = 0; j < 3; ++j)
+                    EXPECT_NEAR(R0[i][j], R1[i][j], 1e-12) << "element " << e;
+        }
+    }
 };
 
 TEST_F(TetrahedronFEMForceField_test, init)
@@ -101,4 +207,19 @@ TEST_F(TetrahedronFEMForceField_test, checkGracefullHandlingWhenTopologyIsMissin
     this->checkGracefullHandlingWhenTopologyIsMissing();
 }
 
+TEST_F(TetrahedronFEMForceField_test, SIMDKernelsLarge)
+{
+    this->checkSIMDKernels("large");
+}
+
+TEST_F(TetrahedronFEMForceField_test, SIMDKernelsPolar)
+{
+    this->checkSIMDKernels("polar");
+}
+
+TEST_F(TetrahedronFEMForceField_test, SIMDKernelsSVD)
+{
+    this->checkSIMDKernels("svd");
+}
+
 } // namespace sofa
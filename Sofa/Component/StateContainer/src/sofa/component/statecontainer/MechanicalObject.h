@@ -60,6 +60,7 @@ public:
 
     typedef sofa::core::behavior::MechanicalState<DataTypes>      Inherited;
     typedef typename Inherited::VMultiOp    VMultiOp;
+    typedef typename Inherited::VReductions VReductions;
     typedef typename DataTypes::Real        Real;
     typedef typename DataTypes::Coord       Coord;
     typedef typename DataTypes::Deriv       Deriv;
@@ -303,6 +304,10 @@ public:
 
     void vMultiOp(const core::ExecParams* params, const VMultiOp& ops) override;
 
+    /// Perform the linear operations and the reductions in a single pass over the vectors, if their layout allows it.
+    /// The vectors are processed by chunks small enough to remain in cache, with loops which can be vectorized.
+    void vMultiOpReduce(const core::ExecParams* params, const VMultiOp& ops, const VReductions& reductions, SReal* results) override;
+
     void vThreshold(core::VecId a, SReal threshold ) override;
 
     SReal vDot(const core::ExecParams* params, core::ConstVecId a, core::ConstVecId b) override;
@@ -420,6 +425,10 @@ protected :
                    core::TVecId<vtype, core::V_WRITE> vId,
                    core::TVecId<vtype, core::V_READ> vSrcId);
 
+    /// Fused implementation of vMultiOpReduce. Returns false, without modifying any vector, if the vectors cannot be
+    /// processed as contiguous arrays of scalars of the same size.
+    bool vMultiOpReduceFused(const core::ExecParams* params, const VMultiOp& ops, const VReductions& reductions, SReal* results);
+
     /// Shortcut to get a write-only accessor corresponding to the provided VecType from a VecId
     template<core::VecType vtype>
     helper::WriteOnlyAccessor<core::objectmodel::Data<core::StateVecType_t<DataTypes, vtype> > >
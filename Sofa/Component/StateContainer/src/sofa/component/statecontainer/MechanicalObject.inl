@@ -31,6 +31,7 @@
 #include <sofa/core/topology/TopologyChange.h>
 #include <sofa/defaulttype/DataTypeInfo.h>
 #include <sofa/helper/accessor.h>
+#include <sofa/simulation/ComponentProfiler.h>
 #include <sofa/simulation/Node.h>
 #include <sofa/defaulttype/DataTypeOperations.h>
 
@@ -1607,6 +1608,7 @@ void MechanicalObject<DataTypes>::vAllocImpl(
         auto* vec_d = this->write(v);
         vec_d->beginEdit()->resize(d_size.getValue());
         vec_d->endEdit();
+        simulation::ComponentProfiler::addAllocation(this);
 
         setVecIdProperties(v, properties, vec_d);
     }
@@ -1640,6 +1642,7 @@ void MechanicalObject<DataTypes>::vReallocImpl(
     {
         vec_d->beginEdit()->resize(d_size.getValue());
         vec_d->endEdit();
+        simulation::ComponentProfiler::addAllocation(this);
     }
 
     setVecIdProperties(v, properties, vec_d);
@@ -2078,6 +2081,330 @@ void MechanicalObject<DataTypes>::vMultiOp(const core::ExecParams* params, const
         Inherited::vMultiOp(params, ops);
 }
 
+template <class DataTypes>
+void MechanicalObject<DataTypes>::vMultiOpReduce(const core::ExecParams* params, const VMultiOp& ops, const VReductions& reductions, SReal* results)
+{
+    if (!vMultiOpReduceFused(params, ops, reductions, results))
+    {
+        Inherited::vMultiOpReduce(params, ops, reductions, results);
+    }
+}
+
+namespace
+{
+
+/// v = sum_j a_j * f_j on the range [begin, end)
+template<class Real>
+void fusedLinearOperation(Real* v, const sofa::type::vector<std::pair<const Real*, Real> >& operands, std::size_t begin, std::size_t end)
+{
+    // The number of operands is known in the most common cases, so that the loops can be vectorized.
+    // If v is also an operand, v[i] is read before being written: the result is correct.
+    switch (operands.size())
+    {
+    case 0:
+        std::fill(v + begin, v + end, static_cast<Real>(0));
+        break;
+    case 1:
+    {
+        const auto [a, fa] = operands[0];
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            v[i] = a[i] * fa;
+        }
+        break;
+    }
+    case 2:
+    {
+        const auto [a, fa] = operands[0];
+        const auto [b, fb] = operands[1];
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            v[i] = a[i] * fa + b[i] * fb;
+        }
+        break;
+    }
+    case 3:
+    {
+        const auto [a, fa] = operands[0];
+        const auto [b, fb] = operands[1];
+        const auto [c, fc] = operands[2];
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            v[i] = a[i] * fa + b[i] * fb + c[i] * fc;
+        }
+        break;
+    }
+    default:
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            Real sum = 0;
+            for (const auto& [a, fa] : operands)
+            {
+                sum += a[i] * fa;
+            }
+            v[i] = sum;
+        }
+        break;
+    }
+}
+
+/// Scalar product on the range [begin, end), with independent partial sums to allow vectorization
+template<class Real>
+Real fusedDot(const Real* a, const Real* b, std::size_t begin, std::size_t end)
+{
+    Real s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+        s0 += a[i    ] * b[i    ];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < end; ++i)
+    {
+        s0 += a[i] * b[i];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+/// Maximum of the absolute values on the range [begin, end)
+template<class Real>
+Real fusedMax(const Real* a, std::size_t begin, std::size_t end)
+{
+    Real m0 = 0, m1 = 0, m2 = 0, m3 = 0;
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+        m0 = std::max(m0, std::abs(a[i    ]));
+        m1 = std::max(m1, std::abs(a[i + 1]));
+        m2 = std::max(m2, std::abs(a[i + 2]));
+        m3 = std::max(m3, std::abs(a[i + 3]));
+    }
+    for (; i < end; ++i)
+    {
+        m0 = std::max(m0, std::abs(a[i]));
+    }
+    return std::max(std::max(m0, m1), std::max(m2, m3));
+}
+
+} // anonymous namespace
+
+template <class DataTypes>
+bool MechanicalObject<DataTypes>::vMultiOpReduceFused(const core::ExecParams* params, const VMultiOp& ops, const VReductions& reductions, SReal* results)
+{
+    // the vectors must be contiguous arrays of scalars
+    if constexpr (sizeof(Deriv) != DataTypes::deriv_total_size * sizeof(Real))
+    {
+        SOFA_UNUSED(params);
+        SOFA_UNUSED(ops);
+        SOFA_UNUSED(reductions);
+        SOFA_UNUSED(results);
+        return false;
+    }
+    else
+    {
+        // coordinates can be mixed with derivatives only if they are of the same type (i.e. linear coordinates)
+        static constexpr bool isCoordFusable = std::is_same_v<Coord, Deriv>;
+
+        const Size size = d_size.getValue();
+
+        const auto isFusable = [this, size](core::ConstVecId id)
+        {
+            if (id.isNull())
+            {
+                return false;
+            }
+            if (id.type == core::V_DERIV)
+            {
+                const auto* data = this->read(core::ConstVecDerivId(id));
+                return data != nullptr && data->getValue().size() == size;
+            }
+            if constexpr (isCoordFusable)
+            {
+                if (id.type == core::V_COORD)
+                {
+                    const auto* data = this->read(core::ConstVecCoordId(id));
+                    return data != nullptr && data->getValue().size() == size;
+                }
+            }
+            return false;
+        };
+
+        for (const auto& op : ops)
+        {
+            if (!isFusable(op.first.getId(this)))
+            {
+                return false;
+            }
+            for (const auto& operand : op.second)
+            {
+                if (!isFusable(operand.first.getId(this)))
+                {
+                    return false;
+                }
+            }
+        }
+        for (const auto& reduction : reductions)
+        {
+            const core::ConstVecId a = reduction.a.getId(this);
+            if (!isFusable(a))
+            {
+                return false;
+            }
+            if (reduction.type == core::behavior::BaseMechanicalState::VReductionEntry::Type::DOT)
+            {
+                const core::ConstVecId b = reduction.b.getId(this);
+                if (!isFusable(b) || a.type != b.type)
+                {
+                    return false;
+                }
+            }
+        }
+
+        // All the written vectors are retrieved before the read-only vectors. A vector both read and written is
+        // accessed through the same pointer.
+        sofa::type::vector<std::pair<core::VecId, Real*> > writtenVectors;
+        const auto findWrittenVector = [&writtenVectors](core::ConstVecId id) -> Real*
+        {
+            for (const auto& [writtenId, values] : writtenVectors)
+            {
+                if (writtenId.type == id.type && writtenId.index == id.index)
+                {
+                    return values;
+                }
+            }
+            return nullptr;
+        };
+
+        for (const auto& op : ops)
+        {
+            const core::VecId v = op.first.getId(this);
+            if (!findWrittenVector(v))
+            {
+                Real* values { nullptr };
+                if constexpr (isCoordFusable)
+                {
+                    if (v.type == core::V_COORD)
+                    {
+                        values = reinterpret_cast<Real*>(this->write(core::VecCoordId(v))->beginEdit()->data());
+                    }
+                }
+                if (v.type == core::V_DERIV)
+                {
+                    values = reinterpret_cast<Real*>(this->write(core::VecDerivId(v))->beginEdit()->data());
+                }
+                writtenVectors.emplace_back(v, values);
+            }
+        }
+
+        const auto readValues = [this, &findWrittenVector](core::ConstVecId id) -> const Real*
+        {
+            if (const Real* values = findWrittenVector(id))
+            {
+                return values;
+            }
+            if constexpr (isCoordFusable)
+            {
+                if (id.type == core::V_COORD)
+                {
+                    return reinterpret_cast<const Real*>(this->read(core::ConstVecCoordId(id))->getValue().data());
+                }
+            }
+            return reinterpret_cast<const Real*>(this->read(core::ConstVecDerivId(id))->getValue().data());
+        };
+
+        struct LinearOperation
+        {
+            Real* v { nullptr };
+            sofa::type::vector<std::pair<const Real*, Real> > operands;
+        };
+        sofa::type::vector<LinearOperation> linearOperations(ops.size());
+        for (std::size_t i = 0; i < ops.size(); ++i)
+        {
+            linearOperations[i].v = findWrittenVector(ops[i].first.getId(this));
+            for (const auto& [operand, factor] : ops[i].second)
+            {
+                linearOperations[i].operands.emplace_back(readValues(operand.getId(this)), static_cast<Real>(factor));
+            }
+        }
+
+        sofa::type::vector<std::pair<const Real*, const Real*> > reductionVectors(reductions.size());
+        sofa::type::vector<Real> reductionValues(reductions.size(), 0);
+        for (std::size_t r = 0; r < reductions.size(); ++r)
+        {
+            reductionVectors[r].first = readValues(reductions[r].a.getId(this));
+            if (reductions[r].type == core::behavior::BaseMechanicalState::VReductionEntry::Type::DOT)
+            {
+                reductionVectors[r].second = readValues(reductions[r].b.getId(this));
+            }
+        }
+
+        // Chunks of a few kilobytes: the values written by the linear operations are still in cache when they are
+        // read by the next operations and the reductions
+        static constexpr std::size_t chunkSize = 512;
+        const std::size_t nbScalars = static_cast<std::size_t>(size) * DataTypes::deriv_total_size;
+
+        for (std::size_t begin = 0; begin < nbScalars; begin += chunkSize)
+        {
+            const std::size_t end = std::min(begin + chunkSize, nbScalars);
+
+            for (const auto& op : linearOperations)
+            {
+                fusedLinearOperation(op.v, op.operands, begin, end);
+            }
+
+            for (std::size_t r = 0; r < reductions.size(); ++r)
+            {
+                const auto& [a, b] = reductionVectors[r];
+                if (reductions[r].type == core::behavior::BaseMechanicalState::VReductionEntry::Type::DOT)
+                {
+                    reductionValues[r] += fusedDot(a, b, begin, end);
+                }
+                else if (reductions[r].l == 0)
+                {
+                    reductionValues[r] = std::max(reductionValues[r], fusedMax(a, begin, end));
+                }
+            }
+        }
+
+        for (const auto& [v, values] : writtenVectors)
+        {
+            if constexpr (isCoordFusable)
+            {
+                if (v.type == core::V_COORD)
+                {
+                    this->write(core::VecCoordId(v))->endEdit();
+                }
+            }
+            if (v.type == core::V_DERIV)
+            {
+                this->write(core::VecDerivId(v))->endEdit();
+            }
+        }
+
+        for (std::size_t r = 0; r < reductions.size(); ++r)
+        {
+            const auto& reduction = reductions[r];
+            if (reduction.type == core::behavior::BaseMechanicalState::VReductionEntry::Type::DOT)
+            {
+                results[r] += reductionValues[r];
+            }
+            else if (reduction.l == 0)
+            {
+                results[r] = std::max(results[r], static_cast<SReal>(reductionValues[r]));
+            }
+            else
+            {
+                // not fused: the l-norms (l>0) keep the definition of vSum
+                results[r] += vSum(params, reduction.a.getId(this), reduction.l);
+            }
+        }
+
+        return true;
+    }
+}
+
 template <class T> inline void clear( T& t )
 {
     t.clear();
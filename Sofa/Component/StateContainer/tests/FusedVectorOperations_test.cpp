@@ -0,0 +1,157 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/component/statecontainer/MechanicalObject.h>
+#include <sofa/simulation/FusedVectorOperations.h>
+#include <sofa/simulation/VectorOperations.h>
+#include <sofa/simulation/graph/DAGNode.h>
+
+#include <sofa/testing/BaseTest.h>
+using sofa::testing::BaseTest;
+
+#include <cmath>
+
+namespace sofa
+{
+
+namespace
+{
+
+struct FusedVectorOperations_test : public BaseTest
+{
+    using MechanicalObject1 = component::statecontainer::MechanicalObject<defaulttype::Vec1Types>;
+    using MechanicalObject3 = component::statecontainer::MechanicalObject<defaulttype::Vec3Types>;
+
+    simulation::Node::SPtr root;
+    MechanicalObject3::SPtr mstate1;
+    MechanicalObject1::SPtr mstate2;
+
+    void SetUp() override
+    {
+        // the operations are applied on the mechanical states of several nodes
+        root = core::objectmodel::New<simulation::graph::DAGNode>();
+        mstate1 = core::objectmodel::New<MechanicalObject3>();
+        mstate2 = core::objectmodel::New<MechanicalObject1>();
+        root->createChild("child1")->addObject(mstate1);
+        root->createChild("child2")->addObject(mstate2);
+
+        fillVectors(mstate1.get(), 700);
+        fillVectors(mstate2.get(), 300);
+    }
+
+    template<class MState>
+    static void fillVectors(MState* mstate, const std::size_t n)
+    {
+        mstate->resize(n);
+        auto v = mstate->writeVelocities();
+        auto f = mstate->writeForces();
+        auto dx = mstate->writeDx();
+        // empty vectors are not resized by the mechanical object
+        v.resize(n);
+        f.resize(n);
+        dx.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            for (std::size_t j = 0; j < MState::DataTypes::deriv_total_size; ++j)
+            {
+                const auto k = static_cast<SReal>(i * MState::DataTypes::deriv_total_size + j);
+                v[i][j] = std::sin(k);
+                f[i][j] = std::cos(k);
+                dx[i][j] = std::sin(2 * k);
+            }
+        }
+    }
+
+    template<class MState>
+    static void expectSameVectors(MState* mstate, MState* reference)
+    {
+        const auto compare = [](const auto& vec, const auto& referenceVec)
+        {
+            ASSERT_EQ(vec.size(), referenceVec.size());
+            for (std::size_t i = 0; i < vec.size(); ++i)
+            {
+                for (std::size_t j = 0; j < MState::DataTypes::deriv_total_size; ++j)
+                {
+                    EXPECT_NEAR(vec[i][j], referenceVec[i][j], 1e-12);
+                }
+            }
+        };
+        compare(mstate->readVelocities().ref(), reference->readVelocities().ref());
+        compare(mstate->readForces().ref(), reference->readForces().ref());
+        compare(mstate->readDx().ref(), reference->readDx().ref());
+    }
+};
+
+TEST_F(FusedVectorOperations_test, sameAsVectorOperations)
+{
+    const core::MultiVecDerivId v = core::VecDerivId::velocity();
+    const core::MultiVecDerivId f = core::VecDerivId::force();
+    const core::MultiVecDerivId dx = core::VecDerivId::dx();
+
+    // reference: one traversal per operation
+    simulation::common::VectorOperations vop(core::execparams::defaultInstance(), root.get());
+    vop.v_peq(dx, v, 0.5);
+    vop.v_op(f, dx, f, -2.);
+    vop.v_teq(v, 3.);
+    vop.v_dot(f, dx);
+    const SReal dot = vop.finish();
+    vop.v_norm(f, 0);
+    const SReal maxNorm = vop.finish();
+    vop.v_norm(v, 2);
+    const SReal norm2 = vop.finish();
+
+    const auto reference1 = core::objectmodel::New<MechanicalObject3>();
+    const auto reference2 = core::objectmodel::New<MechanicalObject1>();
+    reference1->resize(mstate1->getSize());
+    reference2->resize(mstate2->getSize());
+    reference1->writeVelocities().wref() = mstate1->readVelocities().ref();
+    reference1->writeForces().wref() = mstate1->readForces().ref();
+    reference1->writeDx().wref() = mstate1->readDx().ref();
+    reference2->writeVelocities().wref() = mstate2->readVelocities().ref();
+    reference2->writeForces().wref() = mstate2->readForces().ref();
+    reference2->writeDx().wref() = mstate2->readDx().ref();
+
+    // same operations, in a single traversal
+    fillVectors(mstate1.get(), mstate1->getSize());
+    fillVectors(mstate2.get(), mstate2->getSize());
+
+    simulation::common::FusedVectorOperations ops(core::execparams::defaultInstance(), root.get());
+    ops.v_peq(dx, v, 0.5);
+    ops.v_op(f, dx, f, -2.);
+    ops.v_teq(v, 3.);
+    const auto dotId = ops.v_dot(f, dx);
+    const auto maxNormId = ops.v_norm(f, 0);
+    const auto norm2Id = ops.v_norm(v, 2);
+    EXPECT_EQ(ops.size(), 6u);
+    ops.execute();
+    EXPECT_TRUE(ops.empty());
+
+    expectSameVectors(mstate1.get(), reference1.get());
+    expectSameVectors(mstate2.get(), reference2.get());
+
+    EXPECT_NEAR(ops.getResult(dotId), dot, 1e-10 * std::abs(dot));
+    EXPECT_NEAR(ops.getResult(maxNormId), maxNorm, 1e-12);
+    EXPECT_NEAR(ops.getResult(norm2Id), norm2, 1e-10 * norm2);
+}
+
+}
+
+}
@@ -22,6 +22,7 @@
 #include <sofa/component/statecontainer/MechanicalObject.h>
 
 #include <sofa/testing/BaseTest.h>
+#include <sofa/testing/NumericTest.h>
 using sofa::testing::BaseTest;
 
 namespace sofa
@@ -110,6 +111,75 @@ TYPED_TEST(MechanicalObject_test, checkThatPositionDefaultValueIsAVectorOfValueI
     TestHelpers::CheckPosition(this->mechanicalObject);
 }
 
+TYPED_TEST(MechanicalObject_test, vMultiOpReduceMatchesSeparateOperations)
+{
+    using VecDeriv = typename TypeParam::VecDeriv;
+    using Real = typename TypeParam::Real;
+    using VMultiOpEntry = core::behavior::BaseMechanicalState::VMultiOpEntry;
+    using VReductionEntry = core::behavior::BaseMechanicalState::VReductionEntry;
+
+    auto& mstate = this->mechanicalObject;
+    static constexpr std::size_t n = 1000; // more than a single chunk
+    mstate.resize(n);
+
+    {
+        auto v = mstate.writeVelocities();
+        auto f = mstate.writeForces();
+        auto dx = mstate.writeDx();
+        // empty vectors are not resized by the mechanical object
+        v.resize(n);
+        f.resize(n);
+        dx.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            for (std::size_t j = 0; j < TypeParam::deriv_total_size; ++j)
+            {
+                const auto k = static_cast<Real>(i * TypeParam::deriv_total_size + j);
+                v[i][j] = std::sin(k);
+                f[i][j] = std::cos(k);
+                dx[i][j] = std::sin(2 * k);
+            }
+        }
+    }
+
+    const VecDeriv v0 = mstate.readVelocities().ref();
+    const VecDeriv f0 = mstate.readForces().ref();
+    const VecDeriv dx0 = mstate.readDx().ref();
+
+    // dx += v * 0.5
+    // f = dx * 2 - f (the result vector is not the first operand)
+    core::behavior::BaseMechanicalState::VMultiOp ops;
+    ops.emplace_back(core::VecDerivId::dx(), core::VecDerivId::dx(), 1., core::VecDerivId::velocity(), 0.5);
+    ops.emplace_back(core::VecDerivId::force(), core::VecDerivId::dx(), 2., core::VecDerivId::force(), -1.);
+
+    core::behavior::BaseMechanicalState::VReductions reductions;
+    reductions.push_back(VReductionEntry::dot(core::VecDerivId::force(), core::VecDerivId::dx()));
+    reductions.push_back(VReductionEntry::norm(core::VecDerivId::force(), 0));
+
+    SReal results[2] { 1, 0 };
+    mstate.vMultiOpReduce(core::execparams::defaultInstance(), ops, reductions, results);
+
+    SReal expectedDot = 1; // results are accumulated
+    SReal expectedMax = 0;
+    const auto dx = mstate.readDx();
+    const auto f = mstate.readForces();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto expectedDx = dx0[i] + v0[i] * static_cast<Real>(0.5);
+        const auto expectedF = expectedDx * static_cast<Real>(2) - f0[i];
+        for (std::size_t j = 0; j < TypeParam::deriv_total_size; ++j)
+        {
+            EXPECT_NEAR(dx[i][j], expectedDx[j], testing::NumericTest<Real>::epsilon() * 10);
+            EXPECT_NEAR(f[i][j], expectedF[j], testing::NumericTest<Real>::epsilon() * 10);
+            expectedMax = std::max<SReal>(expectedMax, std::abs(expectedF[j]));
+        }
+        expectedDot += expectedF * expectedDx;
+    }
+
+    EXPECT_NEAR(results[0], expectedDot, testing::NumericTest<Real>::epsilon() * n * std::abs(expectedDot));
+    EXPECT_NEAR(results[1], expectedMax, testing::NumericTest<Real>::epsilon() * 10);
+}
+
 } // namespace
 
 } // namespace sofa
@@ -22,6 +22,7 @@
 #include <sofa/gui/batch/BatchGUI.h>
 
 #include <sofa/helper/AdvancedTimer.h>
+#include <sofa/simulation/ComponentProfiler.h>
 #include <sofa/helper/system/thread/CTime.h>
 #include <sofa/simulation/Simulation.h>
 #include <sofa/simulation/UpdateContextVisitor.h>
@@ -30,10 +31,14 @@
 #include <sofa/gui/common/ArgumentParser.h>
 
 #include <cxxopts.hpp>
+#include <json.h>
+#include <sofa/version.h>
 
 #include <fstream>
 #include <string>
 #include <iomanip>
+#include <limits>
+#include <thread>
 #include <sofa/gui/batch/ProgressBar.h>
 
 
@@ -57,7 +62,11 @@ BatchGUI::~BatchGUI()
 
 int BatchGUI::mainLoop()
 {
-    if (groot)
+    if (groot && !benchmarkFilename.empty())
+    {
+        runBenchmark();
+    }
+    else if (groot)
     {   
         if (nbIter != -1)
         {   
@@ -124,6 +133,124 @@ int BatchGUI::mainLoop()
     return 0;
 }
 
+void BatchGUI::runBenchmark()
+{
+    using sofa::simulation::ComponentProfiler;
+
+    const int nbMeasuredSteps = nbIter > 0 ? nbIter : DEFAULT_NUMBER_OF_ITERATIONS;
+    msg_info("BatchGUI") << "Benchmark: " << nbWarmUpSteps << " warm-up iterations, then "
+                         << nbMeasuredSteps << " measured iterations." << msgendl;
+
+    for (int i = 0; i < nbWarmUpSteps; ++i)
+    {
+        sofa::simulation::node::animate(groot.get());
+    }
+
+    // the records of the AdvancedTimer are kept for each iteration, but never printed
+    AdvancedTimer::setEnabled("Animate", true);
+    AdvancedTimer::setOutputType("Animate", "stdout");
+    AdvancedTimer::setInterval("Animate", std::numeric_limits<int>::max());
+
+    ComponentProfiler::clear();
+    ComponentProfiler::setEnabled(true);
+
+    std::unique_ptr<ProgressBar> progressBar;
+    if (!hideProgressBar)
+    {
+        progressBar = std::make_unique<ProgressBar>(nbMeasuredSteps);
+    }
+
+    for (int i = 0; i < nbMeasuredSteps; ++i)
+    {
+        ComponentProfiler::beginStep();
+        AdvancedTimer::begin("Animate");
+
+        sofa::simulation::node::animate(groot.get());
+
+        AdvancedTimer::end("Animate");
+        ComponentProfiler::endStep(AdvancedTimer::getRecords("Animate"));
+
+        if (progressBar)
+        {
+            progressBar->tick();
+        }
+    }
+
+    ComponentProfiler::setEnabled(false);
+    AdvancedTimer::setEnabled("Animate", false);
+
+    const auto steps = ComponentProfiler::getStepStatistics();
+    msg_info("BatchGUI") << nbMeasuredSteps << " iterations: " << steps.time.mean << " ms per iteration (median "
+                         << steps.time.median << " ms, p99 " << steps.time.p99 << " ms)." << msgendl;
+
+    exportBenchmark(nbMeasuredSteps);
+}
+
+void BatchGUI::exportBenchmark(int nbMeasuredSteps) const
+{
+    using sofa::simulation::ComponentProfiler;
+
+    const auto toJson = [](const ComponentProfiler::Statistics& statistics)
+    {
+        return nlohmann::json {
+            {"mean", statistics.mean},
+            {"median", statistics.median},
+            {"p99", statistics.p99},
+            {"min", statistics.min},
+            {"max", statistics.max}
+        };
+    };
+
+    const auto steps = ComponentProfiler::getStepStatistics();
+
+    nlohmann::json json;
+    json["context"] = {
+        {"scene", filename},
+        {"sofa_version", SOFA_VERSION_STR},
+        {"hardware_concurrency", std::thread::hardware_concurrency()},
+        {"dt", groot->getDt()},
+        {"warmup_iterations", nbWarmUpSteps},
+        {"iterations", nbMeasuredSteps}
+    };
+    json["step"] = {
+        {"time_ms", toJson(steps.time)},
+        {"thread_utilization", toJson(steps.threadUtilization)},
+        {"allocations", toJson(steps.allocations)}
+    };
+
+    json["components"] = nlohmann::json::array();
+    for (const auto& component : ComponentProfiler::getComponentStatistics())
+    {
+        json["components"].push_back({
+            {"name", component.name},
+            {"class", component.className},
+            {"path", component.path},
+            {"time_ms", toJson(component.time)},
+            {"calls", toJson(component.calls)},
+            {"allocations", toJson(component.allocations)}
+        });
+    }
+
+    json["stages"] = nlohmann::json::array();
+    for (const auto& stage : ComponentProfiler::getStageStatistics())
+    {
+        json["stages"].push_back({
+            {"name", stage.name},
+            {"time_ms", toJson(stage.time)},
+            {"calls", toJson(stage.calls)}
+        });
+    }
+
+    std::ofstream out(benchmarkFilename);
+    if (!out)
+    {
+        msg_error("BatchGUI") << "Cannot write the benchmark results in " << benchmarkFilename;
+        return;
+    }
+    out << json.dump(2);
+    msg_info("BatchGUI") << "Benchmark results written in " << benchmarkFilename;
+}
+
 void BatchGUI::redraw()
 {
 }
@@ -203,6 +330,16 @@ int BatchGUI::RegisterGUIParameters(ArgumentParser* argumentParser)
         "hideProgressBar",
         "if defined, hides the progress bar"
     );
+    argumentParser->addArgument(
+        cxxopts::value<std::string>(benchmarkFilename),
+        "benchmark",
+        "(only batch) Run the benchmark mode and write the per-component statistics of the measured iterations (--nbIter) in the given JSON file"
+    );
+    argumentParser->addArgument(
+        cxxopts::value<int>(nbWarmUpSteps)->default_value("10"),
+        "warmup",
+        "(only batch) Number of iterations simulated before the measured iterations in the benchmark mode"
+    );
     return 0;
 }
 
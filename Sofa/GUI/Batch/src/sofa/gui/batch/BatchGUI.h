@@ -85,6 +85,17 @@ protected:
     static std::string nbIterInp;
     inline static bool hideProgressBar { false };
 
+    /// File where the results of the benchmark mode are written. The benchmark mode is disabled if empty.
+    inline static std::string benchmarkFilename;
+    /// Number of steps simulated before the measured steps in the benchmark mode
+    inline static int nbWarmUpSteps { 10 };
+
+    /// Simulate the warm-up steps, then the measured steps while profiling each component, and write the statistics
+    void runBenchmark();
+
+    /// Write the statistics of the ComponentProfiler in a JSON file
+    void exportBenchmark(int nbMeasuredSteps) const;
+
     /// Return true if the timer output string has a json string and the timer is setup to output json
     static bool canExportJson(const std::string& timerOutputStr, const std::string& timerId);
 
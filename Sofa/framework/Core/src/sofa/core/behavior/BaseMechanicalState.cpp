@@ -21,6 +21,7 @@
 ******************************************************************************/
 #include <sofa/core/behavior/BaseMechanicalState.h>
 #include <sofa/core/objectmodel/BaseNode.h>
+#include <algorithm>
 
 
 namespace sofa::core::behavior
@@ -78,6 +79,31 @@ void BaseMechanicalState::vMultiOp(const ExecParams* params, const VMultiOp& ops
     }
 }
 
+void BaseMechanicalState::vMultiOpReduce(const ExecParams* params, const VMultiOp& ops, const VReductions& reductions, SReal* results)
+{
+    if (!ops.empty())
+    {
+        vMultiOp(params, ops);
+    }
+
+    for (std::size_t i = 0; i < reductions.size(); ++i)
+    {
+        const auto& reduction = reductions[i];
+        if (reduction.type == VReductionEntry::Type::DOT)
+        {
+            results[i] += vDot(params, reduction.a.getId(this), reduction.b.getId(this));
+        }
+        else if (reduction.l > 0)
+        {
+            results[i] += vSum(params, reduction.a.getId(this), reduction.l);
+        }
+        else
+        {
+            results[i] = std::max(results[i], vMax(params, reduction.a.getId(this)));
+        }
+    }
+}
+
 /// Handle state Changes from a given Topology
 void BaseMechanicalState::handleStateChange(core::topology::Topology* /*t*/)
 {
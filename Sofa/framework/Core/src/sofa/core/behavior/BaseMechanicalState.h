@@ -157,6 +157,44 @@ public:
     /// By default this method decompose the computation into multiple vOp calls.
     virtual void vMultiOp(const ExecParams* params, const VMultiOp& ops);
 
+    /// Data structure describing a reduction (scalar product or norm) on vectors
+    /// \see vMultiOpReduce
+    class VReductionEntry
+    {
+    public:
+        enum class Type : char
+        {
+            DOT, ///< scalar product between a and b
+            NORM ///< norm of a. The type of norm is set by l: 0 for the infinite norm.
+        };
+
+        Type type { Type::DOT };
+        ConstMultiVecId a;
+        ConstMultiVecId b;
+        unsigned l { 2 };
+
+        VReductionEntry() = default;
+        VReductionEntry(ConstMultiVecId a, ConstMultiVecId b) : type(Type::DOT), a(a), b(b) {}
+        VReductionEntry(ConstMultiVecId a, unsigned l) : type(Type::NORM), a(a), l(l) {}
+
+        static VReductionEntry dot(ConstMultiVecId a, ConstMultiVecId b) { return {a, b}; }
+        static VReductionEntry norm(ConstMultiVecId a, unsigned l) { return {a, l}; }
+    };
+
+    typedef type::vector< VReductionEntry > VReductions;
+
+    /// \brief Perform a sequence of linear vector operations (see vMultiOp), followed by a sequence of reductions
+    /// computed on the updated vectors.
+    ///
+    /// The result of each reduction is accumulated in the array results, which must contain as many values as
+    /// reductions:
+    /// \li the scalar product and the l-norm (l>0) add the contribution of this state (as vDot and vSum)
+    /// \li the infinite norm is the maximum between the current value and the contribution of this state (as vMax)
+    ///
+    /// It allows to perform in a single traversal of the data what would require several vector operations.
+    /// By default this method calls vMultiOp, then vDot, vSum or vMax for each reduction.
+    virtual void vMultiOpReduce(const ExecParams* params, const VMultiOp& ops, const VReductions& reductions, SReal* results);
+
     /// Compute the scalar products between two vectors.
     virtual SReal vDot(const ExecParams* params, ConstVecId a, ConstVecId b) = 0;
 
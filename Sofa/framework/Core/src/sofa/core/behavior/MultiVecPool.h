@@ -0,0 +1,146 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/core/behavior/MultiVec.h>
+#include <sofa/helper/AdvancedTimer.h>
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace sofa::core::behavior
+{
+
+/// Pool of temporary state vectors, reused from one time step to the next.
+///
+/// Allocating a temporary TMultiVec requires to traverse the graph to find an available identifier, to allocate the
+/// vector in every mechanical state, and to free it afterwards. A pooled vector remains allocated when it is given
+/// back to the pool: the next request only allocates it in the mechanical states which appeared since its previous use.
+///
+/// The values of a pooled vector are NOT reset: they are those left by its previous user. Call clear() on the vector
+/// if the algorithm relies on an initial zero value.
+///
+/// The number of allocations and reuses are reported to the AdvancedTimer.
+template<VecType vtype>
+class TMultiVecPool
+{
+public:
+    typedef TMultiVecId<vtype, V_WRITE> MyMultiVecId;
+
+    /// Temporary vector borrowed from a pool. It is given back to the pool when destroyed.
+    class PooledMultiVec : public TMultiVec<vtype>
+    {
+    public:
+        PooledMultiVec(TMultiVecPool* pool, BaseVectorOperations* vop, MyMultiVecId v)
+            : TMultiVec<vtype>(vop, v), m_pool(pool)
+        {}
+
+        ~PooledMultiVec()
+        {
+            m_pool->release(this->v);
+        }
+
+        using TMultiVec<vtype>::operator=;
+
+    private:
+        TMultiVecPool* m_pool;
+    };
+
+    TMultiVecPool() = default;
+    TMultiVecPool(const TMultiVecPool&) = delete;
+    TMultiVecPool& operator=(const TMultiVecPool&) = delete;
+
+    /// Borrow a vector from the pool, allocating a new one if they are all in use.
+    /// The vector is (re)allocated in the mechanical states where it does not exist yet.
+    PooledMultiVec acquire(BaseVectorOperations* vop, const VecIdProperties& properties = {})
+    {
+        return PooledMultiVec(this, vop, acquireId(vop, properties));
+    }
+
+    /// Same as acquire, but returns the identifier of the vector, which must be given back with release
+    MyMultiVecId acquireId(BaseVectorOperations* vop, const VecIdProperties& properties = {})
+    {
+        auto it = std::find_if(m_vectors.begin(), m_vectors.end(), [](const Entry& e) { return !e.inUse; });
+        if (it == m_vectors.end())
+        {
+            m_vectors.push_back(Entry{ MyMultiVecId::null(), false });
+            it = std::prev(m_vectors.end());
+            helper::AdvancedTimer::valAdd("PooledVectorAllocations", 1);
+        }
+        else
+        {
+            helper::AdvancedTimer::valAdd("PooledVectorReuses", 1);
+        }
+
+        it->inUse = true;
+        vop->v_realloc(it->id, false, false, properties);
+        return it->id;
+    }
+
+    /// Give back to the pool a vector obtained with acquireId
+    void release(const MyMultiVecId& v)
+    {
+        for (auto& entry : m_vectors)
+        {
+            if (entry.inUse && entry.id.getDefaultId() == v.getDefaultId())
+            {
+                entry.inUse = false;
+                return;
+            }
+        }
+    }
+
+    /// Free all the vectors of the pool. They must not be in use.
+    void clear(BaseVectorOperations* vop)
+    {
+        for (auto& entry : m_vectors)
+        {
+            assert(!entry.inUse);
+            vop->v_free(entry.id);
+        }
+        m_vectors.clear();
+    }
+
+    /// Number of vectors allocated by the pool
+    std::size_t size() const { return m_vectors.size(); }
+
+    /// Number of vectors currently borrowed from the pool
+    std::size_t nbInUse() const
+    {
+        return std::count_if(m_vectors.begin(), m_vectors.end(), [](const Entry& e) { return e.inUse; });
+    }
+
+private:
+    struct Entry
+    {
+        MyMultiVecId id;
+        bool inUse;
+    };
+
+    std::vector<Entry> m_vectors;
+};
+
+typedef TMultiVecPool<V_COORD> MultiVecCoordPool;
+typedef TMultiVecPool<V_DERIV> MultiVecDerivPool;
+
+} // namespace sofa::core::behavior
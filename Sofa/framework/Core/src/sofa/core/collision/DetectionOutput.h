@@ -105,6 +105,10 @@ class DetectionOutputVector
     /// Const iterator end to iterate the detection pairs
     virtual type::Vec3 getSecondPosition(unsigned idx) = 0;
 
+    /// Move the contacts of another vector at the end of this vector, leaving the other vector empty.
+    /// Return false if the other vector is not of the same type, in which case nothing is moved.
+    virtual bool append(DetectionOutputVector* other) { SOFA_UNUSED(other); return false; }
+
 };
 
 
@@ -141,5 +145,20 @@ public:
         return (*this)[idx].point[1];
     }
 
+    bool append(DetectionOutputVector* other) override
+    {
+        auto* otherVector = dynamic_cast<TDetectionOutputVector*>(other);
+        if (otherVector == nullptr)
+        {
+            return false;
+        }
+        if (otherVector != this)
+        {
+            this->Vector::insert(this->Vector::end(), otherVector->Vector::begin(), otherVector->Vector::end());
+            otherVector->Vector::clear();
+        }
+        return true;
+    }
+
 };
 } // namespace sofa::core::collision
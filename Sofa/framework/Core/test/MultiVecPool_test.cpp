@@ -0,0 +1,116 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/core/behavior/MultiVecPool.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+using namespace sofa::core;
+using namespace sofa::core::behavior;
+
+/// Vector operations counting the allocations, without any mechanical state
+class CountingVectorOperations : public BaseVectorOperations
+{
+public:
+    CountingVectorOperations() : BaseVectorOperations(nullptr, nullptr) {}
+
+    void v_alloc(MultiVecCoordId&, const VecIdProperties&) override {}
+    void v_alloc(MultiVecDerivId&, const VecIdProperties&) override {}
+    void v_free(MultiVecCoordId&, bool, bool) override {}
+    void v_free(MultiVecDerivId& id, bool, bool) override
+    {
+        ++nbFree;
+        id = MultiVecDerivId::null();
+    }
+    void v_realloc(MultiVecCoordId&, bool, bool, const VecIdProperties&) override {}
+    void v_realloc(MultiVecDerivId& id, bool, bool, const VecIdProperties&) override
+    {
+        ++nbRealloc;
+        if (id.isNull())
+        {
+            id = VecDerivId(nextIndex++);
+        }
+    }
+    void v_clear(MultiVecId) override {}
+    void v_eq(MultiVecId, ConstMultiVecId) override {}
+    void v_eq(MultiVecId, ConstMultiVecId, SReal) override {}
+    void v_peq(MultiVecId, ConstMultiVecId, SReal) override {}
+    void v_teq(MultiVecId, SReal) override {}
+    void v_op(MultiVecId, ConstMultiVecId, ConstMultiVecId, SReal) override {}
+    void v_multiop(const BaseMechanicalState::VMultiOp&) override {}
+    void v_dot(ConstMultiVecId, ConstMultiVecId) override {}
+    void v_norm(ConstMultiVecId, unsigned) override {}
+    void v_threshold(MultiVecId, SReal) override {}
+    SReal finish() override { return 0; }
+    void print(ConstMultiVecId, std::ostream&, std::string, std::string) override {}
+    size_t v_size(MultiVecId) override { return 0; }
+
+    unsigned int nextIndex { VecDerivId::V_FIRST_DYNAMIC_INDEX };
+    unsigned int nbRealloc { 0 };
+    unsigned int nbFree { 0 };
+};
+
+TEST(MultiVecPool, reuse)
+{
+    CountingVectorOperations vop;
+    MultiVecDerivPool pool;
+
+    unsigned int firstIndex {};
+    {
+        auto a = pool.acquire(&vop);
+        auto b = pool.acquire(&vop);
+        EXPECT_NE(a.id().getDefaultId(), b.id().getDefaultId());
+        EXPECT_EQ(pool.size(), 2);
+        EXPECT_EQ(pool.nbInUse(), 2);
+        firstIndex = a.id().getDefaultId().index;
+    }
+    EXPECT_EQ(pool.nbInUse(), 0);
+
+    // a second "time step" reuses the same vectors
+    for (int step = 0; step < 3; ++step)
+    {
+        auto a = pool.acquire(&vop);
+        auto b = pool.acquire(&vop);
+        EXPECT_EQ(a.id().getDefaultId().index, firstIndex);
+        EXPECT_EQ(pool.size(), 2);
+    }
+    EXPECT_EQ(vop.nextIndex, VecDerivId::V_FIRST_DYNAMIC_INDEX + 2);
+    EXPECT_EQ(vop.nbRealloc, 8);
+    EXPECT_EQ(vop.nbFree, 0);
+
+    // a vector borrowed through its identifier
+    {
+        const auto id = pool.acquireId(&vop);
+        auto a = pool.acquire(&vop);
+        auto b = pool.acquire(&vop);
+        EXPECT_EQ(pool.size(), 3);
+        pool.release(id);
+    }
+    EXPECT_EQ(pool.nbInUse(), 0);
+
+    pool.clear(&vop);
+    EXPECT_EQ(pool.size(), 0);
+    EXPECT_EQ(vop.nbFree, 3);
+}
+
+}
@@ -26,15 +26,23 @@ namespace sofa::helper
 {
 
 ScopedAdvancedTimer::ScopedAdvancedTimer(const std::string& message)
-    : m_id( message )
+    : m_traceEvent( message.c_str() )
 {
-    AdvancedTimer::stepBegin( m_id );
+    if (AdvancedTimer::isActive())
+    {
+        m_id = AdvancedTimer::IdStep( message );
+        AdvancedTimer::stepBegin( m_id );
+    }
 }
 
 ScopedAdvancedTimer::ScopedAdvancedTimer( const char* message )
-    : m_id( message )
+    : m_traceEvent( message )
 {
-    AdvancedTimer::stepBegin( m_id );
+    if (AdvancedTimer::isActive())
+    {
+        m_id = AdvancedTimer::IdStep( message );
+        AdvancedTimer::stepBegin( m_id );
+    }
 }
 
 ScopedAdvancedTimer::~ScopedAdvancedTimer()
@@ -43,7 +51,7 @@ ScopedAdvancedTimer::~ScopedAdvancedTimer()
     {
         AdvancedTimer::stepEnd( m_id, *m_objId );
     }
-    else
+    else if (m_id)
     {
         AdvancedTimer::stepEnd( m_id );
     }
@@ -26,6 +26,7 @@
 #include<string>
 
 #include <sofa/helper/AdvancedTimer.h>
+#include <sofa/helper/TimerTrace.h>
 
 namespace sofa::helper
 {
@@ -38,8 +39,11 @@ namespace sofa::helper
 ///     ...
 /// }   ///< close the scope... the timer t is destructed and the
 ///     measurement recorded.
+/// The scope is also recorded in the Chrome trace if TimerTrace is enabled. The step id is
+/// created only if an AdvancedTimer is active, to keep the overhead low otherwise.
 struct SOFA_HELPER_API ScopedAdvancedTimer
 {
+    TimerTrace::ScopedEvent m_traceEvent;
     AdvancedTimer::IdStep m_id;
     std::optional<AdvancedTimer::IdObj> m_objId;
 
@@ -55,10 +59,14 @@ struct SOFA_HELPER_API ScopedAdvancedTimer
 
 template <class T>
 ScopedAdvancedTimer::ScopedAdvancedTimer(const char* message, T* obj)
-    : m_id(message)
-    , m_objId(obj->getName())
+    : m_traceEvent(message)
 {
-    AdvancedTimer::stepBegin(m_id, *m_objId);
+    if (AdvancedTimer::isActive())
+    {
+        m_id = AdvancedTimer::IdStep(message);
+        m_objId = AdvancedTimer::IdObj(obj->getName());
+        AdvancedTimer::stepBegin(m_id, *m_objId);
+    }
 }
 
 } /// sofa::helper
@@ -0,0 +1,527 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/helper/TimerTrace.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define SOFA_TIMERTRACE_USE_RDTSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define SOFA_TIMERTRACE_USE_RDTSC
+#endif
+
+namespace sofa::helper
+{
+
+std::atomic<bool> TimerTrace::s_enabled { false };
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+std::int64_t readNanoseconds()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+/// Timestamp of the events. On x86, the time stamp counter is much cheaper to read than the
+/// system clock; the ticks are converted to nanoseconds when the events are written.
+std::int64_t readTicks()
+{
+#ifdef SOFA_TIMERTRACE_USE_RDTSC
+    return static_cast<std::int64_t>(__rdtsc());
+#else
+    return readNanoseconds();
+#endif
+}
+
+/// Simultaneous readings of the tick counter and of the clock
+struct ClockAnchor
+{
+    std::int64_t ticks { 0 };
+    std::int64_t nanoseconds { 0 };
+
+    static ClockAnchor now()
+    {
+        return { readTicks(), readNanoseconds() };
+    }
+};
+
+/// Linear interpolation (or extrapolation) of the time of a tick between two anchors
+std::int64_t toNanoseconds(std::int64_t tick, const ClockAnchor& a, const ClockAnchor& b)
+{
+    if (b.ticks == a.ticks)
+    {
+        return a.nanoseconds + (tick - a.ticks);
+    }
+    const double ratio = static_cast<double>(b.nanoseconds - a.nanoseconds) / static_cast<double>(b.ticks - a.ticks);
+    return a.nanoseconds + static_cast<std::int64_t>(static_cast<double>(tick - a.ticks) * ratio);
+}
+
+struct TraceEvent
+{
+    /// see readTicks()
+    std::int64_t timestamp;
+    /// recording session in which the event has been recorded
+    std::uint32_t generation;
+    char type;
+    char name[TimerTrace::MaxNameLength + 1];
+};
+
+static_assert((TimerTrace::BufferCapacity & (TimerTrace::BufferCapacity - 1)) == 0,
+              "the capacity of the buffers must be a power of two");
+
+/// Single-producer (the recorded thread), single-consumer (the flusher thread) ring buffer
+struct ThreadBuffer
+{
+    static constexpr std::size_t NoDroppedEvent = std::numeric_limits<std::size_t>::max();
+
+    std::unique_ptr<TraceEvent[]> events { new TraceEvent[TimerTrace::BufferCapacity] };
+
+    /// written by the recorded thread
+    alignas(64) std::atomic<std::size_t> head { 0 };
+    /// written by the flusher
+    alignas(64) std::atomic<std::size_t> tail { 0 };
+
+    // accessed only by the recorded thread
+    alignas(64) std::size_t cachedTail { 0 };
+    std::uint32_t generation { 0 };
+    /// nesting level of the current scope
+    std::size_t depth { 0 };
+    /// nesting level of the outermost scope which has been dropped: its nested scopes and its end
+    /// are dropped too, so that the trace remains consistent
+    std::size_t droppedDepth { NoDroppedEvent };
+    /// number of recorded begin events waiting for their end event
+    std::size_t openEvents { 0 };
+
+    std::atomic<std::size_t> droppedEvents { 0 };
+    std::atomic<bool> threadExited { false };
+
+    // protected by the registry mutex
+    unsigned int tid { 0 };
+    std::string name;
+    bool hasCustomName { false };
+    bool nameWritten { false };
+};
+
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer> > buffers;
+    unsigned int nextTid { 1 };
+    std::size_t droppedEventsOfExitedThreads { 0 };
+
+    // recording session
+    std::atomic<std::uint32_t> generation { 0 };
+    ClockAnchor startAnchor;
+    /// anchor taken during the previous drain of the buffers
+    ClockAnchor lastAnchor;
+    std::ofstream file;
+    bool isFirstEvent { true };
+    std::thread flusher;
+    std::mutex flusherMutex;
+    std::condition_variable flusherCondition;
+    bool stopRequested { false };
+    bool isRunning { false };
+};
+
+Registry& getRegistry()
+{
+    // never destroyed: buffers may still be released by exiting threads during the static destruction
+    static Registry* registry = new Registry;
+    return *registry;
+}
+
+struct ThreadBufferHandle
+{
+    std::shared_ptr<ThreadBuffer> buffer;
+    ~ThreadBufferHandle()
+    {
+        if (buffer)
+        {
+            buffer->threadExited.store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadBufferHandle t_threadBuffer;
+
+ThreadBuffer& getThreadBuffer()
+{
+    auto& buffer = t_threadBuffer.buffer;
+    if (!buffer)
+    {
+        buffer = std::make_shared<ThreadBuffer>();
+        Registry& registry = getRegistry();
+        std::lock_guard lock(registry.mutex);
+        buffer->tid = registry.nextTid++;
+        buffer->name = "Thread " + std::to_string(buffer->tid);
+        registry.buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+/// Reset the state of the buffer if a new recording session has started
+void synchronizeGeneration(ThreadBuffer& buffer)
+{
+    const std::uint32_t generation = getRegistry().generation.load(std::memory_order_relaxed);
+    if (buffer.generation != generation)
+    {
+        buffer.generation = generation;
+        buffer.depth = 0;
+        buffer.droppedDepth = ThreadBuffer::NoDroppedEvent;
+        buffer.openEvents = 0;
+    }
+}
+
+/// @param requiredSlots number of free slots needed in the buffer to push the event
+bool push(ThreadBuffer& buffer, char type, const char* name, std::size_t requiredSlots)
+{
+    const std::int64_t timestamp = readTicks();
+
+    const std::size_t head = buffer.head.load(std::memory_order_relaxed);
+    if (head - buffer.cachedTail + requiredSlots > TimerTrace::BufferCapacity)
+    {
+        buffer.cachedTail = buffer.tail.load(std::memory_order_acquire);
+        if (head - buffer.cachedTail + requiredSlots > TimerTrace::BufferCapacity)
+        {
+            return false;
+        }
+    }
+
+    TraceEvent& event = buffer.events[head & (TimerTrace::BufferCapacity - 1)];
+    event.timestamp = timestamp;
+    event.generation = buffer.generation;
+    event.type = type;
+    if (name)
+    {
+        std::size_t i = 0;
+        for (; i < TimerTrace::MaxNameLength && name[i] != '\0'; ++i)
+        {
+            event.name[i] = name[i];
+        }
+        event.name[i] = '\0';
+    }
+    else
+    {
+        event.name[0] = '\0';
+    }
+
+    buffer.head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void writeEscaped(std::ostream& out, const char* str)
+{
+    for (; *str; ++str)
+    {
+        const char c = *str;
+        if (c == '"' || c == '\\')
+        {
+            out << '\\' << c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+            out << escaped;
+        }
+        else
+        {
+            out << c;
+        }
+    }
+}
+
+void beginJsonEvent(Registry& registry)
+{
+    if (!registry.isFirstEvent)
+    {
+        registry.file << ",\n";
+    }
+    registry.isFirstEvent = false;
+}
+
+/// Write the events of all the buffers in the trace file. Only called by the flusher thread.
+void drainBuffers(Registry& registry)
+{
+    struct BufferInfo
+    {
+        std::shared_ptr<ThreadBuffer> buffer;
+        std::string name;
+        bool writeName;
+    };
+    std::vector<BufferInfo> buffers;
+    {
+        std::lock_guard lock(registry.mutex);
+        buffers.reserve(registry.buffers.size());
+        for (const auto& buffer : registry.buffers)
+        {
+            buffers.push_back({buffer, buffer->name, !buffer->nameWritten});
+            buffer->nameWritten = true;
+        }
+    }
+
+    const std::uint32_t generation = registry.generation.load(std::memory_order_relaxed);
+    auto& out = registry.file;
+
+    std::vector<std::size_t> heads(buffers.size());
+    for (std::size_t b = 0; b < buffers.size(); ++b)
+    {
+        heads[b] = buffers[b].buffer->head.load(std::memory_order_acquire);
+    }
+
+    // all the events to write have been recorded before this anchor: their time is interpolated
+    // between the previous anchor and this one
+    const ClockAnchor anchor = ClockAnchor::now();
+
+    for (std::size_t b = 0; b < buffers.size(); ++b)
+    {
+        const auto& [buffer, name, writeName] = buffers[b];
+        const std::size_t head = heads[b];
+        const std::size_t tail = buffer->tail.load(std::memory_order_relaxed);
+        if (head == tail && !writeName)
+        {
+            continue;
+        }
+
+        if (writeName)
+        {
+            beginJsonEvent(registry);
+            out << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->tid << R"(,"args":{"name":")";
+            writeEscaped(out, name.c_str());
+            out << "\"}}";
+        }
+
+        for (std::size_t i = tail; i != head; ++i)
+        {
+            const TraceEvent& event = buffer->events[i & (TimerTrace::BufferCapacity - 1)];
+            if (event.generation != generation)
+            {
+                continue;
+            }
+
+            const std::int64_t time = toNanoseconds(event.timestamp, registry.lastAnchor, anchor) - registry.startAnchor.nanoseconds;
+            char timestamp[32];
+            std::snprintf(timestamp, sizeof(timestamp), "%.3f", static_cast<double>(time) * 1e-3);
+
+            beginJsonEvent(registry);
+            if (event.type == 'B')
+            {
+                out << R"({"name":")";
+                writeEscaped(out, event.name);
+                out << R"(","ph":"B","ts":)" << timestamp << R"(,"pid":1,"tid":)" << buffer->tid << '}';
+            }
+            else
+            {
+                out << R"({"ph":"E","ts":)" << timestamp << R"(,"pid":1,"tid":)" << buffer->tid << '}';
+            }
+        }
+
+        buffer->tail.store(head, std::memory_order_release);
+    }
+
+    registry.lastAnchor = anchor;
+
+    // forget the threads which have exited once all their events have been written
+    std::lock_guard lock(registry.mutex);
+    for (auto it = registry.buffers.begin(); it != registry.buffers.end();)
+    {
+        const auto& buffer = *it;
+        if (buffer->threadExited.load(std::memory_order_acquire)
+            && buffer->head.load(std::memory_order_acquire) == buffer->tail.load(std::memory_order_relaxed))
+        {
+            registry.droppedEventsOfExitedThreads += buffer->droppedEvents.load(std::memory_order_relaxed);
+            it = registry.buffers.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void flusherLoop(Registry& registry)
+{
+    std::unique_lock lock(registry.flusherMutex);
+    while (!registry.stopRequested)
+    {
+        registry.flusherCondition.wait_for(lock, std::chrono::milliseconds(10));
+        lock.unlock();
+        drainBuffers(registry);
+        lock.lock();
+    }
+}
+
+}
+
+bool TimerTrace::start(const std::string& filename)
+{
+    Registry& registry = getRegistry();
+    if (registry.isRunning)
+    {
+        return false;
+    }
+
+    registry.file.open(filename, std::ios::trunc);
+    if (!registry.file.is_open())
+    {
+        return false;
+    }
+
+    // name the thread starting the recording, if it has no name yet
+    ThreadBuffer& mainBuffer = getThreadBuffer();
+    {
+        std::lock_guard lock(registry.mutex);
+        if (!mainBuffer.hasCustomName)
+        {
+            mainBuffer.name = "Main";
+        }
+        for (const auto& buffer : registry.buffers)
+        {
+            buffer->nameWritten = false;
+            buffer->droppedEvents.store(0, std::memory_order_relaxed);
+        }
+        registry.droppedEventsOfExitedThreads = 0;
+    }
+
+    registry.file << "{\"traceEvents\":[\n";
+    registry.isFirstEvent = true;
+    beginJsonEvent(registry);
+    registry.file << R"({"name":"process_name","ph":"M","pid":1,"args":{"name":"SOFA"}})";
+
+    registry.startAnchor = ClockAnchor::now();
+    registry.lastAnchor = registry.startAnchor;
+    registry.generation.fetch_add(1, std::memory_order_relaxed);
+    registry.stopRequested = false;
+    registry.isRunning = true;
+    registry.flusher = std::thread(flusherLoop, std::ref(registry));
+
+    s_enabled.store(true, std::memory_order_release);
+    return true;
+}
+
+void TimerTrace::stop()
+{
+    Registry& registry = getRegistry();
+    if (!registry.isRunning)
+    {
+        return;
+    }
+
+    s_enabled.store(false, std::memory_order_release);
+
+    {
+        std::lock_guard lock(registry.flusherMutex);
+        registry.stopRequested = true;
+    }
+    registry.flusherCondition.notify_one();
+    registry.flusher.join();
+
+    // events recorded by the threads until they noticed the end of the recording
+    drainBuffers(registry);
+
+    registry.file << "\n]}\n";
+    registry.file.close();
+    registry.isRunning = false;
+}
+
+void TimerTrace::setCurrentThreadName(const std::string& name)
+{
+    ThreadBuffer& buffer = getThreadBuffer();
+    std::lock_guard lock(getRegistry().mutex);
+    buffer.name = name;
+    buffer.hasCustomName = true;
+    buffer.nameWritten = false;
+}
+
+std::size_t TimerTrace::getDroppedEventCount()
+{
+    Registry& registry = getRegistry();
+    std::lock_guard lock(registry.mutex);
+    std::size_t count = registry.droppedEventsOfExitedThreads;
+    for (const auto& buffer : registry.buffers)
+    {
+        count += buffer->droppedEvents.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+void TimerTrace::recordBegin(const char* name)
+{
+    ThreadBuffer& buffer = getThreadBuffer();
+    synchronizeGeneration(buffer);
+
+    ++buffer.depth;
+    // keep enough room for the end events of all the open scopes
+    if (buffer.depth >= buffer.droppedDepth || !push(buffer, 'B', name, buffer.openEvents + 2))
+    {
+        if (buffer.depth < buffer.droppedDepth)
+        {
+            buffer.droppedDepth = buffer.depth;
+        }
+        buffer.droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ++buffer.openEvents;
+}
+
+void TimerTrace::recordEnd()
+{
+    ThreadBuffer& buffer = getThreadBuffer();
+    synchronizeGeneration(buffer);
+
+    if (buffer.depth == 0)
+    {
+        // the scope has begun in a previous recording session
+        return;
+    }
+
+    if (buffer.depth >= buffer.droppedDepth)
+    {
+        if (buffer.depth == buffer.droppedDepth)
+        {
+            buffer.droppedDepth = ThreadBuffer::NoDroppedEvent;
+        }
+        --buffer.depth;
+        return;
+    }
+
+    --buffer.depth;
+    --buffer.openEvents;
+    push(buffer, 'E', nullptr, 1);
+}
+
+} // namespace sofa::helper
@@ -0,0 +1,113 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+#include <sofa/helper/config.h>
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+namespace sofa::helper
+{
+
+/**
+ * Low-overhead recording of timed scopes into a Chrome trace (https://ui.perfetto.dev or
+ * chrome://tracing).
+ *
+ * Unlike AdvancedTimer, events can be recorded from any thread, including the worker threads of
+ * the task schedulers. Each thread writes its events into its own fixed-size ring buffer, without
+ * any lock or allocation. A background thread periodically drains the buffers and writes the events
+ * into the trace file.
+ *
+ * When a buffer is full, the new scopes are dropped (see getDroppedEventCount), so the recording
+ * never blocks the recorded threads.
+ *
+ * Usage:
+ *   TimerTrace::start("trace.json");
+ *   ... // ScopedAdvancedTimer and TimerTrace::ScopedEvent scopes are recorded
+ *   TimerTrace::stop();
+ */
+class SOFA_HELPER_API TimerTrace
+{
+public:
+    /// Maximum number of characters of an event name. Longer names are truncated.
+    static constexpr std::size_t MaxNameLength = 47;
+
+    /// Number of events in the buffer of each thread
+    static constexpr std::size_t BufferCapacity = 1 << 14;
+
+    /// Start recording events, written in the given file by a background thread
+    /// @return false if the file cannot be created or if a recording is already running
+    static bool start(const std::string& filename);
+
+    /// Stop recording, write the remaining events and close the file
+    static void stop();
+
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    static void beginEvent(const char* name)
+    {
+        if (isEnabled()) recordBegin(name);
+    }
+    static void beginEvent(const std::string& name)
+    {
+        if (isEnabled()) recordBegin(name.c_str());
+    }
+    /// End the last event begun on this thread
+    static void endEvent()
+    {
+        if (isEnabled()) recordEnd();
+    }
+
+    /// Name of the calling thread in the trace
+    static void setCurrentThreadName(const std::string& name);
+
+    /// Number of events which could not be recorded since start() because a buffer was full
+    static std::size_t getDroppedEventCount();
+
+    /// RAII event
+    class ScopedEvent
+    {
+    public:
+        explicit ScopedEvent(const char* name) : m_recorded(isEnabled())
+        {
+            if (m_recorded) recordBegin(name);
+        }
+        ~ScopedEvent()
+        {
+            if (m_recorded) recordEnd();
+        }
+        ScopedEvent(const ScopedEvent&) = delete;
+        ScopedEvent& operator=(const ScopedEvent&) = delete;
+
+    private:
+        bool m_recorded;
+    };
+
+private:
+    static void recordBegin(const char* name);
+    static void recordEnd();
+
+    static std::atomic<bool> s_enabled;
+};
+
+} // namespace sofa::helper
@@ -0,0 +1,80 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/helper/config.h>
+
+#include <cstddef>
+#include <string>
+
+namespace sofa::helper::system
+{
+
+/**
+ * @brief Read-only view of a whole file mapped in memory.
+ *
+ * The file is mapped with mmap on POSIX systems and with CreateFileMapping on Windows. The pages
+ * are loaded lazily by the operating system, so opening a large file is cheap and random access
+ * does not require any seek or copy.
+ */
+class SOFA_HELPER_API MemoryMappedFile
+{
+public:
+    MemoryMappedFile() = default;
+    explicit MemoryMappedFile(const std::string& filename);
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    MemoryMappedFile(MemoryMappedFile&& other) noexcept;
+    MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept;
+
+    /// Map the whole file in memory. A previously opened file is closed first.
+    /// @return false if the file cannot be opened or mapped. An empty file is opened successfully
+    /// but has a null data pointer.
+    bool open(const std::string& filename);
+
+    void close();
+
+    bool isOpen() const { return m_isOpen; }
+
+    const std::byte* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+
+    /// Description of the last error which occurred in open()
+    const std::string& getLastError() const { return m_lastError; }
+
+private:
+    void swap(MemoryMappedFile& other) noexcept;
+
+    const std::byte* m_data { nullptr };
+    std::size_t m_size { 0 };
+    bool m_isOpen { false };
+    std::string m_lastError;
+
+#ifdef WIN32
+    void* m_fileHandle { nullptr };
+    void* m_mappingHandle { nullptr };
+#endif
+};
+
+} // namespace sofa::helper::system
@@ -0,0 +1,211 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/helper/TimerTrace.h>
+#include <sofa/helper/ScopedAdvancedTimer.h>
+#include <gtest/gtest.h>
+#include <json.h>
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using sofa::helper::TimerTrace;
+using json = sofa::helper::json;
+
+std::string traceFilename(const std::string& name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+json readTrace(const std::string& filename)
+{
+    std::ifstream file(filename);
+    return json::parse(file);
+}
+
+struct ThreadEvents
+{
+    std::size_t nbBegin { 0 };
+    std::size_t nbEnd { 0 };
+    std::map<std::string, std::size_t> names;
+    std::string threadName;
+};
+
+/// Events of the trace, per thread id. Checks that each end matches a begin.
+std::map<int, ThreadEvents> parseEvents(const json& trace)
+{
+    std::map<int, ThreadEvents> threads;
+    std::map<int, int> depth;
+    for (const auto& event : trace["traceEvents"])
+    {
+        const std::string phase = event["ph"];
+        if (phase == "M")
+        {
+            if (event["name"] == "thread_name")
+            {
+                threads[event["tid"]].threadName = event["args"]["name"];
+            }
+            continue;
+        }
+
+        const int tid = event["tid"];
+        if (phase == "B")
+        {
+            ++threads[tid].nbBegin;
+            ++threads[tid].names[event["name"]];
+            ++depth[tid];
+        }
+        else if (phase == "E")
+        {
+            ++threads[tid].nbEnd;
+            EXPECT_GT(depth[tid], 0);
+            --depth[tid];
+        }
+    }
+    return threads;
+}
+
+}
+
+TEST(TimerTrace, disabled)
+{
+    EXPECT_FALSE(TimerTrace::isEnabled());
+    TimerTrace::beginEvent("notRecorded");
+    TimerTrace::endEvent();
+    TimerTrace::ScopedEvent event("notRecorded");
+}
+
+TEST(TimerTrace, multipleThreads)
+{
+    const auto filename = traceFilename("TimerTrace_multipleThreads.json");
+    ASSERT_TRUE(TimerTrace::start(filename));
+    EXPECT_TRUE(TimerTrace::isEnabled());
+    EXPECT_FALSE(TimerTrace::start(filename));
+
+    static constexpr std::size_t nbThreads = 4;
+    static constexpr std::size_t nbScopes = 1000;
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < nbThreads; ++t)
+    {
+        threads.emplace_back([t]()
+        {
+            TimerTrace::setCurrentThreadName("Worker" + std::to_string(t));
+            for (std::size_t i = 0; i < nbScopes; ++i)
+            {
+                TimerTrace::ScopedEvent outer("outer");
+                TimerTrace::ScopedEvent inner("inner \"quoted\"");
+            }
+        });
+    }
+    {
+        TimerTrace::ScopedEvent mainEvent("main");
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    TimerTrace::stop();
+    EXPECT_FALSE(TimerTrace::isEnabled());
+    EXPECT_EQ(TimerTrace::getDroppedEventCount(), 0u);
+
+    const auto events = parseEvents(readTrace(filename));
+
+    std::size_t nbWorkers = 0;
+    bool hasMain = false;
+    for (const auto& [tid, thread] : events)
+    {
+        EXPECT_EQ(thread.nbBegin, thread.nbEnd);
+        if (thread.threadName.rfind("Worker", 0) == 0)
+        {
+            ++nbWorkers;
+            EXPECT_EQ(thread.nbBegin, 2 * nbScopes);
+            EXPECT_EQ(thread.names.at("outer"), nbScopes);
+            EXPECT_EQ(thread.names.at("inner \"quoted\""), nbScopes);
+        }
+        else if (thread.threadName == "Main")
+        {
+            hasMain = true;
+            EXPECT_EQ(thread.names.at("main"), 1u);
+        }
+    }
+    EXPECT_EQ(nbWorkers, nbThreads);
+    EXPECT_TRUE(hasMain);
+}
+
+TEST(TimerTrace, bufferFull)
+{
+    const auto filename = traceFilename("TimerTrace_bufferFull.json");
+    ASSERT_TRUE(TimerTrace::start(filename));
+
+    // nested scopes cannot be written before they end: the buffer becomes full
+    static constexpr std::size_t nbScopes = 2 * TimerTrace::BufferCapacity;
+    {
+        std::vector<std::unique_ptr<TimerTrace::ScopedEvent> > scopes;
+        for (std::size_t i = 0; i < nbScopes; ++i)
+        {
+            scopes.push_back(std::make_unique<TimerTrace::ScopedEvent>("nested"));
+        }
+        while (!scopes.empty())
+        {
+            scopes.pop_back();
+        }
+    }
+
+    TimerTrace::stop();
+    EXPECT_GE(TimerTrace::getDroppedEventCount(), nbScopes - TimerTrace::BufferCapacity);
+
+    // the dropped scopes have neither begin nor end
+    for (const auto& [tid, thread] : parseEvents(readTrace(filename)))
+    {
+        EXPECT_EQ(thread.nbBegin, thread.nbEnd);
+    }
+}
+
+TEST(TimerTrace, scopedAdvancedTimer)
+{
+    const auto filename = traceFilename("TimerTrace_scopedAdvancedTimer.json");
+    ASSERT_TRUE(TimerTrace::start(filename));
+    {
+        sofa::helper::ScopedAdvancedTimer timer("advancedTimerStep");
+        sofa::helper::ScopedAdvancedTimer timer2(std::string("advancedTimerStep2"));
+    }
+    TimerTrace::stop();
+
+    std::size_t nbSteps = 0;
+    for (const auto& [tid, thread] : parseEvents(readTrace(filename)))
+    {
+        if (thread.names.count("advancedTimerStep"))
+        {
+            ++nbSteps;
+            EXPECT_EQ(thread.names.at("advancedTimerStep2"), 1u);
+        }
+    }
+    EXPECT_EQ(nbSteps, 1u);
+}
@@ -21,6 +21,8 @@
 ******************************************************************************/
 #pragma once
 #include <sofa/config.h>
+#include <sofa/type/vector.h>
+#include <algorithm>
 #include <cstring>
 #include <cmath>
 
@@ -97,6 +99,182 @@ void solveUpperUnitriangularSystemCSR(
     }
 }
 
+/// Solves a lower unitriangular system where the matrix is represented in CSR format, for
+/// several right-hand side vectors at once
+///
+/// Same as solveLowerUnitriangularSystemCSR, but the NbRHS right-hand side vectors (and
+/// solution vectors) are interleaved: the i-th entry of the r-th vector is stored at index
+/// i * NbRHS + r. Each value of the matrix is loaded once for all the vectors, and the innermost
+/// loop over the vectors can be vectorized by the compiler.
+/// The right-hand side and the solution can be the same array.
+template<sofa::Size NbRHS, typename Real, typename Integer>
+void solveLowerUnitriangularSystemCSRMultipleRHS(
+    const sofa::Size systemSize,
+    const Real* rightHandSideVectors,
+    Real* solutionVectors,
+    const Integer* const CSR_rows,
+    const Integer* const CSR_columns,
+    const Real* const CSR_values
+    )
+{
+    for (sofa::Size i = 0; i < systemSize; ++i)
+    {
+        Real x_i[NbRHS];
+        for (sofa::Size r = 0; r < NbRHS; ++r)
+        {
+            x_i[r] = rightHandSideVectors[i * NbRHS + r];
+        }
+        for (Integer p = CSR_rows[i]; p < CSR_rows[i + 1]; ++p)
+        {
+            const Real value = CSR_values[p];
+            const Real* x_j = solutionVectors + static_cast<std::size_t>(CSR_columns[p]) * NbRHS;
+            for (sofa::Size r = 0; r < NbRHS; ++r)
+            {
+                x_i[r] -= value * x_j[r];
+            }
+        }
+        for (sofa::Size r = 0; r < NbRHS; ++r)
+        {
+            solutionVectors[i * NbRHS + r] = x_i[r];
+        }
+    }
+}
+
+/// Solves a upper unitriangular system where the matrix is represented in CSR format, for
+/// several right-hand side vectors at once
+///
+/// Same as solveUpperUnitriangularSystemCSR, with interleaved vectors (see
+/// solveLowerUnitriangularSystemCSRMultipleRHS).
+template<sofa::Size NbRHS, typename Real, typename Integer>
+void solveUpperUnitriangularSystemCSRMultipleRHS(
+    const sofa::Size systemSize,
+    const Real* rightHandSideVectors,
+    Real* solutionVectors,
+    const Integer* const CSR_rows,
+    const Integer* const CSR_columns,
+    const Real* const CSR_values
+    )
+{
+    for (sofa::Size i = systemSize - 1; i != static_cast<sofa::Size>(-1); --i)
+    {
+        Real x_i[NbRHS];
+        for (sofa::Size r = 0; r < NbRHS; ++r)
+        {
+            x_i[r] = rightHandSideVectors[i * NbRHS + r];
+        }
+        for (Integer p = CSR_rows[i]; p < CSR_rows[i + 1]; ++p)
+        {
+            const Real value = CSR_values[p];
+            const Real* x_j = solutionVectors + static_cast<std::size_t>(CSR_columns[p]) * NbRHS;
+            for (sofa::Size r = 0; r < NbRHS; ++r)
+            {
+                x_i[r] -= value * x_j[r];
+            }
+        }
+        for (sofa::Size r = 0; r < NbRHS; ++r)
+        {
+            solutionVectors[i * NbRHS + r] = x_i[r];
+        }
+    }
+}
+
+/// Computes the level sets of a unitriangular matrix represented in CSR format
+///
+/// The level of a row is 0 if it does not depend on any other row, otherwise it is one more than
+/// the maximum level of the rows it depends on. The rows of a level are independent: they can be
+/// solved in parallel (see solveUnitriangularSystemCSRRows), once all the rows of the previous
+/// levels are solved.
+///
+/// \param systemSize The size of the system
+/// \param CSR_rows The array storing the starting index of each row in the data array.
+/// \param CSR_columns The array storing the column indices of the nonzero values in the data array.
+/// \param isLower true if the matrix is lower triangular, false if it is upper triangular
+/// \param levelPtr Output: the rows of the level l are levelRows[levelPtr[l]] to levelRows[levelPtr[l+1]-1]
+/// \param levelRows Output: the rows sorted by level. In a level, the rows are sorted by index.
+template<typename Integer>
+void computeUnitriangularSystemLevelsCSR(
+    const sofa::Size systemSize,
+    const Integer* const CSR_rows,
+    const Integer* const CSR_columns,
+    const bool isLower,
+    sofa::type::vector<Integer>& levelPtr,
+    sofa::type::vector<Integer>& levelRows
+    )
+{
+    levelPtr.clear();
+    levelRows.clear();
+    if (systemSize == 0)
+    {
+        return;
+    }
+
+    sofa::type::vector<Integer> level(systemSize, 0);
+    Integer nbLevels = 0;
+    for (sofa::Size k = 0; k < systemSize; ++k)
+    {
+        const sofa::Size i = isLower ? k : systemSize - 1 - k;
+        Integer l = 0;
+        for (Integer p = CSR_rows[i]; p < CSR_rows[i + 1]; ++p)
+        {
+            const auto j = static_cast<sofa::Size>(CSR_columns[p]);
+            if (j != i)
+            {
+                l = std::max(l, static_cast<Integer>(level[j] + 1));
+            }
+        }
+        level[i] = l;
+        nbLevels = std::max(nbLevels, static_cast<Integer>(l + 1));
+    }
+
+    levelPtr.resize(nbLevels + 1, 0);
+    for (sofa::Size i = 0; i < systemSize; ++i)
+    {
+        ++levelPtr[level[i] + 1];
+    }
+    for (Integer l = 0; l < nbLevels; ++l)
+    {
+        levelPtr[l + 1] += levelPtr[l];
+    }
+
+    levelRows.resize(systemSize);
+    sofa::type::vector<Integer> position(levelPtr.begin(), levelPtr.end() - 1);
+    for (sofa::Size i = 0; i < systemSize; ++i)
+    {
+        levelRows[position[level[i]]++] = static_cast<Integer>(i);
+    }
+}
+
+/// Solves a subset of the rows of a unitriangular system where the matrix is represented in CSR
+/// format
+///
+/// The entries of the solution on which the rows depend must have been computed before. It is
+/// used to solve the rows of a level computed by computeUnitriangularSystemLevelsCSR. The
+/// right-hand side and the solution can be the same array.
+///
+/// \param firstRow, lastRow The range of indices of the rows to solve
+template<typename Real, typename Integer>
+void solveUnitriangularSystemCSRRows(
+    const Integer* firstRow,
+    const Integer* lastRow,
+    const Real* rightHandSideVector,
+    Real* solutionVector,
+    const Integer* const CSR_rows,
+    const Integer* const CSR_columns,
+    const Real* const CSR_values
+    )
+{
+    for (; firstRow != lastRow; ++firstRow)
+    {
+        const Integer i = *firstRow;
+        Real x_i = rightHandSideVector[i];
+        for (Integer p = CSR_rows[i]; p < CSR_rows[i + 1]; ++p)
+        {
+            x_i -= CSR_values[p] * solutionVector[CSR_columns[p]];
+        }
+        solutionVector[i] = x_i;
+    }
+}
+
 /// A lower triangular matrix can be stored as a linear array. This function
 /// converts the index in this linear array to 2d coordinates (row and column)
 /// of an element in the matrix.
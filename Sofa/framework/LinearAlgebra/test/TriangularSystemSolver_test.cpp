@@ -125,6 +125,154 @@ TEST(TriangularSystemSolver, upper3x3)
     EXPECT_FLOATINGPOINT_EQ(solution[0], static_cast<SReal>(38))
 }
 
+namespace
+{
+/// strictly lower triangular part of a sparse matrix in CSR format, without the unit diagonal
+struct LowerTriangularCSR
+{
+    std::vector<sofa::Index> rows { 0 };
+    std::vector<sofa::Index> columns;
+    std::vector<SReal> values;
+};
+
+LowerTriangularCSR makeLowerTriangularMatrix(const sofa::Size size)
+{
+    LowerTriangularCSR matrix;
+    for (sofa::Index i = 0; i < size; ++i)
+    {
+        for (sofa::Index j = 0; j < i; ++j)
+        {
+            if ((i * 7 + j * 3) % 5 == 0)
+            {
+                matrix.columns.push_back(j);
+                matrix.values.push_back(static_cast<SReal>(0.1) * static_cast<SReal>((i + 2 * j) % 7) - static_cast<SReal>(0.3));
+            }
+        }
+        matrix.rows.push_back(static_cast<sofa::Index>(matrix.columns.size()));
+    }
+    return matrix;
+}
+}
+
+TEST(TriangularSystemSolver, lowerMultipleRHS)
+{
+    constexpr sofa::Size size = 50;
+    constexpr sofa::Size nbRHS = 4;
+    const auto L = makeLowerTriangularMatrix(size);
+
+    std::vector<SReal> interleaved(size * nbRHS);
+    for (sofa::Index i = 0; i < interleaved.size(); ++i)
+    {
+        interleaved[i] = std::cos(static_cast<SReal>(i));
+    }
+
+    std::vector<SReal> expected(size * nbRHS);
+    for (sofa::Index r = 0; r < nbRHS; ++r)
+    {
+        std::vector<SReal> rhs(size), solution(size);
+        for (sofa::Index i = 0; i < size; ++i)
+        {
+            rhs[i] = interleaved[i * nbRHS + r];
+        }
+        sofa::linearalgebra::solveLowerUnitriangularSystemCSR(size, rhs.data(), solution.data(), L.rows.data(), L.columns.data(), L.values.data());
+        for (sofa::Index i = 0; i < size; ++i)
+        {
+            expected[i * nbRHS + r] = solution[i];
+        }
+    }
+
+    // in-place solve
+    sofa::linearalgebra::solveLowerUnitriangularSystemCSRMultipleRHS<nbRHS>(size, interleaved.data(), interleaved.data(), L.rows.data(), L.columns.data(), L.values.data());
+    for (sofa::Index i = 0; i < interleaved.size(); ++i)
+    {
+        EXPECT_FLOATINGPOINT_EQ(interleaved[i], expected[i])
+    }
+}
+
+TEST(TriangularSystemSolver, upperMultipleRHS)
+{
+    constexpr std::array<SReal, 6> interleavedRHS { 5, 1, -9, 2, 3, 3 };
+    std::array<SReal, 6> solution {};
+
+    /**
+     * [ 1 2 3 ]
+     * [ 0 1 4 ]
+     * [ 0 0 1 ]
+     */
+    constexpr std::array<sofa::Size, 3> U_columns { 1, 2, 2 };
+    constexpr std::array<sofa::Size, 4> U_rows { 0, 2, 3, 3 };
+    constexpr std::array<SReal, 3> U_values { 2, 3, 4 };
+
+    sofa::linearalgebra::solveUpperUnitriangularSystemCSRMultipleRHS<2>(3, interleavedRHS.data(), solution.data(), U_rows.data(), U_columns.data(), U_values.data());
+
+    // first right-hand side: (5, -9, 3), second: (1, 2, 3)
+    EXPECT_FLOATINGPOINT_EQ(solution[0], static_cast<SReal>(38))
+    EXPECT_FLOATINGPOINT_EQ(solution[2], static_cast<SReal>(-21))
+    EXPECT_FLOATINGPOINT_EQ(solution[4], static_cast<SReal>(3))
+    EXPECT_FLOATINGPOINT_EQ(solution[1], static_cast<SReal>(1 - 2 * -10 - 3 * 3))
+    EXPECT_FLOATINGPOINT_EQ(solution[3], static_cast<SReal>(-10))
+    EXPECT_FLOATINGPOINT_EQ(solution[5], static_cast<SReal>(3))
+}
+
+TEST(TriangularSystemSolver, levels)
+{
+    /**
+     * [ 1 0 0 0 ]
+     * [ 2 1 0 0 ]
+     * [ 0 0 1 0 ]
+     * [ 0 3 4 1 ]
+     */
+    constexpr std::array<sofa::Index, 3> L_columns { 0, 1, 2 };
+    constexpr std::array<sofa::Index, 5> L_rows { 0, 0, 1, 1, 3 };
+
+    sofa::type::vector<sofa::Index> levelPtr, levelRows;
+    sofa::linearalgebra::computeUnitriangularSystemLevelsCSR(4, L_rows.data(), L_columns.data(), true, levelPtr, levelRows);
+    EXPECT_EQ(levelPtr, sofa::type::vector<sofa::Index>({0, 2, 3, 4}));
+    EXPECT_EQ(levelRows, sofa::type::vector<sofa::Index>({0, 2, 1, 3}));
+
+    // transpose of the previous matrix
+    constexpr std::array<sofa::Index, 3> U_columns { 1, 3, 3 };
+    constexpr std::array<sofa::Index, 5> U_rows { 0, 1, 2, 3, 3 };
+    sofa::linearalgebra::computeUnitriangularSystemLevelsCSR(4, U_rows.data(), U_columns.data(), false, levelPtr, levelRows);
+    EXPECT_EQ(levelPtr, sofa::type::vector<sofa::Index>({0, 1, 3, 4}));
+    EXPECT_EQ(levelRows, sofa::type::vector<sofa::Index>({3, 1, 2, 0}));
+}
+
+TEST(TriangularSystemSolver, solveByLevels)
+{
+    constexpr sofa::Size size = 80;
+    const auto L = makeLowerTriangularMatrix(size);
+
+    std::vector<SReal> rhs(size);
+    for (sofa::Index i = 0; i < size; ++i)
+    {
+        rhs[i] = std::sin(static_cast<SReal>(i));
+    }
+
+    std::vector<SReal> expected(size);
+    sofa::linearalgebra::solveLowerUnitriangularSystemCSR(size, rhs.data(), expected.data(), L.rows.data(), L.columns.data(), L.values.data());
+
+    sofa::type::vector<sofa::Index> levelPtr, levelRows;
+    sofa::linearalgebra::computeUnitriangularSystemLevelsCSR(size, L.rows.data(), L.columns.data(), true, levelPtr, levelRows);
+    ASSERT_GT(levelPtr.size(), 2);
+
+    // the rows of a level are solved in reverse order to check that they are independent
+    std::vector<SReal> solution(size);
+    for (sofa::Index l = 0; l + 1 < levelPtr.size(); ++l)
+    {
+        for (sofa::Index k = levelPtr[l + 1]; k > levelPtr[l]; --k)
+        {
+            sofa::linearalgebra::solveUnitriangularSystemCSRRows(levelRows.data() + k - 1, levelRows.data() + k,
+                rhs.data(), solution.data(), L.rows.data(), L.columns.data(), L.values.data());
+        }
+    }
+
+    for (sofa::Index i = 0; i < size; ++i)
+    {
+        EXPECT_EQ(solution[i], expected[i]);
+    }
+}
+
 TEST(TriangularSystemSolver, computeLowerTriangularMatrixCoordinates)
 {
     for (sofa::Index matrixSize = 2; matrixSize < 50; ++matrixSize)
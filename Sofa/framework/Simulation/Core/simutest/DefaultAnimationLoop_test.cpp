@@ -31,6 +31,9 @@ using sofa::core::ExecParams;
 #include <sofa/testing/BaseSimulationTest.h>
 using sofa::testing::BaseSimulationTest ;
 
+#include <sofa/core/behavior/BaseMechanicalState.h>
+#include <sofa/simulation/IndependentSubtrees.h>
+
 namespace sofa
 {
 
@@ -55,8 +58,116 @@ struct DefaultAnimationLoop_test : public BaseSimulationTest
         sofa::simulation::node::animate(root, 0.01_sreal);
     }
 
+    /// Scene with three falling objects. If coupled, a spring located in the second object is
+    /// attached to the first object. The spring is declared after both objects, so that its link
+    /// to the first object is resolved when the scene is loaded.
+    static std::string fallingObjectsScene(bool parallel, bool coupled)
+    {
+        std::stringstream scene ;
+        scene << "<?xml version='1.0'?>"
+                 "<Node name='Root' gravity='0 -9.81 0' dt='0.01'>                                                \n"
+                 "   <RequiredPlugin name='Sofa.Component.LinearSolver.Iterative'/>                                 \n"
+                 "   <RequiredPlugin name='Sofa.Component.Mass'/>                                                   \n"
+                 "   <RequiredPlugin name='Sofa.Component.ODESolver.Backward'/>                                     \n"
+                 "   <RequiredPlugin name='Sofa.Component.SolidMechanics.Spring'/>                                  \n"
+                 "   <RequiredPlugin name='Sofa.Component.StateContainer'/>                                         \n"
+                 "   <DefaultAnimationLoop name='loop' parallelODESolving='" << parallel << "'/>                    \n";
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            scene << "   <Node name='object" << i << "'>                                                             \n"
+                     "      <EulerImplicitSolver rayleighStiffness='0' rayleighMass='0'/>                           \n"
+                     "      <CGLinearSolver iterations='25' tolerance='1e-9' threshold='1e-9'/>                     \n"
+                     "      <MechanicalObject name='dofs' position='" << i << " 0 0  " << i << " 1 0'/>             \n"
+                     "      <UniformMass totalMass='1'/>                                                            \n";
+            if (coupled && i == 1)
+            {
+                scene << "      <SpringForceField object1='@/object0/dofs' object2='@dofs' spring='0 0 100 0.1 1'/> \n";
+            }
+            scene << "   </Node>                                                                                   \n";
+        }
+        scene << "</Node>\n";
+        return scene.str();
+    }
+
+    void testIndependentSubtrees(bool coupled)
+    {
+        EXPECT_MSG_NOEMIT(Error) ;
+
+        SceneInstance c("xml", fallingObjectsScene(true, coupled)) ;
+        Node* root = c.root.get() ;
+        ASSERT_NE(root, nullptr) ;
+        c.initScene() ;
+
+        sofa::simulation::IndependentSubtrees subtrees;
+        subtrees.build(root);
+
+        const auto& groups = subtrees.getGroups();
+        if (coupled)
+        {
+            ASSERT_EQ(groups.size(), 2);
+            EXPECT_EQ(groups[0].name, "object0+object1");
+            EXPECT_EQ(groups[1].name, "object2");
+        }
+        else
+        {
+            ASSERT_EQ(groups.size(), 3);
+            EXPECT_EQ(groups[0].name, "object0");
+            EXPECT_EQ(groups[1].name, "object1");
+            EXPECT_EQ(groups[2].name, "object2");
+        }
+        EXPECT_FALSE(subtrees.isSubtreeRoot(root));
+        EXPECT_TRUE(subtrees.isSubtreeRoot(groups.back().roots.front()));
+
+        sofa::simulation::node::animate(root, 0.01_sreal);
+
+        const auto* names = dynamic_cast<const core::objectmodel::Data<type::vector<std::string> >*>(root->getObject("loop")->findData("subtreeNames"));
+        const auto* times = dynamic_cast<const core::objectmodel::Data<type::vector<SReal> >*>(root->getObject("loop")->findData("subtreeTimes"));
+        ASSERT_NE(names, nullptr);
+        ASSERT_NE(times, nullptr);
+        const type::vector<std::string> expectedNames = coupled
+            ? type::vector<std::string>{"object0+object1", "object2"}
+            : type::vector<std::string>{"object0", "object1", "object2"};
+        EXPECT_EQ(names->getValue(), expectedNames);
+        EXPECT_EQ(times->getValue().size(), expectedNames.size());
+    }
+
+    void testParallelMatchesSequential(bool coupled)
+    {
+        EXPECT_MSG_NOEMIT(Error) ;
+
+        SceneInstance sequential("xml", fallingObjectsScene(false, coupled)) ;
+        SceneInstance parallel("xml", fallingObjectsScene(true, coupled)) ;
+        sequential.initScene() ;
+        parallel.initScene() ;
+
+        for (unsigned int step = 0; step < 10; ++step)
+        {
+            sofa::simulation::node::animate(sequential.root.get(), 0.01_sreal);
+            sofa::simulation::node::animate(parallel.root.get(), 0.01_sreal);
+        }
+
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            const std::string path = "object" + std::to_string(i);
+            auto* sequentialState = sequential.root->getChild(path)->getMechanicalState();
+            auto* parallelState = parallel.root->getChild(path)->getMechanicalState();
+            ASSERT_NE(sequentialState, nullptr);
+            ASSERT_NE(parallelState, nullptr);
+            ASSERT_EQ(sequentialState->getSize(), parallelState->getSize());
+            for (sofa::Size p = 0; p < sequentialState->getSize(); ++p)
+            {
+                EXPECT_DOUBLE_EQ(sequentialState->getPX(p), parallelState->getPX(p));
+                EXPECT_DOUBLE_EQ(sequentialState->getPY(p), parallelState->getPY(p));
+                EXPECT_DOUBLE_EQ(sequentialState->getPZ(p), parallelState->getPZ(p));
+            }
+        }
+    }
 };
 
 TEST_F(DefaultAnimationLoop_test, testOneStep ) { testOneStep(); }
+TEST_F(DefaultAnimationLoop_test, independentSubtrees ) { testIndependentSubtrees(false); }
+TEST_F(DefaultAnimationLoop_test, coupledSubtrees ) { testIndependentSubtrees(true); }
+TEST_F(DefaultAnimationLoop_test, parallelMatchesSequential ) { testParallelMatchesSequential(false); }
+TEST_F(DefaultAnimationLoop_test, parallelMatchesSequentialCoupled ) { testParallelMatchesSequential(true); }
 
 }
@@ -0,0 +1,328 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/simulation/ComponentProfiler.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace sofa::simulation
+{
+
+struct ComponentProfiler::ThreadData
+{
+    struct ComponentMeasures
+    {
+        std::string name;
+        std::string className;
+        std::string path;
+
+        double time { 0 };
+        unsigned int calls { 0 };
+        unsigned int allocations { 0 };
+    };
+
+    ComponentMeasures& getMeasures(const core::objectmodel::BaseObject* component)
+    {
+        auto [it, inserted] = components.try_emplace(component);
+        if (inserted)
+        {
+            // the identity of the component is kept in case it is destroyed before the end of the step
+            it->second.name = component->getName();
+            it->second.className = component->getClassName();
+            it->second.path = component->getPathName();
+        }
+        return it->second;
+    }
+
+    std::unordered_map<const core::objectmodel::BaseObject*, ComponentMeasures> components;
+
+    /// components being processed by a visitor on the thread, the innermost last
+    std::vector<const core::objectmodel::BaseObject*> processedComponents;
+};
+
+std::atomic<bool> ComponentProfiler::s_enabled { false };
+std::mutex ComponentProfiler::s_mutex;
+std::vector<std::shared_ptr<ComponentProfiler::ThreadData> > ComponentProfiler::s_threadData;
+std::unordered_map<const core::objectmodel::BaseObject*, ComponentProfiler::ComponentData> ComponentProfiler::s_components;
+std::unordered_map<std::string, ComponentProfiler::StageData> ComponentProfiler::s_stages;
+ComponentProfiler::ctime_t ComponentProfiler::s_stepStart { 0 };
+std::clock_t ComponentProfiler::s_stepCpuStart { 0 };
+std::size_t ComponentProfiler::s_nbSteps { 0 };
+std::vector<double> ComponentProfiler::s_stepTimes;
+std::vector<double> ComponentProfiler::s_stepUtilization;
+std::vector<double> ComponentProfiler::s_stepAllocations;
+
+namespace
+{
+double toMilliseconds(ComponentProfiler::ctime_t duration)
+{
+    return 1000. * static_cast<double>(duration) / static_cast<double>(helper::system::thread::CTime::getTicksPerSec());
+}
+}
+
+void ComponentProfiler::setEnabled(bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+ComponentProfiler::ThreadData& ComponentProfiler::getThreadData()
+{
+    thread_local const std::shared_ptr<ThreadData> threadData = []()
+    {
+        auto data = std::make_shared<ThreadData>();
+        std::lock_guard lock(s_mutex);
+        s_threadData.push_back(data);
+        return data;
+    }();
+    return *threadData;
+}
+
+void ComponentProfiler::clear()
+{
+    std::lock_guard lock(s_mutex);
+    for (const auto& threadData : s_threadData)
+    {
+        threadData->components.clear();
+    }
+    s_components.clear();
+    s_stages.clear();
+    s_nbSteps = 0;
+    s_stepTimes.clear();
+    s_stepUtilization.clear();
+    s_stepAllocations.clear();
+}
+
+void ComponentProfiler::beginStep()
+{
+    std::lock_guard lock(s_mutex);
+    for (const auto& threadData : s_threadData)
+    {
+        for (auto& [component, measures] : threadData->components)
+        {
+            measures.time = 0;
+            measures.calls = 0;
+            measures.allocations = 0;
+        }
+    }
+    s_stepCpuStart = std::clock();
+    s_stepStart = helper::system::thread::CTime::getFastTime();
+}
+
+void ComponentProfiler::endStep(const type::vector<helper::Record>& timerRecords)
+{
+    const double stepTime = toMilliseconds(helper::system::thread::CTime::getFastTime() - s_stepStart);
+    const double stepCpuTime = 1000. * static_cast<double>(std::clock() - s_stepCpuStart) / CLOCKS_PER_SEC;
+
+    std::lock_guard lock(s_mutex);
+
+    // gather the measures of all the threads
+    for (auto& [component, data] : s_components)
+    {
+        data.stepTime = 0;
+        data.stepCalls = 0;
+        data.stepAllocations = 0;
+    }
+    for (const auto& threadData : s_threadData)
+    {
+        for (auto& [component, measures] : threadData->components)
+        {
+            auto [it, inserted] = s_components.try_emplace(component);
+            auto& data = it->second;
+            if (inserted)
+            {
+                data.name = measures.name;
+                data.className = measures.className;
+                data.path = measures.path;
+
+                // the component did not exist during the previous recorded steps
+                data.times.assign(s_nbSteps, 0.);
+                data.calls.assign(s_nbSteps, 0.);
+                data.allocations.assign(s_nbSteps, 0.);
+            }
+            data.stepTime += measures.time;
+            data.stepCalls += measures.calls;
+            data.stepAllocations += measures.allocations;
+
+            measures.time = 0;
+            measures.calls = 0;
+            measures.allocations = 0;
+        }
+    }
+
+    ++s_nbSteps;
+    s_stepTimes.push_back(stepTime);
+    s_stepUtilization.push_back(stepTime > 0 ? stepCpuTime / stepTime : 0.);
+
+    double stepAllocations = 0;
+    for (auto& [component, data] : s_components)
+    {
+        data.times.push_back(data.stepTime);
+        data.calls.push_back(data.stepCalls);
+        data.allocations.push_back(data.stepAllocations);
+        stepAllocations += data.stepAllocations;
+    }
+    s_stepAllocations.push_back(stepAllocations);
+
+    // duration of the AdvancedTimer steps, nested steps being matched with a stack
+    std::map<std::string, std::pair<double, unsigned int> > stageTimes;
+    std::vector<const helper::Record*> openedSteps;
+    for (const auto& record : timerRecords)
+    {
+        if (record.type == helper::Record::RSTEP_BEGIN)
+        {
+            openedSteps.push_back(&record);
+        }
+        else if (record.type == helper::Record::RSTEP_END && !openedSteps.empty())
+        {
+            const auto* begin = openedSteps.back();
+            openedSteps.pop_back();
+
+            auto& [time, calls] = stageTimes[begin->label];
+            time += toMilliseconds(record.time - begin->time);
+            ++calls;
+        }
+    }
+
+    for (const auto& [name, timeAndCalls] : stageTimes)
+    {
+        s_stages.try_emplace(name);
+    }
+    for (auto& [name, data] : s_stages)
+    {
+        const auto it = stageTimes.find(name);
+        data.times.push_back(it != stageTimes.end() ? it->second.first : 0.);
+        data.calls.push_back(it != stageTimes.end() ? it->second.second : 0.);
+    }
+}
+
+ComponentProfiler::ctime_t ComponentProfiler::beginComponent(const core::objectmodel::BaseObject* component)
+{
+    getThreadData().processedComponents.push_back(component);
+    return helper::system::thread::CTime::getFastTime();
+}
+
+void ComponentProfiler::endComponent(const core::objectmodel::BaseObject* component, ctime_t start)
+{
+    const double time = toMilliseconds(helper::system::thread::CTime::getFastTime() - start);
+
+    auto& threadData = getThreadData();
+    if (!threadData.processedComponents.empty() && threadData.processedComponents.back() == component)
+    {
+        threadData.processedComponents.pop_back();
+    }
+
+    if (isEnabled())
+    {
+        auto& measures = threadData.getMeasures(component);
+        measures.time += time;
+        ++measures.calls;
+    }
+}
+
+void ComponentProfiler::addAllocation(const core::objectmodel::BaseObject* state)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    auto& threadData = getThreadData();
+
+    // the state is processed by the visitor allocating the vector, on behalf of the enclosing component
+    const core::objectmodel::BaseObject* component = state;
+    const auto& processed = threadData.processedComponents;
+    const auto requester = std::find_if(processed.rbegin(), processed.rend(),
+        [state](const core::objectmodel::BaseObject* c) { return c != state; });
+    if (requester != processed.rend())
+    {
+        component = *requester;
+    }
+
+    ++threadData.getMeasures(component).allocations;
+}
+
+ComponentProfiler::Statistics ComponentProfiler::computeStatistics(std::vector<double> samples)
+{
+    Statistics statistics;
+    if (samples.empty())
+    {
+        return statistics;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const std::size_t n = samples.size();
+
+    double sum = 0;
+    for (const double s : samples)
+    {
+        sum += s;
+    }
+    statistics.mean = sum / static_cast<double>(n);
+    statistics.median = (n % 2 == 1) ? samples[n / 2] : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+    statistics.p99 = samples[std::min(n - 1, static_cast<std::size_t>(std::ceil(0.99 * static_cast<double>(n))) - 1)];
+    statistics.min = samples.front();
+    statistics.max = samples.back();
+    return statistics;
+}
+
+ComponentProfiler::StepStatistics ComponentProfiler::getStepStatistics()
+{
+    std::lock_guard lock(s_mutex);
+    StepStatistics statistics;
+    statistics.nbSteps = s_nbSteps;
+    statistics.time = computeStatistics(s_stepTimes);
+    statistics.threadUtilization = computeStatistics(s_stepUtilization);
+    statistics.allocations = computeStatistics(s_stepAllocations);
+    return statistics;
+}
+
+std::vector<ComponentProfiler::ComponentStatistics> ComponentProfiler::getComponentStatistics()
+{
+    std::lock_guard lock(s_mutex);
+    std::vector<ComponentStatistics> statistics;
+    statistics.reserve(s_components.size());
+    for (const auto& [component, data] : s_components)
+    {
+        statistics.push_back({data.name, data.className, data.path,
+            computeStatistics(data.times), computeStatistics(data.calls), computeStatistics(data.allocations)});
+    }
+    std::sort(statistics.begin(), statistics.end(),
+        [](const ComponentStatistics& a, const ComponentStatistics& b) { return a.time.mean > b.time.mean; });
+    return statistics;
+}
+
+std::vector<ComponentProfiler::StageStatistics> ComponentProfiler::getStageStatistics()
+{
+    std::lock_guard lock(s_mutex);
+    std::vector<StageStatistics> statistics;
+    statistics.reserve(s_stages.size());
+    for (const auto& [name, data] : s_stages)
+    {
+        statistics.push_back({name, computeStatistics(data.times), computeStatistics(data.calls)});
+    }
+    std::sort(statistics.begin(), statistics.end(),
+        [](const StageStatistics& a, const StageStatistics& b) { return a.time.mean > b.time.mean; });
+    return statistics;
+}
+
+}
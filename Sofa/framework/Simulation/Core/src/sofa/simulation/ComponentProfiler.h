@@ -0,0 +1,191 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/simulation/config.h>
+#include <sofa/core/objectmodel/BaseObject.h>
+#include <sofa/helper/AdvancedTimer.h>
+#include <sofa/helper/system/thread/CTime.h>
+
+#include <atomic>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sofa::simulation
+{
+
+/**
+ * Collects, for each time step, the wall time spent in each component and in each step of the
+ * AdvancedTimer (collision stages, solvers...), and computes statistics over the recorded time steps.
+ *
+ * The time of a component is measured by the visitors (see Visitor::begin and Visitor::end), each
+ * time a visitor processes the component. It is inclusive: the time of an ODE solver includes the
+ * time of the force fields called during the solve. Each thread accumulates the times of its
+ * visitors in its own buffer, without synchronization: the buffers are gathered by endStep.
+ *
+ * The allocations are the allocations of the state vectors only, reported by the mechanical states.
+ * An allocation is charged to the innermost component processed by a visitor on the same thread,
+ * excluding the state itself: an ODE solver allocating a vector is charged, not the state. An
+ * allocation outside of any visitor is charged to the state.
+ *
+ * The times of the AdvancedTimer steps are computed from the records given to endStep. The
+ * AdvancedTimer records the steps of the calling thread only: the steps entered on the worker threads
+ * of a task scheduler are missing.
+ *
+ * The profiler is disabled by default. When it is disabled, the overhead in the visitors is a
+ * single test.
+ */
+class SOFA_SIMULATION_CORE_API ComponentProfiler
+{
+public:
+    using ctime_t = helper::system::thread::ctime_t;
+
+    /// Statistics over the recorded time steps of a quantity measured at each step
+    struct Statistics
+    {
+        double mean { 0 };
+        double median { 0 };
+        double p99 { 0 };
+        double min { 0 };
+        double max { 0 };
+    };
+
+    struct ComponentStatistics
+    {
+        std::string name;
+        std::string className;
+        /// path of the component in the scene graph
+        std::string path;
+        /// wall time spent in the component per time step, in milliseconds
+        Statistics time;
+        /// number of times the component has been processed by a visitor per time step
+        Statistics calls;
+        /// number of state vectors allocated by the component per time step
+        Statistics allocations;
+    };
+
+    struct StageStatistics
+    {
+        std::string name;
+        /// wall time spent in the step per time step, in milliseconds
+        Statistics time;
+        /// number of times the step has been entered per time step
+        Statistics calls;
+    };
+
+    struct StepStatistics
+    {
+        std::size_t nbSteps { 0 };
+        /// wall time of a time step, in milliseconds
+        Statistics time;
+        /// CPU time of the process over the wall time, i.e. the average number of busy threads
+        Statistics threadUtilization;
+        /// number of state vectors allocated per time step
+        Statistics allocations;
+    };
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /// Remove all the recorded data
+    static void clear();
+
+    /// Start the recording of a time step. Must not be called while a visitor is running.
+    static void beginStep();
+
+    /**
+     * End the recording of a time step. Must not be called while a visitor is running.
+     * @param timerRecords records of the AdvancedTimer during the time step, used to time the
+     * AdvancedTimer steps (see AdvancedTimer::getRecords)
+     */
+    static void endStep(const type::vector<helper::Record>& timerRecords = {});
+
+    /// Called by the visitors before processing a component
+    static ctime_t beginComponent(const core::objectmodel::BaseObject* component);
+
+    /// Called by the visitors after processing a component, with the time returned by beginComponent
+    static void endComponent(const core::objectmodel::BaseObject* component, ctime_t start);
+
+    /// Count the allocation of a state vector of the state, charged to the component requesting it
+    static void addAllocation(const core::objectmodel::BaseObject* state);
+
+    static StepStatistics getStepStatistics();
+
+    /// Statistics of each component, sorted by decreasing mean time
+    static std::vector<ComponentStatistics> getComponentStatistics();
+
+    /// Statistics of each AdvancedTimer step, sorted by decreasing mean time
+    static std::vector<StageStatistics> getStageStatistics();
+
+    /// Statistics of a set of samples
+    static Statistics computeStatistics(std::vector<double> samples);
+
+private:
+    struct ComponentData
+    {
+        std::string name;
+        std::string className;
+        std::string path;
+
+        double stepTime { 0 };
+        unsigned int stepCalls { 0 };
+        unsigned int stepAllocations { 0 };
+
+        std::vector<double> times;
+        std::vector<double> calls;
+        std::vector<double> allocations;
+    };
+
+    struct StageData
+    {
+        std::vector<double> times;
+        std::vector<double> calls;
+    };
+
+    /// Measures of the current time step on a thread
+    struct ThreadData;
+
+    /// Buffer of the calling thread, registered in s_threadData at the first call
+    static ThreadData& getThreadData();
+
+    static std::atomic<bool> s_enabled;
+    static std::mutex s_mutex;
+
+    /// buffers of all the threads which processed a component, kept alive after the end of the thread
+    static std::vector<std::shared_ptr<ThreadData> > s_threadData;
+
+    static std::unordered_map<const core::objectmodel::BaseObject*, ComponentData> s_components;
+    static std::unordered_map<std::string, StageData> s_stages;
+
+    static ctime_t s_stepStart;
+    static std::clock_t s_stepCpuStart;
+    static std::size_t s_nbSteps;
+    static std::vector<double> s_stepTimes;
+    static std::vector<double> s_stepUtilization;
+    static std::vector<double> s_stepAllocations;
+};
+
+}
@@ -28,7 +28,7 @@ CpuTaskStatus::CpuTaskStatus(): m_busy(0)
 
 bool CpuTaskStatus::isBusy() const
 {
-    return (m_busy.load(std::memory_order_relaxed) > 0);
+    return (m_busy.load(std::memory_order_acquire) > 0);
 }
 
 int CpuTaskStatus::setBusy(bool busy)
@@ -39,7 +39,7 @@ int CpuTaskStatus::setBusy(bool busy)
     }
     else
     {
-        return m_busy.fetch_sub(1, std::memory_order_relaxed);
+        return m_busy.fetch_sub(1, std::memory_order_release);
     }
 }
 }
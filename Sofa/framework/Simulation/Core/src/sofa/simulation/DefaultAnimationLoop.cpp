@@ -36,6 +36,7 @@
 
 #include <sofa/helper/ScopedAdvancedTimer.h>
 #include <sofa/helper/AdvancedTimer.h>
+#include <sofa/helper/TimerTrace.h>
 
 #include <sofa/core/visual/VisualParams.h>
 #include <sofa/simulation/CollisionBeginEvent.h>
@@ -52,10 +53,55 @@
 #include <sofa/simulation/mechanicalvisitor/MechanicalProjectPositionAndVelocityVisitor.h>
 #include <sofa/simulation/mechanicalvisitor/MechanicalPropagateOnlyPositionAndVelocityVisitor.h>
 
+#include <chrono>
+
 
 namespace sofa::simulation
 {
 
+namespace
+{
+
+/// Only computes the interaction force fields located outside of the subtrees containing an ODE
+/// solver, without solving
+class IsolatedInteractionForceFieldVisitor : public SolveVisitor
+{
+public:
+    IsolatedInteractionForceFieldVisitor(const core::ExecParams* params, SReal dt)
+        : SolveVisitor(params, dt, false, false, true)
+    {}
+
+    void processSolver(simulation::Node*, core::behavior::OdeSolver*) override {}
+
+    const char* getClassName() const override { return "IsolatedInteractionForceFieldVisitor"; }
+};
+
+/// Updates the mappings located outside of the given subtrees
+class OutsideSubtreesUpdateMappingVisitor : public UpdateMappingVisitor
+{
+public:
+    OutsideSubtreesUpdateMappingVisitor(const core::ExecParams* params, const IndependentSubtrees& subtrees)
+        : UpdateMappingVisitor(params)
+        , m_subtrees(subtrees)
+    {}
+
+    Result processNodeTopDown(simulation::Node* node) override
+    {
+        if (m_subtrees.isSubtreeRoot(node))
+        {
+            return RESULT_PRUNE;
+        }
+        return UpdateMappingVisitor::processNodeTopDown(node);
+    }
+
+    const char* getClassName() const override { return "OutsideSubtreesUpdateMappingVisitor"; }
+
+private:
+    const IndependentSubtrees& m_subtrees;
+};
+
+}
+
 int DefaultAnimationLoopClass = core::RegisterObject("Simulation loop to use in scene without constraints nor contact.")
                                 .add<DefaultAnimationLoop>()
                                 .addDocumentationURL(std::string(sofa::SOFA_DOCUMENTATION_URL) + std::string("components/animationloops/defaultanimationloop/"))
@@ -69,8 +115,15 @@ This loop triggers the following steps:
 DefaultAnimationLoop::DefaultAnimationLoop(simulation::Node* _m_node)
     : Inherit()
     , d_parallelODESolving(initData(&d_parallelODESolving, false, "parallelODESolving", "If true, solves all the ODEs in parallel"))
+    , d_subtreeNames(initData(&d_subtreeNames, "subtreeNames", "Names of the groups of independent subtrees simulated in parallel (read-only)"))
+    , d_subtreeTimes(initData(&d_subtreeTimes, "subtreeTimes", "Time (ms) spent in each group of independent subtrees during the last step (read-only)"))
 {
     SOFA_UNUSED(_m_node);
+    d_subtreeNames.setReadOnly(true);
+    d_subtreeTimes.setReadOnly(true);
+    d_subtreeNames.setGroup("Stats");
+    d_subtreeTimes.setGroup("Stats");
+
     this->addUpdateCallback("parallelODESolving", {&d_parallelODESolving},
     [this](const core::DataTracker& tracker) -> sofa::core::objectmodel::ComponentState
     {
@@ -146,7 +199,14 @@ void DefaultAnimationLoop::updateMapping(const core::ExecParams* params, const S
 {
     SCOPED_TIMER("UpdateMapping");
     //Visual Information update: Ray Pick add a MechanicalMapping used as VisualMapping
-    m_node->execute<UpdateMappingVisitor>(params);
+    if (d_parallelODESolving.getValue())
+    {
+        parallelUpdateMapping(params);
+    }
+    else
+    {
+        m_node->execute<UpdateMappingVisitor>(params);
+    }
     {
         UpdateMappingEndEvent ev(dt);
         PropagateEventVisitor propagateEventVisitor(params, &ev);
@@ -199,8 +259,99 @@ void DefaultAnimationLoop::solve(const core::ExecParams* params, SReal dt) const
     constexpr bool usefreeVecIds = false;
     constexpr bool computeForceIsolatedInteractionForceFields = true;
     SCOPED_TIMER("solve");
-    simulation::SolveVisitor freeMotion(params, dt, usefreeVecIds, d_parallelODESolving.getValue(), computeForceIsolatedInteractionForceFields);
-    freeMotion.execute(m_node);
+    if (d_parallelODESolving.getValue())
+    {
+        parallelSolve(params, dt);
+    }
+    else
+    {
+        constexpr bool parallelSolve = false;
+        simulation::SolveVisitor freeMotion(params, dt, usefreeVecIds, parallelSolve, computeForceIsolatedInteractionForceFields);
+        freeMotion.execute(m_node);
+    }
+}
+
+void DefaultAnimationLoop::parallelSolve(const core::ExecParams* params, SReal dt) const
+{
+    {
+        // the collision response may have coupled some subtrees
+        SCOPED_TIMER("buildIndependentSubtrees");
+        m_subtrees.build(m_node);
+    }
+
+    {
+        // the ODE solvers do not see the interaction force fields located outside of their subtree
+        IsolatedInteractionForceFieldVisitor isolatedForces(params, dt);
+        isolatedForces.execute(m_node);
+    }
+
+    m_subtreeTimes = runOnSubtrees([params, dt](simulation::Node* root)
+    {
+        constexpr bool usefreeVecIds = false;
+        simulation::SolveVisitor solveVisitor(params, dt, usefreeVecIds);
+        solveVisitor.execute(root);
+    });
+
+    m_subtreeNames.clear();
+    for (const auto& group : m_subtrees.getGroups())
+    {
+        m_subtreeNames.push_back(group.name);
+    }
+}
+
+void DefaultAnimationLoop::parallelUpdateMapping(const core::ExecParams* params) const
+{
+    // the groups built before the solve of this time step are reused
+    const auto times = runOnSubtrees([params](simulation::Node* root)
+    {
+        root->execute<UpdateMappingVisitor>(params);
+    });
+
+    for (std::size_t i = 0; i < times.size(); ++i)
+    {
+        m_subtreeTimes[i] += times[i];
+    }
+
+    OutsideSubtreesUpdateMappingVisitor outsideMappings(params, m_subtrees);
+    m_node->execute(outsideMappings);
+}
+
+type::vector<SReal> DefaultAnimationLoop::runOnSubtrees(const std::function<void(simulation::Node*)>& f) const
+{
+    const auto& groups = m_subtrees.getGroups();
+    type::vector<SReal> times(groups.size(), 0_sreal);
+
+    const auto runGroup = [&groups, &times, &f](std::size_t i)
+    {
+        const IndependentSubtrees::Group& group = groups[i];
+        helper::TimerTrace::ScopedEvent traceEvent(group.name.c_str());
+
+        const auto start = std::chrono::steady_clock::now();
+        for (simulation::Node* root : group.roots)
+        {
+            f(root);
+        }
+        times[i] = std::chrono::duration<SReal, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    simulation::TaskScheduler* taskScheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    if (groups.size() < 2 || taskScheduler->getThreadCount() < 2)
+    {
+        for (std::size_t i = 0; i < groups.size(); ++i)
+        {
+            runGroup(i);
+        }
+        return times;
+    }
+
+    simulation::CpuTaskStatus status;
+    for (std::size_t i = 0; i < groups.size(); ++i)
+    {
+        taskScheduler->addTask(status, [&runGroup, i]() { runGroup(i); });
+    }
+    taskScheduler->workUntilDone(&status);
+
+    return times;
 }
 
 void DefaultAnimationLoop::propagateIntegrateEndEvent(const core::ExecParams* params) const
@@ -320,6 +471,12 @@ void DefaultAnimationLoop::step(const core::ExecParams* params, SReal dt)
     updateMapping(params, dt);
     computeBoundingBox(params);
 
+    if (d_parallelODESolving.getValue())
+    {
+        d_subtreeNames.setValue(m_subtreeNames);
+        d_subtreeTimes.setValue(m_subtreeTimes);
+    }
+
 #ifdef SOFA_DUMP_VISITOR_INFO
     simulation::Visitor::printCloseNode("Step");
 #endif
@@ -25,6 +25,9 @@
 #include <sofa/core/behavior/BaseAnimationLoop.h>
 
 #include <sofa/simulation/fwd.h>
+#include <sofa/simulation/IndependentSubtrees.h>
+
+#include <functional>
 
 
 namespace sofa::core
@@ -55,6 +58,8 @@ protected:
 
 public:
     Data<bool> d_parallelODESolving; ///< If true, solves all the ODEs in parallel
+    Data<type::vector<std::string> > d_subtreeNames; ///< Names of the groups of independent subtrees simulated in parallel (read-only)
+    Data<type::vector<SReal> > d_subtreeTimes; ///< Time (ms) spent in each group of independent subtrees during the last step (read-only)
 
     void init() override;
 
@@ -87,6 +92,26 @@ protected :
     void computeBoundingBox(const sofa::core::ExecParams* params) const;
     void propagateAnimateBeginEvent(const sofa::core::ExecParams* params, SReal dt) const;
 
+    /// Solve the groups of independent subtrees concurrently
+    void parallelSolve(const sofa::core::ExecParams* params, SReal dt) const;
+
+    /// Update the mappings of the groups of independent subtrees concurrently, then the remaining
+    /// mappings of the graph
+    void parallelUpdateMapping(const sofa::core::ExecParams* params) const;
+
+    /// Run a task per group of independent subtrees, calling f on each subtree root of the group.
+    /// @return the time (ms) spent in each group
+    type::vector<SReal> runOnSubtrees(const std::function<void(simulation::Node*)>& f) const;
+
+    /// Groups of independent subtrees, built once per time step before the parallel solve as the
+    /// collision response may modify the graph. The mappings are updated on the same groups.
+    mutable IndependentSubtrees m_subtrees;
+
+    /// Time spent in each group during the current step
+    mutable type::vector<SReal> m_subtreeTimes;
+
+    /// Names of the groups whose time is stored in m_subtreeTimes
+    mutable type::vector<std::string> m_subtreeNames;
 };
 
 } // namespace sofa::simulation
@@ -24,6 +24,9 @@
 #include <sofa/helper/system/thread/thread_specific_ptr.h>
 #include <sofa/simulation/WorkerThread.h>
 #include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/helper/logging/Messaging.h>
+
+#include <algorithm>
 
 namespace sofa::simulation
 {
@@ -63,6 +66,7 @@ DefaultTaskScheduler::DefaultTaskScheduler()
     // init global static thread local var
     {
         _threads[std::this_thread::get_id()] = new WorkerThread(this, 0, "Main  ");// new WorkerThread(this, 0, "Main  ");
+        m_threadsByIndex.push_back(_threads[std::this_thread::get_id()]);
     }
 }
 
@@ -84,6 +88,11 @@ WorkerThread* DefaultTaskScheduler::getWorkerThread(const std::thread::id id)
     return thread->second;
 }
 
+WorkerThread* DefaultTaskScheduler::getWorkerThread(const unsigned int index)
+{
+    return m_threadsByIndex[index % m_threadsByIndex.size()];
+}
+
 Task::Allocator* DefaultTaskScheduler::getTaskAllocator()
 {
     static StdTaskAllocator defaultTaskAllocator;
@@ -94,7 +103,8 @@ void DefaultTaskScheduler::init(const unsigned int NbThread )
 {
     if ( m_isInitialized )
     {
-        if ( (NbThread == m_threadCount) || (NbThread==0 && m_threadCount==GetHardwareThreadsCount()) )
+        const bool isSameThreadCount = (NbThread == m_threadCount) || (NbThread==0 && m_threadCount==GetHardwareThreadsCount());
+        if ( isSameThreadCount && m_threadAffinityPolicy == m_appliedThreadAffinityPolicy )
         {
             return;
         }
@@ -120,11 +130,27 @@ void DefaultTaskScheduler::start(const unsigned int NbThread )
         m_threadCount = NbThread;
     }
 
+    const std::vector<CpuSet> threadCpus = computeThreadCpuSets(m_threadAffinityPolicy, std::max(m_threadCount, 1u));
+    m_appliedThreadAffinityPolicy = m_threadAffinityPolicy;
+    if (!threadCpus.front().empty())
+    {
+        m_mainThreadInitialAffinity = getCurrentThreadAffinity();
+        msg_warning_when(!setCurrentThreadAffinity(threadCpus.front()), "DefaultTaskScheduler")
+            << "The thread affinity policy cannot be applied on this system";
+    }
+
+    m_threadsByIndex.resize(1);
+
     /* start worker threads */
     for( unsigned int i=1; i<m_threadCount; ++i)
     {
         WorkerThread* thread = new WorkerThread(this, int(i));
-        thread->create_and_attach(this);
+        m_threadsByIndex.push_back(thread);
+    }
+    for( unsigned int i=1; i<m_threadCount; ++i)
+    {
+        WorkerThread* thread = m_threadsByIndex[i];
+        thread->create_and_attach(this, threadCpus[i]);
         _threads[thread->getId()] = thread;
         thread->start(this);
     }
@@ -174,6 +200,13 @@ void DefaultTaskScheduler::stop()
         WorkerThread* mainThread = mainThreadIt->second;
         _threads.clear();
         _threads[std::this_thread::get_id()] = mainThread;
+        m_threadsByIndex.assign(1, mainThread);
+
+        if (!m_mainThreadInitialAffinity.empty())
+        {
+            setCurrentThreadAffinity(m_mainThreadInitialAffinity);
+            m_mainThreadInitialAffinity.clear();
+        }
     }
 
     return;
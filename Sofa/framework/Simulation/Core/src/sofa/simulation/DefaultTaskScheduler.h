@@ -33,6 +33,7 @@
 #include <string> 
 #include <mutex>
 #include <atomic>
+#include <vector>
 
 
 namespace sofa::simulation
@@ -92,11 +93,23 @@ private:
             
     WorkerThread* getWorkerThread(const std::thread::id id);
 
+    /// @return the thread of index (index modulo the number of threads), 0 being the main thread
+    WorkerThread* getWorkerThread(unsigned int index);
+
             
     static const std::string _name;
 
     std::map< std::thread::id, WorkerThread*> _threads;
 
+    /// threads sorted by index, the first one being the main thread
+    std::vector<WorkerThread*> m_threadsByIndex;
+
+    /// affinity policy used when the threads have been created
+    ThreadAffinityPolicy m_appliedThreadAffinityPolicy;
+
+    /// affinity of the main thread before it has been pinned by start()
+    CpuSet m_mainThreadInitialAffinity;
+
     std::atomic<const Task::Status*> m_mainTaskStatus;
     void setMainTaskStatus(const Task::Status* mainTaskStatus);
     bool testMainTaskStatus(const Task::Status*);
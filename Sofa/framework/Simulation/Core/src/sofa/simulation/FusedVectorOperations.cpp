@@ -0,0 +1,115 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/simulation/FusedVectorOperations.h>
+
+#include <sofa/core/objectmodel/BaseContext.h>
+#include <sofa/simulation/mechanicalvisitor/MechanicalVMultiOpReduceVisitor.h>
+using sofa::simulation::mechanicalvisitor::MechanicalVMultiOpReduceVisitor;
+
+namespace sofa::simulation::common
+{
+
+FusedVectorOperations::FusedVectorOperations(const core::ExecParams* params, core::objectmodel::BaseContext* ctx, bool precomputedTraversalOrder)
+    : m_params(params)
+    , m_ctx(ctx)
+    , m_precomputedTraversalOrder(precomputedTraversalOrder)
+{
+}
+
+void FusedVectorOperations::v_clear(core::MultiVecId v)
+{
+    m_ops.emplace_back(v);
+}
+
+void FusedVectorOperations::v_eq(core::MultiVecId v, core::ConstMultiVecId a)
+{
+    m_ops.emplace_back(v, a);
+}
+
+void FusedVectorOperations::v_eq(core::MultiVecId v, core::ConstMultiVecId a, SReal f)
+{
+    m_ops.emplace_back(v, a, f);
+}
+
+void FusedVectorOperations::v_peq(core::MultiVecId v, core::ConstMultiVecId a, SReal f)
+{
+    m_ops.emplace_back(v, v, 1_sreal, a, f);
+}
+
+void FusedVectorOperations::v_teq(core::MultiVecId v, SReal f)
+{
+    m_ops.emplace_back(v, v, f);
+}
+
+void FusedVectorOperations::v_op(core::MultiVecId v, core::ConstMultiVecId a, core::ConstMultiVecId b, SReal f)
+{
+    m_ops.emplace_back(v, a, 1_sreal, b, f);
+}
+
+std::size_t FusedVectorOperations::v_dot(core::ConstMultiVecId a, core::ConstMultiVecId b)
+{
+    m_reductions.push_back(VReductionEntry::dot(a, b));
+    return m_reductions.size() - 1;
+}
+
+std::size_t FusedVectorOperations::v_norm(core::ConstMultiVecId a, unsigned l)
+{
+    m_reductions.push_back(VReductionEntry::norm(a, l));
+    return m_reductions.size() - 1;
+}
+
+void FusedVectorOperations::execute()
+{
+    m_results.clear();
+
+    if (!empty())
+    {
+        MechanicalVMultiOpReduceVisitor visitor(m_params, m_ops, m_reductions);
+        visitor.setTags(m_ctx->getTags()).execute(m_ctx, m_precomputedTraversalOrder);
+
+        m_results.resize(m_reductions.size());
+        for (std::size_t i = 0; i < m_reductions.size(); ++i)
+        {
+            m_results[i] = visitor.getResult(i);
+        }
+    }
+
+    m_ops.clear();
+    m_reductions.clear();
+}
+
+SReal FusedVectorOperations::getResult(std::size_t i) const
+{
+    return m_results[i];
+}
+
+std::size_t FusedVectorOperations::size() const
+{
+    return m_ops.size() + m_reductions.size();
+}
+
+bool FusedVectorOperations::empty() const
+{
+    return m_ops.empty() && m_reductions.empty();
+}
+
+}
@@ -0,0 +1,106 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/simulation/config.h>
+#include <sofa/core/behavior/BaseMechanicalState.h>
+#include <sofa/core/MultiVecId.h>
+
+namespace sofa::core
+{
+class ExecParams;
+}
+
+namespace sofa::core::objectmodel
+{
+class BaseContext;
+}
+
+namespace sofa::simulation::common
+{
+
+/**
+ * Deferred vector operations.
+ *
+ * Contrary to VectorOperations, where each operation traverses the scene graph and each state vector, the operations
+ * are only recorded. They are all executed by execute(), in a single traversal of the scene graph. Each mechanical
+ * state performs all the operations in a single pass over its vectors (see BaseMechanicalState::vMultiOpReduce).
+ *
+ * The scalar products and the norms are computed on the vectors resulting from all the linear operations, whatever
+ * the order in which they were recorded. Their results are available after execute().
+ *
+ * Example: x += alpha * p, r -= alpha * q, rho = r.r
+ * \code{.cpp}
+ * FusedVectorOperations ops(params, ctx);
+ * ops.v_peq(x, p, alpha);
+ * ops.v_peq(r, q, -alpha);
+ * const auto rhoId = ops.v_dot(r, r);
+ * ops.execute();
+ * const SReal rho = ops.getResult(rhoId);
+ * \endcode
+ */
+class SOFA_SIMULATION_CORE_API FusedVectorOperations
+{
+public:
+    using VMultiOp = core::behavior::BaseMechanicalState::VMultiOp;
+    using VMultiOpEntry = core::behavior::BaseMechanicalState::VMultiOpEntry;
+    using VReductions = core::behavior::BaseMechanicalState::VReductions;
+    using VReductionEntry = core::behavior::BaseMechanicalState::VReductionEntry;
+
+    FusedVectorOperations(const core::ExecParams* params, core::objectmodel::BaseContext* ctx, bool precomputedTraversalOrder = false);
+
+    void v_clear(core::MultiVecId v); ///< v=0
+    void v_eq(core::MultiVecId v, core::ConstMultiVecId a); ///< v=a
+    void v_eq(core::MultiVecId v, core::ConstMultiVecId a, SReal f); ///< v=f*a
+    void v_peq(core::MultiVecId v, core::ConstMultiVecId a, SReal f = 1.0); ///< v+=f*a
+    void v_teq(core::MultiVecId v, SReal f); ///< v*=f
+    void v_op(core::MultiVecId v, core::ConstMultiVecId a, core::ConstMultiVecId b, SReal f = 1.0); ///< v=a+b*f
+
+    /// Record the scalar product a.b. Return the index of the result (see getResult).
+    std::size_t v_dot(core::ConstMultiVecId a, core::ConstMultiVecId b);
+
+    /// Record the norm of a. The type of norm is set by l: 0 for the infinite norm. Return the index of the result
+    /// (see getResult).
+    std::size_t v_norm(core::ConstMultiVecId a, unsigned l);
+
+    /// Execute all the recorded operations in a single traversal. The recorded operations are then cleared.
+    void execute();
+
+    /// Result of a scalar product or a norm computed during the latest call to execute()
+    SReal getResult(std::size_t i) const;
+
+    /// Number of recorded operations, not yet executed
+    std::size_t size() const;
+
+    [[nodiscard]] bool empty() const;
+
+protected:
+    const core::ExecParams* m_params { nullptr };
+    core::objectmodel::BaseContext* m_ctx { nullptr };
+    bool m_precomputedTraversalOrder { false };
+
+    VMultiOp m_ops;
+    VReductions m_reductions;
+    sofa::type::vector<SReal> m_results;
+};
+
+}
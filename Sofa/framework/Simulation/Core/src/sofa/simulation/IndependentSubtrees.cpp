@@ -0,0 +1,222 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/simulation/IndependentSubtrees.h>
+
+#include <sofa/core/BaseMapping.h>
+#include <sofa/core/behavior/BaseInteractionForceField.h>
+#include <sofa/core/behavior/BaseMechanicalState.h>
+#include <sofa/core/behavior/OdeSolver.h>
+#include <sofa/simulation/Node.h>
+#include <sofa/simulation/Visitor.h>
+
+#include <numeric>
+#include <unordered_map>
+
+
+namespace sofa::simulation
+{
+
+namespace
+{
+
+/// Collects the first nodes containing an ODE solver, without going further down
+class SubtreeRootVisitor : public Visitor
+{
+public:
+    SubtreeRootVisitor() : Visitor(core::execparams::defaultInstance()) {}
+
+    Result processNodeTopDown(Node* node) override
+    {
+        if (!node->solver.empty())
+        {
+            roots.push_back(node);
+            return RESULT_PRUNE;
+        }
+        return RESULT_CONTINUE;
+    }
+
+    const char* getClassName() const override { return "SubtreeRootVisitor"; }
+
+    std::vector<Node*> roots;
+};
+
+/// Collects all the nodes of a subtree
+class SubtreeNodeVisitor : public Visitor
+{
+public:
+    SubtreeNodeVisitor() : Visitor(core::execparams::defaultInstance()) {}
+
+    Result processNodeTopDown(Node* node) override
+    {
+        nodes.push_back(node);
+        return RESULT_CONTINUE;
+    }
+
+    const char* getClassName() const override { return "SubtreeNodeVisitor"; }
+
+    std::vector<Node*> nodes;
+};
+
+}
+
+void IndependentSubtrees::build(Node* root)
+{
+    m_groups.clear();
+    if (!root)
+    {
+        return;
+    }
+
+    SubtreeRootVisitor rootVisitor;
+    root->execute(rootVisitor);
+    const std::vector<Node*>& roots = rootVisitor.roots;
+
+    // union-find on the subtrees: the representative of a set is its first subtree
+    std::vector<std::size_t> parent(roots.size());
+    std::iota(parent.begin(), parent.end(), 0);
+
+    const auto find = [&parent](std::size_t i)
+    {
+        while (parent[i] != i)
+        {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    const auto unite = [&parent, &find](std::size_t i, std::size_t j)
+    {
+        i = find(i);
+        j = find(j);
+        if (i != j)
+        {
+            parent[std::max(i, j)] = std::min(i, j);
+        }
+    };
+
+    std::vector<std::vector<Node*> > subtreeNodes(roots.size());
+    std::unordered_map<const Node*, std::size_t> nodeOwner;
+    std::unordered_map<const core::behavior::BaseMechanicalState*, std::size_t> stateOwner;
+
+    for (std::size_t i = 0; i < roots.size(); ++i)
+    {
+        SubtreeNodeVisitor nodeVisitor;
+        roots[i]->execute(nodeVisitor);
+        subtreeNodes[i] = std::move(nodeVisitor.nodes);
+
+        for (Node* node : subtreeNodes[i])
+        {
+            const auto [it, inserted] = nodeOwner.emplace(node, i);
+            if (!inserted)
+            {
+                unite(it->second, i);
+            }
+
+            if (const auto* state = node->mechanicalState.get())
+            {
+                stateOwner.emplace(state, i);
+            }
+        }
+    }
+
+    const auto coupleWithState = [&stateOwner, &unite](std::size_t i, const core::behavior::BaseMechanicalState* state)
+    {
+        if (state)
+        {
+            const auto it = stateOwner.find(state);
+            if (it != stateOwner.end())
+            {
+                unite(i, it->second);
+            }
+        }
+    };
+
+    const auto coupleWithMapping = [&coupleWithState](std::size_t i, core::BaseMapping* mapping)
+    {
+        for (const auto* state : mapping->getMechFrom())
+        {
+            coupleWithState(i, state);
+        }
+        for (const auto* state : mapping->getMechTo())
+        {
+            coupleWithState(i, state);
+        }
+    };
+
+    for (std::size_t i = 0; i < roots.size(); ++i)
+    {
+        for (Node* node : subtreeNodes[i])
+        {
+            for (auto* forceField : node->interactionForceField)
+            {
+                coupleWithState(i, forceField->getMechModel1());
+                coupleWithState(i, forceField->getMechModel2());
+            }
+            for (auto* mapping : node->mapping)
+            {
+                coupleWithMapping(i, mapping);
+            }
+            if (auto* mapping = node->mechanicalMapping.get())
+            {
+                coupleWithMapping(i, mapping);
+            }
+        }
+    }
+
+    std::vector<std::size_t> groupIndex(roots.size());
+    for (std::size_t i = 0; i < roots.size(); ++i)
+    {
+        const std::size_t representative = find(i);
+        if (representative == i)
+        {
+            groupIndex[i] = m_groups.size();
+            m_groups.emplace_back();
+        }
+        else
+        {
+            groupIndex[i] = groupIndex[representative];
+        }
+
+        Group& group = m_groups[groupIndex[i]];
+        if (!group.roots.empty())
+        {
+            group.name += '+';
+        }
+        group.roots.push_back(roots[i]);
+        group.name += roots[i]->getName();
+    }
+}
+
+bool IndependentSubtrees::isSubtreeRoot(const Node* node) const
+{
+    for (const Group& group : m_groups)
+    {
+        if (std::find(group.roots.begin(), group.roots.end(), node) != group.roots.end())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace sofa::simulation
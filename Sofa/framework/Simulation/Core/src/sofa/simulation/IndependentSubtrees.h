@@ -0,0 +1,73 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/simulation/config.h>
+#include <sofa/simulation/fwd.h>
+
+#include <string>
+#include <vector>
+
+
+namespace sofa::simulation
+{
+
+/**
+ * Partition of a scene graph into groups of mechanical subtrees which can be simulated
+ * concurrently.
+ *
+ * A subtree is rooted at the first node containing an ODE solver along a path from the root of the
+ * graph, as in SolveVisitor. Two subtrees are put in the same group when they are coupled:
+ * - a node is shared by both subtrees (multi-parent node)
+ * - an interaction force field located in one subtree acts on a state of the other one
+ * - a mapping located in one subtree has an input or an output in the other one
+ *
+ * The subtrees of a group are kept in the traversal order of the graph, and the groups are sorted
+ * by their first subtree.
+ */
+class SOFA_SIMULATION_CORE_API IndependentSubtrees
+{
+public:
+
+    struct Group
+    {
+        /// roots of the coupled subtrees, in the traversal order of the graph
+        std::vector<Node*> roots;
+
+        /// names of the roots, separated by '+'
+        std::string name;
+    };
+
+    /// Compute the groups of subtrees below the given node
+    void build(Node* root);
+
+    const std::vector<Group>& getGroups() const { return m_groups; }
+
+    /// @return true if the given node is the root of one of the subtrees
+    bool isSubtreeRoot(const Node* node) const;
+
+private:
+
+    std::vector<Group> m_groups;
+};
+
+} // namespace sofa::simulation
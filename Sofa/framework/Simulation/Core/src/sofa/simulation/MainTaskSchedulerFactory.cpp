@@ -29,6 +29,7 @@ namespace sofa::simulation
 {
 
 std::mutex MainTaskSchedulerFactory::s_mutex;
+std::string MainTaskSchedulerFactory::s_defaultTaskSchedulerType = DefaultTaskScheduler::name();
 
 bool MainTaskSchedulerFactory::registerScheduler(const std::string& name,
     const std::function<TaskScheduler*()>& creatorFunc)
@@ -67,7 +68,20 @@ TaskScheduler* MainTaskSchedulerFactory::createInRegistry()
 
 std::string MainTaskSchedulerFactory::defaultTaskSchedulerType()
 {
-    return DefaultTaskScheduler::name();
+    std::lock_guard lock(s_mutex);
+    return s_defaultTaskSchedulerType;
+}
+
+bool MainTaskSchedulerFactory::setDefaultTaskSchedulerType(const std::string& name)
+{
+    std::lock_guard lock(s_mutex);
+    const auto schedulers = getFactory().getAvailableSchedulers();
+    if (schedulers.find(name) == schedulers.end())
+    {
+        return false;
+    }
+    s_defaultTaskSchedulerType = name;
+    return true;
 }
 
 TaskScheduler* MainTaskSchedulerFactory::instantiate(const std::string& name)
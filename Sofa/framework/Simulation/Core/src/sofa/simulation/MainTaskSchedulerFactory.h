@@ -51,9 +51,18 @@ public:
 
     static std::string defaultTaskSchedulerType();
 
+    /**
+     * Change the type of task scheduler instantiated by @createInRegistry() when no name is
+     * provided. The name must have been registered in the factory.
+     * @return false if the name is not registered
+     */
+    static bool setDefaultTaskSchedulerType(const std::string& name);
+
 private:
     static std::mutex s_mutex;
 
+    static std::string s_defaultTaskSchedulerType;
+
     static TaskSchedulerFactory& getFactory();
 };
 
@@ -180,6 +180,48 @@ UnaryFunction parallelForEachRange(TaskScheduler& taskScheduler, InputIt first,
     return f;
 }
 
+/**
+ * Same as parallelForEachRange, but the i-th range is always executed by the i-th thread of the
+ * task scheduler, whatever the load of the other threads. The first range is executed by the
+ * calling thread: a call from a worker thread does not wait for the main thread to be available.
+ *
+ * Calling this function several times on the same container, with the same task scheduler,
+ * processes the same elements on the same thread. Combined with a thread affinity policy (see
+ * TaskScheduler::setThreadAffinityPolicy), the memory of a range stays close to the CPU which
+ * first touched it (first-touch policy on NUMA systems), and timings are reproducible.
+ */
+template<class InputIt, class UnaryFunction>
+UnaryFunction parallelForEachRangeWithAffinity(TaskScheduler& taskScheduler, InputIt first, InputIt last, UnaryFunction f)
+{
+    if (first != last)
+    {
+        const auto taskSchedulerThreadCount = taskScheduler.getThreadCount();
+        if (taskSchedulerThreadCount == 0)
+        {
+            msg_error("parallelForEach") << "Task scheduler does not appear to be initialized. Cannot perform parallel tasks.";
+            return forEachRange(first, last, f);
+        }
+
+        CpuTaskStatus status;
+
+        const auto ranges = makeRangesForLoop<InputIt>(first, last, taskSchedulerThreadCount);
+
+        for (std::size_t i = 1; i < ranges.size(); ++i)
+        {
+            const Range<InputIt>& r = ranges[i];
+            taskScheduler.addTask(status, [&r, &f]()
+            {
+                f(r);
+            }, static_cast<int>(i));
+        }
+
+        f(ranges.front());
+
+        taskScheduler.workUntilDone(&status);
+    }
+    return f;
+}
+
 /**
  * Applies the given function object f to the result of dereferencing every iterator in the
  * range [first, last), in parallel.
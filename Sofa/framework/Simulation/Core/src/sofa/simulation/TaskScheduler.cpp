@@ -34,6 +34,11 @@ unsigned TaskScheduler::GetHardwareThreadsCount()
 }
 
 bool TaskScheduler::addTask(Task::Status& status, const std::function<void()>& task)
+{
+    return addTask(status, task, -1);
+}
+
+bool TaskScheduler::addTask(Task::Status& status, const std::function<void()>& task, int scheduledThread)
 {
     class CallableTask final : public Task
     {
@@ -60,7 +65,7 @@ bool TaskScheduler::addTask(Task::Status& status, const std::function<void()>& t
         std::function<void()> m_task;
     };
 
-    return addTask(new CallableTask(-1, status, task)); //destructor should be called after run() because it returns MemoryAlloc::Dynamic
+    return addTask(new CallableTask(scheduledThread, status, task)); //destructor should be called after run() because it returns MemoryAlloc::Dynamic
 }
 
 } // namespace sofa::simulation
@@ -24,6 +24,7 @@
 #include <sofa/config.h>
 
 #include <sofa/simulation/Task.h>
+#include <sofa/simulation/ThreadAffinity.h>
 
 #include <string> 
 #include <functional>
@@ -65,12 +66,29 @@ public:
 
     virtual bool addTask(Task::Status& status, const std::function<void()>& task);
 
+    /**
+     * Queue a task which must be executed by the thread of index scheduledThread (modulo the
+     * number of threads), 0 being the thread which initialized the scheduler.
+     * Schedulers not supporting this feature execute the task on any thread.
+     */
+    bool addTask(Task::Status& status, const std::function<void()>& task, int scheduledThread);
+
     virtual void workUntilDone(Task::Status* status) = 0;
 
     virtual Task::Allocator* getTaskAllocator() = 0;
 
+    /**
+     * Define how the threads are pinned on the CPUs. The policy is applied when the threads
+     * are created: a call to init() is required to take it into account.
+     */
+    void setThreadAffinityPolicy(const ThreadAffinityPolicy& policy) { m_threadAffinityPolicy = policy; }
+
+    const ThreadAffinityPolicy& getThreadAffinityPolicy() const { return m_threadAffinityPolicy; }
+
 protected:
 
+    ThreadAffinityPolicy m_threadAffinityPolicy;
+
     friend class Task;
 };
 
@@ -0,0 +1,288 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/simulation/ThreadAffinity.h>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(WIN32)
+#include <windows.h>
+#endif
+
+namespace sofa::simulation
+{
+
+namespace
+{
+
+/// Number of CPUs which can be set in an affinity mask (see setCurrentThreadAffinity)
+#if defined(__linux__)
+constexpr unsigned int maxNbCpus = CPU_SETSIZE;
+#elif defined(WIN32)
+constexpr unsigned int maxNbCpus = sizeof(DWORD_PTR) * 8;
+#else
+constexpr unsigned int maxNbCpus = 1024;
+#endif
+
+}
+
+CpuSet parseCpuList(const std::string& cpuList)
+{
+    CpuSet cpus;
+
+    std::stringstream stream(cpuList);
+    std::string token;
+    while (std::getline(stream, token, ','))
+    {
+        token.erase(std::remove_if(token.begin(), token.end(), [](unsigned char c) { return std::isspace(c); }), token.end());
+        if (token.empty())
+        {
+            continue;
+        }
+
+        try
+        {
+            const auto dash = token.find('-');
+            if (dash == std::string::npos)
+            {
+                const auto cpu = std::stoul(token);
+                if (cpu < maxNbCpus)
+                {
+                    cpus.push_back(static_cast<unsigned int>(cpu));
+                }
+            }
+            else
+            {
+                const auto first = std::stoul(token.substr(0, dash));
+                const auto last = std::stoul(token.substr(dash + 1));
+                if (first > last)
+                {
+                    // reversed ranges are malformed
+                    continue;
+                }
+
+                // the CPUs which cannot be set in an affinity mask are ignored
+                const auto end = std::min<unsigned long>(last, maxNbCpus - 1) + 1;
+                for (auto cpu = first; cpu < end; ++cpu)
+                {
+                    cpus.push_back(static_cast<unsigned int>(cpu));
+                }
+            }
+        }
+        catch (const std::exception&)
+        {
+            // ignore malformed entries
+        }
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+std::vector<CpuSet> getNumaNodesCpus()
+{
+    std::vector<CpuSet> nodes;
+
+#if defined(__linux__)
+    const std::filesystem::path nodesDirectory("/sys/devices/system/node");
+    std::error_code error;
+    std::map<unsigned int, CpuSet> sortedNodes;
+    for (const auto& entry : std::filesystem::directory_iterator(nodesDirectory, error))
+    {
+        const std::string name = entry.path().filename().string();
+        if (name.size() <= 4 || name.compare(0, 4, "node") != 0
+            || !std::all_of(name.begin() + 4, name.end(), [](unsigned char c) { return std::isdigit(c); }))
+        {
+            continue;
+        }
+
+        std::ifstream file(entry.path() / "cpulist");
+        std::string cpuList;
+        if (file && std::getline(file, cpuList))
+        {
+            CpuSet cpus = parseCpuList(cpuList);
+            if (!cpus.empty())
+            {
+                sortedNodes[static_cast<unsigned int>(std::stoul(name.substr(4)))] = std::move(cpus);
+            }
+        }
+    }
+    for (auto& [id, cpus] : sortedNodes)
+    {
+        nodes.push_back(std::move(cpus));
+    }
+#endif
+
+    if (nodes.empty())
+    {
+        CpuSet cpus(std::max(std::thread::hardware_concurrency(), 1u));
+        for (unsigned int i = 0; i < cpus.size(); ++i)
+        {
+            cpus[i] = i;
+        }
+        nodes.push_back(std::move(cpus));
+    }
+
+    return nodes;
+}
+
+std::vector<CpuSet> computeThreadCpuSets(const ThreadAffinityPolicy& policy, const unsigned int nbThreads,
+                                         const std::vector<CpuSet>& numaNodes)
+{
+    std::vector<CpuSet> threadCpus(nbThreads);
+
+    std::vector<CpuSet> nodes;
+    std::copy_if(numaNodes.begin(), numaNodes.end(), std::back_inserter(nodes),
+                 [](const CpuSet& cpus) { return !cpus.empty(); });
+
+    if (nbThreads == 0 || nodes.empty())
+    {
+        return threadCpus;
+    }
+
+    switch (policy.type)
+    {
+    case ThreadAffinityPolicy::Type::COMPACT:
+    {
+        CpuSet allCpus;
+        for (const auto& cpus : nodes)
+        {
+            allCpus.insert(allCpus.end(), cpus.begin(), cpus.end());
+        }
+        for (unsigned int i = 0; i < nbThreads; ++i)
+        {
+            threadCpus[i] = { allCpus[i % allCpus.size()] };
+        }
+        break;
+    }
+    case ThreadAffinityPolicy::Type::SCATTER:
+    {
+        const auto nbNodes = nodes.size();
+        for (unsigned int i = 0; i < nbThreads; ++i)
+        {
+            const CpuSet& cpus = nodes[i % nbNodes];
+            threadCpus[i] = { cpus[(i / nbNodes) % cpus.size()] };
+        }
+        break;
+    }
+    case ThreadAffinityPolicy::Type::EXPLICIT:
+    {
+        if (!policy.cpuList.empty())
+        {
+            for (unsigned int i = 0; i < nbThreads; ++i)
+            {
+                threadCpus[i] = { policy.cpuList[i % policy.cpuList.size()] };
+            }
+        }
+        break;
+    }
+    case ThreadAffinityPolicy::Type::NUMA_NODE:
+    {
+        const auto nbNodes = nodes.size();
+        for (unsigned int i = 0; i < nbThreads; ++i)
+        {
+            threadCpus[i] = nodes[(static_cast<std::size_t>(i) * nbNodes) / nbThreads];
+        }
+        break;
+    }
+    case ThreadAffinityPolicy::Type::NONE:
+    default:
+        break;
+    }
+
+    return threadCpus;
+}
+
+std::vector<CpuSet> computeThreadCpuSets(const ThreadAffinityPolicy& policy, const unsigned int nbThreads)
+{
+    if (policy.type == ThreadAffinityPolicy::Type::NONE)
+    {
+        return std::vector<CpuSet>(nbThreads);
+    }
+    return computeThreadCpuSets(policy, nbThreads, getNumaNodesCpus());
+}
+
+bool setCurrentThreadAffinity(const CpuSet& cpus)
+{
+    if (cpus.empty())
+    {
+        return true;
+    }
+
+#if defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (const auto cpu : cpus)
+    {
+        if (cpu >= CPU_SETSIZE)
+        {
+            return false;
+        }
+        CPU_SET(cpu, &cpuSet);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) == 0;
+#elif defined(WIN32)
+    DWORD_PTR mask = 0;
+    for (const auto cpu : cpus)
+    {
+        if (cpu >= sizeof(DWORD_PTR) * 8)
+        {
+            return false;
+        }
+        mask |= static_cast<DWORD_PTR>(1) << cpu;
+    }
+    return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+    return false;
+#endif
+}
+
+CpuSet getCurrentThreadAffinity()
+{
+    CpuSet cpus;
+#if defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) == 0)
+    {
+        for (unsigned int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &cpuSet))
+            {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    return cpus;
+}
+
+} // namespace sofa::simulation
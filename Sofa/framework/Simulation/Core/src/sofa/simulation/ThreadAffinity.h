@@ -0,0 +1,104 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/simulation/config.h>
+
+#include <string>
+#include <vector>
+
+namespace sofa::simulation
+{
+
+/// Set of logical CPU indices
+using CpuSet = std::vector<unsigned int>;
+
+/**
+ * Describes how the threads of a task scheduler are placed on the CPUs.
+ * The thread of index 0 is the thread which initialized the scheduler.
+ */
+struct SOFA_SIMULATION_CORE_API ThreadAffinityPolicy
+{
+    enum class Type
+    {
+        /// threads are not pinned: the OS is free to move them
+        NONE,
+        /// thread i is pinned on the i-th CPU, filling a NUMA node before using the next one
+        COMPACT,
+        /// threads are pinned on CPUs distributed in a round-robin way over the NUMA nodes
+        SCATTER,
+        /// thread i is pinned on the i-th CPU of cpuList
+        EXPLICIT,
+        /// threads are split in contiguous blocks, one per NUMA node. Each thread can run on any
+        /// CPU of its node.
+        NUMA_NODE
+    };
+
+    Type type { Type::NONE };
+
+    /// CPUs used by the EXPLICIT policy
+    CpuSet cpuList;
+
+    bool operator==(const ThreadAffinityPolicy& other) const
+    {
+        return type == other.type && cpuList == other.cpuList;
+    }
+    bool operator!=(const ThreadAffinityPolicy& other) const { return !(*this == other); }
+};
+
+/**
+ * Parse a list of CPUs in the Linux format, for example "0-3,8,10-11"
+ *
+ * Malformed entries and reversed ranges are ignored, as well as the CPUs which cannot be set in an
+ * affinity mask (see setCurrentThreadAffinity).
+ */
+SOFA_SIMULATION_CORE_API CpuSet parseCpuList(const std::string& cpuList);
+
+/**
+ * @return the CPUs of each NUMA node of the system. If the topology cannot be determined, a single
+ * node containing all the CPUs is returned.
+ */
+SOFA_SIMULATION_CORE_API std::vector<CpuSet> getNumaNodesCpus();
+
+/**
+ * Compute the CPUs allowed for each thread of a scheduler, according to a policy.
+ * An empty set means that the thread must not be pinned.
+ */
+SOFA_SIMULATION_CORE_API std::vector<CpuSet> computeThreadCpuSets(const ThreadAffinityPolicy& policy,
+                                                                  unsigned int nbThreads,
+                                                                  const std::vector<CpuSet>& numaNodes);
+
+SOFA_SIMULATION_CORE_API std::vector<CpuSet> computeThreadCpuSets(const ThreadAffinityPolicy& policy,
+                                                                  unsigned int nbThreads);
+
+/**
+ * Restrict the calling thread to a set of CPUs. Does nothing if the set is empty.
+ * @return false if the affinity could not be changed (unsupported platform or invalid CPU)
+ */
+SOFA_SIMULATION_CORE_API bool setCurrentThreadAffinity(const CpuSet& cpus);
+
+/**
+ * @return the CPUs on which the calling thread is allowed to run, or an empty set if unknown
+ */
+SOFA_SIMULATION_CORE_API CpuSet getCurrentThreadAffinity();
+
+} // namespace sofa::simulation
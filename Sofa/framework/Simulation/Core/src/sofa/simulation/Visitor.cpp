@@ -20,6 +20,7 @@
 * Contact information: contact@sofa-framework.org                             *
 ******************************************************************************/
 #include <sofa/simulation/Visitor.h>
+#include <sofa/simulation/ComponentProfiler.h>
 #include <sofa/simulation/VisualVisitor.h>
 #include <sofa/simulation/MechanicalVisitor.h>
 
@@ -235,10 +236,7 @@ void Visitor::printCloseNode(const char* type)
 
 #endif
 
-simulation::Visitor::ctime_t Visitor::begin(simulation::Node* /*node*/, core::objectmodel::BaseObject*
-#ifdef SOFA_DUMP_VISITOR_INFO
-        obj
-#endif
+simulation::Visitor::ctime_t Visitor::begin(simulation::Node* /*node*/, core::objectmodel::BaseObject* obj
         , const std::string &
 #ifdef SOFA_DUMP_VISITOR_INFO
         info
@@ -256,12 +254,16 @@ simulation::Visitor::ctime_t Visitor::begin(simulation::Node* /*node*/, core::ob
         printNode("Component", obj->getName(), arg);
     }
 #endif
+    if (ComponentProfiler::isEnabled())
+    {
+        return ComponentProfiler::beginComponent(obj);
+    }
     return ctime_t();
 }
 
 /// Optional helper method to call after handling an object if not using the for_each method.
 /// It currently takes care of time logging, but could be extended (step-by-step execution for instance)
-void Visitor::end(simulation::Node* /*node*/, core::objectmodel::BaseObject* /*obj*/, ctime_t)
+void Visitor::end(simulation::Node* /*node*/, core::objectmodel::BaseObject* obj, ctime_t t0)
 {
 #ifdef SOFA_DUMP_VISITOR_INFO
     if (printActivated)
@@ -269,6 +271,11 @@ void Visitor::end(simulation::Node* /*node*/, core::objectmodel::BaseObject* /*o
         printCloseNode("Component");
     }
 #endif
+    // called even if the profiler has been disabled meanwhile, to close the component opened by begin
+    if (t0 != ctime_t())
+    {
+        ComponentProfiler::endComponent(obj, t0);
+    }
 }
 
 simulation::Visitor::ctime_t Visitor::begin(simulation::Visitor::VisitorContext* vc, core::objectmodel::BaseObject* obj, const std::string &info)
@@ -0,0 +1,190 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/simulation/config.h>
+
+#include <sofa/simulation/Task.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace sofa::simulation
+{
+
+/**
+ * Lock-free work-stealing deque of tasks (Chase-Lev).
+ *
+ * The owner thread pushes and pops tasks at the bottom (LIFO), while any other thread can
+ * steal tasks from the top (FIFO). The circular buffer grows when it is full. Buffers replaced
+ * by a larger one are kept alive until the deque is destroyed, because a concurrent thief may
+ * still be reading from them.
+ *
+ * Memory orderings follow "Correct and Efficient Work-Stealing for Weak Memory Models",
+ * Lê, Pop, Cohen and Zappa Nardelli, PPoPP 2013.
+ */
+class WorkStealingDeque
+{
+public:
+
+    explicit WorkStealingDeque(std::int64_t initialCapacity = 256)
+    {
+        std::int64_t capacity = 1;
+        while (capacity < initialCapacity)
+        {
+            capacity <<= 1;
+        }
+        m_buffers.push_back(std::make_unique<CircularBuffer>(capacity));
+        m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /// Add a task at the bottom of the deque. Must only be called by the owner thread.
+    void push(Task* task)
+    {
+        const std::int64_t b = m_bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = m_top.load(std::memory_order_acquire);
+        CircularBuffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        if (b - t > buffer->capacity() - 1)
+        {
+            buffer = grow(buffer, b, t);
+        }
+        buffer->put(b, task);
+        m_bottom.store(b + 1, std::memory_order_release);
+    }
+
+    /// Remove the most recently pushed task. Must only be called by the owner thread.
+    /// @return nullptr if the deque is empty
+    Task* pop()
+    {
+        const std::int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+        CircularBuffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = m_top.load(std::memory_order_relaxed);
+
+        Task* task = nullptr;
+        if (t <= b)
+        {
+            task = buffer->get(b);
+            if (t == b)
+            {
+                // last element: race against thieves
+                if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    task = nullptr;
+                }
+                m_bottom.store(b + 1, std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    /// Remove the oldest task. Can be called by any thread.
+    /// @return nullptr if the deque is empty or if the race against another thread has been lost
+    Task* steal()
+    {
+        std::int64_t t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t b = m_bottom.load(std::memory_order_acquire);
+
+        if (t < b)
+        {
+            const CircularBuffer* buffer = m_buffer.load(std::memory_order_acquire);
+            Task* task = buffer->get(t);
+            if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+            return task;
+        }
+        return nullptr;
+    }
+
+    /// Approximation of the number of tasks in the deque, which can be called by any thread
+    std::int64_t size() const
+    {
+        const std::int64_t b = m_bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = m_top.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    std::int64_t capacity() const { return m_buffer.load(std::memory_order_relaxed)->capacity(); }
+
+private:
+
+    class CircularBuffer
+    {
+    public:
+        explicit CircularBuffer(std::int64_t capacity)
+            : m_capacity(capacity), m_mask(capacity - 1), m_data(new std::atomic<Task*>[static_cast<std::size_t>(capacity)])
+        {}
+
+        std::int64_t capacity() const { return m_capacity; }
+
+        void put(std::int64_t i, Task* task)
+        {
+            m_data[static_cast<std::size_t>(i & m_mask)].store(task, std::memory_order_relaxed);
+        }
+
+        Task* get(std::int64_t i) const
+        {
+            return m_data[static_cast<std::size_t>(i & m_mask)].load(std::memory_order_relaxed);
+        }
+
+    private:
+        const std::int64_t m_capacity;
+        const std::int64_t m_mask;
+        std::unique_ptr<std::atomic<Task*>[]> m_data;
+    };
+
+    CircularBuffer* grow(const CircularBuffer* buffer, std::int64_t bottom, std::int64_t top)
+    {
+        m_buffers.push_back(std::make_unique<CircularBuffer>(2 * buffer->capacity()));
+        CircularBuffer* newBuffer = m_buffers.back().get();
+        for (std::int64_t i = top; i < bottom; ++i)
+        {
+            newBuffer->put(i, buffer->get(i));
+        }
+        m_buffer.store(newBuffer, std::memory_order_release);
+        return newBuffer;
+    }
+
+    alignas(64) std::atomic<std::int64_t> m_top { 0 };
+    alignas(64) std::atomic<std::int64_t> m_bottom { 0 };
+    alignas(64) std::atomic<CircularBuffer*> m_buffer { nullptr };
+
+    /// all the buffers allocated so far. Only accessed by the owner thread.
+    std::vector<std::unique_ptr<CircularBuffer> > m_buffers;
+};
+
+} // namespace sofa::simulation
@@ -0,0 +1,598 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/simulation/WorkStealingTaskScheduler.h>
+
+#include <sofa/simulation/WorkStealingDeque.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/helper/logging/Messaging.h>
+#include <sofa/helper/TimerTrace.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#ifdef WIN32
+#include <processthreadsapi.h>
+#endif
+
+namespace sofa::simulation
+{
+
+const bool WorkStealingTaskSchedulerRegistered = MainTaskSchedulerFactory::registerScheduler(
+    WorkStealingTaskScheduler::name(),
+    &WorkStealingTaskScheduler::create);
+
+namespace
+{
+
+class WorkStealingTaskAllocator : public Task::Allocator
+{
+public:
+
+    void* allocate(std::size_t sz) final
+    {
+        return ::operator new(sz);
+    }
+
+    void free(void* ptr, std::size_t sz) final
+    {
+        SOFA_UNUSED(sz);
+        ::operator delete(ptr);
+    }
+};
+
+/// xorshift32: cheap pseudo-random generator used to choose the victims of a steal
+std::uint32_t nextRandom(std::uint32_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/// Run a task and release its status
+void executeTask(Task* task)
+{
+    Task::Status* status = task->getStatus();
+
+    {
+        helper::TimerTrace::ScopedEvent traceEvent("Task");
+        if (task->run() & Task::MemoryAlloc::Dynamic)
+        {
+            // pooled memory: free
+            task->operator delete(task, sizeof(*task));
+        }
+    }
+
+    status->setBusy(false);
+}
+
+}
+
+class WorkStealingWorkerThread
+{
+public:
+
+    enum
+    {
+        /// number of unsuccessful attempts to find a task before going to sleep
+        MaxSpinCount = 64
+    };
+
+    WorkStealingWorkerThread(WorkStealingTaskScheduler* scheduler, const unsigned int index, const std::string& name)
+        : m_name(name + std::to_string(index))
+        , m_index(index)
+        , m_randomState(2654435761u * (index + 1))
+        , m_scheduler(scheduler)
+    {}
+
+    ~WorkStealingWorkerThread()
+    {
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+    }
+
+    void start(const CpuSet& cpus)
+    {
+        m_cpus = cpus;
+        m_thread = std::thread([this] { run(); });
+    }
+
+    void join()
+    {
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+    }
+
+    /// Run tasks until the status is not busy anymore. Never sleeps.
+    void workUntilDone(const Task::Status* status)
+    {
+        while (status->isBusy())
+        {
+            if (!doWork())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /// Wake up the thread if it is sleeping
+    /// @return false if the thread was not sleeping
+    bool tryWakeUp()
+    {
+        if (!m_isSleeping.load(std::memory_order_relaxed) || !m_isSleeping.exchange(false, std::memory_order_acq_rel))
+        {
+            return false;
+        }
+        m_scheduler->m_sleepingWorkerCount.fetch_sub(1, std::memory_order_relaxed);
+        signal();
+        return true;
+    }
+
+    /// Queue a task that only this thread can execute. Can be called by any thread.
+    void pushPinnedTask(Task* task)
+    {
+        std::lock_guard guard(m_pinnedTasksMutex);
+        m_pinnedTasks.push_back(task);
+        m_pinnedTaskCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool hasPinnedTasks() const
+    {
+        return m_pinnedTaskCount.load(std::memory_order_relaxed) > 0;
+    }
+
+    /// Wake up the thread whatever its state, so it can notice that the scheduler is closing
+    void wakeUpForClosing()
+    {
+        if (m_isSleeping.exchange(false, std::memory_order_acq_rel))
+        {
+            m_scheduler->m_sleepingWorkerCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+        signal();
+    }
+
+    const std::string m_name;
+
+    const unsigned int m_index;
+
+    WorkStealingDeque m_deque;
+
+    std::atomic<std::size_t> m_executedTaskCount { 0 };
+
+    std::atomic<std::size_t> m_stolenTaskCount { 0 };
+
+    std::uint32_t m_randomState;
+
+private:
+
+    /// Pop a task from the own deque, or steal one from another worker, and run it
+    /// @return false if no task has been found
+    bool doWork()
+    {
+        Task* task = popPinnedTask();
+        if (task == nullptr)
+        {
+            task = m_deque.pop();
+        }
+        if (task == nullptr)
+        {
+            task = m_scheduler->stealTask(this, m_randomState);
+            if (task == nullptr)
+            {
+                return false;
+            }
+            m_stolenTaskCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        executeTask(task);
+        m_executedTaskCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    Task* popPinnedTask()
+    {
+        if (!hasPinnedTasks())
+        {
+            return nullptr;
+        }
+        std::lock_guard guard(m_pinnedTasksMutex);
+        if (m_pinnedTasks.empty())
+        {
+            return nullptr;
+        }
+        Task* task = m_pinnedTasks.front();
+        m_pinnedTasks.pop_front();
+        m_pinnedTaskCount.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+    }
+
+    // thread main loop
+    void run()
+    {
+#ifdef WIN32
+        const std::wstring widestr = std::wstring(m_name.begin(), m_name.end());
+        SetThreadDescription(GetCurrentThread(), widestr.c_str());
+#endif
+        helper::TimerTrace::setCurrentThreadName(m_name);
+        s_currentWorker = this;
+        setCurrentThreadAffinity(m_cpus);
+
+        unsigned int spinCount = 0;
+        while (!m_scheduler->isClosing())
+        {
+            if (doWork())
+            {
+                spinCount = 0;
+                continue;
+            }
+
+            if (++spinCount < MaxSpinCount)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            spinCount = 0;
+            sleep();
+        }
+
+        s_currentWorker = nullptr;
+    }
+
+    void sleep()
+    {
+        m_isSleeping.store(true, std::memory_order_relaxed);
+        m_scheduler->m_sleepingWorkerCount.fetch_add(1, std::memory_order_relaxed);
+
+        // pairs with the fence in WorkStealingTaskScheduler::wakeUpOneWorker: either the pusher
+        // sees that this thread is sleeping, or this thread sees the pushed task
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (hasPinnedTasks() || m_scheduler->hasPendingTasks() || m_scheduler->isClosing())
+        {
+            if (m_isSleeping.exchange(false, std::memory_order_acq_rel))
+            {
+                m_scheduler->m_sleepingWorkerCount.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+            // another thread already claimed to wake this one up: consume its signal
+        }
+
+        std::unique_lock lock(m_sleepMutex);
+        m_sleepCondition.wait(lock, [this] { return m_wakeUpSignal; });
+        m_wakeUpSignal = false;
+    }
+
+    void signal()
+    {
+        {
+            std::lock_guard guard(m_sleepMutex);
+            m_wakeUpSignal = true;
+        }
+        m_sleepCondition.notify_one();
+    }
+
+    WorkStealingTaskScheduler* m_scheduler;
+
+    std::thread m_thread;
+
+    /// CPUs on which the thread is pinned. Empty if the thread is not pinned.
+    CpuSet m_cpus;
+
+    /// tasks that cannot be stolen by the other threads
+    std::deque<Task*> m_pinnedTasks;
+
+    std::mutex m_pinnedTasksMutex;
+
+    std::atomic<std::size_t> m_pinnedTaskCount { 0 };
+
+    std::atomic<bool> m_isSleeping { false };
+
+    std::mutex m_sleepMutex;
+
+    std::condition_variable m_sleepCondition;
+
+    bool m_wakeUpSignal { false };
+
+public:
+
+    static thread_local WorkStealingWorkerThread* s_currentWorker;
+
+    friend class WorkStealingTaskScheduler;
+};
+
+thread_local WorkStealingWorkerThread* WorkStealingWorkerThread::s_currentWorker = nullptr;
+
+
+WorkStealingTaskScheduler* WorkStealingTaskScheduler::create()
+{
+    return new WorkStealingTaskScheduler();
+}
+
+WorkStealingTaskScheduler::WorkStealingTaskScheduler()
+    : TaskScheduler()
+    , m_mainThreadId(std::this_thread::get_id())
+{
+    m_workers.push_back(std::make_unique<WorkStealingWorkerThread>(this, 0, "Main  "));
+}
+
+WorkStealingTaskScheduler::~WorkStealingTaskScheduler()
+{
+    if (m_isInitialized)
+    {
+        stop();
+    }
+}
+
+Task::Allocator* WorkStealingTaskScheduler::getTaskAllocator()
+{
+    static WorkStealingTaskAllocator taskAllocator;
+    return &taskAllocator;
+}
+
+void WorkStealingTaskScheduler::init(const unsigned int nbThread)
+{
+    if (m_isInitialized)
+    {
+        const bool isSameThreadCount = (nbThread == m_threadCount) || (nbThread == 0 && m_threadCount == std::max(GetHardwareThreadsCount(), 1u));
+        if (isSameThreadCount && m_threadAffinityPolicy == m_appliedThreadAffinityPolicy)
+        {
+            return;
+        }
+        stop();
+    }
+
+    start(nbThread);
+}
+
+void WorkStealingTaskScheduler::start(const unsigned int nbThread)
+{
+    stop();
+
+    m_isClosing.store(false, std::memory_order_release);
+    m_sleepingWorkerCount.store(0, std::memory_order_relaxed);
+
+    // default number of thread: only physical cores. no advantage from hyperthreading.
+    m_threadCount = nbThread > 0 ? nbThread : std::max(GetHardwareThreadsCount(), 1u);
+
+    m_mainThreadId = std::this_thread::get_id();
+
+    const std::vector<CpuSet> threadCpus = computeThreadCpuSets(m_threadAffinityPolicy, m_threadCount);
+    m_appliedThreadAffinityPolicy = m_threadAffinityPolicy;
+    if (!threadCpus.front().empty())
+    {
+        m_mainThreadInitialAffinity = getCurrentThreadAffinity();
+        msg_warning_when(!setCurrentThreadAffinity(threadCpus.front()), "WorkStealingTaskScheduler")
+            << "The thread affinity policy cannot be applied on this system";
+    }
+
+    // the vector of workers must not be modified once the threads are started
+    m_workers.clear();
+    m_workers.reserve(m_threadCount);
+    m_workers.push_back(std::make_unique<WorkStealingWorkerThread>(this, 0, "Main  "));
+    for (unsigned int i = 1; i < m_threadCount; ++i)
+    {
+        m_workers.push_back(std::make_unique<WorkStealingWorkerThread>(this, i, "Worker"));
+    }
+
+    for (unsigned int i = 1; i < m_threadCount; ++i)
+    {
+        m_workers[i]->start(threadCpus[i]);
+    }
+
+    m_isInitialized = true;
+}
+
+void WorkStealingTaskScheduler::stop()
+{
+    if (!m_isInitialized)
+    {
+        return;
+    }
+
+    m_isClosing.store(true, std::memory_order_release);
+
+    for (std::size_t i = 1; i < m_workers.size(); ++i)
+    {
+        m_workers[i]->wakeUpForClosing();
+    }
+
+    for (std::size_t i = 1; i < m_workers.size(); ++i)
+    {
+        m_workers[i]->join();
+    }
+
+    m_workers.resize(1);
+    m_threadCount = 1;
+    m_isInitialized = false;
+
+    if (!m_mainThreadInitialAffinity.empty() && std::this_thread::get_id() == m_mainThreadId)
+    {
+        setCurrentThreadAffinity(m_mainThreadInitialAffinity);
+    }
+    m_mainThreadInitialAffinity.clear();
+}
+
+WorkStealingWorkerThread* WorkStealingTaskScheduler::getCurrent() const
+{
+    WorkStealingWorkerThread* worker = WorkStealingWorkerThread::s_currentWorker;
+    if (worker != nullptr && worker->m_scheduler == this)
+    {
+        return worker;
+    }
+    if (std::this_thread::get_id() == m_mainThreadId)
+    {
+        return m_workers.front().get();
+    }
+    return nullptr;
+}
+
+const char* WorkStealingTaskScheduler::getCurrentThreadName()
+{
+    const WorkStealingWorkerThread* worker = getCurrent();
+    return worker ? worker->m_name.c_str() : "External";
+}
+
+int WorkStealingTaskScheduler::getCurrentThreadType()
+{
+    return 0;
+}
+
+bool WorkStealingTaskScheduler::addTask(Task* task)
+{
+    WorkStealingWorkerThread* worker = getCurrent();
+
+    task->m_id = task->getStatus()->setBusy(true);
+
+    if (m_threadCount >= 2 && task->getScheduledThread() >= 0)
+    {
+        WorkStealingWorkerThread* target = m_workers[static_cast<std::size_t>(task->getScheduledThread()) % m_workers.size()].get();
+        target->pushPinnedTask(task);
+        if (target != worker)
+        {
+            // pairs with the fence in WorkStealingWorkerThread::sleep
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            target->tryWakeUp();
+        }
+        return true;
+    }
+
+    // we are single thread, or the calling thread has no deque: run the task
+    if (worker == nullptr || m_threadCount < 2)
+    {
+        executeTask(task);
+        return false;
+    }
+
+    worker->m_deque.push(task);
+    wakeUpOneWorker();
+    return true;
+}
+
+void WorkStealingTaskScheduler::workUntilDone(Task::Status* status)
+{
+    if (WorkStealingWorkerThread* worker = getCurrent())
+    {
+        worker->workUntilDone(status);
+    }
+    else
+    {
+        // external thread: it cannot pop, but it can steal
+        std::uint32_t randomState = static_cast<std::uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1u;
+        while (status->isBusy())
+        {
+            if (Task* task = stealTask(nullptr, randomState))
+            {
+                executeTask(task);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+void WorkStealingTaskScheduler::wakeUpOneWorker()
+{
+    // pairs with the fence in WorkStealingWorkerThread::sleep
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (m_sleepingWorkerCount.load(std::memory_order_relaxed) == 0)
+    {
+        return;
+    }
+
+    const std::size_t nbWorkers = m_workers.size();
+    const std::size_t first = m_nextWakeUpCandidate.fetch_add(1, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < nbWorkers; ++i)
+    {
+        const std::size_t candidate = (first + i) % nbWorkers;
+        if (candidate != 0 && m_workers[candidate]->tryWakeUp())
+        {
+            return;
+        }
+    }
+}
+
+bool WorkStealingTaskScheduler::hasPendingTasks() const
+{
+    for (const auto& worker : m_workers)
+    {
+        if (!worker->m_deque.empty())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+Task* WorkStealingTaskScheduler::stealTask(const WorkStealingWorkerThread* thief, std::uint32_t& randomState) const
+{
+    const std::size_t nbWorkers = m_workers.size();
+    const std::size_t first = nextRandom(randomState) % nbWorkers;
+    for (std::size_t i = 0; i < nbWorkers; ++i)
+    {
+        WorkStealingWorkerThread* victim = m_workers[(first + i) % nbWorkers].get();
+        if (victim == thief)
+        {
+            continue;
+        }
+        if (Task* task = victim->m_deque.steal())
+        {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::size_t> WorkStealingTaskScheduler::getExecutedTaskCount() const
+{
+    std::vector<std::size_t> counts;
+    counts.reserve(m_workers.size());
+    for (const auto& worker : m_workers)
+    {
+        counts.push_back(worker->m_executedTaskCount.load(std::memory_order_relaxed));
+    }
+    return counts;
+}
+
+std::vector<std::size_t> WorkStealingTaskScheduler::getStolenTaskCount() const
+{
+    std::vector<std::size_t> counts;
+    counts.reserve(m_workers.size());
+    for (const auto& worker : m_workers)
+    {
+        counts.push_back(worker->m_stolenTaskCount.load(std::memory_order_relaxed));
+    }
+    return counts;
+}
+
+} // namespace sofa::simulation
@@ -0,0 +1,140 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/config.h>
+
+#include <sofa/simulation/TaskScheduler.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace sofa::simulation
+{
+
+class WorkStealingWorkerThread;
+
+/**
+ * Task scheduler based on per-worker lock-free deques (see @WorkStealingDeque).
+ *
+ * Compared to @DefaultTaskScheduler:
+ * - there is no limit on the number of threads
+ * - a worker pushes and pops tasks on its own deque without any lock
+ * - an idle worker steals tasks from a randomly chosen victim
+ * - each worker sleeps on its own condition variable, and a single sleeping worker is
+ *   woken up when a task is pushed, instead of waking up all the workers at once
+ *
+ * The thread calling init() is the main thread of the scheduler. It does not sleep: it helps the
+ * workers in workUntilDone(). Tasks added from a thread which is not known by the scheduler are
+ * executed immediately.
+ *
+ * Tasks with a scheduled thread (see Task::getScheduledThread) are queued in a separate queue of
+ * the target thread and are never stolen.
+ */
+class SOFA_SIMULATION_CORE_API WorkStealingTaskScheduler : public TaskScheduler
+{
+public:
+
+    /**
+     * Call stop() and start() if not already initialized
+     * @param nbThread number of threads, including the main thread. If 0, GetHardwareThreadsCount() is used.
+     */
+    void init(const unsigned int nbThread = 0) final;
+
+    /**
+     * Wait and destroy worker threads
+     */
+    void stop() final;
+
+    unsigned int getThreadCount() const final { return m_threadCount; }
+    const char* getCurrentThreadName() final;
+    int getCurrentThreadType() final;
+
+    // queue task if there is space, and run it otherwise
+    bool addTask(Task* task) final;
+    void workUntilDone(Task::Status* status) final;
+    Task::Allocator* getTaskAllocator() final;
+
+    /// Total number of tasks executed by each thread since the last call to init(). The first
+    /// element corresponds to the main thread.
+    std::vector<std::size_t> getExecutedTaskCount() const;
+
+    /// Total number of tasks stolen by each thread since the last call to init()
+    std::vector<std::size_t> getStolenTaskCount() const;
+
+    // factory methods: name, creator function
+    static const char* name() { return "_workstealing"; }
+
+    static WorkStealingTaskScheduler* create();
+
+    ~WorkStealingTaskScheduler() override;
+
+private:
+
+    WorkStealingTaskScheduler();
+
+    WorkStealingTaskScheduler(const WorkStealingTaskScheduler&) = delete;
+
+    void start(unsigned int nbThread);
+
+    /// @return the worker associated to the calling thread, or nullptr if the thread is not known
+    WorkStealingWorkerThread* getCurrent() const;
+
+    bool isClosing() const { return m_isClosing.load(std::memory_order_acquire); }
+
+    /// Wake up a single sleeping worker, if any
+    void wakeUpOneWorker();
+
+    /// @return true if any of the worker deques contains a task
+    bool hasPendingTasks() const;
+
+    /// Try to steal a task from another worker, starting with a random victim
+    Task* stealTask(const WorkStealingWorkerThread* thief, std::uint32_t& randomState) const;
+
+    /// worker 0 is associated to the main thread
+    std::vector<std::unique_ptr<WorkStealingWorkerThread> > m_workers;
+
+    std::thread::id m_mainThreadId;
+
+    std::atomic<bool> m_isClosing { false };
+
+    std::atomic<unsigned int> m_sleepingWorkerCount { 0 };
+
+    std::atomic<unsigned int> m_nextWakeUpCandidate { 0 };
+
+    bool m_isInitialized { false };
+
+    /// affinity policy used when the threads have been created
+    ThreadAffinityPolicy m_appliedThreadAffinityPolicy;
+
+    /// affinity of the main thread before it has been pinned by init()
+    CpuSet m_mainThreadInitialAffinity;
+
+    unsigned int m_threadCount { 1 };
+
+    friend class WorkStealingWorkerThread;
+};
+
+} // namespace sofa::simulation
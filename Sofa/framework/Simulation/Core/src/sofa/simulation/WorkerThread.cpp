@@ -21,6 +21,7 @@
 ******************************************************************************/
 #include <sofa/simulation/WorkerThread.h>
 #include <sofa/simulation/DefaultTaskScheduler.h>
+#include <sofa/helper/TimerTrace.h>
 
 #include <cassert>
 #include <mutex>
@@ -65,8 +66,14 @@ bool WorkerThread::start(DefaultTaskScheduler *const &taskScheduler)
 }
 
 std::thread *WorkerThread::create_and_attach(DefaultTaskScheduler *const &taskScheduler)
+{
+    return create_and_attach(taskScheduler, {});
+}
+
+std::thread *WorkerThread::create_and_attach(DefaultTaskScheduler *const &taskScheduler, const CpuSet& cpus)
 {
     m_taskScheduler = taskScheduler;
+    m_cpus = cpus;
     m_stdThread = std::thread([this] { run(); });
     return &m_stdThread;
 }
@@ -80,6 +87,9 @@ void WorkerThread::run(void)
         widestr.c_str()
         );
 #endif
+    helper::TimerTrace::setCurrentThreadName(m_name);
+
+    setCurrentThreadAffinity(m_cpus);
 
     //workerThreadIndex = this;
     //TaskSchedulerDefault::_threads[std::this_thread::get_id()] = this;
@@ -153,6 +163,7 @@ void WorkerThread::runTask(Task *task)
     m_currentStatus = task->getStatus();
 
     {
+        helper::TimerTrace::ScopedEvent traceEvent("Task");
         if (task->run() & Task::MemoryAlloc::Dynamic)
         {
             // pooled memory: call destructor and free
@@ -184,6 +195,12 @@ void WorkerThread::workUntilDone(Task::Status *status)
 bool WorkerThread::popTask(Task **task)
 {
     simulation::ScopedLock lock(m_taskMutex);
+    if (!m_pinnedTasks.empty())
+    {
+        *task = m_pinnedTasks.front();
+        m_pinnedTasks.pop_front();
+        return true;
+    }
     if (!m_tasks.empty())
     {
         *task = m_tasks.back();
@@ -203,6 +220,15 @@ bool WorkerThread::pushTask(Task *task)
         return false;
     }
 
+    if (task->getScheduledThread() >= 0)
+    {
+        WorkerThread* target = m_taskScheduler->getWorkerThread(static_cast<unsigned int>(task->getScheduledThread()));
+        simulation::ScopedLock lock(target->m_taskMutex);
+        const int taskId = task->getStatus()->setBusy(true);
+        task->m_id = taskId;
+        target->m_pinnedTasks.push_back(task);
+    }
+    else
     {
         simulation::ScopedLock lock(m_taskMutex);
         const int taskId = task->getStatus()->setBusy(true);
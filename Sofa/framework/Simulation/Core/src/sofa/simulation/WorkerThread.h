@@ -25,6 +25,7 @@
 
 #include <sofa/simulation/Task.h>
 #include <sofa/simulation/Locks.h>
+#include <sofa/simulation/ThreadAffinity.h>
 
 #include <thread>
 #include <deque>
@@ -67,12 +68,15 @@ private:
 
     std::thread* create_and_attach(DefaultTaskScheduler* const& taskScheduler);
 
+    /// Create the thread and restrict it to a set of CPUs (no restriction if the set is empty)
+    std::thread* create_and_attach(DefaultTaskScheduler* const& taskScheduler, const CpuSet& cpus);
+
     void runTask(Task* task);
 
     // queue task if there is space (or do nothing)
     bool pushTask(Task* pTask);
 
-    // pop task from queue
+    // pop task from queue, starting with the tasks scheduled on this thread
     bool popTask(Task** ppTask);
 
     // steal and queue some task from another thread
@@ -101,6 +105,11 @@ private:
 
     std::deque<Task*> m_tasks;
 
+    /// tasks scheduled on this thread: they cannot be stolen
+    std::deque<Task*> m_pinnedTasks;
+
+    CpuSet m_cpus;
+
     std::thread  m_stdThread;
 
     Task::Status*	m_currentStatus;
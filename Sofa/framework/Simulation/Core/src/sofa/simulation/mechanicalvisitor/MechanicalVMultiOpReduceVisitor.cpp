@@ -0,0 +1,75 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/simulation/mechanicalvisitor/MechanicalVMultiOpReduceVisitor.h>
+
+#include <cmath>
+
+namespace sofa::simulation::mechanicalvisitor
+{
+
+MechanicalVMultiOpReduceVisitor::MechanicalVMultiOpReduceVisitor(const sofa::core::ExecParams* params,
+    const VMultiOp& o, const VReductions& r)
+    : MechanicalVMultiOpVisitor(params, o)
+    , reductions(r)
+    , results(r.size(), 0_sreal)
+{
+#ifdef SOFA_DUMP_VISITOR_INFO
+    setReadWriteVectors();
+#endif
+}
+
+Visitor::Result MechanicalVMultiOpReduceVisitor::fwdMechanicalState(VisitorContext* /*ctx*/, core::behavior::BaseMechanicalState* mm)
+{
+    mm->vMultiOpReduce(this->params, ops, reductions, results.data());
+    return RESULT_CONTINUE;
+}
+
+SReal MechanicalVMultiOpReduceVisitor::getResult(std::size_t i) const
+{
+    const auto& reduction = reductions[i];
+    if (reduction.type == VReductionEntry::Type::NORM && reduction.l > 1)
+    {
+        return std::exp(std::log(results[i]) / reduction.l);
+    }
+    return results[i];
+}
+
+std::string MechanicalVMultiOpReduceVisitor::getInfos() const
+{
+    std::ostringstream out;
+    out << MechanicalVMultiOpVisitor::getInfos();
+    for (const auto& reduction : reductions)
+    {
+        out << " ;   ";
+        if (reduction.type == VReductionEntry::Type::DOT)
+        {
+            out << "dot(" << reduction.a.getName() << ", " << reduction.b.getName() << ")";
+        }
+        else
+        {
+            out << "norm" << reduction.l << "(" << reduction.a.getName() << ")";
+        }
+    }
+    return out.str();
+}
+
+}
@@ -0,0 +1,76 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/simulation/mechanicalvisitor/MechanicalVMultiOpVisitor.h>
+
+namespace sofa::simulation::mechanicalvisitor
+{
+
+/** Perform a sequence of linear vector accumulation operations (see MechanicalVMultiOpVisitor), followed by a
+ * sequence of reductions (scalar products or norms) on the updated vectors, in a single traversal.
+ *
+ * The reductions are computed only on the non-mapped states.
+ */
+class SOFA_SIMULATION_CORE_API MechanicalVMultiOpReduceVisitor : public MechanicalVMultiOpVisitor
+{
+public:
+    typedef sofa::core::behavior::BaseMechanicalState::VReductions VReductions;
+    typedef sofa::core::behavior::BaseMechanicalState::VReductionEntry VReductionEntry;
+
+    MechanicalVMultiOpReduceVisitor(const sofa::core::ExecParams* params, const VMultiOp& o, const VReductions& r);
+
+    Result fwdMechanicalState(VisitorContext* ctx, sofa::core::behavior::BaseMechanicalState* mm) override;
+
+    const char* getClassName() const override { return "MechanicalVMultiOpReduceVisitor"; }
+    std::string getInfos() const override;
+
+    /// The results are accumulated from all the states
+    bool isThreadSafe() const override
+    {
+        return false;
+    }
+
+#ifdef SOFA_DUMP_VISITOR_INFO
+    void setReadWriteVectors() override
+    {
+        MechanicalVMultiOpVisitor::setReadWriteVectors();
+        for (const auto& reduction : reductions)
+        {
+            addReadVector(reduction.a);
+            if (reduction.type == VReductionEntry::Type::DOT)
+            {
+                addReadVector(reduction.b);
+            }
+        }
+    }
+#endif
+
+    /// Result of the i-th reduction, once the visitor has been executed
+    SReal getResult(std::size_t i) const;
+
+protected:
+    VReductions reductions;
+    sofa::type::vector<SReal> results;
+};
+
+}
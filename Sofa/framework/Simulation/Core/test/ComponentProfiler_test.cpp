@@ -0,0 +1,199 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <sofa/simulation/ComponentProfiler.h>
+
+#include <numeric>
+#include <thread>
+
+namespace sofa
+{
+
+using simulation::ComponentProfiler;
+
+TEST(ComponentProfiler, statistics)
+{
+    std::vector<double> samples(100);
+    std::iota(samples.rbegin(), samples.rend(), 1.);
+
+    const auto statistics = ComponentProfiler::computeStatistics(samples);
+    EXPECT_DOUBLE_EQ(statistics.mean, 50.5);
+    EXPECT_DOUBLE_EQ(statistics.median, 50.5);
+    EXPECT_DOUBLE_EQ(statistics.p99, 99.);
+    EXPECT_DOUBLE_EQ(statistics.min, 1.);
+    EXPECT_DOUBLE_EQ(statistics.max, 100.);
+
+    const auto empty = ComponentProfiler::computeStatistics({});
+    EXPECT_EQ(empty.mean, 0.);
+    EXPECT_EQ(empty.max, 0.);
+}
+
+TEST(ComponentProfiler, recordSteps)
+{
+    const auto component = core::objectmodel::New<core::objectmodel::BaseObject>();
+    component->setName("component");
+
+    ComponentProfiler::clear();
+    ComponentProfiler::setEnabled(true);
+
+    const auto ticksPerSecond = helper::system::thread::CTime::getTicksPerSec();
+    constexpr unsigned int nbSteps = 4;
+    for (unsigned int step = 0; step < nbSteps; ++step)
+    {
+        ComponentProfiler::beginStep();
+        ComponentProfiler::endComponent(component.get(), ComponentProfiler::beginComponent(component.get()));
+        ComponentProfiler::endComponent(component.get(), ComponentProfiler::beginComponent(component.get()));
+        if (step == 0)
+        {
+            ComponentProfiler::addAllocation(component.get());
+        }
+
+        // a stage of 10ms, containing a nested stage of 2ms
+        type::vector<helper::Record> records(4);
+        records[0].type = helper::Record::RSTEP_BEGIN;
+        records[0].label = "Stage";
+        records[0].time = 0;
+        records[1].type = helper::Record::RSTEP_BEGIN;
+        records[1].label = "NestedStage";
+        records[1].time = ticksPerSecond / 1000;
+        records[2].type = helper::Record::RSTEP_END;
+        records[2].label = "NestedStage";
+        records[2].time = 3 * ticksPerSecond / 1000;
+        records[3].type = helper::Record::RSTEP_END;
+        records[3].label = "Stage";
+        records[3].time = 10 * ticksPerSecond / 1000;
+        ComponentProfiler::endStep(records);
+    }
+
+    ComponentProfiler::setEnabled(false);
+    ComponentProfiler::addAllocation(component.get());
+
+    const auto steps = ComponentProfiler::getStepStatistics();
+    EXPECT_EQ(steps.nbSteps, nbSteps);
+    EXPECT_DOUBLE_EQ(steps.allocations.mean, 1. / nbSteps);
+    EXPECT_DOUBLE_EQ(steps.allocations.max, 1.);
+
+    const auto components = ComponentProfiler::getComponentStatistics();
+    ASSERT_EQ(components.size(), 1);
+    EXPECT_EQ(components[0].name, "component");
+    EXPECT_EQ(components[0].className, "BaseObject");
+    EXPECT_DOUBLE_EQ(components[0].calls.mean, 2.);
+    EXPECT_DOUBLE_EQ(components[0].allocations.max, 1.);
+    EXPECT_DOUBLE_EQ(components[0].allocations.median, 0.);
+    EXPECT_GE(components[0].time.min, 0.);
+
+    const auto stages = ComponentProfiler::getStageStatistics();
+    ASSERT_EQ(stages.size(), 2);
+    EXPECT_EQ(stages[0].name, "Stage");
+    EXPECT_NEAR(stages[0].time.mean, 10., 1e-6);
+    EXPECT_DOUBLE_EQ(stages[0].calls.mean, 1.);
+    EXPECT_EQ(stages[1].name, "NestedStage");
+    EXPECT_NEAR(stages[1].time.median, 2., 1e-6);
+
+    ComponentProfiler::clear();
+    EXPECT_EQ(ComponentProfiler::getStepStatistics().nbSteps, 0);
+    EXPECT_TRUE(ComponentProfiler::getComponentStatistics().empty());
+}
+
+TEST(ComponentProfiler, allocationChargedToRequestingComponent)
+{
+    const auto solver = core::objectmodel::New<core::objectmodel::BaseObject>();
+    solver->setName("solver");
+    const auto state = core::objectmodel::New<core::objectmodel::BaseObject>();
+    state->setName("state");
+
+    ComponentProfiler::clear();
+    ComponentProfiler::setEnabled(true);
+    ComponentProfiler::beginStep();
+
+    // the solver allocates a vector: the state is processed by the allocation visitor
+    const auto solverStart = ComponentProfiler::beginComponent(solver.get());
+    const auto stateStart = ComponentProfiler::beginComponent(state.get());
+    ComponentProfiler::addAllocation(state.get());
+    ComponentProfiler::endComponent(state.get(), stateStart);
+    ComponentProfiler::endComponent(solver.get(), solverStart);
+
+    // allocation outside of any visitor
+    ComponentProfiler::addAllocation(state.get());
+    ComponentProfiler::addAllocation(state.get());
+
+    ComponentProfiler::endStep();
+    ComponentProfiler::setEnabled(false);
+
+    const auto components = ComponentProfiler::getComponentStatistics();
+    ASSERT_EQ(components.size(), 2);
+    for (const auto& component : components)
+    {
+        EXPECT_DOUBLE_EQ(component.allocations.mean, component.name == "solver" ? 1. : 2.) << component.name;
+        EXPECT_DOUBLE_EQ(component.calls.mean, 1.) << component.name;
+    }
+    EXPECT_DOUBLE_EQ(ComponentProfiler::getStepStatistics().allocations.mean, 3.);
+
+    ComponentProfiler::clear();
+}
+
+TEST(ComponentProfiler, workerThreads)
+{
+    const auto component = core::objectmodel::New<core::objectmodel::BaseObject>();
+    component->setName("component");
+
+    ComponentProfiler::clear();
+    ComponentProfiler::setEnabled(true);
+
+    constexpr unsigned int nbSteps = 2;
+    constexpr unsigned int nbThreads = 4;
+    constexpr unsigned int nbCalls = 100;
+    for (unsigned int step = 0; step < nbSteps; ++step)
+    {
+        ComponentProfiler::beginStep();
+
+        std::vector<std::thread> threads;
+        for (unsigned int t = 0; t < nbThreads; ++t)
+        {
+            threads.emplace_back([&component]()
+            {
+                for (unsigned int i = 0; i < nbCalls; ++i)
+                {
+                    ComponentProfiler::endComponent(component.get(), ComponentProfiler::beginComponent(component.get()));
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        ComponentProfiler::endStep();
+    }
+    ComponentProfiler::setEnabled(false);
+
+    // the measures of the threads are gathered at the end of each step, even after the end of the threads
+    const auto components = ComponentProfiler::getComponentStatistics();
+    ASSERT_EQ(components.size(), 1);
+    EXPECT_EQ(components[0].name, "component");
+    EXPECT_DOUBLE_EQ(components[0].calls.min, nbThreads * nbCalls);
+    EXPECT_DOUBLE_EQ(components[0].calls.max, nbThreads * nbCalls);
+
+    ComponentProfiler::clear();
+}
+
+}
@@ -22,6 +22,7 @@
 #include <gtest/gtest.h>
 #include <sofa/simulation/MainTaskSchedulerFactory.h>
 #include <sofa/simulation/DefaultTaskScheduler.h>
+#include <sofa/simulation/WorkStealingTaskScheduler.h>
 
 namespace sofa
 {
@@ -63,6 +64,20 @@ TEST(MainTaskSchedulerFactory, registerAlreadyInFactory)
     EXPECT_FALSE(isRegistered);
 }
 
+TEST(MainTaskSchedulerFactory, setDefaultTaskSchedulerType)
+{
+    EXPECT_FALSE(simulation::MainTaskSchedulerFactory::setDefaultTaskSchedulerType("notInFactory"));
+    EXPECT_EQ(simulation::MainTaskSchedulerFactory::defaultTaskSchedulerType(), simulation::DefaultTaskScheduler::name());
+
+    EXPECT_TRUE(simulation::MainTaskSchedulerFactory::setDefaultTaskSchedulerType(simulation::WorkStealingTaskScheduler::name()));
+    EXPECT_EQ(simulation::MainTaskSchedulerFactory::defaultTaskSchedulerType(), simulation::WorkStealingTaskScheduler::name());
+
+    const simulation::TaskScheduler* scheduler = simulation::MainTaskSchedulerFactory::createInRegistry();
+    EXPECT_NE(dynamic_cast<const simulation::WorkStealingTaskScheduler*>(scheduler), nullptr);
+
+    EXPECT_TRUE(simulation::MainTaskSchedulerFactory::setDefaultTaskSchedulerType(simulation::DefaultTaskScheduler::name()));
+}
+
 TEST(MainTaskSchedulerFactory, registerNew)
 {
     const bool isRegistered = simulation::MainTaskSchedulerFactory::registerScheduler(
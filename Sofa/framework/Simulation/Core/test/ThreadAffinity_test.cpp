@@ -0,0 +1,247 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <sofa/simulation/CpuTaskStatus.h>
+#include <sofa/simulation/DefaultTaskScheduler.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/ParallelForEach.h>
+#include <sofa/simulation/ThreadAffinity.h>
+#include <sofa/simulation/WorkStealingTaskScheduler.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+namespace sofa
+{
+
+using simulation::CpuSet;
+using simulation::ThreadAffinityPolicy;
+
+namespace
+{
+/// two NUMA nodes with 4 CPUs each
+const std::vector<CpuSet> twoNodes { {0, 1, 2, 3}, {4, 5, 6, 7} };
+}
+
+TEST(ThreadAffinity, parseCpuList)
+{
+    EXPECT_EQ(simulation::parseCpuList("0-3,8,10-11"), CpuSet({0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(simulation::parseCpuList("5"), CpuSet({5}));
+    EXPECT_EQ(simulation::parseCpuList(" 2, 1 ,1\n"), CpuSet({1, 2}));
+    EXPECT_TRUE(simulation::parseCpuList("").empty());
+    EXPECT_EQ(simulation::parseCpuList("a,3"), CpuSet({3}));
+    EXPECT_EQ(simulation::parseCpuList("3-1,2"), CpuSet({2}));
+    EXPECT_EQ(simulation::parseCpuList("4294967295,1"), CpuSet({1}));
+
+    // the range is clamped to the CPUs which can be set in an affinity mask
+    const CpuSet largeRange = simulation::parseCpuList("0-4294967295");
+    ASSERT_FALSE(largeRange.empty());
+    EXPECT_LE(largeRange.size(), 1024u * 1024u);
+    EXPECT_EQ(largeRange.front(), 0u);
+    EXPECT_EQ(largeRange.back() + 1, largeRange.size());
+}
+
+TEST(ThreadAffinity, numaNodes)
+{
+    const auto nodes = simulation::getNumaNodesCpus();
+    ASSERT_FALSE(nodes.empty());
+    for (const auto& cpus : nodes)
+    {
+        EXPECT_FALSE(cpus.empty());
+    }
+}
+
+TEST(ThreadAffinity, none)
+{
+    const auto cpus = simulation::computeThreadCpuSets(ThreadAffinityPolicy{}, 4, twoNodes);
+    ASSERT_EQ(cpus.size(), 4);
+    for (const auto& c : cpus)
+    {
+        EXPECT_TRUE(c.empty());
+    }
+}
+
+TEST(ThreadAffinity, compact)
+{
+    ThreadAffinityPolicy policy;
+    policy.type = ThreadAffinityPolicy::Type::COMPACT;
+    const auto cpus = simulation::computeThreadCpuSets(policy, 10, twoNodes);
+    ASSERT_EQ(cpus.size(), 10);
+    for (unsigned int i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(cpus[i], CpuSet({i % 8}));
+    }
+}
+
+TEST(ThreadAffinity, scatter)
+{
+    ThreadAffinityPolicy policy;
+    policy.type = ThreadAffinityPolicy::Type::SCATTER;
+    const auto cpus = simulation::computeThreadCpuSets(policy, 4, twoNodes);
+    ASSERT_EQ(cpus.size(), 4);
+    EXPECT_EQ(cpus[0], CpuSet({0}));
+    EXPECT_EQ(cpus[1], CpuSet({4}));
+    EXPECT_EQ(cpus[2], CpuSet({1}));
+    EXPECT_EQ(cpus[3], CpuSet({5}));
+}
+
+TEST(ThreadAffinity, explicitList)
+{
+    ThreadAffinityPolicy policy;
+    policy.type = ThreadAffinityPolicy::Type::EXPLICIT;
+    policy.cpuList = {6, 2};
+    const auto cpus = simulation::computeThreadCpuSets(policy, 3, twoNodes);
+    ASSERT_EQ(cpus.size(), 3);
+    EXPECT_EQ(cpus[0], CpuSet({6}));
+    EXPECT_EQ(cpus[1], CpuSet({2}));
+    EXPECT_EQ(cpus[2], CpuSet({6}));
+}
+
+TEST(ThreadAffinity, numaNode)
+{
+    ThreadAffinityPolicy policy;
+    policy.type = ThreadAffinityPolicy::Type::NUMA_NODE;
+    const auto cpus = simulation::computeThreadCpuSets(policy, 6, twoNodes);
+    ASSERT_EQ(cpus.size(), 6);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(cpus[i], twoNodes[0]);
+        EXPECT_EQ(cpus[i + 3], twoNodes[1]);
+    }
+}
+
+TEST(ThreadAffinity, setCurrentThreadAffinity)
+{
+    EXPECT_TRUE(simulation::setCurrentThreadAffinity({}));
+
+    const CpuSet initialAffinity = simulation::getCurrentThreadAffinity();
+    if (initialAffinity.empty())
+    {
+        GTEST_SKIP() << "thread affinity is not supported on this system";
+    }
+
+    EXPECT_TRUE(simulation::setCurrentThreadAffinity({initialAffinity.front()}));
+    EXPECT_EQ(simulation::getCurrentThreadAffinity(), CpuSet({initialAffinity.front()}));
+
+    EXPECT_TRUE(simulation::setCurrentThreadAffinity(initialAffinity));
+    EXPECT_EQ(simulation::getCurrentThreadAffinity(), initialAffinity);
+}
+
+/// The tests set the task allocator of their scheduler, which is destroyed at the end of the test
+class ThreadAffinityScheduler_test : public ::testing::TestWithParam<std::string>
+{
+protected:
+    void SetUp() override
+    {
+        m_previousAllocator = simulation::Task::getAllocator();
+    }
+
+    void TearDown() override
+    {
+        simulation::Task::setAllocator(m_previousAllocator);
+    }
+
+private:
+    simulation::Task::Allocator* m_previousAllocator { nullptr };
+};
+
+TEST_P(ThreadAffinityScheduler_test, sameRangeOnSameThread)
+{
+    const auto scheduler = std::unique_ptr<simulation::TaskScheduler>(
+        simulation::MainTaskSchedulerFactory::instantiate(GetParam()));
+    simulation::Task::setAllocator(scheduler->getTaskAllocator());
+
+    ThreadAffinityPolicy policy;
+    policy.type = ThreadAffinityPolicy::Type::COMPACT;
+    scheduler->setThreadAffinityPolicy(policy);
+    scheduler->init(4);
+
+    std::vector<int> integers(1000);
+    std::iota(integers.begin(), integers.end(), 0);
+
+    std::mutex mutex;
+    const auto collectThreadNames = [&]()
+    {
+        std::map<int, std::string> threadNames;
+        simulation::parallelForEachRangeWithAffinity(*scheduler, integers.begin(), integers.end(),
+            [&](const auto& range)
+            {
+                std::lock_guard lock(mutex);
+                threadNames[*range.start] = scheduler->getCurrentThreadName();
+            });
+        return threadNames;
+    };
+
+    const auto reference = collectThreadNames();
+    EXPECT_EQ(reference.size(), 4);
+    for (unsigned int i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(collectThreadNames(), reference);
+    }
+
+    scheduler->stop();
+}
+
+TEST_P(ThreadAffinityScheduler_test, calledFromWorkerThread)
+{
+    const auto scheduler = std::unique_ptr<simulation::TaskScheduler>(
+        simulation::MainTaskSchedulerFactory::instantiate(GetParam()));
+    simulation::Task::setAllocator(scheduler->getTaskAllocator());
+    scheduler->init(4);
+
+    std::vector<int> integers(1000);
+    std::iota(integers.begin(), integers.end(), 0);
+
+    // the loop runs in a task executed by a worker thread, while the main thread is busy
+    std::atomic<int> sum { 0 };
+    std::atomic<bool> done { false };
+    simulation::CpuTaskStatus status;
+    scheduler->addTask(status, [&]()
+    {
+        simulation::parallelForEachRangeWithAffinity(*scheduler, integers.begin(), integers.end(),
+            [&sum](const auto& range)
+            {
+                sum += std::accumulate(range.start, range.end, 0);
+            });
+        done = true;
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    while (!done && std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(done) << "the loop waits for the main thread";
+
+    scheduler->workUntilDone(&status);
+    EXPECT_EQ(sum, 999 * 1000 / 2);
+
+    scheduler->stop();
+}
+
+INSTANTIATE_TEST_SUITE_P(ThreadAffinity, ThreadAffinityScheduler_test,
+    ::testing::Values(simulation::DefaultTaskScheduler::name(), simulation::WorkStealingTaskScheduler::name()));
+
+}
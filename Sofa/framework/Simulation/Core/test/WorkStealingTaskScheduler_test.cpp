@@ -0,0 +1,322 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <gtest/gtest.h>
+#include <sofa/simulation/CpuTask.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/ParallelForEach.h>
+#include <sofa/simulation/WorkStealingDeque.h>
+#include <sofa/simulation/WorkStealingTaskScheduler.h>
+
+#include <numeric>
+#include <thread>
+
+namespace sofa
+{
+
+namespace
+{
+
+// compute recursively the sum of integers from first to last, generating lots of lightweight tasks
+class RecursiveSumTask final : public simulation::CpuTask
+{
+public:
+    RecursiveSumTask(simulation::TaskScheduler* scheduler, const int64_t first, const int64_t last,
+                     int64_t* const sum, simulation::CpuTask::Status* status)
+        : CpuTask(status), m_scheduler(scheduler), m_first(first), m_last(last), m_sum(sum)
+    {}
+
+    MemoryAlloc run() override
+    {
+        const int64_t count = m_last - m_first;
+        if (count < 1)
+        {
+            *m_sum = m_first;
+            return MemoryAlloc::Stack;
+        }
+
+        const int64_t mid = m_first + (count / 2);
+        simulation::CpuTask::Status status;
+        int64_t x, y;
+
+        RecursiveSumTask task0(m_scheduler, m_first, mid, &x, &status);
+        RecursiveSumTask task1(m_scheduler, mid + 1, m_last, &y, &status);
+
+        m_scheduler->addTask(&task0);
+        m_scheduler->addTask(&task1);
+        m_scheduler->workUntilDone(&status);
+
+        *m_sum = x + y;
+        return MemoryAlloc::Stack;
+    }
+
+private:
+    simulation::TaskScheduler* m_scheduler;
+    const int64_t m_first;
+    const int64_t m_last;
+    int64_t* const m_sum;
+};
+
+class DummyTask final : public simulation::CpuTask
+{
+public:
+    DummyTask() : CpuTask(nullptr) {}
+    MemoryAlloc run() override { return MemoryAlloc::Stack; }
+};
+
+std::unique_ptr<simulation::TaskScheduler> makeWorkStealingTaskScheduler()
+{
+    auto scheduler = std::unique_ptr<simulation::TaskScheduler>(
+        simulation::MainTaskSchedulerFactory::instantiate(simulation::WorkStealingTaskScheduler::name()));
+    // required by the tasks allocated dynamically (see TaskScheduler::addTask)
+    simulation::Task::setAllocator(scheduler->getTaskAllocator());
+    return scheduler;
+}
+
+int64_t recursiveSum(simulation::TaskScheduler* scheduler, const int64_t N)
+{
+    simulation::CpuTask::Status status;
+    int64_t result = 0;
+
+    RecursiveSumTask task(scheduler, 1, N, &result, &status);
+    scheduler->addTask(&task);
+    scheduler->workUntilDone(&status);
+
+    return result;
+}
+
+}
+
+TEST(WorkStealingDeque, pushPopLIFO)
+{
+    simulation::WorkStealingDeque deque(4);
+    std::vector<DummyTask> tasks(3);
+
+    EXPECT_EQ(deque.pop(), nullptr);
+
+    for (auto& task : tasks)
+    {
+        deque.push(&task);
+    }
+    EXPECT_EQ(deque.size(), 3);
+
+    EXPECT_EQ(deque.pop(), &tasks[2]);
+    EXPECT_EQ(deque.pop(), &tasks[1]);
+    EXPECT_EQ(deque.pop(), &tasks[0]);
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDeque, stealFIFO)
+{
+    simulation::WorkStealingDeque deque(4);
+    std::vector<DummyTask> tasks(3);
+
+    for (auto& task : tasks)
+    {
+        deque.push(&task);
+    }
+
+    EXPECT_EQ(deque.steal(), &tasks[0]);
+    EXPECT_EQ(deque.pop(), &tasks[2]);
+    EXPECT_EQ(deque.steal(), &tasks[1]);
+    EXPECT_EQ(deque.steal(), nullptr);
+}
+
+TEST(WorkStealingDeque, grow)
+{
+    simulation::WorkStealingDeque deque(2);
+    std::vector<DummyTask> tasks(100);
+
+    for (auto& task : tasks)
+    {
+        deque.push(&task);
+    }
+    EXPECT_GE(deque.capacity(), 100);
+
+    for (auto it = tasks.rbegin(); it != tasks.rend(); ++it)
+    {
+        EXPECT_EQ(deque.pop(), &*it);
+    }
+}
+
+TEST(WorkStealingDeque, concurrentSteal)
+{
+    static constexpr std::size_t nbTasks = 100000;
+    simulation::WorkStealingDeque deque(16);
+    std::vector<DummyTask> tasks(nbTasks);
+    std::vector<std::atomic<int> > taken(nbTasks);
+
+    const auto markTaken = [&tasks, &taken](const simulation::Task* task)
+    {
+        taken[static_cast<std::size_t>(static_cast<const DummyTask*>(task) - tasks.data())].fetch_add(1);
+    };
+
+    std::atomic<bool> done { false };
+    std::vector<std::thread> thieves;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        thieves.emplace_back([&]
+        {
+            while (!done.load() || !deque.empty())
+            {
+                if (const auto* task = deque.steal())
+                {
+                    markTaken(task);
+                }
+            }
+        });
+    }
+
+    for (std::size_t i = 0; i < nbTasks; ++i)
+    {
+        deque.push(&tasks[i]);
+        if (i % 3 == 0)
+        {
+            if (const auto* task = deque.pop())
+            {
+                markTaken(task);
+            }
+        }
+    }
+    while (const auto* task = deque.pop())
+    {
+        markTaken(task);
+    }
+    done.store(true);
+
+    for (auto& thief : thieves)
+    {
+        thief.join();
+    }
+
+    for (const auto& t : taken)
+    {
+        EXPECT_EQ(t.load(), 1);
+    }
+}
+
+/// The tests set the task allocator of their scheduler, which is destroyed at the end of the test
+class WorkStealingTaskScheduler_test : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_previousAllocator = simulation::Task::getAllocator();
+    }
+
+    void TearDown() override
+    {
+        simulation::Task::setAllocator(m_previousAllocator);
+    }
+
+private:
+    simulation::Task::Allocator* m_previousAllocator { nullptr };
+};
+
+TEST_F(WorkStealingTaskScheduler_test, registeredInFactory)
+{
+    const auto schedulers = simulation::MainTaskSchedulerFactory::getAvailableSchedulers();
+    EXPECT_NE(schedulers.find(simulation::WorkStealingTaskScheduler::name()), schedulers.end());
+
+    const auto scheduler = makeWorkStealingTaskScheduler();
+    EXPECT_NE(dynamic_cast<const simulation::WorkStealingTaskScheduler*>(scheduler.get()), nullptr);
+}
+
+TEST_F(WorkStealingTaskScheduler_test, IntSumSingle)
+{
+    const auto scheduler = makeWorkStealingTaskScheduler();
+    scheduler->init(1);
+
+    const int64_t N = 1 << 16;
+    EXPECT_EQ(recursiveSum(scheduler.get(), N), N * (N + 1) / 2);
+
+    scheduler->stop();
+}
+
+TEST_F(WorkStealingTaskScheduler_test, IntSumMulti)
+{
+    const auto scheduler = makeWorkStealingTaskScheduler();
+
+    // more threads than the former limit of DefaultTaskScheduler
+    scheduler->init(20);
+    EXPECT_EQ(scheduler->getThreadCount(), 20);
+
+    const int64_t N = 1 << 20;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(recursiveSum(scheduler.get(), N), N * (N + 1) / 2);
+    }
+
+    const auto* workStealing = dynamic_cast<const simulation::WorkStealingTaskScheduler*>(scheduler.get());
+    ASSERT_NE(workStealing, nullptr);
+    const auto executed = workStealing->getExecutedTaskCount();
+    EXPECT_EQ(executed.size(), 20);
+
+    scheduler->stop();
+    EXPECT_EQ(scheduler->getThreadCount(), 1);
+}
+
+TEST_F(WorkStealingTaskScheduler_test, parallelForEachRange)
+{
+    const auto scheduler = makeWorkStealingTaskScheduler();
+    scheduler->init(4);
+
+    std::vector<int> integers(10000);
+    std::iota(integers.begin(), integers.end(), 0);
+
+    simulation::parallelForEachRange(*scheduler, integers.begin(), integers.end(),
+        [](const auto& range)
+        {
+            for (auto it = range.start; it != range.end; ++it)
+            {
+                *it *= 2;
+            }
+        });
+
+    for (std::size_t i = 0; i < integers.size(); ++i)
+    {
+        EXPECT_EQ(integers[i], 2 * static_cast<int>(i));
+    }
+
+    scheduler->stop();
+}
+
+TEST_F(WorkStealingTaskScheduler_test, Lambda)
+{
+    const auto scheduler = makeWorkStealingTaskScheduler();
+    scheduler->init(2);
+
+    std::atomic<unsigned int> counter { 0u };
+
+    simulation::CpuTaskStatus status;
+    for (unsigned int i = 0; i < 100; ++i)
+    {
+        scheduler->addTask(status, [&counter]{ ++counter; });
+    }
+
+    scheduler->workUntilDone(&status);
+    scheduler->stop();
+
+    EXPECT_EQ(counter.load(), 100u);
+}
+
+}
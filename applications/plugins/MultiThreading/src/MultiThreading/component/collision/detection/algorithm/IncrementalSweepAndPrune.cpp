@@ -0,0 +1,139 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <MultiThreading/component/collision/detection/algorithm/IncrementalSweepAndPrune.h>
+
+#include <algorithm>
+
+namespace multithreading::component::collision::detection::algorithm
+{
+
+void IncrementalSweepAndPrune::resize(std::size_t nbBoxes)
+{
+    if (nbBoxes != size())
+    {
+        m_hasPreviousOrder.fill(false);
+    }
+    m_bounds.resize(2 * nbBoxes);
+}
+
+void IncrementalSweepAndPrune::setBox(Index i, const sofa::type::Vec3& min, const sofa::type::Vec3& max)
+{
+    m_bounds[2 * i] = min;
+    m_bounds[2 * i + 1] = max;
+}
+
+void IncrementalSweepAndPrune::sort()
+{
+    m_sweepAxis = computeSweepAxis();
+    sortAxis(m_sweepAxis);
+}
+
+unsigned int IncrementalSweepAndPrune::computeSweepAxis() const
+{
+    const std::size_t nbBoxes = size();
+
+    // the axis on which the centers of the boxes are the most spread leads to the least overlaps
+    sofa::type::Vec3 sum, sum2;
+    for (std::size_t i = 0; i < nbBoxes; ++i)
+    {
+        const sofa::type::Vec3 center = (m_bounds[2 * i] + m_bounds[2 * i + 1]) * 0.5;
+        sum += center;
+        sum2 += center.linearProduct(center);
+    }
+
+    unsigned int sweepAxis = 0;
+    SReal maxVariance = -1;
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+        const SReal variance = sum2[axis] - sum[axis] * sum[axis] / std::max<SReal>(1, static_cast<SReal>(nbBoxes));
+        if (variance > maxVariance)
+        {
+            maxVariance = variance;
+            sweepAxis = axis;
+        }
+    }
+    return sweepAxis;
+}
+
+void IncrementalSweepAndPrune::sortAxis(unsigned int axis)
+{
+    auto& endPoints = m_endPoints[axis];
+    if (!m_hasPreviousOrder[axis])
+    {
+        const auto nbBoxes = static_cast<Index>(size());
+        endPoints.resize(2 * nbBoxes);
+        for (Index i = 0; i < nbBoxes; ++i)
+        {
+            endPoints[2 * i].data = i << 1;
+            endPoints[2 * i + 1].data = (i << 1) | 1;
+        }
+    }
+
+    for (EndPoint& endPoint : endPoints)
+    {
+        endPoint.value = m_bounds[endPoint.data][axis];
+    }
+
+    std::size_t swapCount = 0;
+    if (m_hasPreviousOrder[axis])
+    {
+        // insertion sort: linear if the order did not change since the previous call
+        for (std::size_t i = 1; i < endPoints.size(); ++i)
+        {
+            const EndPoint endPoint = endPoints[i];
+            std::size_t j = i;
+            while (j > 0 && endPoint < endPoints[j - 1])
+            {
+                endPoints[j] = endPoints[j - 1];
+                --j;
+            }
+            swapCount += i - j;
+            endPoints[j] = endPoint;
+        }
+    }
+    else
+    {
+        std::sort(endPoints.begin(), endPoints.end());
+    }
+    m_swapCount = swapCount;
+    m_hasPreviousOrder[axis] = true;
+}
+
+void IncrementalSweepAndPrune::prepareSweep()
+{
+    const unsigned int axis0 = m_sweepAxis;
+    const unsigned int axis1 = (m_sweepAxis + 1) % 3;
+    const unsigned int axis2 = (m_sweepAxis + 2) % 3;
+
+    m_proxies.clear();
+    for (const EndPoint& endPoint : m_endPoints[m_sweepAxis])
+    {
+        if (!endPoint.isMax())
+        {
+            const sofa::type::Vec3& min = m_bounds[endPoint.data];
+            const sofa::type::Vec3& max = m_bounds[endPoint.data + 1];
+            m_proxies.push_back({ min[axis0], max[axis0], min[axis1], max[axis1], min[axis2], max[axis2], endPoint.box() });
+        }
+    }
+}
+
+}
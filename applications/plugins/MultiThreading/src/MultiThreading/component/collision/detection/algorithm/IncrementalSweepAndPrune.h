@@ -0,0 +1,196 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <MultiThreading/config.h>
+
+#include <sofa/simulation/ParallelForEach.h>
+#include <sofa/type/Vec.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace multithreading::component::collision::detection::algorithm
+{
+
+/**
+ * @brief Sweep and prune on axis-aligned bounding boxes, reusing the order of the previous call
+ *
+ * The overlapping pairs are found by sweeping the axis on which the centers of the boxes are the
+ * most spread. Only the endpoints of this axis are sorted: the overlaps on the two other axes are
+ * tested on the boxes themselves. The endpoints of each axis keep their order between two calls.
+ * With temporal coherence, the order changes little from one time step to the next and the
+ * insertion sort of the endpoints is close to linear. If the swept axis changes, its endpoints
+ * are sorted starting from the order of the last call which swept it.
+ *
+ * The boxes are copied contiguously in the order of the sweep, which is split into ranges
+ * processed in parallel, each range writing in its own buffer of pairs. The buffers keep their
+ * memory from one call to the next.
+ */
+class SOFA_MULTITHREADING_PLUGIN_API IncrementalSweepAndPrune
+{
+public:
+    using Index = std::uint32_t;
+    using IndexPair = std::pair<Index, Index>;
+
+    /// Set the number of boxes. If it changes, the endpoints are sorted from scratch by the next
+    /// call to sort().
+    void resize(std::size_t nbBoxes);
+
+    std::size_t size() const { return m_bounds.size() / 2; }
+
+    void setBox(Index i, const sofa::type::Vec3& min, const sofa::type::Vec3& max);
+
+    /// Choose the axis to sweep, and sort the endpoints of the boxes on this axis, starting from
+    /// the order of the previous call
+    void sort();
+
+    /**
+     * Find the pairs of overlapping boxes. sort() must have been called before.
+     *
+     * @param filter A function object called concurrently on each pair of overlapping boxes
+     * (i, j), with the signature bool(Index& i, Index& j). The pair is kept if it returns true.
+     * The filter may swap i and j to change the order of the stored pair.
+     */
+    template<class Filter>
+    void findOverlappingPairs(sofa::simulation::TaskScheduler& taskScheduler, Filter filter);
+
+    /// Pairs found by the last call to findOverlappingPairs, stored per range of boxes
+    const std::vector<std::vector<IndexPair> >& getPairs() const { return m_pairs; }
+
+    /// Number of endpoint swaps performed by the last call to sort()
+    std::size_t getSwapCount() const { return m_swapCount; }
+
+    /// Axis sorted by the last call to sort(), and swept by findOverlappingPairs
+    unsigned int getSweepAxis() const { return m_sweepAxis; }
+
+protected:
+
+    struct EndPoint
+    {
+        SReal value;
+
+        /// index of the box, shifted by one bit. The lowest bit is set for a max endpoint. It is
+        /// also the index of the endpoint in m_bounds.
+        Index data;
+
+        Index box() const { return data >> 1; }
+        bool isMax() const { return data & 1; }
+
+        /// At equal values, a min endpoint is placed before a max endpoint, so that touching boxes
+        /// overlap
+        bool operator<(const EndPoint& other) const
+        {
+            return value < other.value || (value == other.value && !isMax() && other.isMax());
+        }
+    };
+
+    /// Choose the axis on which the centers of the boxes are the most spread
+    unsigned int computeSweepAxis() const;
+
+    /// Update the values of the endpoints of an axis, and sort them
+    void sortAxis(unsigned int axis);
+
+    /// Gather the boxes in the order of their min endpoint on the swept axis
+    void prepareSweep();
+
+    /// Copy of a box, stored contiguously in the order of the sweep. The coordinates are permuted
+    /// so that the swept axis comes first.
+    struct Proxy
+    {
+        SReal min0, max0;
+        SReal min1, max1;
+        SReal min2, max2;
+        Index box;
+    };
+
+    /// min and max of each box, interleaved
+    std::vector<sofa::type::Vec3> m_bounds;
+
+    std::array<std::vector<EndPoint>, 3> m_endPoints;
+    std::size_t m_swapCount { 0 };
+
+    /// true for an axis if its endpoints are sorted from a previous call with the same number of
+    /// boxes
+    std::array<bool, 3> m_hasPreviousOrder {};
+
+    unsigned int m_sweepAxis { 0 };
+
+    /// boxes sorted by their min endpoint on the swept axis
+    std::vector<Proxy> m_proxies;
+
+    std::vector<std::vector<IndexPair> > m_pairs;
+};
+
+template<class Filter>
+void IncrementalSweepAndPrune::findOverlappingPairs(sofa::simulation::TaskScheduler& taskScheduler, Filter filter)
+{
+    prepareSweep();
+
+    const auto nbBoxes = static_cast<Index>(m_proxies.size());
+
+    // more ranges than threads to balance the load, as the number of overlaps varies along the axis
+    const auto ranges = sofa::simulation::makeRangesForLoop(Index{ 0 }, nbBoxes, 4 * taskScheduler.getThreadCount());
+
+    if (m_pairs.size() < ranges.size())
+    {
+        m_pairs.resize(ranges.size());
+    }
+    for (auto& pairs : m_pairs)
+    {
+        pairs.clear();
+    }
+
+    sofa::simulation::CpuTaskStatus status;
+    for (std::size_t r = 0; r < ranges.size(); ++r)
+    {
+        taskScheduler.addTask(status, [this, &ranges, &filter, r, nbBoxes]()
+        {
+            auto& pairs = m_pairs[r];
+            for (Index k = ranges[r].start; k < ranges[r].end; ++k)
+            {
+                const Proxy& a = m_proxies[k];
+
+                // the boxes starting between the min and the max of the box a on the swept axis
+                for (Index l = k + 1; l < nbBoxes && m_proxies[l].min0 <= a.max0; ++l)
+                {
+                    const Proxy& b = m_proxies[l];
+
+                    // non-short-circuit operators: the result is rarely true and hard to predict
+                    if ((a.min1 <= b.max1) & (b.min1 <= a.max1) & (a.min2 <= b.max2) & (b.min2 <= a.max2))
+                    {
+                        Index first = a.box;
+                        Index second = b.box;
+                        if (filter(first, second))
+                        {
+                            pairs.emplace_back(first, second);
+                        }
+                    }
+                }
+            }
+        });
+    }
+    taskScheduler.workUntilDone(&status);
+}
+
+}
@@ -29,6 +29,11 @@
 #include <sofa/core/topology/BaseMeshTopology.h>
 #include <sofa/simulation/MainTaskSchedulerFactory.h>
 #include <MultiThreading/ParallelImplementationsRegistry.h>
+#include <sofa/component/collision/detection/algorithm/MirrorIntersector.h>
+
+#include <deque>
+#include <queue>
+#include <stack>
 
 namespace multithreading::component::collision::detection::algorithm
 {
@@ -43,8 +48,25 @@ int ParallelBVHNarrowPhaseClass = sofa::core::RegisterObject("Narrow phase colli
         .add< ParallelBVHNarrowPhase >()
 ;
 
+namespace
+{
+/// Number of pairs of subtrees per thread when a pair of collision models is split. The subtrees can be very uneven:
+/// more tasks than threads balance the load.
+constexpr std::size_t nbSubtreesPerThread = 4;
+}
+
 ParallelBVHNarrowPhase::ParallelBVHNarrowPhase()
-{}
+    : d_splitLargePairs(initData(&d_splitLargePairs, false, "splitLargePairs",
+        "If true, the traversal of the hierarchies of a pair of large collision models is split into several tasks, "
+        "each of them writing its contacts in its own output. Otherwise, each pair of collision models is processed in a single task."))
+    , d_minElementsToSplit(initData(&d_minElementsToSplit, 5000u, "minElementsToSplit",
+        "Minimum number of elements in both finest collision models of a pair to split its traversal into several tasks"))
+    , d_nbSplitPairs(initData(&d_nbSplitPairs, 0u, "nbSplitPairs",
+        "OUTPUT: number of pairs of collision models split into several tasks during the last narrow phase"))
+{
+    d_nbSplitPairs.setReadOnly(true);
+    d_nbSplitPairs.setGroup("Stats");
+}
 
 void ParallelBVHNarrowPhase::init()
 {
@@ -60,6 +82,7 @@ void ParallelBVHNarrowPhase::addCollisionPairs(const sofa::type::vector< std::pa
 
     if (v.empty())
     {
+        d_nbSplitPairs.setValue(0);
         return;
     }
 
@@ -69,14 +92,35 @@ void ParallelBVHNarrowPhase::addCollisionPairs(const sofa::type::vector< std::pa
     sofa::simulation::CpuTask::Status status;
     const auto nbPairs = static_cast<unsigned int>(v.size());
     m_tasks.reserve(nbPairs);
+    m_splitPairs.reserve(nbPairs); // the tasks refer to the elements of m_splitPairs
 
     {
         SCOPED_TIMER_VARNAME(createTasksTimer, "TasksCreation");
         for (const auto &pair : v)
         {
+            if (isLargePair(pair))
+            {
+                if (splitPair(pair, m_splitPairs.emplace_back()))
+                {
+                    continue;
+                }
+                m_splitPairs.pop_back();
+            }
+
             m_tasks.emplace_back(&status, this, pair);
             m_taskScheduler->addTask(&m_tasks.back());
         }
+
+        for (auto& split : m_splitPairs)
+        {
+            for (std::size_t i = 0; i < split.taskOutputs.size(); ++i)
+            {
+                m_taskScheduler->addTask(status, [this, &split, i]()
+                {
+                    traverseSubtrees(split, split.subtreesBegin[i], split.subtreesBegin[i + 1], split.taskOutputs[i]);
+                });
+            }
+        }
     }
 
     {
@@ -84,7 +128,18 @@ void ParallelBVHNarrowPhase::addCollisionPairs(const sofa::type::vector< std::pa
         m_taskScheduler->workUntilDone(&status);
     }
 
+    {
+        SCOPED_TIMER_VARNAME(mergeTimer, "MergeOutputs");
+        for (auto& split : m_splitPairs)
+        {
+            mergeOutputs(split);
+        }
+    }
+
+    d_nbSplitPairs.setValue(static_cast<unsigned int>(m_splitPairs.size()));
+
     m_tasks.clear();
+    m_splitPairs.clear();
 
     // m_outputsMap should just be filled in addCollisionPair function
     m_primitiveTestCount = m_outputsMap.size();
@@ -150,6 +205,179 @@ void ParallelBVHNarrowPhase::initializeTopology(sofa::core::topology::BaseMeshTo
     }
 }
 
+bool ParallelBVHNarrowPhase::isLargePair(const std::pair<sofa::core::CollisionModel*, sofa::core::CollisionModel*>& pair) const
+{
+    if (!d_splitLargePairs.getValue())
+    {
+        return false;
+    }
+
+    const auto minElements = d_minElementsToSplit.getValue();
+    return pair.first->getLast()->getSize() >= minElements && pair.second->getLast()->getSize() >= minElements;
+}
+
+bool ParallelBVHNarrowPhase::splitPair(
+        const std::pair<sofa::core::CollisionModel*, sofa::core::CollisionModel*>& pair, SplitPair& split)
+{
+    sofa::core::CollisionModel *cm1 = pair.first;
+    sofa::core::CollisionModel *cm2 = pair.second;
+
+    if ((!cm1->isSimulated() && !cm2->isSimulated()) || cm1->empty() || cm2->empty())
+        return false;
+
+    sofa::core::CollisionModel *finestCollisionModel1 = cm1->getLast();
+    sofa::core::CollisionModel *finestCollisionModel2 = cm2->getLast();
+
+    // the roots also contain the finest elements: there is no hierarchy to split
+    if (finestCollisionModel1 == cm1 || finestCollisionModel2 == cm2)
+        return false;
+
+    bool swapModels = false;
+    sofa::core::collision::ElementIntersector *finestIntersector = intersectionMethod->findIntersector(
+            finestCollisionModel1, finestCollisionModel2, swapModels);
+    if (finestIntersector == nullptr)
+        return false;
+    if (swapModels)
+    {
+        std::swap(cm1, cm2);
+        std::swap(finestCollisionModel1, finestCollisionModel2);
+    }
+
+    bool swapCoarseModels = false;
+    sofa::core::collision::ElementIntersector *coarseIntersector = intersectionMethod->findIntersector(cm1, cm2, swapCoarseModels);
+    if (coarseIntersector == nullptr)
+        return false;
+    sofa::component::collision::detection::algorithm::MirrorIntersector mirror;
+    if (swapCoarseModels)
+    {
+        mirror.intersector = coarseIntersector;
+        coarseIntersector = &mirror;
+    }
+
+    sofa::core::collision::DetectionOutputVector*& outputs = this->getDetectionOutputs(finestCollisionModel1, finestCollisionModel2);
+    finestIntersector->beginIntersect(finestCollisionModel1, finestCollisionModel2, outputs);
+
+    // the outputs of the tasks are appended to the output of the pair: check it is supported by this type of output
+    sofa::core::collision::DetectionOutputVector* firstTaskOutputs = nullptr;
+    finestIntersector->beginIntersect(finestCollisionModel1, finestCollisionModel2, firstTaskOutputs);
+    if (outputs == nullptr || firstTaskOutputs == nullptr || !outputs->append(firstTaskOutputs))
+    {
+        if (firstTaskOutputs)
+        {
+            firstTaskOutputs->release();
+        }
+        return false;
+    }
+
+    split.finest = {finestCollisionModel1, finestCollisionModel2, finestIntersector, isSelfCollision(finestCollisionModel1, finestCollisionModel2)};
+    split.outputs = outputs;
+
+    const std::size_t nbTargetSubtrees = nbSubtreesPerThread * std::max<std::size_t>(1, m_taskScheduler->getThreadCount());
+
+    std::queue<TestPair> externalCells;
+    initializeExternalCells(cm1, cm2, externalCells);
+
+    // Only the pair of internal children of the roots, and its descendants, are expanded. The traversal of the other
+    // pairs requires other intersectors, and is left to the tasks.
+    const TestPair rootInternalChildren(cm1->begin().getInternalChildren(), cm2->begin().getInternalChildren());
+
+    std::deque<TestPair> subtrees;
+    for (; !externalCells.empty(); externalCells.pop())
+    {
+        if (externalCells.front() == rootInternalChildren)
+        {
+            subtrees.push_back(externalCells.front());
+        }
+        else
+        {
+            split.subtrees.push_back(externalCells.front());
+        }
+    }
+
+    // Breadth-first traversal of the top of the hierarchies, until there are enough pairs of subtrees
+    std::stack<TestPair> children;
+    while (!subtrees.empty() && split.subtrees.size() + subtrees.size() < nbTargetSubtrees)
+    {
+        TestPair subtree = std::move(subtrees.front());
+        subtrees.pop_front();
+
+        // the intersections between the finest elements are left to the tasks
+        if (getCollisionModelsFromTestPair(subtree) == std::make_pair(finestCollisionModel1, finestCollisionModel2))
+        {
+            split.subtrees.push_back(std::move(subtree));
+            continue;
+        }
+
+        processInternalCell(subtree, coarseIntersector, split.finest, externalCells, children, outputs, intersectionMethod);
+
+        for (; !children.empty(); children.pop())
+        {
+            subtrees.push_back(children.top());
+        }
+        for (; !externalCells.empty(); externalCells.pop())
+        {
+            split.subtrees.push_back(externalCells.front());
+        }
+    }
+    split.subtrees.insert(split.subtrees.end(), subtrees.begin(), subtrees.end());
+
+    // Contiguous ranges of pairs of subtrees are distributed among the tasks
+    const std::size_t nbTasks = std::min(split.subtrees.size(), nbTargetSubtrees);
+    split.subtreesBegin.resize(nbTasks + 1);
+    for (std::size_t i = 0; i <= nbTasks; ++i)
+    {
+        split.subtreesBegin[i] = i * split.subtrees.size() / std::max<std::size_t>(1, nbTasks);
+    }
+
+    split.taskOutputs.assign(nbTasks, nullptr);
+    if (nbTasks == 0)
+    {
+        firstTaskOutputs->release();
+        return true;
+    }
+
+    split.taskOutputs[0] = firstTaskOutputs;
+    for (std::size_t i = 1; i < nbTasks; ++i)
+    {
+        finestIntersector->beginIntersect(finestCollisionModel1, finestCollisionModel2, split.taskOutputs[i]);
+    }
+
+    return true;
+}
+
+void ParallelBVHNarrowPhase::traverseSubtrees(const SplitPair& split, const std::size_t begin, const std::size_t end,
+                                              sofa::core::collision::DetectionOutputVector*& outputs) const
+{
+    std::queue<TestPair> externalCells;
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        externalCells.push(split.subtrees[i]);
+    }
+
+    sofa::core::CollisionModel* cm1 = nullptr;
+    sofa::core::CollisionModel* cm2 = nullptr;
+    sofa::core::collision::ElementIntersector* intersector = nullptr;
+    sofa::component::collision::detection::algorithm::MirrorIntersector mirror;
+
+    while (!externalCells.empty())
+    {
+        TestPair root = externalCells.front();
+        externalCells.pop();
+
+        processExternalCell(root, cm1, cm2, intersector, split.finest, &mirror, externalCells, outputs);
+    }
+}
+
+void ParallelBVHNarrowPhase::mergeOutputs(SplitPair& split)
+{
+    for (auto*& taskOutputs : split.taskOutputs)
+    {
+        split.outputs->append(taskOutputs);
+        taskOutputs->release();
+        taskOutputs = nullptr;
+    }
+}
+
 ParallelBVHNarrowPhasePairTask::ParallelBVHNarrowPhasePairTask(
         sofa::simulation::CpuTask::Status* status,
         ParallelBVHNarrowPhase* bvhNarrowPhase,
@@ -33,6 +33,15 @@ namespace multithreading::component::collision::detection::algorithm
 
 class ParallelBVHNarrowPhasePairTask;
 
+/**
+ * @brief Parallel version of BVHNarrowPhase
+ *
+ * Each pair of collision models is processed in its own task. Optionally, the pairs made of large collision models
+ * are split into several tasks: the top of both hierarchies is traversed sequentially until enough independent pairs
+ * of subtrees are found. The pairs of subtrees are then traversed concurrently, each task writing its contacts in its
+ * own output vector. The outputs are appended to the output of the pair of collision models once all tasks are done,
+ * always in the same order.
+ */
 class SOFA_MULTITHREADING_PLUGIN_API ParallelBVHNarrowPhase :
     public sofa::component::collision::detection::algorithm::BVHNarrowPhase,
     public TaskSchedulerUser
@@ -40,11 +49,33 @@ class SOFA_MULTITHREADING_PLUGIN_API ParallelBVHNarrowPhase :
 public:
     SOFA_CLASS(ParallelBVHNarrowPhase, sofa::component::collision::detection::algorithm::BVHNarrowPhase);
 
+    sofa::Data<bool> d_splitLargePairs; ///< If true, the pairs of large collision models are split into several tasks
+    sofa::Data<unsigned int> d_minElementsToSplit; ///< Minimum number of elements in both finest collision models of a pair to split it into several tasks
+    sofa::Data<unsigned int> d_nbSplitPairs; ///< OUTPUT: number of pairs of collision models split into several tasks during the last narrow phase
+
 protected:
     ParallelBVHNarrowPhase();
 
     std::vector<ParallelBVHNarrowPhasePairTask> m_tasks;
 
+    /// Pair of collision models whose traversal is split into independent pairs of subtrees
+    struct SplitPair
+    {
+        FinestCollision finest;
+
+        /// Output of the pair of collision models
+        sofa::core::collision::DetectionOutputVector* outputs { nullptr };
+
+        /// Pairs of subtrees, traversed concurrently
+        std::vector<TestPair> subtrees;
+
+        /// One output per task. The range of subtrees of a task i starts at subtreesBegin[i] and ends at subtreesBegin[i+1].
+        std::vector<sofa::core::collision::DetectionOutputVector*> taskOutputs;
+        std::vector<std::size_t> subtreesBegin;
+    };
+
+    std::vector<SplitPair> m_splitPairs;
+
     std::unordered_set< sofa::core::topology::BaseMeshTopology* > m_initializedTopology;
     std::set< std::pair<sofa::core::CollisionModel*, sofa::core::CollisionModel*> > m_initializedPairs;
 
@@ -61,6 +92,21 @@ private:
 
     /// This function makes sure some topology arrays are initialized. They cannot be initialized concurrently
     void initializeTopology(sofa::core::topology::BaseMeshTopology*);
+
+    bool isLargePair(const std::pair<sofa::core::CollisionModel*, sofa::core::CollisionModel*>& pair) const;
+
+    /// Traverse sequentially the top of the hierarchies of a pair of collision models, until enough independent pairs
+    /// of subtrees are found to feed the threads. The contacts found during this traversal are written in the output
+    /// of the pair.
+    /// Return false if the pair cannot be split. It is then processed as a single task.
+    bool splitPair(const std::pair<sofa::core::CollisionModel*, sofa::core::CollisionModel*>& pair, SplitPair& split);
+
+    /// Traverse a range of pairs of subtrees and write the contacts in the provided output
+    void traverseSubtrees(const SplitPair& split, std::size_t begin, std::size_t end,
+                          sofa::core::collision::DetectionOutputVector*& outputs) const;
+
+    /// Append the outputs of the tasks to the output of the pair of collision models
+    static void mergeOutputs(SplitPair& split);
 };
 
 class SOFA_MULTITHREADING_PLUGIN_API ParallelBVHNarrowPhasePairTask : public sofa::simulation::CpuTask
@@ -0,0 +1,193 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <MultiThreading/component/collision/detection/algorithm/ParallelSweepAndPruneBroadPhase.h>
+
+#include <sofa/component/collision/geometry/CubeModel.h>
+#include <sofa/core/ObjectFactory.h>
+#include <sofa/core/collision/Intersection.h>
+#include <sofa/helper/ScopedAdvancedTimer.h>
+
+namespace multithreading::component::collision::detection::algorithm
+{
+
+int ParallelSweepAndPruneBroadPhaseClass = sofa::core::RegisterObject("Broad phase collision detection using an incremental sweep and prune performed in parallel")
+        .add< ParallelSweepAndPruneBroadPhase >()
+;
+
+ParallelSweepAndPruneBroadPhase::ParallelSweepAndPruneBroadPhase()
+    : BruteForceBroadPhase()
+{}
+
+void ParallelSweepAndPruneBroadPhase::init()
+{
+    BruteForceBroadPhase::init();
+
+    // initialize the thread pool
+    this->initTaskScheduler();
+}
+
+void ParallelSweepAndPruneBroadPhase::addCollisionModel(sofa::core::CollisionModel *cm)
+{
+    if (cm == nullptr || cm->empty())
+        return;
+
+    assert(intersectionMethod != nullptr);
+
+    if (boxModel && !intersectWithBoxModel(cm))
+    {
+        return;
+    }
+
+    if (doesSelfCollide(cm))
+    {
+        // add the collision model to be tested against itself
+        cmPairs.emplace_back(cm, cm);
+    }
+
+    if (dynamic_cast<sofa::component::collision::geometry::CubeCollisionModel*>(cm))
+    {
+        m_collisionModels.emplace_back(cm, cm->getLast());
+    }
+    else
+    {
+        m_unboundedCollisionModels.emplace_back(cm, cm->getLast());
+    }
+}
+
+void ParallelSweepAndPruneBroadPhase::addCollisionModels(const sofa::type::vector<sofa::core::CollisionModel *>& v)
+{
+    SCOPED_TIMER("ParallelSweepAndPruneBroadPhase::addCollisionModels");
+
+    m_unboundedCollisionModels.clear();
+    BroadPhaseDetection::addCollisionModels(v);
+
+    using Index = IncrementalSweepAndPrune::Index;
+    using sofa::component::collision::geometry::Cube;
+    using sofa::component::collision::geometry::CubeCollisionModel;
+
+    {
+        SCOPED_TIMER_VARNAME(sortTimer, "SortEndPoints");
+
+        // the boxes are extended by the alarm distance, so that the boxes overlap if the cubes can intersect
+        const SReal alarmDistance = intersectionMethod->getAlarmDistance();
+        const sofa::type::Vec3 margin(alarmDistance, alarmDistance, alarmDistance);
+
+        m_sweepAndPrune.resize(m_collisionModels.size());
+        for (Index i = 0; i < static_cast<Index>(m_collisionModels.size()); ++i)
+        {
+            const Cube cube(static_cast<CubeCollisionModel*>(m_collisionModels[i].firstCollisionModel), 0);
+            m_sweepAndPrune.setBox(i, cube.minVect(), cube.maxVect() + margin);
+        }
+
+        m_sweepAndPrune.sort();
+    }
+
+    {
+        SCOPED_TIMER_VARNAME(sweepTimer, "Sweep");
+        m_sweepAndPrune.findOverlappingPairs(*m_taskScheduler, [this](Index& i, Index& j)
+        {
+            bool swapModels = false;
+            if (!canIntersect(m_collisionModels[i], m_collisionModels[j], swapModels))
+            {
+                return false;
+            }
+            if (swapModels)
+            {
+                std::swap(i, j);
+            }
+            return true;
+        });
+    }
+
+    for (const auto& pairs : m_sweepAndPrune.getPairs())
+    {
+        for (const auto& [i, j] : pairs)
+        {
+            cmPairs.emplace_back(m_collisionModels[i].firstCollisionModel, m_collisionModels[j].firstCollisionModel);
+        }
+    }
+
+    // the collision models without bounding box are tested against all the others
+    for (std::size_t u = 0; u < m_unboundedCollisionModels.size(); ++u)
+    {
+        const auto& unbounded = m_unboundedCollisionModels[u];
+
+        const auto testPair = [this, &unbounded](const FirstLastCollisionModel& other)
+        {
+            bool swapModels = false;
+            if (canIntersect(unbounded, other, swapModels))
+            {
+                if (swapModels)
+                {
+                    cmPairs.emplace_back(other.firstCollisionModel, unbounded.firstCollisionModel);
+                }
+                else
+                {
+                    cmPairs.emplace_back(unbounded.firstCollisionModel, other.firstCollisionModel);
+                }
+            }
+        };
+
+        for (const auto& model : m_collisionModels)
+        {
+            testPair(model);
+        }
+        for (std::size_t k = 0; k < u; ++k)
+        {
+            testPair(m_unboundedCollisionModels[k]);
+        }
+    }
+}
+
+bool ParallelSweepAndPruneBroadPhase::canIntersect(const FirstLastCollisionModel& a, const FirstLastCollisionModel& b, bool& swapModels) const
+{
+    auto* cm1 = a.firstCollisionModel;
+    auto* cm2 = b.firstCollisionModel;
+
+    // ignore this pair if both are NOT simulated (inactive)
+    if (!cm1->isSimulated() && !cm2->isSimulated())
+    {
+        return false;
+    }
+
+    if (!keepCollisionBetween(a.lastCollisionModel, b.lastCollisionModel))
+    {
+        return false;
+    }
+
+    swapModels = false;
+    sofa::core::collision::ElementIntersector* intersector = intersectionMethod->findIntersector(cm1, cm2, swapModels);
+    if (intersector == nullptr)
+    {
+        return false;
+    }
+
+    if (swapModels)
+    {
+        std::swap(cm1, cm2);
+    }
+
+    // Here we assume a single root element is present in both models
+    return intersector->canIntersect(cm1->begin(), cm2->begin(), intersectionMethod);
+}
+
+}
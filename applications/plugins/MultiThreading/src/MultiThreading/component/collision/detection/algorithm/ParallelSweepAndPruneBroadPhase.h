@@ -0,0 +1,72 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <MultiThreading/config.h>
+#include <MultiThreading/TaskSchedulerUser.h>
+#include <MultiThreading/component/collision/detection/algorithm/IncrementalSweepAndPrune.h>
+
+#include <sofa/component/collision/detection/algorithm/BruteForceBroadPhase.h>
+
+namespace multithreading::component::collision::detection::algorithm
+{
+
+/**
+ * @brief A parallel broad phase based on an incremental sweep and prune
+ *
+ * The bounding boxes of the collision models are sorted on the axis where they are the most spread,
+ * starting from the order of the previous time step (see IncrementalSweepAndPrune). The candidate pairs are then filtered in
+ * parallel with the same tests as BruteForceBroadPhase, so that both components output the same
+ * pairs.
+ *
+ * The bounding box of a collision model is taken from the root of its bounding tree, which must be
+ * a CubeCollisionModel. The other collision models are tested against all the others.
+ */
+class SOFA_MULTITHREADING_PLUGIN_API ParallelSweepAndPruneBroadPhase :
+    public sofa::component::collision::detection::algorithm::BruteForceBroadPhase,
+    public TaskSchedulerUser
+{
+public:
+    SOFA_CLASS(ParallelSweepAndPruneBroadPhase, sofa::component::collision::detection::algorithm::BruteForceBroadPhase);
+
+    void init() override;
+
+    void addCollisionModel(sofa::core::CollisionModel *cm) override;
+    void addCollisionModels(const sofa::type::vector<sofa::core::CollisionModel *>& v) override;
+
+protected:
+    ParallelSweepAndPruneBroadPhase();
+    ~ParallelSweepAndPruneBroadPhase() override = default;
+
+    /// Same tests as BruteForceBroadPhase on a pair of collision models. swapModels is set to true
+    /// if the models must be swapped in the output pair.
+    bool canIntersect(const FirstLastCollisionModel& a, const FirstLastCollisionModel& b, bool& swapModels) const;
+
+    /// Collision models without a CubeCollisionModel as bounding volume
+    sofa::type::vector<FirstLastCollisionModel> m_unboundedCollisionModels;
+
+    /// Sorted endpoints of the bounding boxes of m_collisionModels, kept from one time step to
+    /// the next
+    IncrementalSweepAndPrune m_sweepAndPrune;
+};
+
+}
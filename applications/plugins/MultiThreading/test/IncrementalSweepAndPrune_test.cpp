@@ -0,0 +1,190 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <MultiThreading/component/collision/detection/algorithm/IncrementalSweepAndPrune.h>
+
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/TaskScheduler.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+
+namespace multithreading
+{
+
+using component::collision::detection::algorithm::IncrementalSweepAndPrune;
+
+namespace
+{
+
+struct Boxes
+{
+    std::vector<sofa::type::Vec3> min;
+    std::vector<sofa::type::Vec3> max;
+};
+
+Boxes randomBoxes(std::size_t nbBoxes, std::mt19937& generator)
+{
+    std::uniform_real_distribution<SReal> position(0, 10);
+    std::uniform_real_distribution<SReal> size(0, 1);
+
+    Boxes boxes;
+    for (std::size_t i = 0; i < nbBoxes; ++i)
+    {
+        const sofa::type::Vec3 min(position(generator), position(generator), position(generator));
+        boxes.min.push_back(min);
+        boxes.max.push_back(min + sofa::type::Vec3(size(generator), size(generator), size(generator)));
+    }
+    return boxes;
+}
+
+std::set<std::pair<IncrementalSweepAndPrune::Index, IncrementalSweepAndPrune::Index> > bruteForcePairs(const Boxes& boxes)
+{
+    std::set<std::pair<IncrementalSweepAndPrune::Index, IncrementalSweepAndPrune::Index> > pairs;
+    for (IncrementalSweepAndPrune::Index i = 0; i < boxes.min.size(); ++i)
+    {
+        for (IncrementalSweepAndPrune::Index j = i + 1; j < boxes.min.size(); ++j)
+        {
+            bool overlap = true;
+            for (unsigned int axis = 0; axis < 3; ++axis)
+            {
+                overlap = overlap && boxes.min[i][axis] <= boxes.max[j][axis] && boxes.min[j][axis] <= boxes.max[i][axis];
+            }
+            if (overlap)
+            {
+                pairs.emplace(i, j);
+            }
+        }
+    }
+    return pairs;
+}
+
+std::set<std::pair<IncrementalSweepAndPrune::Index, IncrementalSweepAndPrune::Index> > sweepAndPrunePairs(
+    IncrementalSweepAndPrune& sweepAndPrune, const Boxes& boxes, sofa::simulation::TaskScheduler& taskScheduler)
+{
+    sweepAndPrune.resize(boxes.min.size());
+    for (IncrementalSweepAndPrune::Index i = 0; i < boxes.min.size(); ++i)
+    {
+        sweepAndPrune.setBox(i, boxes.min[i], boxes.max[i]);
+    }
+    sweepAndPrune.sort();
+    sweepAndPrune.findOverlappingPairs(taskScheduler, [](auto&, auto&) { return true; });
+
+    std::set<std::pair<IncrementalSweepAndPrune::Index, IncrementalSweepAndPrune::Index> > pairs;
+    for (const auto& rangePairs : sweepAndPrune.getPairs())
+    {
+        for (const auto& [i, j] : rangePairs)
+        {
+            const bool inserted = pairs.emplace(std::min(i, j), std::max(i, j)).second;
+            EXPECT_TRUE(inserted) << "pair " << i << " " << j << " found twice";
+        }
+    }
+    return pairs;
+}
+
+}
+
+TEST(IncrementalSweepAndPrune, sameAsBruteForce)
+{
+    auto* taskScheduler = sofa::simulation::MainTaskSchedulerFactory::createInRegistry();
+    taskScheduler->init(4);
+
+    std::mt19937 generator(42);
+    Boxes boxes = randomBoxes(500, generator);
+
+    IncrementalSweepAndPrune sweepAndPrune;
+
+    std::normal_distribution<SReal> displacement(0, 0.05);
+    for (unsigned int step = 0; step < 10; ++step)
+    {
+        EXPECT_EQ(sweepAndPrunePairs(sweepAndPrune, boxes, *taskScheduler), bruteForcePairs(boxes));
+
+        // small displacements between two steps
+        for (std::size_t i = 0; i < boxes.min.size(); ++i)
+        {
+            const sofa::type::Vec3 d(displacement(generator), displacement(generator), displacement(generator));
+            boxes.min[i] += d;
+            boxes.max[i] += d;
+        }
+    }
+
+    // a change in the number of boxes
+    boxes = randomBoxes(300, generator);
+    EXPECT_EQ(sweepAndPrunePairs(sweepAndPrune, boxes, *taskScheduler), bruteForcePairs(boxes));
+}
+
+TEST(IncrementalSweepAndPrune, coherentOrderIsNotSwapped)
+{
+    auto* taskScheduler = sofa::simulation::MainTaskSchedulerFactory::createInRegistry();
+    taskScheduler->init(4);
+
+    std::mt19937 generator(0);
+    const Boxes boxes = randomBoxes(100, generator);
+
+    IncrementalSweepAndPrune sweepAndPrune;
+    sweepAndPrunePairs(sweepAndPrune, boxes, *taskScheduler);
+    sweepAndPrunePairs(sweepAndPrune, boxes, *taskScheduler);
+
+    EXPECT_EQ(sweepAndPrune.getSwapCount(), 0);
+}
+
+TEST(IncrementalSweepAndPrune, sweepAxisChange)
+{
+    auto* taskScheduler = sofa::simulation::MainTaskSchedulerFactory::createInRegistry();
+    taskScheduler->init(2);
+
+    std::mt19937 generator(1);
+    Boxes boxes = randomBoxes(200, generator);
+
+    // boxes spread along the y axis, then along the x axis, then along the y axis again
+    IncrementalSweepAndPrune sweepAndPrune;
+    for (const auto& [axis, spacing] : {std::make_pair(1u, 10_sreal), std::make_pair(0u, 20_sreal), std::make_pair(1u, 40_sreal)})
+    {
+        for (std::size_t i = 0; i < boxes.min.size(); ++i)
+        {
+            const SReal shift = spacing * static_cast<SReal>(i % 10);
+            boxes.min[i][axis] += shift;
+            boxes.max[i][axis] += shift;
+        }
+
+        EXPECT_EQ(sweepAndPrunePairs(sweepAndPrune, boxes, *taskScheduler), bruteForcePairs(boxes));
+        EXPECT_EQ(sweepAndPrune.getSweepAxis(), axis);
+    }
+}
+
+TEST(IncrementalSweepAndPrune, touchingBoxes)
+{
+    auto* taskScheduler = sofa::simulation::MainTaskSchedulerFactory::createInRegistry();
+    taskScheduler->init(2);
+
+    Boxes boxes;
+    boxes.min = { {0, 0, 0}, {1, 0, 0}, {2.5, 0, 0} };
+    boxes.max = { {1, 1, 1}, {2, 1, 1}, {3, 1, 1} };
+
+    IncrementalSweepAndPrune sweepAndPrune;
+    const auto pairs = sweepAndPrunePairs(sweepAndPrune, boxes, *taskScheduler);
+    ASSERT_EQ(pairs.size(), 1);
+    EXPECT_EQ(*pairs.begin(), std::make_pair(IncrementalSweepAndPrune::Index{0}, IncrementalSweepAndPrune::Index{1}));
+}
+
+}
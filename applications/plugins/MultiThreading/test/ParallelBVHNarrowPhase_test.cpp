@@ -0,0 +1,203 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <MultiThreading/component/collision/detection/algorithm/ParallelBVHNarrowPhase.h>
+
+#include <sofa/component/collision/detection/algorithm/BVHNarrowPhase.h>
+#include <sofa/component/collision/geometry/CubeModel.h>
+#include <sofa/component/collision/testing/BoxCollisionModel.h>
+#include <sofa/core/CollisionModel.h>
+#include <sofa/core/collision/Intersection.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+
+namespace multithreading
+{
+
+using component::collision::detection::algorithm::ParallelBVHNarrowPhase;
+using sofa::component::collision::detection::algorithm::BVHNarrowPhase;
+using sofa::component::collision::geometry::Cube;
+using sofa::collision_test::BoxCollisionModel;
+
+namespace
+{
+
+using BoxDetectionOutputVector = sofa::core::collision::TDetectionOutputVector<BoxCollisionModel, BoxCollisionModel>;
+
+/// Intersection method writing a contact for each pair of overlapping boxes
+class BoxIntersection : public sofa::core::collision::Intersection, public sofa::core::collision::ElementIntersector
+{
+public:
+    SOFA_CLASS(BoxIntersection, sofa::core::collision::Intersection);
+
+    sofa::core::collision::ElementIntersector* findIntersector(sofa::core::CollisionModel*, sofa::core::CollisionModel*, bool& swapModels) override
+    {
+        swapModels = false;
+        return this;
+    }
+
+    bool canIntersect(sofa::core::CollisionElementIterator elem1, sofa::core::CollisionElementIterator elem2, const sofa::core::collision::Intersection*) override
+    {
+        const Cube cube1(elem1), cube2(elem2);
+        return sofa::collision_test::overlap(cube1.minVect(), cube1.maxVect(), cube2.minVect(), cube2.maxVect());
+    }
+
+    int beginIntersect(sofa::core::CollisionModel*, sofa::core::CollisionModel*, sofa::core::collision::DetectionOutputVector*& contacts) override
+    {
+        if (contacts == nullptr)
+        {
+            contacts = new BoxDetectionOutputVector;
+        }
+        return 0;
+    }
+
+    int intersect(sofa::core::CollisionElementIterator elem1, sofa::core::CollisionElementIterator elem2, sofa::core::collision::DetectionOutputVector* contacts, const sofa::core::collision::Intersection*) override
+    {
+        if (!sofa::collision_test::boxesOverlap(elem1, elem2))
+        {
+            return 0;
+        }
+
+        const auto& c1 = static_cast<BoxCollisionModel*>(elem1.getCollisionModel())->centers[elem1.getIndex()];
+        const auto& c2 = static_cast<BoxCollisionModel*>(elem2.getCollisionModel())->centers[elem2.getIndex()];
+
+        auto& detection = static_cast<BoxDetectionOutputVector*>(contacts)->emplace_back();
+        detection.elem = {elem1, elem2};
+        detection.id = elem1.getIndex() * static_cast<sofa::core::collision::DetectionOutput::ContactId>(elem2.getCollisionModel()->getSize()) + elem2.getIndex();
+        detection.point[0] = c1;
+        detection.point[1] = c2;
+        return 1;
+    }
+
+    int endIntersect(sofa::core::CollisionModel*, sofa::core::CollisionModel*, sofa::core::collision::DetectionOutputVector*) override
+    {
+        return 0;
+    }
+
+    std::string name() const override
+    {
+        return "BoxIntersection";
+    }
+};
+
+/// Detect the overlapping boxes of both models, and return the contact ids
+std::vector<sofa::core::collision::DetectionOutput::ContactId> detect(
+    BVHNarrowPhase* narrowPhase, sofa::core::CollisionModel* cm1, sofa::core::CollisionModel* cm2)
+{
+    narrowPhase->beginNarrowPhase();
+    narrowPhase->addCollisionPairs({{cm1, cm2}});
+    narrowPhase->endNarrowPhase();
+
+    std::vector<sofa::core::collision::DetectionOutput::ContactId> ids;
+    for (const auto& [models, outputs] : narrowPhase->getDetectionOutputs())
+    {
+        if (outputs)
+        {
+            for (const auto& detection : *static_cast<BoxDetectionOutputVector*>(outputs))
+            {
+                ids.push_back(detection.id);
+            }
+        }
+    }
+    return ids;
+}
+
+ParallelBVHNarrowPhase::SPtr createSplittingNarrowPhase(BoxIntersection* intersection)
+{
+    const auto narrowPhase = sofa::core::objectmodel::New<ParallelBVHNarrowPhase>();
+    narrowPhase->setIntersectionMethod(intersection);
+    narrowPhase->d_nbThreads.setValue(4);
+    narrowPhase->d_splitLargePairs.setValue(true);
+    narrowPhase->d_minElementsToSplit.setValue(100);
+    narrowPhase->init();
+    return narrowPhase;
+}
+
+/// Two plates moving toward each other
+void setPlates(BoxCollisionModel* model1, BoxCollisionModel* model2, const unsigned int step)
+{
+    model1->setPlate(30, 0, 0.1 * step);
+    model2->setPlate(25, 2 - 0.2 * step, -0.1 * step);
+    model1->computeBoundingTree(10);
+    model2->computeBoundingTree(10);
+}
+
+}
+
+TEST(ParallelBVHNarrowPhase, splitLargePairs)
+{
+    const auto model1 = sofa::core::objectmodel::New<BoxCollisionModel>();
+    const auto model2 = sofa::core::objectmodel::New<BoxCollisionModel>();
+    const auto intersection = sofa::core::objectmodel::New<BoxIntersection>();
+
+    const auto sequential = sofa::core::objectmodel::New<BVHNarrowPhase>();
+    sequential->setIntersectionMethod(intersection.get());
+
+    const auto parallel = createSplittingNarrowPhase(intersection.get());
+
+    std::size_t nbContacts = 0;
+    for (unsigned int step = 0; step < 10; ++step)
+    {
+        setPlates(model1.get(), model2.get(), step);
+
+        auto reference = detect(sequential.get(), model1->getFirst(), model2->getFirst());
+        auto ids = detect(parallel.get(), model1->getFirst(), model2->getFirst());
+
+        // the traversal of the pair has been split into several tasks
+        EXPECT_EQ(parallel->d_nbSplitPairs.getValue(), 1u) << "step " << step;
+
+        // the contacts are the same, without duplicates, but not in the same order
+        std::sort(reference.begin(), reference.end());
+        std::sort(ids.begin(), ids.end());
+        EXPECT_EQ(ids, reference) << "step " << step;
+        EXPECT_EQ(std::set(ids.begin(), ids.end()).size(), ids.size());
+
+        nbContacts += reference.size();
+    }
+
+    EXPECT_GT(nbContacts, 0u);
+}
+
+TEST(ParallelBVHNarrowPhase, splitLargePairsOutputOrder)
+{
+    const auto model1 = sofa::core::objectmodel::New<BoxCollisionModel>();
+    const auto model2 = sofa::core::objectmodel::New<BoxCollisionModel>();
+    const auto intersection = sofa::core::objectmodel::New<BoxIntersection>();
+
+    const auto parallel = createSplittingNarrowPhase(intersection.get());
+    const auto otherParallel = createSplittingNarrowPhase(intersection.get());
+
+    for (unsigned int step = 0; step < 10; ++step)
+    {
+        setPlates(model1.get(), model2.get(), step);
+
+        // the outputs of the tasks are merged in the order of the tasks, whatever the scheduling
+        const auto ids = detect(parallel.get(), model1->getFirst(), model2->getFirst());
+        EXPECT_EQ(detect(parallel.get(), model1->getFirst(), model2->getFirst()), ids) << "step " << step;
+        EXPECT_EQ(detect(otherParallel.get(), model1->getFirst(), model2->getFirst()), ids) << "step " << step;
+        EXPECT_EQ(parallel->d_nbSplitPairs.getValue(), 1u) << "step " << step;
+    }
+}
+
+}
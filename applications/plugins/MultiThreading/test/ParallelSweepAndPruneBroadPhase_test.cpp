@@ -0,0 +1,168 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <MultiThreading/component/collision/detection/algorithm/ParallelSweepAndPruneBroadPhase.h>
+
+#include <sofa/component/collision/detection/algorithm/BruteForceBroadPhase.h>
+#include <sofa/component/collision/geometry/CubeModel.h>
+#include <sofa/component/collision/testing/BoxCollisionModel.h>
+#include <sofa/core/collision/Intersection.h>
+#include <sofa/simulation/graph/DAGNode.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+
+namespace multithreading
+{
+
+using component::collision::detection::algorithm::ParallelSweepAndPruneBroadPhase;
+using sofa::component::collision::detection::algorithm::BruteForceBroadPhase;
+using sofa::component::collision::geometry::Cube;
+using sofa::collision_test::BoxCollisionModel;
+
+namespace
+{
+
+/// Intersection method only testing the overlap of the bounding boxes
+class CubeIntersection : public sofa::core::collision::Intersection, public sofa::core::collision::ElementIntersector
+{
+public:
+    SOFA_CLASS(CubeIntersection, sofa::core::collision::Intersection);
+
+    sofa::core::collision::ElementIntersector* findIntersector(sofa::core::CollisionModel*, sofa::core::CollisionModel*, bool& swapModels) override
+    {
+        swapModels = false;
+        return this;
+    }
+
+    bool canIntersect(sofa::core::CollisionElementIterator elem1, sofa::core::CollisionElementIterator elem2, const sofa::core::collision::Intersection*) override
+    {
+        const Cube cube1(elem1), cube2(elem2);
+        return sofa::collision_test::overlap(cube1.minVect(), cube1.maxVect(), cube2.minVect(), cube2.maxVect());
+    }
+
+    int beginIntersect(sofa::core::CollisionModel*, sofa::core::CollisionModel*, sofa::core::collision::DetectionOutputVector*&) override
+    {
+        return 0;
+    }
+
+    int intersect(sofa::core::CollisionElementIterator, sofa::core::CollisionElementIterator, sofa::core::collision::DetectionOutputVector*, const sofa::core::collision::Intersection*) override
+    {
+        return 0;
+    }
+
+    int endIntersect(sofa::core::CollisionModel*, sofa::core::CollisionModel*, sofa::core::collision::DetectionOutputVector*) override
+    {
+        return 0;
+    }
+
+    std::string name() const override
+    {
+        return "CubeIntersection";
+    }
+};
+
+/// Pairs of collision models output by the broad phase, whatever the order of the models in a pair
+std::set<std::pair<sofa::core::CollisionModel*, sofa::core::CollisionModel*> > detect(
+    BruteForceBroadPhase* broadPhase, const sofa::type::vector<sofa::core::CollisionModel*>& boundingVolumes)
+{
+    broadPhase->beginBroadPhase();
+    broadPhase->addCollisionModels(boundingVolumes);
+    broadPhase->endBroadPhase();
+
+    std::set<std::pair<sofa::core::CollisionModel*, sofa::core::CollisionModel*> > pairs;
+    for (const auto& [cm1, cm2] : broadPhase->getCollisionModelPairs())
+    {
+        // a pair is output only once
+        EXPECT_TRUE(pairs.insert(std::minmax(cm1, cm2)).second);
+    }
+    return pairs;
+}
+
+}
+
+TEST(ParallelSweepAndPruneBroadPhase, sameAsBruteForce)
+{
+    constexpr std::size_t nbModels = 60;
+
+    const auto intersection = sofa::core::objectmodel::New<CubeIntersection>();
+
+    const auto bruteForce = sofa::core::objectmodel::New<BruteForceBroadPhase>();
+    bruteForce->setIntersectionMethod(intersection.get());
+    bruteForce->init();
+
+    const auto sweepAndPrune = sofa::core::objectmodel::New<ParallelSweepAndPruneBroadPhase>();
+    sweepAndPrune->setIntersectionMethod(intersection.get());
+    sweepAndPrune->d_nbThreads.setValue(4);
+    sweepAndPrune->init();
+
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<SReal> position(0, 15);
+    std::uniform_real_distribution<SReal> offset(-1, 1);
+    std::uniform_int_distribution<unsigned int> nbBoxes(1, 5);
+
+    // each model is in its own node: the models of a same node only collide if self collision is enabled
+    std::vector<sofa::simulation::Node::SPtr> nodes;
+    std::vector<BoxCollisionModel::SPtr> models;
+    for (std::size_t i = 0; i < nbModels; ++i)
+    {
+        auto model = sofa::core::objectmodel::New<BoxCollisionModel>();
+        model->setSelfCollision(i % 3 == 0);
+        model->setSimulated(i % 5 != 0);
+        if (i % 7 == 0)
+        {
+            model->addGroup(1);
+        }
+        nodes.push_back(sofa::core::objectmodel::New<sofa::simulation::graph::DAGNode>());
+        nodes.back()->addObject(model);
+        models.push_back(model);
+    }
+
+    // the models move between the steps: the order of the previous step is reused by the sweep and prune
+    std::size_t nbPairs = 0;
+    for (unsigned int step = 0; step < 5; ++step)
+    {
+        sofa::type::vector<sofa::core::CollisionModel*> boundingVolumes;
+        for (const auto& model : models)
+        {
+            model->centers.resize(nbBoxes(generator));
+            const sofa::type::Vec3 center(position(generator), position(generator), position(generator));
+            for (auto& c : model->centers)
+            {
+                c = center + sofa::type::Vec3(offset(generator), offset(generator), offset(generator));
+            }
+            model->computeBoundingTree(6);
+            boundingVolumes.push_back(model->getFirst());
+        }
+
+        const auto expectedPairs = detect(bruteForce.get(), boundingVolumes);
+        EXPECT_EQ(detect(sweepAndPrune.get(), boundingVolumes), expectedPairs);
+        nbPairs += expectedPairs.size();
+    }
+
+    // the test is meaningful only if the models collide
+    EXPECT_GT(nbPairs, 0u);
+}
+
+}
@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""
+Compare two JSON outputs of Sofa.Benchmarks (--benchmark_out=<file> --benchmark_out_format=json).
+
+Usage: compare_benchmarks.py baseline.json contender.json [--threshold 0.05]
+
+For each benchmark present in both files, prints the time of both runs and their relative
+difference. The exit code is 1 if at least one benchmark is slower than the baseline by more
+than the threshold, which allows to use the script to detect regressions between two commits.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(filename):
+    with open(filename) as f:
+        data = json.load(f)
+
+    results = {}
+    for benchmark in data.get("benchmarks", []):
+        # with repetitions, only the aggregates are compared
+        if benchmark.get("run_type") == "aggregate" and benchmark.get("aggregate_name") != "median":
+            continue
+        if "error_occurred" in benchmark and benchmark["error_occurred"]:
+            continue
+        name = benchmark.get("run_name", benchmark["name"])
+        results[name] = benchmark
+    return data.get("context", {}), results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="relative slowdown above which a benchmark is reported as a regression (default: 0.05)")
+    parser.add_argument("--metric", choices=["real_time", "cpu_time"], default="real_time")
+    args = parser.parse_args()
+
+    baseline_context, baseline = load(args.baseline)
+    contender_context, contender = load(args.contender)
+
+    for key in ("host_name", "num_cpus", "sofa_version", "library_build_type"):
+        if baseline_context.get(key) != contender_context.get(key):
+            print(f"warning: '{key}' differs: {baseline_context.get(key)} vs {contender_context.get(key)}")
+
+    regressions = []
+    width = max((len(name) for name in baseline if name in contender), default=0)
+    print(f"{'benchmark':<{width}}  {'baseline':>14}  {'contender':>14}  {'diff':>8}")
+    for name, reference in baseline.items():
+        if name not in contender:
+            continue
+        before = reference[args.metric]
+        after = contender[name][args.metric]
+        if reference["time_unit"] != contender[name]["time_unit"] or before <= 0:
+            continue
+
+        diff = (after - before) / before
+        unit = reference["time_unit"]
+        flag = ""
+        if diff > args.threshold:
+            regressions.append(name)
+            flag = "  <-- regression"
+        print(f"{name:<{width}}  {before:>11.3f} {unit:<2}  {after:>11.3f} {unit:<2}  {diff:>+7.1%}{flag}")
+
+    missing = sorted(set(baseline) ^ set(contender))
+    if missing:
+        print(f"\n{len(missing)} benchmark(s) present in only one of the files")
+
+    if regressions:
+        print(f"\n{len(regressions)} regression(s) above {args.threshold:.0%}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
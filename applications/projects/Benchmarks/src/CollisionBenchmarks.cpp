@@ -0,0 +1,205 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include "SyntheticScenes.h"
+
+#include <benchmark/benchmark.h>
+
+#include <sofa/core/CollisionModel.h>
+#include <sofa/core/collision/BroadPhaseDetection.h>
+#include <sofa/core/collision/Intersection.h>
+#include <sofa/core/collision/NarrowPhaseDetection.h>
+#include <sofa/simpleapi/SimpleApi.h>
+#include <sofa/simulation/Simulation.h>
+
+#include <sstream>
+
+namespace sofa::benchmarks
+{
+
+namespace
+{
+
+constexpr int boundingTreeDepth = 6;
+
+/// Collision scene with the detection components of a CollisionPipeline, but no response
+simulation::Node::SPtr createCollisionScene()
+{
+    simulation::Node::SPtr root = simulation::getSimulation()->createNewGraph("root");
+    simpleapi::createObject(root, "CollisionPipeline", {{"depth", std::to_string(boundingTreeDepth)}});
+    simpleapi::createObject(root, "BruteForceBroadPhase");
+    simpleapi::createObject(root, "BVHNarrowPhase");
+    simpleapi::createObject(root, "MinProximityIntersection", {{"alarmDistance", "0.02"}, {"contactDistance", "0.01"}});
+    return root;
+}
+
+/// Adds an object made of n x n x n spheres regularly spread in the box [min, min + size]
+void addSphereObject(const simulation::Node::SPtr& root, const std::string& name, int n, const type::Vec3& min, SReal size)
+{
+    const auto node = simpleapi::createChild(root, name);
+
+    std::ostringstream resolution, minString, maxString;
+    resolution << n << " " << n << " " << n;
+    minString << min;
+    maxString << min + type::Vec3(size, size, size);
+
+    simpleapi::createObject(node, "RegularGridTopology", {{"min", minString.str()}, {"max", maxString.str()}, {"n", resolution.str()}});
+    simpleapi::createObject(node, "MechanicalObject", {{"template", "Vec3"}});
+    simpleapi::createObject(node, "SphereCollisionModel", {{"radius", std::to_string(0.5 * size / n)}});
+}
+
+struct CollisionDetection
+{
+    simulation::Node::SPtr root;
+    core::collision::Intersection* intersection { nullptr };
+    core::collision::BroadPhaseDetection* broadPhase { nullptr };
+    core::collision::NarrowPhaseDetection* narrowPhase { nullptr };
+    type::vector<core::CollisionModel*> models;
+
+    explicit CollisionDetection(simulation::Node::SPtr scene)
+        : root(std::move(scene))
+    {
+        simulation::node::initRoot(root.get());
+        intersection = root->getTreeObject<core::collision::Intersection>();
+        broadPhase = root->getTreeObject<core::collision::BroadPhaseDetection>();
+        narrowPhase = root->getTreeObject<core::collision::NarrowPhaseDetection>();
+        root->getTreeObjects<core::CollisionModel>(&models);
+    }
+
+    ~CollisionDetection()
+    {
+        simulation::node::unload(root);
+    }
+
+    bool isValid() const
+    {
+        return intersection && broadPhase && narrowPhase && !models.empty();
+    }
+
+    void computeBoundingTrees() const
+    {
+        for (auto* model : models)
+        {
+            model->computeBoundingTree(boundingTreeDepth);
+        }
+    }
+
+    void runBroadPhase() const
+    {
+        type::vector<core::CollisionModel*> boundingVolumes;
+        boundingVolumes.reserve(models.size());
+        for (auto* model : models)
+        {
+            boundingVolumes.push_back(model->getFirst());
+        }
+
+        intersection->beginBroadPhase();
+        broadPhase->beginBroadPhase();
+        broadPhase->addCollisionModels(boundingVolumes);
+        broadPhase->endBroadPhase();
+        intersection->endBroadPhase();
+    }
+
+    void runNarrowPhase() const
+    {
+        intersection->beginNarrowPhase();
+        narrowPhase->beginNarrowPhase();
+        narrowPhase->addCollisionPairs(broadPhase->getCollisionModelPairs());
+        narrowPhase->endNarrowPhase();
+        intersection->endNarrowPhase();
+    }
+
+    std::size_t nbContacts() const
+    {
+        std::size_t nb = 0;
+        for (const auto& [pair, outputs] : narrowPhase->getDetectionOutputs())
+        {
+            if (outputs)
+            {
+                nb += outputs->size();
+            }
+        }
+        return nb;
+    }
+};
+
+/// Broad phase among k x k x k objects of 8 spheres, each object overlapping its neighbors
+void BM_BroadPhase(benchmark::State& state)
+{
+    const int k = static_cast<int>(state.range(0));
+    auto root = createCollisionScene();
+    for (int i = 0; i < k * k * k; ++i)
+    {
+        const type::Vec3 min(i % k, (i / k) % k, i / (k * k));
+        addSphereObject(root, "object" + std::to_string(i), 2, min * 0.9, 1);
+    }
+
+    const CollisionDetection detection(root);
+    if (!detection.isValid())
+    {
+        state.SkipWithError("Cannot create the collision pipeline");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        detection.computeBoundingTrees();
+        detection.runBroadPhase();
+    }
+
+    state.counters["models"] = static_cast<double>(detection.models.size());
+    state.counters["pairs"] = static_cast<double>(detection.broadPhase->getCollisionModelPairs().size());
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(detection.models.size()));
+}
+BENCHMARK(BM_BroadPhase)->RangeMultiplier(2)->Range(2, 8)->Unit(benchmark::kMicrosecond);
+
+/// Narrow phase between two interpenetrating objects of n x n x n spheres
+void BM_NarrowPhase(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    auto root = createCollisionScene();
+    addSphereObject(root, "object0", n, {0, 0, 0}, 1);
+    addSphereObject(root, "object1", n, {0.5 / n, 0.5 / n, 0.5}, 1);
+
+    const CollisionDetection detection(root);
+    if (!detection.isValid())
+    {
+        state.SkipWithError("Cannot create the collision pipeline");
+        return;
+    }
+
+    detection.computeBoundingTrees();
+    detection.runBroadPhase();
+
+    for (auto _ : state)
+    {
+        detection.runNarrowPhase();
+    }
+
+    state.counters["spheres"] = 2 * n * n * n;
+    state.counters["contacts"] = static_cast<double>(detection.nbContacts());
+    state.SetItemsProcessed(state.iterations() * 2 * n * n * n);
+}
+BENCHMARK(BM_NarrowPhase)->RangeMultiplier(2)->Range(4, 32)->Unit(benchmark::kMicrosecond);
+
+}
+
+}
@@ -0,0 +1,162 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include "SyntheticScenes.h"
+
+#include <benchmark/benchmark.h>
+
+#include <sofa/component/statecontainer/MechanicalObject.h>
+#include <sofa/core/MechanicalParams.h>
+#include <sofa/core/behavior/BaseForceField.h>
+#include <sofa/simulation/Simulation.h>
+
+#include <cmath>
+
+namespace sofa::benchmarks
+{
+
+namespace
+{
+
+using MechanicalObject3 = component::statecontainer::MechanicalObject<defaulttype::Vec3Types>;
+
+struct ForceFieldCase
+{
+    std::string name;
+    ElementType elements;
+    std::string type;
+    std::map<std::string, std::string> attributes;
+};
+
+const std::vector<ForceFieldCase>& forceFieldCases()
+{
+    static const std::vector<ForceFieldCase> cases {
+        {"TetrahedronFEMForceField_small", ElementType::Tetrahedra, "TetrahedronFEMForceField", {{"method", "small"}, {"youngModulus", "1000"}, {"poissonRatio", "0.4"}}},
+        {"TetrahedronFEMForceField_large", ElementType::Tetrahedra, "TetrahedronFEMForceField", {{"method", "large"}, {"youngModulus", "1000"}, {"poissonRatio", "0.4"}}},
+        {"TetrahedronFEMForceField_polar", ElementType::Tetrahedra, "TetrahedronFEMForceField", {{"method", "polar"}, {"youngModulus", "1000"}, {"poissonRatio", "0.4"}}},
+        {"TetrahedronFEMForceField_svd", ElementType::Tetrahedra, "TetrahedronFEMForceField", {{"method", "svd"}, {"youngModulus", "1000"}, {"poissonRatio", "0.4"}}},
+        {"TetrahedralCorotationalFEMForceField", ElementType::Tetrahedra, "TetrahedralCorotationalFEMForceField", {{"method", "large"}, {"youngModulus", "1000"}, {"poissonRatio", "0.4"}}},
+        {"FastTetrahedralCorotationalForceField", ElementType::Tetrahedra, "FastTetrahedralCorotationalForceField", {{"method", "qr"}, {"youngModulus", "1000"}, {"poissonRatio", "0.4"}}},
+        {"TetrahedronHyperelasticityFEMForceField", ElementType::Tetrahedra, "TetrahedronHyperelasticityFEMForceField", {{"materialName", "StVenantKirchhoff"}, {"ParameterSet", "3448.2759 31034.483"}}},
+        {"HexahedronFEMForceField_large", ElementType::Hexahedra, "HexahedronFEMForceField", {{"method", "large"}, {"youngModulus", "1000"}, {"poissonRatio", "0.4"}}},
+        {"HexahedronFEMForceField_polar", ElementType::Hexahedra, "HexahedronFEMForceField", {{"method", "polar"}, {"youngModulus", "1000"}, {"poissonRatio", "0.4"}}},
+        {"TriangleFEMForceField", ElementType::Triangles, "TriangleFEMForceField", {{"method", "large"}, {"youngModulus", "1000"}, {"poissonRatio", "0.4"}}},
+        {"TriangularFEMForceField", ElementType::Triangles, "TriangularFEMForceField", {{"method", "large"}, {"youngModulus", "1000"}, {"poissonRatio", "0.4"}}},
+        {"TriangularFEMForceFieldOptim", ElementType::Triangles, "TriangularFEMForceFieldOptim", {{"youngModulus", "1000"}, {"poissonRatio", "0.4"}}},
+        {"MeshSpringForceField", ElementType::Tetrahedra, "MeshSpringForceField", {{"stiffness", "1000"}, {"damping", "1"}}},
+        {"RegularGridSpringForceField", ElementType::Hexahedra, "RegularGridSpringForceField", {{"stiffness", "1000"}, {"damping", "1"}}},
+    };
+    return cases;
+}
+
+/// Deforms the beam and fills the velocity and dx vectors, so that the force fields are not evaluated at rest
+MechanicalObject3* prepareState(const simulation::Node::SPtr& root)
+{
+    auto* mstate = dynamic_cast<MechanicalObject3*>(root->getMechanicalState());
+    if (mstate == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto x = helper::getWriteAccessor(mstate->x);
+    auto v = helper::getWriteAccessor(mstate->v);
+    auto dx = helper::getWriteAccessor(mstate->dx);
+    auto f = helper::getWriteAccessor(mstate->f);
+    v.resize(x.size());
+    dx.resize(x.size());
+    f.resize(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        const SReal angle = 0.1_sreal * x[i][2];
+        const SReal c = std::cos(angle), s = std::sin(angle);
+        x[i] = {c * x[i][0] - s * x[i][1], s * x[i][0] + c * x[i][1], x[i][2]};
+        v[i] = {0.01_sreal, 0, 0};
+        dx[i] = {0.001_sreal * std::sin(static_cast<SReal>(i)), 0.001_sreal, 0};
+    }
+    return mstate;
+}
+
+void addForce(benchmark::State& state, const ForceFieldCase& forceField)
+{
+    const int n = static_cast<int>(state.range(0));
+    const auto root = createForceFieldScene(n, forceField.elements, forceField.type, forceField.attributes);
+    auto* ff = root->getTreeObject<core::behavior::BaseForceField>();
+    if (ff == nullptr || prepareState(root) == nullptr)
+    {
+        state.SkipWithError("Cannot create the force field");
+        return;
+    }
+
+    core::MechanicalParams mparams;
+    for (auto _ : state)
+    {
+        ff->addForce(&mparams, core::VecDerivId::force());
+    }
+
+    state.counters["nodes"] = nbBeamNodes(n);
+    state.SetItemsProcessed(state.iterations() * nbBeamNodes(n));
+    simulation::node::unload(root);
+}
+
+void addDForce(benchmark::State& state, const ForceFieldCase& forceField)
+{
+    const int n = static_cast<int>(state.range(0));
+    const auto root = createForceFieldScene(n, forceField.elements, forceField.type, forceField.attributes);
+    auto* ff = root->getTreeObject<core::behavior::BaseForceField>();
+    if (ff == nullptr || prepareState(root) == nullptr)
+    {
+        state.SkipWithError("Cannot create the force field");
+        return;
+    }
+
+    // addForce updates the rotations and stiffnesses used by addDForce
+    core::MechanicalParams mparams;
+    ff->addForce(&mparams, core::VecDerivId::force());
+
+    mparams.setDx(core::ConstVecDerivId::dx());
+    mparams.setKFactor(1);
+    for (auto _ : state)
+    {
+        ff->addDForce(&mparams, core::VecDerivId::force());
+    }
+
+    state.counters["nodes"] = nbBeamNodes(n);
+    state.SetItemsProcessed(state.iterations() * nbBeamNodes(n));
+    simulation::node::unload(root);
+}
+
+bool registerForceFieldBenchmarks()
+{
+    for (const auto& forceField : forceFieldCases())
+    {
+        benchmark::RegisterBenchmark(("ForceField_addForce/" + forceField.name).c_str(), addForce, forceField)
+            ->RangeMultiplier(2)->Range(2, 16)->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark(("ForceField_addDForce/" + forceField.name).c_str(), addDForce, forceField)
+            ->RangeMultiplier(2)->Range(2, 16)->Unit(benchmark::kMicrosecond);
+    }
+    return true;
+}
+
+const bool forceFieldBenchmarksRegistered = registerForceFieldBenchmarks();
+
+}
+
+}
@@ -0,0 +1,198 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <benchmark/benchmark.h>
+
+#include <sofa/component/haptics/HapticLoopMonitor.h>
+#include <sofa/component/haptics/TripleBuffer.h>
+#include <sofa/helper/system/thread/CTime.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sofa::benchmarks
+{
+
+namespace
+{
+
+using component::haptics::HapticLoopMonitor;
+using component::haptics::TripleBuffer;
+using helper::system::thread::CTime;
+using helper::system::thread::ctime_t;
+
+/// Snapshot of a constraint problem sent by the simulation thread to the haptic thread
+struct Snapshot
+{
+    std::vector<SReal> compliance;
+    ctime_t time { 0 };
+};
+
+/// The simulation thread holds a mutex while it writes the snapshot, and the haptic thread while it reads it
+class MutexExchange
+{
+public:
+    static const char* name() { return "Mutex"; }
+
+    template<class Write>
+    void write(Write&& writeSnapshot)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        writeSnapshot(m_snapshot);
+    }
+
+    template<class Read>
+    void read(Read&& readSnapshot)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        readSnapshot(m_snapshot);
+    }
+
+private:
+    std::mutex m_mutex;
+    Snapshot m_snapshot;
+};
+
+/// The snapshots are exchanged with a TripleBuffer, as in LCPForceFeedback
+class TripleBufferExchange
+{
+public:
+    static const char* name() { return "TripleBuffer"; }
+
+    template<class Write>
+    void write(Write&& writeSnapshot)
+    {
+        writeSnapshot(m_buffer.getWriteBuffer());
+        m_buffer.publish();
+    }
+
+    template<class Read>
+    void read(Read&& readSnapshot)
+    {
+        m_buffer.update();
+        readSnapshot(m_buffer.getReadBuffer());
+    }
+
+private:
+    TripleBuffer<Snapshot> m_buffer;
+};
+
+/**
+ * A synthetic device thread running at 1kHz reads the snapshots of a synthetic simulation thread, which writes
+ * the compliance of n constraints (n x n values) at each time step.
+ * The statistics of the haptic loop (jitter, missed deadlines, age of the snapshots) are reported in the counters.
+ */
+template<class Exchange>
+void hapticLoop(benchmark::State& state)
+{
+    const auto nbConstraints = static_cast<std::size_t>(state.range(0));
+    constexpr double hapticPeriod = 0.001;
+    constexpr unsigned int nbTicks = 500;
+    const ctime_t ticksPerPeriod = static_cast<ctime_t>(hapticPeriod * CTime::getTicksPerSec());
+
+    Exchange exchange;
+    std::atomic<bool> terminate { false };
+    std::thread simulation([&]()
+    {
+        SReal step = 0;
+        while (!terminate)
+        {
+            exchange.write([&](Snapshot& snapshot)
+            {
+                snapshot.compliance.resize(nbConstraints * nbConstraints);
+                std::fill(snapshot.compliance.begin(), snapshot.compliance.end(), step);
+                snapshot.time = CTime::getTime();
+            });
+            step += 1;
+
+            // rest of the time step
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    // statistics of the whole benchmark, published at the end
+    HapticLoopMonitor monitor(hapticPeriod, std::numeric_limits<double>::max());
+    SReal force = 0;
+    for (auto _ : state)
+    {
+        for (unsigned int tick = 0; tick < nbTicks; ++tick)
+        {
+            const ctime_t start = CTime::getTime();
+
+            ctime_t snapshotTime = 0;
+            exchange.read([&](const Snapshot& snapshot)
+            {
+                if (!snapshot.compliance.empty())
+                {
+                    force += snapshot.compliance[tick % snapshot.compliance.size()];
+                }
+                snapshotTime = snapshot.time;
+            });
+            monitor.addIteration(start, snapshotTime);
+
+            // wait for the next tick of the device
+            while (CTime::getTime() - start < ticksPerPeriod)
+            {
+            }
+        }
+    }
+    benchmark::DoNotOptimize(force);
+
+    terminate = true;
+    simulation.join();
+
+    monitor.publish();
+    HapticLoopMonitor::Statistics statistics;
+    monitor.getStatistics(statistics);
+
+    state.counters["constraints"] = static_cast<double>(nbConstraints);
+    state.counters["frequency"] = statistics.frequency;
+    state.counters["jitter_us"] = statistics.jitter * 1e6;
+    state.counters["max_jitter_us"] = statistics.maxJitter * 1e6;
+    state.counters["missed_deadlines"] = statistics.missedDeadlines;
+    state.counters["snapshot_age_us"] = statistics.snapshotAge * 1e6;
+    state.counters["max_snapshot_age_us"] = statistics.maxSnapshotAge * 1e6;
+}
+
+template<class Exchange>
+void registerHapticLoopBenchmark()
+{
+    benchmark::RegisterBenchmark((std::string("Haptics_loop/") + Exchange::name()).c_str(), hapticLoop<Exchange>)
+        ->RangeMultiplier(4)->Range(64, 1024)->Iterations(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+bool registerHapticsBenchmarks()
+{
+    registerHapticLoopBenchmark<MutexExchange>();
+    registerHapticLoopBenchmark<TripleBufferExchange>();
+    return true;
+}
+
+const bool hapticsBenchmarksRegistered = registerHapticsBenchmarks();
+
+}
+
+}
@@ -0,0 +1,171 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include "SyntheticScenes.h"
+
+#include <benchmark/benchmark.h>
+
+#include <sofa/component/linearsolver/direct/SparseLDLSolver.h>
+#include <sofa/component/linearsolver/iterative/CGLinearSolver.h>
+#include <sofa/linearalgebra/FullVector.h>
+
+#include <cmath>
+
+namespace sofa::benchmarks
+{
+
+namespace
+{
+
+using Matrix = linearalgebra::CompressedRowSparseMatrix<SReal>;
+using Vector = linearalgebra::FullVector<SReal>;
+
+Vector createRightHandSide(const Matrix& matrix)
+{
+    Vector rhs(matrix.rowSize());
+    for (int i = 0; i < rhs.size(); ++i)
+    {
+        rhs[i] = std::sin(static_cast<SReal>(i));
+    }
+    return rhs;
+}
+
+/// Assembly of a matrix coupling the nodes of a grid, from scratch, followed by its compression
+void BM_CRSAssembly(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    Matrix::Index nbNonZeros = 0;
+    for (auto _ : state)
+    {
+        const Matrix matrix = createGridMatrix(n);
+        nbNonZeros = static_cast<Matrix::Index>(matrix.colsValue.size());
+        benchmark::DoNotOptimize(matrix.colsValue.data());
+    }
+
+    state.counters["rows"] = 3 * n * n * n;
+    state.counters["nnz"] = nbNonZeros;
+    state.SetItemsProcessed(state.iterations() * nbNonZeros);
+}
+BENCHMARK(BM_CRSAssembly)->RangeMultiplier(2)->Range(4, 32)->Unit(benchmark::kMicrosecond);
+
+/// Product of the assembled matrix with a vector
+void BM_CRSProduct(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const Matrix matrix = createGridMatrix(n);
+    const Vector x = createRightHandSide(matrix);
+    Vector y(matrix.rowSize());
+    for (auto _ : state)
+    {
+        matrix.mul(y, x);
+        benchmark::DoNotOptimize(y.ptr());
+    }
+
+    state.counters["rows"] = matrix.rowSize();
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(matrix.colsValue.size()));
+}
+BENCHMARK(BM_CRSProduct)->RangeMultiplier(2)->Range(4, 32)->Unit(benchmark::kMicrosecond);
+
+using LDLSolver = component::linearsolver::direct::SparseLDLSolver<Matrix, Vector>;
+
+LDLSolver::SPtr createLDLSolver(bool supernodal)
+{
+    const LDLSolver::SPtr solver = core::objectmodel::New<LDLSolver>();
+    solver->findData("supernodal")->read(supernodal ? "true" : "false");
+    solver->init();
+    return solver;
+}
+
+/// Numerical factorization, the symbolic factorization being reused across iterations as in a simulation
+void BM_SparseLDLFactorization(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const bool supernodal = state.range(1) != 0;
+    Matrix matrix = createGridMatrix(n);
+    const auto solver = createLDLSolver(supernodal);
+    solver->invert(matrix);
+
+    for (auto _ : state)
+    {
+        solver->invert(matrix);
+    }
+
+    state.counters["rows"] = matrix.rowSize();
+    state.SetItemsProcessed(state.iterations() * matrix.rowSize());
+}
+BENCHMARK(BM_SparseLDLFactorization)->ArgNames({"n", "supernodal"})
+    ->ArgsProduct({benchmark::CreateRange(4, 16, 2), {0, 1}})->Unit(benchmark::kMillisecond);
+
+/// Forward and backward substitutions with a factorized matrix
+void BM_SparseLDLSolve(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const bool supernodal = state.range(1) != 0;
+    Matrix matrix = createGridMatrix(n);
+    Vector rhs = createRightHandSide(matrix);
+    Vector solution(matrix.rowSize());
+    const auto solver = createLDLSolver(supernodal);
+    solver->invert(matrix);
+
+    for (auto _ : state)
+    {
+        solver->solve(matrix, solution, rhs);
+        benchmark::DoNotOptimize(solution.ptr());
+    }
+
+    state.counters["rows"] = matrix.rowSize();
+    state.SetItemsProcessed(state.iterations() * matrix.rowSize());
+}
+BENCHMARK(BM_SparseLDLSolve)->ArgNames({"n", "supernodal"})
+    ->ArgsProduct({benchmark::CreateRange(4, 16, 2), {0, 1}})->Unit(benchmark::kMicrosecond);
+
+/// A fixed number of conjugate gradient iterations on an assembled matrix
+void BM_CGIterations(benchmark::State& state)
+{
+    constexpr unsigned int nbIterations = 25;
+
+    const int n = static_cast<int>(state.range(0));
+    Matrix matrix = createGridMatrix(n);
+    Vector rhs = createRightHandSide(matrix);
+    Vector solution(matrix.rowSize());
+
+    using CGSolver = component::linearsolver::iterative::CGLinearSolver<Matrix, Vector>;
+    const CGSolver::SPtr solver = core::objectmodel::New<CGSolver>();
+    solver->d_maxIter.setValue(nbIterations);
+    solver->d_tolerance.setValue(0);
+    solver->d_smallDenominatorThreshold.setValue(0);
+    solver->init();
+
+    for (auto _ : state)
+    {
+        solver->solve(matrix, solution, rhs);
+        benchmark::DoNotOptimize(solution.ptr());
+    }
+
+    state.counters["rows"] = matrix.rowSize();
+    state.counters["iterations_per_solve"] = nbIterations;
+    state.SetItemsProcessed(state.iterations() * nbIterations);
+}
+BENCHMARK(BM_CGIterations)->RangeMultiplier(2)->Range(4, 32)->Unit(benchmark::kMicrosecond);
+
+}
+
+}
@@ -0,0 +1,126 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include "SyntheticScenes.h"
+
+#include <benchmark/benchmark.h>
+
+#include <sofa/component/statecontainer/MechanicalObject.h>
+#include <sofa/core/BaseMapping.h>
+#include <sofa/core/MechanicalParams.h>
+#include <sofa/simpleapi/SimpleApi.h>
+#include <sofa/simulation/Simulation.h>
+
+#include <sstream>
+
+namespace sofa::benchmarks
+{
+
+namespace
+{
+
+using MechanicalObject3 = component::statecontainer::MechanicalObject<defaulttype::Vec3Types>;
+
+/**
+ * A hexahedral beam of n x n x 4n nodes, and a child embedding (2n)x(2n)x(8n) points with a
+ * BarycentricMapping, i.e. 8 mapped points per node of the beam.
+ */
+simulation::Node::SPtr createBarycentricMappingScene(int n)
+{
+    simulation::Node::SPtr root = simulation::getSimulation()->createNewGraph("root");
+    addBeam(root, n, ElementType::Hexahedra);
+
+    const auto embedded = simpleapi::createChild(root, "embedded");
+    std::ostringstream resolution;
+    resolution << 2 * n << " " << 2 * n << " " << 8 * n;
+    simpleapi::createObject(embedded, "RegularGridTopology", {{"min", "0.05 0.05 0.05"}, {"max", "0.95 0.95 3.95"}, {"n", resolution.str()}});
+    simpleapi::createObject(embedded, "MechanicalObject", {{"template", "Vec3"}});
+    simpleapi::createObject(embedded, "BarycentricMapping", {{"input", "@.."}, {"output", "@."}});
+
+    simulation::node::initRoot(root.get());
+    return root;
+}
+
+void BM_BarycentricMappingApply(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const auto root = createBarycentricMappingScene(n);
+    auto* mapping = root->getTreeObject<core::BaseMapping>();
+    if (mapping == nullptr)
+    {
+        state.SkipWithError("Cannot create the mapping");
+        return;
+    }
+
+    const core::MechanicalParams mparams;
+    for (auto _ : state)
+    {
+        mapping->apply(&mparams, core::VecCoordId::position(), core::ConstVecCoordId::position());
+    }
+
+    const int nbMappedPoints = 8 * nbBeamNodes(n);
+    state.counters["mapped_points"] = nbMappedPoints;
+    state.SetItemsProcessed(state.iterations() * nbMappedPoints);
+    simulation::node::unload(root);
+}
+BENCHMARK(BM_BarycentricMappingApply)->RangeMultiplier(2)->Range(2, 16)->Unit(benchmark::kMicrosecond);
+
+void BM_BarycentricMappingApplyJT(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const auto root = createBarycentricMappingScene(n);
+    auto* mapping = root->getTreeObject<core::BaseMapping>();
+    if (mapping == nullptr)
+    {
+        state.SkipWithError("Cannot create the mapping");
+        return;
+    }
+
+    // a non-zero force on the mapped points
+    for (auto* mstate : mapping->getMechTo())
+    {
+        if (auto* mappedState = dynamic_cast<MechanicalObject3*>(mstate))
+        {
+            auto f = helper::getWriteAccessor(mappedState->f);
+            f.resize(mappedState->getSize());
+            for (std::size_t i = 0; i < f.size(); ++i)
+            {
+                f[i] = {0, -1, 0.01_sreal * (i % 7)};
+            }
+        }
+    }
+
+    const core::MechanicalParams mparams;
+    for (auto _ : state)
+    {
+        mapping->applyJT(&mparams, core::VecDerivId::force(), core::ConstVecDerivId::force());
+    }
+
+    const int nbMappedPoints = 8 * nbBeamNodes(n);
+    state.counters["mapped_points"] = nbMappedPoints;
+    state.SetItemsProcessed(state.iterations() * nbMappedPoints);
+    simulation::node::unload(root);
+}
+BENCHMARK(BM_BarycentricMappingApplyJT)->RangeMultiplier(2)->Range(2, 16)->Unit(benchmark::kMicrosecond);
+
+}
+
+}
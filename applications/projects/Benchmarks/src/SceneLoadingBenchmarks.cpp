@@ -0,0 +1,112 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include "SyntheticScenes.h"
+
+#include <benchmark/benchmark.h>
+
+#include <sofa/simulation/Simulation.h>
+#include <sofa/simulation/common/SceneLoaderXML.h>
+
+namespace sofa::benchmarks
+{
+
+namespace
+{
+
+/// Parsing of an XML scene and creation of its graph
+void BM_SceneLoading(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const std::string scene = createBeamSceneXML(n);
+
+    for (auto _ : state)
+    {
+        const auto root = simulation::SceneLoaderXML::loadFromMemory("benchmark.scn", scene.c_str());
+        if (root == nullptr)
+        {
+            state.SkipWithError("Cannot load the scene");
+            return;
+        }
+
+        state.PauseTiming();
+        simulation::node::unload(root);
+        state.ResumeTiming();
+    }
+
+    state.counters["nodes"] = nbBeamNodes(n);
+}
+BENCHMARK(BM_SceneLoading)->RangeMultiplier(2)->Range(2, 16)->Unit(benchmark::kMillisecond);
+
+/// Initialization of a loaded scene: topological mappings, FEM precomputations, mass...
+void BM_SceneInit(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const std::string scene = createBeamSceneXML(n);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        const auto root = simulation::SceneLoaderXML::loadFromMemory("benchmark.scn", scene.c_str());
+        if (root == nullptr)
+        {
+            state.SkipWithError("Cannot load the scene");
+            return;
+        }
+        state.ResumeTiming();
+
+        simulation::node::initRoot(root.get());
+
+        state.PauseTiming();
+        simulation::node::unload(root);
+        state.ResumeTiming();
+    }
+
+    state.counters["nodes"] = nbBeamNodes(n);
+}
+BENCHMARK(BM_SceneInit)->RangeMultiplier(2)->Range(2, 16)->Unit(benchmark::kMillisecond);
+
+/// A complete time step of the loaded scene
+void BM_SceneAnimate(benchmark::State& state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const auto root = simulation::SceneLoaderXML::loadFromMemory("benchmark.scn", createBeamSceneXML(n).c_str());
+    if (root == nullptr)
+    {
+        state.SkipWithError("Cannot load the scene");
+        return;
+    }
+    simulation::node::initRoot(root.get());
+
+    for (auto _ : state)
+    {
+        simulation::node::animate(root.get(), 0.01_sreal);
+    }
+
+    state.counters["nodes"] = nbBeamNodes(n);
+    state.SetItemsProcessed(state.iterations() * nbBeamNodes(n));
+    simulation::node::unload(root);
+}
+BENCHMARK(BM_SceneAnimate)->RangeMultiplier(2)->Range(2, 16)->Unit(benchmark::kMillisecond);
+
+}
+
+}
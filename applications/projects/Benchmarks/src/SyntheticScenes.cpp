@@ -0,0 +1,161 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include "SyntheticScenes.h"
+
+#include <sofa/simpleapi/SimpleApi.h>
+#include <sofa/simulation/Simulation.h>
+
+#include <sstream>
+
+namespace sofa::benchmarks
+{
+
+namespace
+{
+std::string gridResolution(int n)
+{
+    std::ostringstream resolution;
+    resolution << n << " " << n << " " << 4 * n;
+    return resolution.str();
+}
+}
+
+int nbBeamNodes(int n)
+{
+    return n * n * 4 * n;
+}
+
+void addBeam(const simulation::Node::SPtr& node, int n, ElementType elements)
+{
+    switch (elements)
+    {
+    case ElementType::Hexahedra:
+        simpleapi::createObject(node, "RegularGridTopology", {{"name", "grid"}, {"min", "0 0 0"}, {"max", "1 1 4"}, {"n", gridResolution(n)}});
+        simpleapi::createObject(node, "MechanicalObject", {{"template", "Vec3"}});
+        break;
+    case ElementType::Tetrahedra:
+        simpleapi::createObject(node, "RegularGridTopology", {{"name", "grid"}, {"min", "0 0 0"}, {"max", "1 1 4"}, {"n", gridResolution(n)}});
+        simpleapi::createObject(node, "MechanicalObject", {{"template", "Vec3"}});
+        simpleapi::createObject(node, "TetrahedronSetTopologyContainer", {{"name", "topology"}});
+        simpleapi::createObject(node, "TetrahedronSetTopologyModifier");
+        simpleapi::createObject(node, "Hexa2TetraTopologicalMapping", {{"input", "@grid"}, {"output", "@topology"}});
+        break;
+    case ElementType::Triangles:
+    {
+        // the surface has as many nodes as the volumetric beam
+        std::ostringstream resolution;
+        resolution << 2 * n << " " << 2 * n * n << " 1";
+        simpleapi::createObject(node, "RegularGridTopology", {{"name", "grid"}, {"min", "0 0 0"}, {"max", "1 4 0"}, {"n", resolution.str()}});
+        simpleapi::createObject(node, "MechanicalObject", {{"template", "Vec3"}});
+        simpleapi::createObject(node, "TriangleSetTopologyContainer", {{"name", "topology"}});
+        simpleapi::createObject(node, "TriangleSetTopologyModifier");
+        simpleapi::createObject(node, "Quad2TriangleTopologicalMapping", {{"input", "@grid"}, {"output", "@topology"}});
+        break;
+    }
+    }
+}
+
+simulation::Node::SPtr createForceFieldScene(int n, ElementType elements, const std::string& forceField,
+                                             const std::map<std::string, std::string>& attributes)
+{
+    simulation::Node::SPtr root = simulation::getSimulation()->createNewGraph("root");
+    addBeam(root, n, elements);
+
+    std::map<std::string, std::string> forceFieldAttributes = attributes;
+    if (elements != ElementType::Hexahedra)
+    {
+        forceFieldAttributes.emplace("topology", "@topology");
+    }
+    simpleapi::createObject(root, forceField, forceFieldAttributes);
+
+    simulation::node::initRoot(root.get());
+    return root;
+}
+
+std::string createBeamSceneXML(int n)
+{
+    std::ostringstream scene;
+    scene << "<Node name=\"root\" dt=\"0.01\" gravity=\"0 -9.81 0\">\n"
+          << "  <DefaultAnimationLoop/>\n"
+          << "  <Node name=\"beam\">\n"
+          << "    <EulerImplicitSolver rayleighStiffness=\"0.1\" rayleighMass=\"0.1\"/>\n"
+          << "    <CGLinearSolver iterations=\"25\" tolerance=\"1e-9\" threshold=\"1e-9\"/>\n"
+          << "    <RegularGridTopology name=\"grid\" min=\"0 0 0\" max=\"1 1 4\" n=\"" << gridResolution(n) << "\"/>\n"
+          << "    <MechanicalObject template=\"Vec3\"/>\n"
+          << "    <TetrahedronSetTopologyContainer name=\"topology\"/>\n"
+          << "    <TetrahedronSetTopologyModifier/>\n"
+          << "    <Hexa2TetraTopologicalMapping input=\"@grid\" output=\"@topology\"/>\n"
+          << "    <DiagonalMass massDensity=\"1\" topology=\"@topology\"/>\n"
+          << "    <TetrahedronFEMForceField youngModulus=\"1000\" poissonRatio=\"0.4\" method=\"large\" topology=\"@topology\"/>\n"
+          << "    <BoxROI name=\"fixed\" box=\"-0.1 -0.1 -0.1 1.1 1.1 0.1\"/>\n"
+          << "    <FixedProjectiveConstraint indices=\"@fixed.indices\"/>\n"
+          << "  </Node>\n"
+          << "</Node>\n";
+    return scene.str();
+}
+
+linearalgebra::CompressedRowSparseMatrix<SReal> createGridMatrix(int n)
+{
+    const auto nodeId = [n](int x, int y, int z) { return (z * n + y) * n + x; };
+    const int nbNodes = n * n * n;
+
+    linearalgebra::CompressedRowSparseMatrix<SReal> matrix;
+    matrix.resize(3 * nbNodes, 3 * nbNodes);
+
+    const auto addCoupling = [&matrix](int a, int b)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                const SReal value = -0.1_sreal * (1 + i + 2 * j) / (1 + a % 7);
+                matrix.add(3 * a + i, 3 * b + j, value);
+                matrix.add(3 * b + j, 3 * a + i, value);
+            }
+        }
+    };
+
+    for (int z = 0; z < n; ++z)
+    {
+        for (int y = 0; y < n; ++y)
+        {
+            for (int x = 0; x < n; ++x)
+            {
+                const int a = nodeId(x, y, z);
+                if (x + 1 < n) addCoupling(a, nodeId(x + 1, y, z));
+                if (y + 1 < n) addCoupling(a, nodeId(x, y + 1, z));
+                if (z + 1 < n) addCoupling(a, nodeId(x, y, z + 1));
+            }
+        }
+    }
+
+    // diagonal dominance
+    for (int i = 0; i < 3 * nbNodes; ++i)
+    {
+        matrix.add(i, i, 10_sreal + i % 5);
+    }
+
+    matrix.compress();
+    return matrix;
+}
+
+}
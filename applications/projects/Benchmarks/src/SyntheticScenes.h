@@ -0,0 +1,69 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#pragma once
+
+#include <sofa/linearalgebra/CompressedRowSparseMatrix.h>
+#include <sofa/simulation/Node.h>
+
+#include <map>
+#include <string>
+
+namespace sofa::benchmarks
+{
+
+/// Kind of elements built on top of the synthetic grid
+enum class ElementType
+{
+    Hexahedra,
+    Tetrahedra,
+    Triangles
+};
+
+/**
+ * Adds to the node a beam discretized by a regular grid of n x n x 4n nodes, and the
+ * topology matching the requested element type.
+ * The grid topology is named "grid" and the element topology, if any, "topology".
+ * The mechanical state is added after the topology (positions are taken from the grid).
+ */
+void addBeam(const simulation::Node::SPtr& node, int n, ElementType elements);
+
+/**
+ * Creates and initializes a scene made of a beam of n x n x 4n nodes and a single force field
+ * of the given type, created with the given attributes. No solver is added: the scene is meant
+ * to call the force field directly.
+ */
+simulation::Node::SPtr createForceFieldScene(int n, ElementType elements, const std::string& forceField,
+                                             const std::map<std::string, std::string>& attributes);
+
+/**
+ * Returns a complete XML scene (solver, mass, FEM, fixed constraint) of a beam of
+ * n x n x 4n nodes, used to measure scene loading and initialization.
+ */
+std::string createBeamSceneXML(int n);
+
+/// Symmetric positive definite matrix made of 3x3 blocks coupling the nodes of a grid of n x n x n nodes
+linearalgebra::CompressedRowSparseMatrix<SReal> createGridMatrix(int n);
+
+/// Number of nodes of the beam built by addBeam
+int nbBeamNodes(int n);
+
+}
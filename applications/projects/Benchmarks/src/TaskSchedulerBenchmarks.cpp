@@ -0,0 +1,128 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <benchmark/benchmark.h>
+
+#include <sofa/simulation/DefaultTaskScheduler.h>
+#include <sofa/simulation/MainTaskSchedulerFactory.h>
+#include <sofa/simulation/ParallelForEach.h>
+#include <sofa/simulation/WorkStealingTaskScheduler.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+
+namespace sofa::benchmarks
+{
+
+namespace
+{
+
+const std::vector<std::string>& schedulerNames()
+{
+    static const std::vector<std::string> names {
+        simulation::DefaultTaskScheduler::name(),
+        simulation::WorkStealingTaskScheduler::name()
+    };
+    return names;
+}
+
+std::unique_ptr<simulation::TaskScheduler> createScheduler(const std::string& name)
+{
+    std::unique_ptr<simulation::TaskScheduler> scheduler(simulation::MainTaskSchedulerFactory::instantiate(name));
+    if (scheduler)
+    {
+        simulation::Task::setAllocator(scheduler->getTaskAllocator());
+        // at least one thread, even on machines with a single hardware thread
+        scheduler->init(std::max(1u, simulation::TaskScheduler::GetHardwareThreadsCount()));
+    }
+    return scheduler;
+}
+
+/// Parallel loop over n elements, each requiring a small amount of computation
+void parallelForEach(benchmark::State& state, const std::string& schedulerName)
+{
+    const auto scheduler = createScheduler(schedulerName);
+    if (!scheduler)
+    {
+        state.SkipWithError("Cannot create the task scheduler");
+        return;
+    }
+
+    std::vector<SReal> values(state.range(0));
+    std::iota(values.begin(), values.end(), 0_sreal);
+
+    for (auto _ : state)
+    {
+        simulation::parallelForEach(*scheduler, values.begin(), values.end(),
+            [](SReal& value) { value = std::sqrt(value * value + 1_sreal); });
+        benchmark::DoNotOptimize(values.data());
+    }
+
+    state.counters["threads"] = scheduler->getThreadCount();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    scheduler->stop();
+}
+
+/// Overhead of the submission and completion of n empty tasks
+void emptyTasks(benchmark::State& state, const std::string& schedulerName)
+{
+    const auto scheduler = createScheduler(schedulerName);
+    if (!scheduler)
+    {
+        state.SkipWithError("Cannot create the task scheduler");
+        return;
+    }
+
+    const auto nbTasks = state.range(0);
+    for (auto _ : state)
+    {
+        simulation::CpuTaskStatus status;
+        for (int64_t i = 0; i < nbTasks; ++i)
+        {
+            scheduler->addTask(status, [] {});
+        }
+        scheduler->workUntilDone(&status);
+    }
+
+    state.counters["threads"] = scheduler->getThreadCount();
+    state.SetItemsProcessed(state.iterations() * nbTasks);
+    scheduler->stop();
+}
+
+bool registerTaskSchedulerBenchmarks()
+{
+    for (const auto& name : schedulerNames())
+    {
+        benchmark::RegisterBenchmark(("TaskScheduler_parallelForEach/" + name).c_str(), parallelForEach, name)
+            ->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->Unit(benchmark::kMicrosecond)->UseRealTime();
+        benchmark::RegisterBenchmark(("TaskScheduler_emptyTasks/" + name).c_str(), emptyTasks, name)
+            ->RangeMultiplier(4)->Range(16, 4096)->Unit(benchmark::kMicrosecond)->UseRealTime();
+    }
+    return true;
+}
+
+const bool taskSchedulerBenchmarksRegistered = registerTaskSchedulerBenchmarks();
+
+}
+
+}
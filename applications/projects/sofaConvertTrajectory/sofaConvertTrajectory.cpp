@@ -0,0 +1,73 @@
+/******************************************************************************
+*                 SOFA, Simulation Open-Framework Architecture                *
+*                    (c) 2006 INRIA, USTL, UJF, CNRS, MGH                     *
+*                                                                             *
+* This program is free software; you can redistribute it and/or modify it     *
+* under the terms of the GNU Lesser General Public License as published by    *
+* the Free Software Foundation; either version 2.1 of the License, or (at     *
+* your option) any later version.                                             *
+*                                                                             *
+* This program is distributed in the hope that it will be useful, but WITHOUT *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+* for more details.                                                           *
+*                                                                             *
+* You should have received a copy of the GNU Lesser General Public License    *
+* along with this program. If not, see <http://www.gnu.org/licenses/>.        *
+*******************************************************************************
+* Authors: The SOFA Team and external contributors (see Authors.txt)          *
+*                                                                             *
+* Contact information: contact@sofa-framework.org                             *
+******************************************************************************/
+#include <sofa/component/playback/TrajectoryFile.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// ---------------------------------------------------------------------
+// Convert a text file written by WriteState into a binary trajectory file
+// ---------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    using namespace sofa::component::playback::trajectory;
+
+    std::string input, output;
+    Compression compression = Compression::None;
+    std::uint32_t coordDimension = 0;
+    std::uint32_t derivDimension = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--compress")
+        {
+            compression = Compression::Zlib;
+        }
+        else if (arg == "--coordDimension" && i + 1 < argc)
+        {
+            coordDimension = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--derivDimension" && i + 1 < argc)
+        {
+            derivDimension = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+        }
+        else if (input.empty())
+        {
+            input = arg;
+        }
+        else if (output.empty())
+        {
+            output = arg;
+        }
+    }
+
+    if (input.empty() || output.empty())
+    {
+        std::cout << "Usage: sofaConvertTrajectory INPUT OUTPUT.trj [--compress] "
+                     "[--coordDimension N] [--derivDimension N]" << std::endl;
+        return -1;
+    }
+
+    return convertTextTrajectory(input, output, compression, coordDimension, derivDimension) ? 0 : 1;
+}